@@ -0,0 +1,272 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/allocator.h>
+#include <EASTL/arena_allocator.h>
+#include <EASTL/thread_caching_allocator.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/list.h>
+#include <EASTL/map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <stdio.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+using namespace EA;
+
+
+namespace
+{
+	const int kMaxThreadCount = 32;
+
+	struct ThreadData
+	{
+		const uint32_t*        mpSizes;
+		eastl_size_t           mnCount;
+		EA::Thread::Semaphore* mpStartSema;
+		uint32_t               mnResult;
+	};
+
+
+	// Keeps a window of live blocks of varying sizes, freeing the oldest block for every
+	// new one, as a program which builds and discards short-lived objects does.
+	template <typename Allocator>
+	intptr_t AllocFreeThreadFn(void* pData)
+	{
+		ThreadData& data = *static_cast<ThreadData*>(pData);
+		Allocator   allocator;
+		const int   kWindowSize = 256;
+		void*       window[kWindowSize] = {};
+		uint32_t    windowSizes[kWindowSize] = {};
+		uint32_t    result = 0;
+
+		data.mpStartSema->Wait();
+
+		for(eastl_size_t i = 0; i < data.mnCount; i++)
+		{
+			const int slot = (int)(i % kWindowSize);
+
+			if(window[slot])
+				allocator.deallocate(window[slot], windowSizes[slot]);
+
+			windowSizes[slot] = data.mpSizes[i];
+			window[slot]      = allocator.allocate(windowSizes[slot]);
+			result += (uint32_t)(uintptr_t)window[slot];
+		}
+
+		for(int slot = 0; slot < kWindowSize; slot++)
+		{
+			if(window[slot])
+				allocator.deallocate(window[slot], windowSizes[slot]);
+		}
+
+		data.mnResult = result;
+		return 0;
+	}
+
+
+	// Builds and clears lists and maps, as a program which uses node containers for scratch work does.
+	template <typename Allocator>
+	intptr_t ContainerChurnThreadFn(void* pData)
+	{
+		ThreadData& data = *static_cast<ThreadData*>(pData);
+		uint32_t    result = 0;
+
+		data.mpStartSema->Wait();
+
+		for(eastl_size_t i = 0; i < data.mnCount; i += 100)
+		{
+			eastl::list<uint32_t, Allocator> intList;
+			eastl::map<uint32_t, uint32_t, eastl::less<uint32_t>, Allocator> intMap;
+
+			for(eastl_size_t j = i, jEnd = eastl::min_alt(i + 100, data.mnCount); j < jEnd; j++)
+			{
+				intList.push_back(data.mpSizes[j]);
+				intMap[data.mpSizes[j]] = (uint32_t)j;
+			}
+
+			result += (uint32_t)(intList.size() + intMap.size());
+		}
+
+		data.mnResult = result;
+		return 0;
+	}
+
+
+	// Runs threadCount threads, which together do sizes.size() allocations.
+	void TestThreads(EA::StdC::Stopwatch& stopwatch, intptr_t (*pThreadFn)(void*), const eastl::vector<uint32_t>& sizes, int threadCount)
+	{
+		EA::Thread::Thread    threads[kMaxThreadCount];
+		ThreadData            threadData[kMaxThreadCount];
+		EA::Thread::Semaphore startSema(0);
+
+		const eastl_size_t countPerThread = sizes.size() / (eastl_size_t)threadCount;
+
+		for(int t = 0; t < threadCount; t++)
+		{
+			threadData[t].mpSizes     = sizes.data() + (countPerThread * (eastl_size_t)t);
+			threadData[t].mnCount     = countPerThread;
+			threadData[t].mpStartSema = &startSema;
+			threadData[t].mnResult    = 0;
+			threads[t].Begin(pThreadFn, static_cast<void*>(&threadData[t]));
+		}
+
+		stopwatch.Restart();
+		startSema.Post(threadCount);
+
+		uint32_t result = 0;
+		for(int t = 0; t < threadCount; t++)
+		{
+			threads[t].WaitForEnd();
+			result += threadData[t].mnResult;
+		}
+		stopwatch.Stop();
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+
+	// Builds a vector, a string and a hash_map, and throws them away, as scratch work
+	// during a frame or a request does.
+	template <typename Allocator>
+	uint32_t DoScratchWork(const Allocator& allocator, const uint32_t* pValues, eastl_size_t count)
+	{
+		eastl::vector<uint32_t, Allocator> intVector(allocator);
+		eastl::basic_string<char, Allocator> str(allocator);
+		eastl::hash_map<uint32_t, uint32_t, eastl::hash<uint32_t>, eastl::equal_to<uint32_t>, Allocator> intHashMap(allocator);
+
+		for(eastl_size_t i = 0; i < count; i++)
+		{
+			intVector.push_back(pValues[i]);
+			str.push_back((char)('a' + (pValues[i] % 26)));
+			intHashMap[pValues[i] % 64]++;
+		}
+
+		return (uint32_t)(intVector.size() + str.size() + intHashMap.size());
+	}
+
+
+	void TestScratchHeap(EA::StdC::Stopwatch& stopwatch, const eastl::vector<uint32_t>& values, eastl_size_t countPerIteration)
+	{
+		uint32_t result = 0;
+
+		stopwatch.Restart();
+		for(eastl_size_t i = 0; (i + countPerIteration) <= values.size(); i += countPerIteration)
+			result += DoScratchWork(eastl::allocator(), values.data() + i, countPerIteration);
+		stopwatch.Stop();
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+
+	void TestScratchArena(EA::StdC::Stopwatch& stopwatch, eastl::arena& arena, const eastl::vector<uint32_t>& values, eastl_size_t countPerIteration)
+	{
+		uint32_t result = 0;
+
+		stopwatch.Restart();
+		for(eastl_size_t i = 0; (i + countPerIteration) <= values.size(); i += countPerIteration)
+		{
+			eastl::arena_scope scope(arena);
+			result += DoScratchWork(eastl::arena_allocator(&arena), values.data() + i, countPerIteration);
+		}
+		stopwatch.Stop();
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+} // namespace
+
+
+
+
+void BenchmarkAllocator()
+{
+	EASTLTest_Printf("Allocator\n");
+
+	EA::UnitTest::Rand  rng(EA::UnitTest::GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	{
+		// Compares eastl::allocator (first column) against thread_caching_allocator (second column).
+		// The same total amount of work is split between 1 to 32 threads, so perfect scaling halves the time with each step.
+		const eastl_size_t kOperationCount = 1 << 21;
+
+		eastl::vector<uint32_t> sizes(kOperationCount);
+		for(eastl_size_t i = 0; i < kOperationCount; i++)
+			sizes[i] = (rng.RandLimit(16) == 0) ? (16 + rng.RandLimit(4096)) : (16 + rng.RandLimit(240)); // Mostly node-sized blocks.
+
+		for(int threadCount = 1; threadCount <= kMaxThreadCount; threadCount *= 2)
+		{
+			for(int i = 0; i < 2; i++)
+			{
+				char name[128];
+
+				///////////////////////////////
+				// Test allocate / deallocate
+				///////////////////////////////
+
+				TestThreads(stopwatch1, AllocFreeThreadFn<eastl::allocator>, sizes, threadCount);
+				TestThreads(stopwatch2, AllocFreeThreadFn<eastl::thread_caching_allocator>, sizes, threadCount);
+
+				if(i == 1)
+				{
+					sprintf(name, "allocator vs thread_caching_allocator/allocate, deallocate/%d threads", threadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+
+				///////////////////////////////
+				// Test list and map churn
+				///////////////////////////////
+
+				TestThreads(stopwatch1, ContainerChurnThreadFn<eastl::allocator>, sizes, threadCount);
+				TestThreads(stopwatch2, ContainerChurnThreadFn<eastl::thread_caching_allocator>, sizes, threadCount);
+
+				if(i == 1)
+				{
+					sprintf(name, "allocator vs thread_caching_allocator/list and map churn/%d threads", threadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+			}
+		}
+	}
+
+	{
+		// Compares eastl::allocator (first column) against arena_allocator (second column) for
+		// scratch containers which are built and thrown away. The arena is rewound after each
+		// batch of work, and reuses its chunks, so after the first batch it doesn't use the heap.
+		eastl::vector<uint32_t> values(1 << 20);
+		for(eastl_size_t i = 0; i < values.size(); i++)
+			values[i] = rng.RandValue();
+
+		const eastl_size_t countsPerIteration[] = { 16, 256, 4096 };
+
+		for(eastl_size_t c = 0; c < EAArrayCount(countsPerIteration); c++)
+		{
+			char          stackBuffer[4096];
+			eastl::arena  arena(stackBuffer, sizeof(stackBuffer));
+
+			for(int i = 0; i < 2; i++)
+			{
+				TestScratchHeap(stopwatch1, values, countsPerIteration[c]);
+				TestScratchArena(stopwatch2, arena, values, countsPerIteration[c]);
+
+				if(i == 1)
+				{
+					char name[128];
+					sprintf(name, "allocator vs arena_allocator/scratch vector, string, hash_map/%u elements", (unsigned)countsPerIteration[c]);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+			}
+		}
+	}
+}
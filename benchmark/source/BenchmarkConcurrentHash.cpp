@@ -0,0 +1,181 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include <EAStdC/EAStopwatch.h>
+#include <EASTL/concurrent_hash_map.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <mutex>
+#include <stdio.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+using namespace EA;
+
+
+namespace
+{
+	// The baseline: a hash_map behind a single mutex.
+	struct MutexHashMap
+	{
+		std::mutex                            mMutex;
+		eastl::hash_map<uint32_t, uint32_t>   mMap;
+
+		bool Find(uint32_t k, uint32_t& v)
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			eastl::hash_map<uint32_t, uint32_t>::const_iterator it = mMap.find(k);
+			if(it == mMap.end())
+				return false;
+			v = it->second;
+			return true;
+		}
+
+		bool   Insert(uint32_t k, uint32_t v) { std::lock_guard<std::mutex> lock(mMutex); return mMap.try_emplace(k, v).second; }
+		size_t Erase(uint32_t k)              { std::lock_guard<std::mutex> lock(mMutex); return mMap.erase(k); }
+	};
+
+	struct ShardedHashMap
+	{
+		eastl::concurrent_hash_map<uint32_t, uint32_t> mMap;
+
+		bool   Find(uint32_t k, uint32_t& v)  { return mMap.find(k, v); }
+		bool   Insert(uint32_t k, uint32_t v) { return mMap.try_emplace(k, v); }
+		size_t Erase(uint32_t k)              { return mMap.erase(k); }
+	};
+
+
+	template <typename Map>
+	struct ThreadData
+	{
+		Map*                   mpMap;
+		const uint32_t*        mpKeys;
+		eastl_size_t           mKeyCount;
+		EA::Thread::Semaphore* mpStartSema;
+		uint32_t               mResult;
+	};
+
+	// Every tenth operation is an insert and every tenth is an erase; the rest are finds.
+	template <typename Map>
+	intptr_t MixedOperationsThreadFn(void* pData)
+	{
+		ThreadData<Map>& data = *static_cast<ThreadData<Map>*>(pData);
+		uint32_t result = 0;
+
+		data.mpStartSema->Wait();
+
+		for(eastl_size_t i = 0; i < data.mKeyCount; i++)
+		{
+			const uint32_t k = data.mpKeys[i];
+			uint32_t v;
+
+			switch(i % 10)
+			{
+				case 0:
+					result += (uint32_t)data.mpMap->Insert(k, k);
+					break;
+				case 1:
+					result += (uint32_t)data.mpMap->Erase(k);
+					break;
+				default:
+					if(data.mpMap->Find(k, v))
+						result += v;
+					break;
+			}
+		}
+
+		data.mResult = result;
+		return 0;
+	}
+
+
+	// Runs threadCount threads, which together do keys.size() operations on map.
+	template <typename Map>
+	void TestMixedOperations(EA::StdC::Stopwatch& stopwatch, Map& map, const eastl::vector<uint32_t>& keys, int threadCount)
+	{
+		const int kMaxThreadCount = 32;
+		EA::Thread::Thread    threads[kMaxThreadCount];
+		ThreadData<Map>       threadData[kMaxThreadCount];
+		EA::Thread::Semaphore startSema(0);
+
+		const eastl_size_t keysPerThread = keys.size() / (eastl_size_t)threadCount;
+
+		for(int t = 0; t < threadCount; t++)
+		{
+			threadData[t].mpMap       = &map;
+			threadData[t].mpKeys      = keys.data() + (keysPerThread * (eastl_size_t)t);
+			threadData[t].mKeyCount   = keysPerThread;
+			threadData[t].mpStartSema = &startSema;
+			threadData[t].mResult     = 0;
+			threads[t].Begin(MixedOperationsThreadFn<Map>, static_cast<void*>(&threadData[t]));
+		}
+
+		stopwatch.Restart();
+		startSema.Post(threadCount);
+
+		uint32_t result = 0;
+		for(int t = 0; t < threadCount; t++)
+		{
+			threads[t].WaitForEnd();
+			result += threadData[t].mResult;
+		}
+		stopwatch.Stop();
+
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)result);
+	}
+
+} // namespace
+
+
+
+
+void BenchmarkConcurrentHash()
+{
+	EASTLTest_Printf("ConcurrentHashMap\n");
+
+	EA::UnitTest::Rand  rng(EA::UnitTest::GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+	EA::StdC::Stopwatch stopwatch2(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	{
+		// The same total amount of work is split between 1 to 32 threads, so perfect scaling halves the time with each step.
+		const uint32_t     kKeyRange       = 1 << 16;
+		const eastl_size_t kOperationCount = 1 << 21;
+
+		eastl::vector<uint32_t> keys(kOperationCount);
+		for(eastl_size_t i = 0; i < kOperationCount; i++)
+			keys[i] = rng.RandLimit(kKeyRange);
+
+		for(int threadCount = 1; threadCount <= 32; threadCount *= 2)
+		{
+			for(int i = 0; i < 2; i++)
+			{
+				MutexHashMap   mutexMap;
+				ShardedHashMap shardedMap;
+
+				for(uint32_t k = 0; k < kKeyRange; k += 2)
+				{
+					mutexMap.Insert(k, k);
+					shardedMap.Insert(k, k);
+				}
+
+				TestMixedOperations(stopwatch1, mutexMap,   keys, threadCount);
+				TestMixedOperations(stopwatch2, shardedMap, keys, threadCount);
+
+				if(i == 1)
+				{
+					char name[128];
+					sprintf(name, "concurrent_hash_map<uint32_t, uint32_t>/mutex hash_map vs sharded, 80%% find/%d threads", threadCount);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+			}
+		}
+	}
+}
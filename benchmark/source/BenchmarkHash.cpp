@@ -8,6 +8,7 @@
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/vector.h>
 #include <EASTL/hash_map.h>
+#include <EASTL/flat_hash_map.h>
 #include <EASTL/string.h>
 #include <EASTL/algorithm.h>
 
@@ -62,6 +63,12 @@ using StdMapStrUint32 = std::unordered_map<std::string, uint32_t, HashString8<st
 using EaMapUint32TO = eastl::hash_map<uint32_t, TestObject>;
 using EaMapStrUint32 = eastl::hash_map<eastl::string, uint32_t, HashString8<eastl::string>>;
 
+using EaMapUint32TOPow2 = eastl::hash_map<uint32_t, TestObject, eastl::hash<uint32_t>, eastl::equal_to<uint32_t>, EASTLAllocatorType, false, eastl::power_of_two_rehash_policy>;
+using EaMapStrUint32Pow2 = eastl::hash_map<eastl::string, uint32_t, HashString8<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, false, eastl::power_of_two_rehash_policy>;
+
+using EaFlatMapUint32TO = eastl::flat_hash_map<uint32_t, TestObject>;
+using EaFlatMapStrUint32 = eastl::flat_hash_map<eastl::string, uint32_t, HashString8<eastl::string>>;
+
 
 namespace
 {
@@ -227,6 +234,109 @@ namespace
 	}
 
 
+	template <typename Container, typename Key>
+	void TestFindLoop(EA::StdC::Stopwatch& stopwatch, Container& c, const Key* pKeyArray, eastl_size_t nKeyCount, typename Container::iterator* pResultArray)
+	{
+		stopwatch.Restart();
+		for(eastl_size_t i = 0; i < nKeyCount; i++)
+			pResultArray[i] = c.find(pKeyArray[i]);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%p", &pResultArray[nKeyCount / 2]);
+	}
+
+
+	template <typename Container, typename Key>
+	void TestFindBatch(EA::StdC::Stopwatch& stopwatch, Container& c, const Key* pKeyArray, eastl_size_t nKeyCount, typename Container::iterator* pResultArray)
+	{
+		stopwatch.Restart();
+		c.find_batch(pKeyArray, nKeyCount, pResultArray);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%p", &pResultArray[nKeyCount / 2]);
+	}
+
+
+	template <typename Container, typename Key>
+	void TestContainsLoop(EA::StdC::Stopwatch& stopwatch, const Container& c, const Key* pKeyArray, eastl_size_t nKeyCount, bool* pResultArray)
+	{
+		stopwatch.Restart();
+		for(eastl_size_t i = 0; i < nKeyCount; i++)
+			pResultArray[i] = c.contains(pKeyArray[i]);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%d", (int)pResultArray[nKeyCount / 2]);
+	}
+
+
+	template <typename Container, typename Key>
+	void TestContainsBatch(EA::StdC::Stopwatch& stopwatch, const Container& c, const Key* pKeyArray, eastl_size_t nKeyCount, bool* pResultArray)
+	{
+		stopwatch.Restart();
+		c.contains_batch(pKeyArray, nKeyCount, pResultArray);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%d", (int)pResultArray[nKeyCount / 2]);
+	}
+
+
+	template <typename Container, typename Value>
+	void TestInsertBatch(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd)
+	{
+		stopwatch.Restart();
+		c.insert_batch(pArrayBegin, (typename Container::size_type)(pArrayEnd - pArrayBegin));
+		stopwatch.Stop();
+	}
+
+
+	template <typename Container, typename Key>
+	void TestEraseKeys(EA::StdC::Stopwatch& stopwatch, Container& c, const Key* pKeyBegin, const Key* pKeyEnd)
+	{
+		stopwatch.Restart();
+		while(pKeyBegin != pKeyEnd)
+			c.erase(*pKeyBegin++);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	template <typename Container, typename Key>
+	void TestFindKeys(EA::StdC::Stopwatch& stopwatch, const Container& c, const Key* pKeyBegin, const Key* pKeyEnd)
+	{
+		uint32_t nFoundCount = 0;
+		stopwatch.Restart();
+		while(pKeyBegin != pKeyEnd)
+			nFoundCount += (uint32_t)(c.find(*pKeyBegin++) != c.end());
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nFoundCount);
+	}
+
+
+	template <typename Container>
+	void TestIterationSum(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint32_t nSum = 0;
+		stopwatch.Restart();
+		for(typename Container::const_iterator it = c.begin(), itEnd = c.end(); it != itEnd; ++it)
+			nSum += it->second;
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+
+	template <typename Hash, typename String>
+	void TestHashString(EA::StdC::Stopwatch& stopwatch, const String* pBegin, const String* pEnd)
+	{
+		const Hash hashFunction;
+		size_t     nSum = 0;
+
+		stopwatch.Restart();
+		for(int j = 0; j < 100; j++)
+		{
+			for(const String* p = pBegin; p != pEnd; ++p)
+				nSum += hashFunction(*p);
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)nSum);
+	}
+
+
 } // namespace
 
 
@@ -447,6 +557,432 @@ void BenchmarkHash()
 				Benchmark::AddResult("hash_map<string, uint32_t>/clear", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 
 		}
+
+		for(int i = 0; i < 2; i++)
+		{
+			StdMapUint32TO     stdMapUint32TO;
+			EaMapUint32TOPow2  eaMapUint32TO;
+
+			StdMapStrUint32    stdMapStrUint32;
+			EaMapStrUint32Pow2 eaMapStrUint32;
+
+
+			///////////////////////////////
+			// Test insert(const value_type&)
+			///////////////////////////////
+
+			TestInsert(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestInsert(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, TestObject>/power_of_two/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestInsert(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestInsert(stopwatch2, eaMapStrUint32,    eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/power_of_two/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test operator[]
+			///////////////////////////////
+
+			TestBracket(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestBracket(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, TestObject>/power_of_two/operator[]", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestBracket(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestBracket(stopwatch2, eaMapStrUint32,    eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/power_of_two/operator[]", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find
+			///////////////////////////////
+
+			TestFind(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestFind(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, TestObject>/power_of_two/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestFind(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestFind(stopwatch2, eaMapStrUint32,    eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/power_of_two/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test count
+			///////////////////////////////
+
+			TestCount(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestCount(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, TestObject>/power_of_two/count", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestCount(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestCount(stopwatch2, eaMapStrUint32,   eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/power_of_two/count", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test erase(const key_type& key)
+			///////////////////////////////
+
+			TestEraseValue(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + (stdVectorUT.size() / 2));
+			TestEraseValue(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  (eaVectorUT.size() / 2));
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, TestObject>/power_of_two/erase val", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestEraseValue(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + (stdVectorSU.size() / 2));
+			TestEraseValue(stopwatch2, eaMapStrUint32,   eaVectorSU.data(),  eaVectorSU.data() +  (eaVectorSU.size() / 2));
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/power_of_two/erase val", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+
+		for(int i = 0; i < 2; i++)
+		{
+			StdMapUint32TO     stdMapUint32TO;
+			EaFlatMapUint32TO  eaMapUint32TO;
+
+			StdMapStrUint32    stdMapStrUint32;
+			EaFlatMapStrUint32 eaMapStrUint32;
+
+
+			///////////////////////////////
+			// Test insert(const value_type&)
+			///////////////////////////////
+
+			TestInsert(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestInsert(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestInsert(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestInsert(stopwatch2, eaMapStrUint32,    eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test iteration
+			///////////////////////////////
+
+			TestIteration(stopwatch1, stdMapUint32TO, StdMapUint32TO::value_type(9999999, TestObject(9999999)));
+			TestIteration(stopwatch2,  eaMapUint32TO,  EaFlatMapUint32TO::value_type(9999999, TestObject(9999999)));
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/iteration", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestIteration(stopwatch1, stdMapStrUint32, StdMapStrUint32::value_type(  std::string("9999999"), 9999999));
+			TestIteration(stopwatch2,  eaMapStrUint32,  EaFlatMapStrUint32::value_type(eastl::string("9999999"), 9999999));
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/iteration", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test operator[]
+			///////////////////////////////
+
+			TestBracket(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestBracket(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/operator[]", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestBracket(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestBracket(stopwatch2, eaMapStrUint32,    eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/operator[]", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find
+			///////////////////////////////
+
+			TestFind(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestFind(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestFind(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestFind(stopwatch2, eaMapStrUint32,    eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test count
+			///////////////////////////////
+
+			TestCount(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestCount(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/count", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestCount(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestCount(stopwatch2, eaMapStrUint32,   eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/count", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test erase(const key_type& key)
+			///////////////////////////////
+
+			TestEraseValue(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + (stdVectorUT.size() / 2));
+			TestEraseValue(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  (eaVectorUT.size() / 2));
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/erase val", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestEraseValue(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + (stdVectorSU.size() / 2));
+			TestEraseValue(stopwatch2, eaMapStrUint32,   eaVectorSU.data(),  eaVectorSU.data() +  (eaVectorSU.size() / 2));
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/erase val", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test erase(iterator position)
+			///////////////////////////////
+
+			TestErasePosition(stopwatch1, stdMapUint32TO);
+			TestErasePosition(stopwatch2, eaMapUint32TO);
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/erase pos", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestErasePosition(stopwatch1, stdMapStrUint32);
+			TestErasePosition(stopwatch2, eaMapStrUint32);
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/erase pos", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test clear()
+			///////////////////////////////
+
+			// Re-set the containers with full data.
+			TestInsert(stopwatch1, stdMapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+			TestInsert(stopwatch2, eaMapUint32TO,   eaVectorUT.data(),  eaVectorUT.data() +  eaVectorUT.size());
+			TestInsert(stopwatch1, stdMapStrUint32, stdVectorSU.data(), stdVectorSU.data() + stdVectorSU.size());
+			TestInsert(stopwatch2, eaMapStrUint32,   eaVectorSU.data(),  eaVectorSU.data() +  eaVectorSU.size());
+
+			TestClear(stopwatch1, stdMapUint32TO);
+			TestClear(stopwatch2, eaMapUint32TO);
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<uint32_t, TestObject>/clear", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestClear(stopwatch1, stdMapStrUint32);
+			TestClear(stopwatch2, eaMapStrUint32);
+
+			if(i == 1)
+				Benchmark::AddResult("flat_hash_map<string, uint32_t>/clear", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Batched lookups against a loop of single lookups. The table is made large enough
+		// that most buckets and nodes aren't in cache, which is the case batching is for.
+		// Both columns are EASTL: the first is the loop and the second is the batch call.
+		typedef eastl::hash_map<uint32_t, uint32_t> EaMapUint32Uint32;
+
+		const eastl_size_t kElementCount = 500000;
+		eastl::vector<EaMapUint32Uint32::value_type> eaVectorUU;
+		eastl::vector<uint32_t>                      eaKeys(kElementCount);
+
+		eaVectorUU.reserve(kElementCount);
+		for(eastl_size_t i = 0; i < kElementCount; i++)
+			eaVectorUU.push_back(EaMapUint32Uint32::value_type(rng.RandValue(), (uint32_t)i));
+
+		for(eastl_size_t i = 0; i < kElementCount; i++)
+			eaKeys[i] = ((i % 4) == 3) ? rng.RandValue() : eaVectorUU[rng.RandLimit((uint32_t)kElementCount)].first; // Mostly hits, some misses.
+
+		eastl::vector<EaMapUint32Uint32::iterator> results(kElementCount);
+		bool* const pContainsResults = new bool[kElementCount];
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaMapUint32Uint32 eaMapLoop;
+			EaMapUint32Uint32 eaMapBatch;
+
+			TestInsert(stopwatch1, eaMapLoop, eaVectorUU.data(), eaVectorUU.data() + eaVectorUU.size());
+			TestInsertBatch(stopwatch2, eaMapBatch, eaVectorUU.data(), eaVectorUU.data() + eaVectorUU.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, uint32_t>/insert vs insert_batch", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestFindLoop(stopwatch1, eaMapLoop, eaKeys.data(), eaKeys.size(), results.data());
+			TestFindBatch(stopwatch2, eaMapLoop, eaKeys.data(), eaKeys.size(), results.data());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, uint32_t>/find vs find_batch", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestContainsLoop(stopwatch1, eaMapLoop, eaKeys.data(), eaKeys.size(), pContainsResults);
+			TestContainsBatch(stopwatch2, eaMapLoop, eaKeys.data(), eaKeys.size(), pContainsResults);
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<uint32_t, uint32_t>/contains vs contains_batch", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+
+		delete[] pContainsResults;
+	}
+
+	{
+		// Erasing most of a large table, with and without a minimum load factor. Without one the
+		// bucket array stays at its peak size, which costs memory and makes iteration walk the
+		// empty buckets. The notes give the bucket array size in KB for each column.
+		typedef eastl::hash_map<uint32_t, uint32_t> EaMapUint32Uint32;
+
+		const uint32_t kElementCount = 500000;
+		const uint32_t kRemainCount  = kElementCount / 100;
+
+		eastl::vector<uint32_t> eaKeys(kElementCount);
+		for(uint32_t i = 0; i < kElementCount; i++)
+			eaKeys[i] = i * 2654435761u;
+
+		char notes[96];
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaMapUint32Uint32 eaMapNoMin;
+			EaMapUint32Uint32 eaMapMin;
+			eaMapMin.set_min_load_factor(0.25f);
+
+			for(uint32_t k = 0; k < kElementCount; k++)
+			{
+				eaMapNoMin.insert(EaMapUint32Uint32::value_type(eaKeys[k], k));
+				eaMapMin.insert(EaMapUint32Uint32::value_type(eaKeys[k], k));
+			}
+
+			TestEraseKeys(stopwatch1, eaMapNoMin, eaKeys.data() + kRemainCount, eaKeys.data() + eaKeys.size());
+			TestEraseKeys(stopwatch2, eaMapMin,   eaKeys.data() + kRemainCount, eaKeys.data() + eaKeys.size());
+
+			if(i == 1)
+			{
+				sprintf(notes, "buckets %u KB vs %u KB", (unsigned)(eaMapNoMin.bucket_count() * sizeof(void*) / 1024),
+				                                          (unsigned)(eaMapMin.bucket_count()   * sizeof(void*) / 1024));
+				Benchmark::AddResult("hash_map<uint32_t, uint32_t>/erase 99%, min load factor 0 vs 0.25", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+			}
+
+			// Iteration over the sparse table, before and after shrink_to_fit.
+			const unsigned nBucketKBBefore = (unsigned)(eaMapNoMin.bucket_count() * sizeof(void*) / 1024);
+
+			TestIterationSum(stopwatch1, eaMapNoMin);
+			stopwatch2.Restart();
+			eaMapNoMin.shrink_to_fit();
+			stopwatch2.Stop();
+			const int64_t nShrinkTime = stopwatch2.GetElapsedTime();
+			TestIterationSum(stopwatch2, eaMapNoMin);
+
+			if(i == 1)
+			{
+				sprintf(notes, "buckets %u KB -> %u KB, shrink_to_fit took %u", nBucketKBBefore,
+				        (unsigned)(eaMapNoMin.bucket_count() * sizeof(void*) / 1024), (unsigned)nShrinkTime);
+				Benchmark::AddResult("hash_map<uint32_t, uint32_t>/iterate before vs after shrink_to_fit", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime(), notes);
+			}
+		}
+	}
+
+	{
+		// String-keyed lookups without and with cached hash codes, which string keys get by default.
+		// Misses in a table at a high load factor walk whole chains, and only the cached table can
+		// skip the nodes of other hash codes without comparing the strings, which share a long prefix.
+		typedef eastl::hash_map<eastl::string, uint32_t, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, false> EaMapStrUint32Uncached;
+		typedef eastl::hash_map<eastl::string, uint32_t>                                                                                      EaMapStrUint32Cached;
+
+		const uint32_t kElementCount = 100000;
+
+		eastl::vector<eastl::string> eaKeys(kElementCount);
+		eastl::vector<eastl::string> eaMissingKeys(kElementCount);
+		for(uint32_t i = 0; i < kElementCount; i++)
+		{
+			eaKeys[i].sprintf("/assets/textures/environment/%08x", i * 2654435761u);
+			eaMissingKeys[i].sprintf("/assets/textures/environment/%08x", (i + kElementCount) * 2654435761u);
+		}
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaMapStrUint32Uncached eaMapUncached;
+			EaMapStrUint32Cached   eaMapCached;
+			eaMapUncached.set_max_load_factor(4.f);
+			eaMapCached.set_max_load_factor(4.f);
+
+			for(uint32_t k = 0; k < kElementCount; k++)
+			{
+				eaMapUncached.insert(EaMapStrUint32Uncached::value_type(eaKeys[k], k));
+				eaMapCached.insert(EaMapStrUint32Cached::value_type(eaKeys[k], k));
+			}
+
+			TestFindKeys(stopwatch1, eaMapUncached, eaMissingKeys.data(), eaMissingKeys.data() + eaMissingKeys.size());
+			TestFindKeys(stopwatch2, eaMapCached,   eaMissingKeys.data(), eaMissingKeys.data() + eaMissingKeys.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/find miss, uncached vs cached hash", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestFindKeys(stopwatch1, eaMapUncached, eaKeys.data(), eaKeys.data() + eaKeys.size());
+			TestFindKeys(stopwatch2, eaMapCached,   eaKeys.data(), eaKeys.data() + eaKeys.size());
+
+			if(i == 1)
+				Benchmark::AddResult("hash_map<string, uint32_t>/find hit, uncached vs cached hash", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// String hashing, for key lengths from short identifiers to long paths and URLs.
+		const eastl_size_t kLengths[] = { 4, 16, 64, 256 };
+
+		for(eastl_size_t n = 0; n < EAArrayCount(kLengths); n++)
+		{
+			eastl::vector<  std::string> stdStrings(1000);
+			eastl::vector<eastl::string>  eaStrings(1000);
+
+			for(eastl_size_t i = 0; i < stdStrings.size(); i++)
+			{
+				for(eastl_size_t c = 0; c < kLengths[n]; c++)
+				{
+					const char ch = (char)('a' + rng.RandLimit(26));
+					stdStrings[i].push_back(ch);
+					eaStrings[i].push_back(ch);
+				}
+			}
+
+			for(int i = 0; i < 2; i++)
+			{
+				TestHashString<  std::hash<  std::string>>(stopwatch1, stdStrings.data(), stdStrings.data() + stdStrings.size());
+				TestHashString<eastl::hash<eastl::string>>(stopwatch2,  eaStrings.data(),  eaStrings.data() +  eaStrings.size());
+
+				if(i == 1)
+				{
+					char name[64];
+					sprintf(name, "hash<string>/length %u", (unsigned)kLengths[n]);
+					Benchmark::AddResult(name, stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+				}
+			}
+		}
 	}
 }
 
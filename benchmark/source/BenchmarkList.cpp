@@ -7,6 +7,7 @@
 #include "EASTLTest.h"
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/list.h>
+#include <EASTL/node_pool_allocator.h>
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/random.h>
@@ -29,6 +30,7 @@ using namespace eastl;
 
 typedef std::list<TestObject>   StdListTO;
 typedef eastl::list<TestObject> EaListTO;
+typedef eastl::list<TestObject, eastl::node_pool_allocator> EaPoolListTO;
 
 
 
@@ -170,6 +172,18 @@ namespace
 		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.back().mX);
 	}
 
+
+	template <typename Container>
+	void TestIterate(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		int nSum = 0;
+		stopwatch.Restart();
+		for(typename Container::const_iterator it = c.begin(), itEnd = c.end(); it != itEnd; ++it)
+			nSum += it->mX;
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%d", nSum);
+	}
+
 } // namespace
 
 
@@ -357,6 +371,51 @@ void BenchmarkList()
 				Benchmark::AddResult("list<TestObject>/erase", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
 		}
 	}
+
+	{
+		// Compares the default allocator (first column) against node_pool_allocator (second column).
+		// The lists are built by inserting at spread-out positions, with erasures in between, so that
+		// the default allocator's nodes become scattered in memory, as they do in long-lived lists.
+		eastl::vector<TestObject> toVector(100000);
+		for(eastl_size_t i = 0, iEnd = toVector.size(); i < iEnd; ++i)
+			toVector[i] = TestObject((int)i);
+		random_shuffle(toVector.begin(), toVector.end(), rng);
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaListTO     eaListTO;
+			EaPoolListTO eaPoolListTO;
+
+			///////////////////////////////
+			// Test insert() / erase()
+			///////////////////////////////
+
+			TestInsert(stopwatch1, eaListTO, toVector.data(), toVector.data() + toVector.size());
+			TestInsert(stopwatch2, eaPoolListTO, toVector.data(), toVector.data() + toVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("list<TestObject>/insert vs node_pool_allocator", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestErase(stopwatch1, eaListTO);
+			TestErase(stopwatch2, eaPoolListTO);
+
+			if(i == 1)
+				Benchmark::AddResult("list<TestObject>/erase vs node_pool_allocator", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestInsert(stopwatch1, eaListTO, toVector.data(), toVector.data() + toVector.size());
+			TestInsert(stopwatch2, eaPoolListTO, toVector.data(), toVector.data() + toVector.size());
+
+			///////////////////////////////
+			// Test iteration
+			///////////////////////////////
+
+			TestIterate(stopwatch1, eaListTO);
+			TestIterate(stopwatch2, eaPoolListTO);
+
+			if(i == 1)
+				Benchmark::AddResult("list<TestObject>/iterate vs node_pool_allocator", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
 }
 
 
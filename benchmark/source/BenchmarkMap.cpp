@@ -7,6 +7,7 @@
 #include "EASTLTest.h"
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/map.h>
+#include <EASTL/btree_map.h>
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
 
@@ -21,6 +22,8 @@ using namespace EA;
 
 typedef std::map<TestObject, uint32_t>     StdMapTOUint32;
 typedef eastl::map<TestObject, uint32_t>   EaMapTOUint32;
+typedef eastl::map<uint32_t, uint32_t>       EaMapUint32;
+typedef eastl::btree_map<uint32_t, uint32_t> EaBTreeMapUint32;
 
 
 namespace
@@ -100,6 +103,40 @@ namespace
 	}
 
 
+	template <typename Container>
+	void TestLowerBoundSweep(EA::StdC::Stopwatch& stopwatch, const Container& c, uint32_t nKeyEnd, uint32_t nKeyStep, bool bHinted)
+	{
+		// Probes with monotonically increasing keys. If bHinted, each result is the hint for the next lookup.
+		typename Container::const_iterator it = c.begin();
+
+		stopwatch.Restart();
+		for(uint32_t k = 0; k < nKeyEnd; k += nKeyStep)
+		{
+			it = bHinted ? c.lower_bound(it, k) : c.lower_bound(k);
+			Benchmark::DoNothing(it->second);
+		}
+		stopwatch.Stop();
+	}
+
+
+	template <typename Container, typename Value>
+	void TestInsertHinted(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd, bool bHinted)
+	{
+		// If bHinted, each inserted element is the hint for the next insertion.
+		typename Container::iterator it = c.end();
+
+		stopwatch.Restart();
+		for(; pArrayBegin != pArrayEnd; ++pArrayBegin)
+		{
+			if(bHinted)
+				it = c.insert(it, *pArrayBegin);
+			else
+				c.insert(*pArrayBegin);
+		}
+		stopwatch.Stop();
+	}
+
+
 	template <typename Container, typename Value>
 	void TestUpperBound(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd)
 	{
@@ -187,6 +224,16 @@ namespace
 	}
 
 
+	template <typename Container, typename Value>
+	void TestConstruct(EA::StdC::Stopwatch& stopwatch, const Value* pArrayBegin, const Value* pArrayEnd)
+	{
+		stopwatch.Restart();
+		Container c(pArrayBegin, pArrayEnd);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
 	template <typename Container>
 	void TestClear(EA::StdC::Stopwatch& stopwatch, Container& c)
 	{
@@ -364,6 +411,162 @@ void BenchmarkMap()
 
 		}
 	}
+
+	{
+		// Construction from sorted input, as when loading a sorted snapshot at startup.
+		eastl::vector< std::pair<uint32_t, uint32_t> >   stdVector(1000000);
+		eastl::vector< eastl::pair<uint32_t, uint32_t> > eaVector(1000000);
+
+		for(eastl_size_t i = 0, iEnd = stdVector.size(); i < iEnd; i++)
+		{
+			const uint32_t n = rng.RandValue();
+
+			stdVector[i] = std::pair<uint32_t, uint32_t>((uint32_t)i, n);
+			eaVector[i]  = eastl::pair<uint32_t, uint32_t>((uint32_t)i, n);
+		}
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test map(first, last) with sorted input
+			///////////////////////////////
+
+			TestConstruct<std::map<uint32_t, uint32_t>>(stopwatch1, stdVector.data(), stdVector.data() + stdVector.size());
+			TestConstruct<eastl::map<uint32_t, uint32_t>>(stopwatch2, eaVector.data(), eaVector.data() + eaVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t>/construct/sorted", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test multimap(first, last) with sorted input
+			///////////////////////////////
+
+			TestConstruct<std::multimap<uint32_t, uint32_t>>(stopwatch1, stdVector.data(), stdVector.data() + stdVector.size());
+			TestConstruct<eastl::multimap<uint32_t, uint32_t>>(stopwatch2, eaVector.data(), eaVector.data() + eaVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("multimap<uint32_t, uint32_t>/construct/sorted", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Compares regular (first column) against hinted (second column) lookups and insertions
+		// in eastl::map, with keys that increase monotonically or nearly so.
+		eastl::vector< eastl::pair<uint32_t, uint32_t> > eaVector(1000000);
+
+		for(eastl_size_t i = 0, iEnd = eaVector.size(); i < iEnd; i++)
+			eaVector[i] = eastl::pair<uint32_t, uint32_t>((uint32_t)(i * 16) + rng.RandLimit(64), rng.RandValue()); // Nearly sorted.
+
+		for(int i = 0; i < 2; i++)
+		{
+			eastl::map<uint32_t, uint32_t> eaMapUint32A;
+			eastl::map<uint32_t, uint32_t> eaMapUint32B;
+
+			///////////////////////////////
+			// Test insert(hint, value) with nearly sorted values
+			///////////////////////////////
+
+			TestInsertHinted(stopwatch1, eaMapUint32A, eaVector.data(), eaVector.data() + eaVector.size(), false);
+			TestInsertHinted(stopwatch2, eaMapUint32B, eaVector.data(), eaVector.data() + eaVector.size(), true);
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t>/insert vs insert hint", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test lower_bound(hint, key) with increasing keys
+			///////////////////////////////
+
+			TestLowerBoundSweep(stopwatch1, eaMapUint32A, (uint32_t)(eaVector.size() - 1) * 16, 5, false);
+			TestLowerBoundSweep(stopwatch2, eaMapUint32A, (uint32_t)(eaVector.size() - 1) * 16, 5, true);
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t>/lower_bound vs lower_bound hint", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Compares eastl::map (first column) against eastl::btree_map (second column).
+		eastl::vector< eastl::pair<uint32_t, uint32_t> > eaVector(100000);
+
+		for(eastl_size_t i = 0, iEnd = eaVector.size(); i < iEnd; i++)
+			eaVector[i] = eastl::pair<uint32_t, uint32_t>(rng.RandLimit((uint32_t)iEnd / 2), rng.RandValue());
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaMapUint32      eaMapUint32;
+			EaBTreeMapUint32 eaBTreeMapUint32;
+
+
+			///////////////////////////////
+			// Test insert(const value_type&)
+			///////////////////////////////
+
+			const eastl::pair<uint32_t, uint32_t> highValue(0x7fffffff, 0x7fffffff);
+
+			TestInsert(stopwatch1, eaMapUint32,      eaVector.data(), eaVector.data() + eaVector.size(), highValue);
+			TestInsert(stopwatch2, eaBTreeMapUint32, eaVector.data(), eaVector.data() + eaVector.size(), highValue);
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t> vs btree_map/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test iteration
+			///////////////////////////////
+
+			TestIteration(stopwatch1, eaMapUint32,      EaMapUint32::value_type(9999999, 9999999));
+			TestIteration(stopwatch2, eaBTreeMapUint32, EaBTreeMapUint32::value_type(9999999, 9999999));
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t> vs btree_map/iteration", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find
+			///////////////////////////////
+
+			TestFind(stopwatch1, eaMapUint32,      eaVector.data(), eaVector.data() + eaVector.size());
+			TestFind(stopwatch2, eaBTreeMapUint32, eaVector.data(), eaVector.data() + eaVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t> vs btree_map/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test lower_bound
+			///////////////////////////////
+
+			TestLowerBound(stopwatch1, eaMapUint32,      eaVector.data(), eaVector.data() + eaVector.size());
+			TestLowerBound(stopwatch2, eaBTreeMapUint32, eaVector.data(), eaVector.data() + eaVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t> vs btree_map/lower_bound", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test erase(const key_type& key)
+			///////////////////////////////
+
+			TestEraseValue(stopwatch1, eaMapUint32,      eaVector.data(), eaVector.data() + (eaVector.size() / 2));
+			TestEraseValue(stopwatch2, eaBTreeMapUint32, eaVector.data(), eaVector.data() + (eaVector.size() / 2));
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t> vs btree_map/erase/key", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test clear()
+			///////////////////////////////
+
+			TestClear(stopwatch1, eaMapUint32);
+			TestClear(stopwatch2, eaBTreeMapUint32);
+
+			if(i == 1)
+				Benchmark::AddResult("map<uint32_t, uint32_t> vs btree_map/clear", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
 }
 
 
@@ -7,8 +7,13 @@
 #include "EASTLTest.h"
 #include <EAStdC/EAStopwatch.h>
 #include <EASTL/set.h>
+#include <EASTL/btree_set.h>
+#include <EASTL/ranked_set.h>
+#include <EASTL/static_sorted_set.h>
+#include <EASTL/vector_set.h>
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <set>
@@ -21,6 +26,10 @@ using namespace EA;
 
 typedef std::set<uint32_t>     StdSetUint32;
 typedef eastl::set<uint32_t>   EaSetUint32;
+typedef eastl::btree_set<uint32_t> EaBTreeSetUint32;
+typedef eastl::ranked_set<uint32_t> EaRankedSetUint32;
+typedef eastl::vector_set<uint32_t> EaVectorSetUint32;
+typedef eastl::static_sorted_set<uint32_t> EaStaticSortedSetUint32;
 
 
 namespace
@@ -38,6 +47,17 @@ namespace
 	}
 
 
+	template <typename Container>
+	void TestInsertByElement(EA::StdC::Stopwatch& stopwatch, Container& c, const uint32_t* pArrayBegin, const uint32_t* pArrayEnd)
+	{
+		stopwatch.Restart();
+		while(pArrayBegin != pArrayEnd)
+			c.insert(*pArrayBegin++);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
 	template <typename Container>
 	void TestIteration(EA::StdC::Stopwatch& stopwatch, const Container& c)
 	{
@@ -189,6 +209,86 @@ namespace
 	}
 
 
+	template <typename Container>
+	void TestMergeByElement(EA::StdC::Stopwatch& stopwatch, Container& c, Container& source)
+	{
+		stopwatch.Restart();
+		for(typename Container::iterator it = source.begin(); it != source.end(); )
+		{
+			if(c.insert(*it).second)
+				it = source.erase(it);
+			else
+				++it;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	template <typename Container>
+	void TestMerge(EA::StdC::Stopwatch& stopwatch, Container& c, Container& source)
+	{
+		stopwatch.Restart();
+		c.merge(source);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	template <typename Container>
+	void TestIntersectByElement(EA::StdC::Stopwatch& stopwatch, Container& c, const Container& x)
+	{
+		stopwatch.Restart();
+		for(typename Container::iterator it = c.begin(); it != c.end(); )
+		{
+			if(x.find(*it) == x.end())
+				it = c.erase(it);
+			else
+				++it;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	template <typename Container>
+	void TestIntersect(EA::StdC::Stopwatch& stopwatch, Container& c, const Container& x)
+	{
+		stopwatch.Restart();
+		c.intersect(x);
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)c.size());
+	}
+
+
+	template <typename Container>
+	void TestNthByAdvance(EA::StdC::Stopwatch& stopwatch, const Container& c, const uint32_t* pIndexBegin, const uint32_t* pIndexEnd)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(; pIndexBegin != pIndexEnd; ++pIndexBegin)
+		{
+			typename Container::const_iterator it = c.begin();
+			eastl::advance(it, (ptrdiff_t)(*pIndexBegin % c.size()));
+			temp += *it;
+		}
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)(temp & 0xffffffff));
+	}
+
+
+	template <typename Container>
+	void TestNth(EA::StdC::Stopwatch& stopwatch, const Container& c, const uint32_t* pIndexBegin, const uint32_t* pIndexEnd)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(; pIndexBegin != pIndexEnd; ++pIndexBegin)
+			temp += *c.nth(*pIndexBegin % c.size());
+		stopwatch.Stop();
+		EA::StdC::Snprintf(Benchmark::gScratchBuffer, Benchmark::kScratchBufferSize, "%u", (unsigned)(temp & 0xffffffff));
+	}
+
+
 } // namespace
 
 
@@ -335,6 +435,282 @@ void BenchmarkSet()
 
 		}
 	}
+
+	{
+		// Compares eastl::set (first column) against eastl::btree_set (second column).
+		eastl::vector<uint32_t> intVector(100000);
+		for(eastl_size_t i = 0, iEnd = intVector.size(); i < iEnd; i++)
+			intVector[i] = (uint32_t)rng.RandLimit(((uint32_t)iEnd / 2));
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaSetUint32      eaSetUint32;
+			EaBTreeSetUint32 eaBTreeSetUint32;
+
+
+			///////////////////////////////
+			// Test insert(const value_type&)
+			///////////////////////////////
+
+			TestInsert(stopwatch1, eaSetUint32,      intVector.data(), intVector.data() + intVector.size());
+			TestInsert(stopwatch2, eaBTreeSetUint32, intVector.data(), intVector.data() + intVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs btree_set/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test iteration
+			///////////////////////////////
+
+			TestIteration(stopwatch1, eaSetUint32);
+			TestIteration(stopwatch2, eaBTreeSetUint32);
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs btree_set/iteration", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test find
+			///////////////////////////////
+
+			TestFind(stopwatch1, eaSetUint32,      intVector.data(), intVector.data() + intVector.size());
+			TestFind(stopwatch2, eaBTreeSetUint32, intVector.data(), intVector.data() + intVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs btree_set/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test lower_bound
+			///////////////////////////////
+
+			TestLowerBound(stopwatch1, eaSetUint32,      intVector.data(), intVector.data() + intVector.size());
+			TestLowerBound(stopwatch2, eaBTreeSetUint32, intVector.data(), intVector.data() + intVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs btree_set/lower_bound", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test erase(const value_type& value)
+			///////////////////////////////
+
+			TestEraseValue(stopwatch1, eaSetUint32,      &intVector[0], &intVector[intVector.size() / 2]);
+			TestEraseValue(stopwatch2, eaBTreeSetUint32, &intVector[0], &intVector[intVector.size() / 2]);
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs btree_set/erase/val", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test clear()
+			///////////////////////////////
+
+			TestClear(stopwatch1, eaSetUint32);
+			TestClear(stopwatch2, eaBTreeSetUint32);
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs btree_set/clear", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Compares doing set operations element by element (first column) against eastl::set::merge 
+		// and intersect (second column), for a large set and a small one.
+		eastl::vector<uint32_t> largeVector(100000);
+		eastl::vector<uint32_t> smallVector(1000);
+
+		for(eastl_size_t i = 0, iEnd = largeVector.size(); i < iEnd; i++)
+			largeVector[i] = rng.RandValue();
+		for(eastl_size_t i = 0, iEnd = smallVector.size(); i < iEnd; i++)
+			smallVector[i] = (i % 2) ? largeVector[rng.RandLimit((uint32_t)largeVector.size())] : rng.RandValue(); // About half of these are in the large set.
+
+		const EaSetUint32 eaSetLarge(largeVector.begin(), largeVector.end());
+		const EaSetUint32 eaSetSmall(smallVector.begin(), smallVector.end());
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test merge(this_type& source)
+			///////////////////////////////
+
+			{
+				EaSetUint32 eaSet1(eaSetLarge), eaSource1(eaSetSmall);
+				EaSetUint32 eaSet2(eaSetLarge), eaSource2(eaSetSmall);
+
+				TestMergeByElement(stopwatch1, eaSet1, eaSource1);
+				TestMerge(stopwatch2, eaSet2, eaSource2);
+			}
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t>/merge/small into large", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test intersect(const this_type& x)
+			///////////////////////////////
+
+			{
+				EaSetUint32 eaSet1(eaSetLarge);
+				EaSetUint32 eaSet2(eaSetLarge);
+
+				TestIntersectByElement(stopwatch1, eaSet1, eaSetSmall);
+				TestIntersect(stopwatch2, eaSet2, eaSetSmall);
+			}
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t>/intersect/large with small", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Compares eastl::set (first column) against eastl::ranked_set (second column), which pays 
+		// for keeping subtree sizes on insertion and erasure in return for finding the nth element
+		// without walking to it.
+		eastl::vector<uint32_t> intVector(100000);
+		for(eastl_size_t i = 0, iEnd = intVector.size(); i < iEnd; i++)
+			intVector[i] = (uint32_t)rng.RandLimit(((uint32_t)iEnd / 2));
+
+		for(int i = 0; i < 2; i++)
+		{
+			EaSetUint32       eaSetUint32;
+			EaRankedSetUint32 eaRankedSetUint32;
+
+
+			///////////////////////////////
+			// Test insert(const value_type&)
+			///////////////////////////////
+
+			TestInsert(stopwatch1, eaSetUint32,       intVector.data(), intVector.data() + intVector.size());
+			TestInsert(stopwatch2, eaRankedSetUint32, intVector.data(), intVector.data() + intVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs ranked_set/insert", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test eastl::advance(begin(), n) against nth(n)
+			///////////////////////////////
+
+			TestNthByAdvance(stopwatch1, eaSetUint32, intVector.data(), intVector.data() + 1000);
+			TestNth(stopwatch2, eaRankedSetUint32,    intVector.data(), intVector.data() + 1000);
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs ranked_set/nth", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test erase(const value_type& value)
+			///////////////////////////////
+
+			TestEraseValue(stopwatch1, eaSetUint32,       &intVector[0], &intVector[intVector.size() / 2]);
+			TestEraseValue(stopwatch2, eaRankedSetUint32, &intVector[0], &intVector[intVector.size() / 2]);
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs ranked_set/erase/val", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test clear()
+			///////////////////////////////
+
+			TestClear(stopwatch1, eaSetUint32);
+			TestClear(stopwatch2, eaRankedSetUint32);
+		}
+	}
+
+	{
+		// Compares inserting a batch of values into an eastl::vector_set one at a time (first column)
+		// against inserting them with insert(first, last) (second column), which sorts the batch and
+		// merges it into place at once.
+		eastl::vector<uint32_t> intVector(100000);
+		for(eastl_size_t i = 0, iEnd = intVector.size(); i < iEnd; i++)
+			intVector[i] = rng.RandValue();
+
+		eastl::vector<uint32_t> batchVector(10000);
+		for(eastl_size_t i = 0, iEnd = batchVector.size(); i < iEnd; i++)
+			batchVector[i] = rng.RandValue();
+
+		eastl::sort(intVector.begin(), intVector.end());
+		const EaVectorSetUint32 eaVectorSetInitial(intVector.begin(), intVector.end());
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test insert(InputIterator first, InputIterator last)
+			///////////////////////////////
+
+			{
+				EaVectorSetUint32 eaVectorSet1(eaVectorSetInitial);
+				EaVectorSetUint32 eaVectorSet2(eaVectorSetInitial);
+
+				TestInsertByElement(stopwatch1, eaVectorSet1, batchVector.data(), batchVector.data() + batchVector.size());
+				TestInsert(stopwatch2, eaVectorSet2, batchVector.data(), batchVector.data() + batchVector.size());
+			}
+
+			if(i == 1)
+				Benchmark::AddResult("vector_set<uint32_t>/insert range", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
+
+	{
+		// Compares eastl::vector_set and eastl::set (first column) against eastl::static_sorted_set
+		// (second column) for lookups in a set which is much larger than the cache.
+		eastl::vector<uint32_t> intVector(1000000);
+		for(eastl_size_t i = 0, iEnd = intVector.size(); i < iEnd; i++)
+			intVector[i] = rng.RandValue();
+		intVector.push_back(0xffffffff); // So that lower_bound never returns end().
+		eastl::sort(intVector.begin(), intVector.end()); // vector_set builds slowly from unsorted input.
+
+		eastl::vector<uint32_t> findVector(1000000);    // Keys which are in the set, in random order.
+		eastl::vector<uint32_t> lookupVector(1000000);  // Keys which mostly aren't.
+		for(eastl_size_t i = 0, iEnd = findVector.size(); i < iEnd; i++)
+		{
+			findVector[i]   = intVector[rng.RandLimit((uint32_t)intVector.size())];
+			lookupVector[i] = rng.RandValue();
+		}
+
+		EaVectorSetUint32       eaVectorSetUint32(intVector.begin(), intVector.end());
+		EaSetUint32             eaSetUint32(intVector.begin(), intVector.end());
+		EaStaticSortedSetUint32 eaStaticSortedSetUint32(intVector.begin(), intVector.end());
+
+		for(int i = 0; i < 2; i++)
+		{
+			///////////////////////////////
+			// Test find
+			///////////////////////////////
+
+			TestFind(stopwatch1, eaVectorSetUint32,       findVector.data(), findVector.data() + findVector.size());
+			TestFind(stopwatch2, eaStaticSortedSetUint32, findVector.data(), findVector.data() + findVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("vector_set<uint32_t> vs static_sorted_set/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestFind(stopwatch1, eaSetUint32,             findVector.data(), findVector.data() + findVector.size());
+			TestFind(stopwatch2, eaStaticSortedSetUint32, findVector.data(), findVector.data() + findVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs static_sorted_set/find", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+
+			///////////////////////////////
+			// Test lower_bound
+			///////////////////////////////
+
+			TestLowerBound(stopwatch1, eaVectorSetUint32,       lookupVector.data(), lookupVector.data() + lookupVector.size());
+			TestLowerBound(stopwatch2, eaStaticSortedSetUint32, lookupVector.data(), lookupVector.data() + lookupVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("vector_set<uint32_t> vs static_sorted_set/lower_bound", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+
+			TestLowerBound(stopwatch1, eaSetUint32,             lookupVector.data(), lookupVector.data() + lookupVector.size());
+			TestLowerBound(stopwatch2, eaStaticSortedSetUint32, lookupVector.data(), lookupVector.data() + lookupVector.size());
+
+			if(i == 1)
+				Benchmark::AddResult("set<uint32_t> vs static_sorted_set/lower_bound", stopwatch1.GetUnits(), stopwatch1.GetElapsedTime(), stopwatch2.GetElapsedTime());
+		}
+	}
 }
 
 
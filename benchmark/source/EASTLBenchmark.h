@@ -41,7 +41,9 @@ void BenchmarkDeque();
 void BenchmarkSet();
 void BenchmarkMap();
 void BenchmarkHash();
+void BenchmarkConcurrentHash();
 void BenchmarkAlgorithm();
+void BenchmarkAllocator();
 void BenchmarkHeap();
 void BenchmarkBitset();
 void BenchmarkTupleVector();
@@ -146,6 +146,7 @@ int EAMain(int argc, char* argv[])
 	EA::StdC::Stopwatch stopwatch(EA::StdC::Stopwatch::kUnitsSeconds, true);     // Measure seconds, start the counting immediately.
 
 	BenchmarkAlgorithm();
+	BenchmarkAllocator();
 	BenchmarkList();
 	BenchmarkString();
 	BenchmarkVector();
@@ -153,6 +154,7 @@ int EAMain(int argc, char* argv[])
 	BenchmarkSet();
 	BenchmarkMap();
 	BenchmarkHash();
+	BenchmarkConcurrentHash();
 	BenchmarkHeap();
 	BenchmarkBitset();
 	BenchmarkSort();
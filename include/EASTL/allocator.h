@@ -8,9 +8,14 @@
 
 
 #include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
 #include <EABase/nullptr.h>
 #include <stddef.h>
 
+#if EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT
+	#include <EASTL/thread_caching_allocator.h> // Declares EASTLAllocatorType.
+#endif
+
 
 #if defined(EA_PRAGMA_ONCE_SUPPORTED)
 	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
@@ -103,6 +108,11 @@ namespace eastl
 #endif
 
 
+	// Containers are trivially relocatable if their allocators are. See is_trivially_relocatable.
+	template <> struct is_trivially_relocatable<allocator>       : public true_type {};
+	template <> struct is_trivially_relocatable<dummy_allocator> : public true_type {};
+
+
 	/// Defines a static default allocator which is constant across all types.
 	/// This is different from get_default_allocator, which is is bound at
 	/// compile-time and expected to differ per allocator type.
@@ -375,6 +385,81 @@ namespace eastl
 		return result;
 	}
 
+
+	namespace detail
+	{
+		template <typename Allocator, typename = void>
+		struct has_allocator_try_expand : public eastl::false_type {};
+
+		template <typename Allocator>
+		struct has_allocator_try_expand<Allocator, eastl::void_t<decltype(eastl::declval<Allocator&>().try_expand((void*)NULL, size_t(), size_t()))>>
+			: public eastl::true_type {};
+
+		template <typename Allocator, typename = void>
+		struct has_allocator_reallocate : public eastl::false_type {};
+
+		template <typename Allocator>
+		struct has_allocator_reallocate<Allocator, eastl::void_t<decltype(eastl::declval<Allocator&>().reallocate((void*)NULL, size_t(), size_t()))>>
+			: public eastl::true_type {};
+
+		template <typename Allocator>
+		inline bool allocator_try_expand(Allocator& a, void* p, size_t oldSize, size_t newSize, eastl::true_type)
+			{ return a.try_expand(p, oldSize, newSize); }
+
+		template <typename Allocator>
+		inline bool allocator_try_expand(Allocator&, void*, size_t, size_t, eastl::false_type)
+			{ return false; }
+
+		template <typename Allocator>
+		inline void* allocator_reallocate(Allocator& a, void* p, size_t oldSize, size_t newSize, eastl::true_type)
+			{ return a.reallocate(p, oldSize, newSize); }
+
+		template <typename Allocator>
+		inline void* allocator_reallocate(Allocator&, void*, size_t, size_t, eastl::false_type)
+			{ return NULL; }
+	}
+
+
+	/// allocator_try_expand
+	///
+	/// Asks the allocator to grow the block p of oldSize bytes to newSize bytes
+	/// where it is, and returns true if it did. Returns false if it couldn't, or
+	/// if the allocator doesn't support this, in which case p is unchanged.
+	///
+	/// This is an optional allocator extension. An allocator supports it by
+	/// providing the following function, which containers use as they grow:
+	///     bool try_expand(void* p, size_t oldSize, size_t newSize);
+	///
+	template <typename Allocator>
+	inline bool allocator_try_expand(Allocator& a, void* p, size_t oldSize, size_t newSize)
+	{
+		return detail::allocator_try_expand(a, p, oldSize, newSize, detail::has_allocator_try_expand<Allocator>());
+	}
+
+
+	/// allocator_reallocate
+	///
+	/// Asks the allocator to move the block p of oldSize bytes to a block of
+	/// newSize bytes, in the manner of realloc, and returns the new block.
+	/// Returns NULL if it couldn't, or if the allocator doesn't support this,
+	/// in which case p is unchanged.
+	///
+	/// The block's bytes are copied, so containers use this only for trivially
+	/// relocatable values whose alignment is no more than EASTL_ALLOCATOR_MIN_ALIGNMENT.
+	/// A realloc-based implementation can thus grow large blocks without copying
+	/// them, where the system can remap their pages (e.g. glibc with mremap).
+	///
+	/// This is an optional allocator extension. An allocator supports it by
+	/// providing the following function, whose result must be aligned as
+	/// allocate(n) results are, and which must leave p unchanged if it fails:
+	///     void* reallocate(void* p, size_t oldSize, size_t newSize);
+	///
+	template <typename Allocator>
+	inline void* allocator_reallocate(Allocator& a, void* p, size_t oldSize, size_t newSize)
+	{
+		return detail::allocator_reallocate(a, p, oldSize, newSize, detail::has_allocator_reallocate<Allocator>());
+	}
+
 }
 
 
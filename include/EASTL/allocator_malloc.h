@@ -106,6 +106,12 @@ namespace eastl
 		void deallocate(void* p, size_t /*n*/)
 			{ free(p); }
 
+		// Supports allocator_reallocate. Only blocks from allocate(n) may be passed, as realloc
+		// doesn't keep the alignment of memalign blocks. Large blocks are typically moved by
+		// remapping their pages rather than by copying them.
+		void* reallocate(void* p, size_t /*oldSize*/, size_t newSize)
+			{ return realloc(p, newSize); }
+
 		const char* get_name() const
 			{ return "allocator_malloc"; }
 
@@ -113,6 +119,8 @@ namespace eastl
 			{ }
 	};
 
+	template <> struct is_trivially_relocatable<allocator_malloc> : public true_type {};
+
 
 } // namespace eastl
 
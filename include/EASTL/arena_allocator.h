@@ -0,0 +1,380 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     arena
+//     arena_scope
+//     arena_allocator
+//
+// An arena is a monotonic (bump pointer) allocator for scratch memory, such as
+// the containers built during a frame or a request. Memory is never freed
+// individually; instead the whole arena is reset, or rewound to a marker taken
+// earlier. Rewinding keeps the arena's chunks for reuse, so once an arena has
+// grown to the size of its workload, it no longer touches the heap.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ARENA_ALLOCATOR_H
+#define EASTL_ARENA_ALLOCATOR_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ARENA_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ARENA_DEFAULT_NAME
+		#define EASTL_ARENA_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " arena" // Unless the user overrides something, this is "EASTL arena".
+	#endif
+
+
+	/// EASTL_ARENA_DEFAULT_CHUNK_SIZE
+	///
+	/// Defines the default size in bytes of the first chunk an arena allocates.
+	/// Each further chunk is twice as large as the one before it, up to
+	/// EASTL_ARENA_MAX_CHUNK_SIZE.
+	///
+	#ifndef EASTL_ARENA_DEFAULT_CHUNK_SIZE
+		#define EASTL_ARENA_DEFAULT_CHUNK_SIZE (16 * 1024)
+	#endif
+
+
+	/// EASTL_ARENA_MAX_CHUNK_SIZE
+	///
+	/// Defines the size in bytes above which an arena stops growing its chunks.
+	/// Larger requests get a chunk of their own.
+	///
+	#ifndef EASTL_ARENA_MAX_CHUNK_SIZE
+		#define EASTL_ARENA_MAX_CHUNK_SIZE (1024 * 1024)
+	#endif
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// arena
+	///////////////////////////////////////////////////////////////////////////
+
+	/// arena
+	///
+	/// Allocation bumps a pointer through the current chunk. When the chunk is
+	/// full, the arena moves to a spare chunk left over from an earlier rewind,
+	/// or allocates a new chunk from its overflow allocator.
+	///
+	/// An arena can start with a user-supplied buffer, such as one on the stack,
+	/// which it uses before allocating any chunks. The arena doesn't free it.
+	///
+	/// Rewinding to a marker makes all memory allocated since the marker available
+	/// again, so it must not be done while anything allocated since the marker,
+	/// such as a container, still uses its memory. The same applies to reset.
+	///
+	/// An arena is not thread-safe, in the same way that containers aren't.
+	///
+	/// Example usage:
+	///     char buffer[4096];
+	///     eastl::arena frameArena(buffer, sizeof(buffer));
+	///
+	///     for(each frame)
+	///     {
+	///         {
+	///             eastl::vector<Widget*, eastl::arena_allocator> visibleWidgets(eastl::arena_allocator(&frameArena));
+	///             ...
+	///         }
+	///         frameArena.reset();
+	///     }
+	///
+	class EASTL_API arena
+	{
+	public:
+		/// A position in an arena, which the arena can be rewound to.
+		struct marker
+		{
+			void* mpChunk;
+			char* mpCurrent;
+		};
+
+		explicit arena(size_t nChunkSize = EASTL_ARENA_DEFAULT_CHUNK_SIZE, const EASTLAllocatorType& allocator = EASTLAllocatorType(EASTL_ARENA_DEFAULT_NAME));
+		arena(void* pBuffer, size_t nBufferSize, size_t nChunkSize = EASTL_ARENA_DEFAULT_CHUNK_SIZE, const EASTLAllocatorType& allocator = EASTLAllocatorType(EASTL_ARENA_DEFAULT_NAME));
+	   ~arena();
+
+		void* allocate(size_t n, size_t alignment = EASTL_ALLOCATOR_MIN_ALIGNMENT, size_t offset = 0);
+
+		/// Grows the block p of oldSize bytes to newSize bytes where it is, which is
+		/// possible if it's the most recent allocation and there is room after it.
+		/// Returns false otherwise. A vector which is the last thing allocated from
+		/// an arena thus grows without copying its elements.
+		bool try_expand(void* p, size_t oldSize, size_t newSize);
+
+		marker mark() const;
+		void   rewind(const marker& m);
+
+		/// Rewinds the arena to its start. Its chunks are kept for reuse.
+		void reset();
+
+		/// Resets the arena and frees its chunks.
+		void release();
+
+		size_t chunk_count() const { return mnChunkCount; } // The number of chunks allocated from the overflow allocator, including spare chunks.
+
+		EASTLAllocatorType&       get_allocator()       { return mAllocator; }
+		const EASTLAllocatorType& get_allocator() const { return mAllocator; }
+
+		bool validate() const;
+
+	protected:
+		struct Chunk
+		{
+			Chunk* mpPrev;   // The chunk which was in use before this one, or the next spare chunk.
+			size_t mnSize;   // The size of the chunk's memory, including this header.
+		};
+
+		void* DoAllocateSlow(size_t n, size_t alignment, size_t offset);
+
+	private:
+		arena(const arena&);
+		arena& operator=(const arena&);
+
+	protected:
+		char*              mpCurrent;       // The next free byte in the current chunk or buffer.
+		char*              mpEnd;           // The end of the current chunk or buffer.
+		Chunk*             mpChunk;         // The current chunk, or NULL while we are in the buffer.
+		Chunk*             mpSpareChunks;   // Chunks which were rewound past, linked by mpPrev.
+		char*              mpBuffer;
+		size_t             mnBufferSize;
+		size_t             mnChunkSize;     // The size of the next new chunk.
+		size_t             mnChunkCount;
+		EASTLAllocatorType mAllocator;
+	};
+
+
+	inline void* arena::allocate(size_t n, size_t alignment, size_t offset)
+	{
+		EASTL_ASSERT((alignment & (alignment - 1)) == 0); // Alignment must be a power of 2.
+
+		const uintptr_t nCurrent = reinterpret_cast<uintptr_t>(mpCurrent);
+		const uintptr_t nAligned = ((nCurrent + offset + (alignment - 1)) & ~(uintptr_t)(alignment - 1)) - offset;
+
+		if(EASTL_LIKELY(((nAligned + n) <= reinterpret_cast<uintptr_t>(mpEnd)) && mpEnd))
+		{
+			mpCurrent = reinterpret_cast<char*>(nAligned + n);
+			return reinterpret_cast<void*>(nAligned);
+		}
+
+		return DoAllocateSlow(n, alignment, offset);
+	}
+
+
+	inline bool arena::try_expand(void* p, size_t oldSize, size_t newSize)
+	{
+		char* const pBlock = static_cast<char*>(p);
+
+		if(((pBlock + oldSize) == mpCurrent) && (newSize <= (size_t)(mpEnd - pBlock)))
+		{
+			mpCurrent = pBlock + newSize;
+			return true;
+		}
+
+		return false;
+	}
+
+
+	inline arena::marker arena::mark() const
+	{
+		const marker m = { mpChunk, mpCurrent };
+		return m;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// arena_scope
+	///////////////////////////////////////////////////////////////////////////
+
+	/// arena_scope
+	///
+	/// Marks an arena on construction and rewinds it to the mark on destruction.
+	/// Containers which use the arena within the scope must be destroyed first.
+	///
+	/// Example usage:
+	///     {
+	///         eastl::arena_scope scope(requestArena);
+	///         eastl::hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, eastl::arena_allocator> counts(eastl::arena_allocator(&requestArena));
+	///         ...
+	///     }
+	///
+	class arena_scope
+	{
+	public:
+		explicit arena_scope(arena& a)
+			: mArena(a), mMarker(a.mark()) { }
+
+	   ~arena_scope()
+			{ mArena.rewind(mMarker); }
+
+	private:
+		arena_scope(const arena_scope&);
+		arena_scope& operator=(const arena_scope&);
+
+		arena&        mArena;
+		arena::marker mMarker;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// arena_allocator
+	///////////////////////////////////////////////////////////////////////////
+
+	/// arena_allocator
+	///
+	/// An EASTL allocator which allocates from an arena, and whose deallocate does
+	/// nothing. Copies use the same arena and compare equal.
+	///
+	/// A default-constructed arena_allocator has no arena and uses EASTLAllocatorType,
+	/// freeing its memory normally, so that containers which are default-constructed
+	/// and then given an arena with set_allocator work as expected. Changing the arena
+	/// of an allocator which has allocated memory is not allowed.
+	///
+	class arena_allocator
+	{
+	public:
+		EASTL_ALLOCATOR_EXPLICIT arena_allocator(const char* pName = EASTL_NAME_VAL(EASTL_ARENA_DEFAULT_NAME))
+			: mpArena(NULL)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_ARENA_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		EASTL_ALLOCATOR_EXPLICIT arena_allocator(arena* pArena, const char* pName = EASTL_NAME_VAL(EASTL_ARENA_DEFAULT_NAME))
+			: mpArena(pArena)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_ARENA_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		arena_allocator(const arena_allocator& x)
+			: mpArena(x.mpArena)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = x.mpName;
+			#endif
+		}
+
+		arena_allocator(const arena_allocator& x, const char* pName)
+			: mpArena(x.mpArena)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName ? pName : EASTL_ARENA_DEFAULT_NAME;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+		arena_allocator& operator=(const arena_allocator& x)
+		{
+			mpArena = x.mpArena;
+			#if EASTL_NAME_ENABLED
+				mpName = x.mpName;
+			#endif
+			return *this;
+		}
+
+		void* allocate(size_t n, int flags = 0)
+		{
+			if(mpArena)
+				return mpArena->allocate(n);
+
+			EASTLAllocatorType allocator(get_name());
+			return allocator.allocate(n, flags);
+		}
+
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+		{
+			if(mpArena)
+				return mpArena->allocate(n, alignment, offset);
+
+			EASTLAllocatorType allocator(get_name());
+			return allocator.allocate(n, alignment, offset, flags);
+		}
+
+		void deallocate(void* p, size_t n)
+		{
+			if(!mpArena)
+			{
+				EASTLAllocatorType allocator(get_name());
+				allocator.deallocate(p, n);
+			}
+		}
+
+		bool try_expand(void* p, size_t oldSize, size_t newSize)
+			{ return mpArena && mpArena->try_expand(p, oldSize, newSize); }
+
+		arena* get_arena() const
+			{ return mpArena; }
+
+		void set_arena(arena* pArena)
+			{ mpArena = pArena; }
+
+		const char* get_name() const
+		{
+			#if EASTL_NAME_ENABLED
+				return mpName;
+			#else
+				return EASTL_ARENA_DEFAULT_NAME;
+			#endif
+		}
+
+		void set_name(const char* pName)
+		{
+			#if EASTL_NAME_ENABLED
+				mpName = pName;
+			#else
+				EA_UNUSED(pName);
+			#endif
+		}
+
+	protected:
+		arena* mpArena;
+
+		#if EASTL_NAME_ENABLED
+			const char* mpName; // Debug name, used to track memory.
+		#endif
+	};
+
+	inline bool operator==(const arena_allocator& a, const arena_allocator& b)
+	{
+		return a.get_arena() == b.get_arena();
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	inline bool operator!=(const arena_allocator& a, const arena_allocator& b)
+	{
+		return a.get_arena() != b.get_arena();
+	}
+#endif
+
+	template <> struct is_trivially_relocatable<arena_allocator> : public true_type {};
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
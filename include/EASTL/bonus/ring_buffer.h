@@ -332,6 +332,8 @@ namespace eastl
 		//size_type DoGetSize(eastl::input_iterator_tag) const;
 		//size_type DoGetSize(eastl::random_access_iterator_tag) const;
 
+		void DoGrow(size_type n);
+
 	}; // class ring_buffer
 
 
@@ -1032,33 +1034,21 @@ namespace eastl
 		EASTL_ASSERT(c.size() >= 1);
 		const size_type cap = (c.size() - 1);
 
-		mSize = n;
-
 		if(n > cap) // If we need to grow in capacity...
 		{
-			// Given that a growing operation will always result in memory allocation, 
-			// we currently implement this function via the usage of a temp container.
-			// This makes for a simple implementation, but in some cases it is less
-			// efficient. In particular, if the container is a node-based container like
-			// a (linked) list, this function would be faster if we simply added nodes
-			// to ourself. We would do this by inserting the nodes to be after end()
-			// and adjusting the begin() position if it was after end().
+			DoGrow(n);
 
-			// To do: This code needs to be amended to deal with possible exceptions 
-			// that could occur during the resize call below.
+			// The container now has n + 1 slots, so the end is the slot before mBegin, which is
+			// at the end of the container if mBegin is at its beginning.
+			const size_type nBegin = (size_type)eastl::distance(c.begin(), mBegin);
 
-			ContainerTemporary<Container> cTemp(c);
-			cTemp.get().resize(n + 1);
-			eastl::copy(begin(), end(), cTemp.get().begin());
-			eastl::swap(c, cTemp.get());
-
-			mBegin = c.begin();
-			mEnd   = mBegin;
-			eastl::advance(mEnd, n); // We can do a simple advance algorithm on this because we know that mEnd will not wrap around.
+			mSize = n;
+			mEnd  = eastl::next(c.begin(), (difference_type)((nBegin + n) % (n + 1)));
 		}
 		else // We could do a check here for n != size(), but that would be costly and people don't usually resize things to their same size.
 		{
-			mEnd = mBegin;
+			mSize = n;
+			mEnd  = mBegin;
 
 			// eastl::advance(mEnd, n); // We *cannot* use this because there may be wraparound involved.
 
@@ -1090,7 +1080,9 @@ namespace eastl
 	{
 		const size_type capacity = (c.size() - 1);
 
-		if(n != capacity)    // If we need to change capacity...
+		if(n > capacity)     // If we need to grow in capacity...
+			DoGrow(n);
+		else if(n != capacity)    // If we need to change capacity...
 		{
 			ContainerTemporary<Container> cTemp(c);
 			cTemp.get().resize(n + 1);
@@ -1120,13 +1112,37 @@ namespace eastl
 		EASTL_ASSERT(c.size() >= 1);
 
 		if(n > (c.size() - 1))    // If we need to grow in capacity... // (c.size() - 1) == capacity(); we are attempting to reduce function calls.
-		{
-			ContainerTemporary<Container> cTemp(c);
-			cTemp.get().resize(n + 1);
-			eastl::copy(begin(), end(), cTemp.get().begin());
-			eastl::swap(c, cTemp.get());
+			DoGrow(n);
+	}
 
-			mBegin = c.begin();
+
+	template <typename T, typename Container, typename Allocator>
+	void ring_buffer<T, Container, Allocator>::DoGrow(size_type n)
+	{
+		// Grows the capacity to n, which is larger than the current capacity. We grow the
+		// container itself, which keeps the values at their positions; a vector relocates
+		// them with memcpy if they are trivially relocatable, or doesn't move them at all if
+		// its allocator can grow its memory in place, and a list just adds nodes. If the
+		// values wrap around the end of the container, we then move the ones at its end to
+		// its new end, so that the added slots lie between mEnd and mBegin.
+
+		// To do: This code needs to be amended to deal with possible exceptions 
+		// that could occur during the resize call below.
+
+		const size_type nBegin         = (size_type)eastl::distance(c.begin(), mBegin);
+		const size_type nEnd           = (size_type)eastl::distance(c.begin(), mEnd);
+		const size_type nContainerSize = (size_type)c.size();
+
+		c.resize(n + 1);
+
+		if(nEnd < nBegin) // If the values wrap around...
+		{
+			mBegin = eastl::move_backward(eastl::next(c.begin(), (difference_type)nBegin), eastl::next(c.begin(), (difference_type)nContainerSize), c.end());
+			mEnd   = eastl::next(c.begin(), (difference_type)nEnd);
+		}
+		else
+		{
+			mBegin = eastl::next(c.begin(), (difference_type)nBegin);
 			mEnd   = mBegin;
 			eastl::advance(mEnd, mSize); // We can do a simple advance algorithm on this because we know that mEnd will not wrap around.
 		}
@@ -0,0 +1,681 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_BTREE_MAP_H
+#define EASTL_BTREE_MAP_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/btree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#if EASTL_EXCEPTIONS_ENABLED
+#include <stdexcept>
+#endif
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_BTREE_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_MAP_DEFAULT_NAME
+		#define EASTL_BTREE_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_map" // Unless the user overrides something, this is "EASTL btree_map".
+	#endif
+
+
+	/// EASTL_BTREE_MULTIMAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_MULTIMAP_DEFAULT_NAME
+		#define EASTL_BTREE_MULTIMAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_multimap" // Unless the user overrides something, this is "EASTL btree_multimap".
+	#endif
+
+
+	/// EASTL_BTREE_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_MAP_DEFAULT_NAME)
+	#endif
+
+	/// EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_MULTIMAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// btree_map
+	///
+	/// Implements a map with the interface of eastl::map, stored in a B-tree instead
+	/// of a red-black tree. Each node holds many values in a sorted array, which makes
+	/// lookups and iteration much more cache friendly and cuts the per-value memory
+	/// overhead, at the cost of iterator stability.
+	///
+	/// The large majority of the implementation of this class is found in the btree
+	/// base class. See btree for details.
+	///
+	/// Iterator invalidation
+	/// Unlike map, any insertion or erasure invalidates all iterators, pointers and
+	/// references into the container, because values move between and within nodes.
+	/// The iterators returned by insert, emplace, try_emplace and erase are valid.
+	///
+	/// Node size
+	/// nTargetNodeSize is the size in bytes that a node aims for. The default of
+	/// EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE (256) is a good fit for small keys and values.
+	/// For large values, a node holds a minimum of 3 values regardless of the target.
+	///
+	/// Pool allocation
+	/// Nodes come in two sizes, sizeof(btree_map::node_type) for leaves and
+	/// sizeof(btree_map::internal_node_type) for internal nodes, and both are much larger
+	/// than a map node. A pool allocator for btree_map needs to serve both sizes.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType, size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_map
+		: public btree<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> >, true, true, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, eastl::pair<const Key, T>, Compare, Allocator,
+					  eastl::use_first<eastl::pair<const Key, T> >, true, true, nTargetNodeSize>   base_type;
+		typedef btree_map<Key, T, Compare, Allocator, nTargetNodeSize>                            this_type;
+		typedef typename base_type::size_type                                                     size_type;
+		typedef typename base_type::key_type                                                      key_type;
+		typedef T                                                                                 mapped_type;
+		typedef typename base_type::value_type                                                    value_type;
+		typedef typename base_type::node_type                                                     node_type;
+		typedef typename base_type::iterator                                                      iterator;
+		typedef typename base_type::const_iterator                                                const_iterator;
+		typedef typename base_type::allocator_type                                                allocator_type;
+		typedef typename base_type::insert_return_type                                            insert_return_type;
+		typedef typename base_type::extract_key                                                   extract_key;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+
+		static_assert(!is_const<value_type>::value, "btree_map<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "btree_map<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class btree_map;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		btree_map(const allocator_type& allocator = EASTL_BTREE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		btree_map(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		btree_map(const this_type& x)
+			: base_type(x) { }
+		btree_map(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		btree_map(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		btree_map(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		btree_map(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		btree_map(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_MAP_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		/// This is an extension to the C++ standard. We insert a default-constructed
+		/// element with the given key. See map::insert(const Key&).
+		insert_return_type insert(const Key& key) { return try_emplace(key); }
+
+		// Standard conversion overload to avoid the overhead of mismatched 'pair<const Key, Value>' types.
+		template <typename P, eastl::enable_if_t<eastl::is_constructible_v<value_type, P&&>, bool> = true>
+		insert_return_type insert(P&& otherValue) { return base_type::emplace(eastl::forward<P>(otherValue)); }
+
+		value_compare value_comp() const { return value_compare(get_compare()); }
+
+		size_type erase(const Key& key) { return DoErase(key); }
+
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& key) { return DoErase(eastl::forward<KX>(key)); }
+
+		size_type count(const Key& key) const { return (find(key) != end()) ? 1 : 0; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return (find(key) != end()) ? 1 : 0; }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		T& operator[](const Key& key) { return try_emplace_forward(key).first->second; }
+		T& operator[](Key&& key)      { return try_emplace_forward(eastl::move(key)).first->second; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		T& operator[](KX&& key) { return try_emplace_forward(eastl::forward<KX>(key)).first->second; }
+
+		T& at(const Key& key) { return DoAt(key); }
+		const T& at(const Key& key) const { return DoAt(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		T& at(const KX& key) { return DoAt(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const T& at(const KX& key) const { return DoAt(key); }
+
+		template <class... Args> eastl::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) { return try_emplace_forward(k, eastl::forward<Args>(args)...); }
+		template <class... Args> eastl::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) { return try_emplace_forward(eastl::move(k), eastl::forward<Args>(args)...); }
+		template <class KX, class... Args, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, const_iterator> && !eastl::is_convertible_v<KX&&, iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, bool> try_emplace(KX&& k, Args&&... args) { return try_emplace_forward(eastl::forward<KX>(k), eastl::forward<Args>(args)...); }
+		template <class... Args> iterator                    try_emplace(const_iterator hint, const key_type& k, Args&&... args) { return try_emplace_forward(hint, k, eastl::forward<Args>(args)...); }
+		template <class... Args> iterator                    try_emplace(const_iterator hint, key_type&& k, Args&&... args) { return try_emplace_forward(hint, eastl::move(k), eastl::forward<Args>(args)...); }
+		template <class KX, class... Args, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator                    try_emplace(const_iterator hint, KX&& k, Args&&... args) { return try_emplace_forward(hint, eastl::forward<KX>(k), eastl::forward<Args>(args)...); }
+
+		template <class M> eastl::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) { return DoInsertOrAssign(k, eastl::forward<M>(obj)); }
+		template <class M> eastl::pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj) { return DoInsertOrAssign(eastl::move(k), eastl::forward<M>(obj)); }
+		template<typename KX, typename M, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, bool> insert_or_assign(KX&& k, M&& obj) { return DoInsertOrAssign(eastl::forward<KX>(k), eastl::forward<M>(obj)); }
+		template <class M> iterator insert_or_assign(const_iterator hint, const key_type& k, M&& obj) { return DoInsertOrAssign(hint, k, eastl::forward<M>(obj)); }
+		template <class M> iterator insert_or_assign(const_iterator hint, key_type&& k, M&& obj) { return DoInsertOrAssign(hint, eastl::move(k), eastl::forward<M>(obj)); }
+		template<typename KX, typename M, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator insert_or_assign(const_iterator hint, KX&& k, M&& obj) { return DoInsertOrAssign(hint, eastl::forward<KX>(k), eastl::forward<M>(obj)); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& key);
+
+		template <class KFwd, class... Args>
+		eastl::pair<iterator, bool> try_emplace_forward(KFwd&& k, Args&&... args);
+
+		template <class KFwd, class... Args>
+		iterator try_emplace_forward(const_iterator hint, KFwd&& key, Args&&... args);
+
+		template<typename KX, typename M>
+		eastl::pair<iterator, bool> DoInsertOrAssign(KX&& k, M&& obj);
+		template<typename KX, typename M>
+		iterator                    DoInsertOrAssign(const_iterator hint, KX&& k, M&& obj);
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+
+		template<typename KX>
+		T& DoAt(const KX& key);
+		template<typename KX>
+		const T& DoAt(const KX& key) const;
+	}; // btree_map
+
+
+
+
+
+
+	/// btree_multimap
+	///
+	/// Implements a multimap with the interface of eastl::multimap, stored in a B-tree.
+	/// See btree_map for the differences from the red-black tree containers, most
+	/// importantly that insertion and erasure invalidate all iterators.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType, size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_multimap
+		: public btree<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> >, true, false, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, eastl::pair<const Key, T>, Compare, Allocator,
+					  eastl::use_first<eastl::pair<const Key, T> >, true, false, nTargetNodeSize>  base_type;
+		typedef btree_multimap<Key, T, Compare, Allocator, nTargetNodeSize>                       this_type;
+		typedef typename base_type::size_type                                                     size_type;
+		typedef typename base_type::key_type                                                      key_type;
+		typedef T                                                                                 mapped_type;
+		typedef typename base_type::value_type                                                    value_type;
+		typedef typename base_type::node_type                                                     node_type;
+		typedef typename base_type::iterator                                                      iterator;
+		typedef typename base_type::const_iterator                                                const_iterator;
+		typedef typename base_type::allocator_type                                                allocator_type;
+		typedef typename base_type::insert_return_type                                            insert_return_type;
+		typedef typename base_type::extract_key                                                   extract_key;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+
+		static_assert(!is_const<value_type>::value, "btree_multimap<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "btree_multimap<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class btree_multimap;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		btree_multimap(const allocator_type& allocator = EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		btree_multimap(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		btree_multimap(const this_type& x)
+			: base_type(x) { }
+		btree_multimap(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		btree_multimap(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		btree_multimap(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		btree_multimap(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		btree_multimap(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_MULTIMAP_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		/// This is an extension to the C++ standard. We insert a default-constructed
+		/// element with the given key. See multimap::insert(const Key&).
+		insert_return_type insert(const Key& key) { return base_type::DoEmplaceAt(base_type::DoGetKeyInsertionPositionNonuniqueKeys(key), key, T()); }
+
+		// Standard conversion overload to avoid the overhead of mismatched 'pair<const Key, Value>' types.
+		template <typename P, eastl::enable_if_t<eastl::is_constructible_v<value_type, P&&>, bool> = true>
+		insert_return_type insert(P&& otherValue) { return base_type::emplace(eastl::forward<P>(otherValue)); }
+
+		value_compare value_comp() const { return value_compare(get_compare()); }
+
+		size_type erase(const Key& key) { return DoErase(key); }
+
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& key) { return DoErase(eastl::forward<KX>(key)); }
+
+		size_type count(const Key& key) const { return DoCount(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return DoCount(key); }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		/// equal_range_small
+		/// This is a special version of equal_range which is optimized for the
+		/// case of there being few or no duplicated keys in the tree.
+		eastl::pair<iterator, iterator>             equal_range_small(const Key& key) { return DoEqualRangeSmall(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const Key& key) const { return DoEqualRangeSmall(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range_small(const KX& key) { return DoEqualRangeSmall(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const KX& key) const { return DoEqualRangeSmall(key); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& key);
+
+		template<typename KX>
+		size_type DoCount(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRangeSmall(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRangeSmall(const KX& key) const;
+	}; // btree_multimap
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_map
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline typename btree_map<Key, T, Compare, Allocator, nS>::size_type
+	btree_map<Key, T, Compare, Allocator, nS>::DoErase(KX&& key)
+	{
+		const iterator it(find(key));
+
+		if(it != end()) // If it exists...
+		{
+			base_type::erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <class KFwd, class... Args>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, nS>::iterator, bool>
+	btree_map<Key, T, Compare, Allocator, nS>::try_emplace_forward(KFwd&& key, Args&&... args)
+	{
+		bool canInsert;
+		const iterator itPosition(base_type::DoGetKeyInsertionPositionUniqueKeys(canInsert, key));
+
+		if(!canInsert)
+			return eastl::pair<iterator, bool>(itPosition, false);
+
+		// The value is constructed in place in the tree, with no temporary.
+		return eastl::pair<iterator, bool>(base_type::DoEmplaceAt(itPosition, piecewise_construct, eastl::forward_as_tuple(eastl::forward<KFwd>(key)),
+		                                                          eastl::forward_as_tuple(eastl::forward<Args>(args)...)), true);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <class KFwd, class... Args>
+	inline typename btree_map<Key, T, Compare, Allocator, nS>::iterator
+	btree_map<Key, T, Compare, Allocator, nS>::try_emplace_forward(const_iterator hint, KFwd&& key, Args&&... args)
+	{
+		bool canInsert;
+		const iterator itPosition(base_type::DoGetKeyInsertionPositionUniqueKeysHint(hint, canInsert, key));
+
+		if(!canInsert)
+			return itPosition;
+
+		return base_type::DoEmplaceAt(itPosition, piecewise_construct, eastl::forward_as_tuple(eastl::forward<KFwd>(key)),
+		                              eastl::forward_as_tuple(eastl::forward<Args>(args)...));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX, typename M>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, nS>::iterator, bool>
+	btree_map<Key, T, Compare, Allocator, nS>::DoInsertOrAssign(KX&& key, M&& obj)
+	{
+		bool canInsert;
+		const iterator itPosition(base_type::DoGetKeyInsertionPositionUniqueKeys(canInsert, key));
+
+		if(!canInsert)
+		{
+			itPosition->second = eastl::forward<M>(obj);
+			return eastl::pair<iterator, bool>(itPosition, false);
+		}
+
+		return eastl::pair<iterator, bool>(base_type::DoEmplaceAt(itPosition, eastl::forward<KX>(key), eastl::forward<M>(obj)), true);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX, typename M>
+	inline typename btree_map<Key, T, Compare, Allocator, nS>::iterator
+	btree_map<Key, T, Compare, Allocator, nS>::DoInsertOrAssign(const_iterator hint, KX&& key, M&& obj)
+	{
+		bool canInsert;
+		const iterator itPosition(base_type::DoGetKeyInsertionPositionUniqueKeysHint(hint, canInsert, key));
+
+		if(!canInsert)
+		{
+			itPosition->second = eastl::forward<M>(obj);
+			return itPosition;
+		}
+
+		return base_type::DoEmplaceAt(itPosition, eastl::forward<KX>(key), eastl::forward<M>(obj));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, nS>::iterator,
+					   typename btree_map<Key, T, Compare, Allocator, nS>::iterator>
+	btree_map<Key, T, Compare, Allocator, nS>::DoEqualRange(const KX& key)
+	{
+		// The resulting range will either be empty or have one element,
+		// so we do just lower_bound and see if the result is a range of size zero or one.
+		const iterator itLower(lower_bound(key));
+
+		if((itLower == end()) || compare(key, itLower->first)) // If at the end or if (key is < itLower)...
+			return eastl::pair<iterator, iterator>(itLower, itLower);
+
+		iterator itUpper(itLower);
+		return eastl::pair<iterator, iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_map<Key, T, Compare, Allocator, nS>::const_iterator,
+					   typename btree_map<Key, T, Compare, Allocator, nS>::const_iterator>
+	btree_map<Key, T, Compare, Allocator, nS>::DoEqualRange(const KX& key) const
+	{
+		// See DoEqualRange above for comments.
+		const const_iterator itLower(lower_bound(key));
+
+		if((itLower == end()) || compare(key, itLower->first)) // If at the end or if (key is < itLower)...
+			return eastl::pair<const_iterator, const_iterator>(itLower, itLower);
+
+		const_iterator itUpper(itLower);
+		return eastl::pair<const_iterator, const_iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline T& btree_map<Key, T, Compare, Allocator, nS>::DoAt(const KX& key)
+	{
+		// use the use const version of ::DoAt to remove duplication
+		return const_cast<T&>(const_cast<this_type const*>(this)->DoAt(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline const T& btree_map<Key, T, Compare, Allocator, nS>::DoAt(const KX& key) const
+	{
+		const_iterator candidate = this->find(key);
+
+		if(candidate == end())
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				throw std::out_of_range("btree_map::at key does not exist");
+			#else
+				EASTL_FAIL_MSG("btree_map::at key does not exist");
+			#endif
+		}
+
+		return candidate->second;
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/map/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class T, class Compare, class Allocator, size_t nS, class Predicate>
+	typename btree_map<Key, T, Compare, Allocator, nS>::size_type erase_if(btree_map<Key, T, Compare, Allocator, nS>& c, Predicate predicate)
+	{
+		// erase returns a valid iterator to the next value, so this is safe even though erasure invalidates iterators.
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_multimap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline typename btree_multimap<Key, T, Compare, Allocator, nS>::size_type
+	btree_multimap<Key, T, Compare, Allocator, nS>::DoErase(KX&& key)
+	{
+		const eastl::pair<iterator, iterator> range(DoEqualRange(key));
+		const size_type n = (size_type)eastl::distance(range.first, range.second);
+		base_type::erase(range.first, range.second);
+		return n;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline typename btree_multimap<Key, T, Compare, Allocator, nS>::size_type
+	btree_multimap<Key, T, Compare, Allocator, nS>::DoCount(const KX& key) const
+	{
+		const eastl::pair<const_iterator, const_iterator> range(DoEqualRange(key));
+		return (size_type)eastl::distance(range.first, range.second);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multimap<Key, T, Compare, Allocator, nS>::iterator,
+					   typename btree_multimap<Key, T, Compare, Allocator, nS>::iterator>
+	btree_multimap<Key, T, Compare, Allocator, nS>::DoEqualRange(const KX& key)
+	{
+		return eastl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multimap<Key, T, Compare, Allocator, nS>::const_iterator,
+					   typename btree_multimap<Key, T, Compare, Allocator, nS>::const_iterator>
+	btree_multimap<Key, T, Compare, Allocator, nS>::DoEqualRange(const KX& key) const
+	{
+		return eastl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multimap<Key, T, Compare, Allocator, nS>::iterator,
+					   typename btree_multimap<Key, T, Compare, Allocator, nS>::iterator>
+	btree_multimap<Key, T, Compare, Allocator, nS>::DoEqualRangeSmall(const KX& key)
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const iterator itLower(lower_bound(key));
+		iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(key, itUpper->first))
+			++itUpper;
+
+		return eastl::pair<iterator, iterator>(itLower, itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multimap<Key, T, Compare, Allocator, nS>::const_iterator,
+					   typename btree_multimap<Key, T, Compare, Allocator, nS>::const_iterator>
+	btree_multimap<Key, T, Compare, Allocator, nS>::DoEqualRangeSmall(const KX& key) const
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const const_iterator itLower(lower_bound(key));
+		const_iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(key, itUpper->first))
+			++itUpper;
+
+		return eastl::pair<const_iterator, const_iterator>(itLower, itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/multimap/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class T, class Compare, class Allocator, size_t nS, class Predicate>
+	typename btree_multimap<Key, T, Compare, Allocator, nS>::size_type erase_if(btree_multimap<Key, T, Compare, Allocator, nS>& c, Predicate predicate)
+	{
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
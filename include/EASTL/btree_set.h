@@ -0,0 +1,479 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_BTREE_SET_H
+#define EASTL_BTREE_SET_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/btree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_BTREE_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_SET_DEFAULT_NAME
+		#define EASTL_BTREE_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_set" // Unless the user overrides something, this is "EASTL btree_set".
+	#endif
+
+
+	/// EASTL_BTREE_MULTISET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_MULTISET_DEFAULT_NAME
+		#define EASTL_BTREE_MULTISET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree_multiset" // Unless the user overrides something, this is "EASTL btree_multiset".
+	#endif
+
+
+	/// EASTL_BTREE_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_SET_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_SET_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_MULTISET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// btree_set
+	///
+	/// Implements a set with the interface of eastl::set, stored in a B-tree instead
+	/// of a red-black tree. See btree_map for the trade-offs, most importantly that
+	/// any insertion or erasure invalidates all iterators, pointers and references.
+	///
+	/// As with set, btree_set::iterator is const and the same as btree_set::const_iterator.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType, size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_set
+		: public btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, true, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, true, nTargetNodeSize> base_type;
+		typedef btree_set<Key, Compare, Allocator, nTargetNodeSize>                                     this_type;
+		typedef typename base_type::size_type                                                           size_type;
+		typedef typename base_type::value_type                                                          value_type;
+		typedef typename base_type::iterator                                                            iterator;
+		typedef typename base_type::const_iterator                                                      const_iterator;
+		typedef typename base_type::reverse_iterator                                                    reverse_iterator;
+		typedef typename base_type::const_reverse_iterator                                              const_reverse_iterator;
+		typedef typename base_type::allocator_type                                                      allocator_type;
+		typedef Compare                                                                                 value_compare;
+		typedef typename base_type::insert_return_type                                                  insert_return_type;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+
+		static_assert(!is_const<value_type>::value, "btree_set<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "btree_set<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		btree_set(const allocator_type& allocator = EASTL_BTREE_SET_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		btree_set(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_SET_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		btree_set(const this_type& x)
+			: base_type(x) { }
+		btree_set(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		btree_set(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		btree_set(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_SET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		btree_set(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		btree_set(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_SET_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		value_compare value_comp() const { return get_compare(); }
+
+		size_type erase(const Key& k) { return DoErase(k); }
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& k) { return DoErase(eastl::forward<KX>(k)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		insert_return_type insert(KX&& key)
+		{
+			// Heterogeneous insertion only constructs a key_type if the key isn't already present.
+			bool canInsert;
+			const iterator itPosition(base_type::DoGetKeyInsertionPositionUniqueKeys(canInsert, key));
+
+			if(canInsert)
+				return eastl::pair<iterator, bool>(base_type::DoEmplaceAt(itPosition, eastl::forward<KX>(key)), true);
+
+			return eastl::pair<iterator, bool>(itPosition, false);
+		}
+
+		size_type count(const Key& k) const { return (find(k) != end()) ? 1 : 0; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return (find(key) != end()) ? 1 : 0; }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& k);
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+	}; // btree_set
+
+
+
+
+
+	/// btree_multiset
+	///
+	/// Implements a multiset with the interface of eastl::multiset, stored in a B-tree.
+	/// See btree_map for the trade-offs, most importantly that any insertion or erasure
+	/// invalidates all iterators, pointers and references.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType, size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree_multiset
+		: public btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, false, nTargetNodeSize>
+	{
+	public:
+		typedef btree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, false, nTargetNodeSize> base_type;
+		typedef btree_multiset<Key, Compare, Allocator, nTargetNodeSize>                                 this_type;
+		typedef typename base_type::size_type                                                            size_type;
+		typedef typename base_type::value_type                                                           value_type;
+		typedef typename base_type::iterator                                                             iterator;
+		typedef typename base_type::const_iterator                                                       const_iterator;
+		typedef typename base_type::reverse_iterator                                                     reverse_iterator;
+		typedef typename base_type::const_reverse_iterator                                               const_reverse_iterator;
+		typedef typename base_type::allocator_type                                                       allocator_type;
+		typedef Compare                                                                                  value_compare;
+		typedef typename base_type::insert_return_type                                                   insert_return_type;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+
+		static_assert(!is_const<value_type>::value, "btree_multiset<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "btree_multiset<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		btree_multiset(const allocator_type& allocator = EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		btree_multiset(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		btree_multiset(const this_type& x)
+			: base_type(x) { }
+		btree_multiset(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		btree_multiset(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		btree_multiset(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		btree_multiset(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		btree_multiset(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_BTREE_MULTISET_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		value_compare value_comp() const { return get_compare(); }
+
+		size_type erase(const Key& k) { return DoErase(k); }
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& k) { return DoErase(eastl::forward<KX>(k)); }
+
+		size_type count(const Key& key) const { return DoCount(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return DoCount(key); }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		/// equal_range_small
+		/// This is a special version of equal_range which is optimized for the
+		/// case of there being few or no duplicated keys in the tree.
+		eastl::pair<iterator, iterator>             equal_range_small(const Key& key) { return DoEqualRangeSmall(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const Key& key) const { return DoEqualRangeSmall(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range_small(const KX& key) { return DoEqualRangeSmall(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const KX& key) const { return DoEqualRangeSmall(key); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& k);
+
+		template<typename KX>
+		size_type DoCount(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRangeSmall(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRangeSmall(const KX& key) const;
+	}; // btree_multiset
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_set
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline typename btree_set<Key, Compare, Allocator, nS>::size_type
+	btree_set<Key, Compare, Allocator, nS>::DoErase(KX&& k)
+	{
+		const iterator it(find(k));
+
+		if(it != end()) // If it exists...
+		{
+			base_type::erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_set<Key, Compare, Allocator, nS>::iterator,
+					   typename btree_set<Key, Compare, Allocator, nS>::iterator>
+	btree_set<Key, Compare, Allocator, nS>::DoEqualRange(const KX& k)
+	{
+		// The resulting range will either be empty or have one element,
+		// so we do just lower_bound and see if the result is a range of size zero or one.
+		const iterator itLower(lower_bound(k));
+
+		if((itLower == end()) || compare(k, *itLower)) // If at the end or if (k is < itLower)...
+			return eastl::pair<iterator, iterator>(itLower, itLower);
+
+		iterator itUpper(itLower);
+		return eastl::pair<iterator, iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_set<Key, Compare, Allocator, nS>::const_iterator,
+					   typename btree_set<Key, Compare, Allocator, nS>::const_iterator>
+	btree_set<Key, Compare, Allocator, nS>::DoEqualRange(const KX& k) const
+	{
+		// See DoEqualRange above for comments.
+		const const_iterator itLower(lower_bound(k));
+
+		if((itLower == end()) || compare(k, *itLower)) // If at the end or if (k is < itLower)...
+			return eastl::pair<const_iterator, const_iterator>(itLower, itLower);
+
+		const_iterator itUpper(itLower);
+		return eastl::pair<const_iterator, const_iterator>(itLower, ++itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/set/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class Compare, class Allocator, size_t nS, class Predicate>
+	typename btree_set<Key, Compare, Allocator, nS>::size_type erase_if(btree_set<Key, Compare, Allocator, nS>& c, Predicate predicate)
+	{
+		// erase returns a valid iterator to the next value, so this is safe even though erasure invalidates iterators.
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree_multiset
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline typename btree_multiset<Key, Compare, Allocator, nS>::size_type
+	btree_multiset<Key, Compare, Allocator, nS>::DoErase(KX&& k)
+	{
+		const eastl::pair<iterator, iterator> range(DoEqualRange(k));
+		const size_type n = (size_type)eastl::distance(range.first, range.second);
+		base_type::erase(range.first, range.second);
+		return n;
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline typename btree_multiset<Key, Compare, Allocator, nS>::size_type
+	btree_multiset<Key, Compare, Allocator, nS>::DoCount(const KX& k) const
+	{
+		const eastl::pair<const_iterator, const_iterator> range(DoEqualRange(k));
+		return (size_type)eastl::distance(range.first, range.second);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multiset<Key, Compare, Allocator, nS>::iterator,
+					   typename btree_multiset<Key, Compare, Allocator, nS>::iterator>
+	btree_multiset<Key, Compare, Allocator, nS>::DoEqualRange(const KX& k)
+	{
+		return eastl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multiset<Key, Compare, Allocator, nS>::const_iterator,
+					   typename btree_multiset<Key, Compare, Allocator, nS>::const_iterator>
+	btree_multiset<Key, Compare, Allocator, nS>::DoEqualRange(const KX& k) const
+	{
+		return eastl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multiset<Key, Compare, Allocator, nS>::iterator,
+					   typename btree_multiset<Key, Compare, Allocator, nS>::iterator>
+	btree_multiset<Key, Compare, Allocator, nS>::DoEqualRangeSmall(const KX& k)
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const iterator itLower(lower_bound(k));
+		iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(k, *itUpper))
+			++itUpper;
+
+		return eastl::pair<iterator, iterator>(itLower, itUpper);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator, size_t nS>
+	template <typename KX>
+	inline eastl::pair<typename btree_multiset<Key, Compare, Allocator, nS>::const_iterator,
+					   typename btree_multiset<Key, Compare, Allocator, nS>::const_iterator>
+	btree_multiset<Key, Compare, Allocator, nS>::DoEqualRangeSmall(const KX& k) const
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const const_iterator itLower(lower_bound(k));
+		const_iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(k, *itUpper))
+			++itUpper;
+
+		return eastl::pair<const_iterator, const_iterator>(itLower, itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/multiset/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class Compare, class Allocator, size_t nS, class Predicate>
+	typename btree_multiset<Key, Compare, Allocator, nS>::size_type erase_if(btree_multiset<Key, Compare, Allocator, nS>& c, Predicate predicate)
+	{
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,713 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements concurrent_hash_map, a hash map that can be used from
+// multiple threads at once. Keys are partitioned across a fixed number of
+// shards, each of which is a hash_map protected by its own reader/writer
+// spin lock, so threads only contend when they access the same shard.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_CONCURRENT_HASH_MAP_H
+#define EASTL_CONCURRENT_HASH_MAP_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/atomic.h>
+#include <EASTL/bit.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME
+		#define EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " concurrent_hash_map" // Unless the user overrides something, this is "EASTL concurrent_hash_map".
+	#endif
+
+
+	/// EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_CONCURRENT_HASH_MAP_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT
+	///
+	/// The default number of shards of a concurrent_hash_map. It should be
+	/// comfortably larger than the number of threads that use the container
+	/// at the same time, so that two threads rarely need the same shard.
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT
+		#define EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT 64
+	#endif
+
+
+	/// EASTL_CONCURRENT_HASH_MAP_SHARD_ALIGNMENT
+	///
+	/// Each shard is aligned to this, which should be the cache line size, so that
+	/// locking one shard doesn't invalidate the cache line of a neighbouring shard.
+	///
+	#ifndef EASTL_CONCURRENT_HASH_MAP_SHARD_ALIGNMENT
+		#define EASTL_CONCURRENT_HASH_MAP_SHARD_ALIGNMENT 64
+	#endif
+
+
+
+	namespace internal
+	{
+		/// shared_spin_lock
+		///
+		/// A reader/writer spin lock. Any number of readers can hold the lock at
+		/// the same time, or a single writer. A waiting writer blocks new readers,
+		/// so a steady stream of readers can't starve writers.
+		///
+		/// This is intended for short critical sections only. Waiting threads spin
+		/// with cpu_pause, and only yield their time slice after spinning for a while,
+		/// in case the thread holding the lock has been preempted.
+		///
+		class shared_spin_lock
+		{
+		public:
+			shared_spin_lock() EA_NOEXCEPT : mState(0) { }
+
+			void lock() EA_NOEXCEPT
+			{
+				// Claim the writer bit, then wait for the current readers to leave.
+				for(int spinCount = 0; ; DoWait(spinCount))
+				{
+					uint32_t state = mState.load(eastl::memory_order_relaxed);
+
+					if(!(state & kWriterBit) && mState.compare_exchange_weak(state, state | kWriterBit, eastl::memory_order_acquire, eastl::memory_order_relaxed))
+						break;
+				}
+
+				for(int spinCount = 0; mState.load(eastl::memory_order_acquire) != kWriterBit; DoWait(spinCount))
+					{ }
+			}
+
+			bool try_lock() EA_NOEXCEPT
+			{
+				uint32_t state = 0;
+				return mState.compare_exchange_strong(state, kWriterBit, eastl::memory_order_acquire, eastl::memory_order_relaxed);
+			}
+
+			void unlock() EA_NOEXCEPT
+			{
+				mState.store(0, eastl::memory_order_release);
+			}
+
+			void lock_shared() EA_NOEXCEPT
+			{
+				for(int spinCount = 0; ; DoWait(spinCount))
+				{
+					uint32_t state = mState.load(eastl::memory_order_relaxed);
+
+					if(!(state & kWriterBit) && mState.compare_exchange_weak(state, state + 1, eastl::memory_order_acquire, eastl::memory_order_relaxed))
+						break;
+				}
+			}
+
+			void unlock_shared() EA_NOEXCEPT
+			{
+				mState.fetch_sub(1, eastl::memory_order_release);
+			}
+
+		protected:
+			static const uint32_t kWriterBit        = UINT32_C(0x80000000); // The low bits hold the reader count.
+			static const int      kSpinsBeforeYield = 64;
+
+			static void DoWait(int& spinCount) EA_NOEXCEPT
+			{
+				if(spinCount < kSpinsBeforeYield)
+				{
+					++spinCount;
+					eastl::cpu_pause();
+				}
+				else
+					Internal::thread_yield();
+			}
+
+			eastl::atomic<uint32_t> mState;
+
+			shared_spin_lock(const shared_spin_lock&) = delete;
+			void operator=(const shared_spin_lock&) = delete;
+		};
+
+
+		/// shared_spin_lock_guard
+		///
+		/// Holds a shared_spin_lock for the lifetime of the guard, exclusively or shared.
+		///
+		template <bool bShared>
+		class shared_spin_lock_guard
+		{
+		public:
+			explicit shared_spin_lock_guard(shared_spin_lock& lock) EA_NOEXCEPT : mLock(lock)
+				{ bShared ? mLock.lock_shared() : mLock.lock(); }
+
+			~shared_spin_lock_guard()
+				{ bShared ? mLock.unlock_shared() : mLock.unlock(); }
+
+		protected:
+			shared_spin_lock& mLock;
+
+			shared_spin_lock_guard(const shared_spin_lock_guard&) = delete;
+			void operator=(const shared_spin_lock_guard&) = delete;
+		};
+
+	} // namespace internal
+
+
+
+	/// concurrent_hash_map
+	///
+	/// A hash map with unique keys that supports concurrent access from multiple
+	/// threads without external locking. The keys are partitioned across
+	/// nShardCount shards by their hash code. Each shard is a hash_map with
+	/// its own internal::shared_spin_lock; lookups take a shard's lock shared
+	/// and modifications take it exclusively.
+	///
+	/// Because another thread may modify the container at any time, there are no
+	/// iterators and no references to elements are returned. Instead, lookups
+	/// copy the mapped value out (find) or run a user function on the element
+	/// while its shard is locked (visit, update). These functions must be short,
+	/// must not throw, and must not access the same concurrent_hash_map.
+	///
+	/// The key is hashed once per operation; the hash code is used to pick the
+	/// shard and is then passed to the shard's hash_map as a hashed_key.
+	///
+	/// size() and empty() lock the shards one at a time, so their result is
+	/// only a snapshot if other threads are modifying the container.
+	///
+	/// Example usage:
+	///     concurrent_hash_map<uint32_t, int> counters;
+	///
+	///     // From any number of threads:
+	///     counters.try_emplace_or_update(id, [](concurrent_hash_map<uint32_t, int>::value_type& v) { ++v.second; }, 1);
+	///
+	///     int count;
+	///     if(counters.find(id, count))
+	///         ...
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType, size_t nShardCount = EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT>
+	class concurrent_hash_map
+	{
+	public:
+		typedef hash_map<Key, T, Hash, Predicate, Allocator>                                    shard_map_type;
+		typedef concurrent_hash_map<Key, T, Hash, Predicate, Allocator, nShardCount>           this_type;
+		typedef typename shard_map_type::key_type                                               key_type;
+		typedef typename shard_map_type::mapped_type                                            mapped_type;
+		typedef typename shard_map_type::value_type                                             value_type;
+		typedef typename shard_map_type::size_type                                              size_type;
+		typedef typename shard_map_type::allocator_type                                         allocator_type;
+		typedef Hash                                                                            hasher;
+		typedef Predicate                                                                       key_equal;
+
+		static const size_type kShardCount = (size_type)nShardCount;
+
+		static_assert((nShardCount > 0) && ((nShardCount & (nShardCount - 1)) == 0), "concurrent_hash_map shard count must be a power of two.");
+		static_assert(nShardCount <= 65536, "concurrent_hash_map shard count must be no more than 65536.");
+
+	public:
+		explicit concurrent_hash_map(const allocator_type& allocator = EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: mHashFunction()
+		{
+			DoInit(0, Hash(), Predicate(), allocator);
+		}
+
+		/// concurrent_hash_map
+		///
+		/// Constructs an empty container in which each shard starts with nBucketCountPerShard buckets.
+		///
+		explicit concurrent_hash_map(size_type nBucketCountPerShard, const Hash& hashFunction = Hash(), const Predicate& predicate = Predicate(),
+									 const allocator_type& allocator = EASTL_CONCURRENT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: mHashFunction(hashFunction)
+		{
+			DoInit(nBucketCountPerShard, hashFunction, predicate, allocator);
+		}
+
+		~concurrent_hash_map()
+		{
+			for(size_type i = 0; i < kShardCount; i++)
+				GetShard(i).~shard_type();
+		}
+
+		// The container can't be copied or moved, as that couldn't be done atomically.
+		concurrent_hash_map(const this_type&) = delete;
+		this_type& operator=(const this_type&) = delete;
+
+		hasher     hash_function() const { return mHashFunction; }
+		key_equal  key_eq() const        { return GetShard(0).mMap.key_eq(); }
+		size_type  shard_count() const   { return kShardCount; }
+
+		size_type  size() const;
+		bool       empty() const;
+		void       clear();
+
+		/// reserve
+		///
+		/// Reserves room for nElementCount elements in total, assuming that they are spread evenly across the shards.
+		///
+		void       reserve(size_type nElementCount);
+
+		/// insert
+		///
+		/// Inserts value if there is no element with its key. Returns true if value was inserted.
+		///
+		bool insert(const value_type& value);
+		bool insert(value_type&& value);
+
+		/// try_emplace
+		///
+		/// Inserts an element constructed from k and args if there is no element with key k.
+		/// Returns true if the element was inserted.
+		///
+		template <typename... Args>
+		bool try_emplace(const key_type& k, Args&&... args);
+
+		/// insert_or_assign
+		///
+		/// Inserts an element with key k and mapped value obj, or assigns obj to the mapped
+		/// value of the existing element. Returns true if the element was inserted.
+		///
+		template <typename M>
+		bool insert_or_assign(const key_type& k, M&& obj);
+
+		/// find
+		///
+		/// Copies the mapped value of the element with key k to valueOut and returns true,
+		/// or returns false if there is no such element.
+		///
+		bool      find(const key_type& k, mapped_type& valueOut) const;
+		bool      contains(const key_type& k) const;
+		size_type count(const key_type& k) const { return contains(k) ? 1 : 0; }
+
+		size_type erase(const key_type& k);
+
+		/// visit
+		///
+		/// Calls function(const value_type&) on the element with key k while its shard
+		/// is locked for reading. Returns false if there is no such element.
+		///
+		template <typename Function>
+		bool visit(const key_type& k, Function function) const;
+
+		/// update
+		///
+		/// Calls function(value_type&) on the element with key k while its shard is
+		/// locked for writing, which allows the mapped value to be modified in place.
+		/// Returns false if there is no such element.
+		///
+		template <typename Function>
+		bool update(const key_type& k, Function function);
+
+		/// try_emplace_or_update
+		///
+		/// Inserts an element constructed from k and args if there is no element with key k,
+		/// otherwise calls function(value_type&) on the existing element. Both happen under
+		/// a single exclusive lock of the shard. Returns true if the element was inserted.
+		///
+		template <typename Function, typename... Args>
+		bool try_emplace_or_update(const key_type& k, Function function, Args&&... args);
+
+		/// erase_if
+		///
+		/// Erases the element with key k if predicate(const value_type&) returns true for it.
+		/// Returns the number of elements erased.
+		///
+		template <typename UserPredicate>
+		size_type erase_if(const key_type& k, UserPredicate predicate);
+
+		/// visit_all / update_all / erase_all_if
+		///
+		/// Apply a function to every element, one shard at a time. Elements that other threads
+		/// insert or erase in shards that haven't been processed yet may or may not be seen.
+		///
+		template <typename Function>
+		void visit_all(Function function) const;
+
+		template <typename Function>
+		void update_all(Function function);
+
+		template <typename UserPredicate>
+		size_type erase_all_if(UserPredicate predicate);
+
+		/// validate
+		///
+		/// Validates every shard, and that every element is stored in the shard its hash code maps to.
+		/// Must not be called while other threads modify the container.
+		///
+		bool validate() const;
+
+	protected:
+		typedef internal::shared_spin_lock_guard<true>  shared_lock_type;
+		typedef internal::shared_spin_lock_guard<false> exclusive_lock_type;
+
+		struct alignas(EASTL_CONCURRENT_HASH_MAP_SHARD_ALIGNMENT) shard_type
+		{
+			shard_type(size_type nBucketCount, const Hash& hashFunction, const Predicate& predicate, const allocator_type& allocator)
+				: mLock(), mMap(nBucketCount, hashFunction, predicate, allocator) { }
+
+			mutable internal::shared_spin_lock mLock;
+			shard_map_type                     mMap;
+		};
+
+		void DoInit(size_type nBucketCountPerShard, const Hash& hashFunction, const Predicate& predicate, const allocator_type& allocator)
+		{
+			size_type i = 0;
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+			#endif
+					for(; i < kShardCount; i++)
+						::new(static_cast<void*>(&GetShard(i))) shard_type(nBucketCountPerShard, hashFunction, predicate, allocator);
+			#if EASTL_EXCEPTIONS_ENABLED
+				}
+				catch(...)
+				{
+					while(i > 0) // Destroy the shards which were constructed, as our destructor won't be called.
+						GetShard(--i).~shard_type();
+					throw;
+				}
+			#endif
+		}
+
+		shard_type&       GetShard(size_type i)       { return reinterpret_cast<shard_type*>(mShardBuffer)[i]; }
+		const shard_type& GetShard(size_type i) const { return reinterpret_cast<const shard_type*>(mShardBuffer)[i]; }
+
+		// The shard is picked from the top bits of the hash code multiplied by a 64 bit odd constant.
+		// This is a different constant than fibonacci_range_hashing uses, so that the keys of one
+		// shard still spread over all of the shard's buckets with power_of_two_rehash_policy.
+		static size_type DoGetShardIndex(size_t c)
+		{
+			const uint64_t h = (uint64_t)c * UINT64_C(0xC2B2AE3D27D4EB4F);
+			return (size_type)((h >> 32) >> (32 - kShardBits)); // Two shifts so that a single shard doesn't shift by 64.
+		}
+
+		hashed_key<key_type> DoGetHashedKey(const key_type& k) const { return hashed_key<key_type>(k, (size_t)mHashFunction(k)); }
+
+		shard_type&       GetShard(const hashed_key<key_type>& hk)       { return GetShard(DoGetShardIndex(hk.hash_code())); }
+		const shard_type& GetShard(const hashed_key<key_type>& hk) const { return GetShard(DoGetShardIndex(hk.hash_code())); }
+
+	protected:
+		static const int kShardBits = eastl::bit_width(nShardCount) - 1;
+
+		hasher mHashFunction;
+		alignas(shard_type) unsigned char mShardBuffer[sizeof(shard_type) * nShardCount];
+
+	}; // concurrent_hash_map
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// concurrent_hash_map
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline typename concurrent_hash_map<K, T, H, P, A, N>::size_type
+	concurrent_hash_map<K, T, H, P, A, N>::size() const
+	{
+		size_type n = 0;
+
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			const shard_type& shard = GetShard(i);
+			shared_lock_type lock(shard.mLock);
+			n += shard.mMap.size();
+		}
+
+		return n;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::empty() const
+	{
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			const shard_type& shard = GetShard(i);
+			shared_lock_type lock(shard.mLock);
+
+			if(!shard.mMap.empty())
+				return false;
+		}
+
+		return true;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline void concurrent_hash_map<K, T, H, P, A, N>::clear()
+	{
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			shard_type& shard = GetShard(i);
+			exclusive_lock_type lock(shard.mLock);
+			shard.mMap.clear();
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline void concurrent_hash_map<K, T, H, P, A, N>::reserve(size_type nElementCount)
+	{
+		const size_type nShardElementCount = (nElementCount + kShardCount - 1) / kShardCount;
+
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			shard_type& shard = GetShard(i);
+			exclusive_lock_type lock(shard.mLock);
+			shard.mMap.reserve(nShardElementCount);
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::insert(const value_type& value)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(value.first);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		return shard.mMap.try_emplace(hk, value.second).second;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::insert(value_type&& value)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(value.first);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		return shard.mMap.try_emplace(hk, eastl::move(value.second)).second;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename... Args>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::try_emplace(const key_type& k, Args&&... args)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		return shard.mMap.try_emplace(hk, eastl::forward<Args>(args)...).second;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename M>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::insert_or_assign(const key_type& k, M&& obj)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		typename shard_map_type::iterator it = shard.mMap.find(hk);
+
+		if(it != shard.mMap.end())
+		{
+			it->second = eastl::forward<M>(obj);
+			return false;
+		}
+
+		return shard.mMap.try_emplace(hk, eastl::forward<M>(obj)).second;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::find(const key_type& k, mapped_type& valueOut) const
+	{
+		return visit(k, [&valueOut](const value_type& value) { valueOut = value.second; });
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::contains(const key_type& k) const
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		const shard_type& shard = GetShard(hk);
+		shared_lock_type lock(shard.mLock);
+
+		return shard.mMap.contains(hk);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline typename concurrent_hash_map<K, T, H, P, A, N>::size_type
+	concurrent_hash_map<K, T, H, P, A, N>::erase(const key_type& k)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		return shard.mMap.erase(hk);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename Function>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::visit(const key_type& k, Function function) const
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		const shard_type& shard = GetShard(hk);
+		shared_lock_type lock(shard.mLock);
+
+		const typename shard_map_type::const_iterator it = shard.mMap.find(hk);
+
+		if(it == shard.mMap.end())
+			return false;
+
+		function(*it);
+		return true;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename Function>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::update(const key_type& k, Function function)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		const typename shard_map_type::iterator it = shard.mMap.find(hk);
+
+		if(it == shard.mMap.end())
+			return false;
+
+		function(*it);
+		return true;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename Function, typename... Args>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::try_emplace_or_update(const key_type& k, Function function, Args&&... args)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		const typename shard_map_type::insert_return_type result = shard.mMap.try_emplace(hk, eastl::forward<Args>(args)...);
+
+		if(!result.second)
+			function(*result.first);
+
+		return result.second;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename UserPredicate>
+	inline typename concurrent_hash_map<K, T, H, P, A, N>::size_type
+	concurrent_hash_map<K, T, H, P, A, N>::erase_if(const key_type& k, UserPredicate predicate)
+	{
+		const hashed_key<key_type> hk = DoGetHashedKey(k);
+		shard_type& shard = GetShard(hk);
+		exclusive_lock_type lock(shard.mLock);
+
+		const typename shard_map_type::iterator it = shard.mMap.find(hk);
+
+		if((it == shard.mMap.end()) || !predicate(static_cast<const value_type&>(*it)))
+			return 0;
+
+		shard.mMap.erase(it);
+		return 1;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename Function>
+	inline void concurrent_hash_map<K, T, H, P, A, N>::visit_all(Function function) const
+	{
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			const shard_type& shard = GetShard(i);
+			shared_lock_type lock(shard.mLock);
+
+			for(typename shard_map_type::const_iterator it = shard.mMap.begin(), itEnd = shard.mMap.end(); it != itEnd; ++it)
+				function(*it);
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename Function>
+	inline void concurrent_hash_map<K, T, H, P, A, N>::update_all(Function function)
+	{
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			shard_type& shard = GetShard(i);
+			exclusive_lock_type lock(shard.mLock);
+
+			for(typename shard_map_type::iterator it = shard.mMap.begin(), itEnd = shard.mMap.end(); it != itEnd; ++it)
+				function(*it);
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	template <typename UserPredicate>
+	inline typename concurrent_hash_map<K, T, H, P, A, N>::size_type
+	concurrent_hash_map<K, T, H, P, A, N>::erase_all_if(UserPredicate predicate)
+	{
+		size_type n = 0;
+
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			shard_type& shard = GetShard(i);
+			exclusive_lock_type lock(shard.mLock);
+
+			n += eastl::erase_if(shard.mMap, [&predicate](const value_type& value) { return predicate(value); });
+		}
+
+		return n;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, size_t N>
+	inline bool concurrent_hash_map<K, T, H, P, A, N>::validate() const
+	{
+		for(size_type i = 0; i < kShardCount; i++)
+		{
+			const shard_type& shard = GetShard(i);
+
+			if(!shard.mMap.validate())
+				return false;
+
+			for(typename shard_map_type::const_iterator it = shard.mMap.begin(), itEnd = shard.mMap.end(); it != itEnd; ++it)
+			{
+				if(DoGetShardIndex((size_t)mHashFunction(it->first)) != i)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -809,17 +809,40 @@ namespace eastl
 		else
 		{
 			// In this case we will have to do a reallocation.
-			const size_type    nNewPtrArraySize = mnPtrArraySize + eastl::max_alt(mnPtrArraySize, nAdditionalCapacity) + 2;  // Allocate extra capacity.
-			value_type** const pNewPtrArray     = DoAllocatePtrArray(nNewPtrArraySize);
+			const size_type nNewPtrArraySize = mnPtrArraySize + eastl::max_alt(mnPtrArraySize, nAdditionalCapacity) + 2;  // Allocate extra capacity.
+			value_type**    pNewPtrArray     = NULL;
 
-			pPtrArrayBegin = pNewPtrArray + (mItBegin.mpCurrentArrayPtr - mpPtrArray) + ((allocationSide == kSideFront) ? nAdditionalCapacity : 0);
+			// When growing at the back, the pointers can stay at the same positions in the array, so
+			// the allocator may be able to grow the array in place, or move it with reallocate.
+			// Arrays with a larger alignment come from the aligned allocate, which reallocate doesn't support.
+			if((allocationSide == kSideBack) && mpPtrArray)
+			{
+				if(allocator_try_expand(mAllocator, mpPtrArray, mnPtrArraySize * sizeof(T*), nNewPtrArraySize * sizeof(T*)))
+					pNewPtrArray = mpPtrArray;
+				else if(EASTL_ALIGN_OF(T) <= EASTL_ALLOCATOR_MIN_ALIGNMENT)
+					pNewPtrArray = (value_type**)allocator_reallocate(mAllocator, mpPtrArray, mnPtrArraySize * sizeof(T*), nNewPtrArraySize * sizeof(T*));
+			}
 
-			// The following is equivalent to: eastl::copy(mItBegin.mpCurrentArrayPtr, mItEnd.mpCurrentArrayPtr + 1, pPtrArrayBegin);
-			// It's OK to use memcpy instead of memmove because the destination is guaranteed to non-overlap the source.
-			if(mpPtrArray) // Could also say: 'if(mItBegin.mpCurrentArrayPtr)' 
-				memcpy(pPtrArrayBegin, mItBegin.mpCurrentArrayPtr, nUsedPtrSpace);
+			if(pNewPtrArray)
+			{
+				pPtrArrayBegin = pNewPtrArray + nUnusedPtrCountAtFront;
 
-			DoFreePtrArray(mpPtrArray, mnPtrArraySize);
+				#if EASTL_DEBUG
+					memset(pNewPtrArray + mnPtrArraySize, 0, (nNewPtrArraySize - mnPtrArraySize) * sizeof(T*));
+				#endif
+			}
+			else
+			{
+				pNewPtrArray   = DoAllocatePtrArray(nNewPtrArraySize);
+				pPtrArrayBegin = pNewPtrArray + nUnusedPtrCountAtFront + ((allocationSide == kSideFront) ? nAdditionalCapacity : 0);
+
+				// The following is equivalent to: eastl::copy(mItBegin.mpCurrentArrayPtr, mItEnd.mpCurrentArrayPtr + 1, pPtrArrayBegin);
+				// It's OK to use memcpy instead of memmove because the destination is guaranteed to non-overlap the source.
+				if(mpPtrArray) // Could also say: 'if(mItBegin.mpCurrentArrayPtr)' 
+					memcpy(pPtrArrayBegin, mItBegin.mpCurrentArrayPtr, nUsedPtrSpace);
+
+				DoFreePtrArray(mpPtrArray, mnPtrArraySize);
+			}
 
 			mpPtrArray     = pNewPtrArray;
 			mnPtrArraySize = nNewPtrArraySize;
@@ -2899,6 +2922,26 @@ namespace eastl
 		return static_cast<typename deque<T, Allocator>::size_type>(numRemoved);
 	}
 
+
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::deque
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename T>
+			using deque = eastl::deque<T, polymorphic_allocator>;
+		#endif
+	}
+
 } // namespace eastl
 
 
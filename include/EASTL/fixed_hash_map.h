@@ -67,7 +67,7 @@ namespace eastl
 	///     Predicate              hash_set equality testing function. See hash_set.
 	///
 	template <typename Key, typename T, size_t nodeCount, size_t bucketCount = nodeCount + 1, bool bEnableOverflow = true,
-			  typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, bool bCacheHashCode = false, typename OverflowAllocator = EASTLAllocatorType>
+			  typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, bool bCacheHashCode = hash_code_caching_default<Key>::value, typename OverflowAllocator = EASTLAllocatorType>
 	class fixed_hash_map : public hash_map<Key, 
 										   T,
 										   Hash,
@@ -161,7 +161,7 @@ namespace eastl
 	///     Predicate              hash_set equality testing function. See hash_set.
 	///
 	template <typename Key, typename T, size_t nodeCount, size_t bucketCount = nodeCount + 1, bool bEnableOverflow = true,
-			  typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, bool bCacheHashCode = false, typename OverflowAllocator = EASTLAllocatorType>
+			  typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, bool bCacheHashCode = hash_code_caching_default<Key>::value, typename OverflowAllocator = EASTLAllocatorType>
 	class fixed_hash_multimap : public hash_multimap<Key,
 													 T,
 													 Hash,
@@ -67,7 +67,7 @@ namespace eastl
 	///     Predicate              hash_set equality testing function. See hash_set.
 	///
 	template <typename Value, size_t nodeCount, size_t bucketCount = nodeCount + 1, bool bEnableOverflow = true,
-			  typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, bool bCacheHashCode = false, typename OverflowAllocator = EASTLAllocatorType>
+			  typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, bool bCacheHashCode = hash_code_caching_default<Value>::value, typename OverflowAllocator = EASTLAllocatorType>
 	class fixed_hash_set : public hash_set<Value,
 										   Hash,
 										   Predicate,
@@ -157,7 +157,7 @@ namespace eastl
 	///     Predicate              hash_set equality testing function. See hash_set.
 	///
 	template <typename Value, size_t nodeCount, size_t bucketCount = nodeCount + 1, bool bEnableOverflow = true,
-			  typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, bool bCacheHashCode = false, typename OverflowAllocator = EASTLAllocatorType>
+			  typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, bool bCacheHashCode = hash_code_caching_default<Value>::value, typename OverflowAllocator = EASTLAllocatorType>
 	class fixed_hash_multiset : public hash_multiset<Value,
 													 Hash,
 													 Predicate,
@@ -661,10 +661,7 @@ namespace eastl
 	template <class T>
 	inline size_t hash_string(const T* p)
 	{
-		unsigned int c, result = 2166136261U;
-		while ((c = *p++) != 0) // To consider: limit p to at most 256 chars.
-			result = (result * 16777619) ^ c;
-		return (size_t)result;
+		return internal::hash_string(p);
 	}
 
 	template <typename T, int nodeCount, bool bEnableOverflow, typename OverflowAllocator>
@@ -672,7 +669,7 @@ namespace eastl
 	{
 		size_t operator()(const fixed_string<T, nodeCount, bEnableOverflow, OverflowAllocator>& x) const
 		{
-			return hash_string(x.c_str());
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
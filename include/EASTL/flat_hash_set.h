@@ -0,0 +1,254 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements flat_hash_set, an open-addressing alternative to
+// hash_set. See internal/flat_hashtable.h for a description of the design.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_FLAT_HASH_SET_H
+#define EASTL_FLAT_HASH_SET_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/flat_hashtable.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_FLAT_HASH_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_FLAT_HASH_SET_DEFAULT_NAME
+		#define EASTL_FLAT_HASH_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " flat_hash_set" // Unless the user overrides something, this is "EASTL flat_hash_set".
+	#endif
+
+
+	/// EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR
+		#define EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_FLAT_HASH_SET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// flat_hash_set
+	///
+	/// Implements a hashed unique-item container, like hash_set, but stores
+	/// its elements in a single open-addressed slot array instead of in
+	/// separately allocated nodes. See flat_hash_map for the differences
+	/// from the node-based containers; the most important one is that
+	/// iterators and references are invalidated by insertions that grow
+	/// the table.
+	///
+	/// Heterogeneous lookup, insertion and erasure
+	/// Supported when both Hash and Predicate are transparent, as with hash_set.
+	///
+	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>,
+			  typename Allocator = EASTLAllocatorType>
+	class flat_hash_set
+		: public flat_hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate, Hash, false>
+	{
+	public:
+		typedef flat_hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate, Hash, false> base_type;
+		typedef flat_hash_set<Value, Hash, Predicate, Allocator>                                   this_type;
+		typedef typename base_type::size_type                                                      size_type;
+		typedef typename base_type::value_type                                                     value_type;
+		typedef typename base_type::allocator_type                                                 allocator_type;
+		typedef typename base_type::iterator                                                       iterator;
+		typedef typename base_type::const_iterator                                                 const_iterator;
+		typedef typename base_type::insert_return_type                                             insert_return_type;
+
+		using base_type::insert;
+
+		static_assert(!is_const<value_type>::value, "flat_hash_set<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "flat_hash_set<T> value_type must be non-volatile.");
+
+	public:
+		/// flat_hash_set
+		///
+		/// Default constructor.
+		///
+		flat_hash_set()
+			: this_type(EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_set
+		///
+		/// Constructor which creates an empty container with allocator.
+		///
+		explicit flat_hash_set(const allocator_type& allocator)
+			: base_type(0, Hash(), Predicate(), eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		/// flat_hash_set
+		///
+		/// Constructor which creates an empty container with at least nBucketCount slots.
+		///
+		explicit flat_hash_set(size_type nBucketCount, const Hash& hashFunction = Hash(), const Predicate& predicate = Predicate(),
+							   const allocator_type& allocator = EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(nBucketCount, hashFunction, predicate, eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		flat_hash_set(const this_type& x)
+			: base_type(x)
+		{
+		}
+
+
+		flat_hash_set(this_type&& x)
+			: base_type(eastl::move(x))
+		{
+		}
+
+
+		flat_hash_set(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator)
+		{
+		}
+
+
+		/// flat_hash_set
+		///
+		/// initializer_list-based constructor.
+		/// Allows for initializing with brace values (e.g. flat_hash_set<int> hs = { 3, 4, 5, }; )
+		///
+		flat_hash_set(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, predicate, eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+		flat_hash_set(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), Predicate(), eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		template <typename FowardIterator>
+		flat_hash_set(FowardIterator first, FowardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(first, last, nBucketCount, hashFunction, predicate, eastl::use_self<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		this_type& operator=(const this_type& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(x));
+		}
+
+
+		this_type& operator=(std::initializer_list<value_type> ilist)
+		{
+			return static_cast<this_type&>(base_type::operator=(ilist));
+		}
+
+
+		this_type& operator=(this_type&& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+		}
+
+		template<typename KX, typename HX = Hash, typename Pred = Predicate,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<Pred>, bool> = true>
+		insert_return_type insert(KX&& k)
+		{
+			// The value_type is only constructed if the key isn't already present.
+			const eastl::pair<size_type, bool> result = base_type::DoFindOrPrepareInsert(k);
+
+			if (result.second)
+				base_type::DoConstructSlot(result.first, eastl::forward<KX>(k));
+
+			return insert_return_type(base_type::DoMakeIterator(result.first), result.second);
+		}
+
+	}; // flat_hash_set
+
+
+	/// flat_hash_set erase_if
+	///
+	/// https://en.cppreference.com/w/cpp/container/unordered_set/erase_if
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, typename UserPredicate>
+	typename eastl::flat_hash_set<Value, Hash, Predicate, Allocator>::size_type erase_if(eastl::flat_hash_set<Value, Hash, Predicate, Allocator>& c, UserPredicate predicate)
+	{
+		auto oldSize = c.size();
+		// Erases all elements that satisfy the predicate from the container.
+		for (auto i = c.begin(), last = c.end(); i != last;)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Value, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator==(const flat_hash_set<Value, Hash, Predicate, Allocator>& a,
+						   const flat_hash_set<Value, Hash, Predicate, Allocator>& b)
+	{
+		typedef typename flat_hash_set<Value, Hash, Predicate, Allocator>::const_iterator const_iterator;
+
+		// We implement branching with the assumption that the return value is usually false.
+		if(a.size() != b.size())
+			return false;
+
+		for(const_iterator ai = a.begin(), aiEnd = a.end(), biEnd = b.end(); ai != aiEnd; ++ai)
+		{
+			const_iterator bi = b.find(*ai);
+
+			if((bi == biEnd) || !(*ai == *bi)) // We have to compare values in addition to making sure the lookups succeeded, as the Predicate need not be Value operator==.
+				return false;
+		}
+
+		return true;
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator!=(const flat_hash_set<Value, Hash, Predicate, Allocator>& a,
+						   const flat_hash_set<Value, Hash, Predicate, Allocator>& b)
+	{
+		return !(a == b);
+	}
+#endif
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -13,6 +13,7 @@
 #include <EASTL/internal/functional_base.h>
 #include <EASTL/internal/mem_fn.h>
 #include <EASTL/bit.h>
+#include <EASTL/internal/hash_string.h>
 
 
 #if defined(EA_PRAGMA_ONCE_SUPPORTED)
@@ -666,23 +667,18 @@ namespace eastl
 	///////////////////////////////////////////////////////////////////////////
 	// string hashes
 	//
-	// Note that our string hashes here intentionally are slow for long strings.
-	// The reasoning for this is so:
-	//    - The large majority of hashed strings are only a few bytes long.
-	//    - The hash function is significantly more efficient if it can make this assumption.
-	//    - The user is welcome to make a custom hash for those uncommon cases where
-	//      long strings need to be hashed. Indeed, the user can probably make a 
-	//      special hash customized for such strings that's better than what we provide.
+	// All string hashes (character pointers, strings and string views) are 
+	// defined in terms of internal::hash_string, so that a character pointer
+	// and a string with the same characters have the same hash. This is required
+	// for heterogeneous lookup of strings with the transparent string hashes.
+	// See internal/hash_string.h for the algorithm.
 	///////////////////////////////////////////////////////////////////////////
 
 	template <> struct hash<char*>
 	{
 		size_t operator()(const char* p) const
 		{
-			uint32_t c, result = 2166136261U;   // FNV1 hash. Perhaps the best string hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // Using '!=' disables compiler warnings.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -690,10 +686,7 @@ namespace eastl
 	{
 		size_t operator()(const char* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // cast to unsigned 8 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -702,10 +695,7 @@ namespace eastl
 	{
 		size_t operator()(const char8_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // FNV1 hash. Perhaps the best string hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // Using '!=' disables compiler warnings.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -713,10 +703,7 @@ namespace eastl
 	{
 		size_t operator()(const char8_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint8_t)*p++) != 0)     // cast to unsigned 8 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 #endif
@@ -726,10 +713,7 @@ namespace eastl
 	{
 		size_t operator()(const char16_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint16_t)*p++) != 0)    // cast to unsigned 16 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -737,10 +721,7 @@ namespace eastl
 	{
 		size_t operator()(const char16_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint16_t)*p++) != 0)    // cast to unsigned 16 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -748,10 +729,7 @@ namespace eastl
 	{
 		size_t operator()(const char32_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -759,10 +737,7 @@ namespace eastl
 	{
 		size_t operator()(const char32_t* p) const
 		{
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -771,10 +746,7 @@ namespace eastl
 	{
 		size_t operator()(const wchar_t* p) const
 		{
-			uint32_t c, result = 2166136261U;    // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while ((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 
@@ -782,10 +754,7 @@ namespace eastl
 	{
 		size_t operator()(const wchar_t* p) const
 		{
-			uint32_t c, result = 2166136261U;    // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while ((c = (uint32_t)*p++) != 0)    // cast to unsigned 32 bit.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(p);
 		}
 	};
 #endif
@@ -806,11 +775,7 @@ namespace eastl
 
 		size_t operator()(const string_type& s) const
 		{
-			const unsigned_value_type* p = (const unsigned_value_type*)s.c_str();
-			uint32_t c, result = 2166136261U;   // Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
-			while((c = *p++) != 0)
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(s.data(), (size_t)s.length());
 		}
 	};
 
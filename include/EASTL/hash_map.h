@@ -82,7 +82,17 @@ namespace eastl
 	/// When this option is disabled, the rehashing of the table will 
 	/// call the hash function on the key. Setting bCacheHashCode to true 
 	/// is useful for cases whereby the calculation of the hash value for
-	/// a contained object is very expensive.
+	/// a contained object is very expensive. It also makes lookups compare
+	/// hash codes before calling the key predicate, which saves most of the
+	/// calls on keys that are expensive to compare, such as strings. The
+	/// default, hash_code_caching_default, is true for keys of class type.
+	///
+	/// RehashPolicy
+	/// Selects how the bucket count grows and how hash codes are mapped to
+	/// buckets. The default prime_rehash_policy uses prime bucket counts and
+	/// an integer modulo. power_of_two_rehash_policy uses power of two bucket
+	/// counts and a multiplicative (Fibonacci) reduction, which avoids the
+	/// division and is usually faster for cheap hash functions.
 	///
 	/// Heterogeneous lookup, insertion and erasure
 	/// See
@@ -122,17 +132,17 @@ namespace eastl
 	///     i = hashMap.find_as("hello", hash<char*>(), equal_to<>());
 	///
 	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, 
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = hash_code_caching_default<Key>::value, typename RehashPolicy = prime_rehash_policy>
 	class hash_map
 		: public hashtable<Key, eastl::pair<const Key, T>, Allocator, eastl::use_first<eastl::pair<const Key, T> >, Predicate,
-							Hash, mod_range_hashing, default_ranged_hash, prime_rehash_policy, bCacheHashCode, true, true>
+							Hash, typename RehashPolicy::range_hash_type, default_ranged_hash, RehashPolicy, bCacheHashCode, true, true>
 	{
 	public:
 		typedef hashtable<Key, eastl::pair<const Key, T>, Allocator, 
 						  eastl::use_first<eastl::pair<const Key, T> >, 
-						  Predicate, Hash, mod_range_hashing, default_ranged_hash, 
-						  prime_rehash_policy, bCacheHashCode, true, true>        base_type;
-		typedef hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>      this_type;
+						  Predicate, Hash, typename RehashPolicy::range_hash_type, default_ranged_hash, 
+						  RehashPolicy, bCacheHashCode, true, true>        base_type;
+		typedef hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>      this_type;
 		typedef typename base_type::size_type                                     size_type;
 		typedef typename base_type::key_type                                      key_type;
 		typedef T                                                                 mapped_type;
@@ -165,7 +175,7 @@ namespace eastl
 		/// Constructor which creates an empty container with allocator.
 		///
 		explicit hash_map(const allocator_type& allocator)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(),
+			: base_type(0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(),
 						Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -181,7 +191,7 @@ namespace eastl
 		/// note: difference in explicit keyword from the standard.
 		explicit hash_map(size_type nBucketCount, const Hash& hashFunction = Hash(), 
 						  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), 
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -218,14 +228,14 @@ namespace eastl
 		///     
 		hash_map(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), 
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
 		}
 
 		hash_map(std::initializer_list<value_type> ilist, const allocator_type& allocator)
-			: base_type(ilist.begin(), ilist.end(), 0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
 		}
@@ -243,7 +253,7 @@ namespace eastl
 		template <typename ForwardIterator>
 		hash_map(ForwardIterator first, ForwardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				 const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), 
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -289,6 +299,11 @@ namespace eastl
 			return base_type::DoInsertKey(true_type(), eastl::move(key));
 		}
 
+		insert_return_type insert(const hashed_key<key_type>& hk)
+		{
+			return base_type::DoInsertKey(true_type(), hk.key(), base_type::DoGetHashCode(hk));
+		}
+
 		template <typename P, eastl::enable_if_t<eastl::is_constructible_v<value_type, P&&>, bool> = true>
 		insert_return_type insert(P&& otherValue)
 		{
@@ -326,7 +341,8 @@ namespace eastl
 		}
 
 		template <typename KX, typename... Args, typename HX = Hash, typename PX = Predicate,
-			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<PX>, bool> = true>
+			eastl::enable_if_t<!internal::is_hashed_key_v<KX>
+			&& eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<PX>, bool> = true>
 		mapped_type& operator[](KX&& key)
 		{
 			return try_emplace(eastl::forward<KX>(key)).first->second;
@@ -345,12 +361,20 @@ namespace eastl
 		}
 
 		template <typename KX, typename... Args, typename HX = Hash, typename PX = Predicate,
-			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, const_iterator> && !eastl::is_convertible_v<KX&&, iterator>
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, const_iterator> && !eastl::is_convertible_v<KX&&, iterator> && !internal::is_hashed_key_v<KX>
 			&& eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<PX>, bool> = true>
 		inline insert_return_type try_emplace(KX&& k, Args&&... args) {
 			return try_emplace_forwarding(eastl::forward<KX>(k), eastl::forward<Args>(args)...);
 		}
 
+		// The key is copied (or converted, for a heterogeneous hashed_key) into the new element only if one is inserted.
+		template <typename KX, typename... Args, typename HX = Hash, typename PX = Predicate,
+			eastl::enable_if_t<eastl::is_same_v<KX, key_type>
+			|| (eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<PX>), bool> = true>
+		inline insert_return_type try_emplace(const hashed_key<KX>& hk, Args&&... args) {
+			return try_emplace_with_hash_code(hk.key(), base_type::DoGetHashCode(hk), eastl::forward<Args>(args)...);
+		}
+
 		template <class... Args>
 		inline iterator try_emplace(const_iterator, const key_type& k, Args&&... args) {
 			// Currently, the first parameter is ignored.
@@ -366,7 +390,8 @@ namespace eastl
 		}
 
 		template <typename KX, typename... Args, typename HX = Hash, typename PX = Predicate,
-			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX>&& eastl::detail::is_transparent_comparison_v<PX>, bool> = true>
+			eastl::enable_if_t<!internal::is_hashed_key_v<KX>
+			&& eastl::detail::is_transparent_comparison_v<HX>&& eastl::detail::is_transparent_comparison_v<PX>, bool> = true>
 		inline iterator try_emplace(const_iterator, KX&& k, Args&&... args) {
 			// Currently, the first parameter is ignored.
 			insert_return_type result = try_emplace(eastl::forward<KX>(k), eastl::forward<Args>(args)...);
@@ -415,7 +440,13 @@ namespace eastl
 		template <class K, class... Args>
 		insert_return_type try_emplace_forwarding(K&& k, Args&&... args)
 		{
-			const auto key_data = base_type::DoFindKeyData(k);
+			return try_emplace_with_hash_code(eastl::forward<K>(k), base_type::get_hash_code(k), eastl::forward<Args>(args)...);
+		}
+
+		template <class K, class... Args>
+		insert_return_type try_emplace_with_hash_code(K&& k, typename base_type::hash_code_t c, Args&&... args)
+		{
+			const auto key_data = base_type::DoFindKeyData(k, c);
 			if (key_data.node)
 			{ // Node exists, no insertion needed.
 				return eastl::pair<iterator, bool>(
@@ -436,8 +467,8 @@ namespace eastl
 	/// hash_map erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_map/erase_if
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate from the container.
@@ -463,17 +494,17 @@ namespace eastl
 	/// documentation for hash_set for details.
 	///
 	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = hash_code_caching_default<Key>::value, typename RehashPolicy = prime_rehash_policy>
 	class hash_multimap
 		: public hashtable<Key, eastl::pair<const Key, T>, Allocator, eastl::use_first<eastl::pair<const Key, T> >, Predicate,
-						   Hash, mod_range_hashing, default_ranged_hash, prime_rehash_policy, bCacheHashCode, true, false>
+						   Hash, typename RehashPolicy::range_hash_type, default_ranged_hash, RehashPolicy, bCacheHashCode, true, false>
 	{
 	public:
 		typedef hashtable<Key, eastl::pair<const Key, T>, Allocator, 
 						  eastl::use_first<eastl::pair<const Key, T> >, 
-						  Predicate, Hash, mod_range_hashing, default_ranged_hash, 
-						  prime_rehash_policy, bCacheHashCode, true, false>           base_type;
-		typedef hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>     this_type;
+						  Predicate, Hash, typename RehashPolicy::range_hash_type, default_ranged_hash, 
+						  RehashPolicy, bCacheHashCode, true, false>           base_type;
+		typedef hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>     this_type;
 		typedef typename base_type::size_type                                         size_type;
 		typedef typename base_type::key_type                                          key_type;
 		typedef T                                                                     mapped_type;
@@ -497,7 +528,7 @@ namespace eastl
 		/// Default constructor.
 		///
 		explicit hash_multimap(const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(), 
+			: base_type(0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -513,7 +544,7 @@ namespace eastl
 		/// note: difference in explicit keyword from the standard.
 		explicit hash_multimap(size_type nBucketCount, const Hash& hashFunction = Hash(), 
 							   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), 
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -550,14 +581,14 @@ namespace eastl
 		///     
 		hash_multimap(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), 
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
 		}
 
 		hash_multimap(std::initializer_list<value_type> ilist, const allocator_type& allocator)
-			: base_type(ilist.begin(), ilist.end(), 0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
 		}
@@ -576,7 +607,7 @@ namespace eastl
 		template <typename ForwardIterator>
 		hash_multimap(ForwardIterator first, ForwardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), 
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), 
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -623,6 +654,11 @@ namespace eastl
 			return base_type::DoInsertKey(false_type(), eastl::move(key));
 		}
 
+		insert_return_type insert(const hashed_key<key_type>& hk)
+		{
+			return base_type::DoInsertKey(false_type(), hk.key(), base_type::DoGetHashCode(hk));
+		}
+
 		template <typename P, eastl::enable_if_t<eastl::is_constructible_v<value_type, P&&>, bool> = true>
 		insert_return_type insert(P&& otherValue)
 		{
@@ -634,8 +670,8 @@ namespace eastl
 	/// hash_multimap erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_multimap/erase_if
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate from the container.
@@ -659,11 +695,11 @@ namespace eastl
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 
 		// We implement branching with the assumption that the return value is usually false.
 		if(a.size() != b.size())
@@ -683,19 +719,19 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
 #endif
 
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 		typedef typename eastl::iterator_traits<const_iterator>::difference_type difference_type;
 
 		// We implement branching with the assumption that the return value is usually false.
@@ -741,15 +777,37 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
 #endif
 
 
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::hash_map / pmr::hash_multimap
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, bool bCacheHashCode = hash_code_caching_default<Key>::value>
+			using hash_map = eastl::hash_map<Key, T, Hash, Predicate, polymorphic_allocator, bCacheHashCode>;
+
+			template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>, bool bCacheHashCode = hash_code_caching_default<Key>::value>
+			using hash_multimap = eastl::hash_multimap<Key, T, Hash, Predicate, polymorphic_allocator, bCacheHashCode>;
+		#endif
+	}
+
 } // namespace eastl
 
 
@@ -79,7 +79,15 @@ namespace eastl
 	/// When this option is disabled, the rehashing of the table will 
 	/// call the hash function on the key. Setting bCacheHashCode to true 
 	/// is useful for cases whereby the calculation of the hash value for
-	/// a contained object is very expensive.
+	/// a contained object is very expensive. The default is given by
+	/// hash_code_caching_default; see hash_map.
+	///
+	/// RehashPolicy
+	/// Selects how the bucket count grows and how hash codes are mapped to
+	/// buckets. The default prime_rehash_policy uses prime bucket counts and
+	/// an integer modulo. power_of_two_rehash_policy uses power of two bucket
+	/// counts and a multiplicative (Fibonacci) reduction, which avoids the
+	/// division and is usually faster for cheap hash functions.
 	///
 	/// Heterogeneous lookup, insertion and erasure
 	/// See
@@ -119,17 +127,17 @@ namespace eastl
 	///     i = hashSet.find_as("hello", hash<char*>(), equal_to<>());
 	///
 	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, 
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = hash_code_caching_default<Value>::value, typename RehashPolicy = prime_rehash_policy>
 	class hash_set
 		: public hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate,
-						   Hash, mod_range_hashing, default_ranged_hash, 
-						   prime_rehash_policy, bCacheHashCode, false, true>
+						   Hash, typename RehashPolicy::range_hash_type, default_ranged_hash, 
+						   RehashPolicy, bCacheHashCode, false, true>
 	{
 	public:
 		typedef hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate, 
-						  Hash, mod_range_hashing, default_ranged_hash,
-						  prime_rehash_policy, bCacheHashCode, false, true>       base_type;
-		typedef hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>       this_type;
+						  Hash, typename RehashPolicy::range_hash_type, default_ranged_hash,
+						  RehashPolicy, bCacheHashCode, false, true>       base_type;
+		typedef hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>       this_type;
 		typedef typename base_type::size_type                                     size_type;
 		typedef typename base_type::value_type                                    value_type;
 		typedef typename base_type::allocator_type                                allocator_type;
@@ -160,7 +168,7 @@ namespace eastl
 		/// Constructor which creates an empty container with allocator.
 		///
 		explicit hash_set(const allocator_type& allocator)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
+			: base_type(0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -175,7 +183,7 @@ namespace eastl
 		/// note: difference in explicit keyword from the standard.
 		explicit hash_set(size_type nBucketCount, const Hash& hashFunction = Hash(), const Predicate& predicate = Predicate(), 
 						  const allocator_type& allocator = EASTL_HASH_SET_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -211,13 +219,13 @@ namespace eastl
 		///     
 		hash_set(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_SET_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
 
 		hash_set(std::initializer_list<value_type> ilist, const allocator_type& allocator)
-			: base_type(ilist.begin(), ilist.end(), 0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -236,7 +244,7 @@ namespace eastl
 		template <typename FowardIterator>
 		hash_set(FowardIterator first, FowardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				 const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_SET_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -266,16 +274,16 @@ namespace eastl
 		}
 
 		template<typename KX, typename HX = Hash, typename Pred = Predicate,
-			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<Pred>, bool> = true>
+			eastl::enable_if_t<!internal::is_hashed_key_v<KX> && eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<Pred>, bool> = true>
 		insert_return_type insert(KX&& k)
 		{
 			// There's no function in the base type that we can re-use here. insert(value_type&&) is implemented in terms of DoInsertValue(), but that
 			// unconditionally creates a node and therefore the key_type. So we create our own appropriate implementation.
 
 			const typename base_type::hash_code_t c = base_type::get_hash_code(k);
-			const size_type n = (size_type)base_type::bucket_index(k, c, (uint32_t)base_type::mnBucketCount);
+			size_type n;
 
-			node_type* const pNode = base_type::DoFindNode(base_type::mpBucketArray[n], k, c);
+			node_type* const pNode = base_type::DoFindNodeAndBucket(k, c, n);
 
 			if (!pNode)
 			{
@@ -288,6 +296,28 @@ namespace eastl
 			}
 		}
 
+		// Like insert(KX&&) above, the element is only constructed if the key isn't already present.
+		template<typename KX, typename HX = Hash, typename Pred = Predicate,
+			eastl::enable_if_t<eastl::is_same_v<KX, value_type>
+			|| (eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<Pred>), bool> = true>
+		insert_return_type insert(const hashed_key<KX>& hk)
+		{
+			const typename base_type::hash_code_t c = base_type::DoGetHashCode(hk);
+			size_type n;
+
+			node_type* const pNode = base_type::DoFindNodeAndBucket(hk.key(), c, n);
+
+			if (!pNode)
+			{
+				node_type* const pNodeNew = base_type::DoAllocateNode(hk.key());
+				return base_type::template DoInsertUniqueNode<true>(pNodeNew->mValue, c, n, pNodeNew);
+			}
+			else
+			{
+				return pair<iterator, bool>(iterator(pNode, base_type::mpBucketArray + n), false);
+			}
+		}
+
 		// this function was incorrectly defined in the hashtable base type.
 		// this function implicitly converts to value_type, which it shouldn't. Additionally, it does not correctly support heterogeneous insertion (unconditionally creates a key_type).
 		template <typename P, typename HX = Hash, typename Pred = Predicate,
@@ -303,8 +333,8 @@ namespace eastl
 	/// hash_set erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_set/erase_if
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate pred from the container.
@@ -330,17 +360,17 @@ namespace eastl
 	/// for hash_set for details.
 	///
 	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, 
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = hash_code_caching_default<Value>::value, typename RehashPolicy = prime_rehash_policy>
 	class hash_multiset
 		: public hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate,
-						   Hash, mod_range_hashing, default_ranged_hash,
-						   prime_rehash_policy, bCacheHashCode, false, false>
+						   Hash, typename RehashPolicy::range_hash_type, default_ranged_hash,
+						   RehashPolicy, bCacheHashCode, false, false>
 	{
 	public:
 		typedef hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate,
-						  Hash, mod_range_hashing, default_ranged_hash,
-						  prime_rehash_policy, bCacheHashCode, false, false>          base_type;
-		typedef hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>      this_type;
+						  Hash, typename RehashPolicy::range_hash_type, default_ranged_hash,
+						  RehashPolicy, bCacheHashCode, false, false>          base_type;
+		typedef hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>      this_type;
 		typedef typename base_type::size_type                                         size_type;
 		typedef typename base_type::value_type                                        value_type;
 		typedef typename base_type::allocator_type                                    allocator_type;
@@ -358,7 +388,7 @@ namespace eastl
 		/// Default constructor.
 		/// 
 		explicit hash_multiset(const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
+			: base_type(0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -373,7 +403,7 @@ namespace eastl
 		/// note: difference in explicit keyword from the standard.
 		explicit hash_multiset(size_type nBucketCount, const Hash& hashFunction = Hash(), 
 							   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -409,13 +439,13 @@ namespace eastl
 		///     
 		hash_multiset(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
 
 		hash_multiset(std::initializer_list<value_type> ilist, const allocator_type& allocator)
-			: base_type(ilist.begin(), ilist.end(), 0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
+			: base_type(ilist.begin(), ilist.end(), 0, Hash(), typename RehashPolicy::range_hash_type(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -434,7 +464,7 @@ namespace eastl
 		template <typename FowardIterator>
 		hash_multiset(FowardIterator first, FowardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hash_type(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -463,6 +493,11 @@ namespace eastl
 			return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
 		}
 
+		insert_return_type insert(const hashed_key<value_type>& hk)
+		{
+			return base_type::DoInsertValueExtra(false_type(), hk.key(), base_type::DoGetHashCode(hk), NULL, value_type(hk.key()));
+		}
+
 		// this function was incorrectly defined in the hashtable base type.
 		// this function implicitly converts to value_type, which it shouldn't.
 		template <typename P, eastl::enable_if_t<!eastl::is_convertible_v<P&&, value_type> && eastl::is_constructible_v<value_type, P&&>, bool> = true>
@@ -477,8 +512,8 @@ namespace eastl
 	/// hash_multiset erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_multiset/erase_if
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate pred from the container.
@@ -502,11 +537,11 @@ namespace eastl
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 
 		// We implement branching with the assumption that the return value is usually false.
 		if(a.size() != b.size())
@@ -526,19 +561,19 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
 #endif
 
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 		typedef typename eastl::iterator_traits<const_iterator>::difference_type difference_type;
 
 		// We implement branching with the assumption that the return value is usually false.
@@ -584,14 +619,37 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
 #endif
 
+
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::hash_set / pmr::hash_multiset
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, bool bCacheHashCode = hash_code_caching_default<Value>::value>
+			using hash_set = eastl::hash_set<Value, Hash, Predicate, polymorphic_allocator, bCacheHashCode>;
+
+			template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, bool bCacheHashCode = hash_code_caching_default<Value>::value>
+			using hash_multiset = eastl::hash_multiset<Value, Hash, Predicate, polymorphic_allocator, bCacheHashCode>;
+		#endif
+	}
+
 } // namespace eastl
 
 
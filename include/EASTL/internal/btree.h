@@ -0,0 +1,1985 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_BTREE_H
+#define EASTL_INTERNAL_BTREE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/red_black_tree.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/allocator.h>
+#include <EASTL/iterator.h>
+#include <EASTL/utility.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/initializer_list.h>
+#include <EASTL/tuple.h>
+#if EASTL_EXCEPTIONS_ENABLED
+#include <stdexcept>
+#endif
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <new>
+#include <stddef.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+// 4512/4626 - 'class' : assignment operator could not be generated
+// 4530 - C++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
+// 4571 - catch(...) semantics changed since Visual C++ 7.1; structured exceptions (SEH) are no longer caught.
+EA_DISABLE_VC_WARNING(4512 4626 4530 4571);
+
+
+namespace eastl
+{
+
+	/// EASTL_BTREE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BTREE_DEFAULT_NAME
+		#define EASTL_BTREE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " btree" // Unless the user overrides something, this is "EASTL btree".
+	#endif
+
+
+	/// EASTL_BTREE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BTREE_DEFAULT_ALLOCATOR
+		#define EASTL_BTREE_DEFAULT_ALLOCATOR allocator_type(EASTL_BTREE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE
+	///
+	/// The size in bytes that a btree leaf node aims for. The number of values per
+	/// node is derived from this, so the default of 256 bytes (four 64 byte cache lines)
+	/// holds 30 values of a pair<const int, int>. Larger nodes mean fewer cache misses
+	/// per lookup but more values to shift per insertion or erasure.
+	///
+	#ifndef EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE
+		#define EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE 256
+	#endif
+
+
+
+	/// btree_node_base
+	///
+	/// The part of a btree node that doesn't depend on the value type.
+	///
+	struct btree_node_base
+	{
+		btree_node_base* mpParent;    // NULL for the root node.
+		uint16_t         mnPosition;  // The index of this node in mpParent's child array.
+		uint16_t         mnCount;     // The number of values stored in this node.
+		bool             mbLeaf;      // Leaf nodes are allocated without the child array.
+	};
+
+
+	/// btree_node_capacity
+	///
+	/// Calculates how many values fit in a node of the target size, clamped to [3, 255].
+	///
+	template <typename Value, size_t nTargetNodeSize>
+	struct btree_node_capacity
+	{
+		static const size_t kFitCount = (nTargetNodeSize > sizeof(btree_node_base)) ? ((nTargetNodeSize - sizeof(btree_node_base)) / sizeof(Value)) : 0;
+		static const size_t value     = (kFitCount < 3) ? 3 : ((kFitCount > 255) ? 255 : kFitCount);
+	};
+
+
+	template <typename Value, size_t nValueCapacity>
+	struct btree_internal_node;
+
+
+	/// btree_node
+	///
+	/// A leaf node holds up to nValueCapacity values in sorted order. An internal node
+	/// (btree_internal_node) additionally holds mnCount + 1 child pointers. Leaf nodes are
+	/// allocated with sizeof(btree_node), so the child array is only present on internal nodes.
+	///
+	template <typename Value, size_t nValueCapacity>
+	struct btree_node : public btree_node_base
+	{
+		typedef btree_internal_node<Value, nValueCapacity> internal_node_type;
+
+		alignas(Value) unsigned char mValueBuffer[nValueCapacity * sizeof(Value)];
+
+		Value*       values()                { return reinterpret_cast<Value*>(mValueBuffer); }
+		const Value* values() const          { return reinterpret_cast<const Value*>(mValueBuffer); }
+		Value&       value(size_t i)         { return values()[i]; }
+		const Value& value(size_t i) const   { return values()[i]; }
+
+		btree_node*  parent() const          { return static_cast<btree_node*>(mpParent); }
+		btree_node*& child(size_t i)         { return static_cast<internal_node_type*>(this)->mpChildArray[i]; }
+		btree_node*  child(size_t i) const   { return static_cast<const internal_node_type*>(this)->mpChildArray[i]; }
+
+		void set_child(size_t i, btree_node* pChild)
+		{
+			child(i)            = pChild;
+			pChild->mpParent    = this;
+			pChild->mnPosition  = (uint16_t)i;
+		}
+	};
+
+	template <typename Value, size_t nValueCapacity>
+	struct btree_internal_node : public btree_node<Value, nValueCapacity>
+	{
+		btree_node<Value, nValueCapacity>* mpChildArray[nValueCapacity + 1];
+	};
+
+
+
+	/// btree_iterator
+	///
+	/// An iterator is a node and a value position within that node. Increment and
+	/// decrement stay within the node for the common case of a leaf node and only
+	/// walk the tree when crossing a node boundary.
+	///
+	template <typename T, typename Pointer, typename Reference, size_t nValueCapacity>
+	struct btree_iterator
+	{
+		typedef btree_iterator<T, Pointer, Reference, nValueCapacity>    this_type;
+		typedef btree_iterator<T, T*, T&, nValueCapacity>                iterator;
+		typedef btree_iterator<T, const T*, const T&, nValueCapacity>    const_iterator;
+		typedef eastl_size_t                                             size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef ptrdiff_t                                                difference_type;
+		typedef T                                                        value_type;
+		typedef btree_node<T, nValueCapacity>                            node_type;
+		typedef Pointer                                                  pointer;
+		typedef Reference                                                reference;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                 iterator_category;
+
+	public:
+		node_type* mpNode;
+		int        mnPosition;
+
+	public:
+		btree_iterator() : mpNode(NULL), mnPosition(0) { }
+		btree_iterator(node_type* pNode, int nPosition) : mpNode(pNode), mnPosition(nPosition) { }
+
+		template <typename This = this_type, enable_if_t<!is_same_v<This, iterator>, bool> = true>
+		btree_iterator(const iterator& x) : mpNode(x.mpNode), mnPosition(x.mnPosition) { }
+
+		reference operator*() const  { return mpNode->value((size_t)mnPosition); }
+		pointer   operator->() const { return &mpNode->value((size_t)mnPosition); }
+
+		this_type& operator++()
+		{
+			if(!mpNode->mbLeaf || (++mnPosition >= (int)mpNode->mnCount))
+				DoIncrementSlow();
+			return *this;
+		}
+
+		this_type operator++(int)
+		{
+			this_type temp(*this);
+			operator++();
+			return temp;
+		}
+
+		this_type& operator--()
+		{
+			if(!mpNode->mbLeaf || (--mnPosition < 0))
+				DoDecrementSlow();
+			return *this;
+		}
+
+		this_type operator--(int)
+		{
+			this_type temp(*this);
+			operator--();
+			return temp;
+		}
+
+	protected:
+		void DoIncrementSlow()
+		{
+			if(mpNode->mbLeaf) // If we walked off the end of a leaf, climb until there is a next value.
+			{
+				const this_type saved(*this);
+
+				while((mnPosition == (int)mpNode->mnCount) && mpNode->mpParent)
+				{
+					mnPosition = mpNode->mnPosition;
+					mpNode     = mpNode->parent();
+				}
+
+				if(mnPosition == (int)mpNode->mnCount) // If we climbed past the root, we were at the last value and the result is end().
+					*this = saved;
+			}
+			else // Else the next value is the leftmost value of the subtree to the right.
+			{
+				mpNode = mpNode->child((size_t)mnPosition + 1);
+				while(!mpNode->mbLeaf)
+					mpNode = mpNode->child(0);
+				mnPosition = 0;
+			}
+		}
+
+		void DoDecrementSlow()
+		{
+			if(mpNode->mbLeaf)
+			{
+				const this_type saved(*this);
+
+				while((mnPosition < 0) && mpNode->mpParent)
+				{
+					mnPosition = (int)mpNode->mnPosition - 1;
+					mpNode     = mpNode->parent();
+				}
+
+				if(mnPosition < 0) // Decrementing begin() is undefined; leave the iterator as it was.
+					*this = saved;
+			}
+			else
+			{
+				mpNode = mpNode->child((size_t)mnPosition);
+				while(!mpNode->mbLeaf)
+					mpNode = mpNode->child(mpNode->mnCount);
+				mnPosition = (int)mpNode->mnCount - 1;
+			}
+		}
+	}; // btree_iterator
+
+
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, size_t N>
+	inline bool operator==(const btree_iterator<T, PointerA, ReferenceA, N>& a, const btree_iterator<T, PointerB, ReferenceB, N>& b)
+	{
+		return (a.mpNode == b.mpNode) && (a.mnPosition == b.mnPosition);
+	}
+
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, size_t N>
+	inline bool operator!=(const btree_iterator<T, PointerA, ReferenceA, N>& a, const btree_iterator<T, PointerB, ReferenceB, N>& b)
+	{
+		return (a.mpNode != b.mpNode) || (a.mnPosition != b.mnPosition);
+	}
+
+	// We provide a version of operator!= for the case where the iterators are of the
+	// same type. This helps prevent ambiguity errors in the presence of rel_ops.
+	template <typename T, typename Pointer, typename Reference, size_t N>
+	inline bool operator!=(const btree_iterator<T, Pointer, Reference, N>& a, const btree_iterator<T, Pointer, Reference, N>& b)
+	{
+		return (a.mpNode != b.mpNode) || (a.mnPosition != b.mnPosition);
+	}
+
+
+
+	/// btree
+	///
+	/// btree is the implementation of btree_map, btree_multimap, btree_set and
+	/// btree_multiset. It takes the same template parameters as rbtree plus the
+	/// target node size, and offers the same interface.
+	///
+	/// Instead of one heap node per value, a B-tree stores many values per node
+	/// in sorted arrays. A lookup touches O(log n / log N) nodes instead of O(log n),
+	/// each of them a few adjacent cache lines, and iteration walks contiguous memory.
+	/// The per-value memory overhead is a fraction of a pointer instead of the three
+	/// pointers and color of an rbtree node.
+	///
+	/// Iterator invalidation
+	/// Unlike map and set, a btree moves values between nodes when it inserts or erases.
+	/// Any insertion or erasure invalidates all iterators, pointers and references into
+	/// the container. The iterator returned by insert, emplace or erase is valid.
+	/// Code which holds on to iterators across modifications, or which relies on the
+	/// address of a value being stable, should use map or set instead.
+	///
+	/// Value requirements
+	/// Values are relocated by move construction followed by destruction, so value_type
+	/// must be move constructible (copy constructible is enough). Relocation is assumed
+	/// not to throw.
+	///
+	/// nTargetNodeSize (size_t): The size in bytes that a leaf node aims for. See
+	/// EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE. Internal nodes are larger by the child
+	/// pointer array. Every node holds at least 3 and at most 255 values.
+	///
+	template <typename Key, typename Value, typename Compare, typename Allocator,
+			  typename ExtractKey, bool bMutableIterators, bool bUniqueKeys, size_t nTargetNodeSize = EASTL_BTREE_DEFAULT_TARGET_NODE_SIZE>
+	class btree
+		: public rb_base_compare_ebo<Compare>
+	{
+	public:
+		static const size_t kNodeValueCapacity = btree_node_capacity<Value, nTargetNodeSize>::value;
+		static const size_t kMinNodeValueCount = kNodeValueCapacity / 2;
+
+		typedef ptrdiff_t                                                                       difference_type;
+		typedef eastl_size_t                                                                    size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef Key                                                                             key_type;
+		typedef Value                                                                           value_type;
+		typedef btree_node<value_type, kNodeValueCapacity>                                      node_type;
+		typedef btree_internal_node<value_type, kNodeValueCapacity>                             internal_node_type;
+		typedef value_type&                                                                     reference;
+		typedef const value_type&                                                               const_reference;
+		typedef value_type*                                                                     pointer;
+		typedef const value_type*                                                               const_pointer;
+
+		typedef typename conditional<bMutableIterators,
+					btree_iterator<value_type, value_type*, value_type&, kNodeValueCapacity>,
+					btree_iterator<value_type, const value_type*, const value_type&, kNodeValueCapacity> >::type iterator;
+		typedef btree_iterator<value_type, const value_type*, const value_type&, kNodeValueCapacity>          const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                               reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                                         const_reverse_iterator;
+
+		typedef Allocator                                                                       allocator_type;
+		typedef Compare                                                                         key_compare;
+		typedef typename conditional<bUniqueKeys, eastl::pair<iterator, bool>, iterator>::type  insert_return_type;  // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
+		typedef btree<Key, Value, Compare, Allocator, ExtractKey,
+					  bMutableIterators, bUniqueKeys, nTargetNodeSize>                          this_type;
+		typedef rb_base_compare_ebo<Compare>                                                    base_type;
+		typedef integral_constant<bool, bUniqueKeys>                                            has_unique_keys_type;
+		typedef ExtractKey                                                                      extract_key;
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		node_type*      mpRoot;       /// NULL when the container is empty.
+		node_type*      mpLeftmost;   /// The leaf holding begin().
+		node_type*      mpRightmost;  /// The leaf holding the last value. end() is one past its last value.
+		size_type       mnSize;       /// Stores the count of values in the tree.
+		allocator_type  mAllocator;   // To do: Use base class optimization to make this go away.
+
+	public:
+		// ctor/dtor
+		btree();
+		btree(const allocator_type& allocator);
+		btree(const Compare& compare, const allocator_type& allocator = EASTL_BTREE_DEFAULT_ALLOCATOR);
+		btree(const this_type& x);
+		btree(this_type&& x);
+		btree(this_type&& x, const allocator_type& allocator);
+
+		template <typename InputIterator>
+		btree(InputIterator first, InputIterator last, const Compare& compare, const allocator_type& allocator = EASTL_BTREE_DEFAULT_ALLOCATOR);
+
+	   ~btree();
+
+	public:
+		// properties
+		const allocator_type& get_allocator() const EA_NOEXCEPT { return mAllocator; }
+		allocator_type&       get_allocator() EA_NOEXCEPT       { return mAllocator; }
+		void                  set_allocator(const allocator_type& allocator);
+
+		const key_compare& key_comp() const { return get_compare(); }
+		key_compare&       key_comp()       { return get_compare(); }
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		this_type& operator=(this_type&& x);
+
+		void swap(this_type& x);
+
+	public:
+		// iterators
+		iterator        begin() EA_NOEXCEPT         { return iterator(mpLeftmost, 0); }
+		const_iterator  begin() const EA_NOEXCEPT   { return const_iterator(mpLeftmost, 0); }
+		const_iterator  cbegin() const EA_NOEXCEPT  { return const_iterator(mpLeftmost, 0); }
+
+		iterator        end() EA_NOEXCEPT           { return iterator(mpRightmost, mpRightmost ? (int)mpRightmost->mnCount : 0); }
+		const_iterator  end() const EA_NOEXCEPT     { return const_iterator(mpRightmost, mpRightmost ? (int)mpRightmost->mnCount : 0); }
+		const_iterator  cend() const EA_NOEXCEPT    { return end(); }
+
+		reverse_iterator        rbegin() EA_NOEXCEPT        { return reverse_iterator(end()); }
+		const_reverse_iterator  rbegin() const EA_NOEXCEPT  { return const_reverse_iterator(end()); }
+		const_reverse_iterator  crbegin() const EA_NOEXCEPT { return const_reverse_iterator(end()); }
+
+		reverse_iterator        rend() EA_NOEXCEPT          { return reverse_iterator(begin()); }
+		const_reverse_iterator  rend() const EA_NOEXCEPT    { return const_reverse_iterator(begin()); }
+		const_reverse_iterator  crend() const EA_NOEXCEPT   { return const_reverse_iterator(begin()); }
+
+	public:
+		bool      empty() const EA_NOEXCEPT { return (mnSize == 0); }
+		size_type size() const EA_NOEXCEPT  { return mnSize; }
+
+		template <class... Args>
+		insert_return_type emplace(Args&&... args);
+
+		template <class... Args>
+		iterator emplace_hint(const_iterator position, Args&&... args);
+
+		/// btree_map::insert and btree_set::insert return a pair, while btree_multimap::insert and
+		/// btree_multiset::insert return an iterator.
+		insert_return_type insert(const value_type& value);
+		insert_return_type insert(value_type&& value);
+
+		/// The position is a hint; if the value belongs immediately before it, the
+		/// insertion happens there without a search from the root. Inserting a
+		/// sorted sequence with end() as the hint takes amortized constant time per value.
+		iterator insert(const_iterator position, const value_type& value);
+		iterator insert(const_iterator position, value_type&& value);
+
+		void insert(std::initializer_list<value_type> ilist);
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last);
+
+		template <typename Iter = iterator, typename eastl::enable_if<!eastl::is_same_v<Iter, const_iterator>, int>::type = 0>
+		iterator         erase(iterator position) { return erase(const_iterator(position)); }
+		iterator         erase(const_iterator position);
+		iterator         erase(const_iterator first, const_iterator last);
+		reverse_iterator erase(const_reverse_iterator position);
+		reverse_iterator erase(const_reverse_iterator first, const_reverse_iterator last);
+
+		void erase(const key_type* first, const key_type* last);
+
+		void clear();
+		void reset_lose_memory(); // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
+
+		iterator       find(const key_type& key) { return DoFind(key); }
+		const_iterator find(const key_type& key) const { return DoFind(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       find(const KX& key) { return DoFind(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator find(const KX& key) const { return DoFind(key); }
+
+		/// Implements a find whereby the user supplies a comparison of a different type
+		/// than the tree's value_type. See rbtree::find_as.
+		template <typename U, typename Compare2> iterator       find_as(const U& u, Compare2 compare2);
+		template <typename U, typename Compare2> const_iterator find_as(const U& u, Compare2 compare2) const;
+
+		bool contains(const key_type& key) const { return DoFind(key) != end(); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		bool contains(const KX& key) const { return DoFind(key) != end(); }
+
+		iterator       lower_bound(const key_type& key) { return DoLowerBound(key); }
+		const_iterator lower_bound(const key_type& key) const { return DoLowerBound(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       lower_bound(const KX& key) { return DoLowerBound(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator lower_bound(const KX& key) const { return DoLowerBound(key); }
+
+		iterator       upper_bound(const key_type& key) { return DoUpperBound(key); }
+		const_iterator upper_bound(const key_type& key) const { return DoUpperBound(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       upper_bound(const KX& key) { return DoUpperBound(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator upper_bound(const KX& key) const { return DoUpperBound(key); }
+
+		bool validate() const;
+		int  validate_iterator(const_iterator i) const;
+
+	protected:
+		node_type* DoAllocateNode(bool bLeaf);
+		void       DoFreeNode(node_type* pNode);
+		void       DoNukeSubtree(node_type* pNode);
+
+		template <class... Args>
+		void       DoConstructValue(value_type* pValue, Args&&... args);
+		void       DoRelocateValue(value_type* pDest, value_type* pSource);
+		void       DoRelocateValues(value_type* pDest, value_type* pSource, size_t n);
+
+		template <class... Args>
+		void       DoNodeEmplaceValue(node_type* pNode, size_t i, Args&&... args);
+		void       DoNodeCloseGap(node_type* pNode, size_t i);
+		void       DoNodeSplit(node_type* pNode, node_type* pNodeDest, size_t nInsertPosition);
+		void       DoNodeMerge(node_type* pNodeLeft, node_type* pNodeRight);
+		void       DoNodeRebalanceLeftToRight(node_type* pNodeLeft, node_type* pNodeRight, size_t nMoveCount);
+		void       DoNodeRebalanceRightToLeft(node_type* pNodeLeft, node_type* pNodeRight, size_t nMoveCount);
+
+		void       DoRebalanceOrSplit(iterator& position);
+		bool       DoTryMergeOrRebalance(iterator& position);
+		iterator   DoRebalanceAfterErase(iterator position);
+		void       DoTryShrink();
+
+		template <class... Args>
+		iterator   DoEmplaceAt(iterator position, Args&&... args);
+
+		template <class... Args>
+		eastl::pair<iterator, bool> DoInsertValue(true_type, Args&&... args);
+		template <class... Args>
+		iterator                    DoInsertValue(false_type, Args&&... args);
+
+		eastl::pair<iterator, bool> DoInsertValue(true_type, value_type&& value);
+		iterator                    DoInsertValue(false_type, value_type&& value);
+		eastl::pair<iterator, bool> DoInsertValue(true_type, const value_type& value);
+		iterator                    DoInsertValue(false_type, const value_type& value);
+
+		template <class V>
+		iterator DoInsertValueHint(true_type, const_iterator position, V&& value);
+		template <class V>
+		iterator DoInsertValueHint(false_type, const_iterator position, V&& value);
+
+		template <typename KX>
+		iterator DoGetKeyInsertionPositionUniqueKeys(bool& canInsert, const KX& key);
+		iterator DoGetKeyInsertionPositionNonuniqueKeys(const key_type& key);
+
+		template <typename KX>
+		iterator DoGetKeyInsertionPositionUniqueKeysHint(const_iterator position, bool& canInsert, const KX& key);
+		iterator DoGetKeyInsertionPositionNonuniqueKeysHint(const_iterator position, const key_type& key);
+
+		template <typename KX, typename Compare2>
+		iterator DoFindImpl(const KX& key, Compare2 compare2) const;
+
+		template<typename KX>
+		iterator DoFind(const KX& key) const { return DoFindImpl(key, get_compare()); }
+
+		template<typename KX>
+		iterator DoLowerBound(const KX& key) const;
+
+		template<typename KX>
+		iterator DoUpperBound(const KX& key) const;
+
+		template <typename InputIterator>
+		void DoAppendRange(InputIterator first, InputIterator last);
+
+		int DoValidateSubtree(const node_type* pNode, int nDepth) const;
+
+		static iterator DoInternalLast(iterator it);
+
+	}; // btree
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// btree functions
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree()
+		: mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(EASTL_BTREE_DEFAULT_NAME)
+	{
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree(const allocator_type& allocator)
+		: mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree(const C& compare, const allocator_type& allocator)
+		: base_type(compare),
+		  mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree(const this_type& x)
+		: base_type(x.get_compare()),
+		  mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(x.mAllocator)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				DoAppendRange(x.begin(), x.end());
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				clear();
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree(this_type&& x)
+		: base_type(x.get_compare()),
+		  mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(x.mAllocator)
+	{
+		swap(x);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree(this_type&& x, const allocator_type& allocator)
+		: base_type(x.get_compare()),
+		  mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(allocator)
+	{
+		swap(x); // swap will directly or indirectly handle the possibility that mAllocator != x.mAllocator.
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename InputIterator>
+	inline btree<K, V, C, A, E, bM, bU, nS>::btree(InputIterator first, InputIterator last, const C& compare, const allocator_type& allocator)
+		: base_type(compare),
+		  mpRoot(NULL),
+		  mpLeftmost(NULL),
+		  mpRightmost(NULL),
+		  mnSize(0),
+		  mAllocator(allocator)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				insert(first, last);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				clear();
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline btree<K, V, C, A, E, bM, bU, nS>::~btree()
+	{
+		// Erase the entire tree. DoNukeSubtree is not a
+		// conventional erase function, as it does no rebalancing.
+		if(mpRoot)
+			DoNukeSubtree(mpRoot);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::set_allocator(const allocator_type& allocator)
+	{
+		if(mnSize > 0 && mAllocator != allocator)
+			EASTL_THROW_MSG_OR_ASSERT(std::logic_error, "btree::set_allocator -- cannot change allocator after allocations have been made.");
+		mAllocator = allocator;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::this_type&
+	btree<K, V, C, A, E, bM, bU, nS>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			clear();
+
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				mAllocator = x.mAllocator;
+			#endif
+
+			get_compare() = x.get_compare();
+			DoAppendRange(x.begin(), x.end());
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::this_type&
+	btree<K, V, C, A, E, bM, bU, nS>::operator=(this_type&& x)
+	{
+		if(this != &x)
+		{
+			clear();
+			swap(x);
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::this_type&
+	btree<K, V, C, A, E, bM, bU, nS>::operator=(std::initializer_list<value_type> ilist)
+	{
+		// The simplest means of doing this is to clear and insert. There probably isn't a generic
+		// solution that's any more efficient without having prior knowledge of the ilist contents.
+		clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::swap(this_type& x)
+	{
+		// All of our state lives in the heap-allocated nodes, so unlike rbtree's anchor
+		// there is nothing that points back into the container object.
+		eastl::swap(mpRoot,        x.mpRoot);
+		eastl::swap(mpLeftmost,    x.mpLeftmost);
+		eastl::swap(mpRightmost,   x.mpRightmost);
+		eastl::swap(mnSize,        x.mnSize);
+		eastl::swap(get_compare(), x.get_compare());
+		eastl::swap(mAllocator,    x.mAllocator);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::insert_return_type
+	btree<K, V, C, A, E, bM, bU, nS>::emplace(Args&&... args)
+	{
+		return DoInsertValue(has_unique_keys_type(), eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::emplace_hint(const_iterator position, Args&&... args)
+	{
+		// The key isn't known until the value exists, so we build it on the stack and relocate it in.
+		value_type value(eastl::forward<Args>(args)...);
+		return DoInsertValueHint(has_unique_keys_type(), position, eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::insert_return_type
+	btree<K, V, C, A, E, bM, bU, nS>::insert(const value_type& value)
+	{
+		return DoInsertValue(has_unique_keys_type(), value);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::insert_return_type
+	btree<K, V, C, A, E, bM, bU, nS>::insert(value_type&& value)
+	{
+		return DoInsertValue(has_unique_keys_type(), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::insert(const_iterator position, const value_type& value)
+	{
+		return DoInsertValueHint(has_unique_keys_type(), position, value);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::insert(const_iterator position, value_type&& value)
+	{
+		return DoInsertValueHint(has_unique_keys_type(), position, eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::insert(std::initializer_list<value_type> ilist)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename InputIterator>
+	void btree<K, V, C, A, E, bM, bU, nS>::insert(InputIterator first, InputIterator last)
+	{
+		// Using end() as the hint makes inserting an already sorted range linear.
+		for( ; first != last; ++first)
+			DoInsertValueHint(has_unique_keys_type(), end(), *first);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::erase(const_iterator position)
+	{
+		iterator it(position.mpNode, position.mnPosition);
+		bool     bInternalErase = false;
+
+		if(!it.mpNode->mbLeaf)
+		{
+			// We can only remove values from leaves, so we replace the value with its
+			// predecessor, which is the last value of the leaf to its left, and remove that instead.
+			const iterator itInternal(it);
+			--it;
+			value_type* const pInternal = &itInternal.mpNode->value((size_t)itInternal.mnPosition);
+			pInternal->~value_type();
+			DoRelocateValue(pInternal, &it.mpNode->value((size_t)it.mnPosition));
+			bInternalErase = true;
+		}
+		else
+			it.mpNode->value((size_t)it.mnPosition).~value_type();
+
+		DoNodeCloseGap(it.mpNode, (size_t)it.mnPosition);
+		--mnSize;
+
+		// If we erased from a leaf, the next value is the one that now lives at it. If we
+		// erased from an internal node, the predecessor took the erased value's place and
+		// the next value is one after that.
+		iterator itResult = DoRebalanceAfterErase(it);
+		if(bInternalErase)
+			++itResult;
+		return itResult;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::erase(const_iterator first, const_iterator last)
+	{
+		if((first.mpNode == mpLeftmost) && (first.mnPosition == 0) && (last == end())) // If erasing the entire tree...
+		{
+			clear();
+			return end();
+		}
+
+		// Every erase invalidates all iterators, so we count first and then erase at first.
+		size_type n = (size_type)eastl::distance(first, last);
+		iterator  it(first.mpNode, first.mnPosition);
+
+		while(n-- > 0)
+			it = erase(it);
+
+		return it;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::reverse_iterator
+	btree<K, V, C, A, E, bM, bU, nS>::erase(const_reverse_iterator position)
+	{
+		return reverse_iterator(erase((++position).base()));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::reverse_iterator
+	btree<K, V, C, A, E, bM, bU, nS>::erase(const_reverse_iterator first, const_reverse_iterator last)
+	{
+		// Version which erases in order from first to last.
+		// difference_type i(first.base() - last.base());
+		// while(i--)
+		//     first = erase(first);
+		// return first;
+
+		// Version which erases in order from last to first, but is slightly more efficient:
+		return reverse_iterator(erase(last.base(), first.base()));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::erase(const key_type* first, const key_type* last)
+	{
+		// We have no choice but to run a loop like this, as the first/last range could
+		// have values that are discontiguously located in the tree. And some may not
+		// even be in the tree.
+		while(first != last)
+		{
+			const iterator it(DoFind(*first++));
+			if(it != end())
+				erase(it);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::clear()
+	{
+		// Erase the entire tree. DoNukeSubtree is not a
+		// conventional erase function, as it does no rebalancing.
+		if(mpRoot)
+			DoNukeSubtree(mpRoot);
+		reset_lose_memory();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::reset_lose_memory()
+	{
+		// The reset_lose_memory function is a special extension function which unilaterally
+		// resets the container to an empty state without freeing the memory of
+		// the contained objects. This is useful for very quickly tearing down a
+		// container built into scratch memory.
+		mpRoot      = NULL;
+		mpLeftmost  = NULL;
+		mpRightmost = NULL;
+		mnSize      = 0;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename U, typename Compare2>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::find_as(const U& u, Compare2 compare2)
+	{
+		return DoFindImpl(u, compare2);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename U, typename Compare2>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::const_iterator
+	btree<K, V, C, A, E, bM, bU, nS>::find_as(const U& u, Compare2 compare2) const
+	{
+		return DoFindImpl(u, compare2);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename KX, typename Compare2>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoFindImpl(const KX& key, Compare2 compare2) const
+	{
+		extract_key extractKey;
+
+		// We stop at the first equivalent value we meet on the way down, which for
+		// multi-key trees need not be the first of the equivalent values. That
+		// matches rbtree::find, which also returns any of them.
+		for(node_type* pNode = mpRoot; pNode; )
+		{
+			// Binary search for the first value that isn't less than key.
+			size_t nLo = 0, nHi = pNode->mnCount;
+
+			while(nLo < nHi)
+			{
+				const size_t nMid = (nLo + nHi) >> 1;
+
+				if(compare2(extractKey(pNode->value(nMid)), key))
+					nLo = nMid + 1;
+				else
+					nHi = nMid;
+			}
+
+			if((nLo < pNode->mnCount) && !compare2(key, extractKey(pNode->value(nLo))))
+				return iterator(pNode, (int)nLo);
+
+			if(pNode->mbLeaf)
+				break;
+			pNode = pNode->child(nLo);
+		}
+
+		return const_cast<this_type*>(this)->end();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename KX>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoLowerBound(const KX& key) const
+	{
+		extract_key extractKey;
+		node_type*  pNode = mpRoot;
+
+		if(!pNode)
+			return iterator();
+
+		for(;;)
+		{
+			size_t nLo = 0, nHi = pNode->mnCount;
+
+			while(nLo < nHi)
+			{
+				const size_t nMid = (nLo + nHi) >> 1;
+
+				if(compare(extractKey(pNode->value(nMid)), key))
+					nLo = nMid + 1;
+				else
+					nHi = nMid;
+			}
+
+			if(pNode->mbLeaf)
+				return DoInternalLast(iterator(pNode, (int)nLo));
+			pNode = pNode->child(nLo);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename KX>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoUpperBound(const KX& key) const
+	{
+		extract_key extractKey;
+		node_type*  pNode = mpRoot;
+
+		if(!pNode)
+			return iterator();
+
+		for(;;)
+		{
+			size_t nLo = 0, nHi = pNode->mnCount;
+
+			while(nLo < nHi)
+			{
+				const size_t nMid = (nLo + nHi) >> 1;
+
+				if(compare(key, extractKey(pNode->value(nMid))))
+					nHi = nMid;
+				else
+					nLo = nMid + 1;
+			}
+
+			if(pNode->mbLeaf)
+				return DoInternalLast(iterator(pNode, (int)nLo));
+			pNode = pNode->child(nLo);
+		}
+	}
+
+
+	// Converts a leaf position that may be one past the end of its node into the
+	// iterator for the same place in the sequence, which is the nearest ancestor value.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoInternalLast(iterator it)
+	{
+		const iterator itEnd(it.mpNode, (int)it.mpNode->mnCount); // Correct only if it.mpNode is the rightmost leaf, which is the only case we return it.
+
+		while(it.mnPosition == (int)it.mpNode->mnCount)
+		{
+			if(!it.mpNode->mpParent)
+				return itEnd;
+			it.mnPosition = it.mpNode->mnPosition;
+			it.mpNode     = it.mpNode->parent();
+		}
+
+		return it;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename KX>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoGetKeyInsertionPositionUniqueKeys(bool& canInsert, const KX& key)
+	{
+		// Returns the leaf position to insert at if canInsert is true, else the existing value.
+		extract_key extractKey;
+		node_type*  pNode = mpRoot;
+
+		canInsert = true;
+
+		if(!pNode)
+			return iterator();
+
+		for(;;)
+		{
+			size_t nLo = 0, nHi = pNode->mnCount;
+
+			while(nLo < nHi)
+			{
+				const size_t nMid = (nLo + nHi) >> 1;
+
+				if(compare(extractKey(pNode->value(nMid)), key))
+					nLo = nMid + 1;
+				else
+					nHi = nMid;
+			}
+
+			if((nLo < pNode->mnCount) && !compare(key, extractKey(pNode->value(nLo))))
+			{
+				canInsert = false;
+				return iterator(pNode, (int)nLo);
+			}
+
+			if(pNode->mbLeaf)
+				return iterator(pNode, (int)nLo);
+			pNode = pNode->child(nLo);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoGetKeyInsertionPositionNonuniqueKeys(const key_type& key)
+	{
+		// New values go after existing equivalent values, as with rbtree.
+		extract_key extractKey;
+		node_type*  pNode = mpRoot;
+
+		if(!pNode)
+			return iterator();
+
+		for(;;)
+		{
+			size_t nLo = 0, nHi = pNode->mnCount;
+
+			while(nLo < nHi)
+			{
+				const size_t nMid = (nLo + nHi) >> 1;
+
+				if(compare(key, extractKey(pNode->value(nMid))))
+					nHi = nMid;
+				else
+					nLo = nMid + 1;
+			}
+
+			if(pNode->mbLeaf)
+				return iterator(pNode, (int)nLo);
+			pNode = pNode->child(nLo);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename KX>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoGetKeyInsertionPositionUniqueKeysHint(const_iterator position, bool& canInsert, const KX& key)
+	{
+		// The hint is used if key belongs immediately before it. Otherwise we fall back to a full search.
+		extract_key    extractKey;
+		const iterator itPosition(position.mpNode, position.mnPosition);
+
+		if(mnSize)
+		{
+			if((itPosition == end()) || compare(key, extractKey(*itPosition)))
+			{
+				if(itPosition == begin())
+				{
+					canInsert = true;
+					return itPosition;
+				}
+
+				iterator itPrev(itPosition);
+				--itPrev;
+
+				if(compare(extractKey(*itPrev), key))
+				{
+					canInsert = true;
+					return itPosition;
+				}
+			}
+			else if(!compare(extractKey(*itPosition), key)) // If key is equivalent to the hint...
+			{
+				canInsert = false;
+				return itPosition;
+			}
+		}
+
+		return DoGetKeyInsertionPositionUniqueKeys(canInsert, key);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoGetKeyInsertionPositionNonuniqueKeysHint(const_iterator position, const key_type& key)
+	{
+		extract_key    extractKey;
+		const iterator itPosition(position.mpNode, position.mnPosition);
+
+		if(mnSize && ((itPosition == end()) || !compare(extractKey(*itPosition), key)))
+		{
+			if(itPosition == begin())
+				return itPosition;
+
+			iterator itPrev(itPosition);
+			--itPrev;
+
+			if(!compare(key, extractKey(*itPrev)))
+				return itPosition;
+		}
+
+		return DoGetKeyInsertionPositionNonuniqueKeys(key);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	eastl::pair<typename btree<K, V, C, A, E, bM, bU, nS>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValue(true_type, Args&&... args) // true_type means keys are unique.
+	{
+		// The key isn't known until the value exists, so we build it on the stack and relocate it in.
+		value_type value(eastl::forward<Args>(args)...);
+		return DoInsertValue(true_type(), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValue(false_type, Args&&... args) // false_type means keys are not unique.
+	{
+		value_type value(eastl::forward<Args>(args)...);
+		return DoInsertValue(false_type(), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	eastl::pair<typename btree<K, V, C, A, E, bM, bU, nS>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValue(true_type, value_type&& value)
+	{
+		extract_key    extractKey;
+		bool           canInsert;
+		const iterator itPosition(DoGetKeyInsertionPositionUniqueKeys(canInsert, extractKey(value)));
+
+		if(!canInsert)
+			return eastl::pair<iterator, bool>(itPosition, false);
+
+		return eastl::pair<iterator, bool>(DoEmplaceAt(itPosition, eastl::move(value)), true);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValue(false_type, value_type&& value)
+	{
+		extract_key extractKey;
+		return DoEmplaceAt(DoGetKeyInsertionPositionNonuniqueKeys(extractKey(value)), eastl::move(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	eastl::pair<typename btree<K, V, C, A, E, bM, bU, nS>::iterator, bool>
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValue(true_type, const value_type& value)
+	{
+		extract_key    extractKey;
+		bool           canInsert;
+		const iterator itPosition(DoGetKeyInsertionPositionUniqueKeys(canInsert, extractKey(value)));
+
+		if(!canInsert)
+			return eastl::pair<iterator, bool>(itPosition, false);
+
+		return eastl::pair<iterator, bool>(DoEmplaceAt(itPosition, value), true);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValue(false_type, const value_type& value)
+	{
+		extract_key extractKey;
+		return DoEmplaceAt(DoGetKeyInsertionPositionNonuniqueKeys(extractKey(value)), value);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class Val>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValueHint(true_type, const_iterator position, Val&& value)
+	{
+		extract_key    extractKey;
+		bool           canInsert;
+		const iterator itPosition(DoGetKeyInsertionPositionUniqueKeysHint(position, canInsert, extractKey(value)));
+
+		if(!canInsert)
+			return itPosition;
+
+		return DoEmplaceAt(itPosition, eastl::forward<Val>(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class Val>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoInsertValueHint(false_type, const_iterator position, Val&& value)
+	{
+		extract_key extractKey;
+		return DoEmplaceAt(DoGetKeyInsertionPositionNonuniqueKeysHint(position, extractKey(value)), eastl::forward<Val>(value));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <typename InputIterator>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoAppendRange(InputIterator first, InputIterator last)
+	{
+		// Appends an already sorted range without comparing. The end-biased node split
+		// leaves every node but the last ones full.
+		for( ; first != last; ++first)
+			DoEmplaceAt(end(), *first);
+	}
+
+
+	// Constructs a value at position, which must be a valid insertion position in
+	// sort order, and returns the iterator to it.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoEmplaceAt(iterator position, Args&&... args)
+	{
+		if(!mpRoot)
+		{
+			mpRoot = mpLeftmost = mpRightmost = DoAllocateNode(true);
+			mpRoot->mpParent   = NULL;
+			mpRoot->mnPosition = 0;
+			position = iterator(mpRoot, 0);
+		}
+		else if(!position.mpNode->mbLeaf)
+		{
+			// Values are only inserted into leaves. Inserting before an internal value
+			// is the same as inserting after its predecessor, which is in a leaf.
+			--position;
+			++position.mnPosition;
+		}
+
+		if(position.mpNode->mnCount == kNodeValueCapacity)
+			DoRebalanceOrSplit(position);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				DoNodeEmplaceValue(position.mpNode, (size_t)position.mnPosition, eastl::forward<Args>(args)...);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				// A split may have left the destination node empty, which a tree must never have.
+				if(position.mpNode->mnCount == 0)
+					DoRebalanceAfterErase(iterator(position.mpNode, 0));
+				throw;
+			}
+		#endif
+
+		++mnSize;
+		return position;
+	}
+
+
+	// Makes room in a full leaf, either by shifting values to a sibling or by splitting it.
+	// position is updated to the node and index that the new value will go to.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoRebalanceOrSplit(iterator& position)
+	{
+		node_type*& pNode     = position.mpNode;
+		int&        nInsert   = position.mnPosition;
+		node_type*  pParent   = pNode->parent();
+		const int   nCapacity = (int)kNodeValueCapacity;
+
+		if(pParent)
+		{
+			if(pNode->mnPosition > 0)
+			{
+				// Try shifting values to our left sibling. If we are appending we move as many
+				// as fit, which keeps ascending insertions packing nodes full.
+				node_type* const pLeft = pParent->child((size_t)pNode->mnPosition - 1);
+
+				if(pLeft->mnCount < kNodeValueCapacity)
+				{
+					int nMove = (nCapacity - (int)pLeft->mnCount) / (1 + (nInsert < nCapacity));
+					nMove = eastl::max_alt(1, nMove);
+
+					if(((nInsert - nMove) >= 0) || (((int)pLeft->mnCount + nMove) < nCapacity))
+					{
+						DoNodeRebalanceRightToLeft(pLeft, pNode, (size_t)nMove);
+						nInsert -= nMove;
+
+						if(nInsert < 0)
+						{
+							nInsert = nInsert + (int)pLeft->mnCount + 1;
+							pNode   = pLeft;
+						}
+						return;
+					}
+				}
+			}
+
+			if(pNode->mnPosition < pParent->mnCount)
+			{
+				// Try shifting values to our right sibling.
+				node_type* const pRight = pParent->child((size_t)pNode->mnPosition + 1);
+
+				if(pRight->mnCount < kNodeValueCapacity)
+				{
+					int nMove = (nCapacity - (int)pRight->mnCount) / (1 + (nInsert > 0));
+					nMove = eastl::max_alt(1, nMove);
+
+					if((nInsert <= (nCapacity - nMove)) || (((int)pRight->mnCount + nMove) < nCapacity))
+					{
+						DoNodeRebalanceLeftToRight(pNode, pRight, (size_t)nMove);
+
+						if(nInsert > (int)pNode->mnCount)
+						{
+							nInsert = nInsert - (int)pNode->mnCount - 1;
+							pNode   = pRight;
+						}
+						return;
+					}
+				}
+			}
+
+			// Rebalancing didn't work out, so we split, which needs room in the parent for the separator.
+			if(pParent->mnCount == kNodeValueCapacity)
+			{
+				iterator itParent(pParent, (int)pNode->mnPosition);
+				DoRebalanceOrSplit(itParent);
+				pParent = pNode->parent();
+			}
+		}
+		else
+		{
+			// The root is full; the tree grows a level by putting a new root above it.
+			pParent = DoAllocateNode(false);
+			pParent->mpParent   = NULL;
+			pParent->mnPosition = 0;
+			pParent->set_child(0, pNode);
+			mpRoot = pParent;
+		}
+
+		node_type* const pNodeSplit = DoAllocateNode(pNode->mbLeaf);
+		DoNodeSplit(pNode, pNodeSplit, (size_t)nInsert);
+
+		if(mpRightmost == pNode)
+			mpRightmost = pNodeSplit;
+
+		if(nInsert > (int)pNode->mnCount)
+		{
+			nInsert = nInsert - (int)pNode->mnCount - 1;
+			pNode   = pNodeSplit;
+		}
+	}
+
+
+	// Restores the minimum fill of position's node after a value was removed from it,
+	// walking up the tree as merges remove values from parents. Returns the iterator
+	// for the value that followed the removed one.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	typename btree<K, V, C, A, E, bM, bU, nS>::iterator
+	btree<K, V, C, A, E, bM, bU, nS>::DoRebalanceAfterErase(iterator position)
+	{
+		iterator itResult(position);
+		bool     bFirst = true;
+
+		for(;;)
+		{
+			if(position.mpNode == mpRoot)
+			{
+				DoTryShrink();
+				if(!mpRoot)
+					return end();
+				break;
+			}
+
+			if(position.mpNode->mnCount >= kMinNodeValueCount)
+				break;
+
+			const bool bMerged = DoTryMergeOrRebalance(position);
+
+			// position now refers to where the value after the erased one lives,
+			// which may have moved to a sibling.
+			if(bFirst)
+			{
+				itResult = position;
+				bFirst   = false;
+			}
+
+			if(!bMerged)
+				break;
+
+			position.mnPosition = position.mpNode->mnPosition;
+			position.mpNode     = position.mpNode->parent();
+		}
+
+		// If we are one past the end of a node, advance to the next value.
+		if(itResult.mnPosition == (int)itResult.mpNode->mnCount)
+		{
+			itResult.mnPosition = (int)itResult.mpNode->mnCount - 1;
+			++itResult;
+		}
+
+		return itResult;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	bool btree<K, V, C, A, E, bM, bU, nS>::DoTryMergeOrRebalance(iterator& position)
+	{
+		node_type* const pNode   = position.mpNode;
+		node_type* const pParent = pNode->parent();
+
+		if(pNode->mnPosition > 0)
+		{
+			// Try merging with our left sibling.
+			node_type* const pLeft = pParent->child((size_t)pNode->mnPosition - 1);
+
+			if((1u + pLeft->mnCount + pNode->mnCount) <= kNodeValueCapacity)
+			{
+				position.mnPosition += 1 + (int)pLeft->mnCount;
+				DoNodeMerge(pLeft, pNode);
+				position.mpNode = pLeft;
+				return true;
+			}
+		}
+
+		if(pNode->mnPosition < pParent->mnCount)
+		{
+			// Try merging with our right sibling.
+			node_type* const pRight = pParent->child((size_t)pNode->mnPosition + 1);
+
+			if((1u + pNode->mnCount + pRight->mnCount) <= kNodeValueCapacity)
+			{
+				DoNodeMerge(pNode, pRight);
+				return true;
+			}
+
+			// Try taking values from our right sibling. We skip this if we erased the first value
+			// of a non-empty node, which is the common pattern of erasing from the front.
+			if((pRight->mnCount > kMinNodeValueCount) && ((pNode->mnCount == 0) || (position.mnPosition > 0)))
+			{
+				size_t nMove = (size_t)(pRight->mnCount - pNode->mnCount) / 2;
+				nMove = eastl::min_alt(nMove, (size_t)pRight->mnCount - 1);
+				DoNodeRebalanceRightToLeft(pNode, pRight, nMove);
+				return false;
+			}
+		}
+
+		if(pNode->mnPosition > 0)
+		{
+			// Try taking values from our left sibling. We skip this if we erased the last value
+			// of a non-empty node, which is the common pattern of erasing from the back.
+			node_type* const pLeft = pParent->child((size_t)pNode->mnPosition - 1);
+
+			if((pLeft->mnCount > kMinNodeValueCount) && ((pNode->mnCount == 0) || (position.mnPosition < (int)pNode->mnCount)))
+			{
+				size_t nMove = (size_t)(pLeft->mnCount - pNode->mnCount) / 2;
+				nMove = eastl::min_alt(nMove, (size_t)pLeft->mnCount - 1);
+				DoNodeRebalanceLeftToRight(pLeft, pNode, nMove);
+				position.mnPosition += (int)nMove;
+				return false;
+			}
+		}
+
+		return false;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoTryShrink()
+	{
+		node_type* const pRoot = mpRoot;
+
+		if(pRoot->mnCount == 0)
+		{
+			if(pRoot->mbLeaf)
+				mpRoot = mpLeftmost = mpRightmost = NULL;
+			else
+			{
+				// The root's only child becomes the new root and the tree loses a level.
+				mpRoot = pRoot->child(0);
+				mpRoot->mpParent   = NULL;
+				mpRoot->mnPosition = 0;
+			}
+
+			DoFreeNode(pRoot);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline typename btree<K, V, C, A, E, bM, bU, nS>::node_type*
+	btree<K, V, C, A, E, bM, bU, nS>::DoAllocateNode(bool bLeaf)
+	{
+		const size_t nSize = bLeaf ? sizeof(node_type) : sizeof(internal_node_type);
+		node_type* const pNode = (node_type*)allocate_memory(mAllocator, nSize, EASTL_ALIGN_OF(internal_node_type), 0);
+		EASTL_ASSERT_MSG(pNode != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+
+		pNode->mnCount = 0;
+		pNode->mbLeaf  = bLeaf;
+		return pNode;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::DoFreeNode(node_type* pNode)
+	{
+		EASTLFree(mAllocator, pNode, pNode->mbLeaf ? sizeof(node_type) : sizeof(internal_node_type));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNukeSubtree(node_type* pNode)
+	{
+		if(!pNode->mbLeaf)
+		{
+			for(size_t i = 0, iEnd = (size_t)pNode->mnCount; i <= iEnd; ++i)
+				DoNukeSubtree(pNode->child(i));
+		}
+
+		for(size_t i = 0, iEnd = (size_t)pNode->mnCount; i < iEnd; ++i)
+			pNode->value(i).~value_type();
+
+		DoFreeNode(pNode);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::DoConstructValue(value_type* pValue, Args&&... args)
+	{
+		::new((void*)pValue) value_type(eastl::forward<Args>(args)...);
+	}
+
+
+	// Moves the value at pSource to the uninitialized pDest and destroys the source.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::DoRelocateValue(value_type* pDest, value_type* pSource)
+	{
+		::new((void*)pDest) value_type(eastl::move(*pSource));
+		pSource->~value_type();
+	}
+
+
+	// Relocates n values. The ranges may overlap; we copy in the direction that is safe.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void btree<K, V, C, A, E, bM, bU, nS>::DoRelocateValues(value_type* pDest, value_type* pSource, size_t n)
+	{
+		if(pDest < pSource)
+		{
+			for(size_t i = 0; i < n; ++i)
+				DoRelocateValue(pDest + i, pSource + i);
+		}
+		else
+		{
+			for(size_t i = n; i > 0; --i)
+				DoRelocateValue(pDest + i - 1, pSource + i - 1);
+		}
+	}
+
+
+	// Inserts a value at index i of a node that isn't full. For internal nodes the
+	// children after i shift along with the values; the caller sets child i + 1.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	template <class... Args>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNodeEmplaceValue(node_type* pNode, size_t i, Args&&... args)
+	{
+		const size_t nCount = pNode->mnCount;
+
+		DoRelocateValues(pNode->values() + i + 1, pNode->values() + i, nCount - i);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				DoConstructValue(pNode->values() + i, eastl::forward<Args>(args)...);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoRelocateValues(pNode->values() + i, pNode->values() + i + 1, nCount - i);
+				throw;
+			}
+		#endif
+
+		if(!pNode->mbLeaf)
+		{
+			for(size_t j = nCount; j > i; --j)
+				pNode->set_child(j + 1, pNode->child(j));
+		}
+
+		pNode->mnCount = (uint16_t)(nCount + 1);
+	}
+
+
+	// Closes the gap left by an already destroyed or relocated value at index i. For
+	// internal nodes, child i + 1 is dropped from the child array; the caller owns it.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNodeCloseGap(node_type* pNode, size_t i)
+	{
+		const size_t nCount = pNode->mnCount;
+
+		DoRelocateValues(pNode->values() + i, pNode->values() + i + 1, nCount - i - 1);
+
+		if(!pNode->mbLeaf)
+		{
+			for(size_t j = i + 2; j <= nCount; ++j)
+				pNode->set_child(j - 1, pNode->child(j));
+		}
+
+		pNode->mnCount = (uint16_t)(nCount - 1);
+	}
+
+
+	// Splits a full node, moving its upper values to the empty pNodeDest and the separator
+	// to the parent, which must have room. The split is biased by where the pending
+	// insertion goes: appending leaves the left node full, which makes ascending
+	// insertions produce full nodes, and prepending leaves the right node full.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNodeSplit(node_type* pNode, node_type* pNodeDest, size_t nInsertPosition)
+	{
+		const size_t nCount = pNode->mnCount;
+		size_t       nDestCount;
+
+		if(nInsertPosition == 0)
+			nDestCount = nCount - 1;
+		else if(nInsertPosition == kNodeValueCapacity)
+			nDestCount = 0;
+		else
+			nDestCount = nCount / 2;
+
+		const size_t nLeftCount = nCount - nDestCount - 1; // One value goes up as the separator.
+
+		DoRelocateValues(pNodeDest->values(), pNode->values() + nLeftCount + 1, nDestCount);
+		pNodeDest->mnCount = (uint16_t)nDestCount;
+		pNode->mnCount     = (uint16_t)(nLeftCount + 1);
+
+		node_type* const pParent  = pNode->parent();
+		const size_t     nSepSlot = pNode->mnPosition;
+
+		DoNodeEmplaceValue(pParent, nSepSlot, eastl::move(pNode->value(nLeftCount)));
+		pNode->value(nLeftCount).~value_type();
+		pNode->mnCount = (uint16_t)nLeftCount;
+		pParent->set_child(nSepSlot + 1, pNodeDest);
+
+		if(!pNode->mbLeaf)
+		{
+			for(size_t i = 0; i <= nDestCount; ++i)
+				pNodeDest->set_child(i, pNode->child(nLeftCount + 1 + i));
+		}
+	}
+
+
+	// Moves the parent's separator and all of pNodeRight into pNodeLeft and frees pNodeRight.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNodeMerge(node_type* pNodeLeft, node_type* pNodeRight)
+	{
+		node_type* const pParent   = pNodeLeft->parent();
+		const size_t     nSepSlot  = pNodeLeft->mnPosition;
+		const size_t     nLeft     = pNodeLeft->mnCount;
+		const size_t     nRight    = pNodeRight->mnCount;
+
+		DoRelocateValue(pNodeLeft->values() + nLeft, &pParent->value(nSepSlot));
+		DoRelocateValues(pNodeLeft->values() + nLeft + 1, pNodeRight->values(), nRight);
+
+		if(!pNodeLeft->mbLeaf)
+		{
+			for(size_t i = 0; i <= nRight; ++i)
+				pNodeLeft->set_child(nLeft + 1 + i, pNodeRight->child(i));
+		}
+
+		pNodeLeft->mnCount  = (uint16_t)(nLeft + 1 + nRight);
+		pNodeRight->mnCount = 0;
+
+		DoNodeCloseGap(pParent, nSepSlot);
+
+		if(mpRightmost == pNodeRight)
+			mpRightmost = pNodeLeft;
+
+		DoFreeNode(pNodeRight);
+	}
+
+
+	// Moves nMoveCount values from the end of pNodeLeft to the start of its right sibling,
+	// rotating them through the parent's separator.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNodeRebalanceLeftToRight(node_type* pNodeLeft, node_type* pNodeRight, size_t nMoveCount)
+	{
+		node_type* const pParent  = pNodeLeft->parent();
+		const size_t     nSepSlot = pNodeLeft->mnPosition;
+		const size_t     nLeft    = pNodeLeft->mnCount;
+		const size_t     nRight   = pNodeRight->mnCount;
+
+		DoRelocateValues(pNodeRight->values() + nMoveCount, pNodeRight->values(), nRight);
+		DoRelocateValue(pNodeRight->values() + nMoveCount - 1, &pParent->value(nSepSlot));
+		DoRelocateValues(pNodeRight->values(), pNodeLeft->values() + nLeft - (nMoveCount - 1), nMoveCount - 1);
+		DoRelocateValue(&pParent->value(nSepSlot), pNodeLeft->values() + nLeft - nMoveCount);
+
+		if(!pNodeLeft->mbLeaf)
+		{
+			for(size_t i = nRight + 1; i > 0; --i)
+				pNodeRight->set_child(i - 1 + nMoveCount, pNodeRight->child(i - 1));
+
+			for(size_t i = 0; i < nMoveCount; ++i)
+				pNodeRight->set_child(i, pNodeLeft->child(nLeft - nMoveCount + 1 + i));
+		}
+
+		pNodeLeft->mnCount  = (uint16_t)(nLeft - nMoveCount);
+		pNodeRight->mnCount = (uint16_t)(nRight + nMoveCount);
+	}
+
+
+	// Moves nMoveCount values from the start of pNodeRight to the end of its left sibling,
+	// rotating them through the parent's separator.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	void btree<K, V, C, A, E, bM, bU, nS>::DoNodeRebalanceRightToLeft(node_type* pNodeLeft, node_type* pNodeRight, size_t nMoveCount)
+	{
+		node_type* const pParent  = pNodeLeft->parent();
+		const size_t     nSepSlot = pNodeLeft->mnPosition;
+		const size_t     nLeft    = pNodeLeft->mnCount;
+		const size_t     nRight   = pNodeRight->mnCount;
+
+		DoRelocateValue(pNodeLeft->values() + nLeft, &pParent->value(nSepSlot));
+		DoRelocateValues(pNodeLeft->values() + nLeft + 1, pNodeRight->values(), nMoveCount - 1);
+		DoRelocateValue(&pParent->value(nSepSlot), pNodeRight->values() + nMoveCount - 1);
+		DoRelocateValues(pNodeRight->values(), pNodeRight->values() + nMoveCount, nRight - nMoveCount);
+
+		if(!pNodeLeft->mbLeaf)
+		{
+			for(size_t i = 0; i < nMoveCount; ++i)
+				pNodeLeft->set_child(nLeft + 1 + i, pNodeRight->child(i));
+
+			for(size_t i = 0; i <= (nRight - nMoveCount); ++i)
+				pNodeRight->set_child(i, pNodeRight->child(i + nMoveCount));
+		}
+
+		pNodeLeft->mnCount  = (uint16_t)(nLeft + nMoveCount);
+		pNodeRight->mnCount = (uint16_t)(nRight - nMoveCount);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	int btree<K, V, C, A, E, bM, bU, nS>::DoValidateSubtree(const node_type* pNode, int nDepth) const
+	{
+		// Returns the depth of the subtree's leaves, or -1 if the subtree is invalid.
+		if((pNode->mnCount == 0) || (pNode->mnCount > kNodeValueCapacity))
+			return -1;
+
+		if(pNode->mbLeaf)
+			return nDepth;
+
+		int nLeafDepth = -1;
+
+		for(size_t i = 0; i <= (size_t)pNode->mnCount; ++i)
+		{
+			const node_type* const pChild = pNode->child(i);
+
+			if((pChild->mpParent != pNode) || (pChild->mnPosition != i))
+				return -1;
+
+			const int nChildDepth = DoValidateSubtree(pChild, nDepth + 1);
+
+			if((nChildDepth < 0) || ((i > 0) && (nChildDepth != nLeafDepth)))
+				return -1;
+			nLeafDepth = nChildDepth;
+		}
+
+		return nLeafDepth;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	bool btree<K, V, C, A, E, bM, bU, nS>::validate() const
+	{
+		// Verify basic integrity.
+		if(!mpRoot)
+			return (mnSize == 0) && !mpLeftmost && !mpRightmost;
+
+		if(mpRoot->mpParent || (DoValidateSubtree(mpRoot, 0) < 0))
+			return false;
+
+		// Verify that the cached leftmost and rightmost leaves are right.
+		const node_type* pNode = mpRoot;
+		while(!pNode->mbLeaf)
+			pNode = pNode->child(0);
+		if(pNode != mpLeftmost)
+			return false;
+
+		pNode = mpRoot;
+		while(!pNode->mbLeaf)
+			pNode = pNode->child(pNode->mnCount);
+		if(pNode != mpRightmost)
+			return false;
+
+		// Verify that the values are sorted and that we have the right count.
+		extract_key    extractKey;
+		size_type      nCount = 0;
+		const_iterator itPrev;
+
+		for(const_iterator it = begin(), itEnd = end(); it != itEnd; itPrev = it, ++it, ++nCount)
+		{
+			if(nCount)
+			{
+				if(compare(extractKey(*it), extractKey(*itPrev)))
+					return false;
+
+				if(bU && !compare(extractKey(*itPrev), extractKey(*it))) // Unique trees can't have equivalent values.
+					return false;
+			}
+		}
+
+		return (nCount == mnSize);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline int btree<K, V, C, A, E, bM, bU, nS>::validate_iterator(const_iterator i) const
+	{
+		// To do: Come up with a more efficient mechanism of doing this.
+
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline bool operator==(const btree<K, V, C, A, E, bM, bU, nS>& a, const btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		return (a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin());
+	}
+
+
+	// Note that in operator< we do comparisons based on the tree value_type with operator<() of the
+	// value_type instead of the tree's Compare function. For set/map, value_type is the same as key_type
+	// and for map/multimap, value_type is a pair<const key_type, mapped_type>. See rbtree's operator<.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline bool operator<(const btree<K, V, C, A, E, bM, bU, nS>& a, const btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		return eastl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline bool operator!=(const btree<K, V, C, A, E, bM, bU, nS>& a, const btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		return !(a == b);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline bool operator>(const btree<K, V, C, A, E, bM, bU, nS>& a, const btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		return b < a;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline bool operator<=(const btree<K, V, C, A, E, bM, bU, nS>& a, const btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		return !(b < a);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline bool operator>=(const btree<K, V, C, A, E, bM, bU, nS>& a, const btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		return !(a < b);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, size_t nS>
+	inline void swap(btree<K, V, C, A, E, bM, bU, nS>& a, btree<K, V, C, A, E, bM, bU, nS>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+EA_RESTORE_VC_WARNING();
+
+
+#endif // Header include guard
@@ -718,6 +718,24 @@ namespace eastl
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_HASHTABLE_STATS_ENABLED
+//
+// Defined as 0 or 1. Default is 0.
+// If EASTL_HASHTABLE_STATS_ENABLED is enabled, then hashtables count the
+// rehashes they do and the nodes those rehashes move, which get_stats
+// reports along with the bucket statistics it always reports. This adds
+// two counters to every hashtable and must be the same in every translation
+// unit of a program.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_HASHTABLE_STATS_ENABLED
+	#define EASTL_HASHTABLE_STATS_ENABLED 0
+#endif
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_RTTI_ENABLED
 //
@@ -972,6 +990,25 @@ namespace eastl
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_RBTREE_PACKED_COLOR
+//
+// Defined as 0 or 1. Default is 1.
+// If defined as 1, the red-black tree used by map, set, multimap and multiset
+// stores each node's color in the low bit of its parent pointer instead of
+// in a separate char member. Nodes are always at least pointer-aligned, so
+// that bit is otherwise unused. This removes a pointer's worth of padding
+// from every node (e.g. map<int, int> nodes shrink from 40 to 32 bytes on
+// 64 bit platforms), at the cost of a mask on each parent access.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_RBTREE_PACKED_COLOR
+	#define EASTL_RBTREE_PACKED_COLOR 1
+#endif
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_MAX_STACK_USAGE
 //
@@ -1221,6 +1258,29 @@ namespace eastl
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_PREFETCH
+//
+// Defined as a macro which hints to the processor that the memory at the
+// given address will be read soon, so that it can start loading it into
+// the cache. It has no effect on program semantics; the address doesn't
+// need to be valid. Compilers without a prefetch builtin get a no-op.
+//
+// Example usage:
+//    EASTL_PREFETCH(pNode);
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_PREFETCH
+	#if defined(__GNUC__) || defined(__clang__)
+		#define EASTL_PREFETCH(p) __builtin_prefetch((const void*)(p))
+	#else
+		#define EASTL_PREFETCH(p) ((void)0)
+	#endif
+#endif
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // EASTL_COMPILER_INTRINSIC_TYPE_TRAITS_AVAILABLE
 //
@@ -1626,8 +1686,38 @@ typedef EASTL_SSIZE_T eastl_ssize_t; // Signed version of eastl_size_t. Concept
 	#define EASTLFree(allocator, p, size) (allocator).deallocate((void*)(p), (size)) // Important to cast to void* as p may be non-const.
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT
+//
+// Defined as 0 or 1. Default is 0.
+// When 1, EASTLAllocatorType is eastl::thread_caching_allocator instead of
+// eastl::allocator, and EASTLAllocatorDefault returns its default instance.
+// See <EASTL/thread_caching_allocator.h>.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT
+	#define EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT 0
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// EASTL_ALLOCATION_PROFILING_ENABLED
+//
+// Defined as 0 or 1. Default is 0.
+// When 1, eastl::profiling_allocator records allocation statistics per
+// allocator name. When 0, it simply forwards to the allocator it wraps and
+// has no overhead. See <EASTL/profiling_allocator.h>.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_ALLOCATION_PROFILING_ENABLED
+	#define EASTL_ALLOCATION_PROFILING_ENABLED 0
+#endif
+
 #ifndef EASTLAllocatorType
-	#define EASTLAllocatorType eastl::allocator
+	#if EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT
+		#define EASTLAllocatorType eastl::thread_caching_allocator
+	#else
+		#define EASTLAllocatorType eastl::allocator
+	#endif
 #endif
 
 #ifndef EASTLDummyAllocatorType
@@ -1640,7 +1730,11 @@ typedef EASTL_SSIZE_T eastl_ssize_t; // Signed version of eastl_size_t. Concept
 	// used when EASTL needs to allocate memory internally. There are very few cases where
 	// EASTL allocates memory internally, and in each of these it is for a sensible reason
 	// that is documented to behave as such.
-	#define EASTLAllocatorDefault eastl::GetDefaultAllocator
+	#if EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT
+		#define EASTLAllocatorDefault eastl::GetDefaultThreadCachingAllocator
+	#else
+		#define EASTLAllocatorDefault eastl::GetDefaultAllocator
+	#endif
 #endif
 
 
@@ -1769,6 +1863,15 @@ typedef EASTL_SSIZE_T eastl_ssize_t; // Signed version of eastl_size_t. Concept
 	#define EASTL_ENABLE_PAIR_FIRST_ELEMENT_CONSTRUCTOR 0
 #endif
 
+/// EASTL_STRING_HASH_FNV1
+/// Defined as 1 to make the eastl::hash specializations for strings, string views
+/// and character pointers use the byte-at-a-time 32 bit FNV1 hash of older EASTL
+/// versions, for users who depend on its values (e.g. hashes saved to disk).
+/// Defaults to 0, which uses a faster 64 bit hash that reads 8 to 48 bytes per step.
+#ifndef EASTL_STRING_HASH_FNV1
+	#define EASTL_STRING_HASH_FNV1 0
+#endif
+
 /// EASTL_SYSTEM_BIG_ENDIAN_STATEMENT
 /// EASTL_SYSTEM_LITTLE_ENDIAN_STATEMENT
 /// These macros allow you to write endian specific macros as statements.
@@ -0,0 +1,1548 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements flat_hashtable, the open-addressing hash table that
+// underlies flat_hash_map and flat_hash_set.
+//
+// The primary distinctions between flat_hashtable and hashtable are:
+//    - Elements are stored inline in a single contiguous slot array instead
+//      of in individually allocated nodes. There is exactly one allocation
+//      per table, regardless of the element count.
+//    - Each slot has a companion one byte control value. A control byte is
+//      either a special value (empty, deleted, sentinel) or holds 7 bits of
+//      the element's hash code (called H2 below). Lookups compare a whole
+//      group of control bytes against H2 at once, and the key comparison
+//      is only executed for slots whose H2 matches. On x86 the group is
+//      16 bytes wide and is matched with SSE2 instructions; on other
+//      platforms the group is 8 bytes wide and is matched with portable
+//      64 bit integer arithmetic.
+//    - The probe sequence is triangular (quadratic) over groups, with the
+//      starting position taken from the remaining hash bits (called H1).
+//      The capacity is always a power of two minus one, so the position
+//      reduction is a mask and not a modulus.
+//    - Iterators, pointers and references are invalidated by any insertion
+//      that causes the table to grow, as elements are moved into the new
+//      slot array. Erasure never moves elements.
+//
+// The design follows the "Swiss table" family of hash tables.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_FLAT_HASHTABLE_H
+#define EASTL_INTERNAL_FLAT_HASHTABLE_H
+
+
+#include <EABase/eabase.h>
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/allocator.h>
+#include <EASTL/iterator.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/initializer_list.h>
+#include <EASTL/tuple.h>
+#include <EASTL/memory.h>
+#include <EASTL/bit.h>
+#include <string.h>
+#if EASTL_EXCEPTIONS_ENABLED
+#include <stdexcept>
+#endif
+
+EA_DISABLE_ALL_VC_WARNINGS()
+	#include <new>
+	#include <stddef.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+/// EASTL_FLAT_HASHTABLE_SSE2
+///
+/// Defined as 1 if flat_hashtable probes groups of 16 control bytes with SSE2
+/// instructions, else 0, in which case groups of 8 control bytes are probed
+/// with portable integer code. The user may define this to 0 to force the
+/// portable implementation.
+///
+#ifndef EASTL_FLAT_HASHTABLE_SSE2
+	#if (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64)) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+		#define EASTL_FLAT_HASHTABLE_SSE2 1
+	#else
+		#define EASTL_FLAT_HASHTABLE_SSE2 0
+	#endif
+#endif
+
+#if EASTL_FLAT_HASHTABLE_SSE2
+	EA_DISABLE_ALL_VC_WARNINGS()
+		#include <emmintrin.h>
+	EA_RESTORE_ALL_VC_WARNINGS()
+#endif
+
+#if defined(EA_COMPILER_MSVC) && !defined(__clang__)
+	#include <intrin.h>
+#endif
+
+// 4512/4626 - 'class' : assignment operator could not be generated.
+// 4530 - C++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
+// 4571 - catch(...) semantics changed since Visual C++ 7.1; structured exceptions (SEH) are no longer caught.
+EA_DISABLE_VC_WARNING(4512 4626 4530 4571);
+
+
+namespace eastl
+{
+
+	/// EASTL_FLAT_HASHTABLE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_FLAT_HASHTABLE_DEFAULT_NAME
+		#define EASTL_FLAT_HASHTABLE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " flat_hashtable" // Unless the user overrides something, this is "EASTL flat_hashtable".
+	#endif
+
+
+	/// EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR
+		#define EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR allocator_type(EASTL_FLAT_HASHTABLE_DEFAULT_NAME)
+	#endif
+
+
+	namespace internal
+	{
+		/// flat_hash_ctrl_t
+		///
+		/// The type of a control byte. Full slots store the 7 bit H2 value of
+		/// the element's hash (and so are >= 0); all special values are negative.
+		///
+		typedef int8_t flat_hash_ctrl_t;
+
+		static const flat_hash_ctrl_t kFlatHashCtrlEmpty    = -128; // 0b10000000
+		static const flat_hash_ctrl_t kFlatHashCtrlDeleted  = -2;   // 0b11111110
+		static const flat_hash_ctrl_t kFlatHashCtrlSentinel = -1;   // 0b11111111
+
+		inline bool FlatHashIsEmpty(flat_hash_ctrl_t c)          { return c == kFlatHashCtrlEmpty; }
+		inline bool FlatHashIsFull(flat_hash_ctrl_t c)           { return c >= 0; }
+		inline bool FlatHashIsEmptyOrDeleted(flat_hash_ctrl_t c) { return c < kFlatHashCtrlSentinel; }
+
+
+		/// FlatHashCountTrailingZeros
+		///
+		/// Returns the number of trailing zero bits in a non-zero value.
+		///
+		inline uint32_t FlatHashCountTrailingZeros(uint32_t x)
+		{
+			#if defined(EA_COMPILER_MSVC) && !defined(__clang__)
+				unsigned long index;
+				_BitScanForward(&index, x);
+				return (uint32_t)index;
+			#elif defined(__GNUC__) || defined(__clang__)
+				return (uint32_t)__builtin_ctz(x);
+			#else
+				uint32_t n = 0;
+				while(!(x & 1)) { x >>= 1; ++n; }
+				return n;
+			#endif
+		}
+
+		inline uint32_t FlatHashCountTrailingZeros(uint64_t x)
+		{
+			#if defined(EA_COMPILER_MSVC) && !defined(__clang__) && defined(EA_PROCESSOR_X86_64)
+				unsigned long index;
+				_BitScanForward64(&index, x);
+				return (uint32_t)index;
+			#elif defined(__GNUC__) || defined(__clang__)
+				return (uint32_t)__builtin_ctzll(x);
+			#else
+				const uint32_t nLow = (uint32_t)x;
+				return nLow ? FlatHashCountTrailingZeros(nLow) : (32 + FlatHashCountTrailingZeros((uint32_t)(x >> 32)));
+			#endif
+		}
+
+
+		/// flat_hash_bitmask
+		///
+		/// A bit mask produced by matching a group of control bytes. Each of the
+		/// kWidth slots of the group is represented by (1 << Shift) bits of which
+		/// only the lowest or highest is set. Iterating the mask yields the
+		/// group-relative indexes of the matched slots, in ascending order.
+		///
+		template <typename T, int Width, int Shift>
+		class flat_hash_bitmask
+		{
+		public:
+			explicit flat_hash_bitmask(T mask) : mMask(mask) { }
+
+			explicit operator bool() const { return mMask != 0; }
+
+			uint32_t LowestBitSet() const  { return FlatHashCountTrailingZeros(mMask) >> Shift; }
+			uint32_t TrailingZeros() const { return FlatHashCountTrailingZeros(mMask) >> Shift; }
+			uint32_t LeadingZeros() const
+			{
+				const int kExtraBits = (int)(sizeof(T) * CHAR_BIT) - (Width << Shift);
+				return (uint32_t)(eastl::countl_zero(mMask) - kExtraBits) >> Shift;
+			}
+
+			void ClearLowestBit() { mMask &= (mMask - 1); }
+
+		protected:
+			T mMask;
+		};
+
+
+		#if EASTL_FLAT_HASHTABLE_SSE2
+
+			/// flat_hash_group
+			///
+			/// Sixteen control bytes, matched in parallel with SSE2 byte compares.
+			///
+			struct flat_hash_group
+			{
+				static const size_t kWidth = 16;
+				typedef flat_hash_bitmask<uint32_t, 16, 0> bitmask_type;
+
+				explicit flat_hash_group(const flat_hash_ctrl_t* pControl)
+					: mControl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pControl))) { }
+
+				// Returns the slots whose control byte is equal to h2.
+				bitmask_type Match(flat_hash_ctrl_t h2) const
+					{ return bitmask_type((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), mControl))); }
+
+				bitmask_type MatchEmpty() const
+					{ return Match(kFlatHashCtrlEmpty); }
+
+				bitmask_type MatchEmptyOrDeleted() const
+					{ return bitmask_type((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashCtrlSentinel), mControl))); }
+
+				// Returns the number of consecutive empty or deleted slots at the start of the group.
+				uint32_t CountLeadingEmptyOrDeleted() const
+					{ return FlatHashCountTrailingZeros((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashCtrlSentinel), mControl)) + 1); }
+
+				__m128i mControl;
+			};
+
+		#else
+
+			/// flat_hash_group
+			///
+			/// Eight control bytes, matched in parallel with 64 bit integer arithmetic.
+			/// Each slot is represented by the high bit of its byte in the bit masks.
+			///
+			struct flat_hash_group
+			{
+				static const size_t kWidth = 8;
+				typedef flat_hash_bitmask<uint64_t, 8, 3> bitmask_type;
+
+				explicit flat_hash_group(const flat_hash_ctrl_t* pControl)
+				{
+					memcpy(&mControl, pControl, sizeof(mControl));
+
+					#if defined(EA_SYSTEM_BIG_ENDIAN)
+						// The bit mask code requires the first control byte in the least significant byte.
+						uint64_t x = mControl;
+						x = ((x & UINT64_C(0x00000000FFFFFFFF)) << 32) | ((x & UINT64_C(0xFFFFFFFF00000000)) >> 32);
+						x = ((x & UINT64_C(0x0000FFFF0000FFFF)) << 16) | ((x & UINT64_C(0xFFFF0000FFFF0000)) >> 16);
+						x = ((x & UINT64_C(0x00FF00FF00FF00FF)) <<  8) | ((x & UINT64_C(0xFF00FF00FF00FF00)) >>  8);
+						mControl = x;
+					#endif
+				}
+
+				// Returns the slots whose control byte is equal to h2. This may report false
+				// positives for bytes that follow a true match, which is harmless because
+				// every match is confirmed with a key comparison.
+				bitmask_type Match(flat_hash_ctrl_t h2) const
+				{
+					const uint64_t kMsbs = UINT64_C(0x8080808080808080);
+					const uint64_t kLsbs = UINT64_C(0x0101010101010101);
+					const uint64_t x     = mControl ^ (kLsbs * (uint8_t)h2);
+					return bitmask_type((x - kLsbs) & ~x & kMsbs);
+				}
+
+				bitmask_type MatchEmpty() const
+					{ return bitmask_type((mControl & (~mControl << 6)) & UINT64_C(0x8080808080808080)); }
+
+				bitmask_type MatchEmptyOrDeleted() const
+					{ return bitmask_type((mControl & (~mControl << 7)) & UINT64_C(0x8080808080808080)); }
+
+				// Returns the number of consecutive empty or deleted slots at the start of the group.
+				uint32_t CountLeadingEmptyOrDeleted() const
+				{
+					const uint64_t kGaps = UINT64_C(0x00FEFEFEFEFEFEFE);
+					return (FlatHashCountTrailingZeros(((~mControl & (mControl >> 7)) | kGaps) + 1) + 7) >> 3;
+				}
+
+				uint64_t mControl;
+			};
+
+		#endif
+
+
+		/// FlatHashMix
+		///
+		/// Spreads the entropy of a user hash value over all of its bits. This is
+		/// required because the low 7 bits of the result are stored as H2 and the
+		/// rest select the probe start, whereas eastl::hash for integral types
+		/// is the identity function.
+		///
+		inline size_t FlatHashMix(size_t h)
+		{
+			#if (EA_PLATFORM_PTR_SIZE == 8)
+				const uint64_t m = (uint64_t)h * UINT64_C(0x9E3779B97F4A7C15);
+				return (size_t)(m ^ (m >> 32));
+			#else
+				const uint32_t m = (uint32_t)h * 0x9E3779B9u;
+				return (size_t)(m ^ (m >> 16));
+			#endif
+		}
+
+		inline flat_hash_ctrl_t FlatHashH2(size_t h) { return (flat_hash_ctrl_t)(h & 0x7F); }
+
+		// Like ht_distance in hashtable.h: the distance for forward iterators, zero for
+		// input iterators, which can only be traversed once. Used only to presize.
+		template <typename Iterator>
+		inline size_t FlatHashDistance(Iterator first, Iterator last, eastl::input_iterator_tag)
+			{ EA_UNUSED(first); EA_UNUSED(last); return 0; }
+
+		template <typename Iterator>
+		inline size_t FlatHashDistance(Iterator first, Iterator last, eastl::forward_iterator_tag)
+			{ return (size_t)eastl::distance(first, last); }
+
+	} // namespace internal
+
+
+	/// gFlatHashEmptyGroup
+	///
+	/// A shared control byte array for empty flat hash tables, which allows a
+	/// default constructed table to allocate no memory. The first byte is the
+	/// sentinel and the remainder are empty, so lookups terminate immediately.
+	///
+	extern EASTL_API internal::flat_hash_ctrl_t gFlatHashEmptyGroup[16];
+
+
+
+	/// flat_hashtable_iterator
+	///
+	/// Iterates the full slots of a flat_hashtable in slot order. An iterator is
+	/// a pointer to a control byte and a pointer to the corresponding slot.
+	/// The trailing sentinel control byte terminates iteration, so the end
+	/// iterator points at the sentinel.
+	///
+	template <typename Value, bool bConst>
+	struct flat_hashtable_iterator
+	{
+	public:
+		typedef flat_hashtable_iterator<Value, bConst>                  this_type;
+		typedef flat_hashtable_iterator<Value, false>                   this_type_non_const;
+		typedef Value                                                   value_type;
+		typedef typename conditional<bConst, const Value*, Value*>::type pointer;
+		typedef typename conditional<bConst, const Value&, Value&>::type reference;
+		typedef ptrdiff_t                                               difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                      iterator_category;
+
+	public:
+		const internal::flat_hash_ctrl_t* mpControl;
+		Value*                            mpSlot;
+
+	public:
+		flat_hashtable_iterator()
+			: mpControl(NULL), mpSlot(NULL) { }
+
+		flat_hashtable_iterator(const internal::flat_hash_ctrl_t* pControl, Value* pSlot)
+			: mpControl(pControl), mpSlot(pSlot) { }
+
+		template <bool IsConst = bConst, typename enable_if<IsConst, int>::type = 0>
+		flat_hashtable_iterator(const this_type_non_const& x)
+			: mpControl(x.mpControl), mpSlot(x.mpSlot) { }
+
+		flat_hashtable_iterator(const flat_hashtable_iterator&) = default;
+		flat_hashtable_iterator& operator=(const flat_hashtable_iterator&) = default;
+
+		reference operator*() const
+			{ return *mpSlot; }
+
+		pointer operator->() const
+			{ return mpSlot; }
+
+		flat_hashtable_iterator& operator++()
+			{ ++mpControl; ++mpSlot; skip_empty_or_deleted(); return *this; }
+
+		flat_hashtable_iterator operator++(int)
+			{ flat_hashtable_iterator temp(*this); ++*this; return temp; }
+
+		// Advances to the next full slot or to the sentinel, whichever comes first.
+		void skip_empty_or_deleted()
+		{
+			while(internal::FlatHashIsEmptyOrDeleted(*mpControl))
+			{
+				const uint32_t nShift = internal::flat_hash_group(mpControl).CountLeadingEmptyOrDeleted();
+				mpControl += nShift;
+				mpSlot    += nShift;
+			}
+		}
+	}; // flat_hashtable_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator==(const flat_hashtable_iterator<Value, bConstA>& a, const flat_hashtable_iterator<Value, bConstB>& b)
+		{ return a.mpControl == b.mpControl; }
+
+	#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator!=(const flat_hashtable_iterator<Value, bConstA>& a, const flat_hashtable_iterator<Value, bConstB>& b)
+		{ return a.mpControl != b.mpControl; }
+	#endif
+
+
+
+	/// flat_hashtable
+	///
+	/// Key is the key_type. Value is the value_type, which is either Key or
+	/// pair<const Key, T>. ExtractKey returns the key of a value. Equal is the
+	/// key equality predicate and Hash is the user's hash function object.
+	/// bMutableIterators is false for sets, whose elements must not be changed
+	/// in place. Keys are always unique.
+	///
+	/// The capacity (bucket_count) is zero or (2^n - 1). At most 7/8ths of
+	/// the slots are used before the table grows, which keeps probe sequences
+	/// short. The control array holds capacity + 1 + (kWidth - 1) bytes: one
+	/// per slot, the sentinel and a copy of the first (kWidth - 1) bytes so
+	/// that a group load starting near the end of the table needs no wrapping.
+	///
+	template <typename Key, typename Value, typename Allocator, typename ExtractKey,
+			  typename Equal, typename Hash, bool bMutableIterators>
+	class flat_hashtable
+	{
+	public:
+		typedef Key                                                                       key_type;
+		typedef Value                                                                     value_type;
+		typedef Allocator                                                                 allocator_type;
+		typedef Hash                                                                      hasher;
+		typedef Equal                                                                     key_equal;
+		typedef ExtractKey                                                                extract_key_type;
+		typedef ptrdiff_t                                                                 difference_type;
+		typedef eastl_size_t                                                              size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef value_type&                                                               reference;
+		typedef const value_type&                                                         const_reference;
+		typedef flat_hashtable_iterator<value_type, !bMutableIterators>                   iterator;
+		typedef flat_hashtable_iterator<value_type, true>                                 const_iterator;
+		typedef eastl::pair<iterator, bool>                                               insert_return_type;
+		typedef flat_hashtable<Key, Value, Allocator, ExtractKey, Equal, Hash, bMutableIterators> this_type;
+		typedef internal::flat_hash_ctrl_t                                                ctrl_type;
+		typedef internal::flat_hash_group                                                 group_type;
+
+		static const size_type kGroupWidth = (size_type)group_type::kWidth;
+
+	protected:
+		ctrl_type*      mpControl;      // Control bytes; gFlatHashEmptyGroup when mnCapacity is 0.
+		value_type*     mpSlots;        // Uninitialized slot storage, constructed where the control byte is full.
+		size_type       mnCapacity;     // Zero or a power of two minus one, so it can be used as a mask.
+		size_type       mnElementCount;
+		size_type       mnGrowthLeft;   // Number of empty slots that can be filled before the table must grow.
+		Hash            mHash;
+		Equal           mEqual;
+		ExtractKey      mExtractKey;
+		allocator_type  mAllocator;     // To do: Use base class optimization to make this go away.
+
+	public:
+		flat_hashtable(size_type nBucketCount, const Hash& hashFunction, const Equal& equal, const ExtractKey& extractKey,
+					   const allocator_type& allocator = EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR);
+
+		// note: standard only requires InputIterator.
+		template <typename InputIterator>
+		flat_hashtable(InputIterator first, InputIterator last, size_type nBucketCount, const Hash& hashFunction,
+					   const Equal& equal, const ExtractKey& extractKey, const allocator_type& allocator = EASTL_FLAT_HASHTABLE_DEFAULT_ALLOCATOR);
+
+		flat_hashtable(const this_type& x);
+		flat_hashtable(this_type&& x);
+		flat_hashtable(this_type&& x, const allocator_type& allocator);
+	   ~flat_hashtable();
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT { return mAllocator; }
+		allocator_type&       get_allocator() EA_NOEXCEPT       { return mAllocator; }
+		void                  set_allocator(const allocator_type& allocator);
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		this_type& operator=(this_type&& x);
+
+		void swap(this_type& x);
+
+		iterator begin() EA_NOEXCEPT
+		{
+			iterator i(mpControl, mpSlots);
+			i.skip_empty_or_deleted();
+			return i;
+		}
+
+		const_iterator begin() const EA_NOEXCEPT
+		{
+			const_iterator i(mpControl, mpSlots);
+			i.skip_empty_or_deleted();
+			return i;
+		}
+
+		const_iterator cbegin() const EA_NOEXCEPT
+			{ return begin(); }
+
+		iterator end() EA_NOEXCEPT
+			{ return iterator(mpControl + mnCapacity, mpSlots + mnCapacity); }
+
+		const_iterator end() const EA_NOEXCEPT
+			{ return const_iterator(mpControl + mnCapacity, mpSlots + mnCapacity); }
+
+		const_iterator cend() const EA_NOEXCEPT
+			{ return end(); }
+
+		bool empty() const EA_NOEXCEPT
+			{ return mnElementCount == 0; }
+
+		size_type size() const EA_NOEXCEPT
+			{ return mnElementCount; }
+
+		/// Returns the number of slots. Unlike hashtable, every slot holds at most one element.
+		size_type bucket_count() const EA_NOEXCEPT
+			{ return mnCapacity; }
+
+		float load_factor() const EA_NOEXCEPT
+			{ return mnCapacity ? ((float)mnElementCount / (float)mnCapacity) : 0.f; }
+
+		/// The maximum load factor is fixed at 7/8 and cannot be changed.
+		float get_max_load_factor() const EA_NOEXCEPT
+			{ return 0.875f; }
+
+		const hasher& hash_function() const
+			{ return mHash; }
+
+		const key_equal& key_eq() const
+			{ return mEqual; }
+
+		key_equal& key_eq()
+			{ return mEqual; }
+
+		template <class... Args>
+		insert_return_type emplace(Args&&... args);
+
+		template <class... Args>
+		iterator emplace_hint(const_iterator position, Args&&... args);
+
+		insert_return_type                     insert(const value_type& value);
+		insert_return_type                     insert(value_type&& otherValue);
+		iterator                               insert(const_iterator hint, const value_type& value);
+		iterator                               insert(const_iterator hint, value_type&& value);
+		void                                   insert(std::initializer_list<value_type> ilist);
+		template <typename InputIterator> void insert(InputIterator first, InputIterator last);
+
+		template <typename Iter = iterator, typename eastl::enable_if<!eastl::is_same_v<Iter, const_iterator>, int>::type = 0>
+		iterator         erase(iterator position) { return erase(const_iterator(position)); }
+		iterator         erase(const_iterator position);
+		iterator         erase(const_iterator first, const_iterator last);
+		size_type        erase(const key_type& k) { return DoErase(k); }
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		size_type        erase(KX&& k) { return DoErase(k); }
+
+		void clear();
+		void clear(bool clearBuckets);                  // If clearBuckets is true, we free the slot memory and return to the newly constructed state.
+		void reset_lose_memory() EA_NOEXCEPT;           // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
+		void rehash(size_type nBucketCount);
+		void reserve(size_type nElementCount);
+
+		iterator       find(const key_type& key)       { return DoFind(key); }
+		const_iterator find(const key_type& key) const { return DoFind(key); }
+
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		iterator       find(const KX& key) { return DoFind(key); }
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		const_iterator find(const KX& key) const { return DoFind(key); }
+
+		/// Implements a find whereby the user supplies a key of a different type
+		/// along with hash and equality function objects that must have the same
+		/// semantics as the container's. See hashtable::find_as.
+		template <typename U, typename UHash, typename BinaryPredicate>
+		iterator       find_as(const U& u, UHash uhash, BinaryPredicate predicate);
+
+		template <typename U, typename UHash, typename BinaryPredicate>
+		const_iterator find_as(const U& u, UHash uhash, BinaryPredicate predicate) const;
+
+		bool contains(const key_type& key) const { return DoFindIndex(key, DoHash(key)) != kNotFound; }
+
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		bool contains(const KX& key) const { return DoFindIndex(key, DoHash(key)) != kNotFound; }
+
+		size_type count(const key_type& k) const EA_NOEXCEPT { return contains(k) ? 1 : 0; }
+
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		size_type count(const KX& k) const EA_NOEXCEPT { return contains(k) ? 1 : 0; }
+
+		eastl::pair<iterator, iterator>             equal_range(const key_type& k)       { return DoEqualRange(k); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return DoEqualRange(k); }
+
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& k) { return DoEqualRange(k); }
+		template<typename KX, typename HX = Hash, typename EqX = Equal,
+			eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<HX> && eastl::detail::is_transparent_comparison_v<EqX>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& k) const { return DoEqualRange(k); }
+
+		bool validate() const;
+		int  validate_iterator(const_iterator i) const;
+
+	protected:
+		static const size_type kNotFound = (size_type)-1;
+
+		/// flat_hash_probe_seq
+		///
+		/// Visits groups in the order offset, offset + 1 * kWidth, offset + 3 * kWidth,
+		/// offset + 6 * kWidth, ... (mod capacity + 1). This triangular sequence
+		/// visits every group exactly once when the group count is a power of two.
+		///
+		struct probe_seq
+		{
+			size_type mnMask;
+			size_type mnOffset;
+			size_type mnIndex;
+
+			probe_seq(size_t h1, size_type nMask)
+				: mnMask(nMask), mnOffset((size_type)h1 & nMask), mnIndex(0) { }
+
+			size_type offset(size_type i) const { return (mnOffset + i) & mnMask; }
+
+			void next()
+			{
+				mnIndex  += kGroupWidth;
+				mnOffset += mnIndex;
+				mnOffset &= mnMask;
+			}
+		};
+
+		static size_type NormalizeCapacity(size_type n)
+			{ return n ? (~size_type(0) >> eastl::countl_zero(n)) : 1; }
+
+		static size_type CapacityToGrowth(size_type nCapacity)
+		{
+			// With a group width of 8 and a capacity of 7, 7/8ths would leave no empty slot for lookups to stop at.
+			if((kGroupWidth == 8) && (nCapacity == 7))
+				return 6;
+			return nCapacity - (nCapacity / 8);
+		}
+
+		static size_type GrowthToLowerBoundCapacity(size_type nGrowth)
+		{
+			if((kGroupWidth == 8) && (nGrowth == 7))
+				return 8;
+			return nGrowth + (size_type)((int64_t(nGrowth) - 1) / 7);
+		}
+
+		// The per-table salt breaks up clustering that occurs when elements are inserted in
+		// the iteration order of another table with the same hash function.
+		size_t    DoH1(size_t h) const { return (h >> 7) ^ ((uintptr_t)mpControl >> 12); }
+		probe_seq DoProbe(size_t h) const { return probe_seq(DoH1(h), mnCapacity); }
+
+		template <typename KX>
+		size_t DoHash(const KX& k) const { return internal::FlatHashMix((size_t)mHash(k)); }
+
+		template <typename KX>
+		size_type DoFindIndex(const KX& k, size_t h) const;
+
+		template <typename KX>
+		eastl::pair<size_type, bool> DoFindOrPrepareInsert(const KX& k);
+
+		template <typename KX>
+		iterator DoFind(const KX& k)
+		{
+			const size_type i = DoFindIndex(k, DoHash(k));
+			return (i == kNotFound) ? end() : DoMakeIterator(i);
+		}
+
+		template <typename KX>
+		const_iterator DoFind(const KX& k) const
+		{
+			const size_type i = DoFindIndex(k, DoHash(k));
+			return (i == kNotFound) ? end() : DoMakeIterator(i);
+		}
+
+		template <typename KX>
+		size_type DoErase(const KX& k);
+
+		template <typename KX>
+		eastl::pair<iterator, iterator> DoEqualRange(const KX& k)
+		{
+			const iterator it = DoFind(k);
+			return eastl::pair<iterator, iterator>(it, (it == end()) ? it : eastl::next(it));
+		}
+
+		template <typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& k) const
+		{
+			const const_iterator it = DoFind(k);
+			return eastl::pair<const_iterator, const_iterator>(it, (it == end()) ? it : eastl::next(it));
+		}
+
+		template <typename VX>
+		insert_return_type DoInsertValue(VX&& value);
+
+		template <typename VX>
+		insert_return_type DoEmplace(true_type, VX&& value) // The argument is a value_type; no temporary is needed.
+			{ return DoInsertValue(eastl::forward<VX>(value)); }
+
+		template <class... Args>
+		insert_return_type DoEmplace(false_type, Args&&... args);
+
+		template <typename... Args>
+		void DoConstructSlot(size_type i, Args&&... args);
+
+		iterator DoMakeIterator(size_type i) const
+			{ return iterator(mpControl + i, mpSlots + i); }
+
+		size_type DoFindFirstNonFull(size_t h) const;
+		size_type DoPrepareInsert(size_t h);
+		void      DoSetControl(size_type i, ctrl_type h);
+		void      DoEraseMetaOnly(size_type i);
+		void      DoResetControl();
+		void      DoRehashAndGrowIfNecessary();
+		void      DoResize(size_type nNewCapacity);
+		void      DoDestroySlots();
+		void      DoAllocate(size_type nCapacity);
+		void      DoFree(ctrl_type* pControl, size_type nCapacity);
+		void      DoCopyFrom(const this_type& x);
+		void      DoMoveFrom(this_type& x);
+
+		static size_type DoSlotOffset(size_type nCapacity)
+		{
+			// Slots follow the control bytes, aligned for value_type.
+			const size_type nControlBytes = nCapacity + kGroupWidth;
+			const size_type nAlign        = (size_type)EASTL_ALIGN_OF(value_type);
+			return (nControlBytes + nAlign - 1) & ~(nAlign - 1);
+		}
+
+		static size_type DoAllocationSize(size_type nCapacity)
+			{ return DoSlotOffset(nCapacity) + (nCapacity * sizeof(value_type)); }
+
+	}; // class flat_hashtable
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// flat_hashtable
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(size_type nBucketCount, const H& hashFunction, const Eq& equal,
+														   const EK& extractKey, const allocator_type& allocator)
+		: mHash(hashFunction),
+		  mEqual(equal),
+		  mExtractKey(extractKey),
+		  mAllocator(allocator)
+	{
+		reset_lose_memory();
+
+		if(nBucketCount > 0)
+			DoResize(NormalizeCapacity(nBucketCount));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename InputIterator>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(InputIterator first, InputIterator last, size_type nBucketCount,
+														   const H& hashFunction, const Eq& equal, const EK& extractKey,
+														   const allocator_type& allocator)
+		: mHash(hashFunction),
+		  mEqual(equal),
+		  mExtractKey(extractKey),
+		  mAllocator(allocator)
+	{
+		reset_lose_memory();
+
+		if(nBucketCount > 0)
+			DoResize(NormalizeCapacity(nBucketCount));
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				insert(first, last);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				clear(true);
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(const this_type& x)
+		: mHash(x.mHash),
+		  mEqual(x.mEqual),
+		  mExtractKey(x.mExtractKey),
+		  mAllocator(x.mAllocator)
+	{
+		reset_lose_memory();
+		DoCopyFrom(x);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(this_type&& x)
+		: mHash(x.mHash),
+		  mEqual(x.mEqual),
+		  mExtractKey(x.mExtractKey),
+		  mAllocator(x.mAllocator)
+	{
+		reset_lose_memory();
+		swap(x);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::flat_hashtable(this_type&& x, const allocator_type& allocator)
+		: mHash(x.mHash),
+		  mEqual(x.mEqual),
+		  mExtractKey(x.mExtractKey),
+		  mAllocator(allocator)
+	{
+		reset_lose_memory();
+
+		if(mAllocator == x.mAllocator)
+			swap(x);
+		else
+			DoMoveFrom(x);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline flat_hashtable<K, V, A, EK, Eq, H, bM>::~flat_hashtable()
+	{
+		DoDestroySlots();
+		DoFree(mpControl, mnCapacity);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::set_allocator(const allocator_type& allocator)
+	{
+		if(mnCapacity && (mAllocator != allocator))
+			EASTL_THROW_MSG_OR_ASSERT(std::logic_error, "flat_hashtable::set_allocator -- cannot change allocator after allocations have been made.");
+
+		mAllocator = allocator;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::this_type&
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			clear();
+
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				if(mAllocator != x.mAllocator)
+				{
+					DoFree(mpControl, mnCapacity);
+					reset_lose_memory();
+					mAllocator = x.mAllocator;
+				}
+			#endif
+
+			mHash       = x.mHash;
+			mEqual      = x.mEqual;
+			mExtractKey = x.mExtractKey;
+			DoCopyFrom(x);
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::this_type&
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::operator=(this_type&& x)
+	{
+		if(this != &x)
+		{
+			clear();
+
+			if(mAllocator == x.mAllocator)
+				swap(x);
+			else
+				DoMoveFrom(x);
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::this_type&
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::operator=(std::initializer_list<value_type> ilist)
+	{
+		clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::swap(this_type& x)
+	{
+		eastl::swap(mpControl, x.mpControl);
+		eastl::swap(mpSlots, x.mpSlots);
+		eastl::swap(mnCapacity, x.mnCapacity);
+		eastl::swap(mnElementCount, x.mnElementCount);
+		eastl::swap(mnGrowthLeft, x.mnGrowthLeft);
+		eastl::swap(mHash, x.mHash);
+		eastl::swap(mEqual, x.mEqual);
+		eastl::swap(mExtractKey, x.mExtractKey);
+
+		if(mAllocator != x.mAllocator) // If allocators are not equivalent...
+			eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoCopyFrom(const this_type& x)
+	{
+		// Precondition: we are empty. Elements of x are known to be unique, so
+		// we skip the lookup and place each one at its first free slot.
+		if(x.mnElementCount)
+		{
+			reserve(x.mnElementCount);
+
+			for(const_iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+			{
+				const size_t    h = DoHash(mExtractKey(*it));
+				const size_type i = DoPrepareInsert(h);
+				DoConstructSlot(i, *it);
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoMoveFrom(this_type& x)
+	{
+		// Precondition: we are empty and our allocator differs from x's, so we can't take x's memory.
+		if(x.mnElementCount)
+		{
+			reserve(x.mnElementCount);
+
+			for(iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+			{
+				const size_t    h = DoHash(mExtractKey(*it));
+				const size_type i = DoPrepareInsert(h);
+				DoConstructSlot(i, eastl::move(*it.mpSlot));
+			}
+		}
+
+		x.clear();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename KX>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFindIndex(const KX& k, size_t h) const
+	{
+		// An empty table points at gFlatHashEmptyGroup with a mask of zero, so the
+		// first group has no matches and an empty slot; no special case is needed.
+		probe_seq seq = DoProbe(h);
+		const ctrl_type h2 = internal::FlatHashH2(h);
+
+		for(;;)
+		{
+			const group_type g(mpControl + seq.mnOffset);
+
+			for(typename group_type::bitmask_type m = g.Match(h2); m; m.ClearLowestBit())
+			{
+				const size_type i = seq.offset(m.LowestBitSet());
+
+				if(EASTL_LIKELY(mEqual(mExtractKey(mpSlots[i]), k)))
+					return i;
+			}
+
+			if(EASTL_LIKELY(g.MatchEmpty()))
+				return kNotFound;
+
+			seq.next();
+			EASTL_ASSERT_MSG(seq.mnIndex <= mnCapacity, "flat_hashtable: full table");
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFindFirstNonFull(size_t h) const
+	{
+		probe_seq seq = DoProbe(h);
+
+		for(;;)
+		{
+			const typename group_type::bitmask_type m = group_type(mpControl + seq.mnOffset).MatchEmptyOrDeleted();
+
+			if(m)
+				return seq.offset(m.LowestBitSet());
+
+			seq.next();
+			EASTL_ASSERT_MSG(seq.mnIndex <= mnCapacity, "flat_hashtable: full table");
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename KX>
+	eastl::pair<typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type, bool>
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFindOrPrepareInsert(const KX& k)
+	{
+		const size_t    h = DoHash(k);
+		const size_type i = DoFindIndex(k, h);
+
+		if(i != kNotFound)
+			return eastl::pair<size_type, bool>(i, false);
+
+		return eastl::pair<size_type, bool>(DoPrepareInsert(h), true);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoPrepareInsert(size_t h)
+	{
+		// Claims a slot for an element with hash h and marks it full. The caller must construct the slot.
+		size_type i = DoFindFirstNonFull(h);
+
+		// Reusing a deleted slot doesn't consume growth, so we only grow when we'd take an empty slot.
+		if(EASTL_UNLIKELY((mnGrowthLeft == 0) && !(mpControl[i] == internal::kFlatHashCtrlDeleted)))
+		{
+			DoRehashAndGrowIfNecessary();
+			i = DoFindFirstNonFull(h);
+		}
+
+		++mnElementCount;
+		mnGrowthLeft -= internal::FlatHashIsEmpty(mpControl[i]) ? 1 : 0;
+		DoSetControl(i, internal::FlatHashH2(h));
+		return i;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename... Args>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoConstructSlot(size_type i, Args&&... args)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				detail::allocator_construct(mAllocator, mpSlots + i, eastl::forward<Args>(args)...);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoEraseMetaOnly(i); // Give the slot back, as if the element had been inserted and then erased.
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoSetControl(size_type i, ctrl_type h)
+	{
+		// The first (kGroupWidth - 1) control bytes are mirrored after the sentinel. For
+		// i >= kGroupWidth - 1 this writes mpControl[i] a second time, which is harmless.
+		mpControl[i] = h;
+		mpControl[((i - (kGroupWidth - 1)) & mnCapacity) + ((kGroupWidth - 1) & mnCapacity)] = h;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoEraseMetaOnly(size_type i)
+	{
+		--mnElementCount;
+
+		// If the slot is inside a run of fewer than kGroupWidth full or deleted slots, then
+		// no probe sequence ever passed over it on its way to an empty slot, and we can mark
+		// it empty instead of leaving a tombstone that lookups would have to skip.
+		const size_type nIndexBefore = (i - kGroupWidth) & mnCapacity;
+		const typename group_type::bitmask_type emptyAfter  = group_type(mpControl + i).MatchEmpty();
+		const typename group_type::bitmask_type emptyBefore = group_type(mpControl + nIndexBefore).MatchEmpty();
+
+		const bool bWasNeverFull = emptyBefore && emptyAfter &&
+								   ((emptyAfter.TrailingZeros() + emptyBefore.LeadingZeros()) < kGroupWidth);
+
+		DoSetControl(i, bWasNeverFull ? internal::kFlatHashCtrlEmpty : internal::kFlatHashCtrlDeleted);
+		mnGrowthLeft += bWasNeverFull ? 1 : 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoResetControl()
+	{
+		memset(mpControl, (uint8_t)internal::kFlatHashCtrlEmpty, mnCapacity + kGroupWidth);
+		mpControl[mnCapacity] = internal::kFlatHashCtrlSentinel;
+		mnGrowthLeft = CapacityToGrowth(mnCapacity) - mnElementCount;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoRehashAndGrowIfNecessary()
+	{
+		if(mnCapacity == 0)
+			DoResize(1);
+		else if(mnElementCount <= (CapacityToGrowth(mnCapacity) / 2))
+			DoResize(mnCapacity); // Mostly tombstones; rebuilding at the same size reclaims them.
+		else
+			DoResize((mnCapacity * 2) + 1);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoAllocate(size_type nCapacity)
+	{
+		EASTL_ASSERT((nCapacity & (nCapacity + 1)) == 0); // Must be a power of two minus one.
+
+		void* const pMemory = allocate_memory(mAllocator, DoAllocationSize(nCapacity),
+											  eastl::max_alt((size_t)EASTL_ALIGN_OF(value_type), (size_t)EASTL_ALIGN_OF(size_t)), 0);
+		EASTL_ASSERT_MSG(pMemory != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+
+		mpControl  = (ctrl_type*)pMemory;
+		mpSlots    = (value_type*)((char*)pMemory + DoSlotOffset(nCapacity));
+		mnCapacity = nCapacity;
+		DoResetControl();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoFree(ctrl_type* pControl, size_type nCapacity)
+	{
+		// A capacity of zero means pControl is the shared gFlatHashEmptyGroup.
+		if(nCapacity)
+			EASTLFree(mAllocator, pControl, DoAllocationSize(nCapacity));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoResize(size_type nNewCapacity)
+	{
+		ctrl_type* const  pOldControl  = mpControl;
+		value_type* const pOldSlots    = mpSlots;
+		const size_type   nOldCapacity = mnCapacity;
+
+		DoAllocate(nNewCapacity); // Uses mnElementCount, which is unchanged, to compute the growth left.
+		mnGrowthLeft += mnElementCount; // DoPrepareInsert-less placement below; account for the elements ourselves.
+
+		for(size_type i = 0; i < nOldCapacity; ++i)
+		{
+			if(internal::FlatHashIsFull(pOldControl[i]))
+			{
+				const size_t    h = DoHash(mExtractKey(pOldSlots[i]));
+				const size_type j = DoFindFirstNonFull(h);
+
+				DoSetControl(j, internal::FlatHashH2(h));
+				--mnGrowthLeft;
+				::new((void*)(mpSlots + j)) value_type(eastl::move(pOldSlots[i]));
+				pOldSlots[i].~value_type();
+			}
+		}
+
+		DoFree(pOldControl, nOldCapacity);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::DoDestroySlots()
+	{
+		if(!is_trivially_destructible<value_type>::value && mnElementCount)
+		{
+			for(size_type i = 0; i < mnCapacity; ++i)
+			{
+				if(internal::FlatHashIsFull(mpControl[i]))
+					mpSlots[i].~value_type();
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename VX>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoInsertValue(VX&& value)
+	{
+		const eastl::pair<size_type, bool> result = DoFindOrPrepareInsert(mExtractKey(value));
+
+		if(result.second)
+			DoConstructSlot(result.first, eastl::forward<VX>(value));
+
+		return insert_return_type(DoMakeIterator(result.first), result.second);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <class... Args>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::emplace(Args&&... args)
+	{
+		typedef integral_constant<bool, (sizeof...(Args) == 1) && conjunction<is_same<remove_cvref_t<Args>, value_type>...>::value> is_value_type;
+		return DoEmplace(is_value_type(), eastl::forward<Args>(args)...);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <class... Args>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoEmplace(false_type, Args&&... args)
+	{
+		// We need the key before we know where the element goes, so we construct
+		// the value on the stack and move it into place if the key is new.
+		typename eastl::aligned_storage<sizeof(value_type), EASTL_ALIGN_OF(value_type)>::type buffer;
+		value_type* const pValue = ::new((void*)&buffer) value_type(eastl::forward<Args>(args)...);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				const insert_return_type result = DoInsertValue(eastl::move(*pValue));
+				pValue->~value_type();
+				return result;
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				pValue->~value_type();
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <class... Args>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::emplace_hint(const_iterator, Args&&... args)
+	{
+		// We currently ignore the iterator argument as a hint.
+		return emplace(eastl::forward<Args>(args)...).first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(const value_type& value)
+	{
+		return DoInsertValue(value);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::insert_return_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(value_type&& otherValue)
+	{
+		return DoInsertValue(eastl::move(otherValue));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(const_iterator, const value_type& value)
+	{
+		// We currently ignore the iterator argument as a hint.
+		return DoInsertValue(value).first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(const_iterator, value_type&& value)
+	{
+		// We currently ignore the iterator argument as a hint.
+		return DoInsertValue(eastl::move(value)).first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(std::initializer_list<value_type> ilist)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename InputIterator>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::insert(InputIterator first, InputIterator last)
+	{
+		const size_type nElementAdd = (size_type)internal::FlatHashDistance(first, last, typename eastl::iterator_traits<InputIterator>::iterator_category());
+
+		if(nElementAdd > mnGrowthLeft)
+			reserve(mnElementCount + nElementAdd);
+
+		for(; first != last; ++first)
+			DoInsertValue(*first);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::erase(const_iterator i)
+	{
+		const size_type n = (size_type)(i.mpSlot - mpSlots);
+		EASTL_ASSERT_MSG((n < mnCapacity) && internal::FlatHashIsFull(mpControl[n]), "flat_hashtable::erase -- invalid iterator");
+
+		mpSlots[n].~value_type();
+		DoEraseMetaOnly(n);
+
+		iterator next(DoMakeIterator(n));
+		++next;
+		return next;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::erase(const_iterator first, const_iterator last)
+	{
+		// Erasure doesn't move elements, so 'last' stays valid throughout.
+		while(first != last)
+			first = erase(first);
+
+		return DoMakeIterator((size_type)(last.mpSlot - mpSlots));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename KX>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::size_type
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::DoErase(const KX& k)
+	{
+		const size_type i = DoFindIndex(k, DoHash(k));
+
+		if(i == kNotFound)
+			return 0;
+
+		mpSlots[i].~value_type();
+		DoEraseMetaOnly(i);
+		return 1;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename U, typename UHash, typename BinaryPredicate>
+	inline typename flat_hashtable<K, V, A, EK, Eq, H, bM>::iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::find_as(const U& other, UHash uhash, BinaryPredicate predicate)
+	{
+		const const_iterator it = static_cast<const this_type*>(this)->find_as(other, uhash, predicate);
+		return DoMakeIterator((size_type)(it.mpSlot - mpSlots));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	template <typename U, typename UHash, typename BinaryPredicate>
+	typename flat_hashtable<K, V, A, EK, Eq, H, bM>::const_iterator
+	flat_hashtable<K, V, A, EK, Eq, H, bM>::find_as(const U& other, UHash uhash, BinaryPredicate predicate) const
+	{
+		const size_t h = internal::FlatHashMix((size_t)uhash(other));
+		probe_seq seq = DoProbe(h);
+		const ctrl_type h2 = internal::FlatHashH2(h);
+
+		for(;;)
+		{
+			const group_type g(mpControl + seq.mnOffset);
+
+			for(typename group_type::bitmask_type m = g.Match(h2); m; m.ClearLowestBit())
+			{
+				const size_type i = seq.offset(m.LowestBitSet());
+
+				if(predicate(mExtractKey(mpSlots[i]), other))
+					return DoMakeIterator(i);
+			}
+
+			if(g.MatchEmpty())
+				return end();
+
+			seq.next();
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::clear()
+	{
+		// Like hashtable::clear, we keep our memory for reuse.
+		DoDestroySlots();
+		mnElementCount = 0;
+
+		if(mnCapacity)
+			DoResetControl();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::clear(bool clearBuckets)
+	{
+		DoDestroySlots();
+
+		if(clearBuckets)
+		{
+			DoFree(mpControl, mnCapacity);
+			reset_lose_memory();
+		}
+		else
+		{
+			mnElementCount = 0;
+
+			if(mnCapacity)
+				DoResetControl();
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::reset_lose_memory() EA_NOEXCEPT
+	{
+		mpControl      = gFlatHashEmptyGroup;
+		mpSlots        = NULL;
+		mnCapacity     = 0;
+		mnElementCount = 0;
+		mnGrowthLeft   = 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	void flat_hashtable<K, V, A, EK, Eq, H, bM>::rehash(size_type nBucketCount)
+	{
+		if((nBucketCount == 0) && (mnCapacity == 0))
+			return;
+
+		if((nBucketCount == 0) && (mnElementCount == 0))
+		{
+			DoFree(mpControl, mnCapacity);
+			reset_lose_memory();
+			return;
+		}
+
+		// Unlike hashtable, we round the requested count up to a valid capacity and
+		// never go below what the current elements need.
+		const size_type nNewCapacity = NormalizeCapacity(nBucketCount | GrowthToLowerBoundCapacity(mnElementCount));
+
+		if((nBucketCount == 0) || (nNewCapacity > mnCapacity))
+			DoResize(nNewCapacity);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void flat_hashtable<K, V, A, EK, Eq, H, bM>::reserve(size_type nElementCount)
+	{
+		if(nElementCount > (mnElementCount + mnGrowthLeft))
+			DoResize(NormalizeCapacity(GrowthToLowerBoundCapacity(nElementCount)));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	bool flat_hashtable<K, V, A, EK, Eq, H, bM>::validate() const
+	{
+		// Verify our empty group is unmodified.
+		if(gFlatHashEmptyGroup[0] != internal::kFlatHashCtrlSentinel)
+			return false;
+
+		for(size_type i = 1; i < EAArrayCount(gFlatHashEmptyGroup); ++i)
+		{
+			if(gFlatHashEmptyGroup[i] != internal::kFlatHashCtrlEmpty)
+				return false;
+		}
+
+		if(mnCapacity == 0)
+			return (mpControl == gFlatHashEmptyGroup) && (mnElementCount == 0) && (mnGrowthLeft == 0);
+
+		if(mnCapacity & (mnCapacity + 1)) // The capacity must be a power of two minus one.
+			return false;
+
+		if(mpControl[mnCapacity] != internal::kFlatHashCtrlSentinel)
+			return false;
+
+		// Verify that the cloned control bytes match their originals.
+		for(size_type i = 0; i < kGroupWidth - 1; ++i)
+		{
+			const ctrl_type c = (i < mnCapacity) ? mpControl[i] : internal::kFlatHashCtrlEmpty;
+
+			if(mpControl[mnCapacity + 1 + i] != c)
+				return false;
+		}
+
+		// Verify the element count, the growth left, and that every element can be found.
+		size_type nElementCount = 0;
+		size_type nDeletedCount = 0;
+
+		for(size_type i = 0; i < mnCapacity; ++i)
+		{
+			if(internal::FlatHashIsFull(mpControl[i]))
+			{
+				++nElementCount;
+
+				const size_t h = DoHash(mExtractKey(mpSlots[i]));
+
+				if(internal::FlatHashH2(h) != mpControl[i])
+					return false;
+
+				if(DoFindIndex(mExtractKey(mpSlots[i]), h) != i)
+					return false;
+			}
+			else if(mpControl[i] == internal::kFlatHashCtrlDeleted)
+				++nDeletedCount;
+			else if(mpControl[i] != internal::kFlatHashCtrlEmpty)
+				return false;
+		}
+
+		if(nElementCount != mnElementCount)
+			return false;
+
+		if((mnElementCount + nDeletedCount + mnGrowthLeft) != CapacityToGrowth(mnCapacity))
+			return false;
+
+		return true;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	int flat_hashtable<K, V, A, EK, Eq, H, bM>::validate_iterator(const_iterator i) const
+	{
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		if((i.mpControl >= mpControl) && (i.mpControl < (mpControl + mnCapacity)) &&
+		   ((i.mpControl - mpControl) == (i.mpSlot - mpSlots)) && internal::FlatHashIsFull(*i.mpControl))
+		{
+			return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	// operator==, != are implemented in the specific container subclasses (e.g. flat_hash_map).
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H, bool bM>
+	inline void swap(flat_hashtable<K, V, A, EK, Eq, H, bM>& a, flat_hashtable<K, V, A, EK, Eq, H, bM>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+EA_RESTORE_VC_WARNING();
+
+
+#endif // Header include guard
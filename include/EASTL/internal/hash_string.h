@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the string hash used by the eastl::hash specializations
+// for strings, string views and character pointers.
+//
+// The hash is a variant of the public domain wyhash. It reads the string 8
+// bytes at a time (48 bytes per step for long strings, in three independent
+// lanes), mixing with 64 x 64 -> 128 bit multiplies. For the short and medium
+// length strings that are common as hash table keys this is several times
+// faster than hashing a byte at a time, and the result is 64 bits wide.
+//
+// Strings of all character types hash equally if their code units are equal
+// and less than 256, as did the older FNV1 hash; e.g. hash(L"frost") ==
+// hash("frost"). This is done by reading each code unit of such a wide string
+// as a byte. It is relied on by the transparent string hash function objects
+// in string.h. Wide strings with larger code units hash all the bytes of their
+// code units instead, with a different seed, so that no two wide strings of
+// a character type hash equally by construction.
+//
+// The values are not stable across EASTL versions or across platforms of
+// differing endianness, and must not be persisted. EASTL_STRING_HASH_FNV1
+// restores the older FNV1 hash for users who need its values.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_HASH_STRING_H
+#define EASTL_INTERNAL_HASH_STRING_H
+
+#include <EASTL/internal/config.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <EASTL/type_traits.h>
+#include <string.h>
+
+#if defined(EA_COMPILER_MSVC) && (defined(_M_X64) || defined(_M_ARM64)) && !defined(__clang__)
+	EA_DISABLE_ALL_VC_WARNINGS()
+	#include <intrin.h>
+	EA_RESTORE_ALL_VC_WARNINGS()
+#endif
+
+
+namespace eastl
+{
+	namespace internal
+	{
+		const uint64_t kHashStringSecret[4] =
+		{
+			UINT64_C(0x2d358dccaa6c78a5), UINT64_C(0x8bb84b93962eacc9),
+			UINT64_C(0x4b33a62ed433d4a3), UINT64_C(0x4d5a2da51de1aa47)
+		};
+
+		// Sets a and b to the low and high halves of the 128 bit product a * b.
+		EA_FORCE_INLINE void HashStringMultiply(uint64_t& a, uint64_t& b)
+		{
+			#if (EA_COMPILER_INTMAX_SIZE >= 16) && (defined(EA_COMPILER_GNUC) || defined(__clang__))
+				const __uint128_t r = (__uint128_t)a * b;
+				a = (uint64_t)r;
+				b = (uint64_t)(r >> 64);
+			#elif defined(EA_COMPILER_MSVC) && defined(_M_X64) && !defined(__clang__)
+				a = _umul128(a, b, &b);
+			#elif defined(EA_COMPILER_MSVC) && defined(_M_ARM64) && !defined(__clang__)
+				const uint64_t lo = a * b;
+				b = __umulh(a, b);
+				a = lo;
+			#else
+				const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+				const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+				const uint64_t t  = rl + (rm0 << 32);
+				uint64_t       c  = (t < rl) ? 1 : 0;
+				const uint64_t lo = t + (rm1 << 32);
+				c += (lo < t) ? 1 : 0;
+				b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+				a = lo;
+			#endif
+		}
+
+		EA_FORCE_INLINE uint64_t HashStringMix(uint64_t a, uint64_t b)
+		{
+			HashStringMultiply(a, b);
+			return a ^ b;
+		}
+
+		// Reads bytes of a string of 1 byte characters.
+		struct hash_string_byte_reader
+		{
+			const uint8_t* mp;
+
+			uint64_t Read8(size_t i) const { uint64_t v; memcpy(&v, mp + i, sizeof(v)); return v; }
+			uint64_t Read4(size_t i) const { uint32_t v; memcpy(&v, mp + i, sizeof(v)); return v; }
+			uint64_t Read1(size_t i) const { return mp[i]; }
+		};
+
+		// Reads the code units of a string of wide characters which are all less than 256, each as a byte.
+		// The reads compose the bytes in memory order, as the reads of hash_string_byte_reader do.
+		template <typename T>
+		struct hash_string_wide_reader
+		{
+			const T* mp;
+
+			static uint64_t Narrow(T c) { return (uint8_t)c; }
+
+			#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+				// Narrows four 2 byte code units at once.
+				static uint64_t Narrow4(const T* p, integral_constant<size_t, 2>)
+				{
+					uint64_t x;
+					memcpy(&x, p, sizeof(x));
+					x = (x | (x >> 8)) & UINT64_C(0x0000FFFF0000FFFF);
+					return (x | (x >> 16)) & UINT64_C(0xFFFFFFFF);
+				}
+
+				// Narrows four 4 byte code units at once, two per 64 bit word.
+				static uint64_t Narrow4(const T* p, integral_constant<size_t, 4>)
+				{
+					uint64_t x[2];
+					memcpy(x, p, sizeof(x));
+					for(int k = 0; k < 2; k++)
+						x[k] = (x[k] & 0xFF) | ((x[k] >> 24) & 0xFF00);
+					return x[0] | (x[1] << 16);
+				}
+
+				uint64_t Read4(size_t i) const { return Narrow4(mp + i, integral_constant<size_t, sizeof(T)>()); }
+			#else
+				uint64_t Read4(size_t i) const
+				{
+					return (Narrow(mp[i]) << 24) | (Narrow(mp[i + 1]) << 16) | (Narrow(mp[i + 2]) << 8) | Narrow(mp[i + 3]);
+				}
+			#endif
+
+			uint64_t Read8(size_t i) const
+			{
+				#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+					return Read4(i) | (Read4(i + 4) << 32);
+				#else
+					return (Read4(i) << 32) | Read4(i + 4);
+				#endif
+			}
+
+			uint64_t Read1(size_t i) const { return Narrow(mp[i]); }
+		};
+
+
+		/// HashStringUnits
+		///
+		/// Returns a 64 bit hash of the nSize bytes given by reader.
+		///
+		template <typename Reader>
+		inline uint64_t HashStringUnits(const Reader& reader, size_t nSize, uint64_t nSeed = kHashStringSecret[0])
+		{
+			size_t   p    = 0;
+			uint64_t seed = HashStringMix(nSeed, kHashStringSecret[1]);
+			uint64_t a, b;
+
+			if(EASTL_LIKELY(nSize <= 16))
+			{
+				if(nSize >= 4)
+				{
+					const size_t nOffset = (nSize >> 3) << 2; // 0 for [4, 8), 4 for [8, 16]. The reads overlap as needed.
+					a = (reader.Read4(0) << 32) | reader.Read4(nOffset);
+					b = (reader.Read4(nSize - 4) << 32) | reader.Read4(nSize - 4 - nOffset);
+				}
+				else if(nSize > 0)
+				{
+					a = (reader.Read1(0) << 16) | (reader.Read1(nSize >> 1) << 8) | reader.Read1(nSize - 1);
+					b = 0;
+				}
+				else
+					a = b = 0;
+			}
+			else
+			{
+				size_t i = nSize;
+
+				if(i > 48)
+				{
+					uint64_t seed1 = seed, seed2 = seed;
+
+					do {
+						seed  = HashStringMix(reader.Read8(p)      ^ kHashStringSecret[1], reader.Read8(p + 8)  ^ seed);
+						seed1 = HashStringMix(reader.Read8(p + 16) ^ kHashStringSecret[2], reader.Read8(p + 24) ^ seed1);
+						seed2 = HashStringMix(reader.Read8(p + 32) ^ kHashStringSecret[3], reader.Read8(p + 40) ^ seed2);
+						p += 48;
+						i -= 48;
+					} while(i > 48);
+
+					seed ^= seed1 ^ seed2;
+				}
+
+				while(i > 16)
+				{
+					seed = HashStringMix(reader.Read8(p) ^ kHashStringSecret[1], reader.Read8(p + 8) ^ seed);
+					p += 16;
+					i -= 16;
+				}
+
+				// The last 16 bytes of the string, which may overlap bytes already mixed in.
+				a = reader.Read8(p + i - 16);
+				b = reader.Read8(p + i - 8);
+			}
+
+			a ^= kHashStringSecret[1];
+			b ^= seed;
+			HashStringMultiply(a, b);
+			return HashStringMix(a ^ kHashStringSecret[0] ^ nSize, b ^ kHashStringSecret[1]);
+		}
+
+
+		/// HashBytes
+		///
+		/// Returns a 64 bit hash of the nSize bytes at pData.
+		///
+		inline uint64_t HashBytes(const void* pData, size_t nSize)
+		{
+			const hash_string_byte_reader reader = { (const uint8_t*)pData };
+			return HashStringUnits(reader, nSize);
+		}
+
+
+		template <typename T>
+		inline uint64_t HashStringImpl(const T* p, size_t nLength, true_type) // 1 byte characters
+			{ return HashBytes(p, nLength); }
+
+		template <typename T>
+		inline uint64_t HashStringImpl(const T* p, size_t nLength, false_type)
+		{
+			typedef conditional_t<sizeof(T) == 2, uint16_t, uint32_t> unsigned_char_type;
+
+			uint32_t nUnits = 0; // A branchless loop, which the compiler can vectorize.
+			for(size_t i = 0; i < nLength; i++)
+				nUnits |= (uint32_t)(unsigned_char_type)p[i];
+
+			if(EASTL_LIKELY(nUnits < 256))
+			{
+				const hash_string_wide_reader<T> reader = { p };
+				return HashStringUnits(reader, nLength);
+			}
+
+			const hash_string_byte_reader reader = { (const uint8_t*)p };
+			return HashStringUnits(reader, nLength * sizeof(T), kHashStringSecret[2]);
+		}
+
+
+		/// hash_string
+		///
+		/// Returns the hash of the nLength characters at p. This is what the string,
+		/// string_view and character pointer hash specializations are defined as.
+		///
+		template <typename T>
+		inline size_t hash_string(const T* p, size_t nLength)
+		{
+			#if EASTL_STRING_HASH_FNV1
+				typedef conditional_t<sizeof(T) == 1, uint8_t, conditional_t<sizeof(T) == 2, uint16_t, uint32_t>> unsigned_char_type;
+
+				uint32_t result = 2166136261U; // FNV1 hash. Intentionally uint32_t instead of size_t, so the behavior is the same regardless of size.
+				for(const T* const pEnd = p + nLength; p != pEnd; ++p)
+					result = (result * 16777619) ^ (uint32_t)(unsigned_char_type)*p;
+				return (size_t)result;
+			#else
+				return (size_t)HashStringImpl(p, nLength, bool_constant<sizeof(T) == 1>());
+			#endif
+		}
+
+		/// hash_string
+		///
+		/// Returns the hash of the 0-terminated string p. It's equal to the hash of
+		/// the same characters given with an explicit length.
+		///
+		template <typename T>
+		inline size_t hash_string(const T* p)
+		{
+			const T* pEnd = p;
+			while(*pEnd)
+				++pEnd;
+			return hash_string(p, (size_t)(pEnd - p));
+		}
+
+		inline size_t hash_string(const char* p)
+			{ return hash_string(p, strlen(p)); }
+
+	} // namespace internal
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -42,6 +42,7 @@
 #include <EASTL/initializer_list.h>
 #include <EASTL/tuple.h>
 #include <EASTL/memory.h>
+#include <EASTL/bit.h>
 #include <string.h>
 #if EASTL_EXCEPTIONS_ENABLED
 #include <stdexcept>
@@ -76,6 +77,28 @@ namespace eastl
 		#define EASTL_HASHTABLE_DEFAULT_ALLOCATOR allocator_type(EASTL_HASHTABLE_DEFAULT_NAME)
 	#endif
 
+
+	/// EASTL_HASHTABLE_INCREMENTAL_REHASH_STEP
+	///
+	/// Defines the default number of buckets that each insertion migrates
+	/// while an incremental_rehash_policy hashtable is growing.
+	///
+	#ifndef EASTL_HASHTABLE_INCREMENTAL_REHASH_STEP
+		#define EASTL_HASHTABLE_INCREMENTAL_REHASH_STEP 8
+	#endif
+
+
+	/// EASTL_HASHTABLE_BATCH_SIZE
+	///
+	/// Defines how many keys find_batch, contains_batch and insert_batch
+	/// have in flight at once. Each key of a group has its bucket and then
+	/// its first node prefetched before any of the group's chains is searched.
+	/// Larger groups hide more memory latency but use more stack space.
+	///
+	#ifndef EASTL_HASHTABLE_BATCH_SIZE
+		#define EASTL_HASHTABLE_BATCH_SIZE 16
+	#endif
+
 	
 	/// kHashtableAllocFlagBuckets
 	/// Flag to allocator which indicates that we are allocating buckets and not nodes.
@@ -91,6 +114,78 @@ namespace eastl
 	extern EASTL_API void* gpEmptyBucketArray[2];
 
 
+	/// hashed_key
+	///
+	/// A reference to a key together with its hash code. The hash-based containers
+	/// accept a hashed_key in find, contains, count, equal_range, erase, insert and
+	/// try_emplace and use its hash code instead of hashing the key again. This lets
+	/// one hash computation be shared by lookups in several containers, such as a
+	/// hash_map and a hash_set with the same key type.
+	///
+	/// The hash code must be the one that the container's hash function would compute
+	/// for the key. This is checked when EASTL_ASSERT_ENABLED is set. For containers
+	/// with transparent hash and equality function objects, the key can be of a
+	/// different type than the container's key_type, e.g. a string_view for a
+	/// hash_map<string, T>. A hashed_key refers to its key and must not outlive it.
+	///
+	/// Example usage:
+	///     hash_map<string, int> hashMap;
+	///     hash_set<string>      hashSet;
+	///
+	///     const hashed_key<string> hk = make_hashed_key(name, hashMap.hash_function());
+	///     if(hashSet.contains(hk))
+	///         hashMap.erase(hk);
+	///
+	template <typename Key>
+	class hashed_key
+	{
+	public:
+		typedef Key key_type;
+
+		hashed_key(const key_type& key, size_t hashCode) EA_NOEXCEPT
+			: mpKey(&key), mnHashCode(hashCode) { }
+
+		const key_type& key()       const EA_NOEXCEPT { return *mpKey; }
+		size_t          hash_code() const EA_NOEXCEPT { return mnHashCode; }
+
+	protected:
+		const key_type* mpKey;
+		size_t          mnHashCode;
+	};
+
+
+	/// make_hashed_key
+	///
+	/// Returns a hashed_key for key, using hashFunction to compute its hash code.
+	/// hashFunction would usually be the hash_function() of the containers that
+	/// the hashed_key will be used with.
+	///
+	template <typename Key, typename Hash>
+	inline hashed_key<Key> make_hashed_key(const Key& key, const Hash& hashFunction)
+	{
+		return hashed_key<Key>(key, (size_t)hashFunction(key));
+	}
+
+	template <typename Key>
+	inline hashed_key<Key> make_hashed_key(const Key& key)
+	{
+		return hashed_key<Key>(key, (size_t)eastl::hash<Key>()(key));
+	}
+
+
+	namespace internal
+	{
+		template <typename T>
+		struct is_hashed_key : public eastl::false_type { };
+
+		template <typename Key>
+		struct is_hashed_key<hashed_key<Key>> : public eastl::true_type { };
+
+		template <typename T>
+		EA_CONSTEXPR bool is_hashed_key_v = is_hashed_key<eastl::remove_cvref_t<T>>::value;
+	}
+
+
 	/// EASTL_MACRO_SWAP
 	///
 	/// Use EASTL_MACRO_SWAP because GCC (at least v4.6-4.8) has a bug where it fails to compile eastl::swap(mpBucketArray, x.mpBucketArray).
@@ -122,8 +217,8 @@ namespace eastl
 			hash_node(hash_node&&) = default;
 
 			Value        mValue;
+			uint32_t     mnHashCode;      // Placed before mpNext so that it goes in the padding after mValue, if there is any.
 			hash_node*   mpNext;
-			eastl_size_t mnHashCode;      // See config.h for the definition of eastl_size_t, which defaults to size_t.
 		} EASTL_MAY_ALIAS;
 
 		template <typename Value>
@@ -143,6 +238,25 @@ namespace eastl
 	EA_RESTORE_VC_WARNING()
 
 
+	/// hash_code_caching_default
+	///
+	/// The default of the bCacheHashCode template parameter of the hash containers.
+	/// It is true for keys of class type, such as strings and most user types, whose
+	/// equality comparison is expensive next to the compare of the hash codes which
+	/// a cached node is checked with first. Walking a bucket's chain on a lookup then
+	/// calls the key predicate only for nodes whose hash code matches, and rehashing
+	/// doesn't call the hash function. It is false for scalar keys, whose comparison
+	/// is as cheap as that of the hash codes.
+	///
+	/// A cached hash code takes no memory if it fits in the padding after the value
+	/// in the node, e.g. for hash_set<int> on 64 bit platforms, and otherwise takes 8
+	/// bytes on 64 bit platforms. Specialize this for a key type to change its default.
+	///
+	template <typename Key>
+	struct hash_code_caching_default : public integral_constant<bool, !is_scalar<Key>::value> {};
+
+
+
 	// has_hashcode_member
 	//
 	// Custom type-trait that checks for the existence of a class data member 'mnHashCode'.  
@@ -405,6 +519,30 @@ namespace eastl
 	};
 
 
+	/// fibonacci_range_hashing
+	///
+	/// Implements the conversion of a number in the range of [0, SIZE_T_MAX]
+	/// to the range of [0, BucketCount) for power of two bucket counts by
+	/// multiplying by 2^64 / phi and keeping the top log2(BucketCount) bits.
+	/// This replaces the integer division of mod_range_hashing with a multiply
+	/// and a shift, and the multiply mixes the low bits of poor hash functions
+	/// (e.g. the identity hash of integers) into the bits that are kept.
+	///
+	/// If the bucket count is not a power of two, only the buckets below the
+	/// largest power of two no greater than it are used.
+	///
+	struct fibonacci_range_hashing
+	{
+		uint32_t operator()(size_t r, uint32_t n) const
+		{
+			const uint64_t h     = (uint64_t)r * UINT64_C(0x9E3779B97F4A7C15);
+			const int      nBits = 31 - eastl::countl_zero(n); // log2(n); n is never zero.
+
+			return (uint32_t)((h >> 32) >> (32 - nBits)); // Two shifts so that n == 1 doesn't shift by 64.
+		}
+	};
+
+
 	/// default_ranged_hash
 	///
 	/// Default ranged hash function H. In principle it should be a
@@ -426,17 +564,90 @@ namespace eastl
 	struct EASTL_API prime_rehash_policy
 	{
 	public:
+		typedef mod_range_hashing range_hash_type; // The range-hashing function that matches the bucket counts of this policy.
+
 		float            mfMaxLoadFactor;
+		float            mfMinLoadFactor;  // 0 unless erasing elements should shrink the bucket array. See GetShrinkRequired.
 		float            mfGrowthFactor;
 		mutable uint32_t mnNextResize;
 
 	public:
-		prime_rehash_policy(float fMaxLoadFactor = 1.f)
-			: mfMaxLoadFactor(fMaxLoadFactor), mfGrowthFactor(2.f), mnNextResize(0) { }
+		prime_rehash_policy(float fMaxLoadFactor = 1.f, float fMinLoadFactor = 0.f)
+			: mfMaxLoadFactor(fMaxLoadFactor), mfMinLoadFactor(fMinLoadFactor), mfGrowthFactor(2.f), mnNextResize(0) { }
 
 		float GetMaxLoadFactor() const
 			{ return mfMaxLoadFactor; }
 
+		float GetMinLoadFactor() const
+			{ return mfMinLoadFactor; }
+
+		/// Return a bucket count no greater than nBucketCountHint, 
+		/// Don't update member variables while at it.
+		static uint32_t GetPrevBucketCountOnly(uint32_t nBucketCountHint);
+
+		/// Return a bucket count no greater than nBucketCountHint.
+		/// This function has a side effect of updating mnNextResize.
+		uint32_t GetPrevBucketCount(uint32_t nBucketCountHint) const;
+
+		/// Return a bucket count no smaller than nBucketCountHint.
+		/// This function has a side effect of updating mnNextResize.
+		uint32_t GetNextBucketCount(uint32_t nBucketCountHint) const;
+
+		/// Return a bucket count appropriate for nElementCount elements.
+		/// This function has a side effect of updating mnNextResize.
+		uint32_t GetBucketCount(uint32_t nElementCount) const;
+
+		/// nBucketCount is current bucket count, nElementCount is current element count,
+		/// and nElementAdd is number of elements to be inserted. Do we need 
+		/// to increase bucket count? If so, return pair(true, n), where 
+		/// n is the new bucket count. If not, return pair(false, 0).
+		eastl::pair<bool, uint32_t>
+		GetRehashRequired(uint32_t nBucketCount, uint32_t nElementCount, uint32_t nElementAdd) const;
+
+		/// nBucketCount is current bucket count and nElementCount is the element count
+		/// after erasing elements. Do we need to decrease the bucket count because the
+		/// load factor fell below mfMinLoadFactor? If so, return pair(true, n), where
+		/// n is the new bucket count. If not, return pair(false, 0).
+		/// This function has a side effect of updating mnNextResize.
+		eastl::pair<bool, uint32_t>
+		GetShrinkRequired(uint32_t nBucketCount, uint32_t nElementCount) const;
+	};
+
+
+
+
+
+	/// power_of_two_rehash_policy
+	///
+	/// Alternative rehash policy whose bucket counts are powers of two, for
+	/// use with fibonacci_range_hashing. Mapping a hash code to a bucket is then
+	/// a multiply and a shift instead of a division by a prime, which is a
+	/// significant part of the cost of finding small keys. The interface is
+	/// the same as prime_rehash_policy.
+	///
+	/// Example usage:
+	///     hash_map<int, int, hash<int>, equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy> hashMap;
+	///
+	struct EASTL_API power_of_two_rehash_policy
+	{
+	public:
+		typedef fibonacci_range_hashing range_hash_type; // The range-hashing function that matches the bucket counts of this policy.
+
+		float            mfMaxLoadFactor;
+		float            mfMinLoadFactor;  // 0 unless erasing elements should shrink the bucket array. See GetShrinkRequired.
+		float            mfGrowthFactor;
+		mutable uint32_t mnNextResize;
+
+	public:
+		power_of_two_rehash_policy(float fMaxLoadFactor = 1.f, float fMinLoadFactor = 0.f)
+			: mfMaxLoadFactor(fMaxLoadFactor), mfMinLoadFactor(fMinLoadFactor), mfGrowthFactor(2.f), mnNextResize(0) { }
+
+		float GetMaxLoadFactor() const
+			{ return mfMaxLoadFactor; }
+
+		float GetMinLoadFactor() const
+			{ return mfMinLoadFactor; }
+
 		/// Return a bucket count no greater than nBucketCountHint, 
 		/// Don't update member variables while at it.
 		static uint32_t GetPrevBucketCountOnly(uint32_t nBucketCountHint);
@@ -459,12 +670,192 @@ namespace eastl
 		/// n is the new bucket count. If not, return pair(false, 0).
 		eastl::pair<bool, uint32_t>
 		GetRehashRequired(uint32_t nBucketCount, uint32_t nElementCount, uint32_t nElementAdd) const;
+
+		/// nBucketCount is current bucket count and nElementCount is the element count
+		/// after erasing elements. Do we need to decrease the bucket count because the
+		/// load factor fell below mfMinLoadFactor? If so, return pair(true, n), where
+		/// n is the new bucket count. If not, return pair(false, 0).
+		/// This function has a side effect of updating mnNextResize.
+		eastl::pair<bool, uint32_t>
+		GetShrinkRequired(uint32_t nBucketCount, uint32_t nElementCount) const;
 	};
 
 
 
 
 
+	/// hashtable_stats
+	///
+	/// Statistics about the distribution of a hashtable's nodes in its buckets,
+	/// returned by get_stats. A long max chain or a high collision rate at a
+	/// normal load factor points at a poor hash function. The rehash counters
+	/// are only maintained if EASTL_HASHTABLE_STATS_ENABLED is enabled, and are
+	/// zero otherwise.
+	///
+	/// Example usage:
+	///     hash_map<Key, Value, KeyHash> hashMap;
+	///     ...
+	///     hashtable_stats stats = hashMap.get_stats();
+	///     if(stats.mnMaxChainLength > 8)
+	///         printf("%u of %u buckets are empty\n", (unsigned)stats.mnEmptyBucketCount, (unsigned)stats.mnBucketCount);
+	///
+	struct hashtable_stats
+	{
+		static const size_t kChainLengthHistogramSize = 8;
+
+		size_t mnElementCount;
+		size_t mnBucketCount;
+		size_t mnEmptyBucketCount;
+		size_t mnMaxChainLength;
+		size_t mChainLengthHistogram[kChainLengthHistogramSize]; // The number of buckets with each chain length. The last entry counts all longer chains too.
+		float  mfLoadFactor;
+		float  mfEmptyBucketRatio;                               // mnEmptyBucketCount / mnBucketCount.
+		float  mfCollisionRate;                                  // The fraction of nodes which aren't alone in their bucket and aren't the first in it.
+		size_t mnRehashCount;                                    // The number of times the bucket array was replaced.
+		size_t mnRehashNodeCount;                                // The number of nodes those rehashes moved to a new bucket.
+
+		hashtable_stats()
+			: mnElementCount(0), mnBucketCount(0), mnEmptyBucketCount(0), mnMaxChainLength(0), mChainLengthHistogram(),
+			  mfLoadFactor(0.f), mfEmptyBucketRatio(0.f), mfCollisionRate(0.f), mnRehashCount(0), mnRehashNodeCount(0) { }
+	};
+
+
+	namespace internal
+	{
+		// Fills in the bucket statistics of stats from a bucket array of nodes linked by their mpNext,
+		// which is a Link* (Link being a base class of Node in the case of intrusive_hashtable).
+		template <typename Link, typename Node>
+		void GetBucketStats(hashtable_stats& stats, const Node* const* pBucketArray, size_t nBucketCount)
+		{
+			stats.mnBucketCount = nBucketCount;
+
+			for(size_t i = 0; i < nBucketCount; ++i)
+			{
+				size_t nChainLength = 0;
+
+				for(const Link* pNode = pBucketArray[i]; pNode; pNode = pNode->mpNext)
+					++nChainLength;
+
+				stats.mnElementCount += nChainLength;
+				stats.mChainLengthHistogram[eastl::min_alt(nChainLength, hashtable_stats::kChainLengthHistogramSize - 1)]++;
+
+				if(nChainLength > stats.mnMaxChainLength)
+					stats.mnMaxChainLength = nChainLength;
+			}
+
+			stats.mnEmptyBucketCount = stats.mChainLengthHistogram[0];
+
+			if(nBucketCount)
+			{
+				stats.mfLoadFactor       = (float)stats.mnElementCount / (float)nBucketCount;
+				stats.mfEmptyBucketRatio = (float)stats.mnEmptyBucketCount / (float)nBucketCount;
+			}
+
+			if(stats.mnElementCount)
+				stats.mfCollisionRate = (float)(stats.mnElementCount - (nBucketCount - stats.mnEmptyBucketCount)) / (float)stats.mnElementCount;
+		}
+
+
+		// The rehash counters kept by a hashtable if EASTL_HASHTABLE_STATS_ENABLED is enabled.
+		struct hashtable_rehash_counters
+		{
+			size_t mnRehashCount;
+			size_t mnRehashNodeCount;
+
+			hashtable_rehash_counters()
+				: mnRehashCount(0), mnRehashNodeCount(0) { }
+		};
+	}
+
+
+	/// incremental_rehash_state
+	///
+	/// The state of an incremental rehash. See incremental_rehash_policy.
+	///
+	struct incremental_rehash_state
+	{
+		uint32_t mnRehashStep;         // The number of buckets migrated by each insertion.
+		uint32_t mnRehashBucketCount;  // The bucket count being migrated from, or 0 if no rehash is in progress.
+		uint32_t mnRehashIndex;        // The next of those buckets to migrate.
+
+		incremental_rehash_state(uint32_t nRehashStep)
+			: mnRehashStep(nRehashStep), mnRehashBucketCount(0), mnRehashIndex(0) { }
+	};
+
+
+	/// incremental_rehash_policy
+	///
+	/// Rehash policy adaptor which spreads the cost of growing a hashtable over
+	/// the insertions that follow. With the other policies, the insertion which
+	/// takes the hashtable over its max load factor moves every node to a new
+	/// bucket array, which for large hashtables is a latency spike. With this
+	/// policy that insertion only allocates the new bucket array, which starts
+	/// out holding the old buckets, and every insertion then migrates the nodes
+	/// of the next mnRehashStep old buckets to their new buckets. Until a node
+	/// is migrated, lookups find it in its old bucket. The rehash can also be
+	/// advanced explicitly with rehash_step, e.g. during idle time.
+	///
+	/// While a rehash is in progress insertions move nodes between buckets, and
+	/// so invalidate iterators as if they had grown the hashtable. Lookups and
+	/// erasures never move nodes. find_range_by_hash returns only one of the two
+	/// buckets the nodes of the hash may be in.
+	///
+	/// The bucket counts are those of RehashPolicy, which is prime_rehash_policy
+	/// or power_of_two_rehash_policy. Shrinking the bucket array (see
+	/// GetShrinkRequired) always rehashes all nodes at once.
+	///
+	/// Example usage:
+	///     typedef hash_map<int, int, hash<int>, equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>> IntMap;
+	///     IntMap intMap;
+	///     ...
+	///     intMap.rehash_step(1024); // Once per frame.
+	///
+	template <typename RehashPolicy = prime_rehash_policy>
+	struct incremental_rehash_policy : public RehashPolicy, public incremental_rehash_state
+	{
+	public:
+		typedef RehashPolicy base_policy_type;
+
+	public:
+		incremental_rehash_policy(float fMaxLoadFactor = 1.f, uint32_t nRehashStep = EASTL_HASHTABLE_INCREMENTAL_REHASH_STEP, float fMinLoadFactor = 0.f)
+			: RehashPolicy(fMaxLoadFactor, fMinLoadFactor), incremental_rehash_state(nRehashStep) { }
+	};
+
+
+	namespace internal
+	{
+		// Returns the incremental_rehash_state of the rehash policy, or NULL if it isn't an incremental_rehash_policy.
+		template <typename RehashPolicy>
+		inline incremental_rehash_state* GetIncrementalRehashState(RehashPolicy&)
+			{ return NULL; }
+
+		template <typename RehashPolicy>
+		inline incremental_rehash_state* GetIncrementalRehashState(incremental_rehash_policy<RehashPolicy>& policy)
+			{ return &policy; }
+
+		template <typename RehashPolicy>
+		inline const incremental_rehash_state* GetIncrementalRehashState(const RehashPolicy&)
+			{ return NULL; }
+
+		template <typename RehashPolicy>
+		inline const incremental_rehash_state* GetIncrementalRehashState(const incremental_rehash_policy<RehashPolicy>& policy)
+			{ return &policy; }
+
+		// Returns RehashPolicy::GetShrinkRequired, or pair(false, 0) for user-defined rehash policies which don't implement it.
+		template <typename RehashPolicy>
+		inline auto GetShrinkRequired(const RehashPolicy& policy, uint32_t nBucketCount, uint32_t nElementCount, int)
+			-> decltype(policy.GetShrinkRequired(nBucketCount, nElementCount))
+			{ return policy.GetShrinkRequired(nBucketCount, nElementCount); }
+
+		template <typename RehashPolicy>
+		inline eastl::pair<bool, uint32_t> GetShrinkRequired(const RehashPolicy&, uint32_t, uint32_t, long)
+			{ return eastl::pair<bool, uint32_t>(false, (uint32_t)0); }
+	}
+
+
+
+
+
 	///////////////////////////////////////////////////////////////////////
 	// Base classes for hashtable. We define these base classes because 
 	// in some cases we want to do different things depending on the 
@@ -480,13 +871,15 @@ namespace eastl
 	/// rehash_base
 	///
 	/// Give hashtable the get_max_load_factor functions if the rehash 
-	/// policy is prime_rehash_policy.
+	/// policy is prime_rehash_policy, power_of_two_rehash_policy or
+	/// incremental_rehash_policy, and the rehash_step functions if it is
+	/// incremental_rehash_policy.
 	///
 	template <typename RehashPolicy, typename Hashtable>
 	struct rehash_base { };
 
-	template <typename Hashtable>
-	struct rehash_base<prime_rehash_policy, Hashtable>
+	template <typename RehashPolicy, typename Hashtable>
+	struct rehash_base_load_factor
 	{
 		// Returns the max load factor, which is the load factor beyond
 		// which we rebuild the container with a new bucket count.
@@ -501,7 +894,56 @@ namespace eastl
 		void set_max_load_factor(float fMaxLoadFactor)
 		{
 			Hashtable* const pThis = static_cast<Hashtable*>(this);
-			pThis->rehash_policy(prime_rehash_policy(fMaxLoadFactor));    
+			RehashPolicy rehashPolicy(pThis->rehash_policy());
+			rehashPolicy.mfMaxLoadFactor = fMaxLoadFactor;
+			pThis->rehash_policy(rehashPolicy);
+		}
+
+		// Returns the min load factor, which is the load factor below which
+		// erasing elements by key rebuilds the container with a smaller bucket count.
+		float get_min_load_factor() const
+		{
+			const Hashtable* const pThis = static_cast<const Hashtable*>(this);
+			return pThis->rehash_policy().GetMinLoadFactor();
+		}
+
+		// A min load factor of 0 (the default) disables shrinking. To avoid
+		// alternately shrinking and growing, it should be well below half of
+		// the max load factor; a quarter of it (e.g. 0.25f) is a good choice.
+		void set_min_load_factor(float fMinLoadFactor)
+		{
+			Hashtable* const pThis = static_cast<Hashtable*>(this);
+			RehashPolicy rehashPolicy(pThis->rehash_policy());
+			rehashPolicy.mfMinLoadFactor = fMinLoadFactor;
+			pThis->rehash_policy(rehashPolicy);
+		}
+	};
+
+	template <typename Hashtable>
+	struct rehash_base<prime_rehash_policy, Hashtable>
+		: public rehash_base_load_factor<prime_rehash_policy, Hashtable> { };
+
+	template <typename Hashtable>
+	struct rehash_base<power_of_two_rehash_policy, Hashtable>
+		: public rehash_base_load_factor<power_of_two_rehash_policy, Hashtable> { };
+
+	template <typename RehashPolicy, typename Hashtable>
+	struct rehash_base<incremental_rehash_policy<RehashPolicy>, Hashtable>
+		: public rehash_base_load_factor<incremental_rehash_policy<RehashPolicy>, Hashtable>
+	{
+		// Migrates up to nBucketCount buckets of a rehash in progress. Returns true
+		// if the rehash is still in progress. rehash_step(bucket_count()) finishes it.
+		bool rehash_step(eastl_size_t nBucketCount)
+		{
+			Hashtable* const pThis = static_cast<Hashtable*>(this);
+			return pThis->DoRehashStep(nBucketCount);
+		}
+
+		// Returns true if some buckets haven't been migrated to the current bucket count yet.
+		bool rehash_in_progress() const
+		{
+			const Hashtable* const pThis = static_cast<const Hashtable*>(this);
+			return pThis->rehash_policy().mnRehashBucketCount != 0;
 		}
 	};
 
@@ -582,6 +1024,9 @@ namespace eastl
 		bool compare(const KeyX& key, hash_code_t, hash_node<Value, false>* pNode) const
 			{ return mEqual(key, mExtractKey(pNode->mValue)); }
 
+		bool compare_code(hash_code_t, const hash_node<Value, false>*) const
+			{ return true; }
+
 		void copy_code(hash_node<Value, false>*, const hash_node<Value, false>*) const
 			{ } // Nothing to do.
 
@@ -672,6 +1117,9 @@ namespace eastl
 		bool compare(const KeyX& key, hash_code_t, node_type* pNode) const
 			{ return mEqual(key, mExtractKey(pNode->mValue)); }
 
+		bool compare_code(hash_code_t, const node_type*) const
+			{ return true; }
+
 		void copy_code(node_type*, const node_type*) const
 			{ } // Nothing to do.
 
@@ -743,6 +1191,9 @@ namespace eastl
 		bool compare(const KeyX& key, hash_code_t c, node_type* pNode) const
 			{ return (pNode->mnHashCode == c) && mEqual(key, mExtractKey(pNode->mValue)); }
 
+		bool compare_code(hash_code_t c, const node_type* pNode) const
+			{ return pNode->mnHashCode == c; }
+
 		void copy_code(node_type* pDest, const node_type* pSource) const
 			{ pDest->mnHashCode = pSource->mnHashCode; }
 
@@ -776,6 +1227,10 @@ namespace eastl
 	template<typename EqX, typename H1X, typename HX>
 	EA_CONSTEXPR bool is_transparent_key_available_v = is_transparent_key_available<EqX, H1X, HX>::value;
 
+	// A hashed_key<KX> can be used for lookups if KX is the key type, or if the lookup can be heterogeneous.
+	template<typename KX, typename Key, typename EqX, typename H1X, typename HX>
+	EA_CONSTEXPR bool is_hashed_key_lookup_available_v = eastl::is_same_v<eastl::remove_cv_t<KX>, Key> || is_transparent_key_available_v<EqX, H1X, HX>;
+
 	} // namespace internal
 
 
@@ -919,6 +1374,7 @@ namespace eastl
 		using hash_code_base_type::get_hash_code;
 		using hash_code_base_type::bucket_index;
 		using hash_code_base_type::compare;
+		using hash_code_base_type::compare_code;
 		using hash_code_base_type::set_code;
 		using hash_code_base_type::copy_code;
 
@@ -930,6 +1386,9 @@ namespace eastl
 		size_type       mnElementCount;
 		RehashPolicy    mRehashPolicy;  // To do: Use base class optimization to make this go away.
 		allocator_type  mAllocator;     // To do: Use base class optimization to make this go away.
+		#if EASTL_HASHTABLE_STATS_ENABLED
+			internal::hashtable_rehash_counters mRehashCounters; // A copy starts again from zero. swap and move exchange them along with the nodes.
+		#endif
 
 		struct NodeFindKeyData {
 			node_type* node;
@@ -1115,7 +1574,7 @@ namespace eastl
 		template <class M> eastl::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) { return DoInsertOrAssign(k, eastl::forward<M>(obj)); }
 		template <class M> eastl::pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj) { return DoInsertOrAssign(eastl::move(k), eastl::forward<M>(obj)); }
 		template<typename KX, typename M, typename EqX = Equal, typename H1X = H1, typename HX = H,
-			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
+			eastl::enable_if_t<!internal::is_hashed_key_v<KX> && internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
 		eastl::pair<iterator, bool>						insert_or_assign(KX&& k, M&& obj) { return DoInsertOrAssign(eastl::forward<KX>(k), eastl::forward<M>(obj)); }
 		template <class M> iterator						insert_or_assign(const_iterator hint, const key_type& k, M&& obj) { return DoInsertOrAssign(hint, k, eastl::forward<M>(obj)); }
 		template <class M> iterator						insert_or_assign(const_iterator hint, key_type&& k, M&& obj) { return DoInsertOrAssign(hint, eastl::move(k), eastl::forward<M>(obj)); }
@@ -1131,33 +1590,48 @@ namespace eastl
 		iterator         erase(iterator position) { return erase(const_iterator(position)); }
 		iterator         erase(const_iterator position);
 		iterator         erase(const_iterator first, const_iterator last);
-		size_type        erase(const key_type& k) { return DoErase(k); }
+		size_type        erase(const key_type& k) { return DoErase(k, get_hash_code(k)); }
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
-			&& internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		size_type        erase(KX&& k) { return DoErase(eastl::forward<KX>(k)); }
+			&& !internal::is_hashed_key_v<KX> && internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
+		size_type        erase(KX&& k) { return DoErase(k, get_hash_code(k)); }
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		size_type        erase(const hashed_key<KX>& hk) { return DoErase(hk.key(), DoGetHashCode(hk)); }
 
 		void clear();
 		void clear(bool clearBuckets);                  // If clearBuckets is true, we free the bucket memory and set the bucket count back to the newly constructed count.
 		void reset_lose_memory() EA_NOEXCEPT;           // This is a unilateral reset to an initially empty state. No destructors are called, no deallocation occurs.
 		void rehash(size_type nBucketCount);
 		void reserve(size_type nElementCount);
+		void shrink_to_fit();                           // Rehashes to the smallest bucket count the rehash policy allows for size() elements, if it is smaller than the current one.
 
-		iterator       find(const key_type& key) { return DoFind(key); }
-		const_iterator find(const key_type& key) const { return DoFind(key); }
+		iterator       find(const key_type& key) { return DoFind(key, get_hash_code(key)); }
+		const_iterator find(const key_type& key) const { return DoFind(key, get_hash_code(key)); }
 
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		iterator       find(const KX& key) { return DoFind(key); }
+		iterator       find(const KX& key) { return DoFind(key, get_hash_code(key)); }
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		const_iterator find(const KX& key) const { return DoFind(key); }
+		const_iterator find(const KX& key) const { return DoFind(key, get_hash_code(key)); }
+
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		iterator       find(const hashed_key<KX>& hk) { return DoFind(hk.key(), DoGetHashCode(hk)); }
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		const_iterator find(const hashed_key<KX>& hk) const { return DoFind(hk.key(), DoGetHashCode(hk)); }
 
-		bool contains(const key_type& key) const { return DoFind(key) != end(); }
+		bool contains(const key_type& key) const { return DoFind(key, get_hash_code(key)) != end(); }
 
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		bool contains(const KX& key) const { return DoFind(key) != end(); }
+		bool contains(const KX& key) const { return DoFind(key, get_hash_code(key)) != end(); }
+
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		bool contains(const hashed_key<KX>& hk) const { return DoFind(hk.key(), DoGetHashCode(hk)) != end(); }
 
 		/// Implements a find whereby the user supplies a comparison of a different type
 		/// than the hashtable value_type. A useful case of this is one whereby you have
@@ -1210,9 +1684,15 @@ namespace eastl
 				"so it requires cached hash codes.  Consider setting template parameter "
 				"bCacheHashCode to true or using find_by_hash(const key_type& k, hash_code_t c) instead.");
 
-			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			size_type  n     = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			node_type* pNode = DoFindNode(mpBucketArray[n], c);
 
-			node_type* const pNode = DoFindNode(mpBucketArray[n], c);
+			if(!pNode)
+			{
+				const size_type nOld = DoGetRehashBucketIndex(c, n); // Always mnBucketCount unless an incremental rehash is in progress.
+				if((nOld != mnBucketCount) && ((pNode = DoFindNode(mpBucketArray[nOld], c)) != NULL))
+					n = nOld;
+			}
 
 			return pNode ? iterator(pNode, mpBucketArray + n) :
 						   iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
@@ -1226,9 +1706,15 @@ namespace eastl
 								"so it requires cached hash codes.  Consider setting template parameter "
 								"bCacheHashCode to true or using find_by_hash(const key_type& k, hash_code_t c) instead.");
 
-			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			size_type  n     = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+			node_type* pNode = DoFindNode(mpBucketArray[n], c);
 
-			node_type* const pNode = DoFindNode(mpBucketArray[n], c);
+			if(!pNode)
+			{
+				const size_type nOld = DoGetRehashBucketIndex(c, n); // Always mnBucketCount unless an incremental rehash is in progress.
+				if((nOld != mnBucketCount) && ((pNode = DoFindNode(mpBucketArray[nOld], c)) != NULL))
+					n = nOld;
+			}
 
 			return pNode ?
 					   const_iterator(pNode, mpBucketArray + n) :
@@ -1237,22 +1723,54 @@ namespace eastl
 
 		iterator find_by_hash(const key_type& k, hash_code_t c)
 		{
-			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
-
-			node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
+			size_type        n;
+			node_type* const pNode = DoFindNodeAndBucket(k, c, n);
 			return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		const_iterator find_by_hash(const key_type& k, hash_code_t c) const
 		{
-			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
-
-			node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
+			size_type        n;
+			node_type* const pNode = DoFindNodeAndBucket(k, c, n);
 			return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		// todo: heterogeneous find_by_hash
 
+		/// find_batch
+		///
+		/// Looks up nKeyCount keys and writes an iterator for each of them to pResultArray,
+		/// or end() for keys that aren't present. This gives the same results as calling
+		/// find once per key, but is faster for large tables that don't fit in cache.
+		/// The keys are processed in groups of EASTL_HASHTABLE_BATCH_SIZE. The hash codes
+		/// of a group are computed and its buckets prefetched, then the bucket heads are
+		/// read and their first nodes prefetched, and only then are the chains searched.
+		/// The cache misses of a group thus overlap instead of occurring one after another.
+		///
+		/// Example usage:
+		///     hash_map<int, Widget>::iterator results[64];
+		///     hashMap.find_batch(keys, 64, results);
+		///
+		void find_batch(const key_type* pKeyArray, size_type nKeyCount, iterator* pResultArray);
+		void find_batch(const key_type* pKeyArray, size_type nKeyCount, const_iterator* pResultArray) const;
+
+		/// contains_batch
+		///
+		/// Like find_batch, but writes whether each key is present to pResultArray.
+		/// Returns the number of keys that are present.
+		///
+		size_type contains_batch(const key_type* pKeyArray, size_type nKeyCount, bool* pResultArray) const;
+
+		/// insert_batch
+		///
+		/// Inserts nValueCount values, with the same semantics as insert(first, last).
+		/// Like find_batch, the hash codes of each group of values are computed and their
+		/// buckets prefetched before any of the group is inserted.
+		/// Returns the number of values that were inserted, which for containers with
+		/// unique keys excludes values whose key was already present.
+		///
+		size_type insert_batch(const value_type* pValueArray, size_type nValueCount);
+
 		// Returns a pair that allows iterating over all nodes in a hash bucket
 		//   first in the pair returned holds the iterator for the beginning of the bucket,
 		//   second in the pair returned holds the iterator for the end of the bucket,
@@ -1262,25 +1780,38 @@ namespace eastl
 		eastl::pair<iterator, iterator> find_range_by_hash(hash_code_t c);
 		eastl::pair<const_iterator, const_iterator> find_range_by_hash(hash_code_t c) const;
 
-		size_type count(const key_type& k) const EA_NOEXCEPT { return DoCount(k); }
+		size_type count(const key_type& k) const EA_NOEXCEPT { return DoCount(k, get_hash_code(k)); }
 
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		size_type count(const KX& key) const EA_NOEXCEPT { return DoCount(key); }
+		size_type count(const KX& key) const EA_NOEXCEPT { return DoCount(key, get_hash_code(key)); }
 
-		eastl::pair<iterator, iterator>             equal_range(const key_type& k) { return DoEqualRange(k); }
-		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return DoEqualRange(k); }
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		size_type count(const hashed_key<KX>& hk) const EA_NOEXCEPT { return DoCount(hk.key(), DoGetHashCode(hk)); }
+
+		eastl::pair<iterator, iterator>             equal_range(const key_type& k) { return DoEqualRange(k, get_hash_code(k)); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return DoEqualRange(k, get_hash_code(k)); }
 
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		eastl::pair<iterator, iterator>             equal_range(const KX& k) { return DoEqualRange(k); }
+		eastl::pair<iterator, iterator>             equal_range(const KX& k) { return DoEqualRange(k, get_hash_code(k)); }
 		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
 			eastl::enable_if_t<internal::is_transparent_key_available_v<EqX, H1X, HX>, bool> = true>
-		eastl::pair<const_iterator, const_iterator> equal_range(const KX& k) const { return DoEqualRange(k); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& k) const { return DoEqualRange(k, get_hash_code(k)); }
+
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const hashed_key<KX>& hk) { return DoEqualRange(hk.key(), DoGetHashCode(hk)); }
+		template<typename KX, typename EqX = Equal, typename H1X = H1, typename HX = H,
+			eastl::enable_if_t<internal::is_hashed_key_lookup_available_v<KX, key_type, EqX, H1X, HX>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const hashed_key<KX>& hk) const { return DoEqualRange(hk.key(), DoGetHashCode(hk)); }
 
 		bool validate() const;
 		int  validate_iterator(const_iterator i) const;
 
+		hashtable_stats get_stats() const;
+
 	protected:
 		// We must remove one of the 'DoGetResultIterator' overloads from the overload-set (via SFINAE) because both can
 		// not compile successfully at the same time. The 'bUniqueKeys' template parameter chooses at compile-time the
@@ -1419,10 +1950,31 @@ namespace eastl
 		iterator                    DoInsertKey(false_type, const key_type& key) { return DoInsertKey(false_type(), key, get_hash_code(key)); }
 
 		void       DoRehash(size_type nBucketCount);
+		bool       DoGrowForInsert(uint32_t nElementAdd);
+		void       DoShrinkForErase();
+		void       DoRehashBegin(incremental_rehash_state& state, size_type nNewBucketCount);
+		bool       DoRehashStep(size_type nBucketCount);
+		void       DoResetRehashState() EA_NOEXCEPT;
+		size_type  DoGetRehashBucketIndex(hash_code_t c, size_type n) const EA_NOEXCEPT;
 		template <typename KX>
 		node_type* DoFindNode(node_type* pNode, const KX& k, hash_code_t c) const;
 		template <typename KX>
-		NodeFindKeyData DoFindKeyData(const KX& k) const;
+		node_type* DoFindNodeAndBucket(const KX& k, hash_code_t c, size_type& n) const;
+		template <typename KX>
+		node_type* DoFindNodeInBucket(const KX& k, hash_code_t c, size_type& n) const;
+		void       DoFindBatch(const key_type* pKeyArray, size_type nKeyCount, node_type** pNodeArray, size_type* pBucketArray) const;
+		template <typename KX>
+		NodeFindKeyData DoFindKeyData(const KX& k) const { return DoFindKeyData(k, get_hash_code(k)); }
+		template <typename KX>
+		NodeFindKeyData DoFindKeyData(const KX& k, hash_code_t c) const;
+
+		// Returns the hash code of a hashed_key as the hash_code_t of this hashtable.
+		template <typename KX>
+		hash_code_t DoGetHashCode(const hashed_key<KX>& hk) const
+		{
+			EASTL_ASSERT_MSG(get_hash_code(hk.key()) == (hash_code_t)hk.hash_code(), "hashtable: hashed_key hash code doesn't match the hash function of the container.");
+			return (hash_code_t)hk.hash_code();
+		}
 
 		template <typename T>
 		ENABLE_IF_HAS_HASHCODE(T, node_type) DoFindNode(T* pNode, hash_code_t c) const
@@ -1436,7 +1988,7 @@ namespace eastl
 		}
 
 		template <typename U, typename BinaryPredicate>
-		node_type* DoFindNodeT(node_type* pNode, const U& u, BinaryPredicate predicate) const;
+		node_type* DoFindNodeT(node_type* pNode, const U& u, hash_code_t c, BinaryPredicate predicate) const;
 
 	private:
 		template <typename V, typename Enabled = bool_constant<bUniqueKeys>, ENABLE_IF_TRUETYPE(Enabled) = nullptr>
@@ -1451,21 +2003,24 @@ namespace eastl
 		iterator					DoInsertOrAssign(const_iterator hint, KX&& k, M&& obj);
 
 		template<typename KX>
-		size_type        DoErase(KX&& k);
+		size_type        DoErase(const KX& k, hash_code_t c);
 
 		template<typename KX>
-		iterator DoFind(const KX& key);
+		iterator DoFind(const KX& key, hash_code_t c);
 
 		template<typename KX>
-		const_iterator DoFind(const KX& key) const;
+		const_iterator DoFind(const KX& key, hash_code_t c) const;
 
 		template<typename KX>
-		size_type DoCount(const KX& key) const EA_NOEXCEPT;
+		size_type DoCount(const KX& key, hash_code_t c) const EA_NOEXCEPT;
 
 		template<typename KX>
-		eastl::pair<iterator, iterator>             DoEqualRange(const KX& k);
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& k, hash_code_t c);
 		template<typename KX>
-		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& k) const;
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& k, hash_code_t c) const;
+
+		template <typename, typename>
+		friend struct rehash_base;
 
 	}; // class hashtable
 
@@ -1875,6 +2430,9 @@ namespace eastl
 		EASTL_MACRO_SWAP(node_type**, mpBucketArray, x.mpBucketArray);
 		eastl::swap(mnBucketCount, x.mnBucketCount);
 		eastl::swap(mnElementCount, x.mnElementCount);
+		#if EASTL_HASHTABLE_STATS_ENABLED
+			eastl::swap(mRehashCounters, x.mRehashCounters);
+		#endif
 
 		if (mAllocator != x.mAllocator) // If allocators are not equivalent...
 		{
@@ -1887,7 +2445,9 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::rehash_policy(const rehash_policy_type& rehashPolicy)
 	{
+		DoRehashStep(mnBucketCount); // Finish any incremental rehash, as its state is part of the policy we are replacing.
 		mRehashPolicy = rehashPolicy;
+		DoResetRehashState();
 
 		const size_type nBuckets = rehashPolicy.GetBucketCount((uint32_t)mnElementCount);
 
@@ -1901,12 +2461,10 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename KX>
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFind(const KX& k)
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFind(const KX& k, hash_code_t c)
 	{
-		const hash_code_t c = get_hash_code(k);
-		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-
-		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
+		size_type        n;
+		node_type* const pNode = DoFindNodeAndBucket(k, c, n);
 		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
@@ -1916,12 +2474,10 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename KX>
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFind(const KX& k) const
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFind(const KX& k, hash_code_t c) const
 	{
-		const hash_code_t c = get_hash_code(k);
-		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-
-		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
+		size_type        n;
+		node_type* const pNode = DoFindNodeAndBucket(k, c, n);
 		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
@@ -1933,10 +2489,16 @@ namespace eastl
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_as(const U& other, UHash uhash, BinaryPredicate predicate)
 	{
-		const hash_code_t c = (hash_code_t)uhash(other);
-		const size_type   n = (size_type)(c % mnBucketCount); // This assumes we are using the mod range policy.
+		const hash_code_t c     = (hash_code_t)uhash(other);
+		size_type         n     = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type*        pNode = DoFindNodeT(mpBucketArray[n], other, c, predicate);
 
-		node_type* const pNode = DoFindNodeT(mpBucketArray[n], other, predicate);
+		if(!pNode)
+		{
+			const size_type nOld = DoGetRehashBucketIndex(c, n); // Always mnBucketCount unless an incremental rehash is in progress.
+			if((nOld != mnBucketCount) && ((pNode = DoFindNodeT(mpBucketArray[nOld], other, c, predicate)) != NULL))
+				n = nOld;
+		}
 		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
@@ -1948,10 +2510,16 @@ namespace eastl
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_as(const U& other, UHash uhash, BinaryPredicate predicate) const
 	{
-		const hash_code_t c = (hash_code_t)uhash(other);
-		const size_type   n = (size_type)(c % mnBucketCount); // This assumes we are using the mod range policy.
+		const hash_code_t c     = (hash_code_t)uhash(other);
+		size_type         n     = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		node_type*        pNode = DoFindNodeT(mpBucketArray[n], other, c, predicate);
 
-		node_type* const pNode = DoFindNodeT(mpBucketArray[n], other, predicate);
+		if(!pNode)
+		{
+			const size_type nOld = DoGetRehashBucketIndex(c, n); // Always mnBucketCount unless an incremental rehash is in progress.
+			if((nOld != mnBucketCount) && ((pNode = DoFindNodeT(mpBucketArray[nOld], other, c, predicate)) != NULL))
+				n = nOld;
+		}
 		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
@@ -2026,7 +2594,16 @@ namespace eastl
 				typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator>
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_range_by_hash(hash_code_t c) const
 	{
-		const size_type start = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		size_type start = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+
+		if(!mpBucketArray[start])
+		{
+			// During an incremental rehash the nodes may still be in their old bucket.
+			const size_type nOld = DoGetRehashBucketIndex(c, start);
+			if(nOld != mnBucketCount)
+				start = nOld;
+		}
+
 		node_type* const pNodeStart = mpBucketArray[start];
 
 		if (pNodeStart)
@@ -2049,7 +2626,16 @@ namespace eastl
 				typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator>
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_range_by_hash(hash_code_t c)
 	{
-		const size_type start = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		size_type start = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+
+		if(!mpBucketArray[start])
+		{
+			// During an incremental rehash the nodes may still be in their old bucket.
+			const size_type nOld = DoGetRehashBucketIndex(c, start);
+			if(nOld != mnBucketCount)
+				start = nOld;
+		}
+
 		node_type* const pNodeStart = mpBucketArray[start];
 
 		if (pNodeStart)
@@ -2071,15 +2657,14 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename KX>
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoCount(const KX& k) const EA_NOEXCEPT
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoCount(const KX& k, hash_code_t c) const EA_NOEXCEPT
 	{
-		const hash_code_t c      = get_hash_code(k);
-		const size_type   n      = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		size_type         n;
 		size_type         result = 0;
 
 		// To do: Make a specialization for bU (unique keys) == true and take 
 		// advantage of the fact that the count will always be zero or one in that case. 
-		for(node_type* pNode = mpBucketArray[n]; pNode; pNode = pNode->mpNext)
+		for(node_type* pNode = DoFindNodeAndBucket(k, c, n); pNode; pNode = pNode->mpNext)
 		{
 			if(compare(k, c, pNode))
 				++result;
@@ -2094,12 +2679,11 @@ namespace eastl
 	template <typename KX>
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator,
 				typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator>
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoEqualRange(const KX& k)
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoEqualRange(const KX& k, hash_code_t c)
 	{
-		const hash_code_t c     = get_hash_code(k);
-		const size_type   n     = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		size_type         n;
+		node_type*        pNode = DoFindNodeAndBucket(k, c, n);
 		node_type**       head  = mpBucketArray + n;
-		node_type*        pNode = DoFindNode(*head, k, c);
 
 		if(pNode)
 		{
@@ -2132,12 +2716,11 @@ namespace eastl
 	template <typename KX>
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator,
 				typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator>
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoEqualRange(const KX& k) const
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoEqualRange(const KX& k, hash_code_t c) const
 	{
-		const hash_code_t c     = get_hash_code(k);
-		const size_type   n     = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		size_type         n;
+		node_type*        pNode = DoFindNodeAndBucket(k, c, n);
 		node_type**       head  = mpBucketArray + n;
-		node_type*        pNode = DoFindNode(*head, k, c);
 
 		if(pNode)
 		{
@@ -2167,14 +2750,44 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename KX>
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::NodeFindKeyData
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindKeyData(const KX& k) const {
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindKeyData(const KX& k, hash_code_t c) const {
 		NodeFindKeyData d;
-		d.code		   = get_hash_code(k);
-		d.bucket_index = (size_type)bucket_index(k, d.code, (uint32_t)mnBucketCount);
-		d.node		   = DoFindNode(mpBucketArray[d.bucket_index], k, d.code);
+		d.code		   = c;
+		d.node		   = DoFindNodeAndBucket(k, d.code, d.bucket_index);
 		return d;
 	}
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::node_type* 
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindNodeAndBucket(const KX& k, hash_code_t c, size_type& n) const
+	{
+		// Returns the node matching k and sets n to the index of the bucket it is in.
+		// If there is no such node, n is set to the bucket that a new node would go in.
+		n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		return DoFindNodeInBucket(k, c, n);
+	}
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	template <typename KX>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::node_type* 
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindNodeInBucket(const KX& k, hash_code_t c, size_type& n) const
+	{
+		// Same as DoFindNodeAndBucket, but n is given as the bucket index of c.
+		node_type* pNode = DoFindNode(mpBucketArray[n], k, c);
+
+		if(!pNode)
+		{
+			const size_type nOld = DoGetRehashBucketIndex(c, n); // Always mnBucketCount unless an incremental rehash is in progress.
+			if((nOld != mnBucketCount) && ((pNode = DoFindNode(mpBucketArray[nOld], k, c)) != NULL))
+				n = nOld;
+		}
+
+		return pNode;
+	}
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename KX>
@@ -2195,11 +2808,13 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename U, typename BinaryPredicate>
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::node_type* 
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindNodeT(node_type* pNode, const U& other, BinaryPredicate predicate) const
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindNodeT(node_type* pNode, const U& other, hash_code_t c, BinaryPredicate predicate) const
 	{
+		// If hash codes are cached, nodes whose hash code differs from c are skipped without calling the predicate.
+		// This relies on find_as's requirement that uhash(other) equals the hash of the keys other compares equal to.
 		for(; pNode; pNode = pNode->mpNext)
 		{
-			if(predicate(mExtractKey(pNode->mValue), other)) // Intentionally compare with key as first arg and other as second arg.
+			if(compare_code(c, pNode) && predicate(mExtractKey(pNode->mValue), other)) // Intentionally compare with key as first arg and other as second arg.
 				return pNode;
 		}
 		return NULL;
@@ -2212,19 +2827,14 @@ namespace eastl
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator, bool>
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertUniqueNode(const key_type& k, hash_code_t c, size_type n, node_type* pNodeNew)
 	{
-		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
-
 		set_code(pNodeNew, c); // This is a no-op for most hashtables.
 
 		#if EASTL_EXCEPTIONS_ENABLED
 			try
 			{
 		#endif
-				if(bRehash.first)
-				{
-					n = (size_type)bucket_index(k, c, (uint32_t)bRehash.second);
-					DoRehash(bRehash.second);
-				}
+				if(DoGrowForInsert(1))
+					n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 
 				EASTL_ASSERT((uintptr_t)mpBucketArray != (uintptr_t)&gpEmptyBucketArray[0]);
 				pNodeNew->mpNext = mpBucketArray[n];
@@ -2262,8 +2872,8 @@ namespace eastl
 		node_type* const  pNodeNew = DoAllocateNode(eastl::forward<Args>(args)...);
 		const key_type&   k        = mExtractKey(pNodeNew->mValue);
 		const hash_code_t c        = get_hash_code(k);
-		size_type         n        = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-		node_type* const  pNode    = DoFindNode(mpBucketArray[n], k, c);
+		size_type         n;
+		node_type* const  pNode    = DoFindNodeAndBucket(k, c, n);
 
 		if(pNode == NULL) // If value is not present... add it.
 		{
@@ -2291,15 +2901,11 @@ namespace eastl
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertValue(BoolConstantT, Args&&... args) // false_type means bUniqueKeys is false.
 	{
-		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
-
-		if(bRehash.first)
-			DoRehash(bRehash.second);
+		DoGrowForInsert(1);
 
 		node_type*        pNodeNew = DoAllocateNode(eastl::forward<Args>(args)...);
 		const key_type&   k        = mExtractKey(pNodeNew->mValue);
 		const hash_code_t c        = get_hash_code(k);
-		const size_type   n        = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 
 		set_code(pNodeNew, c); // This is a no-op for most hashtables.
 
@@ -2309,7 +2915,8 @@ namespace eastl
 		// erase(value) can more quickly find equal values. The downside is that
 		// this insertion operation taking some extra time. How important is it to
 		// us that equal_range span all equal items? 
-		node_type* const pNodePrev = DoFindNode(mpBucketArray[n], k, c);
+		size_type        n;
+		node_type* const pNodePrev = DoFindNodeAndBucket(k, c, n);
 
 		if(pNodePrev == NULL)
 		{
@@ -2392,8 +2999,8 @@ namespace eastl
 	{
 		// Adds the value to the hash table if not already present. 
 		// If already present then the existing value is returned via an iterator/bool pair.
-		size_type         n     = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-		node_type* const  pNode = DoFindNode(mpBucketArray[n], k, c);
+		size_type         n;
+		node_type* const  pNode = DoFindNodeAndBucket(k, c, n);
 
 		if(pNode == NULL) // If value is not present... add it.
 		{
@@ -2449,12 +3056,7 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertValueExtra(BoolConstantT, const key_type& k, hash_code_t c, node_type* pNodeNew, value_type&& value, 
 			DISABLE_IF_TRUETYPE(BoolConstantT)) // false_type means bUniqueKeys is false.
 	{
-		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
-
-		if(bRehash.first)
-			DoRehash(bRehash.second); // Note: We don't need to wrap this call with try/catch because there's nothing we would need to do in the catch.
-
-		const size_type n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoGrowForInsert(1); // Note: We don't need to wrap this call with try/catch because there's nothing we would need to do in the catch.
 
 		if(pNodeNew)
 			detail::allocator_construct(mAllocator, eastl::addressof(pNodeNew->mValue), eastl::move(value)); // It's expected that pNodeNew was allocated with allocate_uninitialized_node.
@@ -2469,7 +3071,8 @@ namespace eastl
 		// erase(value) can more quickly find equal values. The downside is that
 		// this insertion operation taking some extra time. How important is it to
 		// us that equal_range span all equal items? 
-		node_type* const pNodePrev = DoFindNode(mpBucketArray[n], k, c);
+		size_type        n;
+		node_type* const pNodePrev = DoFindNodeAndBucket(k, c, n);
 
 		if(pNodePrev == NULL)
 		{
@@ -2572,12 +3175,7 @@ namespace eastl
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertValueExtra(BoolConstantT, const key_type& k, hash_code_t c, node_type* pNodeNew, const value_type& value,
 			DISABLE_IF_TRUETYPE(BoolConstantT)) // false_type means bUniqueKeys is false.
 	{
-		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
-
-		if(bRehash.first)
-			DoRehash(bRehash.second); // Note: We don't need to wrap this call with try/catch because there's nothing we would need to do in the catch.
-
-		const size_type n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
+		DoGrowForInsert(1); // Note: We don't need to wrap this call with try/catch because there's nothing we would need to do in the catch.
 
 		if(pNodeNew)
 			detail::allocator_construct(mAllocator, eastl::addressof(pNodeNew->mValue), value); // It's expected that pNodeNew was allocated with allocate_uninitialized_node.
@@ -2592,7 +3190,8 @@ namespace eastl
 		// erase(value) can more quickly find equal values. The downside is that
 		// this insertion operation taking some extra time. How important is it to
 		// us that equal_range span all equal items? 
-		node_type* const pNodePrev = DoFindNode(mpBucketArray[n], k, c);
+		size_type        n;
+		node_type* const pNodePrev = DoFindNodeAndBucket(k, c, n);
 
 		if(pNodePrev == NULL)
 		{
@@ -2692,13 +3291,11 @@ namespace eastl
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator, bool>
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(true_type, const key_type& key, const hash_code_t c) // true_type means bUniqueKeys is true.
 	{
-		size_type         n     = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
-		node_type* const  pNode = DoFindNode(mpBucketArray[n], key, c);
+		size_type         n;
+		node_type* const  pNode = DoFindNodeAndBucket(key, c, n);
 
 		if(pNode == NULL)
 		{
-			const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
-
 			// Allocate the new node before doing the rehash so that we don't
 			// do a rehash if the allocation throws.
 			node_type* const pNodeNew = DoAllocateNodeFromKey(key);
@@ -2708,11 +3305,8 @@ namespace eastl
 				try
 				{
 			#endif
-					if(bRehash.first)
-					{
-						n = (size_type)bucket_index(key, c, (uint32_t)bRehash.second);
-						DoRehash(bRehash.second);
-					}
+					if(DoGrowForInsert(1))
+						n = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
 
 					EASTL_ASSERT((void**)mpBucketArray != &gpEmptyBucketArray[0]);
 					pNodeNew->mpNext = mpBucketArray[n];
@@ -2740,12 +3334,7 @@ namespace eastl
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(false_type, const key_type& key, const hash_code_t c) // false_type means bUniqueKeys is false.
 	{
-		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
-
-		if(bRehash.first)
-			DoRehash(bRehash.second);
-
-		const size_type   n = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
+		DoGrowForInsert(1);
 
 		node_type* const pNodeNew = DoAllocateNodeFromKey(key);
 		set_code(pNodeNew, c); // This is a no-op for most hashtables.
@@ -2756,7 +3345,8 @@ namespace eastl
 		// erase(value) can more quickly find equal values. The downside is that
 		// this insertion operation taking some extra time. How important is it to
 		// us that equal_range span all equal items? 
-		node_type* const pNodePrev = DoFindNode(mpBucketArray[n], key, c);
+		size_type        n;
+		node_type* const pNodePrev = DoFindNodeAndBucket(key, c, n);
 
 		if(pNodePrev == NULL)
 		{
@@ -2876,16 +3466,142 @@ namespace eastl
 	void
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert(InputIterator first, InputIterator last)
 	{
-		const uint32_t nElementAdd = (uint32_t)eastl::ht_distance(first, last);
-		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, nElementAdd);
-
-		if(bRehash.first)
-			DoRehash(bRehash.second);
+		DoGrowForInsert((uint32_t)eastl::ht_distance(first, last));
 
 		for(; first != last; ++first)
 			DoInsertValue(has_unique_keys_type(), *first);
 	}
 
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert_batch(const value_type* pValueArray, size_type nValueCount)
+	{
+		const size_type nElementCountPrev = mnElementCount;
+		hash_code_t     codeArray[EASTL_HASHTABLE_BATCH_SIZE];
+
+		DoGrowForInsert((uint32_t)nValueCount);
+
+		for(size_type i = 0; i < nValueCount; i += EASTL_HASHTABLE_BATCH_SIZE)
+		{
+			const value_type* const pGroup      = pValueArray + i;
+			const size_type         nGroupCount = ((nValueCount - i) < EASTL_HASHTABLE_BATCH_SIZE) ? (nValueCount - i) : EASTL_HASHTABLE_BATCH_SIZE;
+
+			for(size_type j = 0; j < nGroupCount; ++j)
+			{
+				const key_type& k = mExtractKey(pGroup[j]);
+				codeArray[j] = get_hash_code(k);
+				EASTL_PREFETCH(mpBucketArray + bucket_index(k, codeArray[j], (uint32_t)mnBucketCount));
+			}
+
+			// The prefetches are only hints, so it doesn't matter if an insertion below
+			// migrates or reallocates buckets before a later value of the group gets to them.
+			for(size_type j = 0; j < nGroupCount; ++j)
+				DoInsertValueExtra(has_unique_keys_type(), mExtractKey(pGroup[j]), codeArray[j], NULL, pGroup[j]);
+		}
+
+		return mnElementCount - nElementCountPrev;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_batch(const key_type* pKeyArray, size_type nKeyCount, iterator* pResultArray)
+	{
+		node_type* nodeArray[EASTL_HASHTABLE_BATCH_SIZE];
+		size_type  bucketArray[EASTL_HASHTABLE_BATCH_SIZE];
+
+		for(size_type i = 0; i < nKeyCount; i += EASTL_HASHTABLE_BATCH_SIZE)
+		{
+			const size_type nGroupCount = ((nKeyCount - i) < EASTL_HASHTABLE_BATCH_SIZE) ? (nKeyCount - i) : EASTL_HASHTABLE_BATCH_SIZE;
+
+			DoFindBatch(pKeyArray + i, nGroupCount, nodeArray, bucketArray);
+
+			for(size_type j = 0; j < nGroupCount; ++j)
+			{
+				pResultArray[i + j] = nodeArray[j] ? iterator(nodeArray[j], mpBucketArray + bucketArray[j]) :
+													 iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_batch(const key_type* pKeyArray, size_type nKeyCount, const_iterator* pResultArray) const
+	{
+		node_type* nodeArray[EASTL_HASHTABLE_BATCH_SIZE];
+		size_type  bucketArray[EASTL_HASHTABLE_BATCH_SIZE];
+
+		for(size_type i = 0; i < nKeyCount; i += EASTL_HASHTABLE_BATCH_SIZE)
+		{
+			const size_type nGroupCount = ((nKeyCount - i) < EASTL_HASHTABLE_BATCH_SIZE) ? (nKeyCount - i) : EASTL_HASHTABLE_BATCH_SIZE;
+
+			DoFindBatch(pKeyArray + i, nGroupCount, nodeArray, bucketArray);
+
+			for(size_type j = 0; j < nGroupCount; ++j)
+			{
+				pResultArray[i + j] = nodeArray[j] ? const_iterator(nodeArray[j], mpBucketArray + bucketArray[j]) :
+													 const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::contains_batch(const key_type* pKeyArray, size_type nKeyCount, bool* pResultArray) const
+	{
+		node_type* nodeArray[EASTL_HASHTABLE_BATCH_SIZE];
+		size_type  bucketArray[EASTL_HASHTABLE_BATCH_SIZE];
+		size_type  nFoundCount = 0;
+
+		for(size_type i = 0; i < nKeyCount; i += EASTL_HASHTABLE_BATCH_SIZE)
+		{
+			const size_type nGroupCount = ((nKeyCount - i) < EASTL_HASHTABLE_BATCH_SIZE) ? (nKeyCount - i) : EASTL_HASHTABLE_BATCH_SIZE;
+
+			DoFindBatch(pKeyArray + i, nGroupCount, nodeArray, bucketArray);
+
+			for(size_type j = 0; j < nGroupCount; ++j)
+			{
+				pResultArray[i + j] = (nodeArray[j] != NULL);
+				nFoundCount += (nodeArray[j] != NULL);
+			}
+		}
+
+		return nFoundCount;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoFindBatch(const key_type* pKeyArray, size_type nKeyCount, 
+																		   node_type** pNodeArray, size_type* pBucketArray) const
+	{
+		// Finds up to EASTL_HASHTABLE_BATCH_SIZE keys in three passes, so that the
+		// memory accesses of each pass are independent of each other and can be in 
+		// flight at the same time. pNodeArray receives the nodes (or NULL) and 
+		// pBucketArray the index of the bucket each node is in.
+		hash_code_t codeArray[EASTL_HASHTABLE_BATCH_SIZE];
+
+		EASTL_ASSERT(nKeyCount <= EASTL_HASHTABLE_BATCH_SIZE);
+
+		for(size_type j = 0; j < nKeyCount; ++j)
+		{
+			codeArray[j]    = get_hash_code(pKeyArray[j]);
+			pBucketArray[j] = (size_type)bucket_index(pKeyArray[j], codeArray[j], (uint32_t)mnBucketCount);
+			EASTL_PREFETCH(mpBucketArray + pBucketArray[j]);
+		}
+
+		for(size_type j = 0; j < nKeyCount; ++j)
+			EASTL_PREFETCH(mpBucketArray[pBucketArray[j]]); // Prefetching NULL for an empty bucket is harmless.
+
+		for(size_type j = 0; j < nKeyCount; ++j)
+			pNodeArray[j] = DoFindNodeInBucket(pKeyArray[j], codeArray[j], pBucketArray[j]);
+	}
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <class KX, class M>
@@ -2966,13 +3682,12 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	template <typename KX>
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type 
-	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoErase(KX&& k)
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoErase(const KX& k, hash_code_t c)
 	{
 		// To do: Reimplement this function to do a single loop and not try to be 
 		// smart about element contiguity. The mechanism here is only a benefit if the 
 		// buckets are heavily overloaded; otherwise this mechanism may be slightly slower.
 
-		const hash_code_t c = get_hash_code(k);
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 		const size_type   nElementCountSaved = mnElementCount;
 
@@ -2981,6 +3696,19 @@ namespace eastl
 		while(*pBucketArray && !compare(k, c, *pBucketArray))
 			pBucketArray = &(*pBucketArray)->mpNext;
 
+		if(!*pBucketArray)
+		{
+			const size_type nOld = DoGetRehashBucketIndex(c, n); // Always mnBucketCount unless an incremental rehash is in progress.
+
+			if(nOld != mnBucketCount)
+			{
+				pBucketArray = mpBucketArray + nOld;
+
+				while(*pBucketArray && !compare(k, c, *pBucketArray))
+					pBucketArray = &(*pBucketArray)->mpNext;
+			}
+		}
+
 		node_type* pDeleteList = nullptr;
 		while(*pBucketArray && compare(k, c, *pBucketArray))
 		{
@@ -3000,6 +3728,9 @@ namespace eastl
 			DoFreeNode(pToDelete);
 		}
 
+		if(mnElementCount != nElementCountSaved)
+			DoShrinkForErase();
+
 		return nElementCountSaved - mnElementCount;
 	}
 
@@ -3010,6 +3741,7 @@ namespace eastl
 	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::clear()
 	{
 		DoFreeNodes(mpBucketArray, mnBucketCount);
+		DoResetRehashState();
 		mnElementCount = 0;
 	}
 
@@ -3020,6 +3752,7 @@ namespace eastl
 	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::clear(bool clearBuckets)
 	{
 		DoFreeNodes(mpBucketArray, mnBucketCount);
+		DoResetRehashState();
 		if(clearBuckets)
 		{
 			DoFreeBuckets(mpBucketArray, mnBucketCount);
@@ -3049,6 +3782,7 @@ namespace eastl
 
 		mnElementCount = 0;
 		mRehashPolicy.mnNextResize = 0;
+		DoResetRehashState();
 	}
 
 
@@ -3061,6 +3795,21 @@ namespace eastl
 
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::shrink_to_fit()
+	{
+		const uint32_t  nNextResizeSaved = mRehashPolicy.mnNextResize;
+		const size_type nBucketCount     = mRehashPolicy.GetBucketCount((uint32_t)mnElementCount); // This updates mnNextResize for the new bucket count.
+
+		if(nBucketCount < mnBucketCount)
+			DoRehash(nBucketCount);
+		else
+			mRehashPolicy.mnNextResize = nNextResizeSaved;
+	}
+
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::rehash(size_type nBucketCount)
@@ -3096,9 +3845,15 @@ namespace eastl
 					}
 				}
 
+				#if EASTL_HASHTABLE_STATS_ENABLED
+					mRehashCounters.mnRehashCount++;
+					mRehashCounters.mnRehashNodeCount += mnElementCount;
+				#endif
+
 				DoFreeBuckets(mpBucketArray, mnBucketCount);
 				mnBucketCount = nNewBucketCount;
 				mpBucketArray = pBucketArray;
+				DoResetRehashState(); // DoRehash places every node, including any an incremental rehash hadn't migrated yet.
 		#if EASTL_EXCEPTIONS_ENABLED
 			}
 			catch(...)
@@ -3109,6 +3864,7 @@ namespace eastl
 				DoFreeNodes(pBucketArray, nNewBucketCount);
 				DoFreeBuckets(pBucketArray, nNewBucketCount);
 				DoFreeNodes(mpBucketArray, mnBucketCount);
+				DoResetRehashState();
 				mnElementCount = 0;
 				throw;
 			}
@@ -3116,6 +3872,146 @@ namespace eastl
 	}
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline bool hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoGrowForInsert(uint32_t nElementAdd)
+	{
+		// Makes room for nElementAdd more elements. Returns true if the bucket count changed.
+		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, nElementAdd);
+		incremental_rehash_state* const   pState  = internal::GetIncrementalRehashState(mRehashPolicy);
+
+		if(pState) // This is always NULL unless the rehash policy is incremental_rehash_policy.
+		{
+			if(pState->mnRehashBucketCount) // If a rehash is in progress, advance it, or finish it if we are about to start another one.
+				DoRehashStep(bRehash.first ? mnBucketCount : (size_type)pState->mnRehashStep);
+
+			if(bRehash.first)
+				DoRehashBegin(*pState, bRehash.second);
+		}
+		else if(bRehash.first)
+			DoRehash(bRehash.second);
+
+		return bRehash.first;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoShrinkForErase()
+	{
+		// Shrinks the bucket array if erasing took the load factor below the rehash policy's min load factor.
+		// This is only done by the erase functions that don't return an iterator, so erasing while iterating stays valid.
+		const eastl::pair<bool, uint32_t> bShrink = internal::GetShrinkRequired(mRehashPolicy, (uint32_t)mnBucketCount, (uint32_t)mnElementCount, 0);
+
+		if(bShrink.first)
+			DoRehash(bShrink.second);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashBegin(incremental_rehash_state& state, size_type nNewBucketCount)
+	{
+		// Starts an incremental rehash. The new bucket array starts out holding the
+		// old buckets at their old indexes, which DoRehashStep then migrates.
+		if((mnElementCount == 0) || (mnBucketCount < 2)) // If there is nothing to migrate or we are using gpEmptyBucketArray...
+			DoRehash(nNewBucketCount);
+		else
+		{
+			EASTL_ASSERT((nNewBucketCount > mnBucketCount) && (state.mnRehashBucketCount == 0));
+
+			node_type** const pBucketArray = DoAllocateBuckets(nNewBucketCount);
+			memcpy(pBucketArray, mpBucketArray, mnBucketCount * sizeof(node_type*));
+			DoFreeBuckets(mpBucketArray, mnBucketCount);
+
+			state.mnRehashBucketCount = (uint32_t)mnBucketCount;
+			state.mnRehashIndex       = 0;
+			mnBucketCount = nNewBucketCount;
+			mpBucketArray = pBucketArray;
+
+			#if EASTL_HASHTABLE_STATS_ENABLED
+				mRehashCounters.mnRehashCount++;
+			#endif
+		}
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	bool hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoRehashStep(size_type nBucketCount)
+	{
+		// Migrates the nodes of up to nBucketCount old buckets of an incremental rehash
+		// to their new buckets. Returns true if the rehash is still in progress.
+		incremental_rehash_state* const pState = internal::GetIncrementalRehashState(mRehashPolicy);
+
+		if(!pState || !pState->mnRehashBucketCount) // pState is always NULL unless the rehash policy is incremental_rehash_policy.
+			return false;
+
+		const size_type nRemaining = (size_type)(pState->mnRehashBucketCount - pState->mnRehashIndex);
+
+		for(size_type i = pState->mnRehashIndex, iEnd = i + eastl::min_alt(nBucketCount, nRemaining); i < iEnd; ++i)
+		{
+			node_type** ppNode = mpBucketArray + i;
+
+			while(*ppNode)
+			{
+				node_type* const pNode           = *ppNode;
+				const size_type  nNewBucketIndex = (size_type)bucket_index(pNode, (uint32_t)mnBucketCount);
+
+				if(nNewBucketIndex != i)
+				{
+					*ppNode = pNode->mpNext;
+					pNode->mpNext = mpBucketArray[nNewBucketIndex];
+					mpBucketArray[nNewBucketIndex] = pNode;
+					#if EASTL_HASHTABLE_STATS_ENABLED
+						mRehashCounters.mnRehashNodeCount++;
+					#endif
+				}
+				else
+					ppNode = &pNode->mpNext;
+			}
+
+			pState->mnRehashIndex = (uint32_t)(i + 1); // Updated per bucket, so a throwing hash function leaves a consistent state.
+		}
+
+		if(pState->mnRehashIndex == pState->mnRehashBucketCount)
+			pState->mnRehashBucketCount = pState->mnRehashIndex = 0;
+
+		return pState->mnRehashBucketCount != 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline void hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoResetRehashState() EA_NOEXCEPT
+	{
+		if(incremental_rehash_state* const pState = internal::GetIncrementalRehashState(mRehashPolicy))
+			pState->mnRehashBucketCount = pState->mnRehashIndex = 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoGetRehashBucketIndex(hash_code_t c, size_type n) const EA_NOEXCEPT
+	{
+		// Returns the index of the bucket, other than n, in which nodes of hash code c may
+		// still be because an incremental rehash hasn't migrated them yet. Returns mnBucketCount
+		// if there is no such bucket.
+		const incremental_rehash_state* const pState = internal::GetIncrementalRehashState(mRehashPolicy);
+
+		if(pState && pState->mnRehashBucketCount) // pState is always NULL unless the rehash policy is incremental_rehash_policy.
+		{
+			const size_type nOld = (size_type)bucket_index(c, pState->mnRehashBucketCount);
+
+			if((nOld >= pState->mnRehashIndex) && (nOld != n))
+				return nOld;
+		}
+
+		return mnBucketCount;
+	}
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	inline bool hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::validate() const
@@ -3157,12 +4053,36 @@ namespace eastl
 		if(nElementCount != mnElementCount)
 			return false;
 
+		// Verify that an incremental rehash in progress is migrating from a smaller bucket count.
+		if(const incremental_rehash_state* const pState = internal::GetIncrementalRehashState(mRehashPolicy))
+		{
+			if(pState->mnRehashBucketCount && ((pState->mnRehashBucketCount >= mnBucketCount) || (pState->mnRehashIndex >= pState->mnRehashBucketCount)))
+				return false;
+		}
+
 		// To do: Verify that individual elements are in the expected buckets.
 
 		return true;
 	}
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	hashtable_stats hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::get_stats() const
+	{
+		// This walks every bucket and node, so it's meant for diagnostics rather than for regular use.
+		hashtable_stats stats;
+		internal::GetBucketStats<node_type>(stats, mpBucketArray, mnBucketCount);
+
+		#if EASTL_HASHTABLE_STATS_ENABLED
+			stats.mnRehashCount     = mRehashCounters.mnRehashCount;
+			stats.mnRehashNodeCount = mRehashCounters.mnRehashNodeCount;
+		#endif
+
+		return stats;
+	}
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	int hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::validate_iterator(const_iterator i) const
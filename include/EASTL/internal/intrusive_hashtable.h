@@ -449,6 +449,8 @@ namespace eastl
 		bool validate() const;
 		int  validate_iterator(const_iterator i) const;
 
+		hashtable_stats get_stats() const;
+
 	public:
 		Hash hash_function() const
 			{ return mHash; }
@@ -944,6 +946,16 @@ namespace eastl
 	}
 
 
+	template <typename K, typename V, typename H, typename Eq, size_t bC, bool bM, bool bU>
+	hashtable_stats intrusive_hashtable<K, V, H, Eq, bC, bM, bU>::get_stats() const
+	{
+		// The bucket count is fixed, so the rehash counters are always zero.
+		hashtable_stats stats;
+		internal::GetBucketStats<intrusive_hash_node>(stats, mBucketArray, kBucketCount);
+		return stats;
+	}
+
+
 	template <typename K, typename V, typename H, typename Eq, size_t bC, bool bM, bool bU>
 	int intrusive_hashtable<K, V, H, Eq, bC, bM, bU>::validate_iterator(const_iterator i) const
 	{
@@ -0,0 +1,778 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements intrusive_rbtree, the base class of intrusive_set,
+// intrusive_multiset, intrusive_map and intrusive_multimap. It is to rbtree
+// what intrusive_hashtable is to hashtable:
+//
+// * The tree nodes are stored directly in the user's objects. This is done by
+//   deriving the object from intrusive_rbtree_node, or for maps from
+//   intrusive_rbtree_node_key<Key>, which also holds the key as mKey.
+//
+// * The container does no memory allocation. Inserting links the submitted
+//   object into the tree and erasing unlinks it; it is the user's job to
+//   create and destroy the objects, and an object must not be destroyed or
+//   have its key changed while it is in a tree.
+//
+// * A reference to an object in the tree can be converted to an iterator in
+//   O(1) with locate(), and remove() unlinks an object without searching for
+//   it. The rebalancing that follows takes amortized constant time.
+//
+// * An object can be in several trees at once if it has one node for each.
+//   As with intrusive_list, this is done by deriving from several distinct
+//   node types, and the node type to use is a template parameter of the tree:
+//
+//      struct ByName : public intrusive_rbtree_node_key<eastl::string> {};
+//      struct ById   : public intrusive_rbtree_node_key<int> {};
+//      struct Widget : public ByName, public ById { ... };
+//
+//      intrusive_map<eastl::string, Widget, eastl::less<eastl::string>, ByName> widgetsByName;
+//      intrusive_map<int, Widget, eastl::less<int>, ById>                       widgetsById;
+//
+//   Each object must set mKey of each of its nodes before inserting the object
+//   into the corresponding map (for example, static_cast<ByName&>(w).mKey).
+//
+// The tree maintenance is done by the same RBTreeInsert and RBTreeErase
+// functions that rbtree uses.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_INTRUSIVE_RBTREE_H
+#define EASTL_INTERNAL_INTRUSIVE_RBTREE_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/red_black_tree.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/iterator.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#include <EASTL/bonus/compressed_pair.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// intrusive_rbtree_node
+	///
+	/// The node that objects in an intrusive_set or intrusive_multiset derive from.
+	/// Like intrusive_list_node, it is a POD and its contents are only meaningful
+	/// while the object is in a tree.
+	///
+	/// Example usage:
+	///   struct Widget : public intrusive_rbtree_node { ... };
+	///
+	struct intrusive_rbtree_node : public rbtree_node_base
+	{
+	};
+
+
+	/// intrusive_rbtree_node_key
+	///
+	/// The node that objects in an intrusive_map or intrusive_multimap derive from.
+	/// mKey is the object's key in the map.
+	///
+	/// Example usage:
+	///   struct Widget : public intrusive_rbtree_node_key<int> { ... };
+	///
+	template <typename Key>
+	struct intrusive_rbtree_node_key : public intrusive_rbtree_node
+	{
+		typedef Key key_type;
+		Key mKey;
+	};
+
+
+
+	/// intrusive_rbtree_iterator
+	///
+	/// Iterates the objects of an intrusive_rbtree. T is the object type and Node
+	/// is the base of T that links it into the tree.
+	///
+	template <typename T, typename Node, typename Pointer, typename Reference>
+	struct intrusive_rbtree_iterator
+	{
+		typedef intrusive_rbtree_iterator<T, Node, Pointer, Reference>     this_type;
+		typedef intrusive_rbtree_iterator<T, Node, T*, T&>                 iterator;
+		typedef intrusive_rbtree_iterator<T, Node, const T*, const T&>     const_iterator;
+		typedef eastl_size_t                                               size_type;
+		typedef ptrdiff_t                                                  difference_type;
+		typedef T                                                          value_type;
+		typedef Pointer                                                    pointer;
+		typedef Reference                                                  reference;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                   iterator_category;
+
+	public:
+		rbtree_node_base* mpNode;
+
+	public:
+		intrusive_rbtree_iterator()
+			: mpNode(NULL) { }
+
+		explicit intrusive_rbtree_iterator(const rbtree_node_base* pNode)
+			: mpNode(const_cast<rbtree_node_base*>(pNode)) { }
+
+		intrusive_rbtree_iterator(const iterator& x)
+			: mpNode(x.mpNode) { }
+
+		intrusive_rbtree_iterator& operator=(const iterator& x)
+			{ mpNode = x.mpNode; return *this; }
+
+		reference operator*() const
+			{ return static_cast<reference>(static_cast<Node&>(*mpNode)); }
+
+		pointer operator->() const
+			{ return &**this; }
+
+		this_type& operator++()
+			{ mpNode = RBTreeIncrement(mpNode); return *this; }
+
+		this_type operator++(int)
+			{ this_type temp(*this); mpNode = RBTreeIncrement(mpNode); return temp; }
+
+		this_type& operator--()
+			{ mpNode = RBTreeDecrement(mpNode); return *this; }
+
+		this_type operator--(int)
+			{ this_type temp(*this); mpNode = RBTreeDecrement(mpNode); return temp; }
+
+	}; // intrusive_rbtree_iterator
+
+
+	template <typename T, typename Node, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator==(const intrusive_rbtree_iterator<T, Node, PointerA, ReferenceA>& a,
+						   const intrusive_rbtree_iterator<T, Node, PointerB, ReferenceB>& b)
+	{
+		return a.mpNode == b.mpNode;
+	}
+
+
+	template <typename T, typename Node, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
+	inline bool operator!=(const intrusive_rbtree_iterator<T, Node, PointerA, ReferenceA>& a,
+						   const intrusive_rbtree_iterator<T, Node, PointerB, ReferenceB>& b)
+	{
+		return a.mpNode != b.mpNode;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	/// intrusive_rbtree
+	///
+	/// Template parameters:
+	///     Key             The key type. For sets this is T itself.
+	///     T               The type of object the tree holds. T must derive from Node.
+	///     Compare         Ordering of keys.
+	///     Node            The node type, derived from intrusive_rbtree_node, that links T into this tree.
+	///     ExtractKey      Gets the key from a T; use_self for sets and use_intrusive_key for maps.
+	///     bConstIterators If true, iterators give const access to the objects, as with set.
+	///     bUniqueKeys     If true, an object isn't inserted if an object with an equal key is present.
+	///
+	template <typename Key, typename T, typename Compare, typename Node, typename ExtractKey,
+			  bool bConstIterators, bool bUniqueKeys>
+	class intrusive_rbtree
+	{
+	public:
+		typedef intrusive_rbtree<Key, T, Compare, Node, ExtractKey,
+								 bConstIterators, bUniqueKeys>                                        this_type;
+		typedef Key                                                                                   key_type;
+		typedef T                                                                                     value_type;
+		typedef Node                                                                                  node_type;
+		typedef Compare                                                                               key_compare;
+		typedef ExtractKey                                                                            extract_key;
+		typedef ptrdiff_t                                                                             difference_type;
+		typedef eastl_size_t                                                                          size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef value_type&                                                                           reference;
+		typedef const value_type&                                                                     const_reference;
+		typedef typename conditional<bConstIterators, intrusive_rbtree_iterator<T, Node, const T*, const T&>,
+													  intrusive_rbtree_iterator<T, Node, T*, T&> >::type  iterator;
+		typedef intrusive_rbtree_iterator<T, Node, const T*, const T&>                                const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                                     reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                                               const_reverse_iterator;
+		typedef typename conditional<bUniqueKeys, pair<iterator, bool>, iterator>::type               insert_return_type;
+
+		static_assert(is_base_of<intrusive_rbtree_node, Node>::value, "intrusive_rbtree Node must derive from intrusive_rbtree_node.");
+		static_assert(is_base_of<Node, T>::value, "intrusive_rbtree value_type must derive from its Node type.");
+
+	protected:
+		rbtree_node_base mAnchor;      // Its parent is the root, its left is the leftmost node and its right is the rightmost node. See rbtree.
+		eastl::compressed_pair<size_type, Compare> mSizeCompare; // Takes no space for the compare when it is empty.
+
+		size_type&       internalSize() EA_NOEXCEPT          { return mSizeCompare.first(); }
+		const size_type& internalSize() const EA_NOEXCEPT    { return mSizeCompare.first(); }
+		Compare&         internalCompare() EA_NOEXCEPT       { return mSizeCompare.second(); }
+		const Compare&   internalCompare() const EA_NOEXCEPT { return mSizeCompare.second(); }
+
+	public:
+		explicit intrusive_rbtree(const Compare& compare = Compare());
+
+		intrusive_rbtree(const this_type& x);               // Creates an empty tree; ignores the argument, as with intrusive_list.
+		this_type& operator=(const this_type& x);           // Leaves the tree as it is; ignores the argument, as with intrusive_list.
+
+		void swap(this_type& x);
+
+		iterator               begin() EA_NOEXCEPT         { return iterator(mAnchor.mpNodeLeft); }
+		const_iterator         begin() const EA_NOEXCEPT   { return const_iterator(mAnchor.mpNodeLeft); }
+		const_iterator         cbegin() const EA_NOEXCEPT  { return const_iterator(mAnchor.mpNodeLeft); }
+
+		iterator               end() EA_NOEXCEPT           { return iterator(&mAnchor); }
+		const_iterator         end() const EA_NOEXCEPT     { return const_iterator(&mAnchor); }
+		const_iterator         cend() const EA_NOEXCEPT    { return const_iterator(&mAnchor); }
+
+		reverse_iterator       rbegin() EA_NOEXCEPT        { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const EA_NOEXCEPT  { return const_reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const EA_NOEXCEPT { return const_reverse_iterator(end()); }
+
+		reverse_iterator       rend() EA_NOEXCEPT          { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const EA_NOEXCEPT    { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crend() const EA_NOEXCEPT   { return const_reverse_iterator(begin()); }
+
+		bool      empty() const EA_NOEXCEPT { return internalSize() == 0; }
+		size_type size() const EA_NOEXCEPT  { return internalSize(); }
+
+		const key_compare& key_comp() const { return internalCompare(); }
+
+	public:
+		/// Links value into the tree. Nothing is allocated. With unique keys, value isn't
+		/// linked if an object with an equal key is already present, and the returned
+		/// iterator refers to that object.
+		insert_return_type insert(value_type& value)
+			{ return DoInsertValue(value, integral_constant<bool, bUniqueKeys>()); }
+
+		/// As with std::set, position is a hint for where value goes: the object which will
+		/// follow it. If the hint is right the insertion doesn't search the tree.
+		iterator insert(const_iterator position, value_type& value);
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last); // The iterators must dereference to value_type&.
+
+		iterator  erase(const_iterator position);
+		iterator  erase(const_iterator first, const_iterator last);
+		size_type erase(const key_type& key);
+		iterator  remove(value_type& value);           // Removes by value instead of by iterator. This doesn't search the tree, due to this tree being 'intrusive'.
+
+		void clear(); // Unlinks every object in O(1). The objects' nodes are left as they are.
+
+		/// Returns an iterator to value, which must be in this tree. This is O(1),
+		/// and distinguishes between objects with equal keys.
+		iterator       locate(value_type& value);
+		const_iterator locate(const value_type& value) const;
+
+	public:
+		iterator       find(const key_type& key)       { return iterator(DoFind(key)); }
+		const_iterator find(const key_type& key) const { return const_iterator(DoFind(key)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       find(const KX& key)             { return iterator(DoFind(key)); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator find(const KX& key) const       { return const_iterator(DoFind(key)); }
+
+		bool contains(const key_type& key) const { return DoFind(key) != &mAnchor; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		bool contains(const KX& key) const { return DoFind(key) != &mAnchor; }
+
+		size_type count(const key_type& key) const { return DoCount(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return DoCount(key); }
+
+		iterator       lower_bound(const key_type& key)       { return iterator(DoLowerBound(key)); }
+		const_iterator lower_bound(const key_type& key) const { return const_iterator(DoLowerBound(key)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       lower_bound(const KX& key)             { return iterator(DoLowerBound(key)); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator lower_bound(const KX& key) const       { return const_iterator(DoLowerBound(key)); }
+
+		iterator       upper_bound(const key_type& key)       { return iterator(DoUpperBound(key)); }
+		const_iterator upper_bound(const key_type& key) const { return const_iterator(DoUpperBound(key)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       upper_bound(const KX& key)             { return iterator(DoUpperBound(key)); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator upper_bound(const KX& key) const       { return const_iterator(DoUpperBound(key)); }
+
+		eastl::pair<iterator, iterator>             equal_range(const key_type& key)       { return DoEqualRange<iterator>(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return DoEqualRange<const_iterator>(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key)             { return DoEqualRange<iterator>(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const       { return DoEqualRange<const_iterator>(key); }
+
+	public:
+		bool validate() const;
+		int  validate_iterator(const_iterator i) const;
+
+	protected:
+		static const key_type& DoGetKey(const rbtree_node_base* pNode)
+			{ return extract_key()(static_cast<const value_type&>(static_cast<const node_type&>(*pNode))); }
+
+		static rbtree_node_base* DoGetNode(const value_type& value)
+			{ return const_cast<node_type*>(static_cast<const node_type*>(&value)); }
+
+		void DoReset();
+		void DoLink(rbtree_node_base* pNode, rbtree_node_base* pNodeParent, RBTreeSide side);
+
+		pair<iterator, bool> DoInsertValue(value_type& value, true_type);
+		iterator             DoInsertValue(value_type& value, false_type);
+
+		static iterator DoGetIterator(const pair<iterator, bool>& result) { return result.first; }
+		static iterator DoGetIterator(const iterator& result)             { return result; }
+
+		template <typename KX> rbtree_node_base* DoLowerBound(const KX& key) const;
+		template <typename KX> rbtree_node_base* DoUpperBound(const KX& key) const;
+		template <typename KX> rbtree_node_base* DoFind(const KX& key) const;
+		template <typename KX> size_type         DoCount(const KX& key) const;
+
+		template <typename Iterator, typename KX>
+		eastl::pair<Iterator, Iterator> DoEqualRange(const KX& key) const;
+
+	}; // intrusive_rbtree
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// intrusive_rbtree
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline intrusive_rbtree<K, T, C, N, E, bC, bU>::intrusive_rbtree(const C& compare)
+		: mSizeCompare(0, compare)
+	{
+		DoReset();
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline intrusive_rbtree<K, T, C, N, E, bC, bU>::intrusive_rbtree(const this_type& x)
+		: mSizeCompare(0, x.internalCompare())
+	{
+		// We intentionally ignore the contents of x, as an object can only be in one tree per node.
+		DoReset();
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline typename intrusive_rbtree<K, T, C, N, E, bC, bU>::this_type&
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::operator=(const this_type& /*x*/)
+	{
+		// We intentionally ignore argument x. See the copy constructor.
+		return *this;
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline void intrusive_rbtree<K, T, C, N, E, bC, bU>::DoReset()
+	{
+		mAnchor.mpNodeRight = &mAnchor;
+		mAnchor.mpNodeLeft  = &mAnchor;
+		mAnchor.SetParentAndColor(NULL, kRBTreeColorRed); // The anchor is red so that RBTreeDecrement can tell it from the root.
+		internalSize()      = 0;
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	void intrusive_rbtree<K, T, C, N, E, bC, bU>::swap(this_type& x)
+	{
+		// The anchors are part of the containers, so we swap their contents and
+		// then point the roots back at their new anchors. See rbtree::swap.
+		eastl::swap(mAnchor.mpNodeRight, x.mAnchor.mpNodeRight);
+		eastl::swap(mAnchor.mpNodeLeft,  x.mAnchor.mpNodeLeft);
+
+		rbtree_node_base* const pRoot = mAnchor.GetParent();
+		mAnchor.SetParent(x.mAnchor.GetParent());
+		x.mAnchor.SetParent(pRoot);
+
+		if(mAnchor.GetParent())
+			mAnchor.GetParent()->SetParent(&mAnchor);
+		else
+			mAnchor.mpNodeRight = mAnchor.mpNodeLeft = &mAnchor;
+
+		if(x.mAnchor.GetParent())
+			x.mAnchor.GetParent()->SetParent(&x.mAnchor);
+		else
+			x.mAnchor.mpNodeRight = x.mAnchor.mpNodeLeft = &x.mAnchor;
+
+		eastl::swap(internalSize(),    x.internalSize());
+		eastl::swap(internalCompare(), x.internalCompare());
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline void intrusive_rbtree<K, T, C, N, E, bC, bU>::DoLink(rbtree_node_base* pNode, rbtree_node_base* pNodeParent, RBTreeSide side)
+	{
+		RBTreeInsert(pNode, pNodeParent, &mAnchor, side);
+		internalSize()++;
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	eastl::pair<typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator, bool>
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::DoInsertValue(value_type& value, true_type) // true_type means keys are unique.
+	{
+		// This is the same search as rbtree::DoGetKeyInsertionPositionUniqueKeys.
+		const key_type&   key                = extract_key()(value);
+		rbtree_node_base* pCurrent           = mAnchor.GetParent();
+		rbtree_node_base* pParent            = &mAnchor;
+		bool              bValueLessThanNode = true;
+
+		while(pCurrent)
+		{
+			bValueLessThanNode = internalCompare()(key, DoGetKey(pCurrent));
+			pParent            = pCurrent;
+			pCurrent           = bValueLessThanNode ? pCurrent->mpNodeLeft : pCurrent->mpNodeRight;
+		}
+
+		// pParent is now greater than key if bValueLessThanNode and not greater otherwise.
+		// The only node that can be equal to key is pParent or its predecessor.
+		rbtree_node_base* pLowerBound = pParent;
+
+		if(bValueLessThanNode)
+		{
+			if(pParent == mAnchor.mpNodeLeft) // If inserting at the front of the tree (or the tree is empty)...
+			{
+				DoLink(DoGetNode(value), pParent, kRBTreeSideLeft);
+				return pair<iterator, bool>(iterator(DoGetNode(value)), true);
+			}
+
+			pLowerBound = RBTreeDecrement(pParent);
+		}
+
+		if(internalCompare()(DoGetKey(pLowerBound), key))
+		{
+			DoLink(DoGetNode(value), pParent, bValueLessThanNode ? kRBTreeSideLeft : kRBTreeSideRight);
+			return pair<iterator, bool>(iterator(DoGetNode(value)), true);
+		}
+
+		return pair<iterator, bool>(iterator(pLowerBound), false);
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::DoInsertValue(value_type& value, false_type) // false_type means keys are not unique.
+	{
+		// Insert after any objects with equal keys, as multiset does.
+		const key_type&   key                = extract_key()(value);
+		rbtree_node_base* pCurrent           = mAnchor.GetParent();
+		rbtree_node_base* pParent            = &mAnchor;
+		bool              bValueLessThanNode = true;
+
+		while(pCurrent)
+		{
+			bValueLessThanNode = internalCompare()(key, DoGetKey(pCurrent));
+			pParent            = pCurrent;
+			pCurrent           = bValueLessThanNode ? pCurrent->mpNodeLeft : pCurrent->mpNodeRight;
+		}
+
+		DoLink(DoGetNode(value), pParent, bValueLessThanNode ? kRBTreeSideLeft : kRBTreeSideRight);
+		return iterator(DoGetNode(value));
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::insert(const_iterator position, value_type& value)
+	{
+		// The hint is right if value goes between the object before position and position itself:
+		// strictly between with unique keys, and after any equal keys before position with multiple keys.
+		const key_type&         key   = extract_key()(value);
+		rbtree_node_base* const pNext = position.mpNode;
+		rbtree_node_base* const pPrev = (pNext == mAnchor.mpNodeLeft) ? NULL : RBTreeDecrement(pNext);
+
+		const bool bBeforeNext  = (pNext == &mAnchor) || (bU ? internalCompare()(key, DoGetKey(pNext)) : !internalCompare()(DoGetKey(pNext), key));
+		const bool bAfterPrev   = !pPrev || (bU ? internalCompare()(DoGetKey(pPrev), key) : !internalCompare()(key, DoGetKey(pPrev)));
+
+		if(bBeforeNext && bAfterPrev)
+		{
+			// Link as the left child of pNext if that is free, otherwise as the right child of
+			// pPrev, which is the rightmost node of pNext's left subtree and so has no right child.
+			if(pNext == &mAnchor)
+			{
+				if(internalSize())
+					DoLink(DoGetNode(value), mAnchor.mpNodeRight, kRBTreeSideRight);
+				else
+					DoLink(DoGetNode(value), &mAnchor, kRBTreeSideLeft);
+			}
+			else if(!pNext->mpNodeLeft)
+				DoLink(DoGetNode(value), pNext, kRBTreeSideLeft);
+			else
+				DoLink(DoGetNode(value), pPrev, kRBTreeSideRight);
+
+			return iterator(DoGetNode(value));
+		}
+
+		// The hint was wrong, so we do a regular insertion.
+		return DoGetIterator(DoInsertValue(value, integral_constant<bool, bU>()));
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	template <typename InputIterator>
+	inline void intrusive_rbtree<K, T, C, N, E, bC, bU>::insert(InputIterator first, InputIterator last)
+	{
+		for(; first != last; ++first)
+			insert(*first);
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::erase(const_iterator position)
+	{
+		EASTL_ASSERT_MSG(position != end(), "intrusive_rbtree::erase: position must be dereferenceable.");
+
+		const iterator iErase(position.mpNode);
+		const iterator iNext(RBTreeIncrement(position.mpNode));
+
+		RBTreeErase(iErase.mpNode, &mAnchor);
+		--internalSize();
+		return iNext;
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::erase(const_iterator first, const_iterator last)
+	{
+		if((first.mpNode != mAnchor.mpNodeLeft) || (last.mpNode != &mAnchor)) // If not erasing the entire container...
+		{
+			while(first != last)
+				first = erase(first);
+			return iterator(first.mpNode);
+		}
+
+		clear();
+		return end();
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	typename intrusive_rbtree<K, T, C, N, E, bC, bU>::size_type
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::erase(const key_type& key)
+	{
+		const eastl::pair<iterator, iterator> range(equal_range(key));
+		const size_type n = internalSize();
+
+		erase(range.first, range.second);
+		return n - internalSize();
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::remove(value_type& value)
+	{
+		return erase(const_iterator(DoGetNode(value)));
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline void intrusive_rbtree<K, T, C, N, E, bC, bU>::clear()
+	{
+		// As with intrusive_list::clear, we don't touch the nodes of the objects.
+		DoReset();
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline typename intrusive_rbtree<K, T, C, N, E, bC, bU>::iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::locate(value_type& value)
+	{
+		return iterator(DoGetNode(value));
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline typename intrusive_rbtree<K, T, C, N, E, bC, bU>::const_iterator
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::locate(const value_type& value) const
+	{
+		return const_iterator(DoGetNode(value));
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	template <typename KX>
+	inline rbtree_node_base* intrusive_rbtree<K, T, C, N, E, bC, bU>::DoLowerBound(const KX& key) const
+	{
+		const rbtree_node_base* pCurrent    = mAnchor.GetParent();
+		const rbtree_node_base* pLowerBound = &mAnchor;
+
+		while(pCurrent)
+		{
+			if(!internalCompare()(DoGetKey(pCurrent), key)) // If pCurrent is >= key...
+			{
+				pLowerBound = pCurrent;
+				pCurrent    = pCurrent->mpNodeLeft;
+			}
+			else
+				pCurrent = pCurrent->mpNodeRight;
+		}
+
+		return const_cast<rbtree_node_base*>(pLowerBound);
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	template <typename KX>
+	inline rbtree_node_base* intrusive_rbtree<K, T, C, N, E, bC, bU>::DoUpperBound(const KX& key) const
+	{
+		const rbtree_node_base* pCurrent    = mAnchor.GetParent();
+		const rbtree_node_base* pUpperBound = &mAnchor;
+
+		while(pCurrent)
+		{
+			if(internalCompare()(key, DoGetKey(pCurrent))) // If key is < pCurrent...
+			{
+				pUpperBound = pCurrent;
+				pCurrent    = pCurrent->mpNodeLeft;
+			}
+			else
+				pCurrent = pCurrent->mpNodeRight;
+		}
+
+		return const_cast<rbtree_node_base*>(pUpperBound);
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	template <typename KX>
+	inline rbtree_node_base* intrusive_rbtree<K, T, C, N, E, bC, bU>::DoFind(const KX& key) const
+	{
+		rbtree_node_base* const pLowerBound = DoLowerBound(key);
+
+		if((pLowerBound != &mAnchor) && !internalCompare()(key, DoGetKey(pLowerBound)))
+			return pLowerBound;
+		return const_cast<rbtree_node_base*>(&mAnchor);
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	template <typename KX>
+	inline typename intrusive_rbtree<K, T, C, N, E, bC, bU>::size_type
+	intrusive_rbtree<K, T, C, N, E, bC, bU>::DoCount(const KX& key) const
+	{
+		if(bU)
+			return (DoFind(key) != &mAnchor) ? 1 : 0;
+
+		const eastl::pair<const_iterator, const_iterator> range(DoEqualRange<const_iterator>(key));
+		return (size_type)eastl::distance(range.first, range.second);
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	template <typename Iterator, typename KX>
+	inline eastl::pair<Iterator, Iterator> intrusive_rbtree<K, T, C, N, E, bC, bU>::DoEqualRange(const KX& key) const
+	{
+		const Iterator itLower(DoLowerBound(key));
+
+		if(bU) // With unique keys the range is empty or holds the one object at the lower bound.
+		{
+			if((itLower.mpNode != &mAnchor) && !internalCompare()(key, DoGetKey(itLower.mpNode)))
+			{
+				Iterator itUpper(itLower);
+				return eastl::pair<Iterator, Iterator>(itLower, ++itUpper);
+			}
+			return eastl::pair<Iterator, Iterator>(itLower, itLower);
+		}
+
+		return eastl::pair<Iterator, Iterator>(itLower, Iterator(DoUpperBound(key)));
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	bool intrusive_rbtree<K, T, C, N, E, bC, bU>::validate() const
+	{
+		// Verifies the same red-black tree properties as rbtree::validate, along with the
+		// ordering of the keys and the size.
+		if(internalSize() == 0)
+			return (mAnchor.mpNodeLeft == &mAnchor) && (mAnchor.mpNodeRight == &mAnchor) && (mAnchor.GetParent() == NULL);
+
+		const rbtree_node_base* const pRoot = mAnchor.GetParent();
+
+		if(!pRoot || (pRoot->GetParent() != &mAnchor) || (pRoot->GetColor() != kRBTreeColorBlack))
+			return false;
+		if((mAnchor.mpNodeLeft != RBTreeGetMinChild(pRoot)) || (mAnchor.mpNodeRight != RBTreeGetMaxChild(pRoot)))
+			return false;
+
+		const size_t nLeftmostBlackCount = RBTreeGetBlackCount(pRoot, mAnchor.mpNodeLeft);
+		size_type    nIteratedSize       = 0;
+
+		for(const_iterator it = begin(); it != end(); ++it, ++nIteratedSize)
+		{
+			const rbtree_node_base* const pNode  = it.mpNode;
+			const rbtree_node_base* const pLeft  = pNode->mpNodeLeft;
+			const rbtree_node_base* const pRight = pNode->mpNodeRight;
+
+			if((pLeft && (pLeft->GetParent() != pNode)) || (pRight && (pRight->GetParent() != pNode)))
+				return false;
+
+			if(pNode->GetColor() == kRBTreeColorRed) // A red node must not have a red child.
+			{
+				if((pLeft && (pLeft->GetColor() == kRBTreeColorRed)) || (pRight && (pRight->GetColor() == kRBTreeColorRed)))
+					return false;
+			}
+
+			if(pLeft && internalCompare()(DoGetKey(pNode), DoGetKey(pLeft)))
+				return false;
+			if(pRight && internalCompare()(DoGetKey(pRight), DoGetKey(pNode)))
+				return false;
+
+			if(bU) // With unique keys the successor must be strictly greater.
+			{
+				const_iterator itNext(it);
+				if((++itNext != end()) && !internalCompare()(DoGetKey(pNode), DoGetKey(itNext.mpNode)))
+					return false;
+			}
+
+			if(!pLeft && !pRight && (RBTreeGetBlackCount(pRoot, pNode) != nLeftmostBlackCount)) // Every leaf must have the same black height.
+				return false;
+		}
+
+		return nIteratedSize == internalSize();
+	}
+
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	int intrusive_rbtree<K, T, C, N, E, bC, bU>::validate_iterator(const_iterator i) const
+	{
+		// To do: Come up with a more efficient mechanism of doing this.
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename C, typename N, typename E, bool bC, bool bU>
+	inline void swap(intrusive_rbtree<K, T, C, N, E, bC, bU>& a, intrusive_rbtree<K, T, C, N, E, bC, bU>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -100,10 +100,34 @@ namespace eastl
 	public:
 		this_type* mpNodeRight;  // Declared first because it is used most often.
 		this_type* mpNodeLeft;
+	#if EASTL_RBTREE_PACKED_COLOR
+		uintptr_t  mParentAndColor; // The parent pointer, with the RBTreeColor in the low bit. See EASTL_RBTREE_PACKED_COLOR.
+	#else
 		this_type* mpNodeParent;
-		char       mColor;       // We only need one bit here, would be nice if we could stuff that bit somewhere else.
+		char       mColor;
+	#endif
+
+	public:
+		#if EASTL_RBTREE_PACKED_COLOR
+			this_type* GetParent() const                                  { return reinterpret_cast<this_type*>(mParentAndColor & ~(uintptr_t)1); }
+			void       SetParent(this_type* pParent)                      { mParentAndColor = reinterpret_cast<uintptr_t>(pParent) | (mParentAndColor & 1); }
+			char       GetColor() const                                   { return (char)(mParentAndColor & 1); }
+			void       SetColor(char color)                               { mParentAndColor = (mParentAndColor & ~(uintptr_t)1) | (uintptr_t)color; }
+			void       SetParentAndColor(this_type* pParent, char color)  { mParentAndColor = reinterpret_cast<uintptr_t>(pParent) | (uintptr_t)color; }
+		#else
+			this_type* GetParent() const                                  { return mpNodeParent; }
+			void       SetParent(this_type* pParent)                      { mpNodeParent = pParent; }
+			char       GetColor() const                                   { return mColor; }
+			void       SetColor(char color)                               { mColor = color; }
+			void       SetParentAndColor(this_type* pParent, char color)  { mpNodeParent = pParent; mColor = color; }
+		#endif
 	};
 
+	#if EASTL_RBTREE_PACKED_COLOR
+		static_assert((kRBTreeColorRed == 0) && (kRBTreeColorBlack == 1), "RBTreeColor must fit in the low bit of the parent pointer.");
+		static_assert(EA_ALIGN_OF(rbtree_node_base) >= 2, "rbtree_node_base must be aligned enough to leave the low pointer bit free.");
+	#endif
+
 
 	/// rbtree_node
 	///
@@ -122,6 +146,48 @@ namespace eastl
 	};
 
 
+	/// rbtree_ranked_node_base
+	///
+	/// The node base of order statistic trees (rbtree with bRanked set), which is what 
+	/// ranked_map and ranked_set are built on. Each node also records the number of nodes 
+	/// in the subtree it roots. The RBTreeRanked functions below keep the counts up to date 
+	/// through insertion, erasure and every rotation, which is what gives these trees 
+	/// O(log n) access by position and rank. Trees of plain rbtree_node_base nodes don't 
+	/// carry the count and never run any of this code.
+	///
+	struct rbtree_ranked_node_base : public rbtree_node_base
+	{
+		size_t mnSubtreeSize;
+	};
+
+
+	/// rbtree_ranked_node
+	///
+	template <typename Value>
+	struct rbtree_ranked_node : public rbtree_ranked_node_base
+	{
+		Value mValue;
+
+		#if defined(_MSC_VER)
+			rbtree_ranked_node(const rbtree_ranked_node&) = delete;
+		#endif
+	};
+
+
+	/// rbtree_subtree
+	///
+	/// A red-black tree that is detached from any rbtree anchor, along with its black height:
+	/// the number of black nodes on every path from its root down to a leaf. The parent 
+	/// pointer of the root is unspecified. This is what the join and split operations that 
+	/// rbtree::merge, intersect and subtract are built on work with.
+	///
+	struct rbtree_subtree
+	{
+		rbtree_node_base* mpRoot;
+		size_t            mnBlackHeight;
+	};
+
+
 
 
 	// rbtree_node_base functions
@@ -141,7 +207,49 @@ namespace eastl
 														  rbtree_node_base* pNodeAnchor,
 														  RBTreeSide insertionSide);
 	EASTL_API void              RBTreeErase        (      rbtree_node_base* pNode,
-														  rbtree_node_base* pNodeAnchor); 
+														  rbtree_node_base* pNodeAnchor);
+	EASTL_API rbtree_subtree    RBTreeJoin         (rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right);
+	EASTL_API rbtree_subtree    RBTreeJoin2        (rbtree_subtree left, rbtree_subtree right); 
+
+	// Versions of the above for trees of rbtree_ranked_node_base, which also maintain the subtree sizes.
+	EASTL_API void              RBTreeRankedInsert (      rbtree_node_base* pNode,
+														  rbtree_node_base* pNodeParent, 
+														  rbtree_node_base* pNodeAnchor,
+														  RBTreeSide insertionSide);
+	EASTL_API void              RBTreeRankedErase  (      rbtree_node_base* pNode,
+														  rbtree_node_base* pNodeAnchor);
+	EASTL_API rbtree_subtree    RBTreeRankedJoin   (rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right);
+	EASTL_API rbtree_subtree    RBTreeRankedJoin2  (rbtree_subtree left, rbtree_subtree right); 
+	EASTL_API rbtree_node_base* RBTreeRankedGetNth (const rbtree_node_base* pNodeRoot, size_t n);
+	EASTL_API size_t            RBTreeRankedGetIndex(const rbtree_node_base* pNode, const rbtree_node_base* pNodeAnchor);
+
+
+	/// RBTreeGetSubtreeSize
+	/// Returns the number of nodes in the subtree at pNode, which must be NULL or an rbtree_ranked_node_base.
+	///
+	inline size_t RBTreeGetSubtreeSize(const rbtree_node_base* pNode)
+	{
+		return pNode ? static_cast<const rbtree_ranked_node_base*>(pNode)->mnSubtreeSize : 0;
+	}
+
+	inline void RBTreeSetSubtreeSize(rbtree_node_base* pNode, size_t n)
+	{
+		static_cast<rbtree_ranked_node_base*>(pNode)->mnSubtreeSize = n;
+	}
+
+
+	/// RBTreeExpose
+	/// Splits a non-empty subtree into the subtrees under its root.
+	///
+	inline void RBTreeExpose(const rbtree_subtree& tree, rbtree_subtree& left, rbtree_subtree& right)
+	{
+		const size_t nChildHeight = tree.mnBlackHeight - ((tree.mpRoot->GetColor() == kRBTreeColorBlack) ? 1 : 0);
+
+		left.mpRoot         = tree.mpRoot->mpNodeLeft;
+		left.mnBlackHeight  = nChildHeight;
+		right.mpRoot        = tree.mpRoot->mpNodeRight;
+		right.mnBlackHeight = nChildHeight;
+	}
 
 
 
@@ -151,17 +259,19 @@ namespace eastl
 
 	/// rbtree_iterator
 	///
-	template <typename T, typename Pointer, typename Reference>
+	/// Node is the type of the tree's nodes, which is rbtree_ranked_node<T> for ranked trees.
+	///
+	template <typename T, typename Pointer, typename Reference, typename Node = rbtree_node<T> >
 	struct rbtree_iterator
 	{
-		typedef rbtree_iterator<T, Pointer, Reference>      this_type;
-		typedef rbtree_iterator<T, T*, T&>                  iterator;
-		typedef rbtree_iterator<T, const T*, const T&>      const_iterator;
+		typedef rbtree_iterator<T, Pointer, Reference, Node> this_type;
+		typedef rbtree_iterator<T, T*, T&, Node>             iterator;
+		typedef rbtree_iterator<T, const T*, const T&, Node> const_iterator;
 		typedef eastl_size_t                                size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
 		typedef ptrdiff_t                                   difference_type;
 		typedef T                                           value_type;
 		typedef rbtree_node_base                            base_node_type;
-		typedef rbtree_node<T>                              node_type;
+		typedef Node                                        node_type;
 		typedef Pointer                                     pointer;
 		typedef Reference                                   reference;
 		typedef eastl::bidirectional_iterator_tag    iterator_category;
@@ -188,18 +298,18 @@ namespace eastl
 		rbtree_iterator  operator--(int);
 	private:
 
-		template<class U, class PtrA, class RefA, class PtrB, class RefB>
-		friend bool operator==(const rbtree_iterator<U, PtrA, RefA>&, const rbtree_iterator<U, PtrB, RefB>&);
+		template<class U, class PtrA, class RefA, class PtrB, class RefB, class N>
+		friend bool operator==(const rbtree_iterator<U, PtrA, RefA, N>&, const rbtree_iterator<U, PtrB, RefB, N>&);
 
-		template<class U, class PtrA, class RefA, class PtrB, class RefB>
-		friend bool operator!=(const rbtree_iterator<U, PtrA, RefA>&, const rbtree_iterator<U, PtrB, RefB>&);
+		template<class U, class PtrA, class RefA, class PtrB, class RefB, class N>
+		friend bool operator!=(const rbtree_iterator<U, PtrA, RefA, N>&, const rbtree_iterator<U, PtrB, RefB, N>&);
 
-		template<class U, class PtrA, class RefA>
-		friend bool operator!=(const rbtree_iterator<U, PtrA, RefA>&, const rbtree_iterator<U, PtrA, RefA>&);
+		template<class U, class PtrA, class RefA, class N>
+		friend bool operator!=(const rbtree_iterator<U, PtrA, RefA, N>&, const rbtree_iterator<U, PtrA, RefA, N>&);
 
 		// rbtree uses mpNode.
 		template <class Key, class Value, class Compare, class Allocator,
-				  class ExtractKey, bool bMutableIterators, bool bUniqueKeys>
+				  class ExtractKey, bool bMutableIterators, bool bUniqueKeys, bool bRanked>
 		friend class rbtree;
 
 		// for the "copy" constructor, which uses non-const iterator even in the
@@ -371,10 +481,11 @@ namespace eastl
 	///
 	/// The primary rbtree member variable is mAnchor, which is a node_type and 
 	/// acts as the end node. However, like any other node, it has mpNodeLeft,
-	/// mpNodeRight, and mpNodeParent members. We do the conventional trick of 
+	/// mpNodeRight, and parent links. We do the conventional trick of 
 	/// assigning begin() (left-most rbtree node) to mpNodeLeft, assigning 
 	/// 'end() - 1' (a.k.a. rbegin()) to mpNodeRight, and assigning the tree root
-	/// node to mpNodeParent. 
+	/// node to the parent link (see GetParent). The anchor is always red, which 
+	/// is how RBTreeDecrement tells it apart from the (always black) root.
 	///
 	/// Compare (functor): This is a comparison class which defaults to 'less'.
 	/// It is a common STL thing which takes two arguments and returns true if  
@@ -428,26 +539,27 @@ namespace eastl
 	/// for more documentation on this.
 	///
 	template <typename Key, typename Value, typename Compare, typename Allocator, 
-			  typename ExtractKey, bool bMutableIterators, bool bUniqueKeys>
+			  typename ExtractKey, bool bMutableIterators, bool bUniqueKeys, bool bRanked = false>
 	class rbtree
 		: public rb_base<Key, Value, Compare, ExtractKey, bUniqueKeys, 
-							rbtree<Key, Value, Compare, Allocator, ExtractKey, bMutableIterators, bUniqueKeys> >
+							rbtree<Key, Value, Compare, Allocator, ExtractKey, bMutableIterators, bUniqueKeys, bRanked> >
 	{
 	public:
 		typedef ptrdiff_t                                                                       difference_type;
 		typedef eastl_size_t                                                                    size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
 		typedef Key                                                                             key_type;
 		typedef Value                                                                           value_type;
-		typedef rbtree_node<value_type>                                                         node_type;
+		typedef typename conditional<bRanked,
+					rbtree_ranked_node<value_type>, rbtree_node<value_type> >::type             node_type;     // Ranked trees store subtree sizes in their nodes.
 		typedef value_type&                                                                     reference;
 		typedef const value_type&                                                               const_reference;
 		typedef value_type*                                                                     pointer;
 		typedef const value_type*                                                               const_pointer;
 
 		typedef typename conditional<bMutableIterators,
-					rbtree_iterator<value_type, value_type*, value_type&>, 
-					rbtree_iterator<value_type, const value_type*, const value_type&> >::type   iterator;
-		typedef rbtree_iterator<value_type, const value_type*, const value_type&>               const_iterator;
+					rbtree_iterator<value_type, value_type*, value_type&, node_type>, 
+					rbtree_iterator<value_type, const value_type*, const value_type&, node_type> >::type iterator;
+		typedef rbtree_iterator<value_type, const value_type*, const value_type&, node_type>    const_iterator;
 		typedef eastl::reverse_iterator<iterator>                                               reverse_iterator;
 		typedef eastl::reverse_iterator<const_iterator>                                         const_reverse_iterator;
 
@@ -455,7 +567,7 @@ namespace eastl
 		typedef Compare                                                                         key_compare;
 		typedef typename conditional<bUniqueKeys, eastl::pair<iterator, bool>, iterator>::type  insert_return_type;  // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
 		typedef rbtree<Key, Value, Compare, Allocator, 
-						ExtractKey, bMutableIterators, bUniqueKeys>                             this_type;
+						ExtractKey, bMutableIterators, bUniqueKeys, bRanked>                    this_type;
 		typedef rb_base<Key, Value, Compare, ExtractKey, bUniqueKeys, this_type>                base_type;
 		typedef integral_constant<bool, bUniqueKeys>                                            has_unique_keys_type;
 		typedef typename base_type::extract_key                                                 extract_key;
@@ -498,6 +610,14 @@ namespace eastl
 
 		void swap(this_type& x);
 
+		// Set operations. These split and join whole subtrees instead of going element by element, 
+		// so for trees of m and n elements with m <= n they run in O(m log(n/m + 1)) time. They relink 
+		// existing nodes and never allocate. The comparison function must not throw while they run.
+		void merge(this_type& source);      // Moves the elements of source into this container. As with std::map::merge, with unique keys an element whose key is already present stays in source.
+		void merge(this_type&& source);
+		void intersect(const this_type& x); // Erases every element whose key isn't present in x.
+		void subtract(const this_type& x);  // Erases every element whose key is present in x.
+
 	public: 
 		// iterators
 		iterator        begin() EA_NOEXCEPT;
@@ -629,9 +749,58 @@ namespace eastl
 		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
 		const_iterator upper_bound(const KX& key) const { return DoUpperBound(key); }
 
+		/// Hinted lookups (finger search). These search outward from hint instead of down from
+		/// the root: they climb from hint until they reach a subtree that must hold the result and
+		/// then search down that subtree. The cost is proportional to the height of that subtree,
+		/// which is O(log d) for a key at a distance of d elements from hint in typical use. This
+		/// helps when probing with keys that are near each other, such as monotonically
+		/// increasing keys, where each result makes a good hint for the next lookup. Any
+		/// iterator into the container, including end(), is a valid hint; a poor hint costs at
+		/// most twice the height of the tree.
+		///
+		/// Example usage:
+		///     map<int, Event>::iterator it = events.begin();
+		///     for(int t = tBegin; t < tEnd; t += tStep)
+		///         it = events.lower_bound(it, t);
+		///
+		iterator       find(const_iterator hint, const key_type& key) { return DoFindHint(hint, key); }
+		const_iterator find(const_iterator hint, const key_type& key) const { return DoFindHint(hint, key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       find(const_iterator hint, const KX& key) { return DoFindHint(hint, key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator find(const_iterator hint, const KX& key) const { return DoFindHint(hint, key); }
+
+		iterator       lower_bound(const_iterator hint, const key_type& key) { return iterator(DoGetBoundHint(hint, key, false)); }
+		const_iterator lower_bound(const_iterator hint, const key_type& key) const { return const_iterator(DoGetBoundHint(hint, key, false)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       lower_bound(const_iterator hint, const KX& key) { return iterator(DoGetBoundHint(hint, key, false)); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator lower_bound(const_iterator hint, const KX& key) const { return const_iterator(DoGetBoundHint(hint, key, false)); }
+
+		iterator       upper_bound(const_iterator hint, const key_type& key) { return iterator(DoGetBoundHint(hint, key, true)); }
+		const_iterator upper_bound(const_iterator hint, const key_type& key) const { return const_iterator(DoGetBoundHint(hint, key, true)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator       upper_bound(const_iterator hint, const KX& key) { return iterator(DoGetBoundHint(hint, key, true)); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const_iterator upper_bound(const_iterator hint, const KX& key) const { return const_iterator(DoGetBoundHint(hint, key, true)); }
+
 		bool validate() const;
 		int  validate_iterator(const_iterator i) const;
 
+	protected:
+		// Order statistics. These are available only for ranked trees, which keep the size of each 
+		// subtree in its root node, and run in O(log n) time. ranked_map and ranked_set make them public.
+		iterator       nth(size_type n);                          // Returns the element at index n in sorted order, or end() if n >= size().
+		const_iterator nth(size_type n) const;
+		size_type      rank(const key_type& key) const { return DoRank(key); } // Returns the number of elements whose key is less than key.
+		size_type      index_of(const_iterator position) const;   // Returns the index of position in sorted order. end() has index size().
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type      rank(const KX& key) const { return DoRank(key); }
+
 	protected:
 		node_type* DoAllocateNode();
 		void       DoFreeNode(node_type* pNode);
@@ -645,7 +814,26 @@ namespace eastl
 		node_type* DoCreateNode(const node_type* pNodeSource, rbtree_node_base* pNodeParent);
 
 		rbtree_node_base* DoCopySubtree(const node_type* pNodeSource, rbtree_node_base* pNodeDest);
-		void       DoNukeSubtree(rbtree_node_base* pNode);
+		size_type  DoNukeSubtree(rbtree_node_base* pNode);
+
+		template <typename InputIterator>
+		InputIterator DoBuildSortedPrefix(InputIterator first, InputIterator last);
+		void       DoBuildSortedTree(node_type* pNodeChain, size_type n);
+		node_type* DoBuildSortedSubtree(node_type*& pNodeChain, size_type n, size_type nDepth, size_type nRedDepth);
+
+		rbtree_subtree DoDetachTree();
+		void           DoAttachTree(rbtree_node_base* pNodeRoot, size_type n);
+		void           DoSplit(rbtree_subtree tree, const key_type& key, rbtree_subtree& less, rbtree_subtree& equal, rbtree_subtree& greater);
+		void           DoSplitUpper(rbtree_subtree tree, const key_type& key, rbtree_subtree& lessEqual, rbtree_subtree& greater);
+		rbtree_subtree DoMerge(rbtree_subtree tree, rbtree_subtree source, rbtree_node_base**& ppLeftoverNext, size_type& nLeftoverCount);
+		rbtree_subtree DoIntersect(rbtree_subtree tree, const rbtree_node_base* pNodeOther, size_type& nFreedCount);
+		rbtree_subtree DoSubtract(rbtree_subtree tree, const rbtree_node_base* pNodeOther, size_type& nFreedCount);
+
+		// These forward to the RBTree functions, using the versions that maintain subtree sizes for ranked trees.
+		void           DoRebalanceAfterInsert(rbtree_node_base* pNode, rbtree_node_base* pNodeParent, RBTreeSide side);
+		void           DoRebalanceForErase(rbtree_node_base* pNode);
+		static rbtree_subtree DoJoin(rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right);
+		static rbtree_subtree DoJoin2(rbtree_subtree left, rbtree_subtree right);
 
 		template <class... Args>
 		eastl::pair<iterator, bool> DoInsertValue(true_type, Args&&... args);
@@ -684,6 +872,9 @@ namespace eastl
 		rbtree_node_base* DoGetKeyInsertionPositionUniqueKeysHint(const_iterator position, bool& bForceToLeft, const KX& key);
 		rbtree_node_base* DoGetKeyInsertionPositionNonuniqueKeysHint(const_iterator position, bool& bForceToLeft, const key_type& key);
 
+		template <typename KX>
+		rbtree_node_base* DoGetKeyInsertionPositionFinger(const_iterator position, bool& canInsert, bool& bForceToLeft, const KX& key);
+
 		template<typename KX, typename M>
 		pair<iterator, bool>	DoInsertOrAssign(KX&& k, M&& obj);
 		template<typename KX, typename M>
@@ -707,6 +898,18 @@ namespace eastl
 		template<typename KX>
 		const_iterator DoUpperBound(const KX& key) const;
 
+		template<typename KX>
+		bool DoIsInBound(const rbtree_node_base* pNode, const KX& key, bool bUpperBound) const;
+
+		template<typename KX>
+		rbtree_node_base* DoGetBoundHint(const_iterator hint, const KX& key, bool bUpperBound) const;
+
+		template<typename KX>
+		iterator DoFindHint(const_iterator hint, const KX& key) const;
+
+		template<typename KX>
+		size_type DoRank(const KX& key) const;
+
 	}; // rbtree
 
 
@@ -740,56 +943,56 @@ namespace eastl
 	// rbtree_iterator functions
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename T, typename Pointer, typename Reference>
-	rbtree_iterator<T, Pointer, Reference>::rbtree_iterator()
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	rbtree_iterator<T, Pointer, Reference, Node>::rbtree_iterator()
 		: mpNode(NULL) { }
 
 
-	template <typename T, typename Pointer, typename Reference>
-	rbtree_iterator<T, Pointer, Reference>::rbtree_iterator(const base_node_type* pNode)
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	rbtree_iterator<T, Pointer, Reference, Node>::rbtree_iterator(const base_node_type* pNode)
 		: mpNode(const_cast<base_node_type*>(pNode)) { }
 
 
-	template <typename T, typename Pointer, typename Reference>
-	rbtree_iterator<T, Pointer, Reference>::rbtree_iterator(const iterator& x)
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	rbtree_iterator<T, Pointer, Reference, Node>::rbtree_iterator(const iterator& x)
 		: mpNode(x.mpNode) { }
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::this_type&
-	rbtree_iterator<T, Pointer, Reference>::operator=(const iterator& x)
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::this_type&
+	rbtree_iterator<T, Pointer, Reference, Node>::operator=(const iterator& x)
 	{
 		mpNode = x.mpNode;
 		return *this;
 	}
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::reference
-	rbtree_iterator<T, Pointer, Reference>::operator*() const
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::reference
+	rbtree_iterator<T, Pointer, Reference, Node>::operator*() const
 	{
 		return static_cast<node_type*>(mpNode)->mValue;
 	}
 
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::pointer
-	rbtree_iterator<T, Pointer, Reference>::operator->() const
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::pointer
+	rbtree_iterator<T, Pointer, Reference, Node>::operator->() const
 	{
 		return &static_cast<node_type*>(mpNode)->mValue;
 	}
 
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::this_type&
-	rbtree_iterator<T, Pointer, Reference>::operator++()
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::this_type&
+	rbtree_iterator<T, Pointer, Reference, Node>::operator++()
 	{
 		mpNode = RBTreeIncrement(mpNode);
 		return *this;
 	}
 
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::this_type
-	rbtree_iterator<T, Pointer, Reference>::operator++(int)
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::this_type
+	rbtree_iterator<T, Pointer, Reference, Node>::operator++(int)
 	{
 		this_type temp(*this);
 		mpNode = RBTreeIncrement(mpNode);
@@ -797,18 +1000,18 @@ namespace eastl
 	}
 
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::this_type&
-	rbtree_iterator<T, Pointer, Reference>::operator--()
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::this_type&
+	rbtree_iterator<T, Pointer, Reference, Node>::operator--()
 	{
 		mpNode = RBTreeDecrement(mpNode);
 		return *this;
 	}
 
 
-	template <typename T, typename Pointer, typename Reference>
-	typename rbtree_iterator<T, Pointer, Reference>::this_type
-	rbtree_iterator<T, Pointer, Reference>::operator--(int)
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	typename rbtree_iterator<T, Pointer, Reference, Node>::this_type
+	rbtree_iterator<T, Pointer, Reference, Node>::operator--(int)
 	{
 		this_type temp(*this);
 		mpNode = RBTreeDecrement(mpNode);
@@ -819,17 +1022,17 @@ namespace eastl
 	// The C++ defect report #179 requires that we support comparisons between const and non-const iterators.
 	// Thus we provide additional template paremeters here to support this. The defect report does not
 	// require us to support comparisons between reverse_iterators and const_reverse_iterators.
-	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
-	inline bool operator==(const rbtree_iterator<T, PointerA, ReferenceA>& a, 
-						   const rbtree_iterator<T, PointerB, ReferenceB>& b)
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, typename Node>
+	inline bool operator==(const rbtree_iterator<T, PointerA, ReferenceA, Node>& a, 
+						   const rbtree_iterator<T, PointerB, ReferenceB, Node>& b)
 	{
 		return a.mpNode == b.mpNode;
 	}
 
 
-	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB>
-	inline bool operator!=(const rbtree_iterator<T, PointerA, ReferenceA>& a, 
-						   const rbtree_iterator<T, PointerB, ReferenceB>& b)
+	template <typename T, typename PointerA, typename ReferenceA, typename PointerB, typename ReferenceB, typename Node>
+	inline bool operator!=(const rbtree_iterator<T, PointerA, ReferenceA, Node>& a, 
+						   const rbtree_iterator<T, PointerB, ReferenceB, Node>& b)
 	{
 		return a.mpNode != b.mpNode;
 	}
@@ -837,9 +1040,9 @@ namespace eastl
 
 	// We provide a version of operator!= for the case where the iterators are of the 
 	// same type. This helps prevent ambiguity errors in the presence of rel_ops.
-	template <typename T, typename Pointer, typename Reference>
-	inline bool operator!=(const rbtree_iterator<T, Pointer, Reference>& a, 
-						   const rbtree_iterator<T, Pointer, Reference>& b)
+	template <typename T, typename Pointer, typename Reference, typename Node>
+	inline bool operator!=(const rbtree_iterator<T, Pointer, Reference, Node>& a, 
+						   const rbtree_iterator<T, Pointer, Reference, Node>& b)
 	{
 		return a.mpNode != b.mpNode;
 	}
@@ -851,8 +1054,8 @@ namespace eastl
 	// rbtree functions
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree()
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree()
 		: mAnchor(),
 		  mnSize(0),
 		  mAllocator(EASTL_RBTREE_DEFAULT_NAME)
@@ -861,8 +1064,8 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree(const allocator_type& allocator)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree(const allocator_type& allocator)
 		: mAnchor(),
 		  mnSize(0),
 		  mAllocator(allocator)
@@ -871,8 +1074,8 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree(const C& compare, const allocator_type& allocator)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree(const C& compare, const allocator_type& allocator)
 		: base_type(compare),
 		  mAnchor(),
 		  mnSize(0),
@@ -882,8 +1085,8 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree(const this_type& x)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree(const this_type& x)
 		: base_type(x.get_compare()),
 		  mAnchor(),
 		  mnSize(0),
@@ -891,18 +1094,18 @@ namespace eastl
 	{
 		reset_lose_memory();
 
-		if(x.mAnchor.mpNodeParent) // mAnchor.mpNodeParent is the rb_tree root node.
+		if(x.mAnchor.GetParent()) // mAnchor.GetParent() is the rb_tree root node.
 		{
-			mAnchor.mpNodeParent = DoCopySubtree((const node_type*)x.mAnchor.mpNodeParent, &mAnchor);
-			mAnchor.mpNodeRight  = RBTreeGetMaxChild(mAnchor.mpNodeParent);
-			mAnchor.mpNodeLeft   = RBTreeGetMinChild(mAnchor.mpNodeParent);
+			mAnchor.SetParent(DoCopySubtree((const node_type*)x.mAnchor.GetParent(), &mAnchor));
+			mAnchor.mpNodeRight  = RBTreeGetMaxChild(mAnchor.GetParent());
+			mAnchor.mpNodeLeft   = RBTreeGetMinChild(mAnchor.GetParent());
 			mnSize               = x.mnSize;
 		}
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree(this_type&& x)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree(this_type&& x)
 		: base_type(x.get_compare()),
 		  mAnchor(),
 		  mnSize(0),
@@ -912,8 +1115,8 @@ namespace eastl
 		swap(x);
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree(this_type&& x, const allocator_type& allocator)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree(this_type&& x, const allocator_type& allocator)
 		: base_type(x.get_compare()),
 		  mAnchor(),
 		  mnSize(0),
@@ -924,9 +1127,9 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename InputIterator>
-	inline rbtree<K, V, C, A, E, bM, bU>::rbtree(InputIterator first, InputIterator last, const C& compare, const allocator_type& allocator)
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::rbtree(InputIterator first, InputIterator last, const C& compare, const allocator_type& allocator)
 		: base_type(compare),
 		  mAnchor(),
 		  mnSize(0),
@@ -938,8 +1141,7 @@ namespace eastl
 			try
 			{
 		#endif
-				for(; first != last; ++first)
-					insert(*first);
+				insert(first, last);
 		#if EASTL_EXCEPTIONS_ENABLED
 			}
 			catch(...)
@@ -951,33 +1153,33 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline rbtree<K, V, C, A, E, bM, bU>::~rbtree()
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree<K, V, C, A, E, bM, bU, bR>::~rbtree()
 	{
 		// Erase the entire tree. DoNukeSubtree is not a 
 		// conventional erase function, as it does no rebalancing.
-		DoNukeSubtree((node_type*)mAnchor.mpNodeParent);
+		DoNukeSubtree((node_type*)mAnchor.GetParent());
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline const typename rbtree<K, V, C, A, E, bM, bU>::allocator_type&
-	rbtree<K, V, C, A, E, bM, bU>::get_allocator() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline const typename rbtree<K, V, C, A, E, bM, bU, bR>::allocator_type&
+	rbtree<K, V, C, A, E, bM, bU, bR>::get_allocator() const EA_NOEXCEPT
 	{
 		return mAllocator;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::allocator_type&
-	rbtree<K, V, C, A, E, bM, bU>::get_allocator() EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::allocator_type&
+	rbtree<K, V, C, A, E, bM, bU, bR>::get_allocator() EA_NOEXCEPT
 	{
 		return mAllocator;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline void rbtree<K, V, C, A, E, bM, bU>::set_allocator(const allocator_type& allocator)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::set_allocator(const allocator_type& allocator)
 	{
 		if(mnSize > 0 && mAllocator != allocator)
 			EASTL_THROW_MSG_OR_ASSERT(std::logic_error, "rbtree::set_allocator -- cannot change allocator after allocations have been made.");
@@ -985,92 +1187,92 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::size_type
-	rbtree<K, V, C, A, E, bM, bU>::size() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::size_type
+	rbtree<K, V, C, A, E, bM, bU, bR>::size() const EA_NOEXCEPT
 		{ return mnSize; }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline bool rbtree<K, V, C, A, E, bM, bU>::empty() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline bool rbtree<K, V, C, A, E, bM, bU, bR>::empty() const EA_NOEXCEPT
 		{ return (mnSize == 0); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::begin() EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::begin() EA_NOEXCEPT
 		{ return iterator(mAnchor.mpNodeLeft); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::begin() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::begin() const EA_NOEXCEPT
 		{ return const_iterator(mAnchor.mpNodeLeft); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::cbegin() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::cbegin() const EA_NOEXCEPT
 		{ return const_iterator(mAnchor.mpNodeLeft); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::end() EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::end() EA_NOEXCEPT
 		{ return iterator(&mAnchor); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::end() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::end() const EA_NOEXCEPT
 		{ return const_iterator(&mAnchor); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::cend() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::cend() const EA_NOEXCEPT
 		{ return const_iterator(&mAnchor); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::rbegin() EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::rbegin() EA_NOEXCEPT
 		{ return reverse_iterator(end()); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::rbegin() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::rbegin() const EA_NOEXCEPT
 		{ return const_reverse_iterator(end()); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::crbegin() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::crbegin() const EA_NOEXCEPT
 		{ return const_reverse_iterator(end()); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::rend() EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::rend() EA_NOEXCEPT
 		{ return reverse_iterator(begin()); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::rend() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::rend() const EA_NOEXCEPT
 		{ return const_reverse_iterator(begin()); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::crend() const EA_NOEXCEPT
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::crend() const EA_NOEXCEPT
 		{ return const_reverse_iterator(begin()); }
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::this_type&
-	rbtree<K, V, C, A, E, bM, bU>::operator=(const this_type& x)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::this_type&
+	rbtree<K, V, C, A, E, bM, bU, bR>::operator=(const this_type& x)
 	{
 		if(this != &x)
 		{
@@ -1082,20 +1284,20 @@ namespace eastl
 
 			get_compare() = x.get_compare();
 
-			if(x.mAnchor.mpNodeParent) // mAnchor.mpNodeParent is the rb_tree root node.
+			if(x.mAnchor.GetParent()) // mAnchor.GetParent() is the rb_tree root node.
 			{
-				mAnchor.mpNodeParent = DoCopySubtree((const node_type*)x.mAnchor.mpNodeParent, &mAnchor);
-				mAnchor.mpNodeRight  = RBTreeGetMaxChild(mAnchor.mpNodeParent);
-				mAnchor.mpNodeLeft   = RBTreeGetMinChild(mAnchor.mpNodeParent);
+				mAnchor.SetParent(DoCopySubtree((const node_type*)x.mAnchor.GetParent(), &mAnchor));
+				mAnchor.mpNodeRight  = RBTreeGetMaxChild(mAnchor.GetParent());
+				mAnchor.mpNodeLeft   = RBTreeGetMinChild(mAnchor.GetParent());
 				mnSize               = x.mnSize;
 			}
 		}
 		return *this;
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::this_type&
-	rbtree<K, V, C, A, E, bM, bU>::operator=(this_type&& x)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::this_type&
+	rbtree<K, V, C, A, E, bM, bU, bR>::operator=(this_type&& x)
 	{
 		if(this != &x)
 		{
@@ -1105,23 +1307,21 @@ namespace eastl
 		return *this; 
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::this_type&
-	rbtree<K, V, C, A, E, bM, bU>::operator=(std::initializer_list<value_type> ilist)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::this_type&
+	rbtree<K, V, C, A, E, bM, bU, bR>::operator=(std::initializer_list<value_type> ilist)
 	{
-		// The simplest means of doing this is to clear and insert. There probably isn't a generic
-		// solution that's any more efficient without having prior knowledge of the ilist contents.
+		// The simplest means of doing this is to clear and insert. Range insertion into an empty 
+		// tree builds it directly when the ilist happens to be sorted.
 		clear();
-
-		for(typename std::initializer_list<value_type>::iterator it = ilist.begin(), itEnd = ilist.end(); it != itEnd; ++it)
-			DoInsertValue(has_unique_keys_type(), eastl::move(*it));
+		insert(ilist.begin(), ilist.end());
 
 		return *this;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	void rbtree<K, V, C, A, E, bM, bU>::swap(this_type& x)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::swap(this_type& x)
 	{
 	#if EASTL_RBTREE_LEGACY_SWAP_BEHAVIOUR_REQUIRES_COPY_CTOR
 		if(mAllocator == x.mAllocator) // If allocators are equivalent...
@@ -1143,39 +1343,41 @@ namespace eastl
 			// nominal container instance.
 
 			// We optimize for the expected most common case: both pointers being non-null.
-			if(mAnchor.mpNodeParent && x.mAnchor.mpNodeParent) // If both pointers are non-null...
+			if(mAnchor.GetParent() && x.mAnchor.GetParent()) // If both pointers are non-null...
 			{
 				eastl::swap(mAnchor.mpNodeRight,  x.mAnchor.mpNodeRight);
 				eastl::swap(mAnchor.mpNodeLeft,   x.mAnchor.mpNodeLeft);
-				eastl::swap(mAnchor.mpNodeParent, x.mAnchor.mpNodeParent);
+				rbtree_node_base* const pRoot = mAnchor.GetParent();
+				mAnchor.SetParent(x.mAnchor.GetParent());
+				x.mAnchor.SetParent(pRoot);
 
 				// We need to fix up the anchors to point to themselves (we can't just swap them).
-				mAnchor.mpNodeParent->mpNodeParent   = &mAnchor;
-				x.mAnchor.mpNodeParent->mpNodeParent = &x.mAnchor;
+				mAnchor.GetParent()->SetParent(&mAnchor);
+				x.mAnchor.GetParent()->SetParent(&x.mAnchor);
 			}
-			else if(mAnchor.mpNodeParent)
+			else if(mAnchor.GetParent())
 			{
 				x.mAnchor.mpNodeRight  = mAnchor.mpNodeRight;
 				x.mAnchor.mpNodeLeft   = mAnchor.mpNodeLeft;
-				x.mAnchor.mpNodeParent = mAnchor.mpNodeParent;
-				x.mAnchor.mpNodeParent->mpNodeParent = &x.mAnchor;
+				x.mAnchor.SetParent(mAnchor.GetParent());
+				x.mAnchor.GetParent()->SetParent(&x.mAnchor);
 
 				// We need to fix up our anchor to point it itself (we can't have it swap with x).
 				mAnchor.mpNodeRight  = &mAnchor;
 				mAnchor.mpNodeLeft   = &mAnchor;
-				mAnchor.mpNodeParent = NULL;
+				mAnchor.SetParent(NULL);
 			}
-			else if(x.mAnchor.mpNodeParent)
+			else if(x.mAnchor.GetParent())
 			{
 				mAnchor.mpNodeRight  = x.mAnchor.mpNodeRight;
 				mAnchor.mpNodeLeft   = x.mAnchor.mpNodeLeft;
-				mAnchor.mpNodeParent = x.mAnchor.mpNodeParent;
-				mAnchor.mpNodeParent->mpNodeParent = &mAnchor;
+				mAnchor.SetParent(x.mAnchor.GetParent());
+				mAnchor.GetParent()->SetParent(&mAnchor);
 
 				// We need to fix up x's anchor to point it itself (we can't have it swap with us).
 				x.mAnchor.mpNodeRight  = &x.mAnchor;
 				x.mAnchor.mpNodeLeft   = &x.mAnchor;
-				x.mAnchor.mpNodeParent = NULL;
+				x.mAnchor.SetParent(NULL);
 			} // Else both are NULL and there is nothing to do.
 		}
 	#if EASTL_RBTREE_LEGACY_SWAP_BEHAVIOUR_REQUIRES_COPY_CTOR
@@ -1189,58 +1391,58 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::insert_return_type // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
-	rbtree<K, V, C, A, E, bM, bU>::emplace(Args&&... args)
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::insert_return_type // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
+	rbtree<K, V, C, A, E, bM, bU, bR>::emplace(Args&&... args)
 	{
 		return DoInsertValue(has_unique_keys_type(), eastl::forward<Args>(args)...);
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args> 
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::emplace_hint(const_iterator position, Args&&... args)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::emplace_hint(const_iterator position, Args&&... args)
 	{
 		return DoInsertValueHint(has_unique_keys_type(), position, eastl::forward<Args>(args)...);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::iterator 
-	rbtree<K, V, C, A, E, bM, bU>::insert(const_iterator position, value_type&& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator 
+	rbtree<K, V, C, A, E, bM, bU, bR>::insert(const_iterator position, value_type&& value)
 	{
 		return DoInsertValueHint(has_unique_keys_type(), position, eastl::move(value));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::insert_return_type // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
-	rbtree<K, V, C, A, E, bM, bU>::insert(const value_type& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::insert_return_type // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
+	rbtree<K, V, C, A, E, bM, bU, bR>::insert(const value_type& value)
 	{
 		return DoInsertValue(has_unique_keys_type(), value);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::insert_return_type // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
-	rbtree<K, V, C, A, E, bM, bU>::insert(value_type&& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::insert_return_type // map/set::insert return a pair, multimap/multiset::iterator return an iterator.
+	rbtree<K, V, C, A, E, bM, bU, bR>::insert(value_type&& value)
 	{
 		return DoInsertValue(has_unique_keys_type(), eastl::move(value));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::insert(const_iterator position, const value_type& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::insert(const_iterator position, const value_type& value)
 	{
 		return DoInsertValueHint(has_unique_keys_type(), position, value);
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX, typename M>
-	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU>::iterator, bool>
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertOrAssign(KX&& k, M&& obj)
+	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator, bool>
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertOrAssign(KX&& k, M&& obj)
 	{
 		auto iter = find(k);
 
@@ -1255,12 +1457,12 @@ namespace eastl
 		}
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX, typename M>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertOrAssign(const_iterator hint, KX&& k, M&& obj)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertOrAssign(const_iterator hint, KX&& k, M&& obj)
 	{
-		auto iter = find(k);
+		auto iter = find(hint, k);
 
 		if(iter == end())
 		{
@@ -1273,16 +1475,16 @@ namespace eastl
 		}
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
 	rbtree_node_base*
-	rbtree<K, V, C, A, E, bM, bU>::DoGetKeyInsertionPositionUniqueKeys(bool& canInsert, const KX& key)
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoGetKeyInsertionPositionUniqueKeys(bool& canInsert, const KX& key)
 	{
 		// This code is essentially a slightly modified copy of the the rbtree::insert 
 		// function whereby this version takes a key and not a full value_type.
 		extract_key extractKey;
 
-		rbtree_node_base* pCurrent    = mAnchor.mpNodeParent; // Start with the root node.
+		rbtree_node_base* pCurrent    = mAnchor.GetParent(); // Start with the root node.
 		rbtree_node_base* pLowerBound = &mAnchor;             // Set it to the container end for now.
 		rbtree_node_base* pParent;                            // This will be where we insert the new node.
 
@@ -1337,12 +1539,12 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	rbtree_node_base*
-	rbtree<K, V, C, A, E, bM, bU>::DoGetKeyInsertionPositionNonuniqueKeys(const key_type& key)
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoGetKeyInsertionPositionNonuniqueKeys(const key_type& key)
 	{
 		// This is the pathway for insertion of non-unique keys (multimap and multiset, but not map and set).
-		rbtree_node_base* pCurrent  = mAnchor.mpNodeParent; // Start with the root node.
+		rbtree_node_base* pCurrent  = mAnchor.GetParent(); // Start with the root node.
 		rbtree_node_base* pRangeEnd = &mAnchor;             // Set it to the container end for now.
 		extract_key extractKey;
 
@@ -1363,9 +1565,9 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU>::iterator, bool> 
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValue(true_type, value_type&& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator, bool> 
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValue(true_type, value_type&& value)
 	{
 		extract_key extractKey;
 		key_type    key(extractKey(value));
@@ -1382,9 +1584,9 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator 
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValue(false_type, value_type&& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator 
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValue(false_type, value_type&& value)
 	{
 		extract_key extractKey;
 		key_type    key(extractKey(value));
@@ -1394,10 +1596,10 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args>
-	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU>::iterator, bool>
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValue(true_type, Args&&... args) // true_type means keys are unique.
+	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator, bool>
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValue(true_type, Args&&... args) // true_type means keys are unique.
 	{
 		// This is the pathway for insertion of unique keys (map and set, but not multimap and multiset).
 		// Note that we return a pair and not an iterator. This is because the C++ standard for map
@@ -1420,10 +1622,10 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValue(false_type, Args&&... args) // false_type means keys are not unique.
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValue(false_type, Args&&... args) // false_type means keys are not unique.
 	{
 		// We have a problem here if sizeof(value_type) is too big for the stack. We may want to consider having a specialization for large value_types.
 		// To do: Change this so that we call DoCreateNode(eastl::forward<Args>(args)...) here and use the value from the resulting pNode to get the 
@@ -1438,19 +1640,19 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValueImpl(rbtree_node_base* pNodeParent, bool bForceToLeft, const key_type& key, Args&&... args)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValueImpl(rbtree_node_base* pNodeParent, bool bForceToLeft, const key_type& key, Args&&... args)
 	{
 		node_type* const pNodeNew = DoCreateNode(eastl::forward<Args>(args)...); // Note that pNodeNew->mpLeft, mpRight, mpParent, will be uninitialized.
 		return DoInsertValueImpl(pNodeParent, bForceToLeft, key, pNodeNew);
 	}
 
 	
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValueImpl(rbtree_node_base* pNodeParent, bool bForceToLeft, const key_type& key, node_type* pNodeNew)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValueImpl(rbtree_node_base* pNodeParent, bool bForceToLeft, const key_type& key, node_type* pNodeNew)
 	{
 		EASTL_ASSERT_MSG(pNodeNew != nullptr, "node to insert to the rbtree must not be null");
 
@@ -1465,16 +1667,16 @@ namespace eastl
 		else
 			side = kRBTreeSideRight;
 
-		RBTreeInsert(pNodeNew, pNodeParent, &mAnchor, side);
+		DoRebalanceAfterInsert(pNodeNew, pNodeParent, side);
 		mnSize++;
 
 		return iterator(pNodeNew);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU>::iterator, bool>
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertKey(true_type, const key_type& key) // true_type means keys are unique.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	eastl::pair<typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator, bool>
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertKey(true_type, const key_type& key) // true_type means keys are unique.
 	{
 		// This is the pathway for insertion of unique keys (map and set, but not multimap and multiset).
 		// Note that we return a pair and not an iterator. This is because the C++ standard for map
@@ -1492,9 +1694,9 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertKey(false_type, const key_type& key) // false_type means keys are not unique.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertKey(false_type, const key_type& key) // false_type means keys are not unique.
 	{
 		rbtree_node_base* pPosition = DoGetKeyInsertionPositionNonuniqueKeys(key);
 		return DoInsertKeyImpl(pPosition, false, key);
@@ -1502,10 +1704,10 @@ namespace eastl
 
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
 	rbtree_node_base*
-	rbtree<K, V, C, A, E, bM, bU>::DoGetKeyInsertionPositionUniqueKeysHint(const_iterator position, bool& bForceToLeft, const KX& key)
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoGetKeyInsertionPositionUniqueKeysHint(const_iterator position, bool& bForceToLeft, const KX& key)
 	{
 		extract_key extractKey;
 
@@ -1556,9 +1758,9 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	rbtree_node_base*
-	rbtree<K, V, C, A, E, bM, bU>::DoGetKeyInsertionPositionNonuniqueKeysHint(const_iterator position, bool& bForceToLeft, const key_type& key)
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoGetKeyInsertionPositionNonuniqueKeysHint(const_iterator position, bool& bForceToLeft, const key_type& key)
 	{
 		extract_key extractKey;
 
@@ -1599,10 +1801,51 @@ namespace eastl
 		return nullptr;
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	template <typename KX>
+	rbtree_node_base*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoGetKeyInsertionPositionFinger(const_iterator position, bool& canInsert, bool& bForceToLeft, const KX& key)
+	{
+		// This is the pathway for a hinted insertion whose hint isn't adjacent to the insertion
+		// position. Rather than search from the root, we do a finger search from the hint for
+		// the node the new one goes before: the lower bound with unique keys (which we check
+		// for an equal key) and the upper bound with non-unique keys (so equal keys stay in
+		// insertion order, as with DoGetKeyInsertionPositionNonuniqueKeys).
+		extract_key             extractKey;
+		rbtree_node_base* const pNext = DoGetBoundHint(position, key, !bU);
+
+		if(bU && (pNext != &mAnchor) && !compare(key, extractKey(static_cast<node_type*>(pNext)->mValue)))
+		{
+			canInsert = false;
+			return pNext; // The key already exists.
+		}
+
+		canInsert = true;
+
+		// The new node goes to the left of pNext if that is free, or otherwise to the right of
+		// its predecessor, which is the rightmost node of its left subtree.
+		if(pNext == &mAnchor)
+		{
+			bForceToLeft = false;
+			return mnSize ? mAnchor.mpNodeRight : &mAnchor;
+		}
+
+		if(!pNext->mpNodeLeft)
+		{
+			bForceToLeft = true;
+			return pNext;
+		}
+
+		bForceToLeft = false;
+		return RBTreeGetMaxChild(pNext->mpNodeLeft);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValueHint(true_type, const_iterator position, Args&&... args) // true_type means keys are unique.
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValueHint(true_type, const_iterator position, Args&&... args) // true_type means keys are unique.
 	{
 		// This is the pathway for insertion of unique keys (map and set, but not multimap and multiset).
 		//
@@ -1618,25 +1861,23 @@ namespace eastl
 		if (!pPosition)
 		{
 			bool        canInsert;
-			pPosition = DoGetKeyInsertionPositionUniqueKeys(canInsert, key);
+			pPosition = DoGetKeyInsertionPositionFinger(position, canInsert, bForceToLeft, key);
 
 			if (!canInsert)
 			{
 				DoFreeNode(pNodeNew);
 				return iterator(pPosition);
 			}
-
-			bForceToLeft = false;
 		}
 
 		return DoInsertValueImpl(pPosition, bForceToLeft, key, pNodeNew);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <class... Args>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValueHint(false_type, const_iterator position, Args&&... args) // false_type means keys are not unique.
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValueHint(false_type, const_iterator position, Args&&... args) // false_type means keys are not unique.
 	{
 		// This is the pathway for insertion of non-unique keys (multimap and multiset, but not map and set).
 		//
@@ -1651,17 +1892,17 @@ namespace eastl
 
 		if (!pPosition)
 		{
-			pPosition = DoGetKeyInsertionPositionNonuniqueKeys(key);
-			bForceToLeft = false;
+			bool canInsert;
+			pPosition = DoGetKeyInsertionPositionFinger(position, canInsert, bForceToLeft, key);
 		}
 
 		return DoInsertValueImpl(pPosition, bForceToLeft, key, pNodeNew);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValueHint(true_type, const_iterator position, value_type&& value) // true_type means keys are unique.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValueHint(true_type, const_iterator position, value_type&& value) // true_type means keys are unique.
 	{
 		// This is the pathway for insertion of unique keys (map and set, but not multimap and multiset).
 		//
@@ -1673,16 +1914,22 @@ namespace eastl
 		bool        bForceToLeft;
 		rbtree_node_base*  pPosition = DoGetKeyInsertionPositionUniqueKeysHint(position, bForceToLeft, key);
 
-		if(pPosition)
-			return DoInsertValueImpl(pPosition, bForceToLeft, key, eastl::move(value));
-		else
-			return DoInsertValue(has_unique_keys_type(), eastl::move(value)).first;
+		if(!pPosition)
+		{
+			bool canInsert;
+			pPosition = DoGetKeyInsertionPositionFinger(position, canInsert, bForceToLeft, key);
+
+			if(!canInsert)
+				return iterator(pPosition);
+		}
+
+		return DoInsertValueImpl(pPosition, bForceToLeft, key, eastl::move(value));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertValueHint(false_type, const_iterator position, value_type&& value) // false_type means keys are not unique.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertValueHint(false_type, const_iterator position, value_type&& value) // false_type means keys are not unique.
 	{
 		// This is the pathway for insertion of non-unique keys (multimap and multiset, but not map and set).
 		//
@@ -1693,30 +1940,39 @@ namespace eastl
 		bool        bForceToLeft;
 		rbtree_node_base*  pPosition = DoGetKeyInsertionPositionNonuniqueKeysHint(position, bForceToLeft, key);
 
-		if(pPosition)
-			return DoInsertValueImpl(pPosition, bForceToLeft, key, eastl::move(value));
-		else
-			return DoInsertValue(has_unique_keys_type(), eastl::move(value));
+		if(!pPosition)
+		{
+			bool canInsert;
+			pPosition = DoGetKeyInsertionPositionFinger(position, canInsert, bForceToLeft, key);
+		}
+
+		return DoInsertValueImpl(pPosition, bForceToLeft, key, eastl::move(value));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertKey(true_type, const_iterator position, const key_type& key) // true_type means keys are unique.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertKey(true_type, const_iterator position, const key_type& key) // true_type means keys are unique.
 	{
 		bool       bForceToLeft;
 		rbtree_node_base* pPosition = DoGetKeyInsertionPositionUniqueKeysHint(position, bForceToLeft, key);
 
-		if(pPosition)
-			return DoInsertKeyImpl(pPosition, bForceToLeft, key);
-		else
-			return DoInsertKey(has_unique_keys_type(), key).first;
+		if(!pPosition)
+		{
+			bool canInsert;
+			pPosition = DoGetKeyInsertionPositionFinger(position, canInsert, bForceToLeft, key);
+
+			if(!canInsert)
+				return iterator(pPosition);
+		}
+
+		return DoInsertKeyImpl(pPosition, bForceToLeft, key);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertKey(false_type, const_iterator position, const key_type& key) // false_type means keys are not unique.
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertKey(false_type, const_iterator position, const key_type& key) // false_type means keys are not unique.
 	{
 		// This is the pathway for insertion of non-unique keys (multimap and multiset, but not map and set).
 		//
@@ -1725,16 +1981,19 @@ namespace eastl
 		bool       bForceToLeft;
 		rbtree_node_base* pPosition = DoGetKeyInsertionPositionNonuniqueKeysHint(position, bForceToLeft, key);
 
-		if(pPosition)
-			return DoInsertKeyImpl(pPosition, bForceToLeft, key);
-		else
-			return DoInsertKey(has_unique_keys_type(), key); // We are empty or we are inserting at the end.
+		if(!pPosition)
+		{
+			bool canInsert;
+			pPosition = DoGetKeyInsertionPositionFinger(position, canInsert, bForceToLeft, key);
+		}
+
+		return DoInsertKeyImpl(pPosition, bForceToLeft, key);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoInsertKeyImpl(rbtree_node_base* pNodeParent, bool bForceToLeft, const key_type& key)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoInsertKeyImpl(rbtree_node_base* pNodeParent, bool bForceToLeft, const key_type& key)
 	{
 		RBTreeSide  side;
 		extract_key extractKey;
@@ -1748,42 +2007,46 @@ namespace eastl
 			side = kRBTreeSideRight;
 
 		node_type* const pNodeNew = DoCreateNodeFromKey(key); // Note that pNodeNew->mpLeft, mpRight, mpParent, will be uninitialized.
-		RBTreeInsert(pNodeNew, pNodeParent, &mAnchor, side);
+		DoRebalanceAfterInsert(pNodeNew, pNodeParent, side);
 		mnSize++;
 
 		return iterator(pNodeNew);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	void rbtree<K, V, C, A, E, bM, bU>::insert(std::initializer_list<value_type> ilist)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::insert(std::initializer_list<value_type> ilist)
 	{
-		for(typename std::initializer_list<value_type>::iterator it = ilist.begin(), itEnd = ilist.end(); it != itEnd; ++it)
-			DoInsertValue(has_unique_keys_type(), eastl::move(*it));
+		insert(ilist.begin(), ilist.end());
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename InputIterator>
-	void rbtree<K, V, C, A, E, bM, bU>::insert(InputIterator first, InputIterator last)
+	void rbtree<K, V, C, A, E, bM, bU, bR>::insert(InputIterator first, InputIterator last)
 	{
+		// If we are empty, we build a balanced tree directly from however much of the range is 
+		// sorted, in linear time, instead of inserting and rebalancing one value at a time.
+		if(empty())
+			first = DoBuildSortedPrefix(first, last);
+
 		for( ; first != last; ++first)
 			DoInsertValue(has_unique_keys_type(), *first); // Or maybe we should call 'insert(end(), *first)' instead. If the first-last range was sorted then this might make some sense.
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline void rbtree<K, V, C, A, E, bM, bU>::clear()
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::clear()
 	{
 		// Erase the entire tree. DoNukeSubtree is not a 
 		// conventional erase function, as it does no rebalancing.
-		DoNukeSubtree((node_type*)mAnchor.mpNodeParent);
+		DoNukeSubtree((node_type*)mAnchor.GetParent());
 		reset_lose_memory();
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline void rbtree<K, V, C, A, E, bM, bU>::reset_lose_memory()
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::reset_lose_memory()
 	{
 		// The reset_lose_memory function is a special extension function which unilaterally 
 		// resets the container to an empty state without freeing the memory of 
@@ -1791,28 +2054,27 @@ namespace eastl
 		// container built into scratch memory.
 		mAnchor.mpNodeRight  = &mAnchor;
 		mAnchor.mpNodeLeft   = &mAnchor;
-		mAnchor.mpNodeParent = NULL;
-		mAnchor.mColor       = kRBTreeColorRed;
+		mAnchor.SetParentAndColor(NULL, kRBTreeColorRed);
 		mnSize               = 0;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::erase(const_iterator position)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::erase(const_iterator position)
 	{
 		const iterator iErase(position.mpNode);
 		--mnSize; // Interleave this between the two references to itNext. We expect no exceptions to occur during the code below.
 		++position;
-		RBTreeErase(iErase.mpNode, &mAnchor);
+		DoRebalanceForErase(iErase.mpNode);
 		DoFreeNode(static_cast<node_type*>(iErase.mpNode));
 		return iterator(position.mpNode);
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::erase(const_iterator first, const_iterator last)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::erase(const_iterator first, const_iterator last)
 	{
 		// We expect that if the user means to clear the container, they will call clear.
 		if(EASTL_LIKELY((first.mpNode != mAnchor.mpNodeLeft) || (last.mpNode != &mAnchor))) // If (first != begin or last != end) ...
@@ -1841,17 +2103,17 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::erase(const_reverse_iterator position)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::erase(const_reverse_iterator position)
 	{
 		return reverse_iterator(erase((++position).base()));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::reverse_iterator
-	rbtree<K, V, C, A, E, bM, bU>::erase(const_reverse_iterator first, const_reverse_iterator last)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::reverse_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::erase(const_reverse_iterator first, const_reverse_iterator last)
 	{
 		// Version which erases in order from first to last.
 		// difference_type i(first.base() - last.base());
@@ -1864,8 +2126,8 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline void rbtree<K, V, C, A, E, bM, bU>::erase(const key_type* first, const key_type* last)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::erase(const key_type* first, const key_type* last)
 	{
 		// We have no choice but to run a loop like this, as the first/last range could
 		// have values that are discontiguously located in the tree. And some may not 
@@ -1874,14 +2136,14 @@ namespace eastl
 			erase(*first++);
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoFind(const KX& key)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoFind(const KX& key)
 	{
 		extract_key extractKey;
 
-		rbtree_node_base* pCurrent = mAnchor.mpNodeParent; // Start with the root node.
+		rbtree_node_base* pCurrent = mAnchor.GetParent(); // Start with the root node.
 		rbtree_node_base* pRangeEnd = &mAnchor;             // Set it to the container end for now.
 
 		while (EASTL_LIKELY(pCurrent)) // Do a walk down the tree.
@@ -1903,23 +2165,23 @@ namespace eastl
 		return iterator(&mAnchor);
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoFind(const KX& key) const
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoFind(const KX& key) const
 	{
-		typedef rbtree<K, V, C, A, E, bM, bU> rbtree_type;
+		typedef rbtree<K, V, C, A, E, bM, bU, bR> rbtree_type;
 		return const_iterator(const_cast<rbtree_type*>(this)->find(key));
 	}
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename U, typename Compare2>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::find_as(const U& u, Compare2 compare2)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::find_as(const U& u, Compare2 compare2)
 	{
 		extract_key extractKey;
 
-		rbtree_node_base* pCurrent  = mAnchor.mpNodeParent; // Start with the root node.
+		rbtree_node_base* pCurrent  = mAnchor.GetParent(); // Start with the root node.
 		rbtree_node_base* pRangeEnd = &mAnchor;             // Set it to the container end for now.
 
 		while(EASTL_LIKELY(pCurrent)) // Do a walk down the tree.
@@ -1942,24 +2204,24 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename U, typename Compare2>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::find_as(const U& u, Compare2 compare2) const
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::find_as(const U& u, Compare2 compare2) const
 	{
-		typedef rbtree<K, V, C, A, E, bM, bU> rbtree_type;
+		typedef rbtree<K, V, C, A, E, bM, bU, bR> rbtree_type;
 		return const_iterator(const_cast<rbtree_type*>(this)->find_as(u, compare2));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoLowerBound(const KX& key)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoLowerBound(const KX& key)
 	{
 		extract_key extractKey;
 
-		rbtree_node_base* pCurrent  = mAnchor.mpNodeParent; // Start with the root node.
+		rbtree_node_base* pCurrent  = mAnchor.GetParent(); // Start with the root node.
 		rbtree_node_base* pRangeEnd = &mAnchor;             // Set it to the container end for now.
 
 		while(EASTL_LIKELY(pCurrent)) // Do a walk down the tree.
@@ -1980,24 +2242,24 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoLowerBound(const KX& key) const
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoLowerBound(const KX& key) const
 	{
-		typedef rbtree<K, V, C, A, E, bM, bU> rbtree_type;
+		typedef rbtree<K, V, C, A, E, bM, bU, bR> rbtree_type;
 		return const_iterator(const_cast<rbtree_type*>(this)->lower_bound(key));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
-	typename rbtree<K, V, C, A, E, bM, bU>::iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoUpperBound(const KX& key)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoUpperBound(const KX& key)
 	{
 		extract_key extractKey;
 
-		rbtree_node_base* pCurrent  = mAnchor.mpNodeParent; // Start with the root node.
+		rbtree_node_base* pCurrent  = mAnchor.GetParent(); // Start with the root node.
 		rbtree_node_base* pRangeEnd = &mAnchor;             // set it to the container end for now.
 
 		while(EASTL_LIKELY(pCurrent)) // Do a walk down the tree.
@@ -2016,19 +2278,104 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template <typename KX>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::const_iterator
-	rbtree<K, V, C, A, E, bM, bU>::DoUpperBound(const KX& key) const
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoUpperBound(const KX& key) const
 	{
-		typedef rbtree<K, V, C, A, E, bM, bU> rbtree_type;
+		typedef rbtree<K, V, C, A, E, bM, bU, bR> rbtree_type;
 		return const_iterator(const_cast<rbtree_type*>(this)->upper_bound(key));
 	}
 
 
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	template <typename KX>
+	inline bool rbtree<K, V, C, A, E, bM, bU, bR>::DoIsInBound(const rbtree_node_base* pNode, const KX& key, bool bUpperBound) const
+	{
+		// Tells if pNode is at or after the lower bound (pNode >= key) or upper bound (pNode > key) of key.
+		extract_key extractKey;
+		const key_type& nodeKey = extractKey(static_cast<const node_type*>(pNode)->mValue);
+
+		return bUpperBound ? compare(key, nodeKey) : !compare(nodeKey, key);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	template <typename KX>
+	rbtree_node_base* rbtree<K, V, C, A, E, bM, bU, bR>::DoGetBoundHint(const_iterator hint, const KX& key, bool bUpperBound) const
+	{
+		// Returns the first node which is in bound (see DoIsInBound), or the anchor if there is none.
+		// We climb from hint to the smallest subtree which must hold that node, and then walk down
+		// that subtree in the same way as DoLowerBound and DoUpperBound walk down from the root.
+		rbtree_node_base* pTop      = hint.mpNode;
+		rbtree_node_base* pRangeEnd = const_cast<rbtree_node_base*>(&mAnchor);
+
+		if(pTop == &mAnchor)
+		{
+			if(mnSize == 0)
+				return pRangeEnd;
+			pTop = mAnchor.mpNodeRight; // Searching from end() is searching from the last node.
+		}
+
+		if(DoIsInBound(pTop, key, bUpperBound))
+		{
+			// The result is hint or before it. Climb until we come up from the right of a node which
+			// is not in bound; the result is then within the subtree we came up from. Nodes we come
+			// up to from the left are after hint and so can't be the result.
+			for(rbtree_node_base* pParent = pTop->GetParent(); pParent != &mAnchor; pParent = pTop->GetParent())
+			{
+				if((pTop == pParent->mpNodeRight) && !DoIsInBound(pParent, key, bUpperBound))
+					break;
+				pTop = pParent;
+			}
+		}
+		else
+		{
+			// The result is after hint. Climb until we come up from the left of a node which is in
+			// bound; the result is then that node or within the subtree we came up from.
+			for(rbtree_node_base* pParent = pTop->GetParent(); pParent != &mAnchor; pParent = pTop->GetParent())
+			{
+				if((pTop == pParent->mpNodeLeft) && DoIsInBound(pParent, key, bUpperBound))
+				{
+					pRangeEnd = pParent;
+					break;
+				}
+				pTop = pParent;
+			}
+		}
+
+		for(rbtree_node_base* pCurrent = pTop; pCurrent; ) // Do a walk down the subtree.
+		{
+			if(DoIsInBound(pCurrent, key, bUpperBound))
+			{
+				pRangeEnd = pCurrent;
+				pCurrent  = pCurrent->mpNodeLeft;
+			}
+			else
+				pCurrent  = pCurrent->mpNodeRight;
+		}
+
+		return pRangeEnd;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	template <typename KX>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoFindHint(const_iterator hint, const KX& key) const
+	{
+		extract_key extractKey;
+		rbtree_node_base* const pLowerBound = DoGetBoundHint(hint, key, false);
+
+		if((pLowerBound != &mAnchor) && !compare(key, extractKey(static_cast<node_type*>(pLowerBound)->mValue)))
+			return iterator(pLowerBound);
+		return iterator(const_cast<rbtree_node_base*>(&mAnchor));
+	}
+
+
 	// To do: Move this validate function entirely to a template-less implementation.
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	bool rbtree<K, V, C, A, E, bM, bU>::validate() const
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	bool rbtree<K, V, C, A, E, bM, bU, bR>::validate() const
 	{
 		// Red-black trees have the following canonical properties which we validate here:
 		//   1 Every node is either red or black.
@@ -2048,13 +2395,13 @@ namespace eastl
 			//if(!mAnchor.mpNodeParent || (mAnchor.mpNodeLeft == mAnchor.mpNodeRight))
 			//    return false;             // Fix this for case of empty tree.
 
-			if(mAnchor.mpNodeLeft != RBTreeGetMinChild(mAnchor.mpNodeParent))
+			if(mAnchor.mpNodeLeft != RBTreeGetMinChild(mAnchor.GetParent()))
 				return false;
 
-			if(mAnchor.mpNodeRight != RBTreeGetMaxChild(mAnchor.mpNodeParent))
+			if(mAnchor.mpNodeRight != RBTreeGetMaxChild(mAnchor.GetParent()))
 				return false;
 
-			const size_t nBlackCount   = RBTreeGetBlackCount(mAnchor.mpNodeParent, mAnchor.mpNodeLeft);
+			const size_t nBlackCount   = RBTreeGetBlackCount(mAnchor.GetParent(), mAnchor.mpNodeLeft);
 			size_type    nIteratedSize = 0;
 
 			for(const_iterator it = begin(); it != end(); ++it, ++nIteratedSize)
@@ -2072,14 +2419,14 @@ namespace eastl
 					return false;
 
 				// Verify item #1 above.
-				if((pNode->mColor != kRBTreeColorRed) && (pNode->mColor != kRBTreeColorBlack))
+				if((pNode->GetColor() != kRBTreeColorRed) && (pNode->GetColor() != kRBTreeColorBlack))
 					return false;
 
 				// Verify item #3 above.
-				if(pNode->mColor == kRBTreeColorRed)
+				if(pNode->GetColor() == kRBTreeColorRed)
 				{
-					if((pNodeRight && (pNodeRight->mColor == kRBTreeColorRed)) ||
-					   (pNodeLeft  && (pNodeLeft->mColor  == kRBTreeColorRed)))
+					if((pNodeRight && (pNodeRight->GetColor() == kRBTreeColorRed)) ||
+					   (pNodeLeft  && (pNodeLeft->GetColor()  == kRBTreeColorRed)))
 						return false;
 				}
 
@@ -2090,10 +2437,14 @@ namespace eastl
 				if(pNodeLeft && compare(extractKey(pNode->mValue), extractKey(pNodeLeft->mValue)))
 					return false;
 
+				// Verify that ranked trees store the size of each subtree.
+				if(bR && (RBTreeGetSubtreeSize(pNode) != (RBTreeGetSubtreeSize(pNodeLeft) + RBTreeGetSubtreeSize(pNodeRight) + 1)))
+					return false;
+
 				if(!pNodeRight && !pNodeLeft) // If we are at a bottom node of the tree...
 				{
 					// Verify item #4 above.
-					if(RBTreeGetBlackCount(mAnchor.mpNodeParent, pNode) != nBlackCount)
+					if(RBTreeGetBlackCount(mAnchor.GetParent(), pNode) != nBlackCount)
 						return false;
 				}
 			}
@@ -2114,8 +2465,8 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline int rbtree<K, V, C, A, E, bM, bU>::validate_iterator(const_iterator i) const
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline int rbtree<K, V, C, A, E, bM, bU, bR>::validate_iterator(const_iterator i) const
 	{
 		// To do: Come up with a more efficient mechanism of doing this.
 
@@ -2132,9 +2483,9 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline typename rbtree<K, V, C, A, E, bM, bU>::node_type*
-	rbtree<K, V, C, A, E, bM, bU>::DoAllocateNode()
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoAllocateNode()
 	{
 		auto* pNode = (node_type*)allocate_memory(mAllocator, sizeof(node_type), EASTL_ALIGN_OF(node_type), 0);
 		EASTL_ASSERT_MSG(pNode != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
@@ -2143,17 +2494,17 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	inline void rbtree<K, V, C, A, E, bM, bU>::DoFreeNode(node_type* pNode)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::DoFreeNode(node_type* pNode)
 	{
 		pNode->~node_type();
 		EASTLFree(mAllocator, pNode, sizeof(node_type));
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::node_type*
-	rbtree<K, V, C, A, E, bM, bU>::DoCreateNodeFromKey(const key_type& key)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoCreateNodeFromKey(const key_type& key)
 	{
 		// Note that this function intentionally leaves the node pointers uninitialized.
 		// The caller would otherwise just turn right around and modify them, so there's
@@ -2178,17 +2529,16 @@ namespace eastl
 		#if EASTL_DEBUG
 			pNode->mpNodeRight  = NULL;
 			pNode->mpNodeLeft   = NULL;
-			pNode->mpNodeParent = NULL;
-			pNode->mColor       = kRBTreeColorBlack;
+			pNode->SetParentAndColor(NULL, kRBTreeColorBlack);
 		#endif
 
 		return pNode;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::node_type*
-	rbtree<K, V, C, A, E, bM, bU>::DoCreateNode(const value_type& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoCreateNode(const value_type& value)
 	{
 		// Note that this function intentionally leaves the node pointers uninitialized.
 		// The caller would otherwise just turn right around and modify them, so there's
@@ -2212,17 +2562,16 @@ namespace eastl
 		#if EASTL_DEBUG
 			pNode->mpNodeRight  = NULL;
 			pNode->mpNodeLeft   = NULL;
-			pNode->mpNodeParent = NULL;
-			pNode->mColor       = kRBTreeColorBlack;
+			pNode->SetParentAndColor(NULL, kRBTreeColorBlack);
 		#endif
 
 		return pNode;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::node_type*
-	rbtree<K, V, C, A, E, bM, bU>::DoCreateNode(value_type&& value)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoCreateNode(value_type&& value)
 	{
 		// Note that this function intentionally leaves the node pointers uninitialized.
 		// The caller would otherwise just turn right around and modify them, so there's
@@ -2246,18 +2595,17 @@ namespace eastl
 		#if EASTL_DEBUG
 			pNode->mpNodeRight  = NULL;
 			pNode->mpNodeLeft   = NULL;
-			pNode->mpNodeParent = NULL;
-			pNode->mColor       = kRBTreeColorBlack;
+			pNode->SetParentAndColor(NULL, kRBTreeColorBlack);
 		#endif
 
 		return pNode;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	template<class... Args>
-	typename rbtree<K, V, C, A, E, bM, bU>::node_type*
-	rbtree<K, V, C, A, E, bM, bU>::DoCreateNode(Args&&... args)
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoCreateNode(Args&&... args)
 	{
 		// Note that this function intentionally leaves the node pointers uninitialized.
 		// The caller would otherwise just turn right around and modify them, so there's
@@ -2281,32 +2629,32 @@ namespace eastl
 		#if EASTL_DEBUG
 			pNode->mpNodeRight  = NULL;
 			pNode->mpNodeLeft   = NULL;
-			pNode->mpNodeParent = NULL;
-			pNode->mColor       = kRBTreeColorBlack;
+			pNode->SetParentAndColor(NULL, kRBTreeColorBlack);
 		#endif
 
 		return pNode;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	typename rbtree<K, V, C, A, E, bM, bU>::node_type*
-	rbtree<K, V, C, A, E, bM, bU>::DoCreateNode(const node_type* pNodeSource, rbtree_node_base* pNodeParent)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoCreateNode(const node_type* pNodeSource, rbtree_node_base* pNodeParent)
 	{
 		node_type* const pNode = DoCreateNode(pNodeSource->mValue);
 
 		pNode->mpNodeRight  = NULL;
 		pNode->mpNodeLeft   = NULL;
-		pNode->mpNodeParent = pNodeParent;
-		pNode->mColor       = pNodeSource->mColor;
+		pNode->SetParentAndColor(pNodeParent, pNodeSource->GetColor());
+		if(bR)
+			RBTreeSetSubtreeSize(pNode, RBTreeGetSubtreeSize(pNodeSource));
 
 		return pNode;
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
 	rbtree_node_base*
-	rbtree<K, V, C, A, E, bM, bU>::DoCopySubtree(const node_type* pNodeSource, rbtree_node_base* pNodeDest)
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoCopySubtree(const node_type* pNodeSource, rbtree_node_base* pNodeDest)
 	{
 		node_type* const pNewNodeRoot = DoCreateNode(pNodeSource, pNodeDest);
 
@@ -2345,17 +2693,542 @@ namespace eastl
 	}
 
 
-	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU>
-	void rbtree<K, V, C, A, E, bM, bU>::DoNukeSubtree(rbtree_node_base* pNode)
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::size_type
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoNukeSubtree(rbtree_node_base* pNode)
 	{
+		size_type n = 0;
+
 		while(pNode) // Recursively traverse the tree and destroy items as we go.
 		{
-			DoNukeSubtree(pNode->mpNodeRight);
+			n += DoNukeSubtree(pNode->mpNodeRight);
 
 			node_type* const pNodeLeft = static_cast<node_type*>(pNode->mpNodeLeft);
 			DoFreeNode(static_cast<node_type*>(pNode));
 			pNode = pNodeLeft;
+			++n;
+		}
+
+		return n;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	template <typename InputIterator>
+	InputIterator rbtree<K, V, C, A, E, bM, bU, bR>::DoBuildSortedPrefix(InputIterator first, InputIterator last)
+	{
+		// Builds the tree, which must be empty, from the longest sorted prefix of the range and returns
+		// the position of the first value not consumed. We create the nodes in order, chained through 
+		// mpNodeRight, so they are allocated in the order they will be iterated, and we check the order 
+		// on the nodes themselves, which works for any type the range holds.
+		EASTL_ASSERT(empty());
+
+		extract_key extractKey;
+		node_type*  pNodeChainHead = NULL;
+		node_type*  pNodeChainTail = NULL;
+		node_type*  pNode = NULL;
+		size_type   n = 0;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(; first != last; ++first)
+				{
+					pNode = DoCreateNode(*first);
+
+					if(pNodeChainTail)
+					{
+						if(compare(extractKey(pNode->mValue), extractKey(pNodeChainTail->mValue)))
+							break; // Out of order. pNode is inserted the regular way below.
+
+						if(bU && !compare(extractKey(pNodeChainTail->mValue), extractKey(pNode->mValue)))
+						{
+							DoFreeNode(pNode); // Equivalent to the previous value, so insert would reject it as well.
+							pNode = NULL;
+							continue;
+						}
+
+						pNodeChainTail->mpNodeRight = pNode;
+					}
+					else
+						pNodeChainHead = pNode;
+
+					pNodeChainTail = pNode;
+					pNode = NULL;
+					++n;
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				if(pNode)
+					DoFreeNode(pNode);
+
+				for(; n; --n)
+				{
+					node_type* const pNodeNext = static_cast<node_type*>(pNodeChainHead->mpNodeRight);
+					DoFreeNode(pNodeChainHead);
+					pNodeChainHead = pNodeNext;
+				}
+				throw;
+			}
+		#endif
+
+		if(n)
+		{
+			pNodeChainTail->mpNodeRight = NULL;
+			DoBuildSortedTree(pNodeChainHead, n);
 		}
+
+		if(pNode) // If we stopped at a value that was out of order...
+		{
+			const key_type& key = extractKey(pNode->mValue);
+
+			if(bU)
+			{
+				bool canInsert;
+				rbtree_node_base* const pPosition = DoGetKeyInsertionPositionUniqueKeys(canInsert, key);
+
+				if(canInsert)
+					DoInsertValueImpl(pPosition, false, key, pNode);
+				else
+					DoFreeNode(pNode);
+			}
+			else
+				DoInsertValueImpl(DoGetKeyInsertionPositionNonuniqueKeys(key), false, key, pNode);
+
+			++first;
+		}
+
+		return first;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::DoBuildSortedTree(node_type* pNodeChain, size_type n)
+	{
+		// Makes the first n nodes of the chain, which are linked through mpNodeRight and must be 
+		// in order, the contents of this tree, which must be empty.
+		//
+		// We build a tree of minimal height by splitting each range at its middle. Every level but 
+		// the deepest is then full, so coloring the deepest level red and everything else black 
+		// gives every path the same number of black nodes.
+		size_type nRedDepth = 0;
+		for(size_type i = n; i > 1; i >>= 1)
+			++nRedDepth;
+
+		DoAttachTree(DoBuildSortedSubtree(pNodeChain, n, 0, nRedDepth), n);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::node_type*
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoBuildSortedSubtree(node_type*& pNodeChain, size_type n, size_type nDepth, size_type nRedDepth)
+	{
+		// Links the next n nodes of the chain into a balanced subtree and returns its root. 
+		// The caller sets the parent of the returned node.
+		const size_type nLeft     = (n - 1) / 2;
+		node_type*      pNodeLeft = nLeft ? DoBuildSortedSubtree(pNodeChain, nLeft, nDepth + 1, nRedDepth) : NULL;
+		node_type*      pNode     = pNodeChain;
+
+		pNodeChain = static_cast<node_type*>(pNode->mpNodeRight);
+
+		pNode->mpNodeLeft = pNodeLeft;
+		pNode->SetParentAndColor(NULL, ((nDepth == nRedDepth) && nDepth) ? kRBTreeColorRed : kRBTreeColorBlack);
+		if(bR)
+			RBTreeSetSubtreeSize(pNode, n);
+		if(pNodeLeft)
+			pNodeLeft->SetParent(pNode);
+
+		if(n - 1 - nLeft)
+		{
+			pNode->mpNodeRight = DoBuildSortedSubtree(pNodeChain, n - 1 - nLeft, nDepth + 1, nRedDepth);
+			pNode->mpNodeRight->SetParent(pNode);
+		}
+		else
+			pNode->mpNodeRight = NULL;
+
+		return pNode;
+	}
+
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::merge(this_type& source)
+	{
+		if(&source == this)
+			return;
+
+		if(mAllocator == source.mAllocator)
+		{
+			// Equal allocators mean we can take the nodes of source as they are. Elements of source 
+			// that we don't take are chained through mpNodeRight in order and rebuilt into source.
+			const size_type   nSize = mnSize + source.mnSize;
+			rbtree_node_base* pNodeLeftoverHead = NULL;
+			rbtree_node_base** ppLeftoverNext = &pNodeLeftoverHead;
+			size_type         nLeftoverCount = 0;
+
+			const rbtree_subtree tree = DoMerge(DoDetachTree(), source.DoDetachTree(), ppLeftoverNext, nLeftoverCount);
+
+			DoAttachTree(tree.mpRoot, nSize - nLeftoverCount);
+
+			if(nLeftoverCount)
+				source.DoBuildSortedTree(static_cast<node_type*>(pNodeLeftoverHead), nLeftoverCount);
+		}
+		else
+		{
+			// The nodes belong to the other allocator (e.g. that of a fixed_set), so we move the values.
+			extract_key extractKey;
+
+			for(iterator it(source.begin()); it != source.end(); )
+			{
+				rbtree_node_base* pPosition;
+
+				if(bU)
+				{
+					bool canInsert;
+					pPosition = DoGetKeyInsertionPositionUniqueKeys(canInsert, extractKey(*it));
+
+					if(!canInsert)
+					{
+						++it;
+						continue;
+					}
+				}
+				else
+					pPosition = DoGetKeyInsertionPositionNonuniqueKeys(extractKey(*it));
+
+				node_type* const pNodeNew = DoCreateNode(eastl::move(*it));
+				DoInsertValueImpl(pPosition, false, extractKey(pNodeNew->mValue), pNodeNew);
+				it = source.erase(it);
+			}
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::merge(this_type&& source)
+	{
+		merge(source);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::intersect(const this_type& x)
+	{
+		if(&x != this)
+		{
+			const size_type      nSize = mnSize;
+			size_type            nFreedCount = 0;
+			const rbtree_subtree tree = DoIntersect(DoDetachTree(), x.mAnchor.GetParent(), nFreedCount);
+
+			DoAttachTree(tree.mpRoot, nSize - nFreedCount);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::subtract(const this_type& x)
+	{
+		if(&x == this)
+			clear();
+		else
+		{
+			const size_type      nSize = mnSize;
+			size_type            nFreedCount = 0;
+			const rbtree_subtree tree = DoSubtract(DoDetachTree(), x.mAnchor.GetParent(), nFreedCount);
+
+			DoAttachTree(tree.mpRoot, nSize - nFreedCount);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	rbtree_subtree rbtree<K, V, C, A, E, bM, bU, bR>::DoDetachTree()
+	{
+		// Hands our nodes to the caller and leaves us empty.
+		rbtree_subtree tree = { mAnchor.GetParent(), 0 };
+
+		if(tree.mpRoot)
+			tree.mnBlackHeight = RBTreeGetBlackCount(tree.mpRoot, mAnchor.mpNodeLeft);
+
+		reset_lose_memory();
+		return tree;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::DoAttachTree(rbtree_node_base* pNodeRoot, size_type n)
+	{
+		// Makes the tree at pNodeRoot, which has n nodes, the contents of this tree.
+		if(pNodeRoot)
+		{
+			pNodeRoot->SetParentAndColor(&mAnchor, kRBTreeColorBlack);
+			mAnchor.SetParent(pNodeRoot);
+			mAnchor.mpNodeLeft  = RBTreeGetMinChild(pNodeRoot);
+			mAnchor.mpNodeRight = RBTreeGetMaxChild(pNodeRoot);
+			mnSize = n;
+		}
+		else
+			reset_lose_memory();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::DoSplit(rbtree_subtree tree, const key_type& key, rbtree_subtree& less, rbtree_subtree& equal, rbtree_subtree& greater)
+	{
+		// Splits tree into the elements whose keys order before, equivalent to and after key.
+		if(!tree.mpRoot)
+		{
+			less = equal = greater = tree;
+			return;
+		}
+
+		rbtree_subtree left, right;
+		RBTreeExpose(tree, left, right);
+
+		rbtree_node_base* const pNode = tree.mpRoot;
+		const key_type& nodeKey = extract_key()(static_cast<node_type*>(pNode)->mValue);
+
+		if(compare(key, nodeKey))
+		{
+			DoSplit(left, key, less, equal, greater);
+			greater = DoJoin(greater, pNode, right);
+		}
+		else if(compare(nodeKey, key))
+		{
+			DoSplit(right, key, less, equal, greater);
+			less = DoJoin(left, pNode, less);
+		}
+		else if(bU)
+		{
+			const rbtree_subtree empty = { NULL, 0 };
+
+			less    = left;
+			equal   = DoJoin(empty, pNode, empty);
+			greater = right;
+		}
+		else
+		{
+			// Equivalent keys may continue on either side.
+			rbtree_subtree equalLeft, equalRight, none;
+
+			DoSplit(left,  key, less, equalLeft,  none);
+			DoSplit(right, key, none, equalRight, greater);
+			equal = DoJoin(equalLeft, pNode, equalRight);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	void rbtree<K, V, C, A, E, bM, bU, bR>::DoSplitUpper(rbtree_subtree tree, const key_type& key, rbtree_subtree& lessEqual, rbtree_subtree& greater)
+	{
+		// Splits tree into the elements whose keys don't order after key and the ones that do.
+		if(!tree.mpRoot)
+		{
+			lessEqual = greater = tree;
+			return;
+		}
+
+		rbtree_subtree left, right;
+		RBTreeExpose(tree, left, right);
+
+		rbtree_node_base* const pNode = tree.mpRoot;
+
+		if(compare(key, extract_key()(static_cast<node_type*>(pNode)->mValue)))
+		{
+			DoSplitUpper(left, key, lessEqual, greater);
+			greater = DoJoin(greater, pNode, right);
+		}
+		else
+		{
+			DoSplitUpper(right, key, lessEqual, greater);
+			lessEqual = DoJoin(left, pNode, lessEqual);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	rbtree_subtree rbtree<K, V, C, A, E, bM, bU, bR>::DoMerge(rbtree_subtree tree, rbtree_subtree source, rbtree_node_base**& ppLeftoverNext, size_type& nLeftoverCount)
+	{
+		// Splits tree by the root of source and merges the halves with the subtrees of source.
+		// We visit source in order, so leftovers are appended to the chain in order.
+		if(!source.mpRoot)
+			return tree;
+		if(!tree.mpRoot)
+			return source;
+
+		rbtree_subtree sourceLeft, sourceRight;
+		RBTreeExpose(source, sourceLeft, sourceRight);
+
+		rbtree_node_base* const pNodeSource = source.mpRoot;
+		const key_type& key = extract_key()(static_cast<node_type*>(pNodeSource)->mValue);
+
+		if(bU)
+		{
+			rbtree_subtree less, equal, greater;
+			DoSplit(tree, key, less, equal, greater);
+
+			const rbtree_subtree left = DoMerge(less, sourceLeft, ppLeftoverNext, nLeftoverCount);
+			rbtree_node_base*    pNodeMiddle = pNodeSource;
+
+			if(equal.mpRoot) // If we already have the key, our element wins and the source's goes back.
+			{
+				pNodeMiddle = equal.mpRoot;
+				*ppLeftoverNext = pNodeSource;
+				ppLeftoverNext = &pNodeSource->mpNodeRight;
+				++nLeftoverCount;
+			}
+
+			const rbtree_subtree right = DoMerge(greater, sourceRight, ppLeftoverNext, nLeftoverCount);
+			return DoJoin(left, pNodeMiddle, right);
+		}
+		else
+		{
+			// Like insert, we place elements from source after the equivalent ones we already have.
+			rbtree_subtree lessEqual, greater;
+			DoSplitUpper(tree, key, lessEqual, greater);
+
+			const rbtree_subtree left  = DoMerge(lessEqual, sourceLeft,  ppLeftoverNext, nLeftoverCount);
+			const rbtree_subtree right = DoMerge(greater,   sourceRight, ppLeftoverNext, nLeftoverCount);
+			return DoJoin(left, pNodeSource, right);
+		}
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	rbtree_subtree rbtree<K, V, C, A, E, bM, bU, bR>::DoIntersect(rbtree_subtree tree, const rbtree_node_base* pNodeOther, size_type& nFreedCount)
+	{
+		if(tree.mpRoot && !pNodeOther)
+		{
+			nFreedCount += DoNukeSubtree(tree.mpRoot);
+			tree.mpRoot = NULL;
+			tree.mnBlackHeight = 0;
+		}
+
+		if(!tree.mpRoot)
+			return tree;
+
+		rbtree_subtree less, equal, greater;
+		DoSplit(tree, extract_key()(static_cast<const node_type*>(pNodeOther)->mValue), less, equal, greater);
+
+		less    = DoIntersect(less,    pNodeOther->mpNodeLeft,  nFreedCount);
+		greater = DoIntersect(greater, pNodeOther->mpNodeRight, nFreedCount);
+
+		return DoJoin2(DoJoin2(less, equal), greater);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	rbtree_subtree rbtree<K, V, C, A, E, bM, bU, bR>::DoSubtract(rbtree_subtree tree, const rbtree_node_base* pNodeOther, size_type& nFreedCount)
+	{
+		if(!tree.mpRoot || !pNodeOther)
+			return tree;
+
+		rbtree_subtree less, equal, greater;
+		DoSplit(tree, extract_key()(static_cast<const node_type*>(pNodeOther)->mValue), less, equal, greater);
+
+		nFreedCount += DoNukeSubtree(equal.mpRoot);
+
+		less    = DoSubtract(less,    pNodeOther->mpNodeLeft,  nFreedCount);
+		greater = DoSubtract(greater, pNodeOther->mpNodeRight, nFreedCount);
+
+		return DoJoin2(less, greater);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::DoRebalanceAfterInsert(rbtree_node_base* pNode, rbtree_node_base* pNodeParent, RBTreeSide side)
+	{
+		if(bR)
+			RBTreeRankedInsert(pNode, pNodeParent, &mAnchor, side);
+		else
+			RBTreeInsert(pNode, pNodeParent, &mAnchor, side);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline void rbtree<K, V, C, A, E, bM, bU, bR>::DoRebalanceForErase(rbtree_node_base* pNode)
+	{
+		if(bR)
+			RBTreeRankedErase(pNode, &mAnchor);
+		else
+			RBTreeErase(pNode, &mAnchor);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree_subtree rbtree<K, V, C, A, E, bM, bU, bR>::DoJoin(rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right)
+	{
+		return bR ? RBTreeRankedJoin(left, pNode, right) : RBTreeJoin(left, pNode, right);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline rbtree_subtree rbtree<K, V, C, A, E, bM, bU, bR>::DoJoin2(rbtree_subtree left, rbtree_subtree right)
+	{
+		return bR ? RBTreeRankedJoin2(left, right) : RBTreeJoin2(left, right);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::nth(size_type n)
+	{
+		static_assert(bR, "nth requires a ranked tree.");
+
+		rbtree_node_base* const pNode = RBTreeRankedGetNth(mAnchor.GetParent(), (size_t)n);
+		return iterator(pNode ? pNode : &mAnchor);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::const_iterator
+	rbtree<K, V, C, A, E, bM, bU, bR>::nth(size_type n) const
+	{
+		return const_iterator(const_cast<this_type*>(this)->nth(n));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	inline typename rbtree<K, V, C, A, E, bM, bU, bR>::size_type
+	rbtree<K, V, C, A, E, bM, bU, bR>::index_of(const_iterator position) const
+	{
+		static_assert(bR, "index_of requires a ranked tree.");
+
+		if(position.mpNode == &mAnchor)
+			return mnSize;
+		return (size_type)RBTreeRankedGetIndex(position.mpNode, &mAnchor);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E, bool bM, bool bU, bool bR>
+	template <typename KX>
+	typename rbtree<K, V, C, A, E, bM, bU, bR>::size_type
+	rbtree<K, V, C, A, E, bM, bU, bR>::DoRank(const KX& key) const
+	{
+		static_assert(bR, "rank requires a ranked tree.");
+
+		// This is the walk that lower_bound does, counting the elements we pass over to the left.
+		extract_key extractKey;
+
+		const rbtree_node_base* pCurrent = mAnchor.GetParent();
+		size_type               nRank    = 0;
+
+		while(pCurrent)
+		{
+			if(!compare(extractKey(static_cast<const node_type*>(pCurrent)->mValue), key)) // If pCurrent is >= key...
+				pCurrent = pCurrent->mpNodeLeft;
+			else
+			{
+				EASTL_VALIDATE_COMPARE(!compare(key, extractKey(static_cast<const node_type*>(pCurrent)->mValue))); // Validate that the compare function is sane.
+				nRank   += (size_type)RBTreeGetSubtreeSize(pCurrent->mpNodeLeft) + 1;
+				pCurrent = pCurrent->mpNodeRight;
+			}
+		}
+
+		return nRank;
 	}
 
 
@@ -2364,8 +3237,8 @@ namespace eastl
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline bool operator==(const rbtree<K, V, C, A, E, bM, bU>& a, const rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline bool operator==(const rbtree<K, V, C, A, E, bM, bU, bR>& a, const rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		return (a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin());
 	}
@@ -2377,43 +3250,43 @@ namespace eastl
 	// utility.h, but it basically is uses the operator< for pair.first and pair.second. The C++ standard
 	// appears to require this behaviour, whether intentionally or not. If anything, a good reason to do
 	// this is for consistency. A map and a vector that contain the same items should compare the same.
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline bool operator<(const rbtree<K, V, C, A, E, bM, bU>& a, const rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline bool operator<(const rbtree<K, V, C, A, E, bM, bU, bR>& a, const rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		return eastl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
 	}
 
 
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline bool operator!=(const rbtree<K, V, C, A, E, bM, bU>& a, const rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline bool operator!=(const rbtree<K, V, C, A, E, bM, bU, bR>& a, const rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		return !(a == b);
 	}
 
 
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline bool operator>(const rbtree<K, V, C, A, E, bM, bU>& a, const rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline bool operator>(const rbtree<K, V, C, A, E, bM, bU, bR>& a, const rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		return b < a;
 	}
 
 
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline bool operator<=(const rbtree<K, V, C, A, E, bM, bU>& a, const rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline bool operator<=(const rbtree<K, V, C, A, E, bM, bU, bR>& a, const rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		return !(b < a);
 	}
 
 
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline bool operator>=(const rbtree<K, V, C, A, E, bM, bU>& a, const rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline bool operator>=(const rbtree<K, V, C, A, E, bM, bU, bR>& a, const rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		return !(a < b);
 	}
 
 
-	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU>
-	inline void swap(rbtree<K, V, C, A, E, bM, bU>& a, rbtree<K, V, C, A, E, bM, bU>& b)
+	template <typename K, typename V, typename A, typename C, typename E, bool bM, bool bU, bool bR>
+	inline void swap(rbtree<K, V, C, A, E, bM, bU, bR>& a, rbtree<K, V, C, A, E, bM, bU, bR>& b)
 	{
 		a.swap(b);
 	}
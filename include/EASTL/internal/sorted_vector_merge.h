@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the batched insertion used by vector_set, vector_multiset,
+// vector_map and vector_multimap for inserting a range and for merge.
+//
+// Inserting k values one at a time into a sorted vector of n values costs a
+// binary search and a shift of up to n values each, or O(k * n) in all. Instead
+// we append all k values, sort just the new tail, drop the tail values whose keys
+// are already present (for unique keys), and merge the tail into place from the
+// back. That costs O(n + k log k) and only needs temporary space for the tail.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_SORTED_VECTOR_MERGE_H
+#define EASTL_INTERNAL_SORTED_VECTOR_MERGE_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/iterator.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		/// merge_sorted_tail
+		///
+		/// Given a container whose first nOldSize values are sorted by compare and whose
+		/// remaining values are in any order, sorts the container as a whole. The sort
+		/// is stable: values which compare equal stay in the order they had, so that old
+		/// values come before new ones, as if each new value had been inserted at its
+		/// upper bound.
+		///
+		/// If bUniqueKeys is true, a new value is dropped if its key equals that of an old
+		/// value or of an earlier new value, as if the values had been inserted one at a
+		/// time into a set. Dropped values are moved to the end of pRejected if it is
+		/// non-NULL, in sorted order.
+		///
+		/// The container must support random access, erase at the end and move assignment
+		/// of its values. Only the basic exception guarantee holds: if compare throws, the
+		/// container is left valid and nothing leaks, but it may be out of order, and values
+		/// which were being sorted or merged may be lost or left duplicated.
+		///
+		template <typename RandomAccessContainer, typename Compare>
+		void merge_sorted_tail(RandomAccessContainer& c, typename RandomAccessContainer::size_type nOldSize,
+		                       const Compare& compare, bool bUniqueKeys, RandomAccessContainer* pRejected = NULL)
+		{
+			typedef typename RandomAccessContainer::value_type     value_type;
+			typedef typename RandomAccessContainer::allocator_type allocator_type;
+			typedef typename RandomAccessContainer::size_type      size_type;
+			typedef typename RandomAccessContainer::iterator       iterator;
+			typedef eastl::vector<value_type, allocator_type>      buffer_type;
+
+			if(c.size() <= nOldSize)
+				return;
+
+			const iterator itOldEnd = c.begin() + nOldSize;
+			buffer_type    buffer(c.get_allocator());
+
+			// Sort the tail, unless it is already sorted. A sorted tail is common, for
+			// example when the values come from another sorted container. merge_sort_buffer
+			// needs a buffer of constructed values, which we get by copying the tail.
+			if(!eastl::is_sorted(itOldEnd, c.end(), compare))
+			{
+				buffer.assign(itOldEnd, c.end());
+				eastl::merge_sort_buffer(itOldEnd, c.end(), buffer.data(), compare);
+			}
+
+			if(bUniqueKeys)
+			{
+				// Compact the tail, dropping each value whose key equals that of the value kept
+				// before it or of an old value. The old values are searched in a single forward
+				// pass, since the tail is sorted.
+				iterator itOld  = c.begin();
+				iterator itKept = itOldEnd;
+
+				for(iterator it = itOldEnd, itEnd = c.end(); it != itEnd; ++it)
+				{
+					itOld = eastl::lower_bound(itOld, itOldEnd, *it, compare);
+
+					const bool bDuplicate = ((itKept != itOldEnd) && !compare(*(itKept - 1), *it)) ||
+					                        ((itOld  != itOldEnd) && !compare(*it, *itOld));
+					if(bDuplicate)
+					{
+						if(pRejected)
+							pRejected->push_back(eastl::move(*it));
+					}
+					else
+					{
+						if(itKept != it)
+							*itKept = eastl::move(*it);
+						++itKept;
+					}
+				}
+
+				c.erase(itKept, c.end());
+			}
+
+			const size_type nNewSize = (size_type)c.size();
+
+			// If the new values all go after the old ones, we are done. This is the case when
+			// appending in order to the end of the container.
+			if((nNewSize == nOldSize) || (nOldSize == 0) || !compare(*(c.begin() + nOldSize), *(c.begin() + (nOldSize - 1))))
+				return;
+
+			// Merge from the back, moving the new values out of the way first. Each value is
+			// written to a position at or after the one it is read from, so the old values
+			// which haven't been moved yet are never overwritten. Old values less than the
+			// first new value aren't touched.
+			buffer.assign(eastl::make_move_iterator(c.begin() + nOldSize), eastl::make_move_iterator(c.end()));
+
+			size_type nOld = nOldSize;
+			size_type nNew = (size_type)buffer.size();
+			size_type nOut = nNewSize;
+
+			while(nNew)
+			{
+				if(nOld && compare(buffer[nNew - 1], c[nOld - 1]))
+					c[--nOut] = eastl::move(c[--nOld]);
+				else
+					c[--nOut] = eastl::move(buffer[--nNew]);
+			}
+		}
+
+	} // namespace Internal
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,517 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements static_sorted_table, the base class of static_sorted_set
+// and static_sorted_map. It is a read-only sorted container which is built once
+// from a range of values and then only searched.
+//
+// Instead of keeping the values in sorted order as vector_set does, we store
+// them in Eytzinger order: the order of a breadth-first walk of the balanced
+// binary search tree over the values. The root is at index 1 and the children
+// of the node at index k are at 2k and 2k + 1 (we use 1-based indices
+// throughout and store node k at mValues[k - 1]). A search then always moves
+// forward through memory, the top levels of the tree are packed together and
+// stay in the cache, and the 2^d descendants of a node d levels down are
+// adjacent, so we can prefetch them a few levels before we get there.
+//
+// The search loop has no data-dependent branches: each step picks the child
+// with arithmetic and remembers the candidate result with a conditional move.
+// Together with the prefetching, this makes lookups on tables larger than the
+// cache several times faster than binary search over a sorted array, which
+// stalls on a mispredicted branch and a cache miss at nearly every level.
+//
+// Iteration is in sorted order, as with the other ordered containers. An
+// iterator steps between tree nodes, which is amortized constant time but
+// not as fast as walking a vector. The container can't be modified other
+// than by assigning or rebuilding it as a whole.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_STATIC_SORTED_TABLE_H
+#define EASTL_INTERNAL_STATIC_SORTED_TABLE_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+#include <EASTL/functional.h>
+#include <EASTL/iterator.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+#include <EASTL/sort.h>
+#include <EASTL/initializer_list.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STATIC_SORTED_PREFETCH_BYTES
+	///
+	/// Searches prefetch the descendants of the current node a few levels down,
+	/// far enough down that they fill this many bytes. This is normally the size
+	/// of a cache line.
+	///
+	#ifndef EASTL_STATIC_SORTED_PREFETCH_BYTES
+		#define EASTL_STATIC_SORTED_PREFETCH_BYTES 64
+	#endif
+
+
+
+	/// static_sorted_iterator
+	///
+	/// Iterates the values of a static_sorted_table in sorted order. The
+	/// values can't be modified, so there is only a const iterator.
+	///
+	template <typename T>
+	struct static_sorted_iterator
+	{
+		typedef static_sorted_iterator<T>         this_type;
+		typedef eastl_size_t                      size_type;
+		typedef ptrdiff_t                         difference_type;
+		typedef T                                 value_type;
+		typedef const T*                          pointer;
+		typedef const T&                          reference;
+		typedef eastl::bidirectional_iterator_tag iterator_category;
+
+	public:
+		const T*  mpData;   // The table's values, in Eytzinger order.
+		size_type mnIndex;  // The 1-based index of the current node, or 0 for end().
+		size_type mnSize;   // The number of values in the table.
+
+	public:
+		static_sorted_iterator()
+			: mpData(NULL), mnIndex(0), mnSize(0) { }
+
+		static_sorted_iterator(const T* pData, size_type nIndex, size_type nSize)
+			: mpData(pData), mnIndex(nIndex), mnSize(nSize) { }
+
+		reference operator*() const  { return mpData[mnIndex - 1]; }
+		pointer   operator->() const { return mpData + (mnIndex - 1); }
+
+		this_type& operator++()
+		{
+			if(((2 * mnIndex) + 1) <= mnSize) // If there is a right subtree, go to its leftmost node.
+			{
+				mnIndex = (2 * mnIndex) + 1;
+				while((2 * mnIndex) <= mnSize)
+					mnIndex *= 2;
+			}
+			else // Otherwise go up past every node we are the right child of, and then once more.
+			{
+				while(mnIndex & 1)
+					mnIndex >>= 1;
+				mnIndex >>= 1;
+			}
+			return *this;
+		}
+
+		this_type operator++(int)
+		{
+			this_type temp(*this);
+			++*this;
+			return temp;
+		}
+
+		this_type& operator--()
+		{
+			if(mnIndex == 0) // If at end(), go to the rightmost node.
+			{
+				mnIndex = 1;
+				while(((2 * mnIndex) + 1) <= mnSize)
+					mnIndex = (2 * mnIndex) + 1;
+			}
+			else if((2 * mnIndex) <= mnSize) // If there is a left subtree, go to its rightmost node.
+			{
+				mnIndex *= 2;
+				while(((2 * mnIndex) + 1) <= mnSize)
+					mnIndex = (2 * mnIndex) + 1;
+			}
+			else // Otherwise go up past every node we are the left child of, and then once more.
+			{
+				while(mnIndex && !(mnIndex & 1))
+					mnIndex >>= 1;
+				mnIndex >>= 1;
+			}
+			return *this;
+		}
+
+		this_type operator--(int)
+		{
+			this_type temp(*this);
+			--*this;
+			return temp;
+		}
+
+		bool operator==(const this_type& x) const { return (mnIndex == x.mnIndex) && (mpData == x.mpData); }
+		bool operator!=(const this_type& x) const { return !(*this == x); }
+	};
+
+
+
+	/// static_sorted_table
+	///
+	/// The implementation of static_sorted_set and static_sorted_map. Keys are unique;
+	/// when the source range has several values with equivalent keys, the first is kept,
+	/// as when inserting the range into a set or map.
+	///
+	template <typename Key, typename Value, typename Compare, typename Allocator, typename ExtractKey>
+	class static_sorted_table : protected Compare
+	{
+	public:
+		typedef static_sorted_table<Key, Value, Compare, Allocator, ExtractKey> this_type;
+		typedef eastl::vector<Value, Allocator>                                  value_vector_type;
+		typedef Key                                                              key_type;
+		typedef Value                                                            value_type;
+		typedef Compare                                                          key_compare;
+		typedef Allocator                                                        allocator_type;
+		typedef ExtractKey                                                       extract_key;
+		typedef const value_type*                                                pointer;
+		typedef const value_type*                                                const_pointer;
+		typedef const value_type&                                                reference;
+		typedef const value_type&                                                const_reference;
+		typedef eastl_size_t                                                     size_type;
+		typedef ptrdiff_t                                                        difference_type;
+		typedef static_sorted_iterator<value_type>                               iterator;
+		typedef static_sorted_iterator<value_type>                               const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                          const_reverse_iterator;
+
+	protected:
+		value_vector_type mValues; // The values in Eytzinger order. Node k (1-based) is mValues[k - 1].
+
+	public:
+		static_sorted_table(const Compare& compare, const allocator_type& allocator)
+			: Compare(compare), mValues(allocator) { }
+
+		template <typename InputIterator>
+		static_sorted_table(InputIterator first, InputIterator last, const Compare& compare, const allocator_type& allocator)
+			: Compare(compare), mValues(allocator) { DoBuild(first, last); }
+
+		static_sorted_table(const this_type& x)
+			: Compare(x), mValues(x.mValues) { }
+
+		static_sorted_table(this_type&& x)
+			: Compare(x), mValues(eastl::move(x.mValues)) { }
+
+		// The values needn't be assignable, so assignment makes a copy and swaps with it.
+		this_type& operator=(const this_type& x)
+		{
+			if(&x != this)
+			{
+				this_type temp(x);
+				swap(temp);
+			}
+			return *this;
+		}
+
+		this_type& operator=(this_type&& x)
+		{
+			swap(x);
+			return *this;
+		}
+
+		void swap(this_type& x)
+		{
+			using eastl::swap;
+			swap(static_cast<Compare&>(*this), static_cast<Compare&>(x));
+			mValues.swap(x.mValues);
+		}
+
+		/// assign
+		/// Replaces the contents with the values in [first, last), which needn't be sorted.
+		template <typename InputIterator>
+		void assign(InputIterator first, InputIterator last)
+		{
+			DoBuild(first, last);
+		}
+
+		void clear() { mValues.clear(); }
+
+		const allocator_type& get_allocator() const EA_NOEXCEPT { return mValues.get_allocator(); }
+		allocator_type&       get_allocator() EA_NOEXCEPT       { return mValues.get_allocator(); }
+
+		const key_compare& key_comp() const { return *this; }
+
+		iterator        begin() const EA_NOEXCEPT  { return iterator(mValues.data(), DoGetFirstIndex(mValues.size()), mValues.size()); }
+		const_iterator  cbegin() const EA_NOEXCEPT { return begin(); }
+		iterator        end() const EA_NOEXCEPT    { return iterator(mValues.data(), 0, mValues.size()); }
+		const_iterator  cend() const EA_NOEXCEPT   { return end(); }
+
+		reverse_iterator        rbegin() const EA_NOEXCEPT  { return reverse_iterator(end()); }
+		const_reverse_iterator  crbegin() const EA_NOEXCEPT { return rbegin(); }
+		reverse_iterator        rend() const EA_NOEXCEPT    { return reverse_iterator(begin()); }
+		const_reverse_iterator  crend() const EA_NOEXCEPT   { return rend(); }
+
+		bool      empty() const EA_NOEXCEPT { return mValues.empty(); }
+		size_type size() const EA_NOEXCEPT  { return mValues.size(); }
+
+		iterator find(const key_type& key) const { return DoFind(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator find(const KX& key) const { return DoFind(key); }
+
+		bool contains(const key_type& key) const { return DoFind(key) != end(); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		bool contains(const KX& key) const { return DoFind(key) != end(); }
+
+		size_type count(const key_type& key) const { return (DoFind(key) != end()) ? 1 : 0; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return (DoFind(key) != end()) ? 1 : 0; }
+
+		iterator lower_bound(const key_type& key) const { return DoMakeIterator(DoLowerBoundIndex(key)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator lower_bound(const KX& key) const { return DoMakeIterator(DoLowerBoundIndex(key)); }
+
+		iterator upper_bound(const key_type& key) const { return DoMakeIterator(DoUpperBoundIndex(key)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator upper_bound(const KX& key) const { return DoMakeIterator(DoUpperBoundIndex(key)); }
+
+		eastl::pair<iterator, iterator> equal_range(const key_type& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		bool validate() const;
+		int  validate_iterator(const_iterator i) const;
+
+	protected:
+		// The number of nodes from the current one to the first of its descendants that we prefetch.
+		// This is a power of two, so that those descendants are d levels down and adjacent in memory.
+		static const size_type kPrefetchStride = (sizeof(value_type) * 16 <= EASTL_STATIC_SORTED_PREFETCH_BYTES) ? 16 :
+		                                         (sizeof(value_type) *  8 <= EASTL_STATIC_SORTED_PREFETCH_BYTES) ?  8 :
+		                                         (sizeof(value_type) *  4 <= EASTL_STATIC_SORTED_PREFETCH_BYTES) ?  4 : 2;
+
+		iterator DoMakeIterator(size_type nIndex) const { return iterator(mValues.data(), nIndex, mValues.size()); }
+
+		// Returns the index of the leftmost node of a table of n values, or 0 if n is 0.
+		static size_type DoGetFirstIndex(size_type n)
+		{
+			size_type nIndex = n ? 1 : 0;
+			while(nIndex && ((2 * nIndex) <= n))
+				nIndex *= 2;
+			return nIndex;
+		}
+
+		template <typename InputIterator>
+		void DoBuild(InputIterator first, InputIterator last);
+
+		template <typename KX>
+		size_type DoLowerBoundIndex(const KX& key) const;
+
+		template <typename KX>
+		size_type DoUpperBoundIndex(const KX& key) const;
+
+		template <typename KX>
+		iterator DoFind(const KX& key) const;
+
+		template <typename KX>
+		eastl::pair<iterator, iterator> DoEqualRange(const KX& key) const;
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// static_sorted_table
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	template <typename InputIterator>
+	void static_sorted_table<K, V, C, A, E>::DoBuild(InputIterator first, InputIterator last)
+	{
+		// We copy the values, sort pointers to them and drop the pointers to duplicates,
+		// and then move each value into its slot. Sorting pointers means that the values
+		// needn't be assignable (map values have const keys), and the sort is skipped
+		// when the source is already sorted, as it is when it comes from a vector_set.
+		typedef eastl::vector<value_type*, allocator_type> pointer_vector_type;
+		typedef eastl::vector<size_type, allocator_type>   index_vector_type;
+
+		const extract_key   extractKey;
+		const key_compare&  compare = *this;
+		value_vector_type   source(first, last, get_allocator());
+		pointer_vector_type sorted(get_allocator());
+
+		sorted.reserve(source.size());
+		for(typename value_vector_type::iterator it = source.begin(); it != source.end(); ++it)
+			sorted.push_back(&*it);
+
+		auto lessFn = [&](const value_type* a, const value_type* b) { return compare(extractKey(*a), extractKey(*b)); };
+
+		if(!eastl::is_sorted(sorted.begin(), sorted.end(), lessFn))
+			eastl::stable_sort(sorted.begin(), sorted.end(), lessFn);
+
+		size_type n = 0;
+		for(size_type i = 0; i < sorted.size(); ++i)
+		{
+			if((n == 0) || lessFn(sorted[n - 1], sorted[i])) // Keep only the first of each run of equivalent keys.
+				sorted[n++] = sorted[i];
+		}
+
+		// The in-order walk of the tree visits the nodes in sorted order, so the i-th
+		// node it visits gets the i-th smallest value.
+		index_vector_type rankOfNode(n, size_type(0), get_allocator());
+		iterator          it(NULL, 0, n);
+
+		it.mnIndex = DoGetFirstIndex(n);
+		for(size_type i = 0; i < n; ++i, ++it)
+			rankOfNode[it.mnIndex - 1] = i;
+
+		mValues.clear();
+		mValues.reserve(n);
+		for(size_type k = 0; k < n; ++k)
+			mValues.push_back(eastl::move(*sorted[rankOfNode[k]]));
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	template <typename KX>
+	inline typename static_sorted_table<K, V, C, A, E>::size_type
+	static_sorted_table<K, V, C, A, E>::DoLowerBoundIndex(const KX& key) const
+	{
+		const extract_key        extractKey;
+		const key_compare&       compare = *this;
+		const value_type* const  pData   = mValues.data();
+		const size_type          n       = mValues.size();
+		size_type                nIndex  = 1;
+		size_type                nResult = 0;
+
+		while(nIndex <= n)
+		{
+			EASTL_PREFETCH(pData + (eastl::min_alt(nIndex * kPrefetchStride, n) - 1));
+
+			// Go right if the node is less than key. Otherwise it is the best candidate so far.
+			const bool bLess = compare(extractKey(pData[nIndex - 1]), key);
+			nResult = bLess ? nResult : nIndex;
+			nIndex  = (2 * nIndex) + (size_type)bLess;
+		}
+
+		return nResult;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	template <typename KX>
+	inline typename static_sorted_table<K, V, C, A, E>::size_type
+	static_sorted_table<K, V, C, A, E>::DoUpperBoundIndex(const KX& key) const
+	{
+		const extract_key        extractKey;
+		const key_compare&       compare = *this;
+		const value_type* const  pData   = mValues.data();
+		const size_type          n       = mValues.size();
+		size_type                nIndex  = 1;
+		size_type                nResult = 0;
+
+		while(nIndex <= n)
+		{
+			EASTL_PREFETCH(pData + (eastl::min_alt(nIndex * kPrefetchStride, n) - 1));
+
+			// Go right if the node is not greater than key. Otherwise it is the best candidate so far.
+			const bool bNotGreater = !compare(key, extractKey(pData[nIndex - 1]));
+			nResult = bNotGreater ? nResult : nIndex;
+			nIndex  = (2 * nIndex) + (size_type)bNotGreater;
+		}
+
+		return nResult;
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	template <typename KX>
+	inline typename static_sorted_table<K, V, C, A, E>::iterator
+	static_sorted_table<K, V, C, A, E>::DoFind(const KX& key) const
+	{
+		const size_type nIndex = DoLowerBoundIndex(key);
+
+		if(nIndex && !static_cast<const key_compare&>(*this)(key, extract_key()(mValues[nIndex - 1])))
+			return DoMakeIterator(nIndex);
+		return end();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	template <typename KX>
+	inline eastl::pair<typename static_sorted_table<K, V, C, A, E>::iterator, typename static_sorted_table<K, V, C, A, E>::iterator>
+	static_sorted_table<K, V, C, A, E>::DoEqualRange(const KX& key) const
+	{
+		// Keys are unique, so the range is either empty or the one value at lower_bound.
+		const iterator itLower(DoMakeIterator(DoLowerBoundIndex(key)));
+
+		if((itLower == end()) || static_cast<const key_compare&>(*this)(key, extract_key()(*itLower)))
+			return eastl::pair<iterator, iterator>(itLower, itLower);
+
+		iterator itUpper(itLower);
+		return eastl::pair<iterator, iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	bool static_sorted_table<K, V, C, A, E>::validate() const
+	{
+		// Every node must be greater than the one before it in sorted order.
+		const extract_key  extractKey;
+		const key_compare& compare = *this;
+		size_type          nCount  = 0;
+
+		for(iterator it = begin(), itPrev = end(); it != end(); itPrev = it++, ++nCount)
+		{
+			if((itPrev != end()) && !compare(extractKey(*itPrev), extractKey(*it)))
+				return false;
+		}
+
+		return nCount == size();
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	inline int static_sorted_table<K, V, C, A, E>::validate_iterator(const_iterator i) const
+	{
+		if(i.mpData != mValues.data())
+			return isf_none;
+		if(i.mnIndex == 0)
+			return (isf_valid | isf_current);
+		if(i.mnIndex <= size())
+			return (isf_valid | isf_current | isf_can_dereference);
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	inline bool operator==(const static_sorted_table<K, V, C, A, E>& a, const static_sorted_table<K, V, C, A, E>& b)
+	{
+		return (a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin());
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	inline bool operator!=(const static_sorted_table<K, V, C, A, E>& a, const static_sorted_table<K, V, C, A, E>& b)
+	{
+		return !(a == b);
+	}
+
+
+	template <typename K, typename V, typename C, typename A, typename E>
+	inline void swap(static_sorted_table<K, V, C, A, E>& a, static_sorted_table<K, V, C, A, E>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -138,6 +138,12 @@ namespace eastl
 		};
 
 
+		// thread_yield
+		// Gives up the remainder of the calling thread's time slice, for spin loops that
+		// have waited long enough that the thread they wait for may not be running.
+		EASTL_API void thread_yield();
+
+
 		// shared_ptr_auto_mutex
 		class EASTL_API shared_ptr_auto_mutex : public auto_mutex
 		{
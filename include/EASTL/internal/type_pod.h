@@ -1298,6 +1298,42 @@ namespace eastl
 	#endif
 
 
+	///////////////////////////////////////////////////////////////////////
+	// is_trivially_relocatable
+	//
+	// is_trivially_relocatable<T>::value == true if an object of type T
+	// can be moved to another address by copying its bytes, after which
+	// the source is treated as destroyed and its destructor isn't called.
+	// This is not a standard C++ trait.
+	//
+	// It is true by default for trivially copyable types. Many other types
+	// are trivially relocatable too, such as types which own memory through
+	// a pointer but hold no pointers into themselves, and EASTL specializes
+	// it for its own such types (e.g. basic_string, vector and unique_ptr).
+	// Containers use it to relocate their elements with memcpy as they grow.
+	//
+	// Users may specialize it for their own types:
+	//     namespace eastl
+	//     {
+	//         template <>
+	//         struct is_trivially_relocatable<Widget> : public true_type {};
+	//     }
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	struct is_trivially_relocatable
+		: public integral_constant<bool, eastl::is_trivially_copyable<T>::value> {};
+
+	template <typename T>
+	struct is_trivially_relocatable<const T> // So that pair<const Key, T> can be trivially relocatable.
+		: public eastl::is_trivially_relocatable<T> {};
+
+	#if EASTL_VARIABLE_TEMPLATES_ENABLED
+		template <class T>
+		EA_CONSTEXPR bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+	#endif
+
+
 } // namespace eastl
 
 
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_INTRUSIVE_MAP_H
+#define EASTL_INTRUSIVE_MAP_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/intrusive_rbtree.h>
+#include <EASTL/internal/intrusive_hashtable.h> // For use_intrusive_key.
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// intrusive_map
+	///
+	/// An ordered map whose tree nodes are part of the objects it holds, in the
+	/// way that intrusive_hash_map is to hash_map. T derives from Node, which by
+	/// default is intrusive_rbtree_node_key<Key>, and the key is Node's mKey.
+	/// Deriving from several distinct node types lets an object be in several
+	/// maps at once. See intrusive_rbtree.h for details.
+	///
+	/// Example usage:
+	///     struct Widget : public intrusive_rbtree_node_key<int> { ... };
+	///
+	///     intrusive_map<int, Widget> widgetMap;
+	///     Widget widget;
+	///     widget.mKey = 37;
+	///     widgetMap.insert(widget);
+	///     widgetMap.find(37); // Returns an iterator to widget.
+	///
+	/// Template parameters:
+	///     Key             The key object. Node must contain a member of type Key named mKey.
+	///     T               The type of object the map holds (a.k.a. value).
+	///     Compare         Ordering of keys.
+	///     Node            The base of T that links it into this map.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Node = intrusive_rbtree_node_key<Key> >
+	class intrusive_map : public intrusive_rbtree<Key, T, Compare, Node, eastl::use_intrusive_key<Node, Key>, false, true>
+	{
+	public:
+		typedef intrusive_rbtree<Key, T, Compare, Node, eastl::use_intrusive_key<Node, Key>, false, true>  base_type;
+		typedef intrusive_map<Key, T, Compare, Node>                                                       this_type;
+
+	public:
+		explicit intrusive_map(const Compare& compare = Compare())
+			: base_type(compare)
+		{
+			// Empty
+		}
+
+	}; // intrusive_map
+
+
+
+
+	/// intrusive_multimap
+	///
+	/// Implements a intrusive_multimap, which is the same thing as a intrusive_map 
+	/// except that contained elements need not be unique. See the documentation 
+	/// for intrusive_map for details.
+	///
+	/// Template parameters:
+	///     Key             The key object. Node must contain a member of type Key named mKey.
+	///     T               The type of object the map holds (a.k.a. value).
+	///     Compare         Ordering of keys.
+	///     Node            The base of T that links it into this map.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Node = intrusive_rbtree_node_key<Key> >
+	class intrusive_multimap : public intrusive_rbtree<Key, T, Compare, Node, eastl::use_intrusive_key<Node, Key>, false, false>
+	{
+	public:
+		typedef intrusive_rbtree<Key, T, Compare, Node, eastl::use_intrusive_key<Node, Key>, false, false>  base_type;
+		typedef intrusive_multimap<Key, T, Compare, Node>                                                   this_type;
+
+	public:
+		explicit intrusive_multimap(const Compare& compare = Compare())
+			: base_type(compare)
+		{
+			// Empty
+		}
+
+	}; // intrusive_multimap
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Node>
+	inline void swap(intrusive_map<Key, T, Compare, Node>& a, intrusive_map<Key, T, Compare, Node>& b)
+	{
+		a.swap(b);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Node>
+	inline void swap(intrusive_multimap<Key, T, Compare, Node>& a, intrusive_multimap<Key, T, Compare, Node>& b)
+	{
+		a.swap(b);
+	}
+
+
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
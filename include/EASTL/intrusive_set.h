@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_INTRUSIVE_SET_H
+#define EASTL_INTRUSIVE_SET_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/intrusive_rbtree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// intrusive_set
+	///
+	/// An ordered set whose tree nodes are part of the objects it holds, in the
+	/// way that intrusive_hash_set is to hash_set. T derives from Node, which by
+	/// default is intrusive_rbtree_node. See intrusive_rbtree.h for details.
+	///
+	/// Example usage:
+	///     struct Widget : public intrusive_rbtree_node
+	///     {
+	///         int mId;
+	///         bool operator<(const Widget& x) const { return mId < x.mId; }
+	///     };
+	///
+	///     intrusive_set<Widget> widgetSet;
+	///     Widget widget;
+	///     widgetSet.insert(widget);
+	///     widgetSet.remove(widget);
+	///
+	/// Template parameters:
+	///     T               The type of object the set holds (a.k.a. value).
+	///     Compare         Ordering of objects.
+	///     Node            The base of T that links it into this set.
+	///
+	template <typename T, typename Compare = eastl::less<T>, typename Node = intrusive_rbtree_node>
+	class intrusive_set : public intrusive_rbtree<T, T, Compare, Node, eastl::use_self<T>, true, true>
+	{
+	public:
+		typedef intrusive_rbtree<T, T, Compare, Node, eastl::use_self<T>, true, true>  base_type;
+		typedef intrusive_set<T, Compare, Node>                                        this_type;
+
+	public:
+		explicit intrusive_set(const Compare& compare = Compare())
+			: base_type(compare)
+		{
+			// Empty
+		}
+
+	}; // intrusive_set
+
+
+
+
+	/// intrusive_multiset
+	///
+	/// Implements a intrusive_multiset, which is the same thing as a intrusive_set 
+	/// except that contained elements need not be unique. See the documentation 
+	/// for intrusive_set for details.
+	///
+	/// Template parameters:
+	///     T               The type of object the set holds (a.k.a. value).
+	///     Compare         Ordering of objects.
+	///     Node            The base of T that links it into this set.
+	///
+	template <typename T, typename Compare = eastl::less<T>, typename Node = intrusive_rbtree_node>
+	class intrusive_multiset : public intrusive_rbtree<T, T, Compare, Node, eastl::use_self<T>, true, false>
+	{
+	public:
+		typedef intrusive_rbtree<T, T, Compare, Node, eastl::use_self<T>, true, false>  base_type;
+		typedef intrusive_multiset<T, Compare, Node>                                    this_type;
+
+	public:
+		explicit intrusive_multiset(const Compare& compare = Compare())
+			: base_type(compare)
+		{
+			// Empty
+		}
+
+	}; // intrusive_multiset
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Compare, typename Node>
+	inline void swap(intrusive_set<T, Compare, Node>& a, intrusive_set<T, Compare, Node>& b)
+	{
+		a.swap(b);
+	}
+
+
+	template <typename T, typename Compare, typename Node>
+	inline void swap(intrusive_multiset<T, Compare, Node>& a, intrusive_multiset<T, Compare, Node>& b)
+	{
+		a.swap(b);
+	}
+
+
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
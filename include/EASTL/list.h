@@ -2163,6 +2163,25 @@ namespace eastl
 	}
 
 
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::list
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename T>
+			using list = eastl::list<T, polymorphic_allocator>;
+		#endif
+	}
+
 } // namespace eastl
 
 
@@ -685,12 +685,16 @@ namespace eastl
 	map<Key, T, Compare, Allocator>::try_emplace_forward(const_iterator hint, KFwd&& key, Args&&... args)
 	{
 		bool bForceToLeft;
-		rbtree_node_base* const pPosition = base_type::DoGetKeyInsertionPositionUniqueKeysHint(hint, bForceToLeft, key);
+		rbtree_node_base* pPosition = base_type::DoGetKeyInsertionPositionUniqueKeysHint(hint, bForceToLeft, key);
 
 		if (!pPosition)
 		{
-			// the hint didn't help, we need to do a normal insert.
-			return try_emplace_forward(eastl::forward<KFwd>(key), eastl::forward<Args>(args)...).first;
+			// the hint isn't adjacent, so we do a finger search from it.
+			bool canInsert;
+			pPosition = base_type::DoGetKeyInsertionPositionFinger(hint, canInsert, bForceToLeft, key);
+
+			if (!canInsert)
+				return iterator(pPosition);
 		}
 
 		node_type* const pNodeNew =
@@ -901,6 +905,29 @@ namespace eastl
 	}
 #endif
 
+
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::map / pmr::multimap
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename Key, typename T, typename Compare = eastl::less<Key>>
+			using map = eastl::map<Key, T, Compare, polymorphic_allocator>;
+
+			template <typename Key, typename T, typename Compare = eastl::less<Key>>
+			using multimap = eastl::multimap<Key, T, Compare, polymorphic_allocator>;
+		#endif
+	}
+
 } // namespace eastl
 
 
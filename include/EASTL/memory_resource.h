@@ -0,0 +1,465 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     pmr::memory_resource
+//     pmr::polymorphic_allocator
+//     pmr::new_delete_resource / null_memory_resource
+//     pmr::get_default_resource / set_default_resource
+//     pmr::monotonic_buffer_resource
+//     pmr::unsynchronized_pool_resource
+//     pmr::synchronized_pool_resource
+//
+// These are the EASTL versions of the C++17 <memory_resource> facilities. An
+// EASTL allocator is a template parameter of its container, so changing the
+// allocation strategy of a container changes its type. polymorphic_allocator
+// instead forwards to a memory_resource chosen at runtime, so containers which
+// use different strategies share one type and one instantiation.
+//
+// The container headers define pmr aliases such as eastl::pmr::vector<T>,
+// which is eastl::vector<T, eastl::pmr::polymorphic_allocator>.
+//
+// Unlike std::pmr::polymorphic_allocator, eastl::pmr::polymorphic_allocator is
+// not a template, as EASTL allocators allocate bytes rather than objects.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_MEMORY_RESOURCE_H
+#define EASTL_MEMORY_RESOURCE_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/thread_support.h>
+#include <EASTL/type_traits.h>
+#include <stddef.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+	namespace pmr
+	{
+		/// EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME
+		///
+		/// Defines a default allocator name in the absence of a user-provided name.
+		///
+		#ifndef EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME
+			#define EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " polymorphic_allocator" // Unless the user overrides something, this is "EASTL polymorphic_allocator".
+		#endif
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// memory_resource
+		///////////////////////////////////////////////////////////////////////
+
+		/// memory_resource
+		///
+		/// The interface of a source of memory. Implementations override do_allocate,
+		/// do_deallocate and do_is_equal.
+		///
+		/// deallocate is given the size which was passed to allocate. When it is called
+		/// by a polymorphic_allocator it is given EASTL_ALLOCATOR_MIN_ALIGNMENT as the
+		/// alignment, as EASTL allocators aren't told the alignment of the memory they
+		/// free, so resources should find their blocks by size.
+		///
+		class EASTL_API memory_resource
+		{
+		public:
+			virtual ~memory_resource();
+
+			void* allocate(size_t bytes, size_t alignment = EASTL_ALLOCATOR_MIN_ALIGNMENT)
+				{ return do_allocate(bytes, alignment); }
+
+			void deallocate(void* p, size_t bytes, size_t alignment = EASTL_ALLOCATOR_MIN_ALIGNMENT)
+				{ do_deallocate(p, bytes, alignment); }
+
+			bool is_equal(const memory_resource& x) const EA_NOEXCEPT
+				{ return do_is_equal(x); }
+
+		protected:
+			virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+			virtual void  do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+			virtual bool  do_is_equal(const memory_resource& x) const EA_NOEXCEPT = 0;
+		};
+
+		inline bool operator==(const memory_resource& a, const memory_resource& b) EA_NOEXCEPT
+		{
+			return (&a == &b) || a.is_equal(b);
+		}
+
+	#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+		inline bool operator!=(const memory_resource& a, const memory_resource& b) EA_NOEXCEPT
+		{
+			return !(a == b);
+		}
+	#endif
+
+
+		/// new_delete_resource
+		///
+		/// Returns a resource which allocates from EASTLAllocatorType, which by default
+		/// uses operator new[] and delete[].
+		///
+		EASTL_API memory_resource* new_delete_resource() EA_NOEXCEPT;
+
+
+		/// null_memory_resource
+		///
+		/// Returns a resource whose allocate always fails. It throws std::bad_alloc when
+		/// exceptions are enabled, and asserts and returns NULL otherwise. It is useful
+		/// as the upstream resource of a monotonic_buffer_resource which must never use
+		/// more than its initial buffer.
+		///
+		EASTL_API memory_resource* null_memory_resource() EA_NOEXCEPT;
+
+
+		/// set_default_resource / get_default_resource
+		///
+		/// The default resource is used by default-constructed polymorphic_allocators
+		/// and as the default upstream resource of the other resources. It starts as
+		/// new_delete_resource(). Setting it to NULL restores new_delete_resource().
+		/// set_default_resource returns the previous default resource. Both functions
+		/// are thread-safe.
+		///
+		EASTL_API memory_resource* set_default_resource(memory_resource* pResource) EA_NOEXCEPT;
+		EASTL_API memory_resource* get_default_resource() EA_NOEXCEPT;
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// polymorphic_allocator
+		///////////////////////////////////////////////////////////////////////
+
+		/// polymorphic_allocator
+		///
+		/// An EASTL allocator which forwards to a memory_resource. Copies use the same
+		/// resource, and two polymorphic_allocators compare equal when their resources do.
+		/// Containers don't copy their allocator on assignment, unless
+		/// EASTL_ALLOCATOR_COPY_ENABLED is set, but swap exchanges the allocators
+		/// along with the elements, as it does for every EASTL allocator.
+		///
+		/// Allocations are made with at least EASTL_ALLOCATOR_MIN_ALIGNMENT. As deallocate
+		/// isn't given the alignment, alignments larger than EASTL_ALLOCATOR_MIN_ALIGNMENT
+		/// are supported only for sizes of at least the alignment, as is always the case
+		/// for container elements. Alignment offsets are not supported.
+		///
+		/// Example usage:
+		///     eastl::pmr::unsynchronized_pool_resource pool;
+		///     eastl::pmr::vector<int> intVector(&pool);
+		///
+		class polymorphic_allocator
+		{
+		public:
+			EASTL_ALLOCATOR_EXPLICIT polymorphic_allocator(const char* pName = EASTL_NAME_VAL(EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME))
+				: mpResource(get_default_resource())
+			{
+				#if EASTL_NAME_ENABLED
+					mpName = pName ? pName : EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME;
+				#else
+					EA_UNUSED(pName);
+				#endif
+			}
+
+			polymorphic_allocator(memory_resource* pResource, const char* pName = EASTL_NAME_VAL(EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME))
+				: mpResource(pResource)
+			{
+				EASTL_ASSERT(pResource != NULL);
+
+				#if EASTL_NAME_ENABLED
+					mpName = pName ? pName : EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME;
+				#else
+					EA_UNUSED(pName);
+				#endif
+			}
+
+			polymorphic_allocator(const polymorphic_allocator& x)
+				: mpResource(x.mpResource)
+			{
+				#if EASTL_NAME_ENABLED
+					mpName = x.mpName;
+				#endif
+			}
+
+			polymorphic_allocator(const polymorphic_allocator& x, const char* pName)
+				: mpResource(x.mpResource)
+			{
+				#if EASTL_NAME_ENABLED
+					mpName = pName ? pName : EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME;
+				#else
+					EA_UNUSED(pName);
+				#endif
+			}
+
+			polymorphic_allocator& operator=(const polymorphic_allocator& x)
+			{
+				mpResource = x.mpResource;
+				#if EASTL_NAME_ENABLED
+					mpName = x.mpName;
+				#endif
+				return *this;
+			}
+
+			void* allocate(size_t n, int /*flags*/ = 0)
+			{
+				return mpResource->allocate(n, EASTL_ALLOCATOR_MIN_ALIGNMENT);
+			}
+
+			void* allocate(size_t n, size_t alignment, size_t offset, int /*flags*/ = 0)
+			{
+				EASTL_ASSERT((offset % alignment) == 0);
+				EASTL_ASSERT((alignment <= EASTL_ALLOCATOR_MIN_ALIGNMENT) || (n >= alignment));
+				EA_UNUSED(offset);
+
+				return mpResource->allocate(n, (alignment > EASTL_ALLOCATOR_MIN_ALIGNMENT) ? alignment : EASTL_ALLOCATOR_MIN_ALIGNMENT);
+			}
+
+			void deallocate(void* p, size_t n)
+			{
+				mpResource->deallocate(p, n, EASTL_ALLOCATOR_MIN_ALIGNMENT);
+			}
+
+			memory_resource* resource() const
+				{ return mpResource; }
+
+			const char* get_name() const
+			{
+				#if EASTL_NAME_ENABLED
+					return mpName;
+				#else
+					return EASTL_POLYMORPHIC_ALLOCATOR_DEFAULT_NAME;
+				#endif
+			}
+
+			void set_name(const char* pName)
+			{
+				#if EASTL_NAME_ENABLED
+					mpName = pName;
+				#else
+					EA_UNUSED(pName);
+				#endif
+			}
+
+		protected:
+			memory_resource* mpResource;
+
+			#if EASTL_NAME_ENABLED
+				const char* mpName; // Debug name, used to track memory.
+			#endif
+		};
+
+		inline bool operator==(const polymorphic_allocator& a, const polymorphic_allocator& b)
+		{
+			return *a.resource() == *b.resource();
+		}
+
+	#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+		inline bool operator!=(const polymorphic_allocator& a, const polymorphic_allocator& b)
+		{
+			return !(*a.resource() == *b.resource());
+		}
+	#endif
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// monotonic_buffer_resource
+		///////////////////////////////////////////////////////////////////////
+
+		/// monotonic_buffer_resource
+		///
+		/// Allocation bumps a pointer through the initial buffer, if any, and then through
+		/// chunks allocated from the upstream resource, each twice as large as the one
+		/// before it. deallocate does nothing; memory is freed only by release and by the
+		/// destructor. This makes it the fastest resource for scratch containers whose
+		/// memory is all freed at once.
+		///
+		/// A monotonic_buffer_resource is not thread-safe.
+		///
+		/// Example usage:
+		///     char buffer[4096];
+		///     eastl::pmr::monotonic_buffer_resource scratch(buffer, sizeof(buffer));
+		///     eastl::pmr::hash_map<int, int> counts(&scratch);
+		///
+		class EASTL_API monotonic_buffer_resource : public memory_resource
+		{
+		public:
+			explicit monotonic_buffer_resource(memory_resource* pUpstream = get_default_resource());
+			explicit monotonic_buffer_resource(size_t nInitialSize, memory_resource* pUpstream = get_default_resource());
+			monotonic_buffer_resource(void* pBuffer, size_t nBufferSize, memory_resource* pUpstream = get_default_resource());
+		   ~monotonic_buffer_resource();
+
+			/// Frees the chunks allocated from the upstream resource, and starts again
+			/// from the initial buffer.
+			void release();
+
+			memory_resource* upstream_resource() const
+				{ return mpUpstream; }
+
+		protected:
+			void* do_allocate(size_t bytes, size_t alignment) EA_OVERRIDE;
+			void  do_deallocate(void* p, size_t bytes, size_t alignment) EA_OVERRIDE;
+			bool  do_is_equal(const memory_resource& x) const EA_NOEXCEPT EA_OVERRIDE;
+
+			struct Chunk
+			{
+				Chunk* mpPrev;  // The chunk which was allocated before this one.
+				size_t mnSize;  // The size of the chunk, including this header.
+			};
+
+		private:
+			monotonic_buffer_resource(const monotonic_buffer_resource&);
+			monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+		protected:
+			char*            mpCurrent;     // The next free byte in the current chunk or buffer.
+			char*            mpEnd;         // The end of the current chunk or buffer.
+			Chunk*           mpChunk;       // The most recently allocated chunk.
+			char*            mpBuffer;
+			size_t           mnBufferSize;
+			size_t           mnInitialSize; // The size of the first chunk.
+			size_t           mnNextSize;    // The size of the next chunk.
+			memory_resource* mpUpstream;
+		};
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// unsynchronized_pool_resource
+		///////////////////////////////////////////////////////////////////////
+
+		/// pool_options
+		///
+		/// Zero means the default for either field.
+		///
+		struct pool_options
+		{
+			pool_options(size_t maxBlocksPerChunk = 0, size_t largestRequiredPoolBlock = 0)
+				: max_blocks_per_chunk(maxBlocksPerChunk), largest_required_pool_block(largestRequiredPoolBlock) { }
+
+			size_t max_blocks_per_chunk;        // The largest number of blocks a pool allocates from upstream at once. The default is 1024.
+			size_t largest_required_pool_block; // Larger blocks are allocated from upstream directly. The default is 4096, and the maximum 1 MB.
+		};
+
+
+		/// unsynchronized_pool_resource
+		///
+		/// Keeps a pool of free blocks for each power of two size, from
+		/// EASTL_ALLOCATOR_MIN_ALIGNMENT up to options().largest_required_pool_block.
+		/// A pool which runs out of blocks allocates a chunk of them from the upstream
+		/// resource, each chunk having twice as many blocks as the one before it, up to
+		/// max_blocks_per_chunk. Blocks are aligned to their size.
+		///
+		/// Freed blocks go back to their pool, and chunks are returned to the upstream
+		/// resource only by release and by the destructor. Larger blocks are allocated
+		/// from the upstream resource directly and must be deallocated; release doesn't
+		/// free them.
+		///
+		/// Blocks are found by size, so deallocate must be given the size which was
+		/// passed to allocate. An unsynchronized_pool_resource is not thread-safe.
+		///
+		class EASTL_API unsynchronized_pool_resource : public memory_resource
+		{
+		public:
+			explicit unsynchronized_pool_resource(memory_resource* pUpstream = get_default_resource());
+			explicit unsynchronized_pool_resource(const pool_options& options, memory_resource* pUpstream = get_default_resource());
+		   ~unsynchronized_pool_resource();
+
+			/// Returns all chunks to the upstream resource.
+			void release();
+
+			memory_resource* upstream_resource() const
+				{ return mpUpstream; }
+
+			pool_options options() const
+				{ return mOptions; }
+
+		protected:
+			void* do_allocate(size_t bytes, size_t alignment) EA_OVERRIDE;
+			void  do_deallocate(void* p, size_t bytes, size_t alignment) EA_OVERRIDE;
+			bool  do_is_equal(const memory_resource& x) const EA_NOEXCEPT EA_OVERRIDE;
+
+			enum { kMaxPoolCount = 24 };
+
+			struct Chunk
+			{
+				Chunk* mpNext;  // The pool's chunk which was allocated before this one.
+				size_t mnSize;  // The size of the chunk, including this footer.
+			};
+
+			struct Pool
+			{
+				void*  mpFreeList;        // Free blocks, each of which holds a pointer to the next.
+				Chunk* mpChunkList;       // The pool's chunks. Each Chunk is at the end of its memory.
+				size_t mnNextBlockCount;  // The number of blocks in the next chunk.
+			};
+
+			void* DoAllocateChunk(Pool& pool, size_t nBlockSize);
+
+		private:
+			unsynchronized_pool_resource(const unsynchronized_pool_resource&);
+			unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&);
+
+		protected:
+			Pool             mPools[kMaxPoolCount]; // The pool of index i has blocks of size (kMinBlockSize << i).
+			size_t           mnPoolCount;
+			pool_options     mOptions;
+			memory_resource* mpUpstream;
+		};
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// synchronized_pool_resource
+		///////////////////////////////////////////////////////////////////////
+
+		/// synchronized_pool_resource
+		///
+		/// An unsynchronized_pool_resource whose functions lock a mutex, so that it can be
+		/// shared by threads. Threads which allocate heavily should use a resource of their
+		/// own, or eastl::thread_caching_allocator.
+		///
+		class EASTL_API synchronized_pool_resource : public memory_resource
+		{
+		public:
+			explicit synchronized_pool_resource(memory_resource* pUpstream = get_default_resource());
+			explicit synchronized_pool_resource(const pool_options& options, memory_resource* pUpstream = get_default_resource());
+		   ~synchronized_pool_resource();
+
+			void release();
+
+			memory_resource* upstream_resource() const
+				{ return mPool.upstream_resource(); }
+
+			pool_options options() const
+				{ return mPool.options(); }
+
+		protected:
+			void* do_allocate(size_t bytes, size_t alignment) EA_OVERRIDE;
+			void  do_deallocate(void* p, size_t bytes, size_t alignment) EA_OVERRIDE;
+			bool  do_is_equal(const memory_resource& x) const EA_NOEXCEPT EA_OVERRIDE;
+
+		private:
+			synchronized_pool_resource(const synchronized_pool_resource&);
+			synchronized_pool_resource& operator=(const synchronized_pool_resource&);
+
+		protected:
+			unsynchronized_pool_resource mPool;
+			Internal::mutex              mMutex;
+		};
+
+	} // namespace pmr
+
+
+	template <> struct is_trivially_relocatable<pmr::polymorphic_allocator> : public true_type {};
+
+} // namespace eastl
+
+
+#endif // Header include guard
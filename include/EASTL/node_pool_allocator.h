@@ -0,0 +1,234 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     node_pool
+//     node_pool_allocator
+//
+// node_pool_allocator gives node-based containers (list, slist, map, set,
+// hash_map, lru_cache, etc.) the locality of the fixed_* containers without
+// their fixed capacity. Nodes are carved out of slabs, each of which is a
+// single block from the overflow allocator. Each slab is as large as all the
+// previous ones together (up to a limit), so the number of slabs grows only
+// logarithmically with the number of nodes, and a slab is released as soon as
+// all its nodes are freed.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_NODE_POOL_ALLOCATOR_H
+#define EASTL_NODE_POOL_ALLOCATOR_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_NODE_POOL_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_NODE_POOL_DEFAULT_NAME
+		#define EASTL_NODE_POOL_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " node_pool" // Unless the user overrides something, this is "EASTL node_pool".
+	#endif
+
+
+	/// EASTL_NODE_POOL_INITIAL_NODE_COUNT
+	///
+	/// Defines the default number of nodes in the first slab of a node_pool.
+	///
+	#ifndef EASTL_NODE_POOL_INITIAL_NODE_COUNT
+		#define EASTL_NODE_POOL_INITIAL_NODE_COUNT 32
+	#endif
+
+
+	/// EASTL_NODE_POOL_MAX_SLAB_SIZE
+	///
+	/// Defines the default size in bytes above which a node_pool stops growing
+	/// its slabs. Nodes too large for a slab of this size are not pooled.
+	///
+	#ifndef EASTL_NODE_POOL_MAX_SLAB_SIZE
+		#define EASTL_NODE_POOL_MAX_SLAB_SIZE (256 * 1024)
+	#endif
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// node_pool
+	///////////////////////////////////////////////////////////////////////////
+
+	/// node_pool
+	///
+	/// A growable pool of same-sized nodes, which node_pool_allocator uses. The
+	/// node size and alignment are set by the first allocation. Like fixed_pool,
+	/// each slab keeps a free list threaded through its free nodes, and carves new
+	/// nodes off the end of its unused space. Slabs with free nodes are kept ahead
+	/// of full slabs, so allocation is O(1). Freeing a node finds its slab with a
+	/// binary search of the slabs by address, which is O(log(slab count)).
+	///
+	/// A slab is released when its last node is freed, except that one empty slab
+	/// is kept as a spare to avoid repeatedly allocating and releasing a slab when
+	/// the node count hovers around a slab boundary. trim() releases the spare.
+	///
+	/// A node_pool is not thread-safe, in the same way that containers aren't.
+	///
+	class EASTL_API node_pool
+	{
+	public:
+		node_pool(const EASTLAllocatorType& allocator = EASTLAllocatorType(EASTL_NODE_POOL_DEFAULT_NAME),
+		          size_t nInitialNodeCount = EASTL_NODE_POOL_INITIAL_NODE_COUNT,
+		          size_t nMaxSlabSize = EASTL_NODE_POOL_MAX_SLAB_SIZE);
+	   ~node_pool();
+
+		/// Returns a node of at least n bytes with at least the given alignment, or NULL if n
+		/// and alignment don't fit the nodes of this pool. The first call sets the node size.
+		void* allocate(size_t n, size_t alignment);
+
+		/// Frees a node returned by allocate. Returns false if p isn't from this pool.
+		bool deallocate(void* p);
+
+		/// Releases the spare empty slab, if any.
+		void trim();
+
+		size_t node_size() const  { return mnNodeSize; }   // 0 until the first allocation.
+		size_t size() const       { return mnSize; }       // The number of allocated nodes.
+		size_t capacity() const   { return mnCapacity; }   // The number of nodes the slabs in use can hold, not including the spare slab.
+		size_t slab_count() const { return mnSlabCount; }  // The number of slabs, including the spare slab.
+
+		EASTLAllocatorType&       get_allocator()       { return mAllocator; }
+		const EASTLAllocatorType& get_allocator() const { return mAllocator; }
+
+		bool validate() const;
+
+	protected:
+		struct Link
+		{
+			Link* mpNext;
+		};
+
+		struct Slab
+		{
+			Slab*  mpPrev;       // Slabs with free nodes come before full slabs.
+			Slab*  mpNext;
+			Link*  mpFreeList;   // Nodes which were allocated and then freed.
+			char*  mpUnused;     // Nodes from here to mpEnd have never been allocated.
+			char*  mpBegin;      // The first node.
+			char*  mpEnd;
+			size_t mnNodeCount;
+			size_t mnUsedCount;
+		};
+
+		bool  DoIsFull(const Slab* pSlab) const { return !pSlab->mpFreeList && (pSlab->mpUnused == pSlab->mpEnd); }
+		Slab* DoFindSlab(const void* p) const;
+		Slab* DoAddSlab();
+		void  DoReleaseSlab(Slab* pSlab);
+		void  DoResetSlab(Slab* pSlab);
+		void  DoLinkFront(Slab* pSlab);
+		void  DoLinkBack(Slab* pSlab);
+		void  DoUnlink(Slab* pSlab);
+
+	private:
+		node_pool(const node_pool&);
+		node_pool& operator=(const node_pool&);
+
+	public:
+		int mnRefCount; // The number of node_pool_allocators using this pool.
+
+	protected:
+		EASTLAllocatorType mAllocator;          // Allocates the slabs and the slab array.
+		Slab*              mpHead;              // The list of slabs in use.
+		Slab*              mpTail;
+		Slab*              mpSpareSlab;         // An empty slab which isn't in the list, or NULL.
+		Slab**             mpSlabArray;         // All slabs, including the spare, sorted by address.
+		size_t             mnSlabCount;
+		size_t             mnSlabArrayCapacity;
+		size_t             mnNodeSize;
+		size_t             mnNodeAlignment;
+		size_t             mnInitialNodeCount;
+		size_t             mnMaxSlabSize;
+		size_t             mnSize;
+		size_t             mnCapacity;
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// node_pool_allocator
+	///////////////////////////////////////////////////////////////////////////
+
+	/// node_pool_allocator
+	///
+	/// An allocator for node-based containers which allocates their nodes from a
+	/// node_pool. Requests which aren't for nodes, such as hashtable bucket arrays
+	/// or nodes of a different size than the pool's, go to the overflow allocator
+	/// (EASTLAllocatorType).
+	///
+	/// The pool is created on the first allocation and shared by copies of the
+	/// allocator, so copies compare equal and containers can swap and move their
+	/// nodes in O(1). A container's copy constructor copies the allocator, so the
+	/// copy shares the pool of the source. The pool is destroyed with the last
+	/// allocator that uses it.
+	///
+	/// Example usage:
+	///     eastl::map<int, Widget, eastl::less<int>, eastl::node_pool_allocator> widgetMap;
+	///     eastl::list<Widget, eastl::node_pool_allocator> widgetList(eastl::node_pool_allocator("widgets", 256, 64 * 1024));
+	///
+	class EASTL_API node_pool_allocator
+	{
+	public:
+		EASTL_ALLOCATOR_EXPLICIT node_pool_allocator(const char* pName = EASTL_NAME_VAL(EASTL_NODE_POOL_DEFAULT_NAME));
+		node_pool_allocator(const char* pName, size_t nInitialNodeCount, size_t nMaxSlabSize = EASTL_NODE_POOL_MAX_SLAB_SIZE);
+		node_pool_allocator(const node_pool_allocator& x);
+		node_pool_allocator(const node_pool_allocator& x, const char* pName);
+	   ~node_pool_allocator();
+
+		node_pool_allocator& operator=(const node_pool_allocator& x);
+
+		void* allocate(size_t n, int flags = 0);
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+		void  deallocate(void* p, size_t n);
+
+		const char* get_name() const;
+		void        set_name(const char* pName);
+
+		node_pool* get_pool() const { return mpPool; } // NULL until the first allocation.
+
+	protected:
+		node_pool* DoGetPool();
+		void       DoReleasePool();
+
+		node_pool* mpPool;
+		size_t     mnInitialNodeCount;
+		size_t     mnMaxSlabSize;
+
+		#if EASTL_NAME_ENABLED
+			const char* mpName; // Debug name, used to track memory.
+		#endif
+	};
+
+	inline bool operator==(const node_pool_allocator& a, const node_pool_allocator& b)
+	{
+		return a.get_pool() == b.get_pool();
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	inline bool operator!=(const node_pool_allocator& a, const node_pool_allocator& b)
+	{
+		return a.get_pool() != b.get_pool();
+	}
+#endif
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,274 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     profiling_allocator
+//     allocation_profile
+//     GetAllocationProfiles / ResetAllocationProfiles / ReportAllocationProfiles
+//
+// profiling_allocator is an allocator adaptor which records statistics about
+// the allocations it makes, keyed by its allocator name. Containers name their
+// allocators "EASTL vector", "EASTL hashtable" and so on, unless the user gives
+// them a name, so the statistics show which containers use the most memory and
+// allocate most often.
+//
+// Statistics are recorded only when EASTL_ALLOCATION_PROFILING_ENABLED is 1.
+// Otherwise profiling_allocator forwards to the allocator it wraps, is the same
+// size, and adds no code.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_PROFILING_ALLOCATOR_H
+#define EASTL_PROFILING_ALLOCATOR_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/allocator.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_PROFILING_ALLOCATOR_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	/// Allocations of allocators without a name are recorded under it.
+	///
+	#ifndef EASTL_PROFILING_ALLOCATOR_DEFAULT_NAME
+		#define EASTL_PROFILING_ALLOCATOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " profiling_allocator" // Unless the user overrides something, this is "EASTL profiling_allocator".
+	#endif
+
+
+	/// EASTL_ALLOCATION_PROFILING_MAX_NAMES
+	///
+	/// Defines the largest number of distinct allocator names which are recorded.
+	/// Allocations under further names are recorded under "(other)".
+	///
+	#ifndef EASTL_ALLOCATION_PROFILING_MAX_NAMES
+		#define EASTL_ALLOCATION_PROFILING_MAX_NAMES 256
+	#endif
+
+
+	/// EASTL_ALLOCATION_PROFILING_NAME_CAPACITY
+	///
+	/// Defines the size of the buffer each recorded name is copied to, including
+	/// its terminating 0. Longer names are truncated, and names which agree up to
+	/// the truncation are recorded together.
+	///
+	#ifndef EASTL_ALLOCATION_PROFILING_NAME_CAPACITY
+		#define EASTL_ALLOCATION_PROFILING_NAME_CAPACITY 64
+	#endif
+
+
+
+	/// allocation_profile
+	///
+	/// A snapshot of the statistics recorded for an allocator name. mpName points
+	/// to the recorded copy of the name, which lives as long as the program.
+	///
+	struct allocation_profile
+	{
+		/// Histogram bucket 0 counts allocations of up to 16 bytes, bucket i those
+		/// of up to (16 << i) bytes, and the last bucket all larger ones.
+		static const size_t kHistogramSize = 16;
+
+		const char* mpName;
+		uint64_t    mnAllocCount;
+		uint64_t    mnFreeCount;
+		uint64_t    mnAllocBytes;    // The total size of all allocations.
+		int64_t     mnLiveBytes;     // The size of the allocations which haven't been freed.
+		int64_t     mnPeakBytes;     // The largest mnLiveBytes has been.
+		uint64_t    mSizeHistogram[kHistogramSize];
+	};
+
+
+	/// GetAllocationProfiles
+	///
+	/// Copies the statistics of up to nCapacity allocator names to pProfileArray,
+	/// and returns the number of names which have been recorded, which may be
+	/// larger than nCapacity. Returns 0 when profiling is disabled.
+	///
+	EASTL_API size_t GetAllocationProfiles(allocation_profile* pProfileArray, size_t nCapacity);
+
+
+	/// ResetAllocationProfiles
+	///
+	/// Clears the counts, totals and histograms of all names, and sets their peak
+	/// to their current live bytes, so that a later report covers only what came
+	/// after. Live bytes are kept, as the memory is still allocated.
+	///
+	EASTL_API void ResetAllocationProfiles();
+
+
+	/// ReportAllocationProfiles
+	///
+	/// Writes a table of the statistics of all names, ordered by peak bytes, one
+	/// line at a time to pFunction. A NULL pFunction writes to stdout.
+	///
+	/// Example usage:
+	///     void WriteLine(const char* pLine, void* pContext)
+	///         { static_cast<Log*>(pContext)->Write(pLine); }
+	///
+	///     eastl::ReportAllocationProfiles(WriteLine, &gLog);
+	///
+	typedef void (*EASTL_AllocationReportFunction)(const char* pLine, void* pContext);
+
+	EASTL_API void ReportAllocationProfiles(EASTL_AllocationReportFunction pFunction = NULL, void* pContext = NULL);
+
+
+	namespace Internal
+	{
+		struct allocation_profile_record;
+
+		EASTL_API allocation_profile_record* GetAllocationProfileRecord(const char* pName);
+		EASTL_API void RecordAllocation(allocation_profile_record* pRecord, size_t n);
+		EASTL_API void RecordDeallocation(allocation_profile_record* pRecord, size_t n);
+	}
+
+
+
+	/// profiling_allocator
+	///
+	/// Wraps Allocator, and records each allocation and deallocation under its name.
+	/// The name is looked up when the allocator is constructed or renamed, after
+	/// which recording is a few atomic operations. The name is copied when it's
+	/// first recorded, so it needn't outlive the allocator. Renaming an allocator which has
+	/// allocated memory makes the statistics of both names wrong.
+	///
+	/// The size passed to deallocate is what is recorded as freed. Containers pass
+	/// the allocated size, except for string_map and string_hash_map, which pass 0
+	/// for their keys.
+	///
+	/// Example usage:
+	///     typedef eastl::profiling_allocator<> ProfilingAllocator;
+	///     eastl::vector<Widget, ProfilingAllocator> widgets(ProfilingAllocator("Widgets"));
+	///     ...
+	///     eastl::ReportAllocationProfiles();
+	///
+	template <typename Allocator = EASTLAllocatorType>
+	class profiling_allocator
+	{
+	public:
+		typedef Allocator allocator_type;
+
+		EASTL_ALLOCATOR_EXPLICIT profiling_allocator(const char* pName = EASTL_NAME_VAL(EASTL_PROFILING_ALLOCATOR_DEFAULT_NAME))
+			: mAllocator(pName)
+		{
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				mpRecord = Internal::GetAllocationProfileRecord(pName);
+			#endif
+		}
+
+		profiling_allocator(const allocator_type& allocator, const char* pName = EASTL_NAME_VAL(EASTL_PROFILING_ALLOCATOR_DEFAULT_NAME))
+			: mAllocator(allocator, pName)
+		{
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				mpRecord = Internal::GetAllocationProfileRecord(pName);
+			#endif
+		}
+
+		profiling_allocator(const profiling_allocator& x)
+			: mAllocator(x.mAllocator)
+		{
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				mpRecord = x.mpRecord;
+			#endif
+		}
+
+		profiling_allocator(const profiling_allocator& x, const char* pName)
+			: mAllocator(x.mAllocator, pName)
+		{
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				mpRecord = Internal::GetAllocationProfileRecord(pName);
+			#endif
+		}
+
+		profiling_allocator& operator=(const profiling_allocator& x)
+		{
+			mAllocator = x.mAllocator;
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				mpRecord = x.mpRecord;
+			#endif
+			return *this;
+		}
+
+		void* allocate(size_t n, int flags = 0)
+		{
+			void* const p = mAllocator.allocate(n, flags);
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				if(p)
+					Internal::RecordAllocation(mpRecord, n);
+			#endif
+			return p;
+		}
+
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+		{
+			void* const p = mAllocator.allocate(n, alignment, offset, flags);
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				if(p)
+					Internal::RecordAllocation(mpRecord, n);
+			#endif
+			return p;
+		}
+
+		void deallocate(void* p, size_t n)
+		{
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				if(p)
+					Internal::RecordDeallocation(mpRecord, n);
+			#endif
+			mAllocator.deallocate(p, n);
+		}
+
+		const char* get_name() const
+			{ return mAllocator.get_name(); }
+
+		void set_name(const char* pName)
+		{
+			mAllocator.set_name(pName);
+			#if EASTL_ALLOCATION_PROFILING_ENABLED
+				mpRecord = Internal::GetAllocationProfileRecord(pName);
+			#endif
+		}
+
+		allocator_type& get_allocator()
+			{ return mAllocator; }
+
+		const allocator_type& get_allocator() const
+			{ return mAllocator; }
+
+	protected:
+		allocator_type mAllocator;
+
+		#if EASTL_ALLOCATION_PROFILING_ENABLED
+			Internal::allocation_profile_record* mpRecord;
+		#endif
+	};
+
+	template <typename Allocator>
+	inline bool operator==(const profiling_allocator<Allocator>& a, const profiling_allocator<Allocator>& b)
+	{
+		return a.get_allocator() == b.get_allocator(); // Memory from either can be freed by the other. Their names don't matter.
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	template <typename Allocator>
+	inline bool operator!=(const profiling_allocator<Allocator>& a, const profiling_allocator<Allocator>& b)
+	{
+		return !(a.get_allocator() == b.get_allocator());
+	}
+#endif
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,644 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_RANKED_MAP_H
+#define EASTL_RANKED_MAP_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/red_black_tree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+#if EASTL_EXCEPTIONS_ENABLED
+#include <stdexcept>
+#endif
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_RANKED_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_RANKED_MAP_DEFAULT_NAME
+		#define EASTL_RANKED_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " ranked_map" // Unless the user overrides something, this is "EASTL ranked_map".
+	#endif
+
+
+	/// EASTL_RANKED_MULTIMAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_RANKED_MULTIMAP_DEFAULT_NAME
+		#define EASTL_RANKED_MULTIMAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " ranked_multimap" // Unless the user overrides something, this is "EASTL ranked_multimap".
+	#endif
+
+
+	/// EASTL_RANKED_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_RANKED_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_RANKED_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_RANKED_MAP_DEFAULT_NAME)
+	#endif
+
+	/// EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR
+		#define EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR allocator_type(EASTL_RANKED_MULTIMAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// ranked_map
+	///
+	/// Implements a map that can also find elements by their position in sorted order. 
+	/// Each node stores the number of nodes in its subtree, which the tree keeps up to 
+	/// date as it inserts, erases and rebalances. That gives these operations, all of 
+	/// which run in O(log n) time instead of the O(n) of eastl::advance or eastl::distance 
+	/// over a map:
+	///     nth(n)          Returns an iterator to the element at index n, or end() if n >= size().
+	///     rank(key)       Returns the number of elements whose key is less than key.
+	///     index_of(it)    Returns the index of the element at it, or size() for end().
+	///
+	/// In every other respect this is a map, with the same iterator stability. The cost 
+	/// is one size_t per node and a little extra work on each insertion and erasure; 
+	/// map itself doesn't pay any of it.
+	///
+	/// Example usage:
+	///     ranked_map<int, Player> leaderboard;
+	///     ...
+	///     auto itMedian = leaderboard.nth(leaderboard.size() / 2);
+	///     size_t nBelow = leaderboard.rank(score);
+	///
+	/// Pool allocation
+	/// A pool for a ranked_map needs to hold items of type ranked_map::node_type, 
+	/// which is a little larger than map::node_type. See map for an example.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType>
+	class ranked_map
+		: public rbtree<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> >, true, true, true>
+	{
+	public:
+		typedef rbtree<Key, eastl::pair<const Key, T>, Compare, Allocator,
+					   eastl::use_first<eastl::pair<const Key, T> >, true, true, true> base_type;
+		typedef ranked_map<Key, T, Compare, Allocator>                                 this_type;
+		typedef typename base_type::size_type                                          size_type;
+		typedef typename base_type::key_type                                           key_type;
+		typedef T                                                                      mapped_type;
+		typedef typename base_type::value_type                                         value_type;
+		typedef typename base_type::node_type                                          node_type;
+		typedef typename base_type::iterator                                           iterator;
+		typedef typename base_type::const_iterator                                     const_iterator;
+		typedef typename base_type::allocator_type                                     allocator_type;
+		typedef typename base_type::insert_return_type                                 insert_return_type;
+		typedef typename base_type::extract_key                                        extract_key;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+		using base_type::nth;
+		using base_type::rank;
+		using base_type::index_of;
+
+		static_assert(!is_const<value_type>::value, "ranked_map<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "ranked_map<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class ranked_map;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		ranked_map(const allocator_type& allocator = EASTL_RANKED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		ranked_map(const Compare& compare, const allocator_type& allocator = EASTL_RANKED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		ranked_map(const this_type& x)
+			: base_type(x) { }
+		ranked_map(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		ranked_map(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		ranked_map(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_RANKED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		ranked_map(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		ranked_map(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_RANKED_MAP_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		/// This is an extension to the C++ standard. We insert a default-constructed
+		/// element with the given key. See map::insert(const Key&).
+		insert_return_type insert(const Key& key) { return base_type::DoInsertKey(true_type(), key); }
+
+		// Standard conversion overload to avoid the overhead of mismatched 'pair<const Key, Value>' types.
+		template <typename P, eastl::enable_if_t<eastl::is_constructible_v<value_type, P&&>, bool> = true>
+		insert_return_type insert(P&& otherValue) { return base_type::emplace(eastl::forward<P>(otherValue)); }
+
+		value_compare value_comp() const { return value_compare(get_compare()); }
+
+		size_type erase(const Key& key) { return DoErase(key); }
+
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& key) { return DoErase(eastl::forward<KX>(key)); }
+
+		size_type count(const Key& key) const { return (find(key) != end()) ? 1 : 0; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return (find(key) != end()) ? 1 : 0; }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		T& operator[](const Key& key) { return try_emplace_forward(key).first->second; }
+		T& operator[](Key&& key)      { return try_emplace_forward(eastl::move(key)).first->second; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		T& operator[](KX&& key) { return try_emplace_forward(eastl::forward<KX>(key)).first->second; }
+
+		T& at(const Key& key) { return DoAt(key); }
+		const T& at(const Key& key) const { return DoAt(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		T& at(const KX& key) { return DoAt(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const T& at(const KX& key) const { return DoAt(key); }
+
+		template <class... Args> eastl::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) { return try_emplace_forward(k, eastl::forward<Args>(args)...); }
+		template <class... Args> eastl::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) { return try_emplace_forward(eastl::move(k), eastl::forward<Args>(args)...); }
+		template <class KX, class... Args, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, const_iterator> && !eastl::is_convertible_v<KX&&, iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, bool> try_emplace(KX&& k, Args&&... args) { return try_emplace_forward(eastl::forward<KX>(k), eastl::forward<Args>(args)...); }
+		template <class... Args> iterator                    try_emplace(const_iterator hint, const key_type& k, Args&&... args) { return try_emplace_forward(hint, k, eastl::forward<Args>(args)...); }
+		template <class... Args> iterator                    try_emplace(const_iterator hint, key_type&& k, Args&&... args) { return try_emplace_forward(hint, eastl::move(k), eastl::forward<Args>(args)...); }
+		template <class KX, class... Args, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		iterator                    try_emplace(const_iterator hint, KX&& k, Args&&... args) { return try_emplace_forward(hint, eastl::forward<KX>(k), eastl::forward<Args>(args)...); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& key);
+
+		template <class KFwd, class... Args>
+		eastl::pair<iterator, bool> try_emplace_forward(KFwd&& k, Args&&... args);
+
+		template <class KFwd, class... Args>
+		iterator try_emplace_forward(const_iterator hint, KFwd&& key, Args&&... args);
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+
+		template<typename KX>
+		T& DoAt(const KX& key);
+		template<typename KX>
+		const T& DoAt(const KX& key) const;
+	}; // ranked_map
+
+
+
+
+
+
+	/// ranked_multimap
+	///
+	/// Implements a multimap with the order statistics of ranked_map. With duplicate keys, 
+	/// rank(key) is the index of the first element with that key, and count(key) takes 
+	/// O(log n) time regardless of the number of duplicates.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType>
+	class ranked_multimap
+		: public rbtree<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> >, true, false, true>
+	{
+	public:
+		typedef rbtree<Key, eastl::pair<const Key, T>, Compare, Allocator,
+					   eastl::use_first<eastl::pair<const Key, T> >, true, false, true> base_type;
+		typedef ranked_multimap<Key, T, Compare, Allocator>                             this_type;
+		typedef typename base_type::size_type                                           size_type;
+		typedef typename base_type::key_type                                            key_type;
+		typedef T                                                                       mapped_type;
+		typedef typename base_type::value_type                                          value_type;
+		typedef typename base_type::node_type                                           node_type;
+		typedef typename base_type::iterator                                            iterator;
+		typedef typename base_type::const_iterator                                      const_iterator;
+		typedef typename base_type::allocator_type                                      allocator_type;
+		typedef typename base_type::insert_return_type                                  insert_return_type;
+		typedef typename base_type::extract_key                                         extract_key;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+		using base_type::nth;
+		using base_type::rank;
+		using base_type::index_of;
+
+		static_assert(!is_const<value_type>::value, "ranked_multimap<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "ranked_multimap<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class ranked_multimap;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		ranked_multimap(const allocator_type& allocator = EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		ranked_multimap(const Compare& compare, const allocator_type& allocator = EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		ranked_multimap(const this_type& x)
+			: base_type(x) { }
+		ranked_multimap(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		ranked_multimap(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		ranked_multimap(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		ranked_multimap(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		ranked_multimap(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_RANKED_MULTIMAP_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		/// This is an extension to the C++ standard. We insert a default-constructed
+		/// element with the given key. See multimap::insert(const Key&).
+		insert_return_type insert(const Key& key) { return base_type::DoInsertKey(false_type(), key); }
+
+		// Standard conversion overload to avoid the overhead of mismatched 'pair<const Key, Value>' types.
+		template <typename P, eastl::enable_if_t<eastl::is_constructible_v<value_type, P&&>, bool> = true>
+		insert_return_type insert(P&& otherValue) { return base_type::emplace(eastl::forward<P>(otherValue)); }
+
+		value_compare value_comp() const { return value_compare(get_compare()); }
+
+		size_type erase(const Key& key) { return DoErase(key); }
+
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& key) { return DoErase(eastl::forward<KX>(key)); }
+
+		size_type count(const Key& key) const { return DoCount(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return DoCount(key); }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		/// equal_range_small
+		/// This is a special version of equal_range which is optimized for the
+		/// case of there being few or no duplicated keys in the tree.
+		eastl::pair<iterator, iterator>             equal_range_small(const Key& key) { return DoEqualRangeSmall(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const Key& key) const { return DoEqualRangeSmall(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range_small(const KX& key) { return DoEqualRangeSmall(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const KX& key) const { return DoEqualRangeSmall(key); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& key);
+
+		template<typename KX>
+		size_type DoCount(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRangeSmall(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRangeSmall(const KX& key) const;
+	}; // ranked_multimap
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// ranked_map
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline typename ranked_map<Key, T, Compare, Allocator>::size_type
+	ranked_map<Key, T, Compare, Allocator>::DoErase(KX&& key)
+	{
+		const iterator it(find(key));
+
+		if(it != end()) // If it exists...
+		{
+			base_type::erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <class KFwd, class... Args>
+	inline eastl::pair<typename ranked_map<Key, T, Compare, Allocator>::iterator, bool>
+	ranked_map<Key, T, Compare, Allocator>::try_emplace_forward(KFwd&& key, Args&&... args)
+	{
+		bool canInsert;
+		rbtree_node_base* const pPosition = base_type::DoGetKeyInsertionPositionUniqueKeys(canInsert, key);
+
+		if(!canInsert)
+			return eastl::pair<iterator, bool>(iterator(pPosition), false);
+
+		node_type* const pNodeNew = base_type::DoCreateNode(piecewise_construct, eastl::forward_as_tuple(eastl::forward<KFwd>(key)),
+		                                                    eastl::forward_as_tuple(eastl::forward<Args>(args)...));
+		// The key might have been moved from above, so we take it from the node's value.
+		return eastl::pair<iterator, bool>(base_type::DoInsertValueImpl(pPosition, false, extract_key()(pNodeNew->mValue), pNodeNew), true);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <class KFwd, class... Args>
+	inline typename ranked_map<Key, T, Compare, Allocator>::iterator
+	ranked_map<Key, T, Compare, Allocator>::try_emplace_forward(const_iterator hint, KFwd&& key, Args&&... args)
+	{
+		bool bForceToLeft;
+		rbtree_node_base* pPosition = base_type::DoGetKeyInsertionPositionUniqueKeysHint(hint, bForceToLeft, key);
+
+		if(!pPosition) // If the hint isn't adjacent, do a finger search from it...
+		{
+			bool canInsert;
+			pPosition = base_type::DoGetKeyInsertionPositionFinger(hint, canInsert, bForceToLeft, key);
+
+			if(!canInsert)
+				return iterator(pPosition);
+		}
+
+		node_type* const pNodeNew = base_type::DoCreateNode(piecewise_construct, eastl::forward_as_tuple(eastl::forward<KFwd>(key)),
+		                                                    eastl::forward_as_tuple(eastl::forward<Args>(args)...));
+		return base_type::DoInsertValueImpl(pPosition, bForceToLeft, extract_key()(pNodeNew->mValue), pNodeNew);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_map<Key, T, Compare, Allocator>::iterator,
+					   typename ranked_map<Key, T, Compare, Allocator>::iterator>
+	ranked_map<Key, T, Compare, Allocator>::DoEqualRange(const KX& key)
+	{
+		// The resulting range will either be empty or have one element,
+		// so we do just lower_bound and see if the result is a range of size zero or one.
+		const iterator itLower(lower_bound(key));
+
+		if((itLower == end()) || compare(key, itLower->first)) // If at the end or if (key is < itLower)...
+			return eastl::pair<iterator, iterator>(itLower, itLower);
+
+		iterator itUpper(itLower);
+		return eastl::pair<iterator, iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_map<Key, T, Compare, Allocator>::const_iterator,
+					   typename ranked_map<Key, T, Compare, Allocator>::const_iterator>
+	ranked_map<Key, T, Compare, Allocator>::DoEqualRange(const KX& key) const
+	{
+		// See DoEqualRange above for comments.
+		const const_iterator itLower(lower_bound(key));
+
+		if((itLower == end()) || compare(key, itLower->first)) // If at the end or if (key is < itLower)...
+			return eastl::pair<const_iterator, const_iterator>(itLower, itLower);
+
+		const_iterator itUpper(itLower);
+		return eastl::pair<const_iterator, const_iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline T& ranked_map<Key, T, Compare, Allocator>::DoAt(const KX& key)
+	{
+		// use the use const version of ::DoAt to remove duplication
+		return const_cast<T&>(const_cast<this_type const*>(this)->DoAt(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline const T& ranked_map<Key, T, Compare, Allocator>::DoAt(const KX& key) const
+	{
+		const_iterator candidate = this->find(key);
+
+		if(candidate == end())
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				throw std::out_of_range("ranked_map::at key does not exist");
+			#else
+				EASTL_FAIL_MSG("ranked_map::at key does not exist");
+			#endif
+		}
+
+		return candidate->second;
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/map/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class T, class Compare, class Allocator, class Predicate>
+	typename ranked_map<Key, T, Compare, Allocator>::size_type erase_if(ranked_map<Key, T, Compare, Allocator>& c, Predicate predicate)
+	{
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// ranked_multimap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline typename ranked_multimap<Key, T, Compare, Allocator>::size_type
+	ranked_multimap<Key, T, Compare, Allocator>::DoErase(KX&& key)
+	{
+		const eastl::pair<iterator, iterator> range(DoEqualRange(key));
+		const size_type n = index_of(range.second) - index_of(range.first);
+		base_type::erase(range.first, range.second);
+		return n;
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline typename ranked_multimap<Key, T, Compare, Allocator>::size_type
+	ranked_multimap<Key, T, Compare, Allocator>::DoCount(const KX& key) const
+	{
+		const eastl::pair<const_iterator, const_iterator> range(DoEqualRange(key));
+		return index_of(range.second) - index_of(range.first);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multimap<Key, T, Compare, Allocator>::iterator,
+					   typename ranked_multimap<Key, T, Compare, Allocator>::iterator>
+	ranked_multimap<Key, T, Compare, Allocator>::DoEqualRange(const KX& key)
+	{
+		return eastl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multimap<Key, T, Compare, Allocator>::const_iterator,
+					   typename ranked_multimap<Key, T, Compare, Allocator>::const_iterator>
+	ranked_multimap<Key, T, Compare, Allocator>::DoEqualRange(const KX& key) const
+	{
+		return eastl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multimap<Key, T, Compare, Allocator>::iterator,
+					   typename ranked_multimap<Key, T, Compare, Allocator>::iterator>
+	ranked_multimap<Key, T, Compare, Allocator>::DoEqualRangeSmall(const KX& key)
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const iterator itLower(lower_bound(key));
+		iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(key, itUpper->first))
+			++itUpper;
+
+		return eastl::pair<iterator, iterator>(itLower, itUpper);
+	}
+
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multimap<Key, T, Compare, Allocator>::const_iterator,
+					   typename ranked_multimap<Key, T, Compare, Allocator>::const_iterator>
+	ranked_multimap<Key, T, Compare, Allocator>::DoEqualRangeSmall(const KX& key) const
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const const_iterator itLower(lower_bound(key));
+		const_iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(key, itUpper->first))
+			++itUpper;
+
+		return eastl::pair<const_iterator, const_iterator>(itLower, itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/multimap/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class T, class Compare, class Allocator, class Predicate>
+	typename ranked_multimap<Key, T, Compare, Allocator>::size_type erase_if(ranked_multimap<Key, T, Compare, Allocator>& c, Predicate predicate)
+	{
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,486 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_RANKED_SET_H
+#define EASTL_RANKED_SET_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/red_black_tree.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_RANKED_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_RANKED_SET_DEFAULT_NAME
+		#define EASTL_RANKED_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " ranked_set" // Unless the user overrides something, this is "EASTL ranked_set".
+	#endif
+
+
+	/// EASTL_RANKED_MULTISET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_RANKED_MULTISET_DEFAULT_NAME
+		#define EASTL_RANKED_MULTISET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " ranked_multiset" // Unless the user overrides something, this is "EASTL ranked_multiset".
+	#endif
+
+
+	/// EASTL_RANKED_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_RANKED_SET_DEFAULT_ALLOCATOR
+		#define EASTL_RANKED_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_RANKED_SET_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR
+		#define EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR allocator_type(EASTL_RANKED_MULTISET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// ranked_set
+	///
+	/// Implements a set that can also find elements by their position in sorted order, 
+	/// with nth, rank and index_of in O(log n) time. See ranked_map for details.
+	///
+	/// As with set, ranked_set::iterator is const and the same as ranked_set::const_iterator.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType>
+	class ranked_set
+		: public rbtree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, true, true>
+	{
+	public:
+		typedef rbtree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, true, true> base_type;
+		typedef ranked_set<Key, Compare, Allocator>                                           this_type;
+		typedef typename base_type::size_type                                                 size_type;
+		typedef typename base_type::value_type                                                value_type;
+		typedef typename base_type::iterator                                                  iterator;
+		typedef typename base_type::const_iterator                                            const_iterator;
+		typedef typename base_type::reverse_iterator                                          reverse_iterator;
+		typedef typename base_type::const_reverse_iterator                                    const_reverse_iterator;
+		typedef typename base_type::allocator_type                                            allocator_type;
+		typedef Compare                                                                       value_compare;
+		typedef typename base_type::insert_return_type                                        insert_return_type;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+		using base_type::nth;
+		using base_type::rank;
+		using base_type::index_of;
+
+		static_assert(!is_const<value_type>::value, "ranked_set<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "ranked_set<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		ranked_set(const allocator_type& allocator = EASTL_RANKED_SET_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		ranked_set(const Compare& compare, const allocator_type& allocator = EASTL_RANKED_SET_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		ranked_set(const this_type& x)
+			: base_type(x) { }
+		ranked_set(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		ranked_set(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		ranked_set(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_RANKED_SET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		ranked_set(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		ranked_set(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_RANKED_SET_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		value_compare value_comp() const { return get_compare(); }
+
+		size_type erase(const Key& k) { return DoErase(k); }
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& k) { return DoErase(eastl::forward<KX>(k)); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		insert_return_type insert(KX&& key)
+		{
+			// Heterogeneous insertion only constructs a key_type if the key isn't already present.
+			bool              canInsert;
+			rbtree_node_base* pPosition = base_type::DoGetKeyInsertionPositionUniqueKeys(canInsert, key);
+
+			if(canInsert)
+			{
+				typename base_type::node_type* const pNodeNew = base_type::DoCreateNode(eastl::forward<KX>(key));
+				return eastl::pair<iterator, bool>(base_type::DoInsertValueImpl(pPosition, false, pNodeNew->mValue, pNodeNew), true);
+			}
+
+			return eastl::pair<iterator, bool>(iterator(pPosition), false);
+		}
+
+		size_type count(const Key& k) const { return (find(k) != end()) ? 1 : 0; }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return (find(key) != end()) ? 1 : 0; }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& k);
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+	}; // ranked_set
+
+
+
+
+
+	/// ranked_multiset
+	///
+	/// Implements a multiset with the order statistics of ranked_set. With duplicate keys, 
+	/// rank(key) is the index of the first element with that key, and count(key) takes 
+	/// O(log n) time regardless of the number of duplicates.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType>
+	class ranked_multiset
+		: public rbtree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, false, true>
+	{
+	public:
+		typedef rbtree<Key, Key, Compare, Allocator, eastl::use_self<Key>, false, false, true> base_type;
+		typedef ranked_multiset<Key, Compare, Allocator>                                       this_type;
+		typedef typename base_type::size_type                                                  size_type;
+		typedef typename base_type::value_type                                                 value_type;
+		typedef typename base_type::iterator                                                   iterator;
+		typedef typename base_type::const_iterator                                             const_iterator;
+		typedef typename base_type::reverse_iterator                                           reverse_iterator;
+		typedef typename base_type::const_reverse_iterator                                     const_reverse_iterator;
+		typedef typename base_type::allocator_type                                             allocator_type;
+		typedef Compare                                                                        value_compare;
+		typedef typename base_type::insert_return_type                                         insert_return_type;
+		// Other types are inherited from the base class.
+
+		using base_type::begin;
+		using base_type::end;
+		using base_type::find;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+		using base_type::insert;
+		using base_type::erase;
+		using base_type::nth;
+		using base_type::rank;
+		using base_type::index_of;
+
+		static_assert(!is_const<value_type>::value, "ranked_multiset<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "ranked_multiset<T> value_type must be non-volatile.");
+
+	protected:
+		using base_type::compare;
+		using base_type::get_compare;
+
+	public:
+		ranked_multiset(const allocator_type& allocator = EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR)
+			: base_type(allocator) { }
+		ranked_multiset(const Compare& compare, const allocator_type& allocator = EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		ranked_multiset(const this_type& x)
+			: base_type(x) { }
+		ranked_multiset(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		ranked_multiset(this_type&& x, const allocator_type& allocator)
+			: base_type(eastl::move(x), allocator) { }
+		ranked_multiset(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+		ranked_multiset(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+			: base_type(ilist.begin(), ilist.end(), Compare(), allocator) { }
+
+		template <typename Iterator>
+		ranked_multiset(Iterator itBegin, Iterator itEnd)
+			: base_type(itBegin, itEnd, Compare(), EASTL_RANKED_MULTISET_DEFAULT_ALLOCATOR) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { return (this_type&)base_type::operator=(ilist); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+
+	public:
+		value_compare value_comp() const { return get_compare(); }
+
+		size_type erase(const Key& k) { return DoErase(k); }
+		template<typename KX, typename Cmp = Compare,
+			eastl::enable_if_t<!eastl::is_convertible_v<KX&&, iterator> && !eastl::is_convertible_v<KX&&, const_iterator>
+			&& eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type erase(KX&& k) { return DoErase(eastl::forward<KX>(k)); }
+
+		size_type count(const Key& key) const { return DoCount(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		size_type count(const KX& key) const { return DoCount(key); }
+
+		eastl::pair<iterator, iterator>             equal_range(const Key& key) { return DoEqualRange(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return DoEqualRange(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range(const KX& key) { return DoEqualRange(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range(const KX& key) const { return DoEqualRange(key); }
+
+		/// equal_range_small
+		/// This is a special version of equal_range which is optimized for the
+		/// case of there being few or no duplicated keys in the tree.
+		eastl::pair<iterator, iterator>             equal_range_small(const Key& key) { return DoEqualRangeSmall(key); }
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const Key& key) const { return DoEqualRangeSmall(key); }
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<iterator, iterator>             equal_range_small(const KX& key) { return DoEqualRangeSmall(key); }
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		eastl::pair<const_iterator, const_iterator> equal_range_small(const KX& key) const { return DoEqualRangeSmall(key); }
+
+	private:
+		template<typename KX>
+		size_type DoErase(KX&& k);
+
+		template<typename KX>
+		size_type DoCount(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRange(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRange(const KX& key) const;
+
+		template<typename KX>
+		eastl::pair<iterator, iterator>             DoEqualRangeSmall(const KX& key);
+		template<typename KX>
+		eastl::pair<const_iterator, const_iterator> DoEqualRangeSmall(const KX& key) const;
+	}; // ranked_multiset
+
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// ranked_set
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline typename ranked_set<Key, Compare, Allocator>::size_type
+	ranked_set<Key, Compare, Allocator>::DoErase(KX&& k)
+	{
+		const iterator it(find(k));
+
+		if(it != end()) // If it exists...
+		{
+			base_type::erase(it);
+			return 1;
+		}
+		return 0;
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_set<Key, Compare, Allocator>::iterator,
+					   typename ranked_set<Key, Compare, Allocator>::iterator>
+	ranked_set<Key, Compare, Allocator>::DoEqualRange(const KX& k)
+	{
+		// The resulting range will either be empty or have one element,
+		// so we do just lower_bound and see if the result is a range of size zero or one.
+		const iterator itLower(lower_bound(k));
+
+		if((itLower == end()) || compare(k, *itLower)) // If at the end or if (k is < itLower)...
+			return eastl::pair<iterator, iterator>(itLower, itLower);
+
+		iterator itUpper(itLower);
+		return eastl::pair<iterator, iterator>(itLower, ++itUpper);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_set<Key, Compare, Allocator>::const_iterator,
+					   typename ranked_set<Key, Compare, Allocator>::const_iterator>
+	ranked_set<Key, Compare, Allocator>::DoEqualRange(const KX& k) const
+	{
+		// See DoEqualRange above for comments.
+		const const_iterator itLower(lower_bound(k));
+
+		if((itLower == end()) || compare(k, *itLower)) // If at the end or if (k is < itLower)...
+			return eastl::pair<const_iterator, const_iterator>(itLower, itLower);
+
+		const_iterator itUpper(itLower);
+		return eastl::pair<const_iterator, const_iterator>(itLower, ++itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/set/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class Compare, class Allocator, class Predicate>
+	typename ranked_set<Key, Compare, Allocator>::size_type erase_if(ranked_set<Key, Compare, Allocator>& c, Predicate predicate)
+	{
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// ranked_multiset
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline typename ranked_multiset<Key, Compare, Allocator>::size_type
+	ranked_multiset<Key, Compare, Allocator>::DoErase(KX&& k)
+	{
+		const eastl::pair<iterator, iterator> range(DoEqualRange(k));
+		const size_type n = index_of(range.second) - index_of(range.first);
+		base_type::erase(range.first, range.second);
+		return n;
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline typename ranked_multiset<Key, Compare, Allocator>::size_type
+	ranked_multiset<Key, Compare, Allocator>::DoCount(const KX& k) const
+	{
+		const eastl::pair<const_iterator, const_iterator> range(DoEqualRange(k));
+		return index_of(range.second) - index_of(range.first);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multiset<Key, Compare, Allocator>::iterator,
+					   typename ranked_multiset<Key, Compare, Allocator>::iterator>
+	ranked_multiset<Key, Compare, Allocator>::DoEqualRange(const KX& k)
+	{
+		return eastl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multiset<Key, Compare, Allocator>::const_iterator,
+					   typename ranked_multiset<Key, Compare, Allocator>::const_iterator>
+	ranked_multiset<Key, Compare, Allocator>::DoEqualRange(const KX& k) const
+	{
+		return eastl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multiset<Key, Compare, Allocator>::iterator,
+					   typename ranked_multiset<Key, Compare, Allocator>::iterator>
+	ranked_multiset<Key, Compare, Allocator>::DoEqualRangeSmall(const KX& k)
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const iterator itLower(lower_bound(k));
+		iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(k, *itUpper))
+			++itUpper;
+
+		return eastl::pair<iterator, iterator>(itLower, itUpper);
+	}
+
+
+	template <typename Key, typename Compare, typename Allocator>
+	template <typename KX>
+	inline eastl::pair<typename ranked_multiset<Key, Compare, Allocator>::const_iterator,
+					   typename ranked_multiset<Key, Compare, Allocator>::const_iterator>
+	ranked_multiset<Key, Compare, Allocator>::DoEqualRangeSmall(const KX& k) const
+	{
+		// We provide alternative version of equal_range here which works faster
+		// for the case where there are at most small number of potential duplicated keys.
+		const const_iterator itLower(lower_bound(k));
+		const_iterator       itUpper(itLower);
+
+		while((itUpper != end()) && !compare(k, *itUpper))
+			++itUpper;
+
+		return eastl::pair<const_iterator, const_iterator>(itLower, itUpper);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////
+	// erase_if
+	//
+	// https://en.cppreference.com/w/cpp/container/multiset/erase_if
+	///////////////////////////////////////////////////////////////////////
+	template <class Key, class Compare, class Allocator, class Predicate>
+	typename ranked_multiset<Key, Compare, Allocator>::size_type erase_if(ranked_multiset<Key, Compare, Allocator>& c, Predicate predicate)
+	{
+		auto oldSize = c.size();
+		for (auto i = c.begin(); i != c.end();)
+		{
+			if (predicate(*i))
+			{
+				i = c.erase(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		return oldSize - c.size();
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
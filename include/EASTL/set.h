@@ -788,6 +788,28 @@ namespace eastl
 #endif
 
 
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::set / pmr::multiset
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename Key, typename Compare = eastl::less<Key>>
+			using set = eastl::set<Key, Compare, polymorphic_allocator>;
+
+			template <typename Key, typename Compare = eastl::less<Key>>
+			using multiset = eastl::multiset<Key, Compare, polymorphic_allocator>;
+		#endif
+	}
+
 } // namespace eastl
 
 
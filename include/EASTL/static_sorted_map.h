@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_STATIC_SORTED_MAP_H
+#define EASTL_STATIC_SORTED_MAP_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/static_sorted_table.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STATIC_SORTED_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_STATIC_SORTED_MAP_DEFAULT_NAME
+		#define EASTL_STATIC_SORTED_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " static_sorted_map" // Unless the user overrides something, this is "EASTL static_sorted_map".
+	#endif
+
+
+	/// EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_STATIC_SORTED_MAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// static_sorted_map
+	///
+	/// A read-only map which is built once from a range of key/value pairs and then
+	/// searched, with the same results as vector_map but much faster lookups in large
+	/// maps. See static_sorted_set and internal/static_sorted_table.h for the details.
+	///
+	/// Neither the keys nor the mapped values can be modified once the map is built,
+	/// so there is no operator[]; use at() or find() instead.
+	///
+	template <typename Key, typename T, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType>
+	class static_sorted_map
+		: public static_sorted_table<Key, eastl::pair<const Key, T>, Compare, Allocator, eastl::use_first<eastl::pair<const Key, T> > >
+	{
+	public:
+		typedef static_sorted_table<Key, eastl::pair<const Key, T>, Compare, Allocator,
+		                            eastl::use_first<eastl::pair<const Key, T> > >  base_type;
+		typedef static_sorted_map<Key, T, Compare, Allocator>                        this_type;
+		typedef typename base_type::size_type                                        size_type;
+		typedef typename base_type::key_type                                         key_type;
+		typedef T                                                                    mapped_type;
+		typedef typename base_type::value_type                                       value_type;
+		typedef typename base_type::iterator                                         iterator;
+		typedef typename base_type::const_iterator                                   const_iterator;
+		typedef typename base_type::allocator_type                                   allocator_type;
+		// Other types are inherited from the base class.
+
+		using base_type::find;
+		using base_type::end;
+
+	public:
+		class value_compare
+		{
+		protected:
+			friend class static_sorted_map;
+			Compare compare;
+			value_compare(Compare c) : compare(c) {}
+
+		public:
+			bool operator()(const value_type& x, const value_type& y) const
+				{ return compare(x.first, y.first); }
+		};
+
+	public:
+		static_sorted_map(const allocator_type& allocator = EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(Compare(), allocator) { }
+		static_sorted_map(const Compare& compare, const allocator_type& allocator = EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		static_sorted_map(const this_type& x)
+			: base_type(x) { }
+		static_sorted_map(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		static_sorted_map(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+
+		template <typename Iterator>
+		static_sorted_map(Iterator itBegin, Iterator itEnd, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_STATIC_SORTED_MAP_DEFAULT_ALLOCATOR)
+			: base_type(itBegin, itEnd, compare, allocator) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { base_type::assign(ilist.begin(), ilist.end()); return *this; }
+
+		void swap(this_type& x) { base_type::swap(x); }
+
+		value_compare value_comp() const { return value_compare(base_type::key_comp()); }
+
+		const T& at(const Key& key) const
+		{
+			const const_iterator it(find(key));
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				if(EASTL_UNLIKELY(it == end()))
+					throw std::out_of_range("static_sorted_map::at key does not exist");
+			#elif EASTL_ASSERT_ENABLED
+				if(EASTL_UNLIKELY(it == end()))
+					EASTL_FAIL_MSG("static_sorted_map::at key does not exist");
+			#endif
+
+			return it->second;
+		}
+
+		template<typename KX, typename Cmp = Compare, eastl::enable_if_t<eastl::detail::is_transparent_comparison_v<Cmp>, bool> = true>
+		const T& at(const KX& key) const
+		{
+			const const_iterator it(find(key));
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				if(EASTL_UNLIKELY(it == end()))
+					throw std::out_of_range("static_sorted_map::at key does not exist");
+			#elif EASTL_ASSERT_ENABLED
+				if(EASTL_UNLIKELY(it == end()))
+					EASTL_FAIL_MSG("static_sorted_map::at key does not exist");
+			#endif
+
+			return it->second;
+		}
+
+	}; // static_sorted_map
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Compare, typename Allocator>
+	inline void swap(static_sorted_map<Key, T, Compare, Allocator>& a, static_sorted_map<Key, T, Compare, Allocator>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
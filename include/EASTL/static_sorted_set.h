@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_STATIC_SORTED_SET_H
+#define EASTL_STATIC_SORTED_SET_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/internal/static_sorted_table.h>
+#include <EASTL/functional.h>
+#include <EASTL/utility.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STATIC_SORTED_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_STATIC_SORTED_SET_DEFAULT_NAME
+		#define EASTL_STATIC_SORTED_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " static_sorted_set" // Unless the user overrides something, this is "EASTL static_sorted_set".
+	#endif
+
+
+	/// EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR
+		#define EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_STATIC_SORTED_SET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// static_sorted_set
+	///
+	/// A read-only set which is built once from a range of keys and then searched
+	/// with find, lower_bound, upper_bound and the like, with the same results as
+	/// vector_set. The keys are stored in a cache-friendly search order rather than
+	/// sorted order, which makes lookups in large sets much faster than vector_set
+	/// or set. See internal/static_sorted_table.h for the details.
+	///
+	/// The usual way to use it is to build a vector_set (or any other range) while
+	/// the data is changing and then freeze it into a static_sorted_set once the
+	/// data is only going to be read:
+	///     vector_set<int> building;
+	///     ...
+	///     static_sorted_set<int> frozen(building.begin(), building.end());
+	///
+	/// The source range needn't be sorted or free of duplicates; of several
+	/// equivalent keys, the first is kept. Iteration is in sorted order.
+	///
+	template <typename Key, typename Compare = eastl::less<Key>, typename Allocator = EASTLAllocatorType>
+	class static_sorted_set
+		: public static_sorted_table<Key, Key, Compare, Allocator, eastl::use_self<Key> >
+	{
+	public:
+		typedef static_sorted_table<Key, Key, Compare, Allocator, eastl::use_self<Key> > base_type;
+		typedef static_sorted_set<Key, Compare, Allocator>                                this_type;
+		typedef typename base_type::size_type                                             size_type;
+		typedef typename base_type::value_type                                            value_type;
+		typedef typename base_type::iterator                                              iterator;
+		typedef typename base_type::const_iterator                                        const_iterator;
+		typedef typename base_type::allocator_type                                        allocator_type;
+		typedef Compare                                                                   value_compare;
+		// Other types are inherited from the base class.
+
+		static_assert(!is_const<value_type>::value, "static_sorted_set<T> value_type must be non-const.");
+		static_assert(!is_volatile<value_type>::value, "static_sorted_set<T> value_type must be non-volatile.");
+
+	public:
+		static_sorted_set(const allocator_type& allocator = EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR)
+			: base_type(Compare(), allocator) { }
+		static_sorted_set(const Compare& compare, const allocator_type& allocator = EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR)
+			: base_type(compare, allocator) { }
+		static_sorted_set(const this_type& x)
+			: base_type(x) { }
+		static_sorted_set(this_type&& x)
+			: base_type(eastl::move(x)) { }
+		static_sorted_set(std::initializer_list<value_type> ilist, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR)
+			: base_type(ilist.begin(), ilist.end(), compare, allocator) { }
+
+		template <typename Iterator>
+		static_sorted_set(Iterator itBegin, Iterator itEnd, const Compare& compare = Compare(), const allocator_type& allocator = EASTL_STATIC_SORTED_SET_DEFAULT_ALLOCATOR)
+			: base_type(itBegin, itEnd, compare, allocator) { }
+
+		this_type& operator=(const this_type& x) { return (this_type&)base_type::operator=(x); }
+		this_type& operator=(this_type&& x) { return (this_type&)base_type::operator=(eastl::move(x)); }
+		this_type& operator=(std::initializer_list<value_type> ilist) { base_type::assign(ilist.begin(), ilist.end()); return *this; }
+
+		void swap(this_type& x) { base_type::swap(x); }
+
+		value_compare value_comp() const { return base_type::key_comp(); }
+
+	}; // static_sorted_set
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename Compare, typename Allocator>
+	inline void swap(static_sorted_set<Key, Compare, Allocator>& a, static_sorted_set<Key, Compare, Allocator>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
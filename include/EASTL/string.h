@@ -396,7 +396,7 @@ namespace eastl
 
 			Layout()                                                  { ResetToSSO(); } // start as SSO by default
 			Layout(const Layout& other)                               { Copy(*this, other); }
-			Layout(Layout&& other)                                    { Move(*this, other); }
+			Layout(Layout&& other)                                    { Copy(*this, other); } // Not Move, which would swap the uninitialized bytes of this into other.
 			Layout& operator=(const Layout& other)                    { Copy(*this, other); return *this; }
 			Layout& operator=(Layout&& other)                         { Move(*this, other); return *this; }
 
@@ -3862,11 +3862,7 @@ namespace eastl
 	{
 		size_t operator()(const basic_string<char, Allocator>& x) const
 		{
-			const unsigned char* p = (const unsigned char*)x.c_str(); // To consider: limit p to at most 256 chars.
-			unsigned int c, result = 2166136261U; // We implement an FNV-like string hash.
-			while((c = *p++) != 0) // Using '!=' disables compiler warnings.
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
@@ -3876,11 +3872,7 @@ namespace eastl
 		{
 			size_t operator()(const basic_string<char8_t, Allocator>& x) const
 			{
-				const char8_t* p = (const char8_t*)x.c_str();
-				unsigned int c, result = 2166136261U;
-				while((c = *p++) != 0)
-					result = (result * 16777619) ^ c;
-				return (size_t)result;
+				return internal::hash_string(x.data(), (size_t)x.size());
 			}
 		};
 	#endif
@@ -3890,11 +3882,7 @@ namespace eastl
 	{
 		size_t operator()(const basic_string<char16_t, Allocator>& x) const
 		{
-			const char16_t* p = x.c_str();
-			unsigned int c, result = 2166136261U;
-			while((c = *p++) != 0)
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
@@ -3903,11 +3891,7 @@ namespace eastl
 	{
 		size_t operator()(const basic_string<char32_t, Allocator>& x) const
 		{
-			const char32_t* p = x.c_str();
-			unsigned int c, result = 2166136261U;
-			while((c = (unsigned int)*p++) != 0)
-				result = (result * 16777619) ^ c;
-			return (size_t)result;
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
@@ -3917,11 +3901,7 @@ namespace eastl
 		{
 			size_t operator()(const basic_string<wchar_t, Allocator>& x) const
 			{
-				const wchar_t* p = x.c_str();
-				unsigned int c, result = 2166136261U;
-				while((c = (unsigned int)*p++) != 0)
-					result = (result * 16777619) ^ c;
-				return (size_t)result;
+				return internal::hash_string(x.data(), (size_t)x.size());
 			}
 		};
 	#endif
@@ -4134,6 +4114,43 @@ namespace eastl
 		// size_type.
 		return static_cast<typename basic_string<CharT, Allocator>::size_type>(numRemoved);
 	}
+
+
+	/// is_trivially_relocatable
+	///
+	/// A string holds no pointers into itself, so it can be relocated bytewise
+	/// if its allocator can. fixed_string can't, as it points to its own buffer.
+	///
+	template <typename T, typename Allocator>
+	struct is_trivially_relocatable<basic_string<T, Allocator>>
+		: public is_trivially_relocatable<Allocator> {};
+
+
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::basic_string / pmr::string / pmr::wstring / ...
+		///
+		/// Allocate from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using them requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename T>
+			using basic_string = eastl::basic_string<T, polymorphic_allocator>;
+		#endif
+
+		typedef eastl::basic_string<char,     polymorphic_allocator> string;
+		typedef eastl::basic_string<wchar_t,  polymorphic_allocator> wstring;
+		typedef eastl::basic_string<char8_t,  polymorphic_allocator> u8string;
+		typedef eastl::basic_string<char16_t, polymorphic_allocator> u16string;
+		typedef eastl::basic_string<char32_t, polymorphic_allocator> u32string;
+	}
+
 } // namespace eastl
 
 
@@ -606,12 +606,7 @@ namespace eastl
 	{
 		size_t operator()(const string_view& x) const
 		{
-			string_view::const_iterator p = x.cbegin();
-			string_view::const_iterator end = x.cend();
-			uint32_t result = 2166136261U; // We implement an FNV-like string hash.
-			while (p != end)
-				result = (result * 16777619) ^ (uint8_t)*p++;
-			return (size_t)result;
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
@@ -620,12 +615,7 @@ namespace eastl
 		{
 			size_t operator()(const u8string_view& x) const
 			{
-				u8string_view::const_iterator p = x.cbegin();
-				u8string_view::const_iterator end = x.cend();
-				uint32_t result = 2166136261U;
-				while (p != end)
-					result = (result * 16777619) ^ (uint8_t)*p++;
-				return (size_t)result;
+				return internal::hash_string(x.data(), (size_t)x.size());
 			}
 		};
 	#endif
@@ -634,12 +624,7 @@ namespace eastl
 	{
 		size_t operator()(const u16string_view& x) const
 		{
-			u16string_view::const_iterator p = x.cbegin();
-			u16string_view::const_iterator end = x.cend();
-			uint32_t result = 2166136261U;
-			while (p != end)
-				result = (result * 16777619) ^ (uint16_t)*p++;
-			return (size_t)result;
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
@@ -647,12 +632,7 @@ namespace eastl
 	{
 		size_t operator()(const u32string_view& x) const
 		{
-			u32string_view::const_iterator p = x.cbegin();
-			u32string_view::const_iterator end = x.cend();
-			uint32_t result = 2166136261U;
-			while (p != end)
-				result = (result * 16777619) ^ (uint32_t)*p++;
-			return (size_t)result;
+			return internal::hash_string(x.data(), (size_t)x.size());
 		}
 	};
 
@@ -661,12 +641,7 @@ namespace eastl
 		{
 			size_t operator()(const wstring_view& x) const
 			{
-				wstring_view::const_iterator p = x.cbegin();
-				wstring_view::const_iterator end = x.cend();
-				uint32_t result = 2166136261U;
-				while (p != end)
-					result = (result * 16777619) ^ (uint32_t)*p++;
-				return (size_t)result;
+				return internal::hash_string(x.data(), (size_t)x.size());
 			}
 		};
 	#endif
@@ -0,0 +1,198 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the following
+//     thread_caching_allocator
+//
+// thread_caching_allocator is a general-purpose allocator for programs in which
+// many threads allocate and free container memory at once. Small blocks come
+// from per-thread caches which need no locking, and move between threads in
+// batches through a central free list per size class.
+//
+// It can be used as the allocator of individual containers, or as the default
+// allocator of all of EASTL by defining EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT
+// as 1, which makes it EASTLAllocatorType.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_THREAD_CACHING_ALLOCATOR_H
+#define EASTL_THREAD_CACHING_ALLOCATOR_H
+
+
+#include <EASTL/internal/config.h>
+#include <EASTL/type_traits.h>
+#include <stddef.h>
+
+#if defined(EA_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME
+	///
+	/// Defines a default allocator name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME
+		#define EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " thread_caching_allocator" // Unless the user overrides something, this is "EASTL thread_caching_allocator".
+	#endif
+
+
+	/// EASTL_THREAD_CACHING_ALLOCATOR_TLS_ENABLED
+	///
+	/// Defined as 0 or 1. When 0, there are no per-thread caches, and every
+	/// allocation of a small block locks the central free list of its size class.
+	/// This is for platforms which don't support thread_local.
+	///
+	#ifndef EASTL_THREAD_CACHING_ALLOCATOR_TLS_ENABLED
+		#if defined(EA_COMPILER_NO_THREAD_LOCAL)
+			#define EASTL_THREAD_CACHING_ALLOCATOR_TLS_ENABLED 0
+		#else
+			#define EASTL_THREAD_CACHING_ALLOCATOR_TLS_ENABLED 1
+		#endif
+	#endif
+
+
+
+	/// thread_caching_allocator
+	///
+	/// Blocks of up to 8 KB are rounded up to one of 32 size classes, with at most
+	/// 25% waste, and carved out of 64 KB chunks, each of which holds a single size
+	/// class. Each thread keeps a free list per size class. When a thread's list is
+	/// empty it takes a batch of blocks from the central list of the size class, and
+	/// when the list grows past two batches it returns one batch. Moving a batch
+	/// takes a single short lock, so threads rarely contend, and a block freed by a
+	/// thread other than the one which allocated it simply joins the freeing
+	/// thread's cache. The caches of exiting threads are returned to the central lists.
+	///
+	/// Chunks are kept for reuse by their size class and are not returned to the
+	/// system. Larger blocks are allocated from the system directly, with a small
+	/// header just before them, and are freed directly.
+	///
+	/// Unlike eastl::allocator, deallocate doesn't use its size argument, as some
+	/// callers pass 0. Chunks are aligned to 64 KB and recorded in a bitmap, so a
+	/// block in a chunk is found from the chunk's header by masking its address, and
+	/// any other block is a large one.
+	///
+	/// Alignments of up to 64 are served from the size classes, and larger ones from
+	/// the system.
+	///
+	/// All thread_caching_allocators share the same caches and compare equal.
+	///
+	/// Example usage:
+	///     eastl::list<Widget, eastl::thread_caching_allocator> widgetList;
+	///
+	class EASTL_API thread_caching_allocator
+	{
+	public:
+		EASTL_ALLOCATOR_EXPLICIT thread_caching_allocator(const char* pName = EASTL_NAME_VAL(EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME));
+		thread_caching_allocator(const thread_caching_allocator& x);
+		thread_caching_allocator(const thread_caching_allocator& x, const char* pName);
+
+		thread_caching_allocator& operator=(const thread_caching_allocator& x);
+
+		void* allocate(size_t n, int flags = 0);
+		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+		void  deallocate(void* p, size_t n);
+
+		const char* get_name() const;
+		void        set_name(const char* pName);
+
+		/// Returns the blocks cached by the calling thread to the central free lists,
+		/// for threads which are about to sleep for a long time.
+		static void flush_thread_cache();
+
+	protected:
+		#if EASTL_NAME_ENABLED
+			const char* mpName; // Debug name, used to track memory.
+		#endif
+	};
+
+	inline bool operator==(const thread_caching_allocator&, const thread_caching_allocator&)
+	{
+		return true; // All thread_caching_allocators are considered equal, as they share the same caches.
+	}
+
+#if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
+	inline bool operator!=(const thread_caching_allocator&, const thread_caching_allocator&)
+	{
+		return false; // All thread_caching_allocators are considered equal, as they share the same caches.
+	}
+#endif
+
+	template <> struct is_trivially_relocatable<thread_caching_allocator> : public true_type {};
+
+
+	/// GetDefaultThreadCachingAllocator
+	///
+	/// Returns the default thread_caching_allocator instance. This is
+	/// EASTLAllocatorDefault when EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT is 1.
+	///
+	EASTL_API thread_caching_allocator* GetDefaultThreadCachingAllocator();
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// thread_caching_allocator
+	///////////////////////////////////////////////////////////////////////
+
+	inline thread_caching_allocator::thread_caching_allocator(const char* EASTL_NAME(pName))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME;
+		#endif
+	}
+
+
+	inline thread_caching_allocator::thread_caching_allocator(const thread_caching_allocator& EASTL_NAME(x))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = x.mpName;
+		#endif
+	}
+
+
+	inline thread_caching_allocator::thread_caching_allocator(const thread_caching_allocator&, const char* EASTL_NAME(pName))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME;
+		#endif
+	}
+
+
+	inline thread_caching_allocator& thread_caching_allocator::operator=(const thread_caching_allocator& EASTL_NAME(x))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = x.mpName;
+		#endif
+		return *this;
+	}
+
+
+	inline const char* thread_caching_allocator::get_name() const
+	{
+		#if EASTL_NAME_ENABLED
+			return mpName;
+		#else
+			return EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME;
+		#endif
+	}
+
+
+	inline void thread_caching_allocator::set_name(const char* EASTL_NAME(pName))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName;
+		#endif
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
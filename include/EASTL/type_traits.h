@@ -159,6 +159,7 @@
 // EASTL extension type traits
 //    is_aligned                            Defined as true if the type has alignment requirements greater than default alignment, which is taken to be 8. is_aligned is not found in Boost nor C++11, though alignment_of is.
 //    union_cast                            Allows for easy-to-read casting between types that are unrelated but have binary equivalence. The classic use case is converting between float and int32_t bit representations.
+//    is_trivially_relocatable              T can be moved to another address by copying its bytes, without calling its move constructor or destructor.
 //    yes_type
 //    no_type
 //    is_swappable                          Found in <EASTL/utility.h>
@@ -718,6 +718,16 @@ namespace eastl
 	}
 
 
+	/// is_trivially_relocatable
+	///
+	/// A unique_ptr is a pointer and a deleter, so it can be relocated bytewise
+	/// if its deleter can.
+	///
+	template <typename T, typename Deleter>
+	struct is_trivially_relocatable<unique_ptr<T, Deleter>>
+		: public is_trivially_relocatable<Deleter> {};
+
+
 } // namespace eastl
 
 
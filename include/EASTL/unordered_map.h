@@ -29,7 +29,7 @@ namespace eastl
 				  typename Hash = eastl::hash<Key>,
 				  typename Predicate = eastl::equal_to<Key>,
 				  typename Allocator = EASTLAllocatorType,
-				  bool bCacheHashCode = false>
+				  bool bCacheHashCode = hash_code_caching_default<Key>::value>
 		using unordered_map = hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>;
     #endif
 
@@ -45,7 +45,7 @@ namespace eastl
 				  typename Hash = eastl::hash<Key>,
 				  typename Predicate = eastl::equal_to<Key>,
 				  typename Allocator = EASTLAllocatorType,
-				  bool bCacheHashCode = false>
+				  bool bCacheHashCode = hash_code_caching_default<Key>::value>
 		using unordered_multimap = hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>;
     #endif
 
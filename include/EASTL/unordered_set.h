@@ -29,7 +29,7 @@ namespace eastl
 				  typename Hash = eastl::hash<Value>,
 				  typename Predicate = eastl::equal_to<Value>,
 				  typename Allocator = EASTLAllocatorType,
-				  bool bCacheHashCode = false>
+				  bool bCacheHashCode = hash_code_caching_default<Value>::value>
 		using unordered_set = hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>;
 	#endif
 
@@ -43,7 +43,7 @@ namespace eastl
 				  typename Hash = eastl::hash<Value>,
 				  typename Predicate = eastl::equal_to<Value>,
 				  typename Allocator = EASTLAllocatorType,
-				  bool bCacheHashCode = false>
+				  bool bCacheHashCode = hash_code_caching_default<Value>::value>
 		using unordered_multiset = hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>;
 	#endif
 
@@ -637,6 +637,15 @@ namespace eastl
 	#define EASTL_PAIR_CONFORMANCE 1
 
 
+	/// is_trivially_relocatable
+	///
+	/// A pair can be relocated bytewise if both of its members can.
+	///
+	template <typename T1, typename T2>
+	struct is_trivially_relocatable<pair<T1, T2>>
+		: public integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
+
 
 	/// use_self
 	///
@@ -46,6 +46,7 @@
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <new>
 #include <stddef.h>
+#include <string.h> // memcpy
 #if EASTL_EXCEPTIONS_ENABLED
 	#include <stdexcept> // std::out_of_range, std::length_error, std::logic_error.
 #endif
@@ -418,6 +419,24 @@ namespace eastl
 
 		void DoGrow(size_type newCapacity);
 
+		// Growth support. DoTryExpand grows the memory block in place, if the allocator supports
+		// try_expand. DoTryReallocate moves the block with the allocator's reallocate, which
+		// is possible only for trivially relocatable values. DoRelocate moves values to a new
+		// block, bytewise if they are trivially relocatable, after which DoDestroyRelocated
+		// ends the lifetime of the source values.
+		bool DoTryExpand(size_type newCapacity);
+		bool DoTryReallocate(size_type newCapacity);
+		bool DoTryReallocate(size_type newCapacity, true_type);
+		bool DoTryReallocate(size_type newCapacity, false_type);
+
+		pointer DoRelocate(pointer first, pointer last, pointer dest);
+		pointer DoRelocate(pointer first, pointer last, pointer dest, true_type);
+		pointer DoRelocate(pointer first, pointer last, pointer dest, false_type);
+
+		void DoDestroyRelocated(pointer first, pointer last);
+		void DoDestroyRelocated(pointer first, pointer last, true_type);
+		void DoDestroyRelocated(pointer first, pointer last, false_type);
+
 		void DoSwap(this_type& x);
 
 	}; // class vector
@@ -899,15 +918,17 @@ namespace eastl
 
 			shrink_to_fit();
 		}
-		else // Else new capacity > size.
+		else if(n > (size_type)(internalCapacityPtr() - mpBegin)) // Else if new capacity > capacity...
+			DoGrow(n);
+		else // Else size < new capacity < capacity.
 		{
-			pointer const pNewData = DoRealloc(n, mpBegin, mpEnd, should_move_tag());
-			eastl::destruct(mpBegin, mpEnd);
+			pointer const pNewData = DoAllocate(n);
+			pointer const pNewEnd  = DoRelocate(mpBegin, mpEnd, pNewData);
+			DoDestroyRelocated(mpBegin, mpEnd);
 			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
 
-			const ptrdiff_t nPrevSize = mpEnd - mpBegin;
 			mpBegin    = pNewData;
-			mpEnd      = pNewData + nPrevSize;
+			mpEnd      = pNewEnd;
 			internalCapacityPtr() = mpBegin + n;
 		}
 	}
@@ -1796,11 +1817,14 @@ namespace eastl
 	template <typename T, typename Allocator>
 	void vector<T, Allocator>::DoGrow(size_type newCapacity)
 	{
+		if(DoTryExpand(newCapacity) || DoTryReallocate(newCapacity))
+			return;
+
 		pointer const pNewData = DoAllocate(newCapacity);
 
-		pointer pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData);
+		pointer pNewEnd = DoRelocate(mpBegin, mpEnd, pNewData);
 
-		eastl::destruct(mpBegin, mpEnd);
+		DoDestroyRelocated(mpBegin, mpEnd);
 		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
 
 		mpBegin    = pNewData;
@@ -1809,6 +1833,118 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	inline bool vector<T, Allocator>::DoTryExpand(size_type newCapacity)
+	{
+		// The values stay where they are, so this works for any value_type, and references
+		// to the values (e.g. arguments to push_back) remain valid. For allocators which
+		// don't support try_expand this is simply false.
+		const size_type nCapacity = (size_type)(internalCapacityPtr() - mpBegin);
+
+		if(mpBegin && allocator_try_expand(internalAllocator(), mpBegin, nCapacity * sizeof(T), newCapacity * sizeof(T)))
+		{
+			internalCapacityPtr() = mpBegin + newCapacity;
+			return true;
+		}
+
+		return false;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool vector<T, Allocator>::DoTryReallocate(size_type newCapacity)
+	{
+		return DoTryReallocate(newCapacity, eastl::is_trivially_relocatable<value_type>());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool vector<T, Allocator>::DoTryReallocate(size_type newCapacity, true_type)
+	{
+		// Blocks with a larger alignment come from the aligned allocate, which reallocate doesn't support.
+		if(mpBegin && (EASTL_ALIGN_OF(T) <= EASTL_ALLOCATOR_MIN_ALIGNMENT))
+		{
+			const size_type nCapacity = (size_type)(internalCapacityPtr() - mpBegin);
+			pointer const   pNewData  = (pointer)allocator_reallocate(internalAllocator(), mpBegin, nCapacity * sizeof(T), newCapacity * sizeof(T));
+
+			if(pNewData)
+			{
+				mpEnd      = pNewData + (mpEnd - mpBegin);
+				mpBegin    = pNewData;
+				internalCapacityPtr() = pNewData + newCapacity;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline bool vector<T, Allocator>::DoTryReallocate(size_type, false_type)
+	{
+		return false;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename vector<T, Allocator>::pointer
+	vector<T, Allocator>::DoRelocate(pointer first, pointer last, pointer dest)
+	{
+		return DoRelocate(first, last, dest, eastl::is_trivially_relocatable<value_type>());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename vector<T, Allocator>::pointer
+	vector<T, Allocator>::DoRelocate(pointer first, pointer last, pointer dest, true_type)
+	{
+		const size_t n = (size_t)(last - first);
+		EASTL_ASSERT(!n || dest);
+
+		// memcpy requires valid pointers even for zero bytes, and first is NULL for a vector which hasn't
+		// allocated. Checking dest also tells the compiler that it isn't NULL, which it can't otherwise see
+		// for allocators which may fail to allocate, such as fixed allocators without overflow.
+		if(n && dest)
+			memcpy((void*)dest, (const void*)first, n * sizeof(T));
+
+		return dest + n;
+	}
+
+
+	template <typename T, typename Allocator>
+	inline typename vector<T, Allocator>::pointer
+	vector<T, Allocator>::DoRelocate(pointer first, pointer last, pointer dest, false_type)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			return eastl::uninitialized_move_if_noexcept(first, last, dest);
+		#else
+			return eastl::uninitialized_move(first, last, dest);
+		#endif
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::DoDestroyRelocated(pointer first, pointer last)
+	{
+		DoDestroyRelocated(first, last, eastl::is_trivially_relocatable<value_type>());
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::DoDestroyRelocated(pointer, pointer, true_type)
+	{
+		// The values now live in their new location; their bytes here are simply discarded.
+	}
+
+
+	template <typename T, typename Allocator>
+	inline void vector<T, Allocator>::DoDestroyRelocated(pointer first, pointer last, false_type)
+	{
+		eastl::destruct(first, last);
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void vector<T, Allocator>::DoSwap(this_type& x)
 	{
@@ -1828,13 +1964,21 @@ namespace eastl
 			const size_type nGrowCapacity = GetNewCapacity(nPrevSize);
 			EASTL_ASSERT_MSG(nPrevSize <= eastl::numeric_limits<size_type>::max() - n, "Size overflow: Attempting to insert more elements than can fit in a vector.");
 			const size_type nNewCapacity = eastl::max(nGrowCapacity, nPrevSize + n);
+
+			if(DoTryExpand(nNewCapacity)) // We don't reallocate, as value may refer to one of our values.
+			{
+				eastl::uninitialized_fill_n(mpEnd, n, value);
+				mpEnd += n;
+				return;
+			}
+
 			pointer const pNewData = DoAllocate(nNewCapacity);
 
 			#if EASTL_EXCEPTIONS_ENABLED
 				pointer pNewEnd = pNewData; // Assign pNewEnd a value here in case the copy throws.
 				try
 				{
-					pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData);
+					pNewEnd = DoRelocate(mpBegin, mpEnd, pNewData);
 				}
 				catch(...)
 				{
@@ -1843,13 +1987,13 @@ namespace eastl
 					throw;
 				}
 			#else
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, mpEnd, pNewData);
+				pointer pNewEnd = DoRelocate(mpBegin, mpEnd, pNewData);
 			#endif
 
 			eastl::uninitialized_fill_n(pNewEnd, n, value);
 			pNewEnd += n;
 
-			eastl::destruct(mpBegin, mpEnd);
+			DoDestroyRelocated(mpBegin, mpEnd);
 			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
 
 			mpBegin    = pNewData;
@@ -1871,37 +2015,11 @@ namespace eastl
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowCapacity = GetNewCapacity(nPrevSize);
 			EASTL_ASSERT_MSG(nPrevSize <= eastl::numeric_limits<size_type>::max() - n, "Size overflow: Attempting to insert more elements than can fit in a vector.");
-			const size_type nNewCapacity = eastl::max(nGrowCapacity, nPrevSize + n);
-			pointer const pNewData = DoAllocate(nNewCapacity);
-
-			#if EASTL_EXCEPTIONS_ENABLED
-				pointer pNewEnd = pNewData;  // Assign pNewEnd a value here in case the copy throws.
-				try { pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData); }
-				catch (...)
-				{
-					eastl::destruct(pNewData, pNewEnd);
-					DoFree(pNewData, nNewCapacity);
-					throw;
-				}
-			#else
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, mpEnd, pNewData);
-			#endif
-
-			eastl::uninitialized_value_construct_n(pNewEnd, n);
-			pNewEnd += n;
-
-			eastl::destruct(mpBegin, mpEnd);
-			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
-
-			mpBegin = pNewData;
-			mpEnd = pNewEnd;
-			internalCapacityPtr() = pNewData + nNewCapacity;
-		}
-		else
-		{
-			eastl::uninitialized_value_construct_n(mpEnd, n);
-			mpEnd += n;
+			DoGrow(eastl::max(nGrowCapacity, nPrevSize + n)); // There is no argument which may refer to our values, so the block may be reallocated.
 		}
+
+		eastl::uninitialized_value_construct_n(mpEnd, n);
+		mpEnd += n;
 	}
 
 	template <typename T, typename Allocator>
@@ -1952,8 +2070,8 @@ namespace eastl
 					// call eastl::destruct on the entire range if only the first part of the range was constructed.
 					detail::allocator_construct(internalAllocator(), pNewData + nPosSize, eastl::forward<Args>(args)...); // Because the old data is potentially being moved rather than copied, we need to move.
 					pNewEnd = NULL;                                                                             // Set to NULL so that in catch we can tell the exception occurred during the next call.
-					pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, destPosition, pNewData);           // the value first, because it might possibly be a reference to the old data being moved.
-					pNewEnd = eastl::uninitialized_move_if_noexcept(destPosition, mpEnd, ++pNewEnd);
+					pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);                                      // the value first, because it might possibly be a reference to the old data being moved.
+					pNewEnd = DoRelocate(destPosition, mpEnd, ++pNewEnd);
 				}
 				catch(...)
 				{
@@ -1966,11 +2084,11 @@ namespace eastl
 				}
 			#else
 				detail::allocator_construct(internalAllocator(), pNewData + nPosSize, eastl::forward<Args>(args)...); // Because the old data is potentially being moved rather than copied, we need to move
-				pointer pNewEnd = eastl::uninitialized_move(mpBegin, destPosition, pNewData);					// the value first, because it might possibly be a reference to the old data being moved.
-				pNewEnd = eastl::uninitialized_move(destPosition, mpEnd, ++pNewEnd);
+				pointer pNewEnd = DoRelocate(mpBegin, destPosition, pNewData);					// the value first, because it might possibly be a reference to the old data being moved.
+				pNewEnd = DoRelocate(destPosition, mpEnd, ++pNewEnd);
 			#endif
 
-			eastl::destruct(mpBegin, mpEnd);
+			DoDestroyRelocated(mpBegin, mpEnd);
 			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
 
 			mpBegin    = pNewData;
@@ -1986,6 +2104,14 @@ namespace eastl
 	{
 		const size_type nPrevSize = size_type(mpEnd - mpBegin);
 		const size_type nNewCapacity = GetNewCapacity(nPrevSize);
+
+		if(DoTryExpand(nNewCapacity)) // We don't reallocate, as args may refer to one of our values.
+		{
+			detail::allocator_construct(internalAllocator(), mpEnd, eastl::forward<Args>(args)...);
+			++mpEnd;
+			return;
+		}
+
 		pointer const   pNewData  = DoAllocate(nNewCapacity);
 
 		#if EASTL_EXCEPTIONS_ENABLED
@@ -2002,7 +2128,7 @@ namespace eastl
 
 			try
 			{
-				pNewEnd = eastl::uninitialized_move_if_noexcept(mpBegin, mpEnd, pNewData);
+				pNewEnd = DoRelocate(mpBegin, mpEnd, pNewData);
 				pNewEnd++;
 			}
 			catch(...)
@@ -2017,11 +2143,11 @@ namespace eastl
 			// Because args... may potentially reference an element (or its sub-object) of this vector, we need to construct
 			// the new element first, prior to moving it (leaving it in an unspecified state) with the call to uninitialized_move.
 			detail::allocator_construct(internalAllocator(), pNewData + nPrevSize, eastl::forward<Args>(args)...);
-			pointer pNewEnd = eastl::uninitialized_move(mpBegin, mpEnd, pNewData);
+			pointer pNewEnd = DoRelocate(mpBegin, mpEnd, pNewData);
 			pNewEnd++;
 		#endif
 
-		eastl::destruct(mpBegin, mpEnd);
+		DoDestroyRelocated(mpBegin, mpEnd);
 		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
 
 		mpBegin    = pNewData;
@@ -2263,6 +2389,36 @@ namespace eastl
 		return static_cast<typename vector<T, Allocator>::size_type>(numRemoved);
 	}
 
+
+	/// is_trivially_relocatable
+	///
+	/// A vector holds no pointers into itself, so it can be relocated bytewise
+	/// if its allocator can. fixed_vector can't, as it points to its own buffer.
+	///
+	template <typename T, typename Allocator>
+	struct is_trivially_relocatable<vector<T, Allocator>>
+		: public is_trivially_relocatable<Allocator> {};
+
+
+	///////////////////////////////////////////////////////////////////////
+	// pmr
+	///////////////////////////////////////////////////////////////////////
+
+	namespace pmr
+	{
+		class polymorphic_allocator;
+
+		/// pmr::vector
+		///
+		/// Allocates from a memory_resource chosen at runtime, which is given as the
+		/// allocator. Using it requires <EASTL/memory_resource.h>.
+		///
+		#if !defined(EA_COMPILER_NO_TEMPLATE_ALIASES)
+			template <typename T>
+			using vector = eastl::vector<T, polymorphic_allocator>;
+		#endif
+	}
+
 } // namespace eastl
 
 
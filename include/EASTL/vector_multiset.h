@@ -36,6 +36,7 @@
 #include <EASTL/vector.h>
 #include <EASTL/utility.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/internal/sorted_vector_merge.h>
 #include <EASTL/initializer_list.h>
 #include <stddef.h>
 
@@ -192,6 +193,9 @@ namespace eastl
 		template <typename InputIterator>
 		void insert(InputIterator first, InputIterator last);
 
+		void merge(this_type& source);     // Moves all the elements of source into this container, after any elements with equal keys.
+		void merge(this_type&& source);
+
 		template <typename Iter = iterator, typename eastl::enable_if<!eastl::is_same_v<Iter, const_iterator>, int>::type = 0>
 		iterator		 erase(iterator position) { return erase(const_iterator(position)); }
 		iterator         erase(const_iterator position);
@@ -576,16 +580,33 @@ namespace eastl
 	template <typename InputIterator>
 	inline void vector_multiset<K, C, A, RAC>::insert(InputIterator first, InputIterator last)
 	{
-		// To consider: Improve the speed of this by getting the length of the 
-		//              input range and resizing our container to that size
-		//              before doing the insertions. We can't use reserve
-		//              because we don't know if we are using a vector or not.
-		//              Alternatively, force the user to do the reservation.
-		// To consider: When inserting values that come from a container
-		//              like this container, use the property that they are 
-		//              known to be sorted and speed up the inserts here.
-		for(; first != last; ++first)                               
-			base_type::insert(upper_bound(*first), *first);
+		// We append the values and then sort and merge them into place all at once, which
+		// is O(n + k log k) instead of the O(n * k) of inserting them one at a time.
+		const size_type nOldSize = base_type::size();
+
+		base_type::insert(base_type::end(), first, last);
+		Internal::merge_sorted_tail<base_type>(*this, nOldSize, value_comp(), false);
+	}
+
+
+	template <typename K, typename C, typename A, typename RAC>
+	inline void vector_multiset<K, C, A, RAC>::merge(this_type& source)
+	{
+		if(&source != this)
+		{
+			const size_type nOldSize = base_type::size();
+
+			base_type::insert(base_type::end(), eastl::make_move_iterator(source.begin()), eastl::make_move_iterator(source.end()));
+			source.clear();
+			Internal::merge_sorted_tail<base_type>(*this, nOldSize, value_comp(), false);
+		}
+	}
+
+
+	template <typename K, typename C, typename A, typename RAC>
+	inline void vector_multiset<K, C, A, RAC>::merge(this_type&& source)
+	{
+		merge(source);
 	}
 
 
@@ -0,0 +1,165 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/arena_allocator.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+
+namespace eastl
+{
+
+	arena::arena(size_t nChunkSize, const EASTLAllocatorType& allocator)
+		: mpCurrent(NULL)
+		, mpEnd(NULL)
+		, mpChunk(NULL)
+		, mpSpareChunks(NULL)
+		, mpBuffer(NULL)
+		, mnBufferSize(0)
+		, mnChunkSize(nChunkSize)
+		, mnChunkCount(0)
+		, mAllocator(allocator)
+	{
+	}
+
+
+	arena::arena(void* pBuffer, size_t nBufferSize, size_t nChunkSize, const EASTLAllocatorType& allocator)
+		: mpCurrent(static_cast<char*>(pBuffer))
+		, mpEnd(static_cast<char*>(pBuffer) + nBufferSize)
+		, mpChunk(NULL)
+		, mpSpareChunks(NULL)
+		, mpBuffer(static_cast<char*>(pBuffer))
+		, mnBufferSize(nBufferSize)
+		, mnChunkSize(nChunkSize)
+		, mnChunkCount(0)
+		, mAllocator(allocator)
+	{
+	}
+
+
+	arena::~arena()
+	{
+		release();
+	}
+
+
+	void* arena::DoAllocateSlow(size_t n, size_t alignment, size_t offset)
+	{
+		// This is enough for the block wherever the chunk's memory starts.
+		const size_t nNeeded = sizeof(Chunk) + offset + (alignment - 1) + n;
+
+		// We use the first spare chunk which is large enough. The spare chunks are in
+		// the order they were used in, so an arena which is reset and then does the
+		// same work again uses the same chunks in the same order.
+		Chunk** ppChunk = &mpSpareChunks;
+
+		while(*ppChunk && ((*ppChunk)->mnSize < nNeeded))
+			ppChunk = &(*ppChunk)->mpPrev;
+
+		Chunk* pChunk = *ppChunk;
+
+		if(pChunk)
+			*ppChunk = pChunk->mpPrev;
+		else
+		{
+			size_t nSize = mnChunkSize;
+
+			if(nSize < nNeeded)
+				nSize = nNeeded; // The request gets a chunk of its own size, and we don't grow mnChunkSize.
+			else if(mnChunkSize < EASTL_ARENA_MAX_CHUNK_SIZE)
+				mnChunkSize = ((mnChunkSize * 2) < EASTL_ARENA_MAX_CHUNK_SIZE) ? (mnChunkSize * 2) : EASTL_ARENA_MAX_CHUNK_SIZE;
+
+			void* const pMemory = allocate_memory(mAllocator, nSize, EASTL_ALIGN_OF(Chunk), 0);
+
+			if(!pMemory)
+				return NULL;
+
+			pChunk = ::new(pMemory) Chunk;
+			pChunk->mnSize = nSize;
+			mnChunkCount++;
+		}
+
+		pChunk->mpPrev = mpChunk;
+		mpChunk        = pChunk;
+		mpCurrent      = reinterpret_cast<char*>(pChunk + 1);
+		mpEnd          = reinterpret_cast<char*>(pChunk) + pChunk->mnSize;
+
+		const uintptr_t nCurrent = reinterpret_cast<uintptr_t>(mpCurrent);
+		const uintptr_t nAligned = ((nCurrent + offset + (alignment - 1)) & ~(uintptr_t)(alignment - 1)) - offset;
+
+		EASTL_ASSERT((nAligned + n) <= reinterpret_cast<uintptr_t>(mpEnd));
+		mpCurrent = reinterpret_cast<char*>(nAligned + n);
+
+		return reinterpret_cast<void*>(nAligned);
+	}
+
+
+	void arena::rewind(const marker& m)
+	{
+		// Move the chunks used since the marker to the spare list. We move the most
+		// recent first, so that the spare list ends up in the order they were used in.
+		Chunk* const pMarkerChunk = static_cast<Chunk*>(m.mpChunk);
+
+		while(mpChunk != pMarkerChunk)
+		{
+			EASTL_ASSERT(mpChunk); // If this fails, the marker isn't from this arena, or it was already rewound past.
+
+			Chunk* const pChunk = mpChunk;
+			mpChunk        = pChunk->mpPrev;
+			pChunk->mpPrev = mpSpareChunks;
+			mpSpareChunks  = pChunk;
+		}
+
+		mpCurrent = m.mpCurrent;
+		mpEnd     = mpChunk ? (reinterpret_cast<char*>(mpChunk) + mpChunk->mnSize) : (mpBuffer + mnBufferSize);
+	}
+
+
+	void arena::reset()
+	{
+		const marker m = { NULL, mpBuffer };
+		rewind(m);
+	}
+
+
+	void arena::release()
+	{
+		reset();
+
+		while(mpSpareChunks)
+		{
+			Chunk* const pChunk = mpSpareChunks;
+			mpSpareChunks = pChunk->mpPrev;
+			EASTLFree(mAllocator, pChunk, pChunk->mnSize);
+		}
+
+		mnChunkCount = 0;
+	}
+
+
+	bool arena::validate() const
+	{
+		size_t nChunkCount = 0;
+
+		for(const Chunk* pChunk = mpChunk; pChunk; pChunk = pChunk->mpPrev)
+			nChunkCount++;
+
+		for(const Chunk* pChunk = mpSpareChunks; pChunk; pChunk = pChunk->mpPrev)
+			nChunkCount++;
+
+		if(nChunkCount != mnChunkCount)
+			return false;
+
+		const char* const pBegin = mpChunk ? reinterpret_cast<const char*>(mpChunk + 1) : mpBuffer;
+		const char* const pEnd   = mpChunk ? (reinterpret_cast<const char*>(mpChunk) + mpChunk->mnSize) : (mpBuffer + mnBufferSize);
+
+		return (mpEnd == pEnd) && (mpCurrent >= pBegin) && (mpCurrent <= pEnd);
+	}
+
+
+} // namespace eastl
@@ -4,6 +4,7 @@
 
 
 #include <EASTL/internal/hashtable.h>
+#include <EASTL/internal/flat_hashtable.h>
 #include <EASTL/utility.h>
 #include <math.h>  // Not all compilers support <cmath> and std::ceilf(), which we need below.
 #include <stddef.h>
@@ -24,6 +25,20 @@ namespace eastl
 	EASTL_API void* gpEmptyBucketArray[2] = { NULL, (void*)uintptr_t(~0) };
 
 
+	/// gFlatHashEmptyGroup
+	///
+	/// The shared control bytes of an empty flat_hashtable. A sentinel followed
+	/// by empty control bytes, enough for one group of the widest group type.
+	/// 
+	EASTL_API internal::flat_hash_ctrl_t gFlatHashEmptyGroup[16] =
+	{
+		internal::kFlatHashCtrlSentinel, internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty,
+		internal::kFlatHashCtrlEmpty,    internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty,
+		internal::kFlatHashCtrlEmpty,    internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty,
+		internal::kFlatHashCtrlEmpty,    internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty, internal::kFlatHashCtrlEmpty
+	};
+
+
 
 	/// gPrimeNumberArray
 	///
@@ -172,6 +187,173 @@ namespace eastl
 	}
 
 
+	/// GetShrinkTargetLoadFactor
+	/// The load factor that shrinking the bucket array aims for. This is the geometric
+	/// mean of the min and max load factors, so that after a shrink the element count
+	/// has to change by the same factor to trigger either a grow or another shrink.
+	///
+	static float GetShrinkTargetLoadFactor(float fMinLoadFactor, float fMaxLoadFactor)
+	{
+		EASTL_ASSERT_MSG((fMinLoadFactor * 2.f) < fMaxLoadFactor, "hashtable: the min load factor must be less than half of the max load factor, or the hashtable would alternately grow and shrink.");
+		return sqrtf(fMinLoadFactor * fMaxLoadFactor);
+	}
+
+
+	/// GetShrinkRequired
+	/// If the load factor nElementCount / nBucketCount is below the min load factor, finds
+	/// the smallest prime p such that nElementCount / p is no more than the shrink target
+	/// load factor. If p < nBucketCount, return pair<bool, uint32_t>(true, p); otherwise
+	/// return pair<bool, uint32_t>(false, 0).
+	/// This function has a side effect of updating mnNextResize.
+	///
+	eastl::pair<bool, uint32_t>
+	prime_rehash_policy::GetShrinkRequired(uint32_t nBucketCount, uint32_t nElementCount) const
+	{
+		if((mfMinLoadFactor > 0.f) && (nBucketCount > 2) && ((float)nElementCount < (nBucketCount * mfMinLoadFactor)))
+		{
+			const float    fMinBucketCount = nElementCount / GetShrinkTargetLoadFactor(mfMinLoadFactor, mfMaxLoadFactor);
+			const uint32_t nPrime          = *eastl::lower_bound(gPrimeNumberArray, gPrimeNumberArray + kPrimeCount, (uint32_t)fMinBucketCount);
+
+			if(nPrime < nBucketCount)
+			{
+				mnNextResize = (uint32_t)ceilf(nPrime * mfMaxLoadFactor);
+				return eastl::pair<bool, uint32_t>(true, nPrime);
+			}
+		}
+
+		return eastl::pair<bool, uint32_t>(false, (uint32_t)0);
+	}
+
+
+
+	/// kMaxPowerOfTwoBucketCount
+	///
+	/// The largest power of two representable by the uint32_t bucket counts.
+	///
+	const uint32_t kMaxPowerOfTwoBucketCount = UINT32_C(1) << 31;
+
+
+	/// GetPowerOfTwoBucketCount
+	/// Return the smallest power of two no smaller than nBucketCountHint,
+	/// clamped to [2, kMaxPowerOfTwoBucketCount].
+	///
+	static uint32_t GetPowerOfTwoBucketCount(uint32_t nBucketCountHint)
+	{
+		if(nBucketCountHint > kMaxPowerOfTwoBucketCount)
+			return kMaxPowerOfTwoBucketCount;
+		return eastl::max_alt(eastl::bit_ceil(nBucketCountHint), (uint32_t)2);
+	}
+
+
+	/// GetPrevBucketCountOnly
+	/// Return a power of two no greater than nBucketCountHint.
+	///
+	uint32_t power_of_two_rehash_policy::GetPrevBucketCountOnly(uint32_t nBucketCountHint)
+	{
+		return eastl::max_alt(eastl::bit_floor(nBucketCountHint), (uint32_t)1);
+	}
+
+
+	/// GetPrevBucketCount
+	/// Return a power of two no greater than nBucketCountHint.
+	/// This function has a side effect of updating mnNextResize.
+	///
+	uint32_t power_of_two_rehash_policy::GetPrevBucketCount(uint32_t nBucketCountHint) const
+	{
+		const uint32_t nBucketCount = GetPrevBucketCountOnly(nBucketCountHint);
+
+		mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+		return nBucketCount;
+	}
+
+
+	/// GetNextBucketCount
+	/// Return a power of two no smaller than nBucketCountHint.
+	/// This function has a side effect of updating mnNextResize.
+	///
+	uint32_t power_of_two_rehash_policy::GetNextBucketCount(uint32_t nBucketCountHint) const
+	{
+		const uint32_t nBucketCount = GetPowerOfTwoBucketCount(nBucketCountHint);
+
+		mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+		return nBucketCount;
+	}
+
+
+	/// GetBucketCount
+	/// Return the smallest power of two p such that alpha p >= nElementCount, where alpha 
+	/// is the load factor. This function has a side effect of updating mnNextResize.
+	///
+	uint32_t power_of_two_rehash_policy::GetBucketCount(uint32_t nElementCount) const
+	{
+		const uint32_t nMinBucketCount = (uint32_t)(nElementCount / mfMaxLoadFactor);
+		const uint32_t nBucketCount    = GetPowerOfTwoBucketCount(nMinBucketCount);
+
+		mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+		return nBucketCount;
+	}
+
+
+	/// GetRehashRequired
+	/// Finds the smallest power of two p such that alpha p > nElementCount + nElementAdd.
+	/// If p > nBucketCount, return pair<bool, uint32_t>(true, p); otherwise return
+	/// pair<bool, uint32_t>(false, 0). The logic is the same as prime_rehash_policy.
+	/// This function has a side effect of updating mnNextResize.
+	///
+	eastl::pair<bool, uint32_t>
+	power_of_two_rehash_policy::GetRehashRequired(uint32_t nBucketCount, uint32_t nElementCount, uint32_t nElementAdd) const
+	{
+		if((nElementCount + nElementAdd) > mnNextResize) // It is significant that we specify > next resize and not >= next resize.
+		{
+			if(nBucketCount == 1) // We force rehashing to occur if the bucket count is < 2.
+				nBucketCount = 0;
+
+			float fMinBucketCount = (nElementCount + nElementAdd) / mfMaxLoadFactor;
+
+			if((fMinBucketCount > (float)nBucketCount) && (nBucketCount < kMaxPowerOfTwoBucketCount))
+			{
+				fMinBucketCount                = eastl::min_alt(eastl::max_alt(fMinBucketCount, mfGrowthFactor * nBucketCount), (float)kMaxPowerOfTwoBucketCount);
+				const uint32_t nNewBucketCount = GetPowerOfTwoBucketCount((uint32_t)fMinBucketCount);
+				mnNextResize                   = (uint32_t)ceilf(nNewBucketCount * mfMaxLoadFactor);
+
+				return eastl::pair<bool, uint32_t>(true, nNewBucketCount);
+			}
+			else
+			{
+				mnNextResize = (uint32_t)ceilf(nBucketCount * mfMaxLoadFactor);
+				return eastl::pair<bool, uint32_t>(false, (uint32_t)0);
+			}
+		}
+
+		return eastl::pair<bool, uint32_t>(false, (uint32_t)0);
+	}
+
+
+	/// GetShrinkRequired
+	/// Finds the smallest power of two p such that nElementCount / p is no more than the
+	/// shrink target load factor, if the load factor is below the min load factor.
+	/// The logic is the same as prime_rehash_policy.
+	/// This function has a side effect of updating mnNextResize.
+	///
+	eastl::pair<bool, uint32_t>
+	power_of_two_rehash_policy::GetShrinkRequired(uint32_t nBucketCount, uint32_t nElementCount) const
+	{
+		if((mfMinLoadFactor > 0.f) && (nBucketCount > 2) && ((float)nElementCount < (nBucketCount * mfMinLoadFactor)))
+		{
+			const float    fMinBucketCount = nElementCount / GetShrinkTargetLoadFactor(mfMinLoadFactor, mfMaxLoadFactor);
+			const uint32_t nNewBucketCount = GetPowerOfTwoBucketCount((uint32_t)fMinBucketCount);
+
+			if(nNewBucketCount < nBucketCount)
+			{
+				mnNextResize = (uint32_t)ceilf(nNewBucketCount * mfMaxLoadFactor);
+				return eastl::pair<bool, uint32_t>(true, nNewBucketCount);
+			}
+		}
+
+		return eastl::pair<bool, uint32_t>(false, (uint32_t)0);
+	}
+
+
 } // namespace eastl
 
 EA_RESTORE_VC_WARNING();
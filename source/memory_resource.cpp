@@ -0,0 +1,437 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/memory_resource.h>
+#include <EASTL/allocator.h>
+#include <EASTL/atomic.h>
+#include <EASTL/bit.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+
+namespace eastl
+{
+	namespace pmr
+	{
+		namespace
+		{
+			// The smallest pool block, which must be able to hold a free list pointer.
+			const size_t kMinBlockSize  = (EASTL_ALLOCATOR_MIN_ALIGNMENT > sizeof(void*)) ? EASTL_ALLOCATOR_MIN_ALIGNMENT : sizeof(void*);
+			const int    kMinBlockShift = eastl::bit_width(kMinBlockSize) - 1;
+
+			const size_t kDefaultMaxBlocksPerChunk  = 1024;
+			const size_t kMaxMaxBlocksPerChunk      = 65536;
+			const size_t kDefaultLargestPoolBlock   = 4096;
+			const size_t kMaxLargestPoolBlock       = 1024 * 1024;
+			const size_t kInitialPoolChunkSize      = 1024; // A pool's first chunk has this many bytes of blocks, or a single block.
+
+			const size_t kDefaultMonotonicChunkSize = 1024;
+			const size_t kMonotonicChunkAlignment   = EASTL_ALLOCATOR_MIN_ALIGNMENT;
+
+
+			// Returns the index of the pool whose blocks are the smallest power of two of at least n bytes.
+			inline size_t GetPoolIndex(size_t n)
+			{
+				return (n <= kMinBlockSize) ? 0 : (size_t)(eastl::bit_width(n - 1) - kMinBlockShift);
+			}
+
+
+			class new_delete_memory_resource : public memory_resource
+			{
+			protected:
+				void* do_allocate(size_t bytes, size_t alignment) EA_OVERRIDE
+				{
+					if(alignment > EASTL_ALLOCATOR_MIN_ALIGNMENT)
+						return EASTLAllocatorDefault()->allocate(bytes, alignment, 0);
+					return EASTLAllocatorDefault()->allocate(bytes);
+				}
+
+				void do_deallocate(void* p, size_t bytes, size_t /*alignment*/) EA_OVERRIDE
+				{
+					EASTLAllocatorDefault()->deallocate(p, bytes);
+				}
+
+				bool do_is_equal(const memory_resource& x) const EA_NOEXCEPT EA_OVERRIDE
+				{
+					return this == &x;
+				}
+			};
+
+
+			class null_memory_resource_impl : public memory_resource
+			{
+			protected:
+				void* do_allocate(size_t, size_t) EA_OVERRIDE
+				{
+					#if EASTL_EXCEPTIONS_ENABLED
+						throw std::bad_alloc();
+					#else
+						EASTL_FAIL_MSG("null_memory_resource::allocate: The resource has no memory.");
+						return NULL;
+					#endif
+				}
+
+				void do_deallocate(void*, size_t, size_t) EA_OVERRIDE
+				{
+				}
+
+				bool do_is_equal(const memory_resource& x) const EA_NOEXCEPT EA_OVERRIDE
+				{
+					return this == &x;
+				}
+			};
+
+
+			eastl::atomic<memory_resource*> gpDefaultResource(NULL); // NULL means new_delete_resource().
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// memory_resource
+		///////////////////////////////////////////////////////////////////////
+
+		memory_resource::~memory_resource()
+		{
+		}
+
+
+		EASTL_API memory_resource* new_delete_resource() EA_NOEXCEPT
+		{
+			static new_delete_memory_resource sResource;
+			return &sResource;
+		}
+
+
+		EASTL_API memory_resource* null_memory_resource() EA_NOEXCEPT
+		{
+			static null_memory_resource_impl sResource;
+			return &sResource;
+		}
+
+
+		EASTL_API memory_resource* set_default_resource(memory_resource* pResource) EA_NOEXCEPT
+		{
+			memory_resource* const pPrevious = gpDefaultResource.exchange(pResource, eastl::memory_order_acq_rel);
+			return pPrevious ? pPrevious : new_delete_resource();
+		}
+
+
+		EASTL_API memory_resource* get_default_resource() EA_NOEXCEPT
+		{
+			memory_resource* const pResource = gpDefaultResource.load(eastl::memory_order_acquire);
+			return pResource ? pResource : new_delete_resource();
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// monotonic_buffer_resource
+		///////////////////////////////////////////////////////////////////////
+
+		monotonic_buffer_resource::monotonic_buffer_resource(memory_resource* pUpstream)
+			: mpCurrent(NULL)
+			, mpEnd(NULL)
+			, mpChunk(NULL)
+			, mpBuffer(NULL)
+			, mnBufferSize(0)
+			, mnInitialSize(kDefaultMonotonicChunkSize)
+			, mnNextSize(kDefaultMonotonicChunkSize)
+			, mpUpstream(pUpstream)
+		{
+			EASTL_ASSERT(pUpstream != NULL);
+		}
+
+
+		monotonic_buffer_resource::monotonic_buffer_resource(size_t nInitialSize, memory_resource* pUpstream)
+			: mpCurrent(NULL)
+			, mpEnd(NULL)
+			, mpChunk(NULL)
+			, mpBuffer(NULL)
+			, mnBufferSize(0)
+			, mnInitialSize(nInitialSize ? nInitialSize : 1)
+			, mnNextSize(nInitialSize ? nInitialSize : 1)
+			, mpUpstream(pUpstream)
+		{
+			EASTL_ASSERT(pUpstream != NULL);
+		}
+
+
+		monotonic_buffer_resource::monotonic_buffer_resource(void* pBuffer, size_t nBufferSize, memory_resource* pUpstream)
+			: mpCurrent(static_cast<char*>(pBuffer))
+			, mpEnd(static_cast<char*>(pBuffer) + nBufferSize)
+			, mpChunk(NULL)
+			, mpBuffer(static_cast<char*>(pBuffer))
+			, mnBufferSize(nBufferSize)
+			, mnInitialSize((nBufferSize > (kDefaultMonotonicChunkSize / 2)) ? (nBufferSize * 2) : kDefaultMonotonicChunkSize)
+			, mnNextSize(mnInitialSize)
+			, mpUpstream(pUpstream)
+		{
+			EASTL_ASSERT(pUpstream != NULL);
+		}
+
+
+		monotonic_buffer_resource::~monotonic_buffer_resource()
+		{
+			release();
+		}
+
+
+		void monotonic_buffer_resource::release()
+		{
+			while(mpChunk)
+			{
+				Chunk* const pPrev = mpChunk->mpPrev;
+				mpUpstream->deallocate(mpChunk, mpChunk->mnSize, kMonotonicChunkAlignment);
+				mpChunk = pPrev;
+			}
+
+			mpCurrent  = mpBuffer;
+			mpEnd      = mpBuffer ? (mpBuffer + mnBufferSize) : NULL;
+			mnNextSize = mnInitialSize;
+		}
+
+
+		void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t alignment)
+		{
+			EASTL_ASSERT((alignment & (alignment - 1)) == 0); // Alignment must be a power of 2.
+
+			uintptr_t nAligned = (reinterpret_cast<uintptr_t>(mpCurrent) + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+
+			if(EASTL_UNLIKELY(((nAligned + bytes) > reinterpret_cast<uintptr_t>(mpEnd)) || !mpEnd))
+			{
+				// This is enough for the block wherever the chunk's memory starts.
+				const size_t nNeeded = sizeof(Chunk) + (alignment - 1) + bytes;
+
+				size_t nSize = mnNextSize;
+				while(nSize < nNeeded)
+					nSize *= 2;
+
+				Chunk* const pChunk = static_cast<Chunk*>(mpUpstream->allocate(nSize, kMonotonicChunkAlignment));
+
+				pChunk->mpPrev = mpChunk;
+				pChunk->mnSize = nSize;
+
+				mpChunk    = pChunk;
+				mpCurrent  = reinterpret_cast<char*>(pChunk + 1);
+				mpEnd      = reinterpret_cast<char*>(pChunk) + nSize;
+				mnNextSize = nSize * 2;
+
+				nAligned = (reinterpret_cast<uintptr_t>(mpCurrent) + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+			}
+
+			mpCurrent = reinterpret_cast<char*>(nAligned + bytes);
+			return reinterpret_cast<void*>(nAligned);
+		}
+
+
+		void monotonic_buffer_resource::do_deallocate(void*, size_t, size_t)
+		{
+			// Memory is freed only by release.
+		}
+
+
+		bool monotonic_buffer_resource::do_is_equal(const memory_resource& x) const EA_NOEXCEPT
+		{
+			return this == &x;
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// unsynchronized_pool_resource
+		///////////////////////////////////////////////////////////////////////
+
+		unsynchronized_pool_resource::unsynchronized_pool_resource(memory_resource* pUpstream)
+			: unsynchronized_pool_resource(pool_options(), pUpstream)
+		{
+		}
+
+
+		unsynchronized_pool_resource::unsynchronized_pool_resource(const pool_options& options, memory_resource* pUpstream)
+			: mnPoolCount(0)
+			, mOptions(options)
+			, mpUpstream(pUpstream)
+		{
+			EASTL_ASSERT(pUpstream != NULL);
+
+			// We round the options to what we actually use, which options() then returns.
+			if(mOptions.max_blocks_per_chunk == 0)
+				mOptions.max_blocks_per_chunk = kDefaultMaxBlocksPerChunk;
+			else if(mOptions.max_blocks_per_chunk > kMaxMaxBlocksPerChunk)
+				mOptions.max_blocks_per_chunk = kMaxMaxBlocksPerChunk;
+
+			if(mOptions.largest_required_pool_block == 0)
+				mOptions.largest_required_pool_block = kDefaultLargestPoolBlock;
+			else if(mOptions.largest_required_pool_block > kMaxLargestPoolBlock)
+				mOptions.largest_required_pool_block = kMaxLargestPoolBlock;
+
+			mnPoolCount = GetPoolIndex(mOptions.largest_required_pool_block) + 1;
+			mOptions.largest_required_pool_block = kMinBlockSize << (mnPoolCount - 1);
+			EASTL_ASSERT(mnPoolCount <= kMaxPoolCount);
+
+			for(size_t i = 0; i < kMaxPoolCount; i++)
+			{
+				mPools[i].mpFreeList  = NULL;
+				mPools[i].mpChunkList = NULL;
+			}
+
+			release();
+		}
+
+
+		unsynchronized_pool_resource::~unsynchronized_pool_resource()
+		{
+			release();
+		}
+
+
+		void unsynchronized_pool_resource::release()
+		{
+			for(size_t i = 0; i < mnPoolCount; i++)
+			{
+				Pool&        pool       = mPools[i];
+				const size_t nBlockSize = kMinBlockSize << i;
+
+				while(pool.mpChunkList)
+				{
+					Chunk* const pChunk = pool.mpChunkList;
+					pool.mpChunkList = pChunk->mpNext;
+					mpUpstream->deallocate(reinterpret_cast<char*>(pChunk + 1) - pChunk->mnSize, pChunk->mnSize, nBlockSize);
+				}
+
+				size_t nBlockCount = kInitialPoolChunkSize / nBlockSize;
+				if(nBlockCount > mOptions.max_blocks_per_chunk)
+					nBlockCount = mOptions.max_blocks_per_chunk;
+
+				pool.mpFreeList       = NULL;
+				pool.mnNextBlockCount = nBlockCount ? nBlockCount : 1;
+			}
+		}
+
+
+		void* unsynchronized_pool_resource::do_allocate(size_t bytes, size_t alignment)
+		{
+			const size_t n = (bytes > alignment) ? bytes : alignment;
+
+			if(n > mOptions.largest_required_pool_block)
+				return mpUpstream->allocate(bytes, alignment);
+
+			const size_t i = GetPoolIndex(n);
+			Pool& pool = mPools[i];
+
+			if(EASTL_LIKELY(pool.mpFreeList != NULL))
+			{
+				void* const p = pool.mpFreeList;
+				pool.mpFreeList = *static_cast<void**>(p);
+				return p;
+			}
+
+			return DoAllocateChunk(pool, kMinBlockSize << i);
+		}
+
+
+		void* unsynchronized_pool_resource::DoAllocateChunk(Pool& pool, size_t nBlockSize)
+		{
+			// The chunk's blocks come first, so that they are aligned to the block size,
+			// followed by the Chunk. The first block is returned and the rest are freed.
+			const size_t nBlockCount = pool.mnNextBlockCount;
+			const size_t nSize       = (nBlockCount * nBlockSize) + sizeof(Chunk);
+			char* const  pMemory     = static_cast<char*>(mpUpstream->allocate(nSize, nBlockSize));
+
+			Chunk* const pChunk = reinterpret_cast<Chunk*>(pMemory + (nBlockCount * nBlockSize));
+			pChunk->mpNext   = pool.mpChunkList;
+			pChunk->mnSize   = nSize;
+			pool.mpChunkList = pChunk;
+
+			for(size_t b = nBlockCount - 1; b > 0; b--)
+			{
+				void* const pBlock = pMemory + (b * nBlockSize);
+				*static_cast<void**>(pBlock) = pool.mpFreeList;
+				pool.mpFreeList = pBlock;
+			}
+
+			if((nBlockCount * 2) <= mOptions.max_blocks_per_chunk)
+				pool.mnNextBlockCount = nBlockCount * 2;
+
+			return pMemory;
+		}
+
+
+		void unsynchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			const size_t n = (bytes > alignment) ? bytes : alignment;
+
+			if(n > mOptions.largest_required_pool_block)
+				mpUpstream->deallocate(p, bytes, alignment);
+			else if(p)
+			{
+				Pool& pool = mPools[GetPoolIndex(n)];
+				*static_cast<void**>(p) = pool.mpFreeList;
+				pool.mpFreeList = p;
+			}
+		}
+
+
+		bool unsynchronized_pool_resource::do_is_equal(const memory_resource& x) const EA_NOEXCEPT
+		{
+			return this == &x;
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// synchronized_pool_resource
+		///////////////////////////////////////////////////////////////////////
+
+		synchronized_pool_resource::synchronized_pool_resource(memory_resource* pUpstream)
+			: mPool(pUpstream)
+		{
+		}
+
+
+		synchronized_pool_resource::synchronized_pool_resource(const pool_options& options, memory_resource* pUpstream)
+			: mPool(options, pUpstream)
+		{
+		}
+
+
+		synchronized_pool_resource::~synchronized_pool_resource()
+		{
+		}
+
+
+		void synchronized_pool_resource::release()
+		{
+			Internal::auto_mutex lock(mMutex);
+			mPool.release();
+		}
+
+
+		void* synchronized_pool_resource::do_allocate(size_t bytes, size_t alignment)
+		{
+			Internal::auto_mutex lock(mMutex);
+			return mPool.allocate(bytes, alignment);
+		}
+
+
+		void synchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			Internal::auto_mutex lock(mMutex);
+			mPool.deallocate(p, bytes, alignment);
+		}
+
+
+		bool synchronized_pool_resource::do_is_equal(const memory_resource& x) const EA_NOEXCEPT
+		{
+			return this == &x;
+		}
+
+	} // namespace pmr
+
+} // namespace eastl
@@ -0,0 +1,545 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/node_pool_allocator.h>
+#include <EASTL/internal/hashtable.h> // For kHashtableAllocFlagBuckets.
+#include <EASTL/memory.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+
+namespace eastl
+{
+
+	///////////////////////////////////////////////////////////////////////////
+	// node_pool
+	///////////////////////////////////////////////////////////////////////////
+
+	node_pool::node_pool(const EASTLAllocatorType& allocator, size_t nInitialNodeCount, size_t nMaxSlabSize)
+		: mnRefCount(0)
+		, mAllocator(allocator)
+		, mpHead(NULL)
+		, mpTail(NULL)
+		, mpSpareSlab(NULL)
+		, mpSlabArray(NULL)
+		, mnSlabCount(0)
+		, mnSlabArrayCapacity(0)
+		, mnNodeSize(0)
+		, mnNodeAlignment(0)
+		, mnInitialNodeCount(nInitialNodeCount ? nInitialNodeCount : 1)
+		, mnMaxSlabSize(nMaxSlabSize)
+		, mnSize(0)
+		, mnCapacity(0)
+	{
+	}
+
+
+	node_pool::~node_pool()
+	{
+		// We don't require that all nodes be freed, in the same way that a container
+		// may be reset_lose_memory'd. We just release all the memory we hold.
+		for(size_t i = 0; i < mnSlabCount; i++)
+			EASTLFree(mAllocator, mpSlabArray[i], 0);
+
+		if(mpSlabArray)
+			EASTLFree(mAllocator, mpSlabArray, mnSlabArrayCapacity * sizeof(Slab*));
+	}
+
+
+	void* node_pool::allocate(size_t n, size_t alignment)
+	{
+		if(mnNodeSize == 0) // If this is the first allocation, it sets the node size and alignment.
+		{
+			if(alignment < EASTL_ALIGN_OF(Link))
+				alignment = EASTL_ALIGN_OF(Link);
+
+			// Assert that alignment is a power of 2 value (e.g. 1, 2, 4, 8, 16, etc.)
+			EASTL_ASSERT((alignment & (alignment - 1)) == 0);
+
+			const size_t nNodeSize = ((((n > sizeof(Link)) ? n : sizeof(Link)) + (alignment - 1)) & ~(alignment - 1));
+
+			if((nNodeSize * mnInitialNodeCount) > mnMaxSlabSize) // If the nodes are too large to pool...
+				return NULL;
+
+			mnNodeSize      = nNodeSize;
+			mnNodeAlignment = alignment;
+		}
+		else if((n > mnNodeSize) || (alignment > mnNodeAlignment))
+			return NULL;
+
+		Slab* pSlab = mpHead;
+
+		if(!pSlab || DoIsFull(pSlab)) // Slabs with free nodes come first, so if the first is full they all are.
+		{
+			pSlab = DoAddSlab();
+
+			if(!pSlab)
+				return NULL;
+		}
+
+		Link* pLink = pSlab->mpFreeList;
+
+		if(pLink)
+			pSlab->mpFreeList = pLink->mpNext;
+		else
+		{
+			pLink = reinterpret_cast<Link*>(pSlab->mpUnused);
+			pSlab->mpUnused += mnNodeSize;
+		}
+
+		pSlab->mnUsedCount++;
+		mnSize++;
+
+		if(DoIsFull(pSlab) && (pSlab != mpTail)) // Keep full slabs at the back.
+		{
+			DoUnlink(pSlab);
+			DoLinkBack(pSlab);
+		}
+
+		return pLink;
+	}
+
+
+	bool node_pool::deallocate(void* p)
+	{
+		Slab* const pSlab = DoFindSlab(p);
+
+		if(!pSlab)
+			return false;
+
+		EASTL_ASSERT(pSlab->mnUsedCount && (pSlab != mpSpareSlab));
+
+		const bool bWasFull = DoIsFull(pSlab);
+
+		Link* const pLink = static_cast<Link*>(p);
+		pLink->mpNext     = pSlab->mpFreeList;
+		pSlab->mpFreeList = pLink;
+		pSlab->mnUsedCount--;
+		mnSize--;
+
+		if(pSlab->mnUsedCount == 0)
+		{
+			// Take the slab out of use. We keep the larger of it and any spare slab we already have.
+			DoUnlink(pSlab);
+			mnCapacity -= pSlab->mnNodeCount;
+			DoResetSlab(pSlab);
+
+			if(mpSpareSlab && (mpSpareSlab->mnNodeCount >= pSlab->mnNodeCount))
+				DoReleaseSlab(pSlab);
+			else
+			{
+				if(mpSpareSlab)
+					DoReleaseSlab(mpSpareSlab);
+				mpSpareSlab = pSlab;
+			}
+		}
+		else if(bWasFull && (pSlab != mpHead)) // Keep slabs with free nodes at the front.
+		{
+			DoUnlink(pSlab);
+			DoLinkFront(pSlab);
+		}
+
+		return true;
+	}
+
+
+	void node_pool::trim()
+	{
+		if(mpSpareSlab)
+		{
+			DoReleaseSlab(mpSpareSlab);
+			mpSpareSlab = NULL;
+		}
+	}
+
+
+	node_pool::Slab* node_pool::DoFindSlab(const void* p) const
+	{
+		// Find the last slab which begins at or before p. Slabs don't overlap, so p is
+		// in our pool only if it is in that slab.
+		size_t nBegin = 0, nEnd = mnSlabCount;
+
+		while(nBegin < nEnd)
+		{
+			const size_t nMid = nBegin + ((nEnd - nBegin) / 2);
+
+			if(reinterpret_cast<uintptr_t>(mpSlabArray[nMid]->mpBegin) <= reinterpret_cast<uintptr_t>(p))
+				nBegin = nMid + 1;
+			else
+				nEnd = nMid;
+		}
+
+		if(nBegin)
+		{
+			Slab* const pSlab = mpSlabArray[nBegin - 1];
+
+			if(reinterpret_cast<uintptr_t>(p) < reinterpret_cast<uintptr_t>(pSlab->mpEnd))
+				return pSlab;
+		}
+
+		return NULL;
+	}
+
+
+	node_pool::Slab* node_pool::DoAddSlab()
+	{
+		Slab* pSlab = mpSpareSlab;
+
+		if(pSlab)
+			mpSpareSlab = NULL;
+		else
+		{
+			// Each new slab is as large as the ones in use together, so that the slab count
+			// grows logarithmically, up to the maximum slab size.
+			size_t nMaxNodeCount = (mnMaxSlabSize / mnNodeSize);
+			if(nMaxNodeCount < mnInitialNodeCount)
+				nMaxNodeCount = mnInitialNodeCount;
+
+			size_t nNodeCount = (mnCapacity > mnInitialNodeCount) ? mnCapacity : mnInitialNodeCount;
+			if(nNodeCount > nMaxNodeCount)
+				nNodeCount = nMaxNodeCount;
+
+			// The slab header goes at the front of the slab's memory, padded so the nodes are aligned.
+			const size_t nHeaderSize = ((sizeof(Slab) + (mnNodeAlignment - 1)) & ~(mnNodeAlignment - 1));
+			const size_t nSlabSize   = nHeaderSize + (nNodeCount * mnNodeSize);
+
+			// Make room in the slab array first, so that we have nothing to undo if that fails.
+			if(mnSlabCount == mnSlabArrayCapacity)
+			{
+				const size_t nNewCapacity = mnSlabArrayCapacity ? (mnSlabArrayCapacity * 2) : 8;
+				Slab** const pNewArray    = static_cast<Slab**>(mAllocator.allocate(nNewCapacity * sizeof(Slab*)));
+
+				if(!pNewArray)
+					return NULL;
+
+				if(mpSlabArray)
+				{
+					memcpy(pNewArray, mpSlabArray, mnSlabCount * sizeof(Slab*));
+					EASTLFree(mAllocator, mpSlabArray, mnSlabArrayCapacity * sizeof(Slab*));
+				}
+
+				mpSlabArray         = pNewArray;
+				mnSlabArrayCapacity = nNewCapacity;
+			}
+
+			void* const pMemory = allocate_memory(mAllocator, nSlabSize, (mnNodeAlignment > EASTL_ALIGN_OF(Slab)) ? mnNodeAlignment : EASTL_ALIGN_OF(Slab), 0);
+
+			if(!pMemory)
+				return NULL;
+
+			pSlab = ::new(pMemory) Slab;
+			pSlab->mpBegin     = static_cast<char*>(pMemory) + nHeaderSize;
+			pSlab->mpEnd       = pSlab->mpBegin + (nNodeCount * mnNodeSize);
+			pSlab->mnNodeCount = nNodeCount;
+			DoResetSlab(pSlab);
+
+			// Insert the slab into the slab array, keeping it sorted by address.
+			size_t i = mnSlabCount;
+			for(; i && (reinterpret_cast<uintptr_t>(mpSlabArray[i - 1]) > reinterpret_cast<uintptr_t>(pSlab)); i--)
+				mpSlabArray[i] = mpSlabArray[i - 1];
+			mpSlabArray[i] = pSlab;
+			mnSlabCount++;
+		}
+
+		mnCapacity += pSlab->mnNodeCount;
+		DoLinkFront(pSlab);
+
+		return pSlab;
+	}
+
+
+	void node_pool::DoReleaseSlab(Slab* pSlab)
+	{
+		// The slab is not in the list; we remove it from the slab array and free its memory.
+		size_t i = 0;
+		while(mpSlabArray[i] != pSlab)
+			i++;
+
+		memmove(mpSlabArray + i, mpSlabArray + i + 1, (mnSlabCount - (i + 1)) * sizeof(Slab*));
+		mnSlabCount--;
+
+		EASTLFree(mAllocator, pSlab, 0);
+	}
+
+
+	void node_pool::DoResetSlab(Slab* pSlab)
+	{
+		pSlab->mpPrev       = NULL;
+		pSlab->mpNext       = NULL;
+		pSlab->mpFreeList   = NULL;
+		pSlab->mpUnused     = pSlab->mpBegin;
+		pSlab->mnUsedCount  = 0;
+	}
+
+
+	void node_pool::DoLinkFront(Slab* pSlab)
+	{
+		pSlab->mpPrev = NULL;
+		pSlab->mpNext = mpHead;
+
+		if(mpHead)
+			mpHead->mpPrev = pSlab;
+		else
+			mpTail = pSlab;
+
+		mpHead = pSlab;
+	}
+
+
+	void node_pool::DoLinkBack(Slab* pSlab)
+	{
+		pSlab->mpNext = NULL;
+		pSlab->mpPrev = mpTail;
+
+		if(mpTail)
+			mpTail->mpNext = pSlab;
+		else
+			mpHead = pSlab;
+
+		mpTail = pSlab;
+	}
+
+
+	void node_pool::DoUnlink(Slab* pSlab)
+	{
+		if(pSlab->mpPrev)
+			pSlab->mpPrev->mpNext = pSlab->mpNext;
+		else
+			mpHead = pSlab->mpNext;
+
+		if(pSlab->mpNext)
+			pSlab->mpNext->mpPrev = pSlab->mpPrev;
+		else
+			mpTail = pSlab->mpPrev;
+	}
+
+
+	bool node_pool::validate() const
+	{
+		// Slabs with free nodes must come before full slabs, the counts must add up, and
+		// the slab array must be sorted.
+		size_t nSize = 0, nCapacity = 0, nListCount = 0;
+		bool   bSeenFull = false;
+
+		for(const Slab* pSlab = mpHead; pSlab; pSlab = pSlab->mpNext, nListCount++)
+		{
+			if(pSlab->mpNext ? (pSlab->mpNext->mpPrev != pSlab) : (pSlab != mpTail))
+				return false;
+
+			if(DoIsFull(pSlab))
+				bSeenFull = true;
+			else if(bSeenFull)
+				return false;
+
+			if((pSlab->mnUsedCount == 0) || (pSlab->mnUsedCount > pSlab->mnNodeCount))
+				return false;
+
+			size_t nFreeCount = (size_t)(pSlab->mpEnd - pSlab->mpUnused) / mnNodeSize;
+			for(const Link* pLink = pSlab->mpFreeList; pLink; pLink = pLink->mpNext)
+			{
+				if((DoFindSlab(pLink) != pSlab) || (nFreeCount++ > pSlab->mnNodeCount))
+					return false;
+			}
+
+			if((pSlab->mnUsedCount + nFreeCount) != pSlab->mnNodeCount)
+				return false;
+
+			nSize     += pSlab->mnUsedCount;
+			nCapacity += pSlab->mnNodeCount;
+		}
+
+		if((nSize != mnSize) || (nCapacity != mnCapacity) || ((nListCount + (mpSpareSlab ? 1 : 0)) != mnSlabCount))
+			return false;
+
+		for(size_t i = 1; i < mnSlabCount; i++)
+		{
+			if(reinterpret_cast<uintptr_t>(mpSlabArray[i - 1]) >= reinterpret_cast<uintptr_t>(mpSlabArray[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// node_pool_allocator
+	///////////////////////////////////////////////////////////////////////////
+
+	node_pool_allocator::node_pool_allocator(const char* EASTL_NAME(pName))
+		: mpPool(NULL)
+		, mnInitialNodeCount(EASTL_NODE_POOL_INITIAL_NODE_COUNT)
+		, mnMaxSlabSize(EASTL_NODE_POOL_MAX_SLAB_SIZE)
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : EASTL_NODE_POOL_DEFAULT_NAME;
+		#endif
+	}
+
+
+	node_pool_allocator::node_pool_allocator(const char* EASTL_NAME(pName), size_t nInitialNodeCount, size_t nMaxSlabSize)
+		: mpPool(NULL)
+		, mnInitialNodeCount(nInitialNodeCount)
+		, mnMaxSlabSize(nMaxSlabSize)
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : EASTL_NODE_POOL_DEFAULT_NAME;
+		#endif
+	}
+
+
+	node_pool_allocator::node_pool_allocator(const node_pool_allocator& x)
+		: mpPool(x.mpPool)
+		, mnInitialNodeCount(x.mnInitialNodeCount)
+		, mnMaxSlabSize(x.mnMaxSlabSize)
+	{
+		if(mpPool)
+			mpPool->mnRefCount++;
+
+		#if EASTL_NAME_ENABLED
+			mpName = x.mpName;
+		#endif
+	}
+
+
+	node_pool_allocator::node_pool_allocator(const node_pool_allocator& x, const char* EASTL_NAME(pName))
+		: mpPool(x.mpPool)
+		, mnInitialNodeCount(x.mnInitialNodeCount)
+		, mnMaxSlabSize(x.mnMaxSlabSize)
+	{
+		if(mpPool)
+			mpPool->mnRefCount++;
+
+		#if EASTL_NAME_ENABLED
+			mpName = pName ? pName : EASTL_NODE_POOL_DEFAULT_NAME;
+		#endif
+	}
+
+
+	node_pool_allocator::~node_pool_allocator()
+	{
+		DoReleasePool();
+	}
+
+
+	node_pool_allocator& node_pool_allocator::operator=(const node_pool_allocator& x)
+	{
+		// As with other allocators with state, this must not be done while memory from this
+		// allocator is in use, as it makes this allocator share the pool of x.
+		if(mpPool != x.mpPool)
+		{
+			if(x.mpPool)
+				x.mpPool->mnRefCount++;
+
+			DoReleasePool();
+			mpPool = x.mpPool;
+		}
+
+		mnInitialNodeCount = x.mnInitialNodeCount;
+		mnMaxSlabSize      = x.mnMaxSlabSize;
+
+		#if EASTL_NAME_ENABLED
+			mpName = x.mpName;
+		#endif
+
+		return *this;
+	}
+
+
+	void* node_pool_allocator::allocate(size_t n, int flags)
+	{
+		// Containers call this version for nodes whose alignment is no more than
+		// EASTL_ALLOCATOR_MIN_ALIGNMENT. A type's alignment divides its size, so we
+		// align the node by the largest power of two which divides n, up to that.
+		size_t nAlignment = (n & (0 - n));
+		if((nAlignment == 0) || (nAlignment > EASTL_ALLOCATOR_MIN_ALIGNMENT))
+			nAlignment = EASTL_ALLOCATOR_MIN_ALIGNMENT;
+
+		return allocate(n, nAlignment, 0, flags);
+	}
+
+
+	void* node_pool_allocator::allocate(size_t n, size_t alignment, size_t offset, int flags)
+	{
+		node_pool* const pPool = DoGetPool();
+
+		if(!pPool)
+			return NULL;
+
+		if(((flags & kHashtableAllocFlagBuckets) == 0) && (offset == 0)) // Bucket arrays aren't nodes.
+		{
+			void* const p = pPool->allocate(n, alignment);
+
+			if(p)
+				return p;
+		}
+
+		return allocate_memory(pPool->get_allocator(), n, alignment, offset);
+	}
+
+
+	void node_pool_allocator::deallocate(void* p, size_t n)
+	{
+		EASTL_ASSERT(mpPool); // If we have no pool, we never allocated p.
+
+		if(!mpPool->deallocate(p))
+			EASTLFree(mpPool->get_allocator(), p, n);
+	}
+
+
+	const char* node_pool_allocator::get_name() const
+	{
+		#if EASTL_NAME_ENABLED
+			return mpName;
+		#else
+			return EASTL_NODE_POOL_DEFAULT_NAME;
+		#endif
+	}
+
+
+	void node_pool_allocator::set_name(const char* EASTL_NAME(pName))
+	{
+		#if EASTL_NAME_ENABLED
+			mpName = pName;
+		#endif
+	}
+
+
+	node_pool* node_pool_allocator::DoGetPool()
+	{
+		if(!mpPool)
+		{
+			EASTLAllocatorType allocator(get_name());
+			void* const pMemory = allocate_memory(allocator, sizeof(node_pool), EASTL_ALIGN_OF(node_pool), 0);
+
+			if(pMemory)
+			{
+				mpPool = ::new(pMemory) node_pool(allocator, mnInitialNodeCount, mnMaxSlabSize);
+				mpPool->mnRefCount = 1;
+			}
+		}
+
+		return mpPool;
+	}
+
+
+	void node_pool_allocator::DoReleasePool()
+	{
+		if(mpPool && (--mpPool->mnRefCount == 0))
+		{
+			EASTLAllocatorType allocator(mpPool->get_allocator());
+
+			mpPool->~node_pool();
+			EASTLFree(allocator, mpPool, sizeof(node_pool));
+		}
+
+		mpPool = NULL;
+	}
+
+
+} // namespace eastl
@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/profiling_allocator.h>
+#include <EASTL/vector.h>
+#include <EASTL/sort.h>
+#include <EASTL/atomic.h>
+#include <EASTL/bit.h>
+#include <EASTL/internal/hash_string.h>
+#include <EASTL/internal/thread_support.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <stdio.h>
+#include <string.h>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+
+namespace eastl
+{
+
+#if EASTL_ALLOCATION_PROFILING_ENABLED
+
+	namespace Internal
+	{
+		// Records live on their own cache line, as the allocators of all containers of
+		// a kind share one record.
+		struct EA_ALIGN(64) allocation_profile_record
+		{
+			eastl::atomic<const char*> mpName; // Set to mName once, when the record is taken by a name.
+			eastl::atomic<uint64_t>    mnAllocCount;
+			eastl::atomic<uint64_t>    mnFreeCount;
+			eastl::atomic<uint64_t>    mnAllocBytes;
+			eastl::atomic<int64_t>     mnLiveBytes;
+			eastl::atomic<int64_t>     mnPeakBytes;
+			eastl::atomic<uint64_t>    mSizeHistogram[allocation_profile::kHistogramSize];
+			char                       mName[EASTL_ALLOCATION_PROFILING_NAME_CAPACITY];
+		};
+	}
+
+	namespace
+	{
+		// The table has twice as many slots as names, so that probe sequences stay short.
+		// gOtherRecord takes the allocations of names which don't fit.
+		const size_t kRecordTableSize = eastl::bit_ceil((size_t)EASTL_ALLOCATION_PROFILING_MAX_NAMES * 2);
+
+		Internal::allocation_profile_record gRecordTable[kRecordTableSize];
+		Internal::allocation_profile_record gOtherRecord;
+		size_t                              gnRecordCount = 0; // Guarded by the mutex.
+
+		Internal::mutex& GetRecordTableMutex()
+		{
+			static Internal::mutex sMutex;
+			return sMutex;
+		}
+
+		size_t GetHistogramIndex(size_t n)
+		{
+			const size_t i = (n <= 16) ? 0 : (size_t)(eastl::bit_width(n - 1) - 4);
+			return (i < allocation_profile::kHistogramSize) ? i : (allocation_profile::kHistogramSize - 1);
+		}
+
+		void GetProfile(const Internal::allocation_profile_record& record, allocation_profile& profile)
+		{
+			profile.mpName        = record.mpName.load(eastl::memory_order_acquire);
+			profile.mnAllocCount  = record.mnAllocCount.load(eastl::memory_order_relaxed);
+			profile.mnFreeCount   = record.mnFreeCount.load(eastl::memory_order_relaxed);
+			profile.mnAllocBytes  = record.mnAllocBytes.load(eastl::memory_order_relaxed);
+			profile.mnLiveBytes   = record.mnLiveBytes.load(eastl::memory_order_relaxed);
+			profile.mnPeakBytes   = record.mnPeakBytes.load(eastl::memory_order_relaxed);
+
+			for(size_t i = 0; i < allocation_profile::kHistogramSize; i++)
+				profile.mSizeHistogram[i] = record.mSizeHistogram[i].load(eastl::memory_order_relaxed);
+		}
+
+		// Returns the record of pName, or the free slot where it belongs. Only the part of
+		// the name which fits in a record is compared.
+		Internal::allocation_profile_record* FindRecord(const char* pName, size_t nHash)
+		{
+			for(size_t i = 0; i < kRecordTableSize; i++)
+			{
+				Internal::allocation_profile_record& record = gRecordTable[(nHash + i) & (kRecordTableSize - 1)];
+				const char* const pRecordName = record.mpName.load(eastl::memory_order_acquire);
+
+				if(!pRecordName || (strncmp(pRecordName, pName, EASTL_ALLOCATION_PROFILING_NAME_CAPACITY - 1) == 0))
+					return &record;
+			}
+
+			return NULL; // The table always has free slots, as it's twice as large as the number of names.
+		}
+
+		template <typename Function>
+		void ForEachRecord(Function function)
+		{
+			for(size_t i = 0; i < kRecordTableSize; i++)
+			{
+				if(gRecordTable[i].mpName.load(eastl::memory_order_acquire))
+					function(gRecordTable[i]);
+			}
+
+			if(gOtherRecord.mpName.load(eastl::memory_order_acquire))
+				function(gOtherRecord);
+		}
+
+		struct PeakBytesGreater
+		{
+			bool operator()(const allocation_profile& a, const allocation_profile& b) const
+				{ return a.mnPeakBytes > b.mnPeakBytes; }
+		};
+
+		void WriteToStdout(const char* pLine, void*)
+		{
+			fputs(pLine, stdout);
+		}
+	}
+
+
+	namespace Internal
+	{
+		EASTL_API allocation_profile_record* GetAllocationProfileRecord(const char* pName)
+		{
+			if(!pName)
+				pName = EASTL_PROFILING_ALLOCATOR_DEFAULT_NAME;
+
+			// Names are copied and compared by value, as each module has its own copy of a
+			// string literal, and names may be built in temporary buffers. Records are never
+			// freed, and a record's name is set last, so finding a name which has been added
+			// needs no lock.
+			const size_t nHash = eastl::internal::hash_string(pName, eastl::min_alt(strlen(pName), (size_t)EASTL_ALLOCATION_PROFILING_NAME_CAPACITY - 1));
+
+			allocation_profile_record* pRecord = FindRecord(pName, nHash);
+			if(pRecord && pRecord->mpName.load(eastl::memory_order_acquire))
+				return pRecord;
+
+			auto_mutex lock(GetRecordTableMutex());
+
+			pRecord = FindRecord(pName, nHash); // Another thread may have added the name meanwhile.
+			if(pRecord && !pRecord->mpName.load(eastl::memory_order_relaxed))
+			{
+				if(gnRecordCount < EASTL_ALLOCATION_PROFILING_MAX_NAMES)
+				{
+					gnRecordCount++;
+					strncpy(pRecord->mName, pName, EASTL_ALLOCATION_PROFILING_NAME_CAPACITY - 1);
+					pRecord->mName[EASTL_ALLOCATION_PROFILING_NAME_CAPACITY - 1] = 0;
+					pRecord->mpName.store(pRecord->mName, eastl::memory_order_release);
+				}
+				else
+					pRecord = NULL;
+			}
+
+			if(!pRecord)
+			{
+				gOtherRecord.mpName.store("(other)", eastl::memory_order_release);
+				pRecord = &gOtherRecord;
+			}
+
+			return pRecord;
+		}
+
+
+		EASTL_API void RecordAllocation(allocation_profile_record* pRecord, size_t n)
+		{
+			pRecord->mnAllocCount.fetch_add(1, eastl::memory_order_relaxed);
+			pRecord->mnAllocBytes.fetch_add(n, eastl::memory_order_relaxed);
+			pRecord->mSizeHistogram[GetHistogramIndex(n)].fetch_add(1, eastl::memory_order_relaxed);
+
+			const int64_t nLiveBytes = pRecord->mnLiveBytes.fetch_add((int64_t)n, eastl::memory_order_relaxed) + (int64_t)n;
+			int64_t       nPeakBytes = pRecord->mnPeakBytes.load(eastl::memory_order_relaxed);
+
+			while((nLiveBytes > nPeakBytes) && !pRecord->mnPeakBytes.compare_exchange_weak(nPeakBytes, nLiveBytes, eastl::memory_order_relaxed))
+				{ } // compare_exchange_weak updates nPeakBytes on failure.
+		}
+
+
+		EASTL_API void RecordDeallocation(allocation_profile_record* pRecord, size_t n)
+		{
+			pRecord->mnFreeCount.fetch_add(1, eastl::memory_order_relaxed);
+			pRecord->mnLiveBytes.fetch_sub((int64_t)n, eastl::memory_order_relaxed);
+		}
+	}
+
+#endif // EASTL_ALLOCATION_PROFILING_ENABLED
+
+
+
+	EASTL_API size_t GetAllocationProfiles(allocation_profile* pProfileArray, size_t nCapacity)
+	{
+		size_t nCount = 0;
+
+		#if EASTL_ALLOCATION_PROFILING_ENABLED
+			ForEachRecord([&](const Internal::allocation_profile_record& record)
+			{
+				if(nCount < nCapacity)
+					GetProfile(record, pProfileArray[nCount]);
+				nCount++;
+			});
+		#else
+			EA_UNUSED(pProfileArray); EA_UNUSED(nCapacity);
+		#endif
+
+		return nCount;
+	}
+
+
+	EASTL_API void ResetAllocationProfiles()
+	{
+		#if EASTL_ALLOCATION_PROFILING_ENABLED
+			ForEachRecord([](Internal::allocation_profile_record& record)
+			{
+				record.mnAllocCount.store(0, eastl::memory_order_relaxed);
+				record.mnFreeCount.store(0, eastl::memory_order_relaxed);
+				record.mnAllocBytes.store(0, eastl::memory_order_relaxed);
+				record.mnPeakBytes.store(record.mnLiveBytes.load(eastl::memory_order_relaxed), eastl::memory_order_relaxed);
+
+				for(size_t i = 0; i < allocation_profile::kHistogramSize; i++)
+					record.mSizeHistogram[i].store(0, eastl::memory_order_relaxed);
+			});
+		#endif
+	}
+
+
+	EASTL_API void ReportAllocationProfiles(EASTL_AllocationReportFunction pFunction, void* pContext)
+	{
+		#if EASTL_ALLOCATION_PROFILING_ENABLED
+			if(!pFunction)
+				pFunction = WriteToStdout;
+
+			// Names may be added while we copy them, so we copy at most as many as we made room for.
+			eastl::vector<allocation_profile> profiles(GetAllocationProfiles(NULL, 0));
+			profiles.resize(eastl::min_alt(GetAllocationProfiles(profiles.data(), profiles.size()), profiles.size()));
+			eastl::sort(profiles.begin(), profiles.end(), PeakBytesGreater());
+
+			static const char* const kBucketNames[allocation_profile::kHistogramSize] =
+				{ "16", "32", "64", "128", "256", "512", "1K", "2K", "4K", "8K", "16K", "32K", "64K", "128K", "256K", "more" };
+
+			char line[512];
+
+			snprintf(line, sizeof(line), "%-40s %12s %12s %14s %14s %16s\n", "Name", "Allocs", "Frees", "Live bytes", "Peak bytes", "Total bytes");
+			pFunction(line, pContext);
+
+			for(eastl_size_t p = 0; p < profiles.size(); p++)
+			{
+				const allocation_profile& profile = profiles[p];
+
+				snprintf(line, sizeof(line), "%-40s %12llu %12llu %14lld %14lld %16llu\n", profile.mpName,
+						 (unsigned long long)profile.mnAllocCount, (unsigned long long)profile.mnFreeCount,
+						 (long long)profile.mnLiveBytes, (long long)profile.mnPeakBytes, (unsigned long long)profile.mnAllocBytes);
+				pFunction(line, pContext);
+
+				// The size histogram follows on one line, for the sizes which occurred.
+				int nLength = snprintf(line, sizeof(line), "    sizes up to");
+
+				for(size_t i = 0; i < allocation_profile::kHistogramSize; i++)
+				{
+					if(profile.mSizeHistogram[i] && (nLength > 0) && ((size_t)nLength < sizeof(line)))
+						nLength += snprintf(line + nLength, sizeof(line) - (size_t)nLength, " %s:%llu", kBucketNames[i], (unsigned long long)profile.mSizeHistogram[i]);
+				}
+
+				if((nLength > 0) && ((size_t)nLength < (sizeof(line) - 1)))
+				{
+					line[nLength]     = '\n';
+					line[nLength + 1] = 0;
+				}
+				pFunction(line, pContext);
+			}
+		#else
+			if(pFunction)
+				pFunction("Allocation profiling is disabled. Define EASTL_ALLOCATION_PROFILING_ENABLED as 1 to enable it.\n", pContext);
+			else
+				fputs("Allocation profiling is disabled. Define EASTL_ALLOCATION_PROFILING_ENABLED as 1 to enable it.\n", stdout);
+		#endif
+	}
+
+} // namespace eastl
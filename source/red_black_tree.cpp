@@ -33,8 +33,13 @@
 namespace eastl
 {
 	// Forward declarations
-	rbtree_node_base* RBTreeRotateLeft(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot);
-	rbtree_node_base* RBTreeRotateRight(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot);
+	//
+	// The functions below that are templated on bRanked implement both the exported functions for 
+	// plain trees and the RBTreeRanked versions, which also keep rbtree_ranked_node_base::mnSubtreeSize 
+	// up to date. For plain trees the bookkeeping compiles away.
+	template <bool bRanked> rbtree_node_base* RBTreeRotateLeft(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot);
+	template <bool bRanked> rbtree_node_base* RBTreeRotateRight(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot);
+	template <bool bRanked> rbtree_node_base* RBTreeRebalanceAfterInsert(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot);
 
 
 
@@ -52,12 +57,12 @@ namespace eastl
 		}
 		else 
 		{
-			rbtree_node_base* pNodeTemp = pNode->mpNodeParent;
+			rbtree_node_base* pNodeTemp = pNode->GetParent();
 
 			while(pNode == pNodeTemp->mpNodeRight) 
 			{
 				pNode = pNodeTemp;
-				pNodeTemp = pNodeTemp->mpNodeParent;
+				pNodeTemp = pNodeTemp->GetParent();
 			}
 
 			if(pNode->mpNodeRight != pNodeTemp)
@@ -74,7 +79,7 @@ namespace eastl
 	///
 	EASTL_API rbtree_node_base* RBTreeDecrement(const rbtree_node_base* pNode)
 	{
-		if((pNode->mpNodeParent->mpNodeParent == pNode) && (pNode->mColor == kRBTreeColorRed))
+		if((pNode->GetParent()->GetParent() == pNode) && (pNode->GetColor() == kRBTreeColorRed))
 			return pNode->mpNodeRight;
 		else if(pNode->mpNodeLeft)
 		{
@@ -86,12 +91,12 @@ namespace eastl
 			return pNodeTemp;
 		}
 
-		rbtree_node_base* pNodeTemp = pNode->mpNodeParent;
+		rbtree_node_base* pNodeTemp = pNode->GetParent();
 
 		while(pNode == pNodeTemp->mpNodeLeft) 
 		{
 			pNode     = pNodeTemp;
-			pNodeTemp = pNodeTemp->mpNodeParent;
+			pNodeTemp = pNodeTemp->GetParent();
 		}
 
 		return const_cast<rbtree_node_base*>(pNodeTemp);
@@ -109,9 +114,9 @@ namespace eastl
 	{
 		size_t nCount = 0;
 
-		for(; pNodeBottom; pNodeBottom = pNodeBottom->mpNodeParent)
+		for(; pNodeBottom; pNodeBottom = pNodeBottom->GetParent())
 		{
-			if(pNodeBottom->mColor == kRBTreeColorBlack) 
+			if(pNodeBottom->GetColor() == kRBTreeColorBlack) 
 				++nCount;
 
 			if(pNodeBottom == pNodeTop) 
@@ -127,6 +132,7 @@ namespace eastl
 	/// If you want to understand tree rotation, any book on algorithms will
 	/// discuss the topic in detail.
 	///
+	template <bool bRanked>
 	rbtree_node_base* RBTreeRotateLeft(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot)
 	{
 		rbtree_node_base* const pNodeTemp = pNode->mpNodeRight;
@@ -134,18 +140,24 @@ namespace eastl
 		pNode->mpNodeRight = pNodeTemp->mpNodeLeft;
 
 		if(pNodeTemp->mpNodeLeft)
-			pNodeTemp->mpNodeLeft->mpNodeParent = pNode;
-		pNodeTemp->mpNodeParent = pNode->mpNodeParent;
+			pNodeTemp->mpNodeLeft->SetParent(pNode);
+		pNodeTemp->SetParent(pNode->GetParent());
 		
 		if(pNode == pNodeRoot)
 			pNodeRoot = pNodeTemp;
-		else if(pNode == pNode->mpNodeParent->mpNodeLeft)
-			pNode->mpNodeParent->mpNodeLeft = pNodeTemp;
+		else if(pNode == pNode->GetParent()->mpNodeLeft)
+			pNode->GetParent()->mpNodeLeft = pNodeTemp;
 		else
-			pNode->mpNodeParent->mpNodeRight = pNodeTemp;
+			pNode->GetParent()->mpNodeRight = pNodeTemp;
 
 		pNodeTemp->mpNodeLeft = pNode;
-		pNode->mpNodeParent = pNodeTemp;
+		pNode->SetParent(pNodeTemp);
+
+		if(bRanked) // pNodeTemp takes over pNode's subtree, and pNode keeps what's left of it.
+		{
+			RBTreeSetSubtreeSize(pNodeTemp, RBTreeGetSubtreeSize(pNode));
+			RBTreeSetSubtreeSize(pNode, RBTreeGetSubtreeSize(pNode->mpNodeLeft) + RBTreeGetSubtreeSize(pNode->mpNodeRight) + 1);
+		}
 
 		return pNodeRoot;
 	}
@@ -157,6 +169,7 @@ namespace eastl
 	/// If you want to understand tree rotation, any book on algorithms will
 	/// discuss the topic in detail.
 	///
+	template <bool bRanked>
 	rbtree_node_base* RBTreeRotateRight(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot)
 	{
 		rbtree_node_base* const pNodeTemp = pNode->mpNodeLeft;
@@ -164,18 +177,24 @@ namespace eastl
 		pNode->mpNodeLeft = pNodeTemp->mpNodeRight;
 
 		if(pNodeTemp->mpNodeRight)
-			pNodeTemp->mpNodeRight->mpNodeParent = pNode;
-		pNodeTemp->mpNodeParent = pNode->mpNodeParent;
+			pNodeTemp->mpNodeRight->SetParent(pNode);
+		pNodeTemp->SetParent(pNode->GetParent());
 
 		if(pNode == pNodeRoot)
 			pNodeRoot = pNodeTemp;
-		else if(pNode == pNode->mpNodeParent->mpNodeRight)
-			pNode->mpNodeParent->mpNodeRight = pNodeTemp;
+		else if(pNode == pNode->GetParent()->mpNodeRight)
+			pNode->GetParent()->mpNodeRight = pNodeTemp;
 		else
-			pNode->mpNodeParent->mpNodeLeft = pNodeTemp;
+			pNode->GetParent()->mpNodeLeft = pNodeTemp;
 
 		pNodeTemp->mpNodeRight = pNode;
-		pNode->mpNodeParent = pNodeTemp;
+		pNode->SetParent(pNodeTemp);
+
+		if(bRanked)
+		{
+			RBTreeSetSubtreeSize(pNodeTemp, RBTreeGetSubtreeSize(pNode));
+			RBTreeSetSubtreeSize(pNode, RBTreeGetSubtreeSize(pNode->mpNodeLeft) + RBTreeGetSubtreeSize(pNode->mpNodeRight) + 1);
+		}
 
 		return pNodeRoot;
 	}
@@ -183,117 +202,153 @@ namespace eastl
 
 
 
-	/// RBTreeInsert
-	/// Insert a node into the tree and rebalance the tree as a result of the 
-	/// disturbance the node introduced.
+	/// RBTreeRebalanceAfterInsert
+	/// Restores the red-black properties after the red node pNode was linked into the 
+	/// tree at pNodeRoot, when the only violation is that pNode's parent may be red too.
+	/// Returns the new root, which the caller must color black.
 	///
-	EASTL_API void RBTreeInsert(rbtree_node_base* pNode,
-								rbtree_node_base* pNodeParent, 
-								rbtree_node_base* pNodeAnchor,
-								RBTreeSide insertionSide)
+	template <bool bRanked>
+	rbtree_node_base* RBTreeRebalanceAfterInsert(rbtree_node_base* pNode, rbtree_node_base* pNodeRoot)
 	{
-		rbtree_node_base*& pNodeRootRef = pNodeAnchor->mpNodeParent;
-
-		// Initialize fields in new node to insert.
-		pNode->mpNodeParent = pNodeParent;
-		pNode->mpNodeRight  = NULL;
-		pNode->mpNodeLeft   = NULL;
-		pNode->mColor       = kRBTreeColorRed;
-
-		// Insert the node.
-		if(insertionSide == kRBTreeSideLeft)
+		while((pNode != pNodeRoot) && (pNode->GetParent()->GetColor() == kRBTreeColorRed)) 
 		{
-			pNodeParent->mpNodeLeft = pNode; // Also makes (leftmost = pNode) when (pNodeParent == pNodeAnchor)
+			EA_ANALYSIS_ASSUME(pNode->GetParent() != NULL);
+			rbtree_node_base* const pNodeParentParent = pNode->GetParent()->GetParent();
 
-			if(pNodeParent == pNodeAnchor)
-			{
-				pNodeAnchor->mpNodeParent = pNode;
-				pNodeAnchor->mpNodeRight = pNode;
-			}
-			else if(pNodeParent == pNodeAnchor->mpNodeLeft)
-				pNodeAnchor->mpNodeLeft = pNode; // Maintain leftmost pointing to min node
-		}
-		else
-		{
-			pNodeParent->mpNodeRight = pNode;
-
-			if(pNodeParent == pNodeAnchor->mpNodeRight)
-				pNodeAnchor->mpNodeRight = pNode; // Maintain rightmost pointing to max node
-		}
-
-		// Rebalance the tree.
-		while((pNode != pNodeRootRef) && (pNode->mpNodeParent->mColor == kRBTreeColorRed)) 
-		{
-			EA_ANALYSIS_ASSUME(pNode->mpNodeParent != NULL);
-			rbtree_node_base* const pNodeParentParent = pNode->mpNodeParent->mpNodeParent;
-
-			if(pNode->mpNodeParent == pNodeParentParent->mpNodeLeft) 
+			if(pNode->GetParent() == pNodeParentParent->mpNodeLeft) 
 			{
 				rbtree_node_base* const pNodeTemp = pNodeParentParent->mpNodeRight;
 
-				if(pNodeTemp && (pNodeTemp->mColor == kRBTreeColorRed)) 
+				if(pNodeTemp && (pNodeTemp->GetColor() == kRBTreeColorRed)) 
 				{
-					pNode->mpNodeParent->mColor = kRBTreeColorBlack;
-					pNodeTemp->mColor = kRBTreeColorBlack;
-					pNodeParentParent->mColor = kRBTreeColorRed;
+					pNode->GetParent()->SetColor(kRBTreeColorBlack);
+					pNodeTemp->SetColor(kRBTreeColorBlack);
+					pNodeParentParent->SetColor(kRBTreeColorRed);
 					pNode = pNodeParentParent;
 				}
 				else 
 				{
-					if(pNode->mpNodeParent && pNode == pNode->mpNodeParent->mpNodeRight) 
+					if(pNode->GetParent() && pNode == pNode->GetParent()->mpNodeRight) 
 					{
-						pNode = pNode->mpNodeParent;
-						pNodeRootRef = RBTreeRotateLeft(pNode, pNodeRootRef);
+						pNode = pNode->GetParent();
+						pNodeRoot = RBTreeRotateLeft<bRanked>(pNode, pNodeRoot);
 					}
 
-					EA_ANALYSIS_ASSUME(pNode->mpNodeParent != NULL);
-					pNode->mpNodeParent->mColor = kRBTreeColorBlack;
-					pNodeParentParent->mColor = kRBTreeColorRed;
-					pNodeRootRef = RBTreeRotateRight(pNodeParentParent, pNodeRootRef);
+					EA_ANALYSIS_ASSUME(pNode->GetParent() != NULL);
+					pNode->GetParent()->SetColor(kRBTreeColorBlack);
+					pNodeParentParent->SetColor(kRBTreeColorRed);
+					pNodeRoot = RBTreeRotateRight<bRanked>(pNodeParentParent, pNodeRoot);
 				}
 			}
 			else 
 			{
 				rbtree_node_base* const pNodeTemp = pNodeParentParent->mpNodeLeft;
 
-				if(pNodeTemp && (pNodeTemp->mColor == kRBTreeColorRed)) 
+				if(pNodeTemp && (pNodeTemp->GetColor() == kRBTreeColorRed)) 
 				{
-					pNode->mpNodeParent->mColor = kRBTreeColorBlack;
-					pNodeTemp->mColor = kRBTreeColorBlack;
-					pNodeParentParent->mColor = kRBTreeColorRed;
+					pNode->GetParent()->SetColor(kRBTreeColorBlack);
+					pNodeTemp->SetColor(kRBTreeColorBlack);
+					pNodeParentParent->SetColor(kRBTreeColorRed);
 					pNode = pNodeParentParent;
 				}
 				else 
 				{
-					EA_ANALYSIS_ASSUME(pNode != NULL && pNode->mpNodeParent != NULL);
+					EA_ANALYSIS_ASSUME(pNode != NULL && pNode->GetParent() != NULL);
 
-					if(pNode == pNode->mpNodeParent->mpNodeLeft) 
+					if(pNode == pNode->GetParent()->mpNodeLeft) 
 					{
-						pNode = pNode->mpNodeParent;
-						pNodeRootRef = RBTreeRotateRight(pNode, pNodeRootRef);
+						pNode = pNode->GetParent();
+						pNodeRoot = RBTreeRotateRight<bRanked>(pNode, pNodeRoot);
 					}
 
-					pNode->mpNodeParent->mColor = kRBTreeColorBlack;
-					pNodeParentParent->mColor = kRBTreeColorRed;
-					pNodeRootRef = RBTreeRotateLeft(pNodeParentParent, pNodeRootRef);
+					pNode->GetParent()->SetColor(kRBTreeColorBlack);
+					pNodeParentParent->SetColor(kRBTreeColorRed);
+					pNodeRoot = RBTreeRotateLeft<bRanked>(pNodeParentParent, pNodeRoot);
 				}
 			}
 		}
 
-		EA_ANALYSIS_ASSUME(pNodeRootRef != NULL);
-		pNodeRootRef->mColor = kRBTreeColorBlack;
+		return pNodeRoot;
+	}
+
+
+
+
+	/// RBTreeInsert
+	/// Insert a node into the tree and rebalance the tree as a result of the 
+	/// disturbance the node introduced.
+	///
+	template <bool bRanked>
+	void RBTreeInsertImpl(rbtree_node_base* pNode,
+						  rbtree_node_base* pNodeParent, 
+						  rbtree_node_base* pNodeAnchor,
+						  RBTreeSide insertionSide)
+	{
+		rbtree_node_base* pNodeRoot = pNodeAnchor->GetParent(); // The anchor's parent is the root node. We write it back when done.
+
+		// Initialize fields in new node to insert.
+		pNode->SetParentAndColor(pNodeParent, kRBTreeColorRed);
+		pNode->mpNodeRight  = NULL;
+		pNode->mpNodeLeft   = NULL;
+
+		if(bRanked)
+		{
+			RBTreeSetSubtreeSize(pNode, 1);
+
+			for(rbtree_node_base* pNodeAncestor = pNodeParent; pNodeAncestor != pNodeAnchor; pNodeAncestor = pNodeAncestor->GetParent())
+				RBTreeSetSubtreeSize(pNodeAncestor, RBTreeGetSubtreeSize(pNodeAncestor) + 1);
+		}
+
+		// Insert the node.
+		if(insertionSide == kRBTreeSideLeft)
+		{
+			pNodeParent->mpNodeLeft = pNode; // Also makes (leftmost = pNode) when (pNodeParent == pNodeAnchor)
+
+			if(pNodeParent == pNodeAnchor)
+			{
+				pNodeRoot = pNode;
+				pNodeAnchor->mpNodeRight = pNode;
+			}
+			else if(pNodeParent == pNodeAnchor->mpNodeLeft)
+				pNodeAnchor->mpNodeLeft = pNode; // Maintain leftmost pointing to min node
+		}
+		else
+		{
+			pNodeParent->mpNodeRight = pNode;
+
+			if(pNodeParent == pNodeAnchor->mpNodeRight)
+				pNodeAnchor->mpNodeRight = pNode; // Maintain rightmost pointing to max node
+		}
+
+		// Rebalance the tree.
+		pNodeRoot = RBTreeRebalanceAfterInsert<bRanked>(pNode, pNodeRoot);
+
+		EA_ANALYSIS_ASSUME(pNodeRoot != NULL);
+		pNodeRoot->SetColor(kRBTreeColorBlack);
+		pNodeAnchor->SetParent(pNodeRoot);
 
 	} // RBTreeInsert
 
+	EASTL_API void RBTreeInsert(rbtree_node_base* pNode, rbtree_node_base* pNodeParent, rbtree_node_base* pNodeAnchor, RBTreeSide insertionSide)
+	{
+		RBTreeInsertImpl<false>(pNode, pNodeParent, pNodeAnchor, insertionSide);
+	}
+
+	EASTL_API void RBTreeRankedInsert(rbtree_node_base* pNode, rbtree_node_base* pNodeParent, rbtree_node_base* pNodeAnchor, RBTreeSide insertionSide)
+	{
+		RBTreeInsertImpl<true>(pNode, pNodeParent, pNodeAnchor, insertionSide);
+	}
+
 
 
 
 	/// RBTreeErase
 	/// Erase a node from the tree.
 	///
-	EASTL_API void RBTreeErase(rbtree_node_base* pNode, rbtree_node_base* pNodeAnchor)
+	template <bool bRanked>
+	void RBTreeEraseImpl(rbtree_node_base* pNode, rbtree_node_base* pNodeAnchor)
 	{
-		rbtree_node_base*& pNodeRootRef      = pNodeAnchor->mpNodeParent;
+		rbtree_node_base*  pNodeRoot         = pNodeAnchor->GetParent(); // Written back to the anchor when done.
 		rbtree_node_base*& pNodeLeftmostRef  = pNodeAnchor->mpNodeLeft;
 		rbtree_node_base*& pNodeRightmostRef = pNodeAnchor->mpNodeRight;
 		rbtree_node_base*  pNodeSuccessor    = pNode;
@@ -315,22 +370,28 @@ namespace eastl
 			pNodeChild = pNodeSuccessor->mpNodeRight;
 		}
 
+		if(bRanked) // pNodeSuccessor is the node that leaves its place, so every subtree above it shrinks by one.
+		{
+			for(rbtree_node_base* pNodeAncestor = pNodeSuccessor->GetParent(); pNodeAncestor != pNodeAnchor; pNodeAncestor = pNodeAncestor->GetParent())
+				RBTreeSetSubtreeSize(pNodeAncestor, RBTreeGetSubtreeSize(pNodeAncestor) - 1);
+		}
+
 		// Here we remove pNode from the tree and fix up the node pointers appropriately around it.
 		if(pNodeSuccessor == pNode) // If pNode was a leaf node (had both NULL children)...
 		{
-			pNodeChildParent = pNodeSuccessor->mpNodeParent;  // Assign pNodeReplacement's parent.
+			pNodeChildParent = pNodeSuccessor->GetParent();  // Assign pNodeReplacement's parent.
 
 			if(pNodeChild) 
-				pNodeChild->mpNodeParent = pNodeSuccessor->mpNodeParent;
+				pNodeChild->SetParent(pNodeSuccessor->GetParent());
 
-			if(pNode == pNodeRootRef) // If the node being deleted is the root node...
-				pNodeRootRef = pNodeChild; // Set the new root node to be the pNodeReplacement.
+			if(pNode == pNodeRoot) // If the node being deleted is the root node...
+				pNodeRoot = pNodeChild; // Set the new root node to be the pNodeReplacement.
 			else 
 			{
-				if(pNode == pNode->mpNodeParent->mpNodeLeft) // If pNode is a left node...
-					pNode->mpNodeParent->mpNodeLeft  = pNodeChild;  // Make pNode's replacement node be on the same side.
+				if(pNode == pNode->GetParent()->mpNodeLeft) // If pNode is a left node...
+					pNode->GetParent()->mpNodeLeft  = pNodeChild;  // Make pNode's replacement node be on the same side.
 				else
-					pNode->mpNodeParent->mpNodeRight = pNodeChild;
+					pNode->GetParent()->mpNodeRight = pNodeChild;
 				// Now pNode is disconnected from the bottom of the tree (recall that in this pathway pNode was determined to be a leaf).
 			}
 
@@ -344,7 +405,7 @@ namespace eastl
 					pNodeLeftmostRef = RBTreeGetMinChild(pNodeChild); 
 				}
 				else
-					pNodeLeftmostRef = pNode->mpNodeParent; // This  makes (pNodeLeftmostRef == end()) if (pNode == root node)
+					pNodeLeftmostRef = pNode->GetParent(); // This  makes (pNodeLeftmostRef == end()) if (pNode == root node)
 			}
 
 			if(pNode == pNodeRightmostRef) // If pNode is the tree last (rbegin()) node...
@@ -357,85 +418,90 @@ namespace eastl
 					pNodeRightmostRef = RBTreeGetMaxChild(pNodeChild);
 				}
 				else // pNodeChild == pNode->mpNodeLeft
-					pNodeRightmostRef = pNode->mpNodeParent; // makes pNodeRightmostRef == &mAnchor if pNode == pNodeRootRef
+					pNodeRightmostRef = pNode->GetParent(); // makes pNodeRightmostRef == &mAnchor if pNode == pNodeRoot
 			}
 		}
 		else // else (pNodeSuccessor != pNode)
 		{
 			// Relink pNodeSuccessor in place of pNode. pNodeSuccessor is pNode's successor.
 			// We specifically set pNodeSuccessor to be on the right child side of pNode, so fix up the left child side.
-			pNode->mpNodeLeft->mpNodeParent = pNodeSuccessor; 
+			pNode->mpNodeLeft->SetParent(pNodeSuccessor); 
 			pNodeSuccessor->mpNodeLeft = pNode->mpNodeLeft;
 
 			if(pNodeSuccessor == pNode->mpNodeRight) // If pNode's successor was at the bottom of the tree... (yes that's effectively what this statement means)
 				pNodeChildParent = pNodeSuccessor; // Assign pNodeReplacement's parent.
 			else
 			{
-				pNodeChildParent = pNodeSuccessor->mpNodeParent;
+				pNodeChildParent = pNodeSuccessor->GetParent();
 
 				if(pNodeChild)
-					pNodeChild->mpNodeParent = pNodeChildParent;
+					pNodeChild->SetParent(pNodeChildParent);
 
 				pNodeChildParent->mpNodeLeft = pNodeChild;
 
 				pNodeSuccessor->mpNodeRight = pNode->mpNodeRight;
-				pNode->mpNodeRight->mpNodeParent = pNodeSuccessor;
+				pNode->mpNodeRight->SetParent(pNodeSuccessor);
 			}
 
-			if(pNode == pNodeRootRef)
-				pNodeRootRef = pNodeSuccessor;
-			else if(pNode == pNode->mpNodeParent->mpNodeLeft)
-				pNode->mpNodeParent->mpNodeLeft = pNodeSuccessor;
+			if(pNode == pNodeRoot)
+				pNodeRoot = pNodeSuccessor;
+			else if(pNode == pNode->GetParent()->mpNodeLeft)
+				pNode->GetParent()->mpNodeLeft = pNodeSuccessor;
 			else 
-				pNode->mpNodeParent->mpNodeRight = pNodeSuccessor;
+				pNode->GetParent()->mpNodeRight = pNodeSuccessor;
 
 			// Now pNode is disconnected from the tree.
 
-			pNodeSuccessor->mpNodeParent = pNode->mpNodeParent;
-			eastl::swap(pNodeSuccessor->mColor, pNode->mColor);
+			pNodeSuccessor->SetParent(pNode->GetParent());
+			const char color = pNodeSuccessor->GetColor();
+			pNodeSuccessor->SetColor(pNode->GetColor());
+			pNode->SetColor(color);
+
+			if(bRanked)
+				RBTreeSetSubtreeSize(pNodeSuccessor, RBTreeGetSubtreeSize(pNode));
 		}
 
 		// Here we do tree balancing as per the conventional red-black tree algorithm.
-		if(pNode->mColor == kRBTreeColorBlack) 
+		if(pNode->GetColor() == kRBTreeColorBlack) 
 		{ 
-			while((pNodeChild != pNodeRootRef) && ((pNodeChild == NULL) || (pNodeChild->mColor == kRBTreeColorBlack)))
+			while((pNodeChild != pNodeRoot) && ((pNodeChild == NULL) || (pNodeChild->GetColor() == kRBTreeColorBlack)))
 			{
 				if(pNodeChild == pNodeChildParent->mpNodeLeft) 
 				{
 					rbtree_node_base* pNodeTemp = pNodeChildParent->mpNodeRight;
 
-					if(pNodeTemp->mColor == kRBTreeColorRed) 
+					if(pNodeTemp->GetColor() == kRBTreeColorRed) 
 					{
-						pNodeTemp->mColor = kRBTreeColorBlack;
-						pNodeChildParent->mColor = kRBTreeColorRed;
-						pNodeRootRef = RBTreeRotateLeft(pNodeChildParent, pNodeRootRef);
+						pNodeTemp->SetColor(kRBTreeColorBlack);
+						pNodeChildParent->SetColor(kRBTreeColorRed);
+						pNodeRoot = RBTreeRotateLeft<bRanked>(pNodeChildParent, pNodeRoot);
 						pNodeTemp = pNodeChildParent->mpNodeRight;
 					}
 
-					if(((pNodeTemp->mpNodeLeft  == NULL) || (pNodeTemp->mpNodeLeft->mColor  == kRBTreeColorBlack)) &&
-						((pNodeTemp->mpNodeRight == NULL) || (pNodeTemp->mpNodeRight->mColor == kRBTreeColorBlack))) 
+					if(((pNodeTemp->mpNodeLeft  == NULL) || (pNodeTemp->mpNodeLeft->GetColor()  == kRBTreeColorBlack)) &&
+						((pNodeTemp->mpNodeRight == NULL) || (pNodeTemp->mpNodeRight->GetColor() == kRBTreeColorBlack))) 
 					{
-						pNodeTemp->mColor = kRBTreeColorRed;
+						pNodeTemp->SetColor(kRBTreeColorRed);
 						pNodeChild = pNodeChildParent;
-						pNodeChildParent = pNodeChildParent->mpNodeParent;
+						pNodeChildParent = pNodeChildParent->GetParent();
 					} 
 					else 
 					{
-						if((pNodeTemp->mpNodeRight == NULL) || (pNodeTemp->mpNodeRight->mColor == kRBTreeColorBlack)) 
+						if((pNodeTemp->mpNodeRight == NULL) || (pNodeTemp->mpNodeRight->GetColor() == kRBTreeColorBlack)) 
 						{
-							pNodeTemp->mpNodeLeft->mColor = kRBTreeColorBlack;
-							pNodeTemp->mColor = kRBTreeColorRed;
-							pNodeRootRef = RBTreeRotateRight(pNodeTemp, pNodeRootRef);
+							pNodeTemp->mpNodeLeft->SetColor(kRBTreeColorBlack);
+							pNodeTemp->SetColor(kRBTreeColorRed);
+							pNodeRoot = RBTreeRotateRight<bRanked>(pNodeTemp, pNodeRoot);
 							pNodeTemp = pNodeChildParent->mpNodeRight;
 						}
 
-						pNodeTemp->mColor = pNodeChildParent->mColor;
-						pNodeChildParent->mColor = kRBTreeColorBlack;
+						pNodeTemp->SetColor(pNodeChildParent->GetColor());
+						pNodeChildParent->SetColor(kRBTreeColorBlack);
 
 						if(pNodeTemp->mpNodeRight) 
-							pNodeTemp->mpNodeRight->mColor = kRBTreeColorBlack;
+							pNodeTemp->mpNodeRight->SetColor(kRBTreeColorBlack);
 
-						pNodeRootRef = RBTreeRotateLeft(pNodeChildParent, pNodeRootRef);
+						pNodeRoot = RBTreeRotateLeft<bRanked>(pNodeChildParent, pNodeRoot);
 						break;
 					}
 				} 
@@ -444,51 +510,297 @@ namespace eastl
 					// The following is the same as above, with mpNodeRight <-> mpNodeLeft.
 					rbtree_node_base* pNodeTemp = pNodeChildParent->mpNodeLeft;
 
-					if(pNodeTemp->mColor == kRBTreeColorRed) 
+					if(pNodeTemp->GetColor() == kRBTreeColorRed) 
 					{
-						pNodeTemp->mColor        = kRBTreeColorBlack;
-						pNodeChildParent->mColor = kRBTreeColorRed;
+						pNodeTemp->SetColor(kRBTreeColorBlack);
+						pNodeChildParent->SetColor(kRBTreeColorRed);
 
-						pNodeRootRef = RBTreeRotateRight(pNodeChildParent, pNodeRootRef);
+						pNodeRoot = RBTreeRotateRight<bRanked>(pNodeChildParent, pNodeRoot);
 						pNodeTemp = pNodeChildParent->mpNodeLeft;
 					}
 
-					if(((pNodeTemp->mpNodeRight == NULL) || (pNodeTemp->mpNodeRight->mColor == kRBTreeColorBlack)) &&
-						((pNodeTemp->mpNodeLeft  == NULL) || (pNodeTemp->mpNodeLeft->mColor  == kRBTreeColorBlack))) 
+					if(((pNodeTemp->mpNodeRight == NULL) || (pNodeTemp->mpNodeRight->GetColor() == kRBTreeColorBlack)) &&
+						((pNodeTemp->mpNodeLeft  == NULL) || (pNodeTemp->mpNodeLeft->GetColor()  == kRBTreeColorBlack))) 
 					{
-						pNodeTemp->mColor = kRBTreeColorRed;
+						pNodeTemp->SetColor(kRBTreeColorRed);
 						pNodeChild       = pNodeChildParent;
-						pNodeChildParent = pNodeChildParent->mpNodeParent;
+						pNodeChildParent = pNodeChildParent->GetParent();
 					} 
 					else 
 					{
-						if((pNodeTemp->mpNodeLeft == NULL) || (pNodeTemp->mpNodeLeft->mColor == kRBTreeColorBlack)) 
+						if((pNodeTemp->mpNodeLeft == NULL) || (pNodeTemp->mpNodeLeft->GetColor() == kRBTreeColorBlack)) 
 						{
-							pNodeTemp->mpNodeRight->mColor = kRBTreeColorBlack;
-							pNodeTemp->mColor              = kRBTreeColorRed;
+							pNodeTemp->mpNodeRight->SetColor(kRBTreeColorBlack);
+							pNodeTemp->SetColor(kRBTreeColorRed);
 
-							pNodeRootRef = RBTreeRotateLeft(pNodeTemp, pNodeRootRef);
+							pNodeRoot = RBTreeRotateLeft<bRanked>(pNodeTemp, pNodeRoot);
 							pNodeTemp = pNodeChildParent->mpNodeLeft;
 						}
 
-						pNodeTemp->mColor = pNodeChildParent->mColor;
-						pNodeChildParent->mColor = kRBTreeColorBlack;
+						pNodeTemp->SetColor(pNodeChildParent->GetColor());
+						pNodeChildParent->SetColor(kRBTreeColorBlack);
 
 						if(pNodeTemp->mpNodeLeft) 
-							pNodeTemp->mpNodeLeft->mColor = kRBTreeColorBlack;
+							pNodeTemp->mpNodeLeft->SetColor(kRBTreeColorBlack);
 
-						pNodeRootRef = RBTreeRotateRight(pNodeChildParent, pNodeRootRef);
+						pNodeRoot = RBTreeRotateRight<bRanked>(pNodeChildParent, pNodeRoot);
 						break;
 					}
 				}
 			}
 
 			if(pNodeChild)
-				pNodeChild->mColor = kRBTreeColorBlack;
+				pNodeChild->SetColor(kRBTreeColorBlack);
 		}
 
+		pNodeAnchor->SetParent(pNodeRoot);
+
 	} // RBTreeErase
 
+	EASTL_API void RBTreeErase(rbtree_node_base* pNode, rbtree_node_base* pNodeAnchor)
+	{
+		RBTreeEraseImpl<false>(pNode, pNodeAnchor);
+	}
+
+	EASTL_API void RBTreeRankedErase(rbtree_node_base* pNode, rbtree_node_base* pNodeAnchor)
+	{
+		RBTreeEraseImpl<true>(pNode, pNodeAnchor);
+	}
+
+
+
+	/// RBTreeJoin
+	/// Joins the trees left and right with pNode in between and returns the result. Every 
+	/// key in left must order before pNode and every key in right after it. This runs in 
+	/// time proportional to the difference in black height between the two trees: pNode 
+	/// is linked in along the spine of the taller tree at the point where the shorter tree 
+	/// fits, and the insertion rebalance is run from there.
+	///
+	template <bool bRanked>
+	rbtree_subtree RBTreeJoinImpl(rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right)
+	{
+		// Black roots make the spine walks below simpler, so recolor the roots up front.
+		if(left.mpRoot && (left.mpRoot->GetColor() == kRBTreeColorRed))
+		{
+			left.mpRoot->SetColor(kRBTreeColorBlack);
+			++left.mnBlackHeight;
+		}
+
+		if(right.mpRoot && (right.mpRoot->GetColor() == kRBTreeColorRed))
+		{
+			right.mpRoot->SetColor(kRBTreeColorBlack);
+			++right.mnBlackHeight;
+		}
+
+		rbtree_subtree result;
+
+		if(left.mnBlackHeight == right.mnBlackHeight)
+		{
+			pNode->SetParentAndColor(NULL, kRBTreeColorBlack);
+			pNode->mpNodeLeft  = left.mpRoot;
+			pNode->mpNodeRight = right.mpRoot;
+
+			if(left.mpRoot)
+				left.mpRoot->SetParent(pNode);
+			if(right.mpRoot)
+				right.mpRoot->SetParent(pNode);
+
+			if(bRanked)
+				RBTreeSetSubtreeSize(pNode, RBTreeGetSubtreeSize(left.mpRoot) + RBTreeGetSubtreeSize(right.mpRoot) + 1);
+
+			result.mpRoot        = pNode;
+			result.mnBlackHeight = left.mnBlackHeight + 1;
+			return result;
+		}
+
+		if(left.mnBlackHeight > right.mnBlackHeight)
+		{
+			// Walk down the right spine of left to the first black (or NULL) node whose 
+			// black height equals that of right. That node and right become pNode's children.
+			rbtree_node_base* pNodeParent = NULL;
+			rbtree_node_base* pNodeChild  = left.mpRoot;
+			size_t            nHeight     = left.mnBlackHeight;
+
+			while((nHeight != right.mnBlackHeight) || (pNodeChild && (pNodeChild->GetColor() == kRBTreeColorRed)))
+			{
+				if(bRanked) // Every node we pass ends up above pNode and right.
+					RBTreeSetSubtreeSize(pNodeChild, RBTreeGetSubtreeSize(pNodeChild) + RBTreeGetSubtreeSize(right.mpRoot) + 1);
+				if(pNodeChild->GetColor() == kRBTreeColorBlack)
+					--nHeight;
+				pNodeParent = pNodeChild;
+				pNodeChild  = pNodeChild->mpNodeRight;
+			}
+
+			pNode->SetParentAndColor(pNodeParent, kRBTreeColorRed);
+			pNode->mpNodeLeft  = pNodeChild;
+			pNode->mpNodeRight = right.mpRoot;
+			pNodeParent->mpNodeRight = pNode;
+
+			if(pNodeChild)
+				pNodeChild->SetParent(pNode);
+			if(right.mpRoot)
+				right.mpRoot->SetParent(pNode);
+
+			if(bRanked)
+				RBTreeSetSubtreeSize(pNode, RBTreeGetSubtreeSize(pNodeChild) + RBTreeGetSubtreeSize(right.mpRoot) + 1);
+
+			result.mpRoot        = RBTreeRebalanceAfterInsert<bRanked>(pNode, left.mpRoot);
+			result.mnBlackHeight = left.mnBlackHeight;
+		}
+		else
+		{
+			rbtree_node_base* pNodeParent = NULL;
+			rbtree_node_base* pNodeChild  = right.mpRoot;
+			size_t            nHeight     = right.mnBlackHeight;
+
+			while((nHeight != left.mnBlackHeight) || (pNodeChild && (pNodeChild->GetColor() == kRBTreeColorRed)))
+			{
+				if(bRanked)
+					RBTreeSetSubtreeSize(pNodeChild, RBTreeGetSubtreeSize(pNodeChild) + RBTreeGetSubtreeSize(left.mpRoot) + 1);
+				if(pNodeChild->GetColor() == kRBTreeColorBlack)
+					--nHeight;
+				pNodeParent = pNodeChild;
+				pNodeChild  = pNodeChild->mpNodeLeft;
+			}
+
+			pNode->SetParentAndColor(pNodeParent, kRBTreeColorRed);
+			pNode->mpNodeLeft  = left.mpRoot;
+			pNode->mpNodeRight = pNodeChild;
+			pNodeParent->mpNodeLeft = pNode;
+
+			if(left.mpRoot)
+				left.mpRoot->SetParent(pNode);
+			if(pNodeChild)
+				pNodeChild->SetParent(pNode);
+
+			if(bRanked)
+				RBTreeSetSubtreeSize(pNode, RBTreeGetSubtreeSize(left.mpRoot) + RBTreeGetSubtreeSize(pNodeChild) + 1);
+
+			result.mpRoot        = RBTreeRebalanceAfterInsert<bRanked>(pNode, right.mpRoot);
+			result.mnBlackHeight = right.mnBlackHeight;
+		}
+
+		if(result.mpRoot->GetColor() == kRBTreeColorRed) // The rebalance can leave a red root, which we can always recolor.
+		{
+			result.mpRoot->SetColor(kRBTreeColorBlack);
+			++result.mnBlackHeight;
+		}
+
+		result.mpRoot->SetParent(NULL);
+		return result;
+
+	} // RBTreeJoin
+
+	EASTL_API rbtree_subtree RBTreeJoin(rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right)
+	{
+		return RBTreeJoinImpl<false>(left, pNode, right);
+	}
+
+	EASTL_API rbtree_subtree RBTreeRankedJoin(rbtree_subtree left, rbtree_node_base* pNode, rbtree_subtree right)
+	{
+		return RBTreeJoinImpl<true>(left, pNode, right);
+	}
+
+
+
+	/// RBTreeSplitLast
+	/// Removes the last (rightmost) node from the tree and returns it via pNodeLast, 
+	/// returning the tree that remains. 
+	///
+	template <bool bRanked>
+	rbtree_subtree RBTreeSplitLast(rbtree_subtree tree, rbtree_node_base*& pNodeLast)
+	{
+		rbtree_node_base* const pNodeRoot = tree.mpRoot;
+		const size_t nChildHeight = tree.mnBlackHeight - ((pNodeRoot->GetColor() == kRBTreeColorBlack) ? 1 : 0);
+
+		rbtree_subtree left  = { pNodeRoot->mpNodeLeft,  nChildHeight };
+		rbtree_subtree right = { pNodeRoot->mpNodeRight, nChildHeight };
+
+		if(!right.mpRoot)
+		{
+			pNodeLast = pNodeRoot;
+			return left;
+		}
+
+		return RBTreeJoinImpl<bRanked>(left, pNodeRoot, RBTreeSplitLast<bRanked>(right, pNodeLast));
+	}
+
+
+
+	/// RBTreeJoin2
+	/// Joins the trees left and right, where every key in left must order before every 
+	/// key in right. This takes the last node of left out and uses it as the middle node
+	/// for RBTreeJoin, so it runs in time proportional to the height of left.
+	///
+	template <bool bRanked>
+	rbtree_subtree RBTreeJoin2Impl(rbtree_subtree left, rbtree_subtree right)
+	{
+		if(!left.mpRoot)
+			return right;
+		if(!right.mpRoot)
+			return left;
+
+		rbtree_node_base* pNodeLast = NULL;
+		const rbtree_subtree rest = RBTreeSplitLast<bRanked>(left, pNodeLast);
+
+		return RBTreeJoinImpl<bRanked>(rest, pNodeLast, right);
+	}
+
+	EASTL_API rbtree_subtree RBTreeJoin2(rbtree_subtree left, rbtree_subtree right)
+	{
+		return RBTreeJoin2Impl<false>(left, right);
+	}
+
+	EASTL_API rbtree_subtree RBTreeRankedJoin2(rbtree_subtree left, rbtree_subtree right)
+	{
+		return RBTreeJoin2Impl<true>(left, right);
+	}
+
+
+
+	/// RBTreeRankedGetNth
+	/// Returns the node at (zero-based) position n in the ranked tree at pNodeRoot, 
+	/// or NULL if the tree has no more than n nodes.
+	///
+	EASTL_API rbtree_node_base* RBTreeRankedGetNth(const rbtree_node_base* pNodeRoot, size_t n)
+	{
+		while(pNodeRoot)
+		{
+			const size_t nLeftSize = RBTreeGetSubtreeSize(pNodeRoot->mpNodeLeft);
+
+			if(n < nLeftSize)
+				pNodeRoot = pNodeRoot->mpNodeLeft;
+			else if(n > nLeftSize)
+			{
+				n -= (nLeftSize + 1);
+				pNodeRoot = pNodeRoot->mpNodeRight;
+			}
+			else
+				break;
+		}
+
+		return const_cast<rbtree_node_base*>(pNodeRoot);
+	}
+
+
+
+	/// RBTreeRankedGetIndex
+	/// Returns the (zero-based) position of pNode in the ranked tree with the given anchor.
+	/// pNode must not be the anchor.
+	///
+	EASTL_API size_t RBTreeRankedGetIndex(const rbtree_node_base* pNode, const rbtree_node_base* pNodeAnchor)
+	{
+		size_t n = RBTreeGetSubtreeSize(pNode->mpNodeLeft);
+
+		for(const rbtree_node_base* pNodeParent = pNode->GetParent(); pNodeParent != pNodeAnchor; pNode = pNodeParent, pNodeParent = pNode->GetParent())
+		{
+			if(pNode == pNodeParent->mpNodeRight) // Everything in the parent's left subtree and the parent itself come before us.
+				n += RBTreeGetSubtreeSize(pNodeParent->mpNodeLeft) + 1;
+		}
+
+		return n;
+	}
+
 
 
 } // namespace eastl
@@ -0,0 +1,596 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <EASTL/thread_caching_allocator.h>
+#include <EASTL/allocator.h>
+#include <EASTL/atomic.h>
+#include <EASTL/bit.h>
+#include <EASTL/internal/thread_support.h>
+
+EA_DISABLE_ALL_VC_WARNINGS();
+#include <new>
+#include <string.h>
+EA_RESTORE_ALL_VC_WARNINGS();
+
+
+
+namespace eastl
+{
+
+	/// gDefaultThreadCachingAllocator
+	/// Default global thread_caching_allocator instance.
+	EASTL_API thread_caching_allocator gDefaultThreadCachingAllocator;
+
+	EASTL_API thread_caching_allocator* GetDefaultThreadCachingAllocator()
+	{
+		return &gDefaultThreadCachingAllocator;
+	}
+
+
+	namespace
+	{
+		const int      kChunkShift        = 16;
+		const size_t   kChunkSize         = (size_t)1 << kChunkShift; // Chunks are aligned to their size, so a block's chunk header is found by masking its address.
+		const size_t   kChunkHeaderSize   = 64;        // Blocks start a cache line into their chunk, so they're aligned to up to 64.
+		const size_t   kMaxSmallSize      = 8192;
+		const size_t   kMaxSmallAlignment = kChunkHeaderSize;
+		const size_t   kBatchSize         = 16384;     // The number of bytes a thread moves to or from a central list at once.
+		const size_t   kMaxBatchCount     = 64;
+		const int      kSizeClassCount    = 32;
+
+
+		struct Block
+		{
+			Block* mpNext;
+			Block* mpNextBatch; // Used by the first block of each batch in a central list.
+		};
+
+		struct ChunkHeader
+		{
+			uint32_t mnSizeClass;
+		};
+
+		static_assert(sizeof(ChunkHeader) <= kChunkHeaderSize, "ChunkHeader must fit before the first block of its chunk.");
+
+		// Placed immediately before a large block. It may be misaligned, so it's copied in and out.
+		struct LargeHeader
+		{
+			void*  mpMemory;     // The memory allocated from the system.
+			size_t mnMemorySize;
+		};
+
+
+		// The sizes are 16 to 128 in steps of 16, and then four steps per power of two up to 8192.
+		inline int GetSizeClass(size_t n)
+		{
+			if(n <= 128)
+				return (n <= 16) ? 0 : (int)((n + 15) >> 4) - 1;
+
+			const uint32_t m = (uint32_t)(n - 1);
+			const int      b = 31 - eastl::countl_zero(m);
+
+			return 8 + ((b - 7) * 4) + (int)((m >> (b - 2)) & 3);
+		}
+
+		inline size_t GetSizeClassSize(int c)
+		{
+			if(c < 8)
+				return (size_t)(c + 1) * 16;
+
+			const int b = 7 + ((c - 8) >> 2);
+			return ((size_t)1 << b) + ((size_t)((c - 8) & 3) + 1) * ((size_t)1 << (b - 2));
+		}
+
+		inline size_t GetBatchCount(int c)
+		{
+			const size_t nCount = kBatchSize / GetSizeClassSize(c);
+			return (nCount < 2) ? 2 : (nCount > kMaxBatchCount) ? kMaxBatchCount : nCount;
+		}
+
+		inline ChunkHeader* GetChunkHeader(void* p)
+		{
+			return reinterpret_cast<ChunkHeader*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(kChunkSize - 1));
+		}
+
+		inline void* AllocateSystemMemory(size_t n, size_t alignment)
+		{
+			eastl::allocator allocator(EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME);
+			return allocate_memory(allocator, n, alignment, 0);
+		}
+
+		inline void FreeSystemMemory(void* p, size_t n)
+		{
+			eastl::allocator allocator(EASTL_THREAD_CACHING_ALLOCATOR_DEFAULT_NAME);
+			EASTLFree(allocator, p, n);
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// Chunk map
+		///////////////////////////////////////////////////////////////////////
+
+		// A bit per possible chunk address, set for each chunk of small blocks. It lets
+		// deallocate tell a small block from a large one without reading memory outside
+		// the block, as the chunk-aligned address below a large block may not be ours.
+		// The bits are split into leaves, which are allocated when first needed. Chunks
+		// are never freed, so bits are only ever set.
+		#if (EA_PLATFORM_PTR_SIZE == 8)
+			const int kChunkMapAddressBits = 48;
+		#else
+			const int kChunkMapAddressBits = 32;
+		#endif
+
+		const int    kChunkMapBits         = kChunkMapAddressBits - kChunkShift;
+		const int    kChunkMapLeafBits     = (kChunkMapBits < 20) ? kChunkMapBits : 20; // A leaf of 2^20 bits covers 64 GB.
+		const size_t kChunkMapRootCount    = (size_t)1 << (kChunkMapBits - kChunkMapLeafBits);
+		const size_t kChunkMapBitsPerWord  = sizeof(uintptr_t) * 8;
+
+		struct ChunkMapLeaf
+		{
+			eastl::atomic<uintptr_t> mWords[((size_t)1 << kChunkMapLeafBits) / kChunkMapBitsPerWord]; // Zero-initialized by the constructor.
+		};
+
+		eastl::atomic<ChunkMapLeaf*> gChunkMap[kChunkMapRootCount];
+
+
+		bool IsSmallChunk(const void* p)
+		{
+			const uintptr_t nChunk = reinterpret_cast<uintptr_t>(p) >> kChunkShift;
+			const uintptr_t nRoot  = nChunk >> kChunkMapLeafBits;
+
+			if(nRoot >= kChunkMapRootCount)
+				return false;
+
+			const ChunkMapLeaf* const pLeaf = gChunkMap[nRoot].load(eastl::memory_order_acquire);
+			const uintptr_t           nBit  = nChunk & (((uintptr_t)1 << kChunkMapLeafBits) - 1);
+
+			return pLeaf && ((pLeaf->mWords[nBit / kChunkMapBitsPerWord].load(eastl::memory_order_relaxed) >> (nBit % kChunkMapBitsPerWord)) & 1);
+		}
+
+
+		// Returns false if the chunk at p can't be recorded, in which case it mustn't be used for small blocks.
+		bool AddSmallChunk(const void* p)
+		{
+			const uintptr_t nChunk = reinterpret_cast<uintptr_t>(p) >> kChunkShift;
+			const uintptr_t nRoot  = nChunk >> kChunkMapLeafBits;
+
+			if(nRoot >= kChunkMapRootCount)
+				return false;
+
+			ChunkMapLeaf* pLeaf = gChunkMap[nRoot].load(eastl::memory_order_acquire);
+
+			if(!pLeaf)
+			{
+				void* const pMemory = AllocateSystemMemory(sizeof(ChunkMapLeaf), EASTL_ALIGN_OF(ChunkMapLeaf));
+
+				if(!pMemory)
+					return false;
+
+				ChunkMapLeaf* const pNewLeaf = ::new(pMemory) ChunkMapLeaf;
+
+				if(gChunkMap[nRoot].compare_exchange_strong(pLeaf, pNewLeaf, eastl::memory_order_acq_rel, eastl::memory_order_acquire))
+					pLeaf = pNewLeaf;
+				else
+					FreeSystemMemory(pNewLeaf, sizeof(ChunkMapLeaf)); // Another thread added the leaf first.
+			}
+
+			const uintptr_t nBit = nChunk & (((uintptr_t)1 << kChunkMapLeafBits) - 1);
+			pLeaf->mWords[nBit / kChunkMapBitsPerWord].fetch_or((uintptr_t)1 << (nBit % kChunkMapBitsPerWord), eastl::memory_order_relaxed);
+
+			return true;
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// Central free lists
+		///////////////////////////////////////////////////////////////////////
+
+		// The lock is held only to link or unlink a batch, so we spin rather than sleep.
+		// The central lists are zero-initialized, so they're usable by the constructors
+		// of other globals regardless of initialization order.
+		struct SpinLock
+		{
+			eastl::atomic<uint32_t> mnLocked;
+
+			void lock()
+			{
+				for(int spinCount = 0; ; )
+				{
+					if(!mnLocked.load(eastl::memory_order_relaxed) && !mnLocked.exchange(1, eastl::memory_order_acquire))
+						return;
+
+					if(++spinCount < 64)
+						eastl::cpu_pause();
+					else
+						Internal::thread_yield();
+				}
+			}
+
+			void unlock()
+			{
+				mnLocked.store(0, eastl::memory_order_release);
+			}
+		};
+
+		struct alignas(64) CentralList
+		{
+			SpinLock mLock;
+			Block*   mpBatches;     // Batches of exactly GetBatchCount blocks, linked by mpNextBatch.
+			Block*   mpLoose;       // Blocks which didn't make up a whole batch, linked by mpNext.
+			size_t   mnLooseCount;
+		};
+
+		CentralList gCentralLists[kSizeClassCount];
+
+
+		// Adds the list pHead of nCount blocks to the central list of size class c.
+		void CentralGive(int c, Block* pHead, size_t nCount)
+		{
+			const size_t nBatchCount = GetBatchCount(c);
+			CentralList& central     = gCentralLists[c];
+
+			// Split the list into whole batches, outside of the lock.
+			Block* pBatches     = NULL;
+			Block* pBatchesTail = NULL;
+
+			for(; nCount >= nBatchCount; nCount -= nBatchCount)
+			{
+				Block* pTail = pHead;
+				for(size_t i = 1; i < nBatchCount; i++)
+					pTail = pTail->mpNext;
+
+				Block* const pNext = pTail->mpNext;
+				pTail->mpNext      = NULL;
+				pHead->mpNextBatch = NULL;
+
+				if(pBatchesTail)
+					pBatchesTail->mpNextBatch = pHead;
+				else
+					pBatches = pHead;
+
+				pBatchesTail = pHead;
+				pHead        = pNext;
+			}
+
+			Block* pLooseTail = NULL;
+			if(nCount)
+			{
+				pLooseTail = pHead;
+				while(pLooseTail->mpNext)
+					pLooseTail = pLooseTail->mpNext;
+			}
+
+			central.mLock.lock();
+
+			if(pBatchesTail)
+			{
+				pBatchesTail->mpNextBatch = central.mpBatches;
+				central.mpBatches         = pBatches;
+			}
+
+			if(pLooseTail)
+			{
+				pLooseTail->mpNext    = central.mpLoose;
+				central.mpLoose       = pHead;
+				central.mnLooseCount += nCount;
+			}
+
+			central.mLock.unlock();
+		}
+
+
+		// Carves a new chunk into blocks of size class c. Returns a batch of them, and
+		// gives the rest to the central list.
+		Block* CentralNewChunk(int c, size_t& nCount)
+		{
+			void* const pMemory = AllocateSystemMemory(kChunkSize, kChunkSize);
+
+			if(!pMemory)
+				return NULL;
+
+			if(!AddSmallChunk(pMemory))
+			{
+				FreeSystemMemory(pMemory, kChunkSize);
+				return NULL;
+			}
+
+			ChunkHeader* const pHeader = ::new(pMemory) ChunkHeader;
+			pHeader->mnSizeClass = (uint32_t)c;
+
+			const size_t nSize       = GetSizeClassSize(c);
+			const size_t nBlockCount = (kChunkSize - kChunkHeaderSize) / nSize;
+			char* const  pBegin      = static_cast<char*>(pMemory) + kChunkHeaderSize;
+
+			for(size_t i = 0; i < nBlockCount; i++)
+				reinterpret_cast<Block*>(pBegin + (i * nSize))->mpNext = ((i + 1) < nBlockCount) ? reinterpret_cast<Block*>(pBegin + ((i + 1) * nSize)) : NULL;
+
+			// Keep the first batch and give the rest away.
+			nCount = GetBatchCount(c);
+			if(nCount > nBlockCount)
+				nCount = nBlockCount;
+
+			Block* const pLast = reinterpret_cast<Block*>(pBegin + ((nCount - 1) * nSize));
+
+			if(pLast->mpNext)
+			{
+				CentralGive(c, pLast->mpNext, nBlockCount - nCount);
+				pLast->mpNext = NULL;
+			}
+
+			return reinterpret_cast<Block*>(pBegin);
+		}
+
+
+		// Takes a list of blocks of size class c from the central list, or from a new chunk
+		// if the central list is empty. Returns NULL if there's no chunk to be had.
+		Block* CentralTake(int c, size_t& nCount)
+		{
+			CentralList& central = gCentralLists[c];
+			Block*       pHead   = NULL;
+
+			central.mLock.lock();
+
+			if(central.mpBatches)
+			{
+				pHead             = central.mpBatches;
+				central.mpBatches = pHead->mpNextBatch;
+				nCount            = GetBatchCount(c);
+			}
+			else if(central.mpLoose)
+			{
+				pHead                = central.mpLoose;
+				nCount               = central.mnLooseCount;
+				central.mpLoose      = NULL;
+				central.mnLooseCount = 0;
+			}
+
+			central.mLock.unlock();
+
+			return pHead ? pHead : CentralNewChunk(c, nCount);
+		}
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// Thread caches
+		///////////////////////////////////////////////////////////////////////
+
+		struct ThreadCache
+		{
+			Block*   mpLists[kSizeClassCount];
+			uint32_t mnCounts[kSizeClassCount];
+		};
+
+		void FlushThreadCache(ThreadCache& cache)
+		{
+			for(int c = 0; c < kSizeClassCount; c++)
+			{
+				if(cache.mpLists[c])
+				{
+					CentralGive(c, cache.mpLists[c], cache.mnCounts[c]);
+					cache.mpLists[c]  = NULL;
+					cache.mnCounts[c] = 0;
+				}
+			}
+		}
+
+		#if EASTL_THREAD_CACHING_ALLOCATOR_TLS_ENABLED
+			enum ThreadCacheState
+			{
+				kThreadCacheNone,
+				kThreadCacheActive,
+				kThreadCacheDestroyed  // The thread is exiting, and blocks it frees go straight to the central lists.
+			};
+
+			// The cache itself has no constructor or destructor, so accessing it needs no
+			// thread_local initialization check. The reaper is constructed when the thread
+			// first uses its cache, and returns the cache to the central lists when the
+			// thread exits.
+			thread_local ThreadCache tThreadCache;
+			thread_local int         tThreadCacheState;
+
+			struct ThreadCacheReaper
+			{
+				ThreadCacheReaper()  { tThreadCacheState = kThreadCacheActive; }
+			   ~ThreadCacheReaper()  { FlushThreadCache(tThreadCache); tThreadCacheState = kThreadCacheDestroyed; }
+
+				void Touch() { }
+			};
+
+			thread_local ThreadCacheReaper tThreadCacheReaper;
+
+			inline ThreadCache* GetThreadCache()
+			{
+				if(EASTL_LIKELY(tThreadCacheState == kThreadCacheActive))
+					return &tThreadCache;
+
+				if(tThreadCacheState == kThreadCacheDestroyed)
+					return NULL;
+
+				tThreadCacheReaper.Touch(); // Constructs the reaper, which activates the cache.
+				return &tThreadCache;
+			}
+		#else
+			inline ThreadCache* GetThreadCache()
+			{
+				return NULL;
+			}
+		#endif
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		// Blocks
+		///////////////////////////////////////////////////////////////////////
+
+		void* AllocateSmall(int c)
+		{
+			ThreadCache* const pCache = GetThreadCache();
+			size_t             nCount;
+
+			if(EASTL_LIKELY(pCache != NULL))
+			{
+				Block* const pBlock = pCache->mpLists[c];
+
+				if(EASTL_LIKELY(pBlock != NULL))
+				{
+					pCache->mpLists[c] = pBlock->mpNext;
+					pCache->mnCounts[c]--;
+					return pBlock;
+				}
+
+				Block* const pHead = CentralTake(c, nCount);
+
+				if(pHead)
+				{
+					pCache->mpLists[c]  = pHead->mpNext;
+					pCache->mnCounts[c] = (uint32_t)(nCount - 1);
+				}
+
+				return pHead;
+			}
+
+			// Without a cache we take a list and give back all but one block.
+			Block* const pHead = CentralTake(c, nCount);
+
+			if(pHead && pHead->mpNext)
+				CentralGive(c, pHead->mpNext, nCount - 1);
+
+			return pHead;
+		}
+
+
+		void DeallocateSmall(int c, void* p)
+		{
+			ThreadCache* const pCache = GetThreadCache();
+			Block* const       pBlock = static_cast<Block*>(p);
+
+			if(EASTL_LIKELY(pCache != NULL))
+			{
+				pBlock->mpNext     = pCache->mpLists[c];
+				pCache->mpLists[c] = pBlock;
+
+				// When the list exceeds two batches we return one. Keeping a batch
+				// means that a thread which alternately allocates and frees at a batch
+				// boundary doesn't move a batch every time.
+				const size_t nBatchCount = GetBatchCount(c);
+
+				if(EASTL_UNLIKELY(++pCache->mnCounts[c] > (2 * nBatchCount)))
+				{
+					Block* pTail = pBlock;
+					for(size_t i = 1; i < nBatchCount; i++)
+						pTail = pTail->mpNext;
+
+					pCache->mpLists[c]   = pTail->mpNext;
+					pCache->mnCounts[c] -= (uint32_t)nBatchCount;
+					pTail->mpNext        = NULL;
+
+					CentralGive(c, pBlock, nBatchCount);
+				}
+			}
+			else
+			{
+				pBlock->mpNext = NULL;
+				CentralGive(c, pBlock, 1);
+			}
+		}
+
+
+		void* AllocateLarge(size_t n, size_t alignment, size_t offset)
+		{
+			// The memory has the block's alignment, and the block goes as near to its
+			// start as the offset allows, after room for the header.
+			const size_t nPadding = ((sizeof(LargeHeader) + offset + (alignment - 1)) & ~(alignment - 1)) - offset;
+			const LargeHeader header = { AllocateSystemMemory(nPadding + n, alignment), nPadding + n };
+
+			if(!header.mpMemory)
+				return NULL;
+
+			char* const pBlock = static_cast<char*>(header.mpMemory) + nPadding;
+			memcpy(pBlock - sizeof(LargeHeader), &header, sizeof(LargeHeader));
+
+			return pBlock;
+		}
+
+
+		void DeallocateLarge(void* p)
+		{
+			LargeHeader header;
+			memcpy(&header, static_cast<char*>(p) - sizeof(LargeHeader), sizeof(LargeHeader));
+
+			FreeSystemMemory(header.mpMemory, header.mnMemorySize);
+		}
+
+	} // namespace
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	// thread_caching_allocator
+	///////////////////////////////////////////////////////////////////////////
+
+	void* thread_caching_allocator::allocate(size_t n, int /*flags*/)
+	{
+		// If no chunk can be had for a small block, we try it as a large one.
+		if(EASTL_LIKELY(n <= kMaxSmallSize))
+		{
+			if(void* const p = AllocateSmall(GetSizeClass(n)))
+				return p;
+		}
+
+		return AllocateLarge(n, EASTL_ALLOCATOR_MIN_ALIGNMENT, 0);
+	}
+
+
+	void* thread_caching_allocator::allocate(size_t n, size_t alignment, size_t offset, int /*flags*/)
+	{
+		EASTL_ASSERT((alignment & (alignment - 1)) == 0); // Alignment must be a power of 2.
+
+		if(alignment == 0)
+			alignment = 1;
+
+		if((n <= kMaxSmallSize) && (alignment <= kMaxSmallAlignment) && ((offset % alignment) == 0))
+		{
+			// Blocks of a size class are aligned to the largest power of 2 which divides the size, up to 64.
+			int c = GetSizeClass((n > alignment) ? n : alignment);
+
+			while((c < kSizeClassCount) && (GetSizeClassSize(c) % alignment))
+				++c;
+
+			if(c < kSizeClassCount)
+			{
+				if(void* const p = AllocateSmall(c))
+					return p;
+			}
+		}
+
+		return AllocateLarge(n, alignment, offset);
+	}
+
+
+	void thread_caching_allocator::deallocate(void* p, size_t /*n*/)
+	{
+		if(p)
+		{
+			if(IsSmallChunk(p))
+				DeallocateSmall((int)GetChunkHeader(p)->mnSizeClass, p);
+			else
+				DeallocateLarge(p);
+		}
+	}
+
+
+	void thread_caching_allocator::flush_thread_cache()
+	{
+		#if EASTL_THREAD_CACHING_ALLOCATOR_TLS_ENABLED
+			if(tThreadCacheState == kThreadCacheActive)
+				FlushThreadCache(tThreadCache);
+		#endif
+	}
+
+
+} // namespace eastl
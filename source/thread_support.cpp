@@ -15,6 +15,8 @@
 	#endif
 	#include <Windows.h>
 	EA_RESTORE_ALL_VC_WARNINGS();
+#elif defined(EA_PLATFORM_POSIX)
+	#include <sched.h>
 #endif
 
 
@@ -91,6 +93,20 @@ namespace eastl
 		#endif
 
 
+		/////////////////////////////////////////////////////////////////
+		// thread_yield
+		/////////////////////////////////////////////////////////////////
+
+		void thread_yield()
+		{
+			#if defined(EA_PLATFORM_MICROSOFT)
+				SwitchToThread();
+			#elif defined(EA_PLATFORM_POSIX)
+				sched_yield();
+			#endif
+		}
+
+
 		/////////////////////////////////////////////////////////////////
 		// shared_ptr_auto_mutex
 		/////////////////////////////////////////////////////////////////
@@ -33,9 +33,11 @@ int TestBit();
 int TestBadExpectedAccess();
 int TestBitVector();
 int TestBitset();
+int TestBTree();
 int TestCharTraits();
 int TestChrono();
 int TestConcepts();
+int TestConcurrentHashMap();
 int TestContainerBehaviour();
 int TestCppCXTypeTraits();
 int TestDeque();
@@ -51,6 +53,7 @@ int TestFixedSet();
 int TestFixedString();
 int TestFixedTupleVector();
 int TestFixedVector();
+int TestFlatHash();
 int TestFunctional();
 int TestHash();
 int TestHeap();
@@ -58,16 +61,19 @@ int TestIntrusiveHash();
 int TestIntrusiveList();
 int TestIntrusiveSDList();
 int TestIntrusiveSList();
+int TestIntrusiveTree();
 int TestIterator();
 int TestList();
 int TestListMap();
 int TestLruCache();
 int TestMap();
 int TestMemory();
+int TestMemoryResource();
 int TestMeta();
 int TestNumericLimits();
 int TestOptional();
 int TestRandom();
+int TestRankedMap();
 int TestRatio();
 int TestRingBuffer();
 int TestSList();
@@ -76,6 +82,7 @@ int TestSet();
 int TestSmartPtr();
 int TestSort();
 int TestSpan();
+int TestStaticSorted();
 int TestString();
 int TestStringHashMap();
 int TestStringMap();
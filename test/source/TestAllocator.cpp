@@ -8,9 +8,23 @@
 #include <EASTL/allocator_malloc.h>
 #include <EASTL/fixed_allocator.h>
 #include <EASTL/core_allocator_adapter.h>
+#include <EASTL/arena_allocator.h>
+#include <EASTL/node_pool_allocator.h>
+#include <EASTL/thread_caching_allocator.h>
+#include <EASTL/profiling_allocator.h>
 #include <EASTL/list.h>
+#include <EASTL/slist.h>
+#include <EASTL/map.h>
+#include <EASTL/set.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/vector.h>
+#include <EASTL/string.h>
+#include <EASTL/atomic.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/bonus/lru_cache.h>
 #include <EAStdC/EAString.h>
 #include <EAStdC/EAAlignment.h>
+#include <eathread/eathread_thread.h>
 
 
 
@@ -376,6 +390,736 @@ static int TestAllocationOffsetAndAlignment()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// TestArenaAllocator
+//
+static int TestArenaAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{   // Allocation from the initial buffer, then from chunks.
+		char buffer[1024];
+		arena a(buffer, sizeof(buffer), 4096);
+
+		void* p1 = a.allocate(100);
+		void* p2 = a.allocate(100, 64, 0);
+		void* p3 = a.allocate(100, 32, 8);
+
+		EATEST_VERIFY((p1 >= buffer) && ((char*)p1 + 100 <= buffer + sizeof(buffer)));
+		EATEST_VERIFY(EA::StdC::IsAligned(p1, EASTL_ALLOCATOR_MIN_ALIGNMENT));
+		EATEST_VERIFY(EA::StdC::IsAligned(p2, 64) && ((char*)p2 >= (char*)p1 + 100));
+		EATEST_VERIFY(EA::StdC::IsAligned((char*)p3 + 8, 32) && ((char*)p3 >= (char*)p2 + 100));
+		EATEST_VERIFY(a.chunk_count() == 0);
+		EATEST_VERIFY(a.validate());
+
+		void* p4 = a.allocate(1000); // Doesn't fit in the rest of the buffer.
+		EATEST_VERIFY(p4 && ((p4 < buffer) || (p4 >= buffer + sizeof(buffer))));
+		EATEST_VERIFY(a.chunk_count() == 1);
+		memset(p4, 0, 1000);
+
+		void* p5 = a.allocate(100000); // Larger than any chunk.
+		EATEST_VERIFY(p5 && (a.chunk_count() == 2));
+		memset(p5, 0, 100000);
+		EATEST_VERIFY(a.validate());
+
+		a.reset();
+		EATEST_VERIFY(a.allocate(100) == p1); // We are back at the start of the buffer.
+		EATEST_VERIFY(a.validate());
+
+		a.release();
+		EATEST_VERIFY(a.chunk_count() == 0);
+		EATEST_VERIFY(a.validate());
+	}
+
+	{   // mark and rewind reuse the same memory, and don't allocate more chunks.
+		arena a(1024);
+
+		a.allocate(10);
+		const arena::marker m = a.mark();
+
+		vector<void*> first;
+		for(int i = 0; i < 1000; i++)
+			first.push_back(a.allocate((size_t)(i % 100) + 1));
+
+		const size_t nChunkCount = a.chunk_count();
+		EATEST_VERIFY(nChunkCount > 1);
+		EATEST_VERIFY(a.validate());
+
+		for(int j = 0; j < 3; j++)
+		{
+			a.rewind(m);
+			EATEST_VERIFY(a.validate());
+
+			for(int i = 0; i < 1000; i++)
+				EATEST_VERIFY(a.allocate((size_t)(i % 100) + 1) == first[(eastl_size_t)i]);
+
+			EATEST_VERIFY(a.chunk_count() == nChunkCount);
+		}
+
+		{   // Nested scopes.
+			arena_scope outer(a);
+			void* p = a.allocate(50);
+
+			{
+				arena_scope inner(a);
+				for(int i = 0; i < 100; i++)
+					a.allocate(500);
+			}
+
+			const uintptr_t nExpected = ((uintptr_t)p + 50 + (EASTL_ALLOCATOR_MIN_ALIGNMENT - 1)) & ~(uintptr_t)(EASTL_ALLOCATOR_MIN_ALIGNMENT - 1);
+			EATEST_VERIFY((uintptr_t)a.allocate(50) == nExpected); // The inner scope's memory was rewound.
+			EATEST_VERIFY(a.validate());
+		}
+	}
+
+	{   // Containers, which stop allocating chunks once the arena has grown to fit their work.
+		arena a;
+		size_t nChunkCount = 0;
+
+		for(int frame = 0; frame < 4; frame++)
+		{
+			{
+				arena_scope scope(a);
+				arena_allocator allocator(&a);
+
+				vector<int, arena_allocator> intVector(allocator);
+				basic_string<char, arena_allocator> str(allocator);
+				hash_map<int, int, hash<int>, equal_to<int>, arena_allocator> intHashMap(allocator);
+				list<int, arena_allocator> intList(allocator);
+				map<int, int, less<int>, arena_allocator> intMap(allocator);
+
+				for(int i = 0; i < 2000; i++)
+				{
+					intVector.push_back(i);
+					str += (char)('a' + (i % 26));
+					intHashMap[i] = i;
+					intList.push_front(i);
+					intMap[i] = i;
+				}
+
+				EATEST_VERIFY((intVector.size() == 2000) && (intVector[1999] == 1999));
+				EATEST_VERIFY((str.size() == 2000) && (str[1999] == (char)('a' + (1999 % 26))));
+				EATEST_VERIFY(intHashMap.validate() && (intHashMap[1999] == 1999));
+				EATEST_VERIFY((intList.size() == 2000) && (intList.front() == 1999));
+				EATEST_VERIFY(intMap.validate() && (intMap.size() == 2000));
+
+				// Containers with the same arena swap in O(1).
+				vector<int, arena_allocator> intVector2(allocator);
+				intVector2.swap(intVector);
+				EATEST_VERIFY(intVector.empty() && (intVector2.size() == 2000));
+			}
+
+			EATEST_VERIFY(a.validate());
+
+			if(frame == 0)
+				nChunkCount = a.chunk_count();
+			else
+				EATEST_VERIFY(a.chunk_count() == nChunkCount);
+		}
+	}
+
+	{   // Without an arena, arena_allocator uses the heap.
+		vector<int, arena_allocator> intVector;
+		for(int i = 0; i < 1000; i++)
+			intVector.push_back(i);
+
+		EATEST_VERIFY((intVector.get_allocator().get_arena() == NULL) && (intVector[999] == 999));
+	}
+
+	return nErrorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestNodePoolAllocator
+//
+static int TestNodePoolAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{   // node_pool
+		node_pool pool(EASTLAllocatorType(), 4, 4096);
+		vector<void*> nodes;
+
+		EATEST_VERIFY(pool.node_size() == 0);
+		EATEST_VERIFY(pool.slab_count() == 0);
+
+		for(int i = 0; i < 100; i++)
+		{
+			void* p = pool.allocate(24, 8);
+			EATEST_VERIFY(p && EA::StdC::IsAligned(p, 8));
+			memset(p, 0xcc, 24);
+			nodes.push_back(p);
+		}
+
+		EATEST_VERIFY(pool.node_size() == 24);
+		EATEST_VERIFY(pool.size() == 100);
+		EATEST_VERIFY(pool.capacity() >= 100);
+		EATEST_VERIFY(pool.slab_count() < 10); // Slabs grow geometrically: 4 + 4 + 8 + 16 + 32 + 64.
+		EATEST_VERIFY(pool.validate());
+
+		EATEST_VERIFY(pool.allocate(32, 8) == NULL);  // Larger than the pool's nodes.
+		EATEST_VERIFY(pool.allocate(24, 16) == NULL); // More aligned than the pool's nodes.
+		EATEST_VERIFY(pool.allocate(16, 4) != NULL);  // Smaller nodes fit.
+		int notFromPool;
+		EATEST_VERIFY(!pool.deallocate(&notFromPool));
+
+		// Free every other node, then the rest; all slabs but the spare are released.
+		for(eastl_size_t i = 0; i < nodes.size(); i += 2)
+			EATEST_VERIFY(pool.deallocate(nodes[i]));
+		EATEST_VERIFY(pool.validate());
+
+		for(eastl_size_t i = 1; i < nodes.size(); i += 2)
+			EATEST_VERIFY(pool.deallocate(nodes[i]));
+		EATEST_VERIFY(pool.validate());
+		EATEST_VERIFY(pool.size() == 1);
+
+		nodes.clear();
+		for(int i = 0; i < 1000; i++)
+		{
+			void* p = pool.allocate(24, 8);
+			EATEST_VERIFY(p != NULL);
+			nodes.push_back(p);
+		}
+		EATEST_VERIFY(pool.validate());
+		EATEST_VERIFY((pool.capacity() * 24) < (3 * 4096) + (1001 * 24)); // Slabs stop growing at the max slab size.
+
+		for(eastl_size_t i = 0; i < nodes.size(); i++)
+			pool.deallocate(nodes[i]);
+		EATEST_VERIFY(pool.validate());
+		EATEST_VERIFY(pool.size() == 1);
+		EATEST_VERIFY(pool.slab_count() == 2); // The slab with the remaining node, plus the spare.
+
+		pool.trim();
+		EATEST_VERIFY(pool.slab_count() == 1);
+		EATEST_VERIFY(pool.validate());
+	}
+
+	{   // list, slist
+		list<int, node_pool_allocator> intList(node_pool_allocator("intList", 8));
+		slist<int, node_pool_allocator> intSlist;
+
+		EATEST_VERIFY(intList.get_allocator().get_pool() == NULL);
+
+		for(int i = 0; i < 1000; i++)
+		{
+			intList.push_back(i);
+			intSlist.push_front(i);
+		}
+
+		node_pool* pPool = intList.get_allocator().get_pool();
+		EATEST_VERIFY(pPool && (pPool->size() == 1000) && pPool->validate());
+		EATEST_VERIFY(pPool->slab_count() < 12);
+		EATEST_VERIFY(intSlist.get_allocator().get_pool()->size() == 1000);
+
+		intList.remove_if([](int i) { return (i % 3) == 0; });
+		EATEST_VERIFY(pPool->size() == intList.size());
+		EATEST_VERIFY(pPool->validate());
+
+		// Copies share the pool, so splicing and swapping is O(1).
+		list<int, node_pool_allocator> intList2(intList);
+		EATEST_VERIFY(intList2.get_allocator() == intList.get_allocator());
+		EATEST_VERIFY(pPool->size() == (intList.size() * 2));
+
+		intList2.splice(intList2.end(), intList);
+		EATEST_VERIFY(intList.empty());
+		intList.swap(intList2);
+		EATEST_VERIFY(intList2.empty() && (pPool->size() == intList.size()));
+
+		intList.clear();
+		intSlist.clear();
+		EATEST_VERIFY(pPool->size() == 0);
+		EATEST_VERIFY(pPool->slab_count() == 1); // Only the spare is left.
+		EATEST_VERIFY(pPool->validate());
+	}
+
+	{   // map, set
+		map<int, int, less<int>, node_pool_allocator> intMap;
+		set<int, less<int>, node_pool_allocator> intSet;
+
+		for(int i = 0; i < 1000; i++)
+		{
+			intMap[(i * 7919) % 1000] = i;
+			intSet.insert((i * 7919) % 1000);
+		}
+
+		EATEST_VERIFY(intMap.validate() && intSet.validate());
+		EATEST_VERIFY(intMap.get_allocator().get_pool()->size() == 1000);
+		EATEST_VERIFY(intMap.get_allocator().get_pool()->validate());
+
+		for(int i = 0; i < 1000; i += 2)
+		{
+			intMap.erase(i);
+			intSet.erase(i);
+		}
+
+		EATEST_VERIFY(intMap.validate() && intSet.validate());
+		EATEST_VERIFY(intSet.get_allocator().get_pool()->size() == 500);
+		EATEST_VERIFY(intSet.get_allocator().get_pool()->validate());
+
+		// Moving between containers with different pools falls back to copying, and still works.
+		set<int, less<int>, node_pool_allocator> intSet2;
+		intSet2.insert(-1);
+		intSet2 = eastl::move(intSet);
+		EATEST_VERIFY((intSet2.size() == 500) && intSet2.validate());
+		EATEST_VERIFY(intSet2.get_allocator().get_pool()->validate());
+	}
+
+	{   // hash_map
+		hash_map<int, int, hash<int>, equal_to<int>, node_pool_allocator> intHashMap;
+
+		for(int i = 0; i < 1000; i++)
+			intHashMap[i] = i;
+
+		// The bucket array goes to the overflow allocator, and doesn't affect the node size.
+		node_pool* pPool = intHashMap.get_allocator().get_pool();
+		EATEST_VERIFY(pPool->size() == 1000);
+		EATEST_VERIFY(pPool->validate());
+		EATEST_VERIFY(intHashMap.validate());
+
+		for(int i = 0; i < 1000; i++)
+			EATEST_VERIFY(intHashMap.find(i)->second == i);
+
+		intHashMap.clear(true);
+		EATEST_VERIFY(pPool->size() == 0);
+	}
+
+	{   // lru_cache
+		lru_cache<int, int, node_pool_allocator> cache(100, node_pool_allocator("lru_cache"));
+
+		for(int i = 0; i < 1000; i++)
+		{
+			cache.insert(i, i * 2);
+			EATEST_VERIFY(cache.size() <= 100);
+		}
+
+		for(int i = 900; i < 1000; i++)
+			EATEST_VERIFY(cache.get(i) == (i * 2));
+		EATEST_VERIFY(!cache.contains(0));
+	}
+
+	{   // Over-aligned nodes are pooled with their alignment.
+		struct alignas(64) Align64 { int mX; };
+
+		list<Align64, node_pool_allocator> alignList;
+		for(int i = 0; i < 100; i++)
+			alignList.push_back(Align64{i});
+
+		for(auto& a : alignList)
+			EATEST_VERIFY(EA::StdC::IsAligned(&a, 64));
+		EATEST_VERIFY(alignList.get_allocator().get_pool()->size() == 100);
+	}
+
+	return nErrorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestThreadCachingAllocator
+//
+namespace
+{
+	// Blocks are stamped with their size, so that a block which is handed out
+	// twice, or overwritten by a neighbour, is detected when it's freed.
+	void StampBlock(void* p, size_t n)
+	{
+		memset(p, (int)(n & 0xff), n);
+		if(n >= sizeof(size_t))
+			memcpy(p, &n, sizeof(size_t));
+	}
+
+	bool CheckBlock(const void* p, size_t n)
+	{
+		const unsigned char* const pBytes = static_cast<const unsigned char*>(p);
+		size_t i = 0;
+
+		if(n >= sizeof(size_t))
+		{
+			size_t nStamped;
+			memcpy(&nStamped, p, sizeof(size_t));
+			if(nStamped != n)
+				return false;
+			i = sizeof(size_t);
+		}
+
+		for(; i < n; i++)
+		{
+			if(pBytes[i] != (unsigned char)(n & 0xff))
+				return false;
+		}
+
+		return true;
+	}
+
+	const int kExchangeThreadCount = 4;
+	const int kExchangeSlotCount   = 256;
+
+	struct ThreadCachingExchangeData
+	{
+		eastl::atomic<void*>  mSlots[kExchangeSlotCount];
+		EA::Thread::Semaphore mStartSema{0};
+		eastl::atomic<int>    mThreadIndex{0};
+		eastl::atomic<int>    mErrorCount{0};
+	};
+
+	size_t GetExchangeBlockSize(uint32_t r)
+	{
+		return sizeof(size_t) + ((r % 16) ? (r % 600) : (r % 20000)); // Mostly small blocks, and some large ones.
+	}
+
+	// Each thread puts blocks into random slots and frees the blocks it takes out of
+	// them, so most blocks are freed by a thread other than the one which allocated them.
+	intptr_t ThreadCachingExchangeThreadFn(void* pData)
+	{
+		ThreadCachingExchangeData& data = *static_cast<ThreadCachingExchangeData*>(pData);
+		const int threadIndex = data.mThreadIndex++;
+		eastl::thread_caching_allocator allocator;
+		EA::UnitTest::Rand rng((uint32_t)(threadIndex + 1));
+
+		data.mStartSema.Wait();
+
+		for(int i = 0; i < 20000; i++)
+		{
+			const size_t n = GetExchangeBlockSize(rng.RandValue());
+			void* const  p = allocator.allocate(n);
+
+			if(!p || !EA::StdC::IsAligned(p, EASTL_ALLOCATOR_MIN_ALIGNMENT))
+			{
+				data.mErrorCount++;
+				continue;
+			}
+
+			StampBlock(p, n);
+
+			if(void* const pOld = data.mSlots[rng.RandLimit(kExchangeSlotCount)].exchange(p))
+			{
+				size_t nOld;
+				memcpy(&nOld, pOld, sizeof(nOld));
+
+				if(!CheckBlock(pOld, nOld))
+					data.mErrorCount++;
+
+				allocator.deallocate(pOld, nOld);
+			}
+		}
+
+		if(threadIndex % 2) // Some threads flush their caches explicitly, and the others when they exit.
+			eastl::thread_caching_allocator::flush_thread_cache();
+
+		return 0;
+	}
+}
+
+static int TestThreadCachingAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{   // Every size, up to beyond the largest size class.
+		thread_caching_allocator allocator;
+		vector<eastl::pair<void*, size_t>> blocks;
+
+		for(size_t n = 0; n < 20000; n += ((n < 1100) ? 1 : 97))
+		{
+			void* p = allocator.allocate(n);
+			EATEST_VERIFY(p && EA::StdC::IsAligned(p, EASTL_ALLOCATOR_MIN_ALIGNMENT));
+			StampBlock(p, n);
+			blocks.push_back(eastl::make_pair(p, n));
+		}
+
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+		random_shuffle(blocks.begin(), blocks.end(), rng);
+
+		for(eastl_size_t i = 0; i < blocks.size(); i++)
+		{
+			EATEST_VERIFY(CheckBlock(blocks[i].first, blocks[i].second));
+			allocator.deallocate(blocks[i].first, (i % 2) ? blocks[i].second : 0); // The size is optional.
+		}
+	}
+
+	{   // Aligned allocations, with and without offsets.
+		thread_caching_allocator allocator;
+		const size_t sizes[]   = { 1, 24, 100, 3000, 9000, 100000 };
+		const size_t offsets[] = { 0, 8, 16, 40, 70000 };
+
+		for(size_t alignment = 1; alignment <= 256 * 1024; alignment *= 2) // Alignments beyond the 64 KB chunk size go to the system too.
+		{
+			for(size_t s = 0; s < EAArrayCount(sizes); s++)
+			{
+				for(size_t o = 0; o < EAArrayCount(offsets); o++)
+				{
+					void* p = allocator.allocate(sizes[s], alignment, offsets[o]);
+					EATEST_VERIFY(p && EA::StdC::IsAligned(static_cast<char*>(p) + offsets[o], alignment));
+					StampBlock(p, sizes[s]);
+					EATEST_VERIFY(CheckBlock(p, sizes[s]));
+					allocator.deallocate(p, sizes[s]);
+				}
+			}
+		}
+	}
+
+	{   // Containers
+		list<int, thread_caching_allocator> intList;
+		map<int, int, less<int>, thread_caching_allocator> intMap;
+		hash_map<int, int, hash<int>, equal_to<int>, thread_caching_allocator> intHashMap;
+		vector<int, thread_caching_allocator> intVector;
+		basic_string<char, thread_caching_allocator> str;
+
+		for(int i = 0; i < 10000; i++)
+		{
+			intList.push_back(i);
+			intMap[i] = i;
+			intHashMap[i] = i;
+			intVector.push_back(i);
+			str += (char)('a' + (i % 26));
+		}
+
+		EATEST_VERIFY(intMap.validate() && intHashMap.validate());
+		EATEST_VERIFY((intList.size() == 10000) && (intList.back() == 9999));
+		EATEST_VERIFY((intVector.size() == 10000) && (intVector[9999] == 9999));
+		EATEST_VERIFY((str.size() == 10000) && (str[9999] == (char)('a' + (9999 % 26))));
+
+		list<int, thread_caching_allocator> intList2(intList);
+		intList.swap(intList2);
+		EATEST_VERIFY(intList == intList2);
+	}
+
+	{   // Blocks freed by other threads.
+		ThreadCachingExchangeData data;
+		for(int i = 0; i < kExchangeSlotCount; i++)
+			data.mSlots[i] = NULL;
+
+		EA::Thread::Thread threads[kExchangeThreadCount];
+
+		for(int i = 0; i < kExchangeThreadCount; i++)
+			threads[i].Begin(ThreadCachingExchangeThreadFn, static_cast<void*>(&data));
+
+		data.mStartSema.Post(kExchangeThreadCount);
+
+		for(int i = 0; i < kExchangeThreadCount; i++)
+			threads[i].WaitForEnd();
+
+		EATEST_VERIFY(data.mErrorCount == 0);
+
+		thread_caching_allocator allocator;
+		for(int i = 0; i < kExchangeSlotCount; i++)
+		{
+			if(void* p = data.mSlots[i].load())
+				allocator.deallocate(p, 0);
+		}
+	}
+
+	return nErrorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestProfilingAllocator
+//
+namespace
+{
+	#if EASTL_ALLOCATION_PROFILING_ENABLED
+		// Returns the profile recorded for pName, or a zeroed profile.
+		eastl::allocation_profile FindAllocationProfile(const char* pName)
+		{
+			eastl::vector<eastl::allocation_profile> profiles(eastl::GetAllocationProfiles(NULL, 0));
+			profiles.resize(eastl::min_alt(eastl::GetAllocationProfiles(profiles.data(), profiles.size()), profiles.size()));
+
+			for(eastl_size_t i = 0; i < profiles.size(); i++)
+			{
+				if(strcmp(profiles[i].mpName, pName) == 0)
+					return profiles[i];
+			}
+
+			eastl::allocation_profile profile;
+			memset(&profile, 0, sizeof(profile));
+			return profile;
+		}
+
+		void AppendReportLine(const char* pLine, void* pContext)
+		{
+			static_cast<eastl::string*>(pContext)->append(pLine);
+		}
+
+		const int kProfilingThreadCount = 4;
+
+		intptr_t ProfilingAllocatorThreadFn(void*)
+		{
+			eastl::profiling_allocator<> allocator("TestProfilingAllocator threads");
+
+			for(int i = 0; i < 10000; i++)
+			{
+				void* const p = allocator.allocate(32);
+				allocator.deallocate(p, 32);
+			}
+
+			return 0;
+		}
+	#endif
+}
+
+static int TestProfilingAllocator()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{   // profiling_allocator works as the allocator it wraps.
+		#if !EASTL_ALLOCATION_PROFILING_ENABLED
+			static_assert(sizeof(profiling_allocator<allocator>) == sizeof(allocator), "profiling_allocator should add nothing when profiling is disabled.");
+			EATEST_VERIFY(GetAllocationProfiles(NULL, 0) == 0);
+		#endif
+
+		typedef profiling_allocator<> ProfilingAllocator;
+
+		vector<int, ProfilingAllocator> intVector(ProfilingAllocator("TestProfilingAllocator vector"));
+		list<int, profiling_allocator<allocator_malloc>> intList;
+
+		for(int i = 0; i < 1000; i++)
+		{
+			intVector.push_back(i);
+			intList.push_back(i);
+		}
+
+		EATEST_VERIFY((intVector.size() == 1000) && (intList.size() == 1000));
+		EATEST_VERIFY(intVector.get_allocator() == ProfilingAllocator("another name"));
+
+		void* p = intVector.get_allocator().allocate(100, 64, 0);
+		EATEST_VERIFY(p && EA::StdC::IsAligned(p, 64));
+		intVector.get_allocator().deallocate(p, 100);
+	}
+
+	#if EASTL_ALLOCATION_PROFILING_ENABLED
+		{   // Counts, bytes and the size histogram.
+			profiling_allocator<> allocator("TestProfilingAllocator counts");
+
+			const size_t sizes[] = { 8, 16, 17, 100, 5000, 1 << 20 };
+			void* blocks[EAArrayCount(sizes)];
+
+			for(size_t i = 0; i < EAArrayCount(sizes); i++)
+				blocks[i] = allocator.allocate(sizes[i]);
+
+			const size_t nTotal = 8 + 16 + 17 + 100 + 5000 + (1 << 20);
+
+			allocation_profile profile = FindAllocationProfile("TestProfilingAllocator counts");
+			EATEST_VERIFY((profile.mnAllocCount == 6) && (profile.mnFreeCount == 0));
+			EATEST_VERIFY((profile.mnAllocBytes == nTotal) && (profile.mnLiveBytes == (int64_t)nTotal) && (profile.mnPeakBytes == (int64_t)nTotal));
+			EATEST_VERIFY(profile.mSizeHistogram[0] == 2);  // 8 and 16
+			EATEST_VERIFY(profile.mSizeHistogram[1] == 1);  // 17
+			EATEST_VERIFY(profile.mSizeHistogram[3] == 1);  // 100
+			EATEST_VERIFY(profile.mSizeHistogram[9] == 1);  // 5000
+			EATEST_VERIFY(profile.mSizeHistogram[allocation_profile::kHistogramSize - 1] == 1); // 1 MB
+
+			allocator.deallocate(blocks[5], sizes[5]);
+			allocator.deallocate(blocks[4], sizes[4]);
+
+			profile = FindAllocationProfile("TestProfilingAllocator counts");
+			EATEST_VERIFY((profile.mnFreeCount == 2) && (profile.mnLiveBytes == (int64_t)(8 + 16 + 17 + 100)) && (profile.mnPeakBytes == (int64_t)nTotal));
+
+			ResetAllocationProfiles();
+
+			profile = FindAllocationProfile("TestProfilingAllocator counts");
+			EATEST_VERIFY((profile.mnAllocCount == 0) && (profile.mnFreeCount == 0) && (profile.mnAllocBytes == 0) && (profile.mSizeHistogram[0] == 0));
+			EATEST_VERIFY((profile.mnLiveBytes == (int64_t)(8 + 16 + 17 + 100)) && (profile.mnPeakBytes == profile.mnLiveBytes));
+
+			for(size_t i = 0; i < 4; i++)
+				allocator.deallocate(blocks[i], sizes[i]);
+
+			EATEST_VERIFY(FindAllocationProfile("TestProfilingAllocator counts").mnLiveBytes == 0);
+		}
+
+		{   // Containers are recorded under their default names, or the names they are given.
+			const int64_t nListPeak = FindAllocationProfile(EASTL_LIST_DEFAULT_NAME).mnPeakBytes;
+
+			{
+				list<int, profiling_allocator<>> intList;
+				for(int i = 0; i < 100; i++)
+					intList.push_back(i);
+
+				hash_map<int, int, hash<int>, equal_to<int>, profiling_allocator<>> intHashMap;
+				intHashMap.get_allocator().set_name("TestProfilingAllocator hash_map");
+				for(int i = 0; i < 100; i++)
+					intHashMap[i] = i;
+
+				EATEST_VERIFY(FindAllocationProfile(EASTL_LIST_DEFAULT_NAME).mnLiveBytes >= (int64_t)(100 * sizeof(int)));
+				EATEST_VERIFY(FindAllocationProfile("TestProfilingAllocator hash_map").mnAllocCount > 100); // The nodes and the buckets.
+			}
+
+			EATEST_VERIFY(FindAllocationProfile(EASTL_LIST_DEFAULT_NAME).mnPeakBytes >= nListPeak);
+			EATEST_VERIFY(FindAllocationProfile("TestProfilingAllocator hash_map").mnLiveBytes == 0);
+
+			// Names are compared by value.
+			char name[] = "TestProfilingAllocator hash_map";
+			profiling_allocator<> allocator(name);
+			void* p = allocator.allocate(64);
+			EATEST_VERIFY(FindAllocationProfile("TestProfilingAllocator hash_map").mnLiveBytes == 64);
+			allocator.deallocate(p, 64);
+		}
+
+		{   // Names are copied when first recorded, so they may be built in temporary buffers.
+			{
+				char name[] = "TestProfilingAllocator temporary name";
+				profiling_allocator<> allocator(name);
+				void* p = allocator.allocate(48);
+				allocator.deallocate(p, 48);
+				memset(name, 'x', sizeof(name) - 1);
+			}
+
+			const allocation_profile profile = FindAllocationProfile("TestProfilingAllocator temporary name");
+			EATEST_VERIFY((profile.mnAllocCount == 1) && (strcmp(profile.mpName, "TestProfilingAllocator temporary name") == 0));
+
+			// Names longer than the record's copy are truncated, and recorded together if the copies are equal.
+			string longName("TestProfilingAllocator long name ");
+			longName.resize(EASTL_ALLOCATION_PROFILING_NAME_CAPACITY + 8, 'a');
+
+			profiling_allocator<> allocator1(longName.c_str());
+			longName.back() = 'b';
+			profiling_allocator<> allocator2(longName.c_str());
+
+			void* p1 = allocator1.allocate(16);
+			void* p2 = allocator2.allocate(16);
+
+			longName.resize(EASTL_ALLOCATION_PROFILING_NAME_CAPACITY - 1);
+			EATEST_VERIFY(FindAllocationProfile(longName.c_str()).mnLiveBytes == 32);
+
+			allocator1.deallocate(p1, 16);
+			allocator2.deallocate(p2, 16);
+		}
+
+		{   // Threads which record under the same name.
+			EA::Thread::Thread threads[kProfilingThreadCount];
+
+			for(int i = 0; i < kProfilingThreadCount; i++)
+				threads[i].Begin(ProfilingAllocatorThreadFn, NULL);
+
+			for(int i = 0; i < kProfilingThreadCount; i++)
+				threads[i].WaitForEnd();
+
+			const allocation_profile profile = FindAllocationProfile("TestProfilingAllocator threads");
+			EATEST_VERIFY((profile.mnAllocCount == (uint64_t)(10000 * kProfilingThreadCount)) && (profile.mnFreeCount == profile.mnAllocCount));
+			EATEST_VERIFY((profile.mnLiveBytes == 0) && (profile.mnPeakBytes >= 32) && (profile.mnPeakBytes <= 32 * kProfilingThreadCount));
+		}
+
+		{   // Report
+			string report;
+			ReportAllocationProfiles(AppendReportLine, &report);
+
+			EATEST_VERIFY(report.find("Peak bytes") != string::npos);
+			EATEST_VERIFY(report.find("TestProfilingAllocator counts") != string::npos);
+			EATEST_VERIFY(report.find("TestProfilingAllocator counts") < report.find("TestProfilingAllocator threads")); // Ordered by peak bytes.
+			EATEST_VERIFY(report.find(" 32:40000") != string::npos); // The threads' size histogram.
+		}
+	#endif
+
+	return nErrorCount;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // TestAllocator
 //
@@ -388,6 +1132,10 @@ int TestAllocator()
 	nErrorCount += TestAllocatorMalloc();
 	nErrorCount += TestCoreAllocatorAdapter();
 	nErrorCount += TestSwapAllocator();
+	nErrorCount += TestArenaAllocator();
+	nErrorCount += TestNodePoolAllocator();
+	nErrorCount += TestThreadCachingAllocator();
+	nErrorCount += TestProfilingAllocator();
 
 	return nErrorCount;
 }
@@ -0,0 +1,362 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "TestMap.h"
+#include "TestSet.h"
+#include "EASTLTest.h"
+#include <EASTL/btree_map.h>
+#include <EASTL/btree_set.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	#include <map>
+	#include <set>
+#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::btree_map<int, int>;
+template class eastl::btree_multimap<int, int>;
+template class eastl::btree_map<TestObject, TestObject>;
+template class eastl::btree_multimap<TestObject, TestObject>;
+template class eastl::btree_set<int>;
+template class eastl::btree_multiset<float>;
+template class eastl::btree_set<TestObject>;
+template class eastl::btree_multiset<TestObject>;
+template class eastl::btree_map<int, int, eastl::less<int>, EASTLAllocatorType, 16>; // The smallest possible nodes, with 3 values each.
+
+
+///////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+typedef eastl::btree_map<int, int> VBM1;
+typedef eastl::btree_map<TestObject, TestObject> VBM4;
+typedef eastl::btree_map<Align64, Align64> VBM7;
+typedef eastl::btree_multimap<int, int> VBMM1;
+typedef eastl::btree_multimap<TestObject, TestObject> VBMM4;
+typedef eastl::btree_multimap<Align64, Align64> VBMM7;
+typedef eastl::btree_set<int> VBS1;
+typedef eastl::btree_set<TestObject> VBS4;
+typedef eastl::btree_multiset<int> VBMS1;
+typedef eastl::btree_multiset<TestObject> VBMS4;
+
+// Small nodes make for deep trees, which exercises splits, merges and rebalancing with few values.
+typedef eastl::btree_map<int, int, eastl::less<int>, EASTLAllocatorType, 16> SmallNodeMap;
+typedef eastl::btree_multiset<int, eastl::less<int>, EASTLAllocatorType, 32> SmallNodeMultiset;
+
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	typedef std::map<int, int> VM3;
+	typedef std::map<TestObject, TestObject> VM6;
+	typedef std::map<Align64, Align64> VM9;
+	typedef std::multimap<int, int> VMM3;
+	typedef std::multimap<TestObject, TestObject> VMM6;
+	typedef std::multimap<Align64, Align64> VMM9;
+	typedef std::set<int> VS3;
+	typedef std::set<TestObject> VS6;
+	typedef std::multiset<int> VMS3;
+	typedef std::multiset<TestObject> VMS6;
+#endif
+
+
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	template <typename T>
+	bool BTreeValueEquals(const T& a, const T& b) { return a == b; }
+
+	template <typename K, typename V>
+	bool BTreeValueEquals(const eastl::pair<const K, V>& a, const std::pair<const K, V>& b) { return (a.first == b.first) && (a.second == b.second); }
+
+	// Applies a random mix of insertions and erasures to a btree and a std container and
+	// verifies that they agree and that the btree stays valid after every operation.
+	template <typename BTree, typename StdContainer, typename Insert>
+	int TestBTreeRandomOperations(int nOperationCount, int nKeyRange, Insert insertFn)
+	{
+		int nErrorCount = 0;
+
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+		BTree          bt;
+		StdContainer   sc;
+
+		for(int i = 0; i < nOperationCount; i++)
+		{
+			const int k = (int)rng.RandLimit((uint32_t)nKeyRange);
+
+			if(rng.RandLimit(3) != 0)
+				insertFn(bt, sc, k);
+			else
+			{
+				const typename BTree::size_type nErased = bt.erase(k);
+				EATEST_VERIFY(nErased == (typename BTree::size_type)sc.erase(k));
+			}
+
+			EATEST_VERIFY(bt.validate());
+			EATEST_VERIFY(bt.size() == (typename BTree::size_type)sc.size());
+		}
+
+		typename StdContainer::iterator itStd = sc.begin();
+		for(typename BTree::iterator it = bt.begin(); it != bt.end(); ++it, ++itStd)
+			EATEST_VERIFY(BTreeValueEquals(*it, *itStd));
+
+		// Searches agree for every key in range, including absent ones.
+		for(int k = -1; k <= nKeyRange; k++)
+		{
+			EATEST_VERIFY(eastl::distance(bt.begin(), bt.lower_bound(k)) == std::distance(sc.begin(), sc.lower_bound(k)));
+			EATEST_VERIFY(eastl::distance(bt.begin(), bt.upper_bound(k)) == std::distance(sc.begin(), sc.upper_bound(k)));
+			EATEST_VERIFY(bt.count(k) == (typename BTree::size_type)sc.count(k));
+		}
+
+		// Erase everything in random order through the iterator version of erase.
+		while(!bt.empty())
+		{
+			typename BTree::iterator it = bt.begin();
+			eastl::advance(it, (ptrdiff_t)rng.RandLimit((uint32_t)bt.size()));
+
+			itStd = sc.begin();
+			std::advance(itStd, eastl::distance(bt.begin(), it));
+
+			it    = bt.erase(it);
+			itStd = sc.erase(itStd);
+
+			EATEST_VERIFY(bt.validate());
+			EATEST_VERIFY(eastl::distance(bt.begin(), it) == std::distance(sc.begin(), itStd)); // erase returns the next value.
+		}
+
+		EATEST_VERIFY(sc.empty());
+		return nErrorCount;
+	}
+#endif
+
+
+int TestBTree()
+{
+	int nErrorCount = 0;
+
+	#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+		{   // Test construction
+			nErrorCount += TestMapConstruction<VBM1, VM3, false>();
+			nErrorCount += TestMapConstruction<VBM4, VM6, false>();
+			nErrorCount += TestMapConstruction<VBM7, VM9, false>();
+			nErrorCount += TestMapConstruction<eastl::btree_map<int, int, eastl::less<void>>, std::map<int, int, std::less<void>>, false>();
+
+			nErrorCount += TestMapConstruction<VBMM1, VMM3, true>();
+			nErrorCount += TestMapConstruction<VBMM4, VMM6, true>();
+			nErrorCount += TestMapConstruction<VBMM7, VMM9, true>();
+
+			nErrorCount += TestSetConstruction<VBS1, VS3, false>();
+			nErrorCount += TestSetConstruction<VBS4, VS6, false>();
+			nErrorCount += TestSetConstruction<VBMS1, VMS3, true>();
+			nErrorCount += TestSetConstruction<VBMS4, VMS6, true>();
+		}
+
+		{   // Test mutating functionality.
+			nErrorCount += TestMapMutation<VBM1, VM3, false>();
+			nErrorCount += TestMapMutation<VBM4, VM6, false>();
+			nErrorCount += TestMapMutation<VBM7, VM9, false>();
+			nErrorCount += TestMapMutation<eastl::btree_map<int, int, eastl::less<void>>, std::map<int, int, std::less<void>>, false>();
+
+			nErrorCount += TestMapMutation<VBMM1, VMM3, true>();
+			nErrorCount += TestMapMutation<VBMM4, VMM6, true>();
+			nErrorCount += TestMapMutation<VBMM7, VMM9, true>();
+
+			nErrorCount += TestSetMutation<VBS1, VS3, false>();
+			nErrorCount += TestSetMutation<VBS4, VS6, false>();
+			nErrorCount += TestSetMutation<VBMS1, VMS3, true>();
+			nErrorCount += TestSetMutation<VBMS4, VMS6, true>();
+		}
+	#endif // EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+
+
+	{   // Test searching functionality.
+		nErrorCount += TestMapSearch<VBM1, false>();
+		nErrorCount += TestMapSearch<VBM4, false>();
+		nErrorCount += TestMapSearch<VBM7, false>();
+		nErrorCount += TestMapSearch<eastl::btree_map<int, int, eastl::less<void>>, false>();
+
+		nErrorCount += TestMapSearch<VBMM1, true>();
+		nErrorCount += TestMapSearch<VBMM4, true>();
+		nErrorCount += TestMapSearch<VBMM7, true>();
+
+		nErrorCount += TestSetSearch<VBS1, false>();
+		nErrorCount += TestSetSearch<VBS4, false>();
+		nErrorCount += TestSetSearch<VBMS1, true>();
+		nErrorCount += TestSetSearch<VBMS4, true>();
+	}
+
+
+	{
+		// C++11 emplace and related functionality
+		nErrorCount += TestMapCpp11<eastl::btree_map<int, TestObject>>();
+		nErrorCount += TestMapCpp11<eastl::btree_map<int, TestObject, eastl::less<void>>>();
+		nErrorCount += TestMultimapCpp11<eastl::btree_multimap<int, TestObject>>();
+
+		nErrorCount += TestSetCpp11<eastl::btree_set<TestObject>>();
+		nErrorCount += TestMultisetCpp11<eastl::btree_multiset<TestObject>>();
+	}
+
+
+	{
+		// C++17 try_emplace and related functionality
+		nErrorCount += TestMapCpp17<eastl::btree_map<int, TestObject>>();
+		nErrorCount += TestMapCpp17<eastl::btree_map<int, TestObject, eastl::less<void>>>();
+	}
+
+
+	{   // operator[] and at()
+		nErrorCount += TestMapAccess<VBM1>();
+		nErrorCount += TestMapAccess<VBM4>();
+		nErrorCount += TestMapAccess<VBM7>();
+	}
+
+
+	#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+		{   // Random insertions and erasures against the std containers, with small and default nodes.
+			nErrorCount += TestBTreeRandomOperations<SmallNodeMap, VM3>(4000, 500,
+				[](SmallNodeMap& bt, VM3& sc, int k) { bt.insert(SmallNodeMap::value_type(k, k)); sc.insert(VM3::value_type(k, k)); });
+
+			nErrorCount += TestBTreeRandomOperations<VBM1, VM3>(20000, 5000,
+				[](VBM1& bt, VM3& sc, int k) { bt.insert(VBM1::value_type(k, k)); sc.insert(VM3::value_type(k, k)); });
+
+			nErrorCount += TestBTreeRandomOperations<SmallNodeMultiset, VMS3>(4000, 100,
+				[](SmallNodeMultiset& bt, VMS3& sc, int k) { bt.insert(k); sc.insert(k); });
+
+			// Hinted insertion with a mix of good and bad hints.
+			nErrorCount += TestBTreeRandomOperations<SmallNodeMap, VM3>(4000, 500,
+				[](SmallNodeMap& bt, VM3& sc, int k) { bt.insert(bt.lower_bound(k + (k % 3)), SmallNodeMap::value_type(k, k)); sc.insert(VM3::value_type(k, k)); });
+		}
+	#endif
+
+
+	{   // Sorted insertion, iteration in both directions, and erasure from the front and back.
+		SmallNodeMap bm;
+
+		for(int i = 0; i < 1000; i++)
+		{
+			SmallNodeMap::iterator it = bm.insert(bm.end(), SmallNodeMap::value_type(i, i * 2));
+			EATEST_VERIFY(it->first == i);
+		}
+		EATEST_VERIFY(bm.validate());
+		EATEST_VERIFY(bm.size() == 1000);
+
+		int i = 0;
+		for(SmallNodeMap::const_iterator it = bm.cbegin(); it != bm.cend(); ++it, ++i)
+			EATEST_VERIFY((it->first == i) && (it->second == i * 2));
+		EATEST_VERIFY(i == 1000);
+
+		for(SmallNodeMap::reverse_iterator it = bm.rbegin(); it != bm.rend(); ++it)
+			EATEST_VERIFY(it->first == --i);
+		EATEST_VERIFY(i == 0);
+
+		for(i = 0; i < 250; i++)
+		{
+			bm.erase(bm.begin());
+			bm.erase(--bm.end());
+		}
+		EATEST_VERIFY(bm.validate());
+		EATEST_VERIFY((bm.size() == 500) && (bm.begin()->first == 250) && (bm.rbegin()->first == 749));
+
+		// erase(first, last)
+		SmallNodeMap::iterator it = bm.erase(bm.find(300), bm.find(700));
+		EATEST_VERIFY(bm.validate());
+		EATEST_VERIFY((bm.size() == 100) && (it->first == 700));
+
+		bm.erase(bm.begin(), bm.end());
+		EATEST_VERIFY(bm.validate() && bm.empty() && (bm.begin() == bm.end()));
+	}
+
+
+	{   // erase_if, and the multi-key erase and count.
+		btree_map<int, int> bm;
+		btree_multimap<int, int> bmm;
+
+		for(int i = 0; i < 500; i++)
+		{
+			bm[i] = i;
+			bmm.emplace(i % 50, i);
+		}
+
+		EATEST_VERIFY(eastl::erase_if(bm, [](const btree_map<int, int>::value_type& v) { return (v.first % 3) == 0; }) == 167);
+		EATEST_VERIFY(bm.validate() && (bm.size() == 333));
+		EATEST_VERIFY(bm.find(3) == bm.end() && bm.find(4) != bm.end());
+
+		EATEST_VERIFY(bmm.count(7) == 10);
+		EATEST_VERIFY(bmm.erase(7) == 10);
+		EATEST_VERIFY(bmm.count(7) == 0);
+		EATEST_VERIFY(bmm.validate() && (bmm.size() == 490));
+
+		// Equivalent keys keep their insertion order.
+		eastl::pair<btree_multimap<int, int>::iterator, btree_multimap<int, int>::iterator> range = bmm.equal_range(8);
+		int nPrev = -1;
+		for(btree_multimap<int, int>::iterator it = range.first; it != range.second; ++it)
+		{
+			EATEST_VERIFY((it->first == 8) && (it->second > nPrev));
+			nPrev = it->second;
+		}
+	}
+
+
+	{   // Heterogeneous lookup and insertion.
+		btree_set<eastl::string, eastl::less<void>> bs = { "apple", "banana", "cherry" };
+
+		EATEST_VERIFY(bs.find("banana") != bs.end());
+		EATEST_VERIFY(bs.contains("cherry") && !bs.contains("durian"));
+		EATEST_VERIFY(bs.insert("durian").second);
+		EATEST_VERIFY(!bs.insert("apple").second);
+		EATEST_VERIFY(bs.erase("banana") == 1);
+		EATEST_VERIFY(bs.validate() && (bs.size() == 3));
+
+		btree_map<eastl::string, int> bm;
+		bm["one"] = 1;
+		EATEST_VERIFY(bm.find_as("one", eastl::less<>()) != bm.end());
+		EATEST_VERIFY(bm.find_as("two", eastl::less<>()) == bm.end());
+	}
+
+
+	{   // Allocator support: all nodes are returned to the allocator.
+		CountingAllocator::resetCount();
+		{
+			btree_map<int, TestObject, eastl::less<int>, CountingAllocator> bm;
+
+			for(int i = 0; i < 2000; i++)
+				bm.try_emplace(i, i);
+			EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() > 0);
+
+			// A B-tree packs many values per allocation.
+			EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() < (bm.size() / 4));
+
+			btree_map<int, TestObject, eastl::less<int>, CountingAllocator> bmCopy(bm);
+			EATEST_VERIFY(bmCopy.validate() && (bmCopy == bm));
+
+			for(int i = 0; i < 2000; i += 2)
+				bm.erase(i);
+			EATEST_VERIFY(bm.validate() && (bm.size() == 1000));
+		}
+		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+
+	{   // swap, move, and validate_iterator
+		VBM1 bm1 = { {1, 1}, {2, 2}, {3, 3} };
+		VBM1 bm2;
+
+		bm1.swap(bm2);
+		EATEST_VERIFY(bm1.empty() && (bm2.size() == 3) && bm1.validate() && bm2.validate());
+
+		VBM1 bm3(eastl::move(bm2));
+		EATEST_VERIFY(bm2.empty() && (bm3.size() == 3));
+
+		EATEST_VERIFY(bm3.validate_iterator(bm3.find(2)) == (isf_valid | isf_current | isf_can_dereference));
+		EATEST_VERIFY(bm3.validate_iterator(bm3.end()) == (isf_valid | isf_current));
+		EATEST_VERIFY(bm3.validate_iterator(bm1.end()) == isf_none);
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,265 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/concurrent_hash_map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <eathread/eathread_thread.h>
+
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::concurrent_hash_map<int, int>;
+template class eastl::concurrent_hash_map<eastl::string, int, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, 4>;
+template class eastl::concurrent_hash_map<int, TestObject, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, 1>;
+
+
+namespace
+{
+	typedef concurrent_hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, 8> IntMap;
+
+
+	// Allocates with malloc, counts the blocks it holds, and throws once gnFailingAllocatorCountdown
+	// allocations have been made.
+	#if EASTL_EXCEPTIONS_ENABLED
+		int gnFailingAllocatorCountdown = -1;
+	#endif
+	int gnFailingAllocatorBlockCount = 0;
+
+	struct FailingAllocator
+	{
+		FailingAllocator(const char* = NULL) {}
+		FailingAllocator(const FailingAllocator&, const char*) {}
+
+		void* allocate(size_t n, int = 0)
+		{
+			#if EASTL_EXCEPTIONS_ENABLED
+				if(gnFailingAllocatorCountdown-- == 0)
+					throw std::bad_alloc();
+			#endif
+			++gnFailingAllocatorBlockCount;
+			return malloc(n);
+		}
+
+		void* allocate(size_t n, size_t, size_t, int flags = 0)
+			{ return allocate(n, flags); }
+
+		void deallocate(void* p, size_t)
+		{
+			--gnFailingAllocatorBlockCount;
+			free(p);
+		}
+
+		const char* get_name() const { return "FailingAllocator"; }
+		void        set_name(const char*) {}
+	};
+
+	inline bool operator==(const FailingAllocator&, const FailingAllocator&) { return true; }
+	inline bool operator!=(const FailingAllocator&, const FailingAllocator&) { return false; }
+
+	struct ConcurrentHashMapThreadData
+	{
+		IntMap                    mMap;
+		EA::Thread::Semaphore     mStartSema{0};
+		eastl::atomic<int>        mThreadIndex{0};
+		eastl::atomic<int>        mInsertCount{0};
+		eastl::atomic<int>        mEraseCount{0};
+	};
+
+	const int kThreadCount      = 4;
+	const int kKeysPerThread    = 2000;
+	const int kSharedKeyCount   = 64;
+	const int kIncrementsPerKey = 50;
+
+	static intptr_t ConcurrentHashMapThreadFn(void* pData)
+	{
+		ConcurrentHashMapThreadData& data = *static_cast<ConcurrentHashMapThreadData*>(pData);
+		const int threadIndex = data.mThreadIndex++;
+
+		data.mStartSema.Wait();
+
+		// Keys that only this thread uses: insert them all, then erase every other one.
+		const int firstKey = kSharedKeyCount + (threadIndex * kKeysPerThread);
+
+		for(int i = 0; i < kKeysPerThread; i++)
+		{
+			if(data.mMap.try_emplace(firstKey + i, i))
+				++data.mInsertCount;
+		}
+
+		for(int i = 0; i < kKeysPerThread; i += 2)
+			data.mEraseCount += (int)data.mMap.erase(firstKey + i);
+
+		// Keys that all threads increment.
+		for(int j = 0; j < kIncrementsPerKey; j++)
+		{
+			for(int i = 0; i < kSharedKeyCount; i++)
+				data.mMap.try_emplace_or_update(i, [](IntMap::value_type& value) { ++value.second; }, 1);
+		}
+
+		return 0;
+	}
+}
+
+
+int TestConcurrentHashMap()
+{
+	int nErrorCount = 0;
+
+	{ // Test declarations
+		concurrent_hash_map<int, int> intMap;
+		EATEST_VERIFY(intMap.validate());
+		EATEST_VERIFY(intMap.empty() && (intMap.size() == 0));
+		EATEST_VERIFY(intMap.shard_count() == EASTL_CONCURRENT_HASH_MAP_DEFAULT_SHARD_COUNT);
+
+		concurrent_hash_map<int, int> intMap2(16);
+		EATEST_VERIFY(intMap2.validate());
+	}
+
+	{ // insert, try_emplace, insert_or_assign, find, contains, count, erase
+		concurrent_hash_map<eastl::string, int, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, EASTLAllocatorType, 4> stringMap;
+
+		EATEST_VERIFY(stringMap.insert(eastl::make_pair(eastl::string("one"), 1)));
+		EATEST_VERIFY(!stringMap.insert(eastl::make_pair(eastl::string("one"), 100)));
+		EATEST_VERIFY(stringMap.try_emplace("two", 2));
+		EATEST_VERIFY(!stringMap.try_emplace("two", 200));
+		EATEST_VERIFY(stringMap.insert_or_assign("three", 3));
+		EATEST_VERIFY(!stringMap.insert_or_assign("three", 33));
+		EATEST_VERIFY(stringMap.validate());
+		EATEST_VERIFY(stringMap.size() == 3);
+
+		int value = 0;
+		EATEST_VERIFY(stringMap.find("one", value) && (value == 1));
+		EATEST_VERIFY(stringMap.find("two", value) && (value == 2));
+		EATEST_VERIFY(stringMap.find("three", value) && (value == 33));
+		EATEST_VERIFY(!stringMap.find("four", value) && (value == 33));
+		EATEST_VERIFY(stringMap.contains("one") && !stringMap.contains("four"));
+		EATEST_VERIFY((stringMap.count("two") == 1) && (stringMap.count("four") == 0));
+
+		EATEST_VERIFY(stringMap.erase("two") == 1);
+		EATEST_VERIFY(stringMap.erase("two") == 0);
+		EATEST_VERIFY(!stringMap.contains("two"));
+		EATEST_VERIFY(stringMap.size() == 2);
+
+		stringMap.clear();
+		EATEST_VERIFY(stringMap.empty());
+		EATEST_VERIFY(stringMap.validate());
+	}
+
+	{ // visit, update, try_emplace_or_update, erase_if
+		IntMap intMap;
+		intMap.reserve(1000);
+
+		for(int i = 0; i < 1000; i++)
+			EATEST_VERIFY(intMap.try_emplace(i, i));
+		EATEST_VERIFY(intMap.validate());
+		EATEST_VERIFY(intMap.size() == 1000);
+
+		int visited = -1;
+		EATEST_VERIFY(intMap.visit(10, [&](const IntMap::value_type& value) { visited = value.second; }));
+		EATEST_VERIFY(visited == 10);
+		EATEST_VERIFY(!intMap.visit(1000, [&](const IntMap::value_type& value) { visited = value.second; }));
+
+		EATEST_VERIFY(intMap.update(10, [](IntMap::value_type& value) { value.second *= 3; }));
+		EATEST_VERIFY(intMap.visit(10, [&](const IntMap::value_type& value) { visited = value.second; }));
+		EATEST_VERIFY(visited == 30);
+		EATEST_VERIFY(!intMap.update(1000, [](IntMap::value_type& value) { value.second *= 3; }));
+
+		EATEST_VERIFY(!intMap.try_emplace_or_update(20, [](IntMap::value_type& value) { value.second = -1; }, 0));
+		EATEST_VERIFY(intMap.try_emplace_or_update(2000, [](IntMap::value_type& value) { value.second = -1; }, 7));
+		int value = 0;
+		EATEST_VERIFY(intMap.find(20, value) && (value == -1));
+		EATEST_VERIFY(intMap.find(2000, value) && (value == 7));
+
+		EATEST_VERIFY(intMap.erase_if(30, [](const IntMap::value_type& value) { return value.second != 30; }) == 0);
+		EATEST_VERIFY(intMap.erase_if(30, [](const IntMap::value_type& value) { return value.second == 30; }) == 1);
+		EATEST_VERIFY(intMap.erase_if(30, [](const IntMap::value_type&) { return true; }) == 0);
+		EATEST_VERIFY(intMap.size() == 1000);
+	}
+
+	{ // visit_all, update_all, erase_all_if
+		IntMap intMap;
+
+		for(int i = 0; i < 100; i++)
+			intMap.try_emplace(i, i);
+
+		intMap.update_all([](IntMap::value_type& value) { value.second += 1; });
+
+		int sum = 0, count = 0;
+		intMap.visit_all([&](const IntMap::value_type& value) { sum += value.second; ++count; });
+		EATEST_VERIFY((count == 100) && (sum == 5050));
+
+		EATEST_VERIFY(intMap.erase_all_if([](const IntMap::value_type& value) { return (value.first % 2) == 0; }) == 50);
+		EATEST_VERIFY(intMap.size() == 50);
+		EATEST_VERIFY(!intMap.contains(0) && intMap.contains(1));
+		EATEST_VERIFY(intMap.validate());
+	}
+
+	{ // Elements are destroyed.
+		TestObject::Reset();
+		{
+			concurrent_hash_map<int, TestObject, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, 1> objectMap;
+
+			for(int i = 0; i < 10; i++)
+				objectMap.try_emplace(i, TestObject(i));
+			objectMap.erase(3);
+			EATEST_VERIFY(objectMap.size() == 9);
+		}
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+	#if EASTL_EXCEPTIONS_ENABLED
+		{ // The shards already constructed are destroyed if constructing a later one throws.
+			typedef concurrent_hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, FailingAllocator, 4> FailingMap;
+
+			gnFailingAllocatorCountdown = 2; // The third shard fails to allocate its buckets.
+			bool bThrew = false;
+
+			try
+			{
+				FailingMap failingMap(16);
+			}
+			catch(std::bad_alloc&)
+			{
+				bThrew = true;
+			}
+
+			EATEST_VERIFY(bThrew && (gnFailingAllocatorBlockCount == 0));
+			gnFailingAllocatorCountdown = -1;
+		}
+	#endif
+
+	{ // Concurrent access
+		ConcurrentHashMapThreadData data;
+		EA::Thread::Thread threads[kThreadCount];
+
+		for(int i = 0; i < kThreadCount; i++)
+			threads[i].Begin(ConcurrentHashMapThreadFn, static_cast<void*>(&data));
+
+		data.mStartSema.Post(kThreadCount);
+
+		for(int i = 0; i < kThreadCount; i++)
+			threads[i].WaitForEnd();
+
+		EATEST_VERIFY(data.mMap.validate());
+		EATEST_VERIFY(data.mInsertCount == (kThreadCount * kKeysPerThread));
+		EATEST_VERIFY(data.mEraseCount == (kThreadCount * kKeysPerThread / 2));
+		EATEST_VERIFY(data.mMap.size() == (IntMap::size_type)(kSharedKeyCount + (kThreadCount * kKeysPerThread / 2)));
+
+		// The first increment of each shared key inserts it with a count of 1.
+		for(int i = 0; i < kSharedKeyCount; i++)
+		{
+			int value = 0;
+			EATEST_VERIFY(data.mMap.find(i, value) && (value == (kThreadCount * kIncrementsPerKey)));
+		}
+	}
+
+	return nErrorCount;
+}
@@ -12,6 +12,8 @@
 #include <EASTL/string.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/allocator_malloc.h>
+#include <EASTL/arena_allocator.h>
 #include "ConceptImpls.h"
 
 
@@ -1040,6 +1042,31 @@ int TestDeque()
 	}
 #endif
 
+	{
+		// Growth of the subarray pointer array, which is done in place or with reallocate
+		// by allocators which support them.
+		eastl::arena scratch(1024 * 1024);
+		eastl::deque<int, eastl::arena_allocator> arenaDeque((eastl::arena_allocator(&scratch)));
+		eastl::deque<int, eastl::allocator_malloc> mallocDeque;
+
+		for(int i = 0; i < 100000; i++)
+		{
+			arenaDeque.push_back(i);
+			mallocDeque.push_back(i);
+
+			if((i % 4) == 0)
+			{
+				arenaDeque.push_front(-i);
+				mallocDeque.push_front(-i);
+			}
+		}
+
+		EATEST_VERIFY(arenaDeque.validate() && mallocDeque.validate());
+		EATEST_VERIFY((arenaDeque.size() == 125000) && (mallocDeque.size() == 125000));
+		EATEST_VERIFY(eastl::equal(arenaDeque.begin(), arenaDeque.end(), mallocDeque.begin()));
+		EATEST_VERIFY((arenaDeque.front() == -99996) && (arenaDeque[25000] == 0) && (arenaDeque.back() == 99999));
+	}
+
 	return nErrorCount;
 }
 
@@ -113,10 +113,10 @@ template class eastl::fixed_hash_map<int, int, 1, 2>;
 template class eastl::fixed_hash_multiset<int, 1, 2>;
 template class eastl::fixed_hash_multimap<int, int, 1, 2>;
 
-template class eastl::fixed_hash_set<A, 1, 2>;
-template class eastl::fixed_hash_map<A, A, 1, 2>;
-template class eastl::fixed_hash_multiset<A, 1, 2>;
-template class eastl::fixed_hash_multimap<A, A, 1, 2>;
+template class eastl::fixed_hash_set<A, 1, 2, true, eastl::hash<A>, eastl::equal_to<A>, false>; // The default for A, a class type, is to cache hash codes.
+template class eastl::fixed_hash_map<A, A, 1, 2, true, eastl::hash<A>, eastl::equal_to<A>, false>;
+template class eastl::fixed_hash_multiset<A, 1, 2, true, eastl::hash<A>, eastl::equal_to<A>, false>;
+template class eastl::fixed_hash_multimap<A, A, 1, 2, true, eastl::hash<A>, eastl::equal_to<A>, false>;
 
 template class eastl::fixed_hash_set<int, 1, 2, true, eastl::hash<int>, eastl::equal_to<int>, true>;
 template class eastl::fixed_hash_map<int, int, 1, 2, true, eastl::hash<int>, eastl::equal_to<int>, true>;
@@ -787,6 +787,34 @@ int TestFixedHash()
 		nErrorCount += TestAssociativeContainerHeterogeneousErasure(s);
 	}
 
+	{ // find_batch / contains_batch / insert_batch
+		typedef eastl::fixed_hash_map<int, int, 64> FixedHashMap;
+
+		eastl::vector<FixedHashMap::value_type> values;
+		int keys[40];
+		for(int i = 0; i < 40; i++)
+		{
+			values.push_back(FixedHashMap::value_type(i * 3, i));
+			keys[i] = i;
+		}
+
+		FixedHashMap fixedHashMap;
+		VERIFY(fixedHashMap.insert_batch(values.data(), values.size()) == 40);
+		VERIFY(fixedHashMap.validate());
+
+		FixedHashMap::iterator results[40];
+		fixedHashMap.find_batch(keys, 40, results);
+		for(int i = 0; i < 40; i++)
+			VERIFY(results[i] == fixedHashMap.find(i));
+
+		eastl::fixed_hash_set<int, 64> fixedHashSet;
+		VERIFY(fixedHashSet.insert_batch(keys, 40) == 40);
+
+		bool containsResults[40];
+		VERIFY(fixedHashSet.contains_batch(keys, 20, containsResults) == 20);
+		VERIFY(eastl::find(containsResults, containsResults + 20, false) == containsResults + 20);
+	}
+
 #if EASTL_NAME_ENABLED
 	// allocators
 	{
@@ -102,6 +102,15 @@ int TestFixedMap()
 		nErrorCount += TestMapCpp11NonCopyable<eastl::fixed_map<int, NonCopyable, 32, true, eastl::less<void>>>();
 	}
 
+
+	{   // Test merge, intersect and subtract. These copy elements between fixed containers, as their nodes can't be shared.
+		nErrorCount += TestMapAlgebra<VM1, false>();
+		nErrorCount += TestMapAlgebra<VM4, false>();
+
+		nErrorCount += TestMapAlgebra<VMM1, true>();
+		nErrorCount += TestMapAlgebra<VMM4, true>();
+	}
+
 	{
 		// C++17 try_emplace and related functionality
 		nErrorCount += TestMapCpp17<eastl::fixed_map<int, TestObject, 32>>();
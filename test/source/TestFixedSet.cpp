@@ -101,6 +101,15 @@ int TestFixedSet()
 	}
 
 
+	{   // Test merge, intersect and subtract. These copy elements between fixed containers, as their nodes can't be shared.
+		nErrorCount += TestSetAlgebra<VS1, false>();
+		nErrorCount += TestSetAlgebra<VS4, false>();
+
+		nErrorCount += TestSetAlgebra<VMS1, true>();
+		nErrorCount += TestSetAlgebra<VMS4, true>();
+	}
+
+
 	{ // Test functionality specific to fixed size containers.
 
 		VS1  vs1;
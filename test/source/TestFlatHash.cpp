@@ -0,0 +1,451 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include "TestMap.h"
+#include "TestSet.h"
+#include "TestAssociativeContainers.h"
+#include <EASTL/flat_hash_set.h>
+#include <EASTL/flat_hash_map.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+
+
+using namespace eastl;
+
+
+namespace
+{
+	struct Align32Hash
+	{
+		size_t operator()(const Align32& a32) const
+			{ return static_cast<size_t>(a32.mX); }
+	};
+
+	// Every key hashes to one of three values, which makes every probe sequence long
+	// and exercises H2 collisions, group wrap-around and tombstone handling.
+	struct FlatCollidingHash
+	{
+		size_t operator()(const int& val) const
+			{ return static_cast<size_t>(val % 3); }
+	};
+}
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::flat_hashtable<int, int, EASTLAllocatorType, eastl::use_self<int>, eastl::equal_to<int>, eastl::hash<int>, false>;
+template class eastl::flat_hash_set<int>;
+template class eastl::flat_hash_map<int, int>;
+template class eastl::flat_hash_set<Align32, Align32Hash>;
+template class eastl::flat_hash_map<Align32, Align32, Align32Hash>;
+template class eastl::flat_hash_map<eastl::string, int>;
+
+
+int TestFlatHash()
+{
+	int nErrorCount = 0;
+
+	{ // Test declarations
+		flat_hash_set<int>      hashSet;
+		flat_hash_map<int, int> hashMap;
+
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.bucket_count() == 0);
+		EATEST_VERIFY(hashSet.begin() == hashSet.end());
+		EATEST_VERIFY(hashSet.find(0) == hashSet.end());
+		EATEST_VERIFY(hashSet.erase(0) == 0);
+
+		flat_hash_set<int> hashSet2(hashSet);
+		EATEST_VERIFY(hashSet2.size() == hashSet.size());
+		EATEST_VERIFY(hashSet2 == hashSet);
+
+		flat_hash_map<int, int> hashMap2(hashMap);
+		EATEST_VERIFY(hashMap2.size() == hashMap.size());
+		EATEST_VERIFY(hashMap2 == hashMap);
+
+		// allocator_type& get_allocator();
+		// void            set_allocator(const allocator_type& allocator);
+		flat_hash_set<int>::allocator_type& allocator = hashSet.get_allocator();
+		hashSet.set_allocator(EASTLAllocatorType());
+		hashSet.set_allocator(allocator);
+
+		#if EASTL_NAME_ENABLED
+			hashMap.get_allocator().set_name("test");
+			const char* pName = hashMap.get_allocator().get_name();
+			EATEST_VERIFY(equal(pName, pName + 5, "test"));
+		#endif
+	}
+
+
+	{ // clear
+		flat_hash_set<int> hashSet;
+
+		hashSet.clear(true);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 0);
+		EATEST_VERIFY(hashSet.bucket_count() == 0);
+
+		for(int i = 0; i < 100; ++i)
+			hashSet.insert(i);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 100);
+
+		const flat_hash_set<int>::size_type nBucketCount = hashSet.bucket_count();
+		hashSet.clear();
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 0);
+		EATEST_VERIFY(hashSet.bucket_count() == nBucketCount);
+		EATEST_VERIFY(hashSet.begin() == hashSet.end());
+
+		for(int i = 0; i < 100; ++i)
+			hashSet.insert(i);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 100);
+
+		hashSet.clear(true);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 0);
+		EATEST_VERIFY(hashSet.bucket_count() == 0);
+	}
+
+
+	{ // Test flat_hash_set
+		typedef flat_hash_set<int> HashSetInt;
+
+		HashSetInt hashSet;
+		const int kCount = 10000;
+
+		EATEST_VERIFY(hashSet.empty());
+		EATEST_VERIFY(hashSet.count(0) == 0);
+
+		for(int i = 0; i < kCount; i++)
+		{
+			const HashSetInt::insert_return_type result = hashSet.insert(i);
+			EATEST_VERIFY(result.second && (*result.first == i));
+		}
+
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == (HashSetInt::size_type)kCount);
+		EATEST_VERIFY(hashSet.load_factor() <= hashSet.get_max_load_factor());
+		EATEST_VERIFY((hashSet.bucket_count() & (hashSet.bucket_count() + 1)) == 0); // A power of two minus one.
+		EATEST_VERIFY(!hashSet.insert(17).second);
+		EATEST_VERIFY(eastl::distance(hashSet.begin(), hashSet.end()) == kCount);
+
+		for(int i = 0; i < kCount; i++)
+		{
+			EATEST_VERIFY(hashSet.find(i) != hashSet.end());
+			EATEST_VERIFY(hashSet.count(i) == 1);
+			EATEST_VERIFY(hashSet.contains(i));
+		}
+		EATEST_VERIFY(hashSet.find(-1) == hashSet.end());
+		EATEST_VERIFY(hashSet.find(kCount) == hashSet.end());
+
+		// Every element is visited exactly once.
+		eastl::vector<int> visited(hashSet.begin(), hashSet.end());
+		eastl::sort(visited.begin(), visited.end());
+		for(int i = 0; i < kCount; i++)
+			EATEST_VERIFY(visited[(eastl_size_t)i] == i);
+
+		// size_type erase(const key_type& k);
+		for(int i = 0; i < kCount; i += 2)
+			EATEST_VERIFY(hashSet.erase(i) == 1);
+		EATEST_VERIFY(hashSet.erase(0) == 0);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == (HashSetInt::size_type)(kCount / 2));
+
+		for(int i = 0; i < kCount; i++)
+			EATEST_VERIFY(hashSet.contains(i) == ((i % 2) != 0));
+
+		// iterator erase(const_iterator position);
+		for(HashSetInt::iterator it = hashSet.begin(); it != hashSet.end(); )
+		{
+			if((*it % 4) == 1)
+				it = hashSet.erase(it);
+			else
+				++it;
+		}
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == (HashSetInt::size_type)(kCount / 4));
+
+		// Reinsertion reuses erased slots without growing.
+		const HashSetInt::size_type nBucketCount = hashSet.bucket_count();
+		for(int i = 0; i < kCount; i++)
+			hashSet.insert(i);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == (HashSetInt::size_type)kCount);
+		EATEST_VERIFY(hashSet.bucket_count() == nBucketCount);
+
+		// iterator erase(const_iterator first, const_iterator last);
+		hashSet.erase(hashSet.begin(), hashSet.end());
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.empty());
+	}
+
+
+	{ // Test flat_hash_map
+		typedef flat_hash_map<int, int> HashMapIntInt;
+
+		HashMapIntInt hashMap;
+		const int kCount = 10000;
+
+		for(int i = 0; i < kCount; i++)
+			hashMap[i] = i * 2;
+
+		EATEST_VERIFY(hashMap.validate());
+		EATEST_VERIFY(hashMap.size() == (HashMapIntInt::size_type)kCount);
+
+		for(int i = 0; i < kCount; i++)
+		{
+			HashMapIntInt::iterator it = hashMap.find(i);
+			EATEST_VERIFY((it != hashMap.end()) && (it->first == i) && (it->second == (i * 2)));
+			EATEST_VERIFY(hashMap.at(i) == (i * 2));
+		}
+
+		EATEST_VERIFY(!hashMap.insert(HashMapIntInt::value_type(3, 0)).second);
+		EATEST_VERIFY(hashMap[3] == 6);
+		EATEST_VERIFY(!hashMap.insert_or_assign(3, 7).second);
+		EATEST_VERIFY(hashMap[3] == 7);
+		EATEST_VERIFY(hashMap.insert_or_assign(-3, 7).second);
+		EATEST_VERIFY(hashMap.try_emplace(-4, 8).second);
+		EATEST_VERIFY(!hashMap.try_emplace(-4, 9).second);
+		EATEST_VERIFY(hashMap[-4] == 8);
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			EATEST_VERIFY_THROW(hashMap.at(kCount));
+		#endif
+
+		eastl::pair<HashMapIntInt::iterator, HashMapIntInt::iterator> range = hashMap.equal_range(5);
+		EATEST_VERIFY((range.first != hashMap.end()) && (eastl::distance(range.first, range.second) == 1));
+		range = hashMap.equal_range(kCount);
+		EATEST_VERIFY((range.first == hashMap.end()) && (range.second == hashMap.end()));
+
+		// erase_if
+		const HashMapIntInt::size_type nErased = erase_if(hashMap, [](const HashMapIntInt::value_type& v) { return v.first < 0; });
+		EATEST_VERIFY(nErased == 2);
+		EATEST_VERIFY(hashMap.validate());
+
+		HashMapIntInt hashMap2(hashMap);
+		EATEST_VERIFY(hashMap2 == hashMap);
+		hashMap2[0] = 1;
+		EATEST_VERIFY(hashMap2 != hashMap);
+
+		HashMapIntInt hashMap3(eastl::move(hashMap2));
+		EATEST_VERIFY(hashMap2.empty() && hashMap2.validate());
+		EATEST_VERIFY(hashMap3.size() == hashMap.size());
+
+		hashMap2 = hashMap3;
+		EATEST_VERIFY(hashMap2 == hashMap3);
+		hashMap2 = eastl::move(hashMap3);
+		EATEST_VERIFY(hashMap2.size() == hashMap.size());
+
+		hashMap2.swap(hashMap3);
+		EATEST_VERIFY(hashMap2.empty());
+		EATEST_VERIFY(hashMap3.size() == hashMap.size());
+	}
+
+
+	{ // Test initializer lists, range construction and reserve/rehash.
+		flat_hash_map<int, int> hashMap = { {1, 10}, {2, 20}, {3, 30} };
+		EATEST_VERIFY(hashMap.size() == 3);
+		EATEST_VERIFY(hashMap[2] == 20);
+
+		hashMap = { {4, 40}, {5, 50} };
+		EATEST_VERIFY(hashMap.size() == 2);
+		EATEST_VERIFY(hashMap.find(1) == hashMap.end());
+
+		const int values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 3, 4 };
+		flat_hash_set<int> hashSet(values, values + EAArrayCount(values));
+		EATEST_VERIFY(hashSet.size() == 10);
+		EATEST_VERIFY(hashSet.validate());
+
+		hashSet.reserve(1000);
+		EATEST_VERIFY(hashSet.bucket_count() >= 1000);
+		EATEST_VERIFY(hashSet.validate());
+
+		const flat_hash_set<int>::size_type nBucketCount = hashSet.bucket_count();
+		for(int i = 0; i < 1000; i++)
+			hashSet.insert(i);
+		EATEST_VERIFY(hashSet.bucket_count() == nBucketCount);
+
+		hashSet.rehash(5000);
+		EATEST_VERIFY(hashSet.bucket_count() >= 5000);
+		EATEST_VERIFY(hashSet.validate());
+
+		hashSet.rehash(0); // Shrinks to fit.
+		EATEST_VERIFY(hashSet.bucket_count() < 5000);
+		EATEST_VERIFY(hashSet.size() == 1000);
+		EATEST_VERIFY(hashSet.validate());
+
+		nErrorCount += HashContainerReserveTest<flat_hash_set<int>>()();
+		nErrorCount += HashContainerReserveTest<flat_hash_map<int, int>>()();
+	}
+
+
+	{ // Test a poor hash function.
+		flat_hash_set<int, FlatCollidingHash> hashSet;
+
+		for(int i = 0; i < 1000; i++)
+			hashSet.insert(i);
+		EATEST_VERIFY(hashSet.validate());
+
+		for(int i = 0; i < 1000; i++)
+			EATEST_VERIFY(hashSet.contains(i));
+
+		for(int i = 0; i < 1000; i += 3)
+			hashSet.erase(i);
+		EATEST_VERIFY(hashSet.validate());
+		EATEST_VERIFY(hashSet.size() == 666);
+
+		for(int i = 0; i < 1000; i++)
+			EATEST_VERIFY(hashSet.contains(i) == ((i % 3) != 0));
+	}
+
+
+	{ // Test randomized operations against hash_map.
+		EA::UnitTest::Rand rng(EA::UnitTest::GetRandSeed());
+
+		flat_hash_map<uint32_t, uint32_t> flatMap;
+		hash_map<uint32_t, uint32_t>      refMap;
+
+		for(int i = 0; i < 50000; i++)
+		{
+			const uint32_t key = rng.RandLimit(2000);
+
+			switch(rng.RandLimit(4))
+			{
+				case 0:
+				case 1:
+					flatMap[key] = (uint32_t)i;
+					refMap[key]  = (uint32_t)i;
+					break;
+
+				case 2:
+					EATEST_VERIFY(flatMap.erase(key) == refMap.erase(key));
+					break;
+
+				default:
+					EATEST_VERIFY(flatMap.count(key) == refMap.count(key));
+					break;
+			}
+
+			if((i % 5000) == 0)
+				EATEST_VERIFY(flatMap.validate());
+		}
+
+		EATEST_VERIFY(flatMap.validate());
+		EATEST_VERIFY(flatMap.size() == refMap.size());
+
+		for(hash_map<uint32_t, uint32_t>::iterator it = refMap.begin(); it != refMap.end(); ++it)
+		{
+			flat_hash_map<uint32_t, uint32_t>::iterator itFlat = flatMap.find(it->first);
+			EATEST_VERIFY((itFlat != flatMap.end()) && (itFlat->second == it->second));
+		}
+	}
+
+
+	{ // Test object lifetimes.
+		TestObject::Reset();
+		{
+			flat_hash_map<int, TestObject> toMap;
+
+			for(int i = 0; i < 1000; i++)
+				toMap.try_emplace(i, i);
+			for(int i = 0; i < 1000; i += 2)
+				toMap.erase(i);
+
+			flat_hash_map<int, TestObject> toMap2(toMap);
+			EATEST_VERIFY(toMap2.size() == 500);
+			toMap2.clear();
+			toMap.rehash(0);
+			EATEST_VERIFY(toMap.validate());
+		}
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+
+	{ // Test allocators
+		InstanceAllocator ia0((uint8_t)0);
+		InstanceAllocator ia1((uint8_t)1);
+
+		flat_hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, InstanceAllocator> hashMap0(ia0);
+		flat_hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, InstanceAllocator> hashMap1(ia1);
+
+		for(int i = 0; i < 100; i++)
+		{
+			hashMap0[i] = i;
+			hashMap1[i + 100] = i;
+		}
+
+		hashMap0 = eastl::move(hashMap1); // Different allocators; must move element-wise.
+		EATEST_VERIFY(hashMap0.size() == 100);
+		EATEST_VERIFY(hashMap0.find(150) != hashMap0.end());
+		EATEST_VERIFY(hashMap0.get_allocator().mInstanceId == 0);
+		EATEST_VERIFY(hashMap0.validate());
+
+		hashMap0.swap(hashMap1);
+		EATEST_VERIFY(hashMap0.empty());
+		EATEST_VERIFY(hashMap1.size() == 100);
+
+		EATEST_VERIFY(InstanceAllocator::reset_all());
+	}
+
+
+	{ // Test find_as
+		flat_hash_map<eastl::string, int> hashMap;
+		hashMap["hello"] = 1;
+		hashMap["world"] = 2;
+
+		flat_hash_map<eastl::string, int>::iterator it = hashMap.find_as("hello", eastl::hash<const char*>(), eastl::equal_to<>());
+		EATEST_VERIFY((it != hashMap.end()) && (it->second == 1));
+		it = hashMap.find_as("none", eastl::hash<const char*>(), eastl::equal_to<>());
+		EATEST_VERIFY(it == hashMap.end());
+	}
+
+
+	{ // Test over-aligned types
+		flat_hash_map<Align32, Align32, Align32Hash> hashMap;
+
+		for(int i = 0; i < 100; i++)
+			hashMap[Align32(i)] = Align32(i);
+
+		for(flat_hash_map<Align32, Align32, Align32Hash>::iterator it = hashMap.begin(); it != hashMap.end(); ++it)
+			EATEST_VERIFY(((uintptr_t)&*it % EASTL_ALIGN_OF(Align32)) == 0);
+	}
+
+
+	{
+		// C++11 emplace and related functionality
+		nErrorCount += TestMapCpp11<eastl::flat_hash_map<int, TestObject>>();
+		nErrorCount += TestSetCpp11<eastl::flat_hash_set<TestObject>>();
+
+		// TestMapCpp17 is not used, as it counts constructor calls and flat tables
+		// move their elements when they grow. try_emplace is covered above.
+
+		nErrorCount += TestMapAccess<eastl::flat_hash_map<int, int>>();
+	}
+
+
+	{ // heterogenous functions - flat_hash_map
+		eastl::flat_hash_map<ExplicitString, int, ExplicitStringHash, eastl::equal_to<void>> m{ { ExplicitString::Create("found"), 1 } };
+		nErrorCount += TestAssociativeContainerHeterogeneousLookup(m);
+		nErrorCount += TestMapHeterogeneousInsertion<decltype(m)>();
+		nErrorCount += TestAssociativeContainerHeterogeneousErasure(m);
+	}
+
+
+	{ // heterogenous functions - flat_hash_set
+		eastl::flat_hash_set<ExplicitString, ExplicitStringHash, eastl::equal_to<void>> s{ ExplicitString::Create("found") };
+		nErrorCount += TestAssociativeContainerHeterogeneousLookup(s);
+		nErrorCount += TestSetHeterogeneousInsertion<decltype(s)>();
+		nErrorCount += TestAssociativeContainerHeterogeneousErasure(s);
+	}
+
+	return nErrorCount;
+}
@@ -13,6 +13,8 @@
 #include <EASTL/unordered_map.h>
 #include <EASTL/map.h>
 #include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/fixed_string.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/sort.h>
 #include <EASTL/vector.h>
@@ -160,6 +162,32 @@ template class eastl::hashtable<int,
 								true,  // bMutableIterators
 								true   // bUniqueKeys
 								>;
+template class eastl::hashtable<int,
+								eastl::pair<const int, int>,
+								eastl::allocator,
+								eastl::use_first<eastl::pair<const int, int>>,
+								eastl::equal_to<int>,
+								eastl::hash<int>,
+								fibonacci_range_hashing,
+								default_ranged_hash,
+								power_of_two_rehash_policy,
+								false, // bCacheHashCode
+								true,  // bMutableIterators
+								true   // bUniqueKeys
+								>;
+template class eastl::hashtable<int,
+								eastl::pair<const int, int>,
+								eastl::allocator,
+								eastl::use_first<eastl::pair<const int, int>>,
+								eastl::equal_to<int>,
+								eastl::hash<int>,
+								mod_range_hashing,
+								default_ranged_hash,
+								incremental_rehash_policy<>,
+								false, // bCacheHashCode
+								true,  // bMutableIterators
+								true   // bUniqueKeys
+								>;
 // TODO(rparolin): known compiler error, we should fix this.
 // template class eastl::hashtable<int,
 //                                 eastl::pair<const int, int>,
@@ -186,6 +214,16 @@ template class eastl::hash_set<Align32>;
 template class eastl::hash_multiset<Align32>;
 template class eastl::hash_map<Align32, Align32>;
 template class eastl::hash_multimap<Align32, Align32>;
+template class eastl::hash_set<Align32, eastl::hash<Align32>, eastl::equal_to<Align32>, EASTLAllocatorType, false>;
+template class eastl::hash_map<Align32, Align32, eastl::hash<Align32>, eastl::equal_to<Align32>, EASTLAllocatorType, false>;
+template class eastl::hash_set<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy>;
+template class eastl::hash_multiset<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy>;
+template class eastl::hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, true, power_of_two_rehash_policy>;
+template class eastl::hash_multimap<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy>;
+template class eastl::hash_set<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>>;
+template class eastl::hash_multiset<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>>;
+template class eastl::hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, true, incremental_rehash_policy<>>;
+template class eastl::hash_multimap<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<power_of_two_rehash_policy>>;
 
 // validate static assumptions about hashtable core types
 typedef eastl::hash_node<int, false> HashNode1;
@@ -214,6 +252,34 @@ struct TransparentHash {
 	}
 };
 
+// Hashes eastl::string and eastl::string_view (and anything convertible to it) identically.
+struct TransparentStringViewHash {
+	using is_transparent = int;
+
+	size_t operator()(eastl::string_view sv) const
+	{
+		return eastl::hash<eastl::string_view>{}(sv);
+	}
+};
+
+// Counts its calls, to check how often a lookup compares keys.
+struct CountingStringEqualTo
+{
+	static int sCallCount;
+
+	bool operator()(const eastl::string& a, const eastl::string& b) const
+	{
+		++sCallCount;
+		return a == b;
+	}
+};
+int CountingStringEqualTo::sCallCount = 0;
+
+static_assert(hash_code_caching_default<eastl::string>::value, "hash_code_caching_default error");
+static_assert(!hash_code_caching_default<int>::value && !hash_code_caching_default<const char*>::value, "hash_code_caching_default error");
+static_assert(eastl::hash_map<eastl::string, int>::kCacheHashCode && !eastl::hash_map<int, int>::kCacheHashCode, "hash_code_caching_default error");
+static_assert(sizeof(eastl::hash_node<uint32_t, true>) == sizeof(eastl::hash_node<uint32_t, false>) || (sizeof(void*) < 8), "The cached hash code should go in the node's padding.");
+
 void TestHashTable_MT();
 
 int TestHash()
@@ -1621,6 +1687,593 @@ int TestHash()
 		s4.insert("a"); // shouldn't call the deprecated insert() overload
 	}
 
+	{ // string hashes
+		// All string representations of the same characters must hash equally, for all lengths
+		// (this covers every tail case of the word-at-a-time hash).
+		EA::UnitTest::Rand rng(EA::UnitTest::GetRandSeed());
+
+		eastl::string    str;
+		eastl::u16string str16;
+		eastl::u32string str32;
+
+		for(int nLength = 0; nLength < 300; nLength++)
+		{
+			const size_t h8  = eastl::hash<eastl::string>()(str);
+			const size_t h16 = eastl::hash<eastl::u16string>()(str16);
+			const size_t h32 = eastl::hash<eastl::u32string>()(str32);
+
+			EATEST_VERIFY(h8 == eastl::hash<const char*>()(str.c_str()));
+			EATEST_VERIFY(h8 == eastl::hash<char*>()(const_cast<char*>(str.c_str())));
+			EATEST_VERIFY(h8 == eastl::hash<eastl::string_view>()(eastl::string_view(str)));
+			typedef eastl::fixed_string<char, 64> FixedString64;
+			EATEST_VERIFY(h8 == eastl::hash<FixedString64>()(FixedString64(str.c_str())));
+			EATEST_VERIFY(h8 == eastl::string_hash<eastl::string>()(str));
+			EATEST_VERIFY(h16 == eastl::hash<const char16_t*>()(str16.c_str()));
+			EATEST_VERIFY(h16 == eastl::hash<eastl::u16string_view>()(eastl::u16string_view(str16)));
+			EATEST_VERIFY(h32 == eastl::hash<const char32_t*>()(str32.c_str()));
+			EATEST_VERIFY(h32 == eastl::hash<eastl::u32string_view>()(eastl::u32string_view(str32)));
+			EATEST_VERIFY((h8 == h16) && (h8 == h32)); // Code units less than 256 hash equally for all character types.
+
+			const char c = (char)rng.RandRange(1, 128);
+			str.push_back(c);
+			str16.push_back((char16_t)c);
+			str32.push_back((char32_t)c);
+		}
+
+		// Strings which differ in a single character, and prefixes of a string, hash differently.
+		eastl::hash_set<size_t> hashes;
+		eastl::string sKey(200, 'a');
+
+		for(eastl_size_t i = 0; i < sKey.size(); i++)
+		{
+			hashes.insert(eastl::hash<eastl::string_view>()(eastl::string_view(sKey.data(), i)));
+
+			sKey[i] = 'b';
+			hashes.insert(eastl::hash<eastl::string>()(sKey));
+			sKey[i] = 'a';
+		}
+		EATEST_VERIFY(hashes.size() == (sKey.size() * 2));
+
+		// Wide strings with code units of 256 and above hash differently from each other and
+		// from their low bytes, for all lengths.
+		const char16_t units16[] = { u'c', 0x4E2D, 0x4F2C, 0x0463, 0x0163, 0x6300 };
+		const char32_t units32[] = { U'c', 0x4E2D, 0x4F2C, 0x0463, 0x0163, 0x6300, 0x10063 };
+		eastl::hash_set<size_t> hashes16, hashes32;
+
+		for(int nLength = 1; nLength < 40; nLength++)
+		{
+			for(size_t u = 0; u < EAArrayCount(units16); u++)
+				hashes16.insert(eastl::hash<eastl::u16string>()(eastl::u16string((eastl_size_t)nLength, units16[u])));
+			for(size_t u = 0; u < EAArrayCount(units32); u++)
+				hashes32.insert(eastl::hash<eastl::u32string>()(eastl::u32string((eastl_size_t)nLength, units32[u])));
+
+			if(nLength > 1)
+			{
+				eastl::u16string s16((eastl_size_t)nLength, u'c');
+				s16[(eastl_size_t)nLength / 2] = 0x4E2D;
+				hashes16.insert(eastl::hash<eastl::u16string>()(s16));
+			}
+		}
+		EATEST_VERIFY(hashes16.size() == (39 * EAArrayCount(units16) + 38));
+		EATEST_VERIFY(hashes32.size() == (39 * EAArrayCount(units32)));
+	}
+
+	{ // power_of_two_rehash_policy
+		const fibonacci_range_hashing rangeHash;
+
+		for(uint32_t nBits = 0; nBits < 32; nBits++)
+		{
+			const uint32_t nBucketCount = UINT32_C(1) << nBits;
+
+			for(size_t r = 0; r < 1000; r += 7)
+				EATEST_VERIFY(rangeHash(r * 0x12345, nBucketCount) < nBucketCount);
+		}
+		EATEST_VERIFY(rangeHash(~size_t(0), 1) == 0);
+		EATEST_VERIFY(rangeHash(12345, 24) < 16); // Non-power of two counts use the lower power of two.
+
+		const power_of_two_rehash_policy policy;
+		EATEST_VERIFY(policy.GetNextBucketCount(0) == 2);
+		EATEST_VERIFY(policy.GetNextBucketCount(17) == 32);
+		EATEST_VERIFY(policy.GetNextBucketCount(32) == 32);
+		EATEST_VERIFY(policy.GetNextBucketCount(UINT32_MAX) == (UINT32_C(1) << 31));
+		EATEST_VERIFY(policy.GetBucketCount(100) == 128);
+		EATEST_VERIFY(power_of_two_rehash_policy::GetPrevBucketCountOnly(100) == 64);
+
+		typedef hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy> HashMapPow2;
+		typedef hash_multiset<int, colliding_hash, eastl::equal_to<int>, EASTLAllocatorType, true, power_of_two_rehash_policy> HashMultisetPow2;
+
+		HashMapPow2 hashMap(20);
+		EATEST_VERIFY(hashMap.bucket_count() == 32);
+
+		for(int i = 0; i < 10000; i++)
+			hashMap[i] = i;
+
+		EATEST_VERIFY(hashMap.validate());
+		EATEST_VERIFY(hashMap.size() == 10000);
+		EATEST_VERIFY(eastl::has_single_bit((uint32_t)hashMap.bucket_count()));
+		EATEST_VERIFY(hashMap.load_factor() <= hashMap.get_max_load_factor());
+
+		for(int i = 0; i < 10000; i++)
+			EATEST_VERIFY((hashMap.find(i) != hashMap.end()) && (hashMap[i] == i));
+		EATEST_VERIFY(hashMap.find(10000) == hashMap.end());
+		EATEST_VERIFY(hashMap.find_as(1234, eastl::hash<int>(), eastl::equal_to<int>()) != hashMap.end());
+
+		hashMap.set_max_load_factor(4.f);
+		EATEST_VERIFY(hashMap.get_max_load_factor() == 4.f);
+		hashMap.reserve(20000);
+		EATEST_VERIFY(eastl::has_single_bit((uint32_t)hashMap.bucket_count()));
+
+		hashMap.rehash(1000); // The user's bucket count is used as-is, even if it's not a power of two.
+		EATEST_VERIFY(hashMap.bucket_count() == 1000);
+		EATEST_VERIFY(hashMap.validate());
+		for(int i = 0; i < 10000; i++)
+			EATEST_VERIFY(hashMap.find(i) != hashMap.end());
+
+		HashMapPow2 hashMap2(hashMap);
+		EATEST_VERIFY(hashMap2 == hashMap);
+
+		HashMultisetPow2 hashMultiset;
+		for(int i = 0; i < 1000; i++)
+		{
+			hashMultiset.insert(i);
+			hashMultiset.insert(i);
+		}
+		EATEST_VERIFY(hashMultiset.validate());
+		EATEST_VERIFY(hashMultiset.count(500) == 2);
+		EATEST_VERIFY(erase_if(hashMultiset, [](int i) { return (i % 2) == 0; }) == 1000);
+		EATEST_VERIFY(hashMultiset.size() == 1000);
+
+		nErrorCount += TestMapCpp11<hash_map<int, TestObject, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy>>();
+		nErrorCount += TestSetCpp11<hash_set<TestObject, eastl::hash<TestObject>, eastl::equal_to<TestObject>, EASTLAllocatorType, false, power_of_two_rehash_policy>>();
+	}
+
+	{ // incremental_rehash_policy
+		typedef hash_map<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>> HashMapInc;
+		typedef hash_multimap<int, int, colliding_hash, eastl::equal_to<int>, EASTLAllocatorType, true, incremental_rehash_policy<power_of_two_rehash_policy>> HashMultimapInc;
+
+		HashMapInc hashMap;
+		bool       bRehashSeen = false;
+
+		EATEST_VERIFY(!hashMap.rehash_in_progress());
+		EATEST_VERIFY(!hashMap.rehash_step(100));
+
+		for(int i = 0; i < 20000; i++)
+		{
+			hashMap[i] = i;
+
+			if(hashMap.rehash_in_progress())
+			{
+				bRehashSeen = true;
+
+				// Elements are found whether or not they have been migrated yet.
+				EATEST_VERIFY((hashMap.find(i / 2) != hashMap.end()) && (hashMap.find(i / 2)->second == (i / 2)));
+				EATEST_VERIFY(hashMap.count(i / 3) == 1);
+				EATEST_VERIFY(hashMap.find_as(i / 5, eastl::hash<int>(), eastl::equal_to<int>()) != hashMap.end());
+				EATEST_VERIFY(hashMap.find_by_hash(i / 7, eastl::hash<int>()(i / 7)) != hashMap.end());
+				EATEST_VERIFY(hashMap.find(i + 1) == hashMap.end());
+				EATEST_VERIFY(!hashMap.insert(HashMapInc::value_type(i / 11, -1)).second);
+			}
+
+			if((i % 1000) == 0)
+				EATEST_VERIFY(hashMap.validate());
+		}
+
+		EATEST_VERIFY(bRehashSeen);
+		EATEST_VERIFY(hashMap.validate());
+		EATEST_VERIFY(hashMap.size() == 20000);
+		EATEST_VERIFY(hashMap.load_factor() <= hashMap.get_max_load_factor());
+		for(int i = 0; i < 20000; i++)
+			EATEST_VERIFY(hashMap[i] == i);
+
+		// With a step of zero, insertions leave the migration to rehash_step.
+		HashMapInc hashMap2;
+		hashMap2.rehash_policy(incremental_rehash_policy<>(1.f, 0));
+
+		int nCount = 0;
+		while(!hashMap2.rehash_in_progress() || (nCount < 200))
+		{
+			hashMap2[nCount] = nCount;
+			nCount++;
+		}
+
+		EATEST_VERIFY(hashMap2.validate());
+		EATEST_VERIFY(eastl::distance(hashMap2.begin(), hashMap2.end()) == nCount);
+
+		HashMapInc hashMap3(hashMap2); // Copies are made mid-migration too.
+		EATEST_VERIFY(hashMap3.rehash_in_progress());
+		EATEST_VERIFY(hashMap3 == hashMap2);
+
+		for(int i = 0; i < nCount; i += 2)
+			EATEST_VERIFY(hashMap2.erase(i) == 1);
+		EATEST_VERIFY(hashMap2.validate());
+		EATEST_VERIFY(hashMap2.size() == (HashMapInc::size_type)(nCount / 2));
+
+		for(int i = 0; i < nCount; i++)
+			EATEST_VERIFY((hashMap2.find(i) != hashMap2.end()) == ((i % 2) != 0));
+
+		while(hashMap2.rehash_step(1))
+			EATEST_VERIFY(hashMap2.validate());
+		EATEST_VERIFY(!hashMap2.rehash_in_progress());
+		for(int i = 0; i < nCount; i++)
+			EATEST_VERIFY((hashMap2.find(i) != hashMap2.end()) == ((i % 2) != 0));
+
+		hashMap3.swap(hashMap2);
+		EATEST_VERIFY(hashMap2.rehash_in_progress() && !hashMap3.rehash_in_progress());
+		EATEST_VERIFY(hashMap2.size() == (HashMapInc::size_type)nCount);
+
+		hashMap2.set_max_load_factor(2.f); // Finishes the migration.
+		EATEST_VERIFY(!hashMap2.rehash_in_progress());
+		EATEST_VERIFY(hashMap2.get_max_load_factor() == 2.f);
+		EATEST_VERIFY(hashMap2.validate());
+
+		hashMap3.clear();
+		EATEST_VERIFY(!hashMap3.rehash_in_progress());
+		EATEST_VERIFY(hashMap3.validate());
+
+		// Equal keys stay together when they are inserted mid-migration.
+		HashMultimapInc hashMultimap;
+		hashMultimap.rehash_policy(incremental_rehash_policy<power_of_two_rehash_policy>(1.f, 0));
+
+		for(int i = 0; !hashMultimap.rehash_in_progress() || (i < 300); i++)
+		{
+			hashMultimap.insert(HashMultimapInc::value_type(i, 0));
+			hashMultimap.insert(HashMultimapInc::value_type(i, 1));
+		}
+
+		for(int i = 0; i < 300; i++)
+			hashMultimap.insert(HashMultimapInc::value_type(i, 2));
+		EATEST_VERIFY(hashMultimap.validate());
+		EATEST_VERIFY(hashMultimap.rehash_in_progress());
+
+		for(int i = 0; i < 300; i++)
+		{
+			EATEST_VERIFY(hashMultimap.count(i) == 3);
+			EATEST_VERIFY(eastl::distance(hashMultimap.equal_range(i).first, hashMultimap.equal_range(i).second) == 3);
+		}
+
+		hashMultimap.rehash_step(hashMultimap.bucket_count());
+		EATEST_VERIFY(!hashMultimap.rehash_in_progress());
+		for(int i = 0; i < 300; i++)
+			EATEST_VERIFY(eastl::distance(hashMultimap.equal_range(i).first, hashMultimap.equal_range(i).second) == 3);
+		EATEST_VERIFY(hashMultimap.erase(7) == 3);
+		EATEST_VERIFY(hashMultimap.validate());
+
+		nErrorCount += TestMapCpp11<hash_map<int, TestObject, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>>>();
+		nErrorCount += TestSetCpp11<hash_set<TestObject, eastl::hash<TestObject>, eastl::equal_to<TestObject>, EASTLAllocatorType, false, incremental_rehash_policy<>>>();
+	}
+
+	{ // find_batch / contains_batch / insert_batch
+		typedef hash_map<int, int> HashMapIntInt;
+
+		// More values than one batch, and some that aren't a multiple of the batch size.
+		const int kValueCount = (EASTL_HASHTABLE_BATCH_SIZE * 5) + 3;
+		eastl::vector<HashMapIntInt::value_type> values;
+		eastl::vector<int> keys;
+
+		for(int i = 0; i < kValueCount; i++)
+		{
+			values.push_back(HashMapIntInt::value_type(i * 2, i));
+			keys.push_back(i);
+		}
+
+		HashMapIntInt hashMap;
+		EATEST_VERIFY(hashMap.insert_batch(values.data(), values.size()) == values.size());
+		EATEST_VERIFY(hashMap.insert_batch(values.data(), values.size()) == 0); // All already present.
+		EATEST_VERIFY(hashMap.size() == values.size());
+		EATEST_VERIFY(hashMap.validate());
+
+		eastl::vector<HashMapIntInt::iterator> results(keys.size());
+		hashMap.find_batch(keys.data(), keys.size(), results.data());
+		for(int i = 0; i < kValueCount; i++)
+			EATEST_VERIFY((results[i] == hashMap.find(i)) && (((i % 2) == 0) == (results[i] != hashMap.end())));
+
+		const HashMapIntInt& hashMapConst = hashMap;
+		eastl::vector<HashMapIntInt::const_iterator> constResults(keys.size());
+		hashMapConst.find_batch(keys.data(), keys.size(), constResults.data());
+		for(int i = 0; i < kValueCount; i++)
+			EATEST_VERIFY(constResults[i] == hashMapConst.find(i));
+
+		bool containsResults[kValueCount];
+		EATEST_VERIFY(hashMap.contains_batch(keys.data(), keys.size(), containsResults) == (HashMapIntInt::size_type)((kValueCount + 1) / 2));
+		for(int i = 0; i < kValueCount; i++)
+			EATEST_VERIFY(containsResults[i] == ((i % 2) == 0));
+
+		hashMap.find_batch(keys.data(), 0, results.data());
+
+		// Multimaps insert every value. Lookups find the first of the equal elements.
+		hash_multimap<int, int> hashMultimap;
+		EATEST_VERIFY(hashMultimap.insert_batch(values.data(), values.size()) == values.size());
+		EATEST_VERIFY(hashMultimap.insert_batch(values.data(), values.size()) == values.size());
+		EATEST_VERIFY(hashMultimap.validate());
+		EATEST_VERIFY(hashMultimap.count(4) == 2);
+
+		eastl::vector<hash_multimap<int, int>::iterator> multiResults(keys.size());
+		hashMultimap.find_batch(keys.data(), keys.size(), multiResults.data());
+		for(int i = 0; i < kValueCount; i++)
+			EATEST_VERIFY(multiResults[i] == hashMultimap.find(i));
+
+		// Lookups during an incremental rehash check the old buckets too.
+		typedef hash_set<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>> HashSetInc;
+		HashSetInc hashSet;
+		hashSet.rehash_policy(incremental_rehash_policy<>(1.f, 0));
+
+		int nCount = 0;
+		while(!hashSet.rehash_in_progress() || (nCount < 100))
+			hashSet.insert(nCount++);
+
+		eastl::vector<int> setKeys;
+		for(int i = 0; i < nCount + 10; i++)
+			setKeys.push_back(i);
+
+		eastl::vector<HashSetInc::iterator> setResults(setKeys.size());
+		hashSet.find_batch(setKeys.data(), setKeys.size(), setResults.data());
+		for(int i = 0; i < nCount + 10; i++)
+			EATEST_VERIFY((setResults[i] != hashSet.end()) == (i < nCount) && (setResults[i] == hashSet.find(i)));
+	}
+
+	{ // hashed_key
+		// One hash computation shared by a hash_map and a hash_set with the same hash function.
+		hash_map<int, int> hashMap;
+		hash_set<int>      hashSet;
+
+		for(int i = 0; i < 100; i++)
+		{
+			const hashed_key<int> hk = make_hashed_key(i, hashMap.hash_function());
+			EATEST_VERIFY(hashMap.insert(hk).second);
+			EATEST_VERIFY(hashSet.insert(hk).second);
+			EATEST_VERIFY(!hashSet.insert(hk).second);
+			EATEST_VERIFY(!hashMap.try_emplace(hk, i).second);
+		}
+		EATEST_VERIFY(hashMap.validate() && hashSet.validate());
+		EATEST_VERIFY((hashMap.size() == 100) && (hashSet.size() == 100));
+
+		const int key = 37;
+		const hashed_key<int> hk = make_hashed_key(key);
+		EATEST_VERIFY(hashMap.find(hk) == hashMap.find(key));
+		EATEST_VERIFY(hashSet.find(hk) == hashSet.find(key));
+		EATEST_VERIFY(hashMap.contains(hk) && hashSet.contains(hk));
+		EATEST_VERIFY((hashMap.count(hk) == 1) && (hashSet.count(hk) == 1));
+		EATEST_VERIFY(hashMap.equal_range(hk).first == hashMap.find(key));
+		EATEST_VERIFY((hashMap.erase(hk) == 1) && (hashSet.erase(hk) == 1));
+		EATEST_VERIFY(!hashMap.contains(hk) && !hashSet.contains(hk));
+
+		hash_map<int, int>::insert_return_type result = hashMap.try_emplace(hk, 5);
+		EATEST_VERIFY(result.second && (result.first->first == key) && (result.first->second == 5));
+
+		const hash_map<int, int>& constMap = hashMap;
+		EATEST_VERIFY(constMap.find(hk) != constMap.end());
+		EATEST_VERIFY(constMap.equal_range(hk).first != constMap.end());
+	}
+
+	{ // hashed_key with multi-containers and cached hash codes.
+		hash_multimap<int, int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, true> hashMultiMap;
+		hash_multiset<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, true>       hashMultiSet;
+
+		const int key = 12;
+		const hashed_key<int> hk = make_hashed_key(key);
+		for(int i = 0; i < 3; i++)
+		{
+			hashMultiMap.insert(hk);
+			hashMultiSet.insert(hk);
+		}
+		EATEST_VERIFY(hashMultiMap.validate() && hashMultiSet.validate());
+		EATEST_VERIFY((hashMultiMap.count(hk) == 3) && (hashMultiSet.count(hk) == 3));
+		EATEST_VERIFY(eastl::distance(hashMultiSet.equal_range(hk).first, hashMultiSet.equal_range(hk).second) == 3);
+		EATEST_VERIFY((hashMultiMap.erase(hk) == 3) && (hashMultiSet.erase(hk) == 3));
+		EATEST_VERIFY(hashMultiMap.empty() && hashMultiSet.empty());
+	}
+
+	{ // hashed_key with heterogeneous lookup
+		typedef hash_map<eastl::string, int, TransparentStringViewHash, eastl::equal_to<void>> StringMap;
+		typedef hash_set<eastl::string, TransparentStringViewHash, eastl::equal_to<void>>      StringSet;
+
+		StringMap stringMap;
+		StringSet stringSet;
+
+		const eastl::string_view sv("hashed");
+		const hashed_key<eastl::string_view> hk = make_hashed_key(sv, stringMap.hash_function());
+
+		EATEST_VERIFY(!stringMap.contains(hk));
+		EATEST_VERIFY(stringMap.try_emplace(hk, 1).second);
+		EATEST_VERIFY(stringSet.insert(hk).second);
+		EATEST_VERIFY(!stringSet.insert(hk).second);
+		EATEST_VERIFY(stringMap.validate() && stringSet.validate());
+
+		EATEST_VERIFY(stringMap.find(hk) == stringMap.find(eastl::string("hashed")));
+		EATEST_VERIFY(stringSet.find(hk) == stringSet.find(eastl::string("hashed")));
+		EATEST_VERIFY(stringMap.count(hk) == 1);
+		EATEST_VERIFY(stringMap.equal_range(hk).first->second == 1);
+		EATEST_VERIFY((stringMap.erase(hk) == 1) && (stringSet.erase(hk) == 1));
+		EATEST_VERIFY(stringMap.empty() && stringSet.empty());
+	}
+
+	{ // shrink_to_fit
+		hash_map<int, int> hashMap;
+		hashMap.shrink_to_fit(); // Shouldn't allocate the empty container's bucket array.
+		EATEST_VERIFY(hashMap.bucket_count() == 1);
+
+		for(int i = 0; i < 10000; i++)
+			hashMap.insert(eastl::make_pair(i, i));
+
+		const eastl_size_t nPeakBucketCount = hashMap.bucket_count();
+		hashMap.shrink_to_fit(); // Growth overshoots, so this may shrink a little.
+		EATEST_VERIFY(hashMap.bucket_count() <= nPeakBucketCount);
+		EATEST_VERIFY(hashMap.load_factor() <= hashMap.get_max_load_factor());
+
+		const eastl_size_t nBucketCount = hashMap.bucket_count();
+		hashMap.shrink_to_fit();
+		EATEST_VERIFY(hashMap.bucket_count() == nBucketCount);
+
+		for(int i = 100; i < 10000; i++)
+			hashMap.erase(i);
+		EATEST_VERIFY(hashMap.bucket_count() == nBucketCount); // The min load factor is 0 by default, so erasing never shrinks.
+
+		hashMap.shrink_to_fit();
+		EATEST_VERIFY(hashMap.bucket_count() == hashMap.rehash_policy().GetBucketCount(100));
+		EATEST_VERIFY(hashMap.validate() && (hashMap.size() == 100));
+		for(int i = 0; i < 100; i++)
+			EATEST_VERIFY(hashMap.find(i) != hashMap.end());
+
+		// The max load factor is still respected after shrinking.
+		for(int i = 100; i < 1000; i++)
+			hashMap.insert(eastl::make_pair(i, i));
+		EATEST_VERIFY(hashMap.load_factor() <= hashMap.get_max_load_factor());
+		EATEST_VERIFY(hashMap.validate());
+	}
+
+	{ // min load factor
+		typedef hash_set<int> IntSet;
+		typedef hash_set<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, power_of_two_rehash_policy> IntSetPow2;
+		typedef hash_set<int, eastl::hash<int>, eastl::equal_to<int>, EASTLAllocatorType, false, incremental_rehash_policy<>> IntSetInc;
+
+		IntSet hashSet;
+		EATEST_VERIFY(hashSet.get_min_load_factor() == 0.f);
+		hashSet.set_min_load_factor(0.25f);
+		EATEST_VERIFY(hashSet.get_min_load_factor() == 0.25f);
+		hashSet.set_max_load_factor(2.f);
+		EATEST_VERIFY((hashSet.get_min_load_factor() == 0.25f) && (hashSet.get_max_load_factor() == 2.f)); // Setting one doesn't reset the other.
+		hashSet.set_max_load_factor(1.f);
+
+		for(int i = 0; i < 10000; i++)
+			hashSet.insert(i);
+		const eastl_size_t nPeakBucketCount = hashSet.bucket_count();
+
+		// Erasing through iterators never shrinks, so erase loops stay valid.
+		int nErased = 0;
+		for(IntSet::iterator it = hashSet.begin(); (it != hashSet.end()) && (nErased < 9000); nErased++)
+			it = hashSet.erase(it);
+		EATEST_VERIFY(hashSet.bucket_count() == nPeakBucketCount);
+		EATEST_VERIFY(hashSet.validate());
+
+		// Erasing by key does, once the load factor falls below the min load factor.
+		eastl::vector<int> remaining(hashSet.begin(), hashSet.end());
+		for(eastl_size_t i = 0; i < remaining.size() - 10; i++)
+			hashSet.erase(remaining[i]);
+		EATEST_VERIFY(hashSet.size() == 10);
+		EATEST_VERIFY(hashSet.bucket_count() < nPeakBucketCount);
+		EATEST_VERIFY(hashSet.load_factor() >= hashSet.get_min_load_factor());
+		EATEST_VERIFY(hashSet.validate());
+		for(eastl_size_t i = remaining.size() - 10; i < remaining.size(); i++)
+			EATEST_VERIFY(hashSet.find(remaining[i]) != hashSet.end());
+
+		// Hysteresis: repeatedly inserting and erasing an element at the current size doesn't rehash.
+		const eastl_size_t nBucketCount = hashSet.bucket_count();
+		for(int i = 0; i < 100; i++)
+		{
+			hashSet.insert(-1);
+			hashSet.erase(-1);
+		}
+		EATEST_VERIFY(hashSet.bucket_count() == nBucketCount);
+
+		// Other rehash policies.
+		IntSetPow2 hashSetPow2;
+		hashSetPow2.set_min_load_factor(0.25f);
+		IntSetInc hashSetInc;
+		hashSetInc.set_min_load_factor(0.25f);
+
+		for(int i = 0; i < 10000; i++)
+		{
+			hashSetPow2.insert(i);
+			hashSetInc.insert(i);
+		}
+		EATEST_VERIFY(hashSetInc.rehash_in_progress() || (hashSetInc.bucket_count() > 1000));
+		for(int i = 0; i < 9990; i++)
+		{
+			hashSetPow2.erase(i);
+			hashSetInc.erase(i);
+		}
+		EATEST_VERIFY((hashSetPow2.bucket_count() < 64) && hashSetPow2.validate());
+		EATEST_VERIFY((hashSetInc.bucket_count() < 64) && !hashSetInc.rehash_in_progress() && hashSetInc.validate());
+		for(int i = 9990; i < 10000; i++)
+			EATEST_VERIFY(hashSetPow2.contains(i) && hashSetInc.contains(i));
+	}
+
+	{ // get_stats
+		hash_set<int> hashSet;
+		hashtable_stats stats = hashSet.get_stats();
+		EATEST_VERIFY((stats.mnElementCount == 0) && (stats.mnBucketCount == 1) && (stats.mnEmptyBucketCount == 1));
+		EATEST_VERIFY((stats.mnMaxChainLength == 0) && (stats.mfCollisionRate == 0.f) && (stats.mnRehashCount == 0));
+
+		// eastl::hash<int> is the identity, so consecutive ints don't collide.
+		for(int i = 0; i < 1000; i++)
+			hashSet.insert(i);
+		stats = hashSet.get_stats();
+		EATEST_VERIFY((stats.mnElementCount == 1000) && (stats.mnBucketCount == hashSet.bucket_count()));
+		EATEST_VERIFY((stats.mnMaxChainLength == 1) && (stats.mfCollisionRate == 0.f));
+		EATEST_VERIFY((stats.mChainLengthHistogram[1] == 1000) && (stats.mChainLengthHistogram[0] == stats.mnEmptyBucketCount));
+		EATEST_VERIFY(stats.mnEmptyBucketCount == (hashSet.bucket_count() - 1000));
+		EATEST_VERIFY(stats.mfLoadFactor == hashSet.load_factor());
+
+		// colliding_hash puts every key in one of three buckets.
+		hash_set<int, colliding_hash> collidingSet;
+		for(int i = 0; i < 30; i++)
+			collidingSet.insert(i);
+		stats = collidingSet.get_stats();
+		EATEST_VERIFY((stats.mnElementCount == 30) && (stats.mnMaxChainLength == 10));
+		EATEST_VERIFY(stats.mnEmptyBucketCount == (collidingSet.bucket_count() - 3));
+		EATEST_VERIFY(stats.mChainLengthHistogram[hashtable_stats::kChainLengthHistogramSize - 1] == 3); // The last entry includes longer chains.
+		EATEST_VERIFY((stats.mfCollisionRate > 0.89f) && (stats.mfCollisionRate < 0.91f));
+		EATEST_VERIFY(stats.mfEmptyBucketRatio == ((float)stats.mnEmptyBucketCount / (float)stats.mnBucketCount));
+
+		// The rehash counters.
+		#if EASTL_HASHTABLE_STATS_ENABLED
+			stats = hashSet.get_stats();
+			EATEST_VERIFY((stats.mnRehashCount > 0) && (stats.mnRehashNodeCount > 0) && (stats.mnRehashNodeCount < 2000));
+
+			const size_t nRehashCount = stats.mnRehashCount;
+			hashSet.rehash(hashSet.bucket_count() * 2);
+			stats = hashSet.get_stats();
+			EATEST_VERIFY(stats.mnRehashCount == (nRehashCount + 1));
+
+			hash_set<int> hashSetCopy(hashSet);
+			EATEST_VERIFY(hashSetCopy.get_stats().mnRehashCount <= 1);
+		#else
+			EATEST_VERIFY((hashSet.get_stats().mnRehashCount == 0) && (hashSet.get_stats().mnRehashNodeCount == 0));
+		#endif
+	}
+
+	{ // Cached hash codes are compared before the key predicate is called.
+		typedef hash_set<eastl::string, eastl::hash<eastl::string>, CountingStringEqualTo, EASTLAllocatorType, true>  CachedSet;
+		typedef hash_set<eastl::string, eastl::hash<eastl::string>, CountingStringEqualTo, EASTLAllocatorType, false> UncachedSet;
+
+		CachedSet   cachedSet;
+		UncachedSet uncachedSet;
+		cachedSet.set_max_load_factor(8.f); // Make the chains long, so misses walk several nodes.
+		uncachedSet.set_max_load_factor(8.f);
+
+		for(int i = 0; i < 200; i++)
+		{
+			eastl::string s(eastl::string::CtorSprintf(), "key %d", i);
+			cachedSet.insert(s);
+			uncachedSet.insert(s);
+		}
+
+		CountingStringEqualTo::sCallCount = 0;
+		for(int i = 200; i < 400; i++)
+			EATEST_VERIFY(cachedSet.find(eastl::string(eastl::string::CtorSprintf(), "key %d", i)) == cachedSet.end());
+		const int nCachedMissCompares = CountingStringEqualTo::sCallCount;
+
+		CountingStringEqualTo::sCallCount = 0;
+		for(int i = 200; i < 400; i++)
+			EATEST_VERIFY(uncachedSet.find(eastl::string(eastl::string::CtorSprintf(), "key %d", i)) == uncachedSet.end());
+		const int nUncachedMissCompares = CountingStringEqualTo::sCallCount;
+
+		EATEST_VERIFY(nUncachedMissCompares > 200);
+		EATEST_VERIFY(nCachedMissCompares < 10); // Only full 32 bit hash collisions get to the predicate.
+
+		// Hits compare the key once.
+		CountingStringEqualTo::sCallCount = 0;
+		for(int i = 0; i < 200; i++)
+			EATEST_VERIFY(cachedSet.find(eastl::string(eastl::string::CtorSprintf(), "key %d", i)) != cachedSet.end());
+		EATEST_VERIFY(CountingStringEqualTo::sCallCount < 210);
+
+		// find_as skips nodes by hash code too.
+		CountingStringEqualTo::sCallCount = 0;
+		EATEST_VERIFY(cachedSet.find_as("key 5", eastl::hash<const char*>(), eastl::equal_to<>()) != cachedSet.end());
+		EATEST_VERIFY(cachedSet.find_as("key 500", eastl::hash<const char*>(), eastl::equal_to<>()) == cachedSet.end());
+		EATEST_VERIFY(cachedSet.validate() && uncachedSet.validate());
+	}
+
 	return nErrorCount;
 }
 
@@ -743,6 +743,26 @@ int TestIntrusiveHash()
 		VERIFY(hs.validate());
 	}
 
+	{
+		// hashtable_stats get_stats() const;
+		eastl::intrusive_hash_set<SetWidget, 37, SWHash> hs;
+		SetWidget nodes[4];
+
+		nodes[0].mX = 1;
+		nodes[1].mX = 2;
+		nodes[2].mX = 1 + 37; // In the same bucket as nodes[0].
+		nodes[3].mX = 1 + 74;
+
+		for(int i = 0; i < 4; i++)
+			hs.insert(nodes[i]);
+
+		const hashtable_stats stats = hs.get_stats();
+		VERIFY((stats.mnElementCount == 4) && (stats.mnBucketCount == 37) && (stats.mnEmptyBucketCount == 35));
+		VERIFY((stats.mnMaxChainLength == 3) && (stats.mChainLengthHistogram[1] == 1) && (stats.mChainLengthHistogram[3] == 1));
+		VERIFY(stats.mfCollisionRate == 0.5f);
+		VERIFY(stats.mnRehashCount == 0);
+	}
+
 	return nErrorCount;
 }
 
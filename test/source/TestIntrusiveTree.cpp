@@ -0,0 +1,472 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/internal/intrusive_rbtree.h>
+#include <EASTL/intrusive_set.h>
+#include <EASTL/intrusive_map.h>
+#include <EASTL/set.h>
+#include <EASTL/vector.h>
+#include <EASTL/iterator.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+
+
+
+using namespace eastl;
+
+
+struct SetWidget : public intrusive_rbtree_node
+{
+	SetWidget(int x = 0)
+		: mX(x) { }
+	int mX;
+};
+
+inline bool operator<(const SetWidget& a, const SetWidget& b)
+	{ return a.mX < b.mX; }
+
+struct SetWidgetComparable // Exists for the sole purpose of testing the transparent lookup functions.
+{
+	SetWidgetComparable(int x = 0)
+		: mX(x) { }
+	int mX;
+};
+
+struct SetWidgetLess
+{
+	typedef int is_transparent;
+
+	bool operator()(const SetWidget& a, const SetWidget& b) const                   { return a.mX < b.mX; }
+	bool operator()(const SetWidget& a, const SetWidgetComparable& b) const         { return a.mX < b.mX; }
+	bool operator()(const SetWidgetComparable& a, const SetWidget& b) const         { return a.mX < b.mX; }
+};
+
+
+struct MapWidget : public intrusive_rbtree_node_key<int>
+{
+	MapWidget(int x = 0)
+		: mX(x) { mKey = x; }
+	int mX;
+};
+
+
+// MultiWidget
+//
+// An object which is in two maps at once, one by name and one by id.
+//
+struct ByName : public intrusive_rbtree_node_key<int> {};
+struct ById   : public intrusive_rbtree_node_key<int> {};
+
+struct MultiWidget : public ByName, public ById
+{
+	MultiWidget(int name = 0, int id = 0)
+	{
+		static_cast<ByName&>(*this).mKey = name;
+		static_cast<ById&>(*this).mKey   = id;
+	}
+};
+
+
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::intrusive_rbtree<SetWidget, SetWidget, eastl::less<SetWidget>, intrusive_rbtree_node, eastl::use_self<SetWidget>, true, true>;
+template class eastl::intrusive_rbtree<int, MapWidget, eastl::less<int>, intrusive_rbtree_node_key<int>, eastl::use_intrusive_key<intrusive_rbtree_node_key<int>, int>, false, true>;
+
+template class eastl::intrusive_set<SetWidget>;
+template class eastl::intrusive_multiset<SetWidget>;
+template class eastl::intrusive_set<SetWidget, SetWidgetLess>;
+
+template class eastl::intrusive_map<int, MapWidget>;
+template class eastl::intrusive_multimap<int, MapWidget>;
+
+template class eastl::intrusive_map<int, MultiWidget, eastl::less<int>, ByName>;
+template class eastl::intrusive_map<int, MultiWidget, eastl::less<int>, ById>;
+
+
+
+
+// Verifies that the keys of t, in order, equal those of the reference container r.
+template <typename T, typename R, typename GetKey>
+static bool IntrusiveTreeMatches(const T& t, const R& r, GetKey getKey)
+{
+	if(t.size() != r.size())
+		return false;
+
+	typename R::const_iterator itR = r.begin();
+
+	for(typename T::const_iterator it = t.begin(); it != t.end(); ++it, ++itR)
+	{
+		if(getKey(*it) != *itR)
+			return false;
+	}
+
+	return true;
+}
+
+
+// Applies a random mix of insertions, erasures and removals to the intrusive container T and
+// to the reference container R, and verifies that they stay equal and that the tree stays valid.
+template <typename T, typename R, typename Widget, typename GetKey>
+static int TestIntrusiveTreeRandomOperations(int nOperationCount, int nKeyRange, GetKey getKey)
+{
+	int nErrorCount = 0;
+
+	EASTLTest_Rand         rng(EA::UnitTest::GetRandSeed());
+	eastl::vector<Widget*> widgets;
+	eastl::vector<bool>    inTree;
+	T                      t;
+	R                      r;
+
+	for(int i = 0; i < nKeyRange * 2; i++)
+	{
+		widgets.push_back(new Widget(i % nKeyRange));
+		inTree.push_back(false);
+	}
+
+	for(int i = 0; i < nOperationCount; i++)
+	{
+		const eastl_size_t w = (eastl_size_t)rng.RandLimit((uint32_t)widgets.size());
+		Widget&            widget = *widgets[w];
+
+		if(!inTree[w])
+		{
+			const typename T::size_type nSize = t.size();
+			t.insert(widget);
+
+			if(t.size() != nSize) // If it was inserted...
+			{
+				r.insert(getKey(widget));
+				inTree[w] = true;
+			}
+		}
+		else if(rng.RandLimit(2))
+		{
+			t.remove(widget);
+			r.erase(r.find(getKey(widget)));
+			inTree[w] = false;
+		}
+		else
+		{
+			const int k = getKey(widget);
+			EATEST_VERIFY(t.erase(k) == r.erase(k));
+
+			for(eastl_size_t j = 0; j < widgets.size(); j++)
+			{
+				if(getKey(*widgets[j]) == k)
+					inTree[j] = false;
+			}
+		}
+
+		EATEST_VERIFY(t.validate());
+
+		if((i % 64) == 0)
+			EATEST_VERIFY(IntrusiveTreeMatches(t, r, getKey));
+	}
+
+	EATEST_VERIFY(IntrusiveTreeMatches(t, r, getKey));
+
+	for(int k = -1; k <= nKeyRange; k++)
+	{
+		EATEST_VERIFY(t.count(k) == r.count(k));
+		EATEST_VERIFY(eastl::distance(t.begin(), t.lower_bound(k)) == eastl::distance(r.begin(), r.lower_bound(k)));
+		EATEST_VERIFY(eastl::distance(t.begin(), t.upper_bound(k)) == eastl::distance(r.begin(), r.upper_bound(k)));
+	}
+
+	t.clear();
+	EATEST_VERIFY(t.empty() && t.validate());
+
+	for(eastl_size_t i = 0; i < widgets.size(); i++)
+		delete widgets[i];
+
+	return nErrorCount;
+}
+
+
+struct GetMapWidgetKey
+{
+	int operator()(const MapWidget& w) const { return w.mKey; }
+};
+
+
+
+int TestIntrusiveTree()
+{
+	int nErrorCount = 0;
+
+	{
+		// Test intrusive_set
+
+		typedef intrusive_set<SetWidget> IS_SW;
+
+		static_assert(sizeof(IS_SW) == (sizeof(rbtree_node_base) + sizeof(IS_SW::size_type)), "An empty compare should take no space.");
+
+		const int kArraySize = 100;
+		SetWidget swArray[kArraySize];
+
+		for(int i = 0; i < kArraySize; i++)
+			swArray[i].mX = (kArraySize - 1 - i); // Insert in reverse order.
+
+		IS_SW is;
+		VERIFY(is.empty() && (is.size() == 0));
+		VERIFY(is.begin() == is.end());
+		VERIFY(is.validate());
+
+		for(int i = 0; i < kArraySize; i++)
+		{
+			eastl::pair<IS_SW::iterator, bool> result = is.insert(swArray[i]);
+			VERIFY(result.second && (&*result.first == &swArray[i]));
+		}
+
+		VERIFY(is.size() == (IS_SW::size_type)kArraySize);
+		VERIFY(is.validate());
+
+		int nExpected = 0;
+		for(IS_SW::const_iterator it = is.begin(); it != is.end(); ++it)
+			VERIFY(it->mX == nExpected++);
+
+		nExpected = kArraySize;
+		for(IS_SW::const_reverse_iterator it = is.rbegin(); it != is.rend(); ++it)
+			VERIFY(it->mX == --nExpected);
+
+		// Inserting an object whose key is present fails and returns the present object.
+		SetWidget duplicate(37);
+		eastl::pair<IS_SW::iterator, bool> result = is.insert(duplicate);
+		VERIFY(!result.second && (&*result.first == &swArray[kArraySize - 1 - 37]));
+		VERIFY(is.size() == (IS_SW::size_type)kArraySize);
+
+		// find / contains / count
+		VERIFY(&*is.find(SetWidget(50)) == &swArray[kArraySize - 1 - 50]);
+		VERIFY(is.find(SetWidget(kArraySize)) == is.end());
+		VERIFY(is.contains(SetWidget(0)));
+		VERIFY(!is.contains(SetWidget(-1)));
+		VERIFY(is.count(SetWidget(10)) == 1);
+		VERIFY(is.count(SetWidget(-10)) == 0);
+
+		// locate / remove
+		IS_SW::iterator it = is.locate(swArray[0]);
+		VERIFY(it->mX == kArraySize - 1);
+		VERIFY(is.validate_iterator(it) == (isf_valid | isf_current | isf_can_dereference));
+
+		it = is.remove(swArray[0]);
+		VERIFY(it == is.end());
+		VERIFY(is.size() == (IS_SW::size_type)(kArraySize - 1));
+		VERIFY(!is.contains(SetWidget(kArraySize - 1)));
+		VERIFY(is.validate());
+
+		// erase(first, last)
+		it = is.erase(is.find(SetWidget(10)), is.find(SetWidget(20)));
+		VERIFY(it->mX == 20);
+		VERIFY(is.size() == (IS_SW::size_type)(kArraySize - 11));
+		VERIFY(is.validate());
+
+		// erase(key)
+		VERIFY(is.erase(SetWidget(30)) == 1);
+		VERIFY(is.erase(SetWidget(30)) == 0);
+		VERIFY(is.validate());
+
+		// swap
+		IS_SW is2;
+		is2.swap(is);
+		VERIFY(is.empty() && is.validate());
+		VERIFY((is2.size() == (IS_SW::size_type)(kArraySize - 12)) && is2.validate());
+		swap(is, is2);
+		VERIFY(is2.empty() && is2.validate());
+		VERIFY((is.size() == (IS_SW::size_type)(kArraySize - 12)) && is.validate());
+
+		// The copy constructor and assignment don't take objects from the source.
+		IS_SW is3(is);
+		VERIFY(is3.empty() && is3.validate());
+		is3 = is;
+		VERIFY(is3.empty() && (is.size() == (IS_SW::size_type)(kArraySize - 12)));
+
+		// clear
+		is.clear();
+		VERIFY(is.empty() && is.validate());
+
+		// The objects can be inserted again after a clear.
+		is.insert(swArray[5]);
+		is.insert(swArray[6]);
+		VERIFY((is.size() == 2) && is.validate());
+		is.clear();
+	}
+
+	{
+		// Test insert with hint
+
+		typedef intrusive_multiset<SetWidget> IMS_SW;
+
+		const int kArraySize = 64;
+		SetWidget swArray[kArraySize];
+		IMS_SW    ims;
+
+		// A correct hint: always inserting at the end.
+		for(int i = 0; i < kArraySize / 2; i++)
+		{
+			swArray[i].mX = i / 2; // Pairs of equal keys.
+			IMS_SW::iterator it = ims.insert(ims.end(), swArray[i]);
+			VERIFY(&*it == &swArray[i]);
+			VERIFY(ims.validate());
+		}
+
+		// Wrong hints fall back to a regular insertion.
+		for(int i = kArraySize / 2; i < kArraySize; i++)
+		{
+			swArray[i].mX = (i * 7) % (kArraySize / 4);
+			IMS_SW::iterator it = ims.insert(ims.begin(), swArray[i]);
+			VERIFY(&*it == &swArray[i]);
+			VERIFY(ims.validate());
+		}
+
+		VERIFY(ims.size() == (IMS_SW::size_type)kArraySize);
+		VERIFY(eastl::is_sorted(ims.begin(), ims.end()));
+
+		// locate tells apart objects with equal keys.
+		for(int i = 0; i < kArraySize; i++)
+		{
+			VERIFY(&*ims.locate(swArray[i]) == &swArray[i]);
+			VERIFY(ims.count(swArray[i]) >= 1);
+		}
+
+		eastl::pair<IMS_SW::iterator, IMS_SW::iterator> range = ims.equal_range(SetWidget(3));
+		VERIFY(eastl::distance(range.first, range.second) == (ptrdiff_t)ims.count(SetWidget(3)));
+		VERIFY(&*range.first == &swArray[6]);
+
+		VERIFY(ims.erase(SetWidget(3)) == 4);
+		VERIFY(ims.count(SetWidget(3)) == 0);
+		VERIFY(ims.validate());
+
+		// Removing one of several equal objects removes that object only.
+		const IMS_SW::size_type nCount = ims.count(SetWidget(0));
+		ims.remove(swArray[1]);
+		VERIFY(ims.count(SetWidget(0)) == nCount - 1);
+		for(range = ims.equal_range(SetWidget(0)); range.first != range.second; ++range.first)
+			VERIFY(&*range.first != &swArray[1]);
+		VERIFY(ims.validate());
+
+		ims.clear();
+	}
+
+	{
+		// Test transparent lookup
+
+		typedef intrusive_set<SetWidget, SetWidgetLess> IS_SWL;
+
+		SetWidget swArray[10];
+		IS_SWL    is;
+
+		for(int i = 0; i < 10; i++)
+		{
+			swArray[i].mX = i * 2;
+			is.insert(swArray[i]);
+		}
+
+		VERIFY(&*is.find(SetWidgetComparable(4)) == &swArray[2]);
+		VERIFY(is.find(SetWidgetComparable(5)) == is.end());
+		VERIFY(is.contains(SetWidgetComparable(18)));
+		VERIFY(is.count(SetWidgetComparable(3)) == 0);
+		VERIFY(is.lower_bound(SetWidgetComparable(5))->mX == 6);
+		VERIFY(is.upper_bound(SetWidgetComparable(6))->mX == 8);
+		VERIFY(eastl::distance(is.equal_range(SetWidgetComparable(8)).first, is.equal_range(SetWidgetComparable(8)).second) == 1);
+
+		is.clear();
+	}
+
+	{
+		// Test intrusive_map and intrusive_multimap
+
+		typedef intrusive_map<int, MapWidget> IM_MW;
+
+		MapWidget mwArray[20];
+		IM_MW     im;
+
+		for(int i = 0; i < 20; i++)
+		{
+			mwArray[i].mKey = (i * 13) % 20;
+			mwArray[i].mX   = i;
+			VERIFY(im.insert(mwArray[i]).second);
+		}
+
+		VERIFY((im.size() == 20) && im.validate());
+
+		for(int i = 0; i < 20; i++)
+		{
+			IM_MW::iterator it = im.find(mwArray[i].mKey);
+			VERIFY(&*it == &mwArray[i]);
+			it->mX = -i; // Map iterators give mutable access to the objects.
+			VERIFY(mwArray[i].mX == -i);
+		}
+
+		VERIFY(im.lower_bound(-1)->mKey == 0);
+		VERIFY(im.upper_bound(19) == im.end());
+		VERIFY(im.erase(7) == 1);
+		VERIFY(!im.contains(7) && im.validate());
+		im.clear();
+
+		nErrorCount += TestIntrusiveTreeRandomOperations<intrusive_map<int, MapWidget>,      eastl::set<int>,      MapWidget>(2000, 50, GetMapWidgetKey());
+		nErrorCount += TestIntrusiveTreeRandomOperations<intrusive_multimap<int, MapWidget>, eastl::multiset<int>, MapWidget>(2000, 50, GetMapWidgetKey());
+		nErrorCount += TestIntrusiveTreeRandomOperations<intrusive_multimap<int, MapWidget>, eastl::multiset<int>, MapWidget>(2000, 5,  GetMapWidgetKey());
+	}
+
+	{
+		// Test an object which is in two maps at once.
+
+		typedef intrusive_map<int, MultiWidget, eastl::less<int>, ByName> IM_ByName;
+		typedef intrusive_map<int, MultiWidget, eastl::less<int>, ById>   IM_ById;
+
+		const int   kArraySize = 50;
+		MultiWidget widgets[kArraySize];
+		IM_ByName   byName;
+		IM_ById     byId;
+
+		for(int i = 0; i < kArraySize; i++)
+		{
+			static_cast<ByName&>(widgets[i]).mKey = i;
+			static_cast<ById&>(widgets[i]).mKey   = (i * 17) % kArraySize;
+
+			VERIFY(byName.insert(widgets[i]).second);
+			VERIFY(byId.insert(widgets[i]).second);
+		}
+
+		VERIFY(byName.validate() && byId.validate());
+
+		for(int i = 0; i < kArraySize; i++)
+		{
+			const int nId = static_cast<ById&>(widgets[i]).mKey;
+			VERIFY(&*byName.find(i) == &widgets[i]);
+			VERIFY(&*byId.find(nId) == &widgets[i]);
+		}
+
+		// Removing an object from one map leaves it in the other.
+		for(int i = 0; i < kArraySize; i += 2)
+			byId.remove(widgets[i]);
+
+		VERIFY((byId.size() == (IM_ById::size_type)(kArraySize / 2)) && byId.validate());
+		VERIFY((byName.size() == (IM_ByName::size_type)kArraySize) && byName.validate());
+
+		for(int i = 0; i < kArraySize; i++)
+		{
+			const int nId = static_cast<ById&>(widgets[i]).mKey;
+			VERIFY(&*byName.find(i) == &widgets[i]);
+			VERIFY(byId.contains(nId) == ((i % 2) != 0));
+		}
+
+		// Iterating one map and removing from the other.
+		for(IM_ByName::iterator it = byName.begin(); it != byName.end(); ++it)
+		{
+			if(static_cast<ByName&>(*it).mKey % 2)
+				byId.remove(*it);
+		}
+
+		VERIFY(byId.empty() && byId.validate());
+		VERIFY(byName.validate());
+
+		byName.clear();
+	}
+
+	return nErrorCount;
+}
@@ -119,6 +119,22 @@ int TestMap()
 		nErrorCount += TestMapCpp11NonCopyable<eastl::map<int, NonCopyable, eastl::less<void>>>();
 	}
 
+	{   // Test hinted (finger search) lookups and insertions.
+		nErrorCount += TestMapHintedSearch<VM1, false>();
+		nErrorCount += TestMapHintedSearch<VM4, false>();
+
+		nErrorCount += TestMapHintedSearch<VMM1, true>();
+		nErrorCount += TestMapHintedSearch<VMM4, true>();
+	}
+
+	{   // Test merge, intersect and subtract.
+		nErrorCount += TestMapAlgebra<VM1, false>();
+		nErrorCount += TestMapAlgebra<VM4, false>();
+
+		nErrorCount += TestMapAlgebra<VMM1, true>();
+		nErrorCount += TestMapAlgebra<VMM4, true>();
+	}
+
 	{
 		// C++17 try_emplace and related functionality
 		nErrorCount += TestMapCpp17<eastl::map<int, TestObject>>();
@@ -241,6 +257,99 @@ int TestMap()
 		EATEST_VERIFY(sizeof(VM1) < sizeof(VM2));
 	}
 
+	{ // Test node size with the color packed into the parent pointer
+		typedef eastl::rbtree_node<eastl::map<int, int>::value_type> MapNode;
+
+		#if EASTL_RBTREE_PACKED_COLOR
+			static_assert(sizeof(eastl::rbtree_node_base) == (3 * sizeof(void*)), "rbtree_node_base should be three pointers.");
+		#endif
+		EATEST_VERIFY(sizeof(MapNode) <= (sizeof(eastl::rbtree_node_base) + sizeof(eastl::pair<int, int>)));
+
+		// Colors and parents stay intact through a mix of insertions and erasures.
+		eastl::map<int, int> m;
+		for(int i = 0; i < 1000; i++)
+			m[(i * 7919) % 1000] = i;
+		for(int i = 0; i < 1000; i += 3)
+			m.erase(i);
+		EATEST_VERIFY(m.validate() && (m.size() == 666));
+
+		int nPrev = -1;
+		for(eastl::map<int, int>::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+		{
+			EATEST_VERIFY((nPrev == -1) || (it->first < nPrev));
+			nPrev = it->first;
+		}
+	}
+
+	{ // Test construction from sorted ranges, which builds the tree directly.
+		const int kSizes[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100, 127, 128, 129, 1000, 4095, 4096, 4097 };
+
+		for(int n : kSizes)
+		{
+			eastl::vector<eastl::pair<int, int>> sorted, duplicates, unsorted;
+
+			for(int i = 0; i < n; i++)
+			{
+				sorted.push_back(eastl::make_pair(i * 2, i));
+				duplicates.push_back(eastl::make_pair(i / 3, i)); // Runs of three equivalent keys.
+				unsorted.push_back(eastl::make_pair((i < (n / 2)) ? i : (n - i), i)); // Sorted up to the middle.
+			}
+
+			eastl::map<int, int> m(sorted.begin(), sorted.end());
+			EATEST_VERIFY(m.validate() && (m.size() == (eastl_size_t)n));
+			EATEST_VERIFY(eastl::equal(m.begin(), m.end(), sorted.begin(), [](const eastl::map<int, int>::value_type& a, const eastl::pair<int, int>& b) { return (a.first == b.first) && (a.second == b.second); }));
+
+			// Unique-key containers keep the first of each run of equivalent keys, as element-wise insertion does.
+			eastl::map<int, int> mDuplicates(duplicates.begin(), duplicates.end());
+			EATEST_VERIFY(mDuplicates.validate() && (mDuplicates.size() == (eastl_size_t)((n + 2) / 3)));
+			for(const auto& e : mDuplicates)
+				EATEST_VERIFY(e.second == (e.first * 3));
+
+			// Multi-key containers keep every value, with equivalent keys in their original order.
+			eastl::multimap<int, int> mmDuplicates(duplicates.begin(), duplicates.end());
+			EATEST_VERIFY(mmDuplicates.validate() && (mmDuplicates.size() == (eastl_size_t)n));
+			int i = 0;
+			for(const auto& e : mmDuplicates)
+				EATEST_VERIFY((e.first == (i / 3)) && (e.second == i++));
+
+			// Ranges that are only partly sorted give the same result as element-wise insertion.
+			eastl::map<int, int> mUnsorted(unsorted.begin(), unsorted.end());
+			eastl::map<int, int> mUnsortedExpected;
+			for(const auto& e : unsorted)
+				mUnsortedExpected.insert(e);
+			EATEST_VERIFY(mUnsorted.validate() && (mUnsorted == mUnsortedExpected));
+
+			eastl::multimap<int, int> mmUnsorted(unsorted.begin(), unsorted.end());
+			eastl::multimap<int, int> mmUnsortedExpected;
+			for(const auto& e : unsorted)
+				mmUnsortedExpected.insert(e);
+			EATEST_VERIFY(mmUnsorted.validate() && (mmUnsorted == mmUnsortedExpected));
+
+			// insert(first, last) into an empty map takes the same path; into a non-empty map it doesn't.
+			eastl::map<int, int> mInserted;
+			mInserted.insert(sorted.begin(), sorted.end());
+			mInserted.insert(duplicates.begin(), duplicates.end());
+			EATEST_VERIFY(mInserted.validate() && (mInserted.size() == (m.size() + (mDuplicates.size() / 2))));
+		}
+
+		{
+			TestObject::Reset();
+			{
+				eastl::vector<eastl::pair<TestObject, TestObject>> v;
+				for(int i = 0; i < 100; i++)
+					v.push_back(eastl::make_pair(TestObject(i), TestObject(i)));
+
+				eastl::map<TestObject, TestObject> m(v.begin(), v.end());
+				EATEST_VERIFY(m.validate() && (m.size() == 100));
+
+				m = { {TestObject(3), TestObject(3)}, {TestObject(2), TestObject(2)}, {TestObject(4), TestObject(4)} };
+				EATEST_VERIFY(m.validate() && (m.size() == 3) && (m.begin()->first == TestObject(2)));
+			}
+			EATEST_VERIFY(TestObject::IsClear());
+			TestObject::Reset();
+		}
+	}
+
 	{ // Test erase_if
 		eastl::map<int, int> m = {{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}};
 		auto numErased = eastl::erase_if(m, [](auto p) { return p.first % 2 == 0; });
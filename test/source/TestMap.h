@@ -6,6 +6,7 @@
 #include "EASTLTest.h"
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
 #include <EASTL/type_traits.h>
 #include <EASTL/scoped_ptr.h>
 #include <EASTL/random.h>
@@ -1435,6 +1436,179 @@ int TestMapAccess()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// TestMapAlgebra
+//
+// This function is designed to work with map, fixed_map, multimap and fixed_multimap.
+// Requires a container that can hold at least 400 items.
+//
+template <typename T1, bool bMultimap>
+int TestMapAlgebra()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		typedef typename T1::key_type    key_type;
+		typedef typename T1::mapped_type mapped_type;
+		typedef typename T1::value_type  value_type;
+		typedef eastl::pair<key_type, mapped_type> entry_type; // Unlike value_type, this is assignable, which the expected results need.
+
+		auto entryEquals = [](const value_type& a, const entry_type& b) { return (a.first == b.first) && (a.second == b.second); };
+
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+		for(int i = 0; i < 100; i++)
+		{
+			// The mapped values tell us which container an element came from and in what order.
+			eastl::scoped_ptr<T1> pt1A(new T1);
+			eastl::scoped_ptr<T1> pt1B(new T1);
+			T1& t1A = *pt1A;
+			T1& t1B = *pt1B;
+
+			const int nRange = (int)rng.RandLimit(300) + 1;
+
+			for(int j = 0, jEnd = (int)rng.RandLimit(200); j < jEnd; j++)
+				t1A.insert(value_type(key_type((int)rng.RandLimit((uint32_t)nRange)), mapped_type(j)));
+			for(int j = 0, jEnd = (int)rng.RandLimit(200); j < jEnd; j++)
+				t1B.insert(value_type(key_type((int)rng.RandLimit((uint32_t)nRange)), mapped_type(1000 + j)));
+
+			// Compute the expected results the slow way. A stable sort by key of our elements followed 
+			// by the ones taken from the source puts equivalent keys in the order merge should give.
+			eastl::vector<entry_type> intersectExpected, subtractExpected, mergeExpected, leftoverExpected;
+
+			for(typename T1::iterator it = t1A.begin(); it != t1A.end(); ++it)
+			{
+				mergeExpected.push_back(*it);
+
+				if(t1B.find(it->first) != t1B.end())
+					intersectExpected.push_back(*it);
+				else
+					subtractExpected.push_back(*it);
+			}
+
+			for(typename T1::iterator it = t1B.begin(); it != t1B.end(); ++it)
+			{
+				if(bMultimap || (t1A.find(it->first) == t1A.end()))
+					mergeExpected.push_back(*it);
+				else
+					leftoverExpected.push_back(*it);
+			}
+
+			eastl::stable_sort(mergeExpected.begin(), mergeExpected.end(), 
+							   [](const entry_type& a, const entry_type& b) { return a.first < b.first; });
+
+			eastl::scoped_ptr<T1> pt1C(new T1(t1A));
+			pt1C->intersect(t1B);
+			EATEST_VERIFY(pt1C->validate());
+			EATEST_VERIFY((pt1C->size() == intersectExpected.size()) && eastl::equal(pt1C->begin(), pt1C->end(), intersectExpected.begin(), entryEquals));
+
+			pt1C.reset(new T1(t1A));
+			pt1C->subtract(t1B);
+			EATEST_VERIFY(pt1C->validate());
+			EATEST_VERIFY((pt1C->size() == subtractExpected.size()) && eastl::equal(pt1C->begin(), pt1C->end(), subtractExpected.begin(), entryEquals));
+
+			t1A.merge(t1B);
+			EATEST_VERIFY(t1A.validate() && t1B.validate());
+			EATEST_VERIFY((t1A.size() == mergeExpected.size()) && eastl::equal(t1A.begin(), t1A.end(), mergeExpected.begin(), entryEquals));
+			EATEST_VERIFY((t1B.size() == leftoverExpected.size()) && eastl::equal(t1B.begin(), t1B.end(), leftoverExpected.begin(), entryEquals));
+		}
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestMapHintedSearch
+//
+// This function is designed to work with map, fixed_map, multimap and fixed_multimap.
+// Requires a container that can hold at least 400 items.
+//
+template <typename T1, bool bMultimap>
+int TestMapHintedSearch()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		typedef typename T1::key_type    key_type;
+		typedef typename T1::mapped_type mapped_type;
+		typedef typename T1::value_type  value_type;
+
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+		for(int i = 0; i < 20; i++)
+		{
+			eastl::scoped_ptr<T1> pt1A(new T1);
+			eastl::scoped_ptr<T1> pt1B(new T1);
+			T1& t1A = *pt1A; // Filled with hinted insertions.
+			T1& t1B = *pt1B; // Filled with regular insertions.
+
+			const int nRange = (int)rng.RandLimit(100) + 1;
+
+			// Insert with random hints, most of which aren't adjacent to the insertion position.
+			for(int j = 0, jEnd = (int)rng.RandLimit(200); j < jEnd; j++)
+			{
+				const int k = (int)rng.RandLimit((uint32_t)nRange);
+
+				typename T1::iterator itHint = t1A.begin();
+				eastl::advance(itHint, (ptrdiff_t)rng.RandLimit((uint32_t)t1A.size() + 1));
+
+				const typename T1::size_type nSize = t1A.size();
+				typename T1::iterator it = t1A.insert(itHint, value_type(key_type(k), mapped_type(j)));
+				EATEST_VERIFY(it->first == key_type(k));
+				EATEST_VERIFY(bMultimap ? (t1A.size() == nSize + 1) : (t1A.size() == nSize + (t1B.find(key_type(k)) == t1B.end() ? 1 : 0)));
+				EATEST_VERIFY(t1A.validate());
+
+				t1B.insert(value_type(key_type(k), mapped_type(j)));
+			}
+
+			EATEST_VERIFY(t1A.size() == t1B.size());
+			EATEST_VERIFY(eastl::equal(t1A.begin(), t1A.end(), t1B.begin(), [](const value_type& a, const value_type& b) { return a.first == b.first; }));
+
+			// Every hint, including end(), must give the same results as the regular lookups.
+			for(typename T1::iterator itHint = t1A.begin(); ; ++itHint)
+			{
+				for(int k = -1; k <= nRange; k++)
+				{
+					const key_type key(k);
+
+					EATEST_VERIFY(t1A.lower_bound(itHint, key) == t1A.lower_bound(key));
+					EATEST_VERIFY(t1A.upper_bound(itHint, key) == t1A.upper_bound(key));
+					EATEST_VERIFY(t1A.find(itHint, key) == t1A.find(key));
+				}
+
+				if(itHint == t1A.end())
+					break;
+			}
+
+			// A sweep with monotonically increasing keys, using each result as the next hint.
+			const T1& t1AConst = t1A;
+			typename T1::const_iterator itSweep = t1AConst.begin();
+
+			for(int k = 0; k < nRange; k++)
+			{
+				itSweep = t1AConst.lower_bound(itSweep, key_type(k));
+				EATEST_VERIFY(itSweep == t1AConst.lower_bound(key_type(k)));
+			}
+		}
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+
 template<typename HashContainer>
 struct HashContainerReserveTest
 {
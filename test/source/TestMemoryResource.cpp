@@ -0,0 +1,390 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/memory_resource.h>
+#include <EASTL/vector.h>
+#include <EASTL/string.h>
+#include <EASTL/deque.h>
+#include <EASTL/list.h>
+#include <EASTL/map.h>
+#include <EASTL/set.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/hash_set.h>
+#include <EASTL/sort.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/atomic.h>
+#include <EAStdC/EAAlignment.h>
+#include <eathread/eathread_thread.h>
+
+
+namespace
+{
+	// A resource which counts what it passes on to its upstream resource.
+	class counting_resource : public eastl::pmr::memory_resource
+	{
+	public:
+		explicit counting_resource(eastl::pmr::memory_resource* pUpstream = eastl::pmr::new_delete_resource())
+			: mpUpstream(pUpstream), mnAllocCount(0), mnFreeCount(0), mnLiveBytes(0) { }
+
+		int    alloc_count() const { return mnAllocCount; }
+		int    live_count()  const { return mnAllocCount - mnFreeCount; }
+		size_t live_bytes()  const { return mnLiveBytes; }
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) EA_OVERRIDE
+		{
+			mnAllocCount++;
+			mnLiveBytes += bytes;
+			return mpUpstream->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t alignment) EA_OVERRIDE
+		{
+			mnFreeCount++;
+			mnLiveBytes -= bytes;
+			mpUpstream->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const eastl::pmr::memory_resource& x) const EA_NOEXCEPT EA_OVERRIDE
+		{
+			return this == &x;
+		}
+
+		eastl::pmr::memory_resource* mpUpstream;
+		int    mnAllocCount;
+		int    mnFreeCount;
+		size_t mnLiveBytes;
+	};
+
+
+	// Uses every pmr container type with the given resource, twice.
+	int TestPmrContainers(eastl::pmr::memory_resource* pResource)
+	{
+		using namespace eastl;
+
+		int nErrorCount = 0;
+
+		for(int pass = 0; pass < 2; pass++)
+		{
+			pmr::vector<int>         intVector(pResource);
+			pmr::string              str(pResource);
+			pmr::deque<int>          intDeque(pResource);
+			pmr::list<int>           intList(pResource);
+			pmr::map<int, int>       intMap(pResource);
+			pmr::multimap<int, int>  intMultimap(pResource);
+			pmr::set<int>            intSet(pResource);
+			pmr::multiset<int>       intMultiset(pResource);
+			pmr::hash_map<int, int>  intHashMap(pResource);
+			pmr::hash_set<int>       intHashSet(pResource);
+
+			for(int i = 0; i < 1000; i++)
+			{
+				intVector.push_back(i);
+				str.push_back((char)('a' + (i % 26)));
+				intDeque.push_front(i);
+				intList.push_back(i);
+				intMap[i] = i;
+				intMultimap.insert(eastl::make_pair(i % 10, i));
+				intSet.insert(i);
+				intMultiset.insert(i % 10);
+				intHashMap[i] = i;
+				intHashSet.insert(i);
+			}
+
+			EATEST_VERIFY((intVector.size() == 1000) && (intVector[999] == 999));
+			EATEST_VERIFY((str.size() == 1000) && (str[999] == (char)('a' + (999 % 26))));
+			EATEST_VERIFY((intDeque.size() == 1000) && (intDeque.front() == 999));
+			EATEST_VERIFY((intList.size() == 1000) && (intList.back() == 999));
+			EATEST_VERIFY((intMap.size() == 1000) && intMap.validate());
+			EATEST_VERIFY((intMultimap.count(3) == 100) && intMultimap.validate());
+			EATEST_VERIFY((intSet.size() == 1000) && intSet.validate());
+			EATEST_VERIFY((intMultiset.count(3) == 100) && intMultiset.validate());
+			EATEST_VERIFY((intHashMap.size() == 1000) && intHashMap.validate());
+			EATEST_VERIFY((intHashSet.size() == 1000) && intHashSet.validate());
+
+			EATEST_VERIFY(intVector.get_allocator().resource() == pResource);
+			EATEST_VERIFY(intHashMap.get_allocator().resource() == pResource);
+
+			pmr::vector<int> intVector2(intVector, pmr::polymorphic_allocator(pResource));
+			EATEST_VERIFY(intVector2 == intVector);
+
+			for(int i = 0; i < 1000; i += 2)
+			{
+				intList.pop_front();
+				intMap.erase(i);
+				intHashMap.erase(i);
+			}
+
+			EATEST_VERIFY((intList.size() == 500) && (intMap.size() == 500) && (intHashMap.size() == 500));
+		}
+
+		return nErrorCount;
+	}
+
+
+	const int kPmrThreadCount = 4;
+
+	struct SynchronizedPoolData
+	{
+		eastl::pmr::synchronized_pool_resource* mpResource;
+		EA::Thread::Semaphore                   mStartSema{0};
+		eastl::atomic<int>                      mErrorCount{0};
+	};
+
+	intptr_t SynchronizedPoolThreadFn(void* pData)
+	{
+		SynchronizedPoolData& data = *static_cast<SynchronizedPoolData*>(pData);
+
+		data.mStartSema.Wait();
+
+		for(int i = 0; i < 100; i++)
+		{
+			eastl::pmr::list<int> intList(data.mpResource);
+			eastl::pmr::hash_map<int, int> intHashMap(data.mpResource);
+
+			for(int j = 0; j < 100; j++)
+			{
+				intList.push_back(j);
+				intHashMap[j] = j;
+			}
+
+			if((intList.size() != 100) || (intHashMap.size() != 100) || !intHashMap.validate())
+				data.mErrorCount++;
+		}
+
+		return 0;
+	}
+}
+
+
+int TestMemoryResource()
+{
+	using namespace eastl;
+
+	int nErrorCount = 0;
+
+	{   // Default resource
+		pmr::memory_resource* const pNewDelete = pmr::new_delete_resource();
+
+		EATEST_VERIFY(pmr::get_default_resource() == pNewDelete);
+		EATEST_VERIFY(*pNewDelete == *pmr::new_delete_resource());
+		EATEST_VERIFY(*pNewDelete != *pmr::null_memory_resource());
+
+		counting_resource counter;
+		EATEST_VERIFY(pmr::set_default_resource(&counter) == pNewDelete);
+		EATEST_VERIFY(pmr::get_default_resource() == &counter);
+
+		{
+			pmr::vector<int> intVector;
+			intVector.resize(100);
+			EATEST_VERIFY(intVector.get_allocator().resource() == &counter);
+			EATEST_VERIFY(counter.live_bytes() >= (100 * sizeof(int)));
+		}
+		EATEST_VERIFY((counter.alloc_count() > 0) && (counter.live_count() == 0));
+
+		EATEST_VERIFY(pmr::set_default_resource(NULL) == &counter);
+		EATEST_VERIFY(pmr::get_default_resource() == pNewDelete);
+	}
+
+	{   // polymorphic_allocator
+		pmr::monotonic_buffer_resource monotonic1, monotonic2;
+
+		pmr::polymorphic_allocator a1(&monotonic1);
+		pmr::polymorphic_allocator a2(a1);
+		pmr::polymorphic_allocator a3(&monotonic2);
+		pmr::polymorphic_allocator a4;
+
+		EATEST_VERIFY((a1 == a2) && (a1 != a3) && (a1 != a4));
+		EATEST_VERIFY(a4.resource() == pmr::get_default_resource());
+
+		a4 = a3;
+		EATEST_VERIFY((a4 == a3) && (a4.resource() == &monotonic2));
+
+		void* p = a1.allocate(100, 64, 0);
+		EATEST_VERIFY(p && EA::StdC::IsAligned(p, 64));
+		a1.deallocate(p, 100);
+	}
+
+	{   // monotonic_buffer_resource with an initial buffer.
+		counting_resource counter;
+		alignas(64) char buffer[1024];
+
+		{
+			pmr::monotonic_buffer_resource monotonic(buffer, sizeof(buffer), &counter);
+
+			void* p1 = monotonic.allocate(100);
+			void* p2 = monotonic.allocate(8, 64);
+			void* p3 = monotonic.allocate(1, 1);
+			EATEST_VERIFY((p1 >= buffer) && (static_cast<char*>(p1) + 100 <= buffer + sizeof(buffer)));
+			EATEST_VERIFY((p2 > p1) && EA::StdC::IsAligned(p2, 64));
+			EATEST_VERIFY(p3 == static_cast<char*>(p2) + 8);
+			EATEST_VERIFY(EA::StdC::IsAligned(p1, EASTL_ALLOCATOR_MIN_ALIGNMENT));
+
+			monotonic.deallocate(p1, 100); // Does nothing.
+			EATEST_VERIFY(counter.alloc_count() == 0);
+
+			// Overflow into upstream chunks, which grow.
+			for(int i = 0; i < 100; i++)
+			{
+				void* p = monotonic.allocate(200, 16);
+				EATEST_VERIFY(p && EA::StdC::IsAligned(p, 16));
+				memset(p, 0xaa, 200);
+			}
+			EATEST_VERIFY((counter.alloc_count() > 0) && (counter.alloc_count() < 10));
+
+			void* pLarge = monotonic.allocate(100000, 256); // Larger than the next chunk.
+			EATEST_VERIFY(pLarge && EA::StdC::IsAligned(pLarge, 256));
+			memset(pLarge, 0xaa, 100000);
+
+			monotonic.release();
+			EATEST_VERIFY(counter.live_count() == 0);
+			EATEST_VERIFY(monotonic.allocate(16) == buffer);
+			EATEST_VERIFY(monotonic.upstream_resource() == &counter);
+
+			monotonic.allocate(2000);
+		}
+
+		EATEST_VERIFY(counter.live_count() == 0);
+	}
+
+	{   // monotonic_buffer_resource which must not exceed its buffer.
+		alignas(64) char buffer[512];
+		pmr::monotonic_buffer_resource monotonic(buffer, sizeof(buffer), pmr::null_memory_resource());
+
+		pmr::vector<int> intVector(&monotonic);
+		intVector.reserve(100);
+		for(int i = 0; i < 100; i++)
+			intVector.push_back(i);
+
+		EATEST_VERIFY((intVector.data() >= (int*)buffer) && (intVector.data() + 100 <= (int*)(buffer + sizeof(buffer))));
+	}
+
+	{   // unsynchronized_pool_resource
+		counting_resource counter;
+
+		{
+			pmr::unsynchronized_pool_resource pool(pmr::pool_options(64, 1000), &counter);
+
+			EATEST_VERIFY(pool.options().max_blocks_per_chunk == 64);
+			EATEST_VERIFY(pool.options().largest_required_pool_block == 1024); // Rounded up to a power of two.
+			EATEST_VERIFY(pool.upstream_resource() == &counter);
+
+			// Freed blocks are reused.
+			void* p1 = pool.allocate(24);
+			pool.deallocate(p1, 24);
+			void* p2 = pool.allocate(30);
+			EATEST_VERIFY(p2 == p1);
+			pool.deallocate(p2, 30);
+
+			// Blocks are aligned to their size.
+			for(size_t n = 1; n <= 1024; n *= 2)
+			{
+				void* p = pool.allocate(n, n);
+				EATEST_VERIFY(p && EA::StdC::IsAligned(p, (n > EASTL_ALLOCATOR_MIN_ALIGNMENT) ? n : EASTL_ALLOCATOR_MIN_ALIGNMENT));
+				memset(p, 0xaa, n);
+				pool.deallocate(p, n, n);
+			}
+
+			// Larger blocks go to upstream directly.
+			const int nAllocCount = counter.alloc_count();
+			void* pLarge = pool.allocate(5000);
+			EATEST_VERIFY(counter.alloc_count() == nAllocCount + 1);
+			pool.deallocate(pLarge, 5000);
+			EATEST_VERIFY(counter.live_count() == nAllocCount);
+
+			// Many small blocks need few upstream allocations.
+			vector<void*> blocks;
+			for(int i = 0; i < 1000; i++)
+				blocks.push_back(pool.allocate(16));
+			EATEST_VERIFY(counter.alloc_count() < nAllocCount + 30);
+
+			sort(blocks.begin(), blocks.end());
+			EATEST_VERIFY(unique(blocks.begin(), blocks.end()) == blocks.end());
+
+			for(eastl_size_t i = 0; i < blocks.size(); i++)
+				pool.deallocate(blocks[i], 16);
+
+			pool.release();
+			EATEST_VERIFY(counter.live_count() == 0);
+
+			EATEST_VERIFY(pool.allocate(16) != NULL);
+		}
+
+		EATEST_VERIFY(counter.live_count() == 0);
+	}
+
+	{   // Containers, which after a first pass reuse the resource's memory.
+		counting_resource counter;
+
+		{
+			pmr::unsynchronized_pool_resource pool(&counter);
+			nErrorCount += TestPmrContainers(&pool);
+		}
+		EATEST_VERIFY(counter.live_count() == 0);
+
+		{
+			pmr::monotonic_buffer_resource monotonic(&counter);
+			nErrorCount += TestPmrContainers(&monotonic);
+		}
+		EATEST_VERIFY(counter.live_count() == 0);
+
+		{
+			pmr::synchronized_pool_resource pool(&counter);
+			nErrorCount += TestPmrContainers(&pool);
+		}
+		EATEST_VERIFY(counter.live_count() == 0);
+
+		nErrorCount += TestPmrContainers(pmr::new_delete_resource());
+	}
+
+	{   // Containers with different resources have the same type.
+		pmr::unsynchronized_pool_resource pool;
+		pmr::monotonic_buffer_resource monotonic;
+
+		pmr::vector<int> intVector1(&pool);
+		pmr::vector<int> intVector2(&monotonic);
+
+		for(int i = 0; i < 10; i++)
+		{
+			intVector1.push_back(i);
+			intVector2.push_back(i * 2);
+		}
+
+		intVector1.swap(intVector2); // Swaps the allocators along with the elements.
+		EATEST_VERIFY((intVector1[9] == 18) && (intVector2[9] == 9));
+		EATEST_VERIFY((intVector1.get_allocator().resource() == &monotonic) && (intVector2.get_allocator().resource() == &pool));
+
+		intVector1 = intVector2; // Assignment doesn't change the resource.
+		EATEST_VERIFY((intVector1 == intVector2) && (intVector1.get_allocator().resource() == &monotonic));
+
+		pmr::string str1("hello", &pool);
+		pmr::string str2("world", &monotonic);
+		str1 += str2;
+		EATEST_VERIFY(str1 == "helloworld");
+	}
+
+	{   // synchronized_pool_resource shared by threads.
+		pmr::synchronized_pool_resource pool(pmr::pool_options(16));
+
+		SynchronizedPoolData data;
+		data.mpResource = &pool;
+
+		EA::Thread::Thread threads[kPmrThreadCount];
+
+		for(int i = 0; i < kPmrThreadCount; i++)
+			threads[i].Begin(SynchronizedPoolThreadFn, static_cast<void*>(&data));
+
+		data.mStartSema.Post(kPmrThreadCount);
+
+		for(int i = 0; i < kPmrThreadCount; i++)
+			threads[i].WaitForEnd();
+
+		EATEST_VERIFY(data.mErrorCount == 0);
+		EATEST_VERIFY(pool.options().max_blocks_per_chunk == 16);
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,328 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "TestMap.h"
+#include "TestSet.h"
+#include "EASTLTest.h"
+#include <EASTL/ranked_map.h>
+#include <EASTL/ranked_set.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	#include <map>
+	#include <set>
+#endif
+EA_RESTORE_ALL_VC_WARNINGS()
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::ranked_map<int, int>;
+template class eastl::ranked_multimap<int, int>;
+template class eastl::ranked_map<TestObject, TestObject>;
+template class eastl::ranked_multimap<TestObject, TestObject>;
+template class eastl::ranked_set<int>;
+template class eastl::ranked_multiset<float>;
+template class eastl::ranked_set<TestObject>;
+template class eastl::ranked_multiset<TestObject>;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+typedef eastl::ranked_map<int, int> VRM1;
+typedef eastl::ranked_map<TestObject, TestObject> VRM4;
+typedef eastl::ranked_map<Align64, Align64> VRM7;
+typedef eastl::ranked_multimap<int, int> VRMM1;
+typedef eastl::ranked_multimap<TestObject, TestObject> VRMM4;
+typedef eastl::ranked_multimap<Align64, Align64> VRMM7;
+typedef eastl::ranked_set<int> VRS1;
+typedef eastl::ranked_set<TestObject> VRS4;
+typedef eastl::ranked_multiset<int> VRMS1;
+typedef eastl::ranked_multiset<TestObject> VRMS4;
+
+#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+	typedef std::map<int, int> VM3;
+	typedef std::map<TestObject, TestObject> VM6;
+	typedef std::map<Align64, Align64> VM9;
+	typedef std::multimap<int, int> VMM3;
+	typedef std::multimap<TestObject, TestObject> VMM6;
+	typedef std::multimap<Align64, Align64> VMM9;
+	typedef std::set<int> VS3;
+	typedef std::set<TestObject> VS6;
+	typedef std::multiset<int> VMS3;
+	typedef std::multiset<TestObject> VMS6;
+#endif
+
+
+// Verifies nth, rank and index_of against a walk over the whole container.
+template <typename T>
+int TestRankedConsistency(const T& t, int nKeyRange)
+{
+	int nErrorCount = 0;
+
+	typename T::size_type i = 0;
+	for(typename T::const_iterator it = t.begin(); it != t.end(); ++it, ++i)
+	{
+		EATEST_VERIFY(t.nth(i) == it);
+		EATEST_VERIFY(t.index_of(it) == i);
+	}
+
+	EATEST_VERIFY(t.nth(t.size()) == t.end());
+	EATEST_VERIFY(t.index_of(t.end()) == t.size());
+
+	for(int k = -1; k <= nKeyRange; k++)
+		EATEST_VERIFY(t.rank(k) == (typename T::size_type)eastl::distance(t.begin(), t.lower_bound(k)));
+
+	return nErrorCount;
+}
+
+
+// Applies a random mix of insertions and erasures and verifies that the order statistics
+// stay correct, and that the tree (including its subtree sizes) stays valid.
+template <typename T, typename Insert>
+int TestRankedRandomOperations(int nOperationCount, int nKeyRange, Insert insertFn)
+{
+	int nErrorCount = 0;
+
+	EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+	T              t;
+
+	for(int i = 0; i < nOperationCount; i++)
+	{
+		const int k = (int)rng.RandLimit((uint32_t)nKeyRange);
+
+		if(rng.RandLimit(3) != 0)
+			insertFn(t, k);
+		else if(!t.empty() && rng.RandLimit(2))
+			t.erase(t.nth((typename T::size_type)rng.RandLimit((uint32_t)t.size())));
+		else
+			t.erase(k);
+
+		EATEST_VERIFY(t.validate());
+
+		if((i % 64) == 0)
+			nErrorCount += TestRankedConsistency(t, nKeyRange);
+	}
+
+	nErrorCount += TestRankedConsistency(t, nKeyRange);
+	return nErrorCount;
+}
+
+
+int TestRankedMap()
+{
+	int nErrorCount = 0;
+
+	#ifndef EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+		{   // Test construction
+			nErrorCount += TestMapConstruction<VRM1, VM3, false>();
+			nErrorCount += TestMapConstruction<VRM4, VM6, false>();
+			nErrorCount += TestMapConstruction<VRM7, VM9, false>();
+
+			nErrorCount += TestMapConstruction<VRMM1, VMM3, true>();
+			nErrorCount += TestMapConstruction<VRMM4, VMM6, true>();
+			nErrorCount += TestMapConstruction<VRMM7, VMM9, true>();
+
+			nErrorCount += TestSetConstruction<VRS1, VS3, false>();
+			nErrorCount += TestSetConstruction<VRS4, VS6, false>();
+			nErrorCount += TestSetConstruction<VRMS1, VMS3, true>();
+			nErrorCount += TestSetConstruction<VRMS4, VMS6, true>();
+		}
+
+		{   // Test mutating functionality.
+			nErrorCount += TestMapMutation<VRM1, VM3, false>();
+			nErrorCount += TestMapMutation<VRM4, VM6, false>();
+			nErrorCount += TestMapMutation<VRM7, VM9, false>();
+
+			nErrorCount += TestMapMutation<VRMM1, VMM3, true>();
+			nErrorCount += TestMapMutation<VRMM4, VMM6, true>();
+			nErrorCount += TestMapMutation<VRMM7, VMM9, true>();
+
+			nErrorCount += TestSetMutation<VRS1, VS3, false>();
+			nErrorCount += TestSetMutation<VRS4, VS6, false>();
+			nErrorCount += TestSetMutation<VRMS1, VMS3, true>();
+			nErrorCount += TestSetMutation<VRMS4, VMS6, true>();
+		}
+	#endif // EA_COMPILER_NO_STANDARD_CPP_LIBRARY
+
+
+	{   // Test searching functionality.
+		nErrorCount += TestMapSearch<VRM1, false>();
+		nErrorCount += TestMapSearch<VRM4, false>();
+		nErrorCount += TestMapSearch<VRMM1, true>();
+		nErrorCount += TestMapSearch<VRMM4, true>();
+
+		nErrorCount += TestSetSearch<VRS1, false>();
+		nErrorCount += TestSetSearch<VRS4, false>();
+		nErrorCount += TestSetSearch<VRMS1, true>();
+		nErrorCount += TestSetSearch<VRMS4, true>();
+	}
+
+
+	{
+		// C++11 emplace and related functionality
+		nErrorCount += TestMapCpp11<eastl::ranked_map<int, TestObject>>();
+		nErrorCount += TestMultimapCpp11<eastl::ranked_multimap<int, TestObject>>();
+
+		nErrorCount += TestSetCpp11<eastl::ranked_set<TestObject>>();
+		nErrorCount += TestMultisetCpp11<eastl::ranked_multiset<TestObject>>();
+	}
+
+
+	{
+		// C++17 try_emplace and related functionality
+		nErrorCount += TestMapCpp17<eastl::ranked_map<int, TestObject>>();
+	}
+
+
+	{   // operator[] and at()
+		nErrorCount += TestMapAccess<VRM1>();
+		nErrorCount += TestMapAccess<VRM4>();
+	}
+
+
+	{   // Hinted insertions, which keep the subtree sizes up to date along the finger search path.
+		nErrorCount += TestMapHintedSearch<VRM1, false>();
+		nErrorCount += TestMapHintedSearch<VRMM1, true>();
+	}
+
+
+	{   // merge, intersect and subtract, which relink whole subtrees.
+		nErrorCount += TestMapAlgebra<VRM1, false>();
+		nErrorCount += TestMapAlgebra<VRMM1, true>();
+
+		nErrorCount += TestSetAlgebra<VRS1, false>();
+		nErrorCount += TestSetAlgebra<VRMS1, true>();
+	}
+
+
+	{   // Random insertions and erasures, checking the order statistics along the way.
+		nErrorCount += TestRankedRandomOperations<VRM1>(4000, 1000, [](VRM1& t, int k) { t.insert(VRM1::value_type(k, k)); });
+		nErrorCount += TestRankedRandomOperations<VRMS1>(4000, 200, [](VRMS1& t, int k) { t.insert(k); });
+
+		// Hinted insertion with a mix of good and bad hints.
+		nErrorCount += TestRankedRandomOperations<VRS1>(4000, 1000, [](VRS1& t, int k) { t.insert(t.lower_bound(k + (k % 3)), k); });
+	}
+
+
+	{   // nth, rank and index_of
+		VRS1 rs;
+
+		EATEST_VERIFY(rs.nth(0) == rs.end());
+		EATEST_VERIFY(rs.rank(5) == 0);
+		EATEST_VERIFY(rs.index_of(rs.end()) == 0);
+
+		for(int i = 0; i < 1000; i++)
+			rs.insert(i * 2);
+
+		EATEST_VERIFY(*rs.nth(0) == 0);
+		EATEST_VERIFY(*rs.nth(500) == 1000);
+		EATEST_VERIFY(*rs.nth(999) == 1998);
+		EATEST_VERIFY(rs.nth(1000) == rs.end());
+
+		EATEST_VERIFY(rs.rank(-1) == 0);
+		EATEST_VERIFY(rs.rank(1000) == 500);  // 0, 2, ... 998 are less than 1000.
+		EATEST_VERIFY(rs.rank(1001) == 501);
+		EATEST_VERIFY(rs.rank(5000) == 1000);
+
+		EATEST_VERIFY(rs.index_of(rs.find(1000)) == 500);
+
+		rs.erase(rs.nth(0), rs.nth(100));
+		EATEST_VERIFY(rs.validate() && (rs.size() == 900));
+		EATEST_VERIFY(*rs.nth(0) == 200);
+		EATEST_VERIFY(rs.rank(1000) == 400);
+
+		const VRS1& rsConst = rs;
+		EATEST_VERIFY(*rsConst.nth(1) == 202);
+	}
+
+
+	{   // Duplicate keys: rank is the index of the first equal key, and count doesn't walk the range.
+		VRMM1 rmm;
+
+		for(int i = 0; i < 1000; i++)
+			rmm.emplace(i % 10, i);
+
+		EATEST_VERIFY(rmm.count(3) == 100);
+		EATEST_VERIFY(rmm.rank(3) == 300);
+		EATEST_VERIFY(rmm.nth(300)->first == 3);
+		EATEST_VERIFY(rmm.nth(299)->first == 2);
+		EATEST_VERIFY(rmm.index_of(rmm.upper_bound(3)) == 400);
+
+		EATEST_VERIFY(rmm.erase(3) == 100);
+		EATEST_VERIFY(rmm.validate() && (rmm.size() == 900));
+		EATEST_VERIFY(rmm.rank(4) == 300);
+	}
+
+
+	{   // Copies, sorted range construction, swap and move keep the subtree sizes.
+		eastl::vector<int> v;
+		for(int i = 0; i < 777; i++)
+			v.push_back(i);
+
+		VRS1 rs(v.begin(), v.end());
+		EATEST_VERIFY(rs.validate() && (*rs.nth(500) == 500));
+
+		VRS1 rsCopy(rs);
+		EATEST_VERIFY(rsCopy.validate() && (*rsCopy.nth(776) == 776));
+
+		VRS1 rsOther = { 5, 3, 1 };
+		rsOther.swap(rsCopy);
+		EATEST_VERIFY(rsOther.validate() && (rsOther.size() == 777) && (*rsCopy.nth(1) == 3));
+
+		VRS1 rsMoved(eastl::move(rsOther));
+		EATEST_VERIFY(rsMoved.validate() && (rsMoved.rank(100) == 100));
+
+		rsMoved.insert(v.begin(), v.end()); // All present already.
+		EATEST_VERIFY(rsMoved.validate() && (rsMoved.size() == 777));
+	}
+
+
+	{   // erase_if and heterogeneous lookup.
+		ranked_map<int, int> rm;
+
+		for(int i = 0; i < 500; i++)
+			rm[i] = i;
+
+		EATEST_VERIFY(eastl::erase_if(rm, [](const ranked_map<int, int>::value_type& v) { return (v.first % 3) == 0; }) == 167);
+		EATEST_VERIFY(rm.validate() && (rm.size() == 333));
+		EATEST_VERIFY(rm.nth(0)->first == 1);
+		EATEST_VERIFY(rm.rank(6) == 4); // 1, 2, 4, 5
+
+		ranked_set<eastl::string, eastl::less<void>> rs = { "apple", "banana", "cherry" };
+
+		EATEST_VERIFY(rs.rank("banana") == 1);
+		EATEST_VERIFY(rs.insert("durian").second);
+		EATEST_VERIFY(*rs.nth(3) == "durian");
+		EATEST_VERIFY(rs.erase("apple") == 1);
+		EATEST_VERIFY(rs.validate() && (rs.rank("cherry") == 1));
+	}
+
+
+	{   // Allocator support: all nodes are returned to the allocator.
+		CountingAllocator::resetCount();
+		{
+			ranked_map<int, TestObject, eastl::less<int>, CountingAllocator> rm;
+
+			for(int i = 0; i < 2000; i++)
+				rm.try_emplace(i, i);
+			EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 2000);
+
+			for(int i = 0; i < 2000; i += 2)
+				rm.erase(i);
+			EATEST_VERIFY(rm.validate() && (rm.size() == 1000) && (rm.nth(10)->first == 21));
+		}
+		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+	return nErrorCount;
+}
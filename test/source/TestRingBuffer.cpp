@@ -1179,6 +1179,50 @@ int TestRingBuffer()
 		}
 	}
 
+	{
+		// Growing keeps the values in order when they wrap around the end of the container.
+		eastl::ring_buffer<eastl::string> stringBuffer(4);
+		eastl::ring_buffer<int, eastl::list<int>> intBuffer(4);
+
+		for(int i = 0; i < 6; i++) // Overwrites 0 and 1, leaving 2-5, which wrap around.
+		{
+			stringBuffer.push_back(eastl::string(eastl::string::CtorSprintf(), "%d long enough to be allocated on the heap", i));
+			intBuffer.push_back(i);
+		}
+
+		stringBuffer.reserve(6);
+		intBuffer.reserve(6);
+		VERIFY((stringBuffer.size() == 4) && (stringBuffer.capacity() == 6));
+		VERIFY((intBuffer.size() == 4) && (intBuffer.capacity() == 6));
+
+		for(int i = 6; i < 10; i++) // Overwrites 2 and 3.
+		{
+			stringBuffer.push_back(eastl::string(eastl::string::CtorSprintf(), "%d long enough to be allocated on the heap", i));
+			intBuffer.push_back(i);
+		}
+
+		stringBuffer.set_capacity(8);
+		intBuffer.set_capacity(8);
+
+		int i = 4;
+		for(auto it = stringBuffer.begin(); it != stringBuffer.end(); ++it, ++i)
+			VERIFY(*it == eastl::string(eastl::string::CtorSprintf(), "%d long enough to be allocated on the heap", i));
+		VERIFY((i == 10) && stringBuffer.validate());
+
+		i = 4;
+		for(auto it = intBuffer.begin(); it != intBuffer.end(); ++it, ++i)
+			VERIFY(*it == i);
+		VERIFY((i == 10) && intBuffer.validate());
+
+		stringBuffer.resize(12);
+		VERIFY((stringBuffer.size() == 12) && (stringBuffer.capacity() == 12) && stringBuffer.validate());
+		VERIFY((stringBuffer.front() == "4 long enough to be allocated on the heap") && (stringBuffer[5] == "9 long enough to be allocated on the heap"));
+
+		intBuffer.resize(12);
+		VERIFY((intBuffer.size() == 12) && (intBuffer.capacity() == 12) && intBuffer.validate());
+		VERIFY((intBuffer.front() == 4) && (*eastl::next(intBuffer.begin(), 5) == 9));
+	}
+
 	return nErrorCount;
 }
 
@@ -154,6 +154,38 @@ int TestSet()
 	}
 
 
+	{   // Test merge, intersect and subtract.
+		nErrorCount += TestSetAlgebra<VS1, false>();
+		nErrorCount += TestSetAlgebra<VS4, false>();
+
+		nErrorCount += TestSetAlgebra<VMS1, true>();
+		nErrorCount += TestSetAlgebra<VMS4, true>();
+	}
+
+
+	{ // merge relinks the nodes of the source instead of allocating new ones.
+		typedef eastl::set<int, eastl::less<int>, CountingAllocator> CountingSet;
+
+		CountingAllocator::resetCount();
+		{
+			CountingSet s1, s2;
+			for(int i = 0; i < 1000; i++)
+				(i % 3 ? s1 : s2).insert(i);
+
+			const uint64_t nAllocCount = CountingAllocator::getTotalAllocationCount();
+			s1.merge(s2);
+			EATEST_VERIFY(s1.validate() && (s1.size() == 1000) && s2.empty());
+
+			CountingSet s3(s1.begin(), s1.end());
+			s3.subtract(s2);
+			s3.intersect(s1);
+			EATEST_VERIFY(s3.validate() && (s3 == s1));
+			EATEST_VERIFY(CountingAllocator::getTotalAllocationCount() == (nAllocCount + 1000));
+		}
+		EATEST_VERIFY(CountingAllocator::getActiveAllocationCount() == 0);
+	}
+
+
 	{ // Misc tests
 
 		// const key_compare& key_comp() const;
@@ -273,6 +305,26 @@ int TestSet()
 		nErrorCount += TestAssociativeContainerHeterogeneousErasure(s);
 	}
 
+	{ // Test construction from sorted ranges, which builds the tree directly.
+		for(int n = 0; n < 300; n++)
+		{
+			eastl::vector<int> v;
+			for(int i = 0; i < n; i++)
+				v.push_back(i / 2);
+
+			eastl::set<int> s(v.begin(), v.end());
+			EATEST_VERIFY(s.validate() && (s.size() == (eastl_size_t)((n + 1) / 2)));
+
+			eastl::multiset<int> ms(v.begin(), v.end());
+			EATEST_VERIFY(ms.validate() && (ms.size() == (eastl_size_t)n));
+			EATEST_VERIFY(eastl::equal(ms.begin(), ms.end(), v.begin()));
+
+			eastl::reverse(v.begin(), v.end());
+			eastl::set<int> sReversed(v.begin(), v.end());
+			EATEST_VERIFY(sReversed.validate() && (sReversed == s));
+		}
+	}
+
 	{ // insert(P&&) was incorrectly defined in the rbtree base type.
 		// should never have been defined for set, multiset.
 		// it does not correctly support heterogeneous insertion (unconditionally creates a key_type).
@@ -6,6 +6,7 @@
 #include "EASTLTest.h"
 #include <EASTL/vector.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
 #include <EASTL/type_traits.h>
 #include <EASTL/scoped_ptr.h>
 #include <EASTL/random.h>
@@ -900,6 +901,113 @@ int TestMultisetCpp11()
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// TestSetAlgebra
+//
+// This function is designed to work with set, fixed_set, multiset and fixed_multiset.
+// Requires a container that can hold at least 400 items.
+//
+template <typename T1, bool bMultiset>
+int TestSetAlgebra()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		typedef typename T1::value_type value_type;
+
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+		for(int i = 0; i < 100; i++)
+		{
+			// We vary the sizes independently so that the trees being joined differ in height.
+			eastl::scoped_ptr<T1> pt1A(new T1);
+			eastl::scoped_ptr<T1> pt1B(new T1);
+			T1& t1A = *pt1A;
+			T1& t1B = *pt1B;
+
+			const int nRange = (int)rng.RandLimit(300) + 1;
+
+			for(int j = 0, jEnd = (int)rng.RandLimit(200); j < jEnd; j++)
+				t1A.insert(value_type((int)rng.RandLimit((uint32_t)nRange)));
+			for(int j = 0, jEnd = (int)rng.RandLimit(200); j < jEnd; j++)
+				t1B.insert(value_type((int)rng.RandLimit((uint32_t)nRange)));
+
+			// Compute the expected results the slow way.
+			eastl::vector<value_type> intersectExpected, subtractExpected, mergeExpected, leftoverExpected;
+
+			for(typename T1::iterator it = t1A.begin(); it != t1A.end(); ++it)
+			{
+				if(t1B.find(*it) != t1B.end())
+					intersectExpected.push_back(*it);
+				else
+					subtractExpected.push_back(*it);
+			}
+
+			if(bMultiset)
+				eastl::merge(t1A.begin(), t1A.end(), t1B.begin(), t1B.end(), eastl::back_inserter(mergeExpected));
+			else
+			{
+				eastl::set_union(t1A.begin(), t1A.end(), t1B.begin(), t1B.end(), eastl::back_inserter(mergeExpected));
+				eastl::set_intersection(t1B.begin(), t1B.end(), t1A.begin(), t1A.end(), eastl::back_inserter(leftoverExpected));
+			}
+
+			eastl::scoped_ptr<T1> pt1C(new T1(t1A));
+			pt1C->intersect(t1B);
+			EATEST_VERIFY(pt1C->validate());
+			EATEST_VERIFY((pt1C->size() == intersectExpected.size()) && eastl::equal(pt1C->begin(), pt1C->end(), intersectExpected.begin()));
+
+			pt1C.reset(new T1(t1A));
+			pt1C->subtract(t1B);
+			EATEST_VERIFY(pt1C->validate());
+			EATEST_VERIFY((pt1C->size() == subtractExpected.size()) && eastl::equal(pt1C->begin(), pt1C->end(), subtractExpected.begin()));
+
+			t1A.merge(t1B);
+			EATEST_VERIFY(t1A.validate() && t1B.validate());
+			EATEST_VERIFY((t1A.size() == mergeExpected.size()) && eastl::equal(t1A.begin(), t1A.end(), mergeExpected.begin()));
+			EATEST_VERIFY((t1B.size() == leftoverExpected.size()) && eastl::equal(t1B.begin(), t1B.end(), leftoverExpected.begin()));
+		}
+	}
+
+	{
+		// Operations with the container itself and with empty containers.
+		T1 t1A, t1B;
+
+		for(int i = 0; i < 100; i++)
+			t1A.insert(typename T1::value_type(i));
+
+		t1A.merge(t1A);
+		t1A.intersect(t1A);
+		EATEST_VERIFY(t1A.validate() && (t1A.size() == 100));
+
+		t1A.merge(t1B);
+		t1A.subtract(t1B);
+		EATEST_VERIFY(t1A.validate() && (t1A.size() == 100));
+
+		t1B.merge(eastl::move(t1A));
+		EATEST_VERIFY(t1A.validate() && t1A.empty());
+		EATEST_VERIFY(t1B.validate() && (t1B.size() == 100));
+
+		t1A.intersect(t1B);
+		EATEST_VERIFY(t1A.validate() && t1A.empty());
+
+		t1B.intersect(t1A);
+		EATEST_VERIFY(t1B.validate() && t1B.empty());
+
+		t1A.insert(typename T1::value_type(1));
+		t1A.subtract(t1A);
+		EATEST_VERIFY(t1A.validate() && t1A.empty());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+
 
 
 
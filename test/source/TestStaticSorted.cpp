@@ -0,0 +1,230 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <EASTL/static_sorted_set.h>
+#include <EASTL/static_sorted_map.h>
+#include <EASTL/vector_set.h>
+#include <EASTL/vector_map.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+using namespace eastl;
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class eastl::static_sorted_set<int>;
+template class eastl::static_sorted_set<TestObject>;
+template class eastl::static_sorted_map<int, int>;
+template class eastl::static_sorted_map<TestObject, TestObject>;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+typedef eastl::static_sorted_set<int>      SSS1;
+typedef eastl::static_sorted_map<int, int> SSM1;
+typedef eastl::vector_set<int>             VS1;
+
+
+// Builds a static_sorted_set of n random keys in [0, nKeyRange) and verifies that
+// every kind of lookup agrees with a vector_set of the same keys, for keys which
+// are present, absent, and beyond either end.
+static int TestStaticSortedAgainstVectorSet(EASTLTest_Rand& rng, int n, int nKeyRange)
+{
+	int nErrorCount = 0;
+
+	eastl::vector<int> keys;
+	for(int i = 0; i < n; i++)
+		keys.push_back((int)rng.RandLimit((uint32_t)nKeyRange));
+
+	const VS1  vs(keys.begin(), keys.end());
+	const SSS1 sss(keys.begin(), keys.end());
+
+	EATEST_VERIFY(sss.validate());
+	EATEST_VERIFY(sss.size() == vs.size());
+	EATEST_VERIFY(eastl::equal(sss.begin(), sss.end(), vs.begin()));
+	EATEST_VERIFY(eastl::equal(sss.rbegin(), sss.rend(), vs.rbegin()));
+
+	for(int k = -1; k <= nKeyRange; k++)
+	{
+		EATEST_VERIFY(eastl::distance(sss.begin(), sss.lower_bound(k)) == eastl::distance(vs.begin(), vs.lower_bound(k)));
+		EATEST_VERIFY(eastl::distance(sss.begin(), sss.upper_bound(k)) == eastl::distance(vs.begin(), vs.upper_bound(k)));
+		EATEST_VERIFY((sss.find(k) == sss.end()) == (vs.find(k) == vs.end()));
+		EATEST_VERIFY(sss.count(k) == vs.count(k));
+		EATEST_VERIFY(sss.contains(k) == vs.contains(k));
+
+		const eastl::pair<SSS1::iterator, SSS1::iterator> range = sss.equal_range(k);
+		EATEST_VERIFY(range.first == sss.lower_bound(k));
+		EATEST_VERIFY(range.second == sss.upper_bound(k));
+		EATEST_VERIFY(sss.find(k) == ((sss.count(k) != 0) ? sss.lower_bound(k) : sss.end()));
+	}
+
+	return nErrorCount;
+}
+
+
+int TestStaticSorted()
+{
+	int nErrorCount = 0;
+
+	{   // Lookups agree with vector_set, for every table size up to a few complete levels
+		// and for a large table, with both sparse and dense keys.
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+
+		for(int n = 0; n < 300; n++)
+			nErrorCount += TestStaticSortedAgainstVectorSet(rng, n, n * 3 + 1);
+
+		nErrorCount += TestStaticSortedAgainstVectorSet(rng, 10000, 30000);
+		nErrorCount += TestStaticSortedAgainstVectorSet(rng, 10000, 1000);
+	}
+
+
+	{   // Empty
+		SSS1 sss;
+
+		EATEST_VERIFY(sss.empty() && (sss.size() == 0) && sss.validate());
+		EATEST_VERIFY(sss.begin() == sss.end());
+		EATEST_VERIFY(sss.rbegin() == sss.rend());
+		EATEST_VERIFY(sss.find(0) == sss.end());
+		EATEST_VERIFY(sss.lower_bound(0) == sss.end());
+		EATEST_VERIFY(sss.upper_bound(0) == sss.end());
+		EATEST_VERIFY(sss.validate_iterator(sss.end()) == (isf_valid | isf_current));
+	}
+
+
+	{   // Iteration in both directions, and iterator validation
+		SSS1 sss = { 5, 3, 9, 1, 7, 2, 8 };
+
+		int expected[] = { 1, 2, 3, 5, 7, 8, 9 };
+		EATEST_VERIFY(VerifySequence(sss.begin(), sss.end(), int(), "static_sorted_set", 1, 2, 3, 5, 7, 8, 9, -1));
+		EATEST_VERIFY(eastl::equal(sss.rbegin(), sss.rend(), eastl::reverse_iterator<int*>(expected + 7)));
+
+		SSS1::iterator it = sss.end();
+		EATEST_VERIFY(*--it == 9);
+		EATEST_VERIFY(*it-- == 9);
+		EATEST_VERIFY(*it == 8);
+		EATEST_VERIFY(*it++ == 8);
+		EATEST_VERIFY(++it == sss.end());
+
+		EATEST_VERIFY(sss.validate_iterator(sss.find(5)) == (isf_valid | isf_current | isf_can_dereference));
+		EATEST_VERIFY(sss.validate_iterator(SSS1().end()) == isf_none);
+	}
+
+
+	{   // Duplicate keys keep the first value, as vector_map does.
+		eastl::vector<eastl::pair<int, int> > v;
+
+		for(int i = 0; i < 100; i++)
+			v.push_back(eastl::make_pair(i % 10, i));
+
+		const SSM1 ssm(v.begin(), v.end());
+
+		EATEST_VERIFY(ssm.validate() && (ssm.size() == 10));
+		for(int i = 0; i < 10; i++)
+			EATEST_VERIFY(ssm.at(i) == i);
+	}
+
+
+	{   // Freezing a vector_map, and map lookups
+		eastl::vector_map<int, TestObject> vm;
+
+		for(int i = 0; i < 500; i++)
+			vm.emplace(i * 2, TestObject(i));
+
+		const eastl::static_sorted_map<int, TestObject> ssm(vm.begin(), vm.end());
+
+		EATEST_VERIFY(ssm.validate() && (ssm.size() == vm.size()));
+		EATEST_VERIFY(eastl::equal(ssm.begin(), ssm.end(), vm.begin(),
+			[](const eastl::pair<const int, TestObject>& a, const eastl::pair<int, TestObject>& b) { return (a.first == b.first) && (a.second == b.second); }));
+		EATEST_VERIFY(ssm.at(200).mX == 100);
+		EATEST_VERIFY(ssm.find(201) == ssm.end());
+		EATEST_VERIFY(ssm.lower_bound(201)->first == 202);
+		EATEST_VERIFY(ssm.value_comp()(*ssm.find(2), *ssm.find(4)));
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			bool bThrown = false;
+			try { ssm.at(201); }
+			catch(std::out_of_range&) { bThrown = true; }
+			EATEST_VERIFY(bThrown);
+		#endif
+	}
+
+
+	{   // Copy, move, swap, assign and comparison
+		SSS1 a = { 1, 2, 3, 4, 5 };
+		SSS1 b(a);
+
+		EATEST_VERIFY((a == b) && b.validate());
+
+		SSS1 c(eastl::move(b));
+		EATEST_VERIFY((a == c) && b.empty());
+
+		b = { 10, 20 };
+		EATEST_VERIFY((b.size() == 2) && (a != b) && b.contains(20));
+
+		swap(a, b);
+		EATEST_VERIFY((a.size() == 2) && (b.size() == 5) && (b == c));
+
+		a = c;
+		EATEST_VERIFY(a == c);
+
+		a = eastl::move(b);
+		EATEST_VERIFY(a == c);
+
+		const int values[] = { 7, 3, 7 };
+		a.assign(values, values + 3);
+		EATEST_VERIFY(a.validate() && (a.size() == 2) && (*a.begin() == 3));
+
+		a.assign(a.begin(), a.end()); // Assigning from our own contents works, since the values are copied first.
+		EATEST_VERIFY(a.validate() && (a.size() == 2) && (*a.begin() == 3));
+
+		a.clear();
+		EATEST_VERIFY(a.empty() && (a.begin() == a.end()));
+	}
+
+
+	{   // Custom comparison
+		const int values[] = { 1, 5, 3, 4, 2 };
+		eastl::static_sorted_set<int, eastl::greater<int> > sss(values, values + 5);
+
+		EATEST_VERIFY(VerifySequence(sss.begin(), sss.end(), int(), "static_sorted_set greater", 5, 4, 3, 2, 1, -1));
+		EATEST_VERIFY(*sss.lower_bound(6) == 5);
+		EATEST_VERIFY(*sss.upper_bound(3) == 2);
+		EATEST_VERIFY(sss.upper_bound(1) == sss.end());
+	}
+
+
+	{   // Heterogeneous lookup with a transparent comparison
+		eastl::static_sorted_map<eastl::string, int, eastl::less<> > ssm = { { "one", 1 }, { "two", 2 }, { "three", 3 } };
+
+		EATEST_VERIFY(ssm.find("two")->second == 2);
+		EATEST_VERIFY(ssm.contains("three"));
+		EATEST_VERIFY(!ssm.contains("four"));
+		EATEST_VERIFY(ssm.count("one") == 1);
+		EATEST_VERIFY(ssm.at("one") == 1);
+		EATEST_VERIFY(ssm.lower_bound("p")->first == "three");
+		EATEST_VERIFY(ssm.upper_bound("two") == ssm.end());
+		EATEST_VERIFY(ssm.equal_range("one").first->second == 1);
+	}
+
+
+	{   // The values are constructed and destroyed in balance.
+		TestObject::Reset();
+		{
+			eastl::vector<TestObject> v;
+			for(int i = 0; i < 100; i++)
+				v.push_back(TestObject(99 - i));
+
+			eastl::static_sorted_set<TestObject> sss(v.begin(), v.end());
+			EATEST_VERIFY(sss.validate() && (sss.size() == 100) && (sss.begin()->mX == 0));
+		}
+		EATEST_VERIFY(TestObject::IsClear());
+		TestObject::Reset();
+	}
+
+	return nErrorCount;
+}
@@ -383,6 +383,24 @@ typedef int  FunctionIntVoid();
 typedef int  FunctionIntFloat(float);
 typedef void (*FunctionVoidVoidPtr)();
 
+
+// Owns memory through a pointer, so it isn't trivially copyable, but it is trivially relocatable.
+struct UserRelocatable
+{
+	UserRelocatable() : mpData(nullptr) {}
+	UserRelocatable(const UserRelocatable&) : mpData(nullptr) {}
+   ~UserRelocatable() {}
+
+	void* mpData;
+};
+
+namespace eastl
+{
+	template <>
+	struct is_trivially_relocatable<UserRelocatable> : public true_type {};
+}
+
+
 namespace
 {
 	const eastl::string gEmptyStringInstance("");
@@ -1176,6 +1194,22 @@ int TestTypeTraits()
 	}
 
 
+	// is_trivially_relocatable
+	static_assert(is_trivially_relocatable<int>::value             == true,   "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<int*>::value            == true,   "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<const int>::value       == true,   "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<int[4]>::value          == true,   "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<UserRelocatable>::value == true,   "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<const UserRelocatable>::value == true, "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<eastl::vector<int>>::value    == true, "is_trivially_relocatable failure");
+	static_assert(is_trivially_relocatable<eastl::pair<const int, UserRelocatable>>::value == true, "is_trivially_relocatable failure");
+	#if EASTL_TYPE_TRAIT_is_trivially_copyable_CONFORMANCE
+		static_assert(is_trivially_relocatable<NoTrivialCopy1>::value == false,  "is_trivially_relocatable failure");
+		static_assert(is_trivially_relocatable<PodA>::value           == true,   "is_trivially_relocatable failure");
+		static_assert(is_trivially_relocatable<eastl::pair<int, NoTrivialCopy1>>::value == false, "is_trivially_relocatable failure");
+	#endif
+
+
 	// is_trivially_copy_assignable
 	{
 		static_assert(is_trivially_copy_assignable<int>::value == true, "is_trivially_copy_assignable failure");
@@ -11,6 +11,7 @@
 #include <EASTL/algorithm.h>
 #include <EASTL/utility.h>
 #include <EASTL/allocator_malloc.h>
+#include <EASTL/arena_allocator.h>
 #include <EASTL/unique_ptr.h>
 
 #include "ConceptImpls.h"
@@ -152,6 +153,63 @@ struct TestMoveAssignToSelf
 	bool mMovedToSelf;
 };
 
+// Owns an int through a pointer, and counts its constructions and destructions.
+// Being trivially relocatable, a vector of it should grow without constructing
+// or destroying any elements.
+struct RelocatableCounter
+{
+	RelocatableCounter(int value = 0)               : mpValue(new int(value))      { ++sCtorCount; }
+	RelocatableCounter(const RelocatableCounter& x) : mpValue(new int(*x.mpValue)) { ++sCtorCount; }
+	RelocatableCounter(RelocatableCounter&& x)      : mpValue(x.mpValue)           { x.mpValue = nullptr; ++sCtorCount; }
+   ~RelocatableCounter()                                                           { delete mpValue; ++sDtorCount; }
+
+	RelocatableCounter& operator=(const RelocatableCounter& x) { *mpValue = *x.mpValue; return *this; }
+	RelocatableCounter& operator=(RelocatableCounter&& x)      { eastl::swap(mpValue, x.mpValue); return *this; }
+
+	bool operator==(int value) const { return mpValue && (*mpValue == value); }
+
+	int* mpValue;
+
+	static int sCtorCount;
+	static int sDtorCount;
+};
+
+int RelocatableCounter::sCtorCount = 0;
+int RelocatableCounter::sDtorCount = 0;
+
+namespace eastl
+{
+	template <>
+	struct is_trivially_relocatable<RelocatableCounter> : public true_type {};
+}
+
+
+// An allocator which supports the reallocate extension, and counts its calls.
+class ReallocatingAllocator
+{
+public:
+	ReallocatingAllocator(const char* = NULL) {}
+	ReallocatingAllocator(const ReallocatingAllocator&, const char*) {}
+
+	void* allocate(size_t n, int = 0)                           { ++snAllocCount; return malloc(n); }
+	void* allocate(size_t n, size_t alignment, size_t, int = 0) { ++snAllocCount; return (alignment <= EASTL_SYSTEM_ALLOCATOR_MIN_ALIGNMENT) ? malloc(n) : NULL; }
+	void  deallocate(void* p, size_t)                           { free(p); }
+	void* reallocate(void* p, size_t, size_t n)                 { ++snReallocCount; return realloc(p, n); }
+
+	const char* get_name() const      { return "ReallocatingAllocator"; }
+	void        set_name(const char*) {}
+
+	static int snAllocCount;
+	static int snReallocCount;
+};
+
+int ReallocatingAllocator::snAllocCount   = 0;
+int ReallocatingAllocator::snReallocCount = 0;
+
+inline bool operator==(const ReallocatingAllocator&, const ReallocatingAllocator&) { return true; }
+inline bool operator!=(const ReallocatingAllocator&, const ReallocatingAllocator&) { return false; }
+
+
 #if EASTL_VARIABLE_TEMPLATES_ENABLED
 	/// custom type-trait which checks if a type is comparable via the <operator.
 	template <class, class = eastl::void_t<>>
@@ -1921,6 +1979,109 @@ int TestVector()
 	    VerifySequence(v, {str, str}, "push_back() must be able to push elements from self.");
     }
 
+	// Growth of trivially relocatable values.
+	{
+		static_assert(eastl::is_trivially_relocatable<eastl::string>::value,                "is_trivially_relocatable failure");
+		static_assert(eastl::is_trivially_relocatable<eastl::vector<int>>::value,           "is_trivially_relocatable failure");
+		static_assert(eastl::is_trivially_relocatable<eastl::unique_ptr<int>>::value,       "is_trivially_relocatable failure");
+		static_assert(eastl::is_trivially_relocatable<TestObject>::value == false,          "is_trivially_relocatable failure");
+
+		RelocatableCounter::sCtorCount = RelocatableCounter::sDtorCount = 0;
+		{
+			eastl::vector<RelocatableCounter> v;
+
+			for(int i = 0; i < 1000; i++)
+				v.emplace_back(i);   // Grows by emplace_back.
+			v.reserve(3000);         // Grows by reserve.
+			v.resize(4000);          // Grows by resize, and default constructs 3000 more.
+			EATEST_VERIFY((RelocatableCounter::sCtorCount == 4000) && (RelocatableCounter::sDtorCount == 0));
+
+			v.insert(v.begin() + 1, RelocatableCounter(-1)); // Grows by insert, which constructs the temporary and moves it in.
+			EATEST_VERIFY((RelocatableCounter::sCtorCount == 4002) && (RelocatableCounter::sDtorCount == 1));
+
+			v.set_capacity(5000);    // Relocates to a smaller block.
+			EATEST_VERIFY((RelocatableCounter::sCtorCount == 4002) && (RelocatableCounter::sDtorCount == 1));
+			EATEST_VERIFY((v.size() == 4001) && (v.capacity() == 5000));
+			EATEST_VERIFY((v[0] == 0) && (v[1] == -1) && (v[2] == 1) && (v[1000] == 999) && (v[1001] == 0));
+
+			eastl::vector<RelocatableCounter> w(4);
+			w[2] = RelocatableCounter(2);
+			EATEST_VERIFY(w.size() == w.capacity());
+			w.push_back(w[2]); // Grows, while the argument refers to a value of the vector.
+			EATEST_VERIFY((w[2] == 2) && (w[4] == 2));
+		}
+		EATEST_VERIFY(RelocatableCounter::sCtorCount == RelocatableCounter::sDtorCount);
+
+		// Strings and unique_ptrs relocate with their values intact.
+		eastl::vector<eastl::string> strings;
+		eastl::vector<eastl::unique_ptr<int>> pointers;
+
+		for(int i = 0; i < 1000; i++)
+		{
+			strings.push_back(eastl::string(eastl::string::CtorSprintf(), "%d long enough to be allocated on the heap", i));
+			strings.push_back(eastl::string(eastl::string::CtorSprintf(), "%d", i)); // In the string's own buffer.
+			pointers.push_back(eastl::unique_ptr<int>(new int(i)));
+		}
+
+		for(int i = 0; i < 1000; i++)
+		{
+			EATEST_VERIFY(strings[(eastl_size_t)i * 2] == eastl::string(eastl::string::CtorSprintf(), "%d long enough to be allocated on the heap", i));
+			EATEST_VERIFY(strings[(eastl_size_t)i * 2 + 1] == eastl::string(eastl::string::CtorSprintf(), "%d", i));
+			EATEST_VERIFY(*pointers[(eastl_size_t)i] == i);
+		}
+	}
+
+	// Growth with an allocator which supports reallocate.
+	{
+		ReallocatingAllocator::snAllocCount = ReallocatingAllocator::snReallocCount = 0;
+
+		eastl::vector<int, ReallocatingAllocator> v;
+
+		for(int i = 0; i < 1000; i++)
+			v.push_back(i); // push_back allocates a new block, as its argument may refer to a value of the vector.
+		EATEST_VERIFY(ReallocatingAllocator::snReallocCount == 0);
+
+		const int nAllocCount = ReallocatingAllocator::snAllocCount;
+		v.reserve(100000);
+		v.resize(300000);
+		EATEST_VERIFY((ReallocatingAllocator::snReallocCount == 2) && (ReallocatingAllocator::snAllocCount == nAllocCount));
+		EATEST_VERIFY((v.size() == 300000) && (v[999] == 999) && (v[1000] == 0));
+
+		for(int i = 0; i < 1000; i++)
+			EATEST_VERIFY(v[(eastl_size_t)i] == i);
+
+		// Values which aren't trivially relocatable are moved to a new block.
+		eastl::vector<TestObject, ReallocatingAllocator> objects(10);
+		objects.reserve(1000);
+		EATEST_VERIFY(ReallocatingAllocator::snReallocCount == 2);
+	}
+	EATEST_VERIFY(TestObject::Reset());
+
+	// Growth in place, with an allocator which supports try_expand.
+	{
+		eastl::arena scratch(1024 * 1024);
+		eastl::vector<TestObject, eastl::arena_allocator> v((eastl::arena_allocator(&scratch)));
+
+		v.push_back(TestObject(0));
+		const TestObject* const pData = v.data();
+		const int64_t nMoveCount = TestObject::sTOMoveCtorCount + TestObject::sTOCopyCtorCount;
+
+		for(int i = 1; i < 1000; i++)
+			v.push_back(v[(eastl_size_t)i - 1]); // The vector is the arena's last allocation, so it grows in place.
+		v.reserve(2000);
+		v.resize(1500);
+
+		EATEST_VERIFY(v.data() == pData);
+		EATEST_VERIFY((TestObject::sTOMoveCtorCount + TestObject::sTOCopyCtorCount) == (nMoveCount + 999)); // Only the copies of the arguments.
+		EATEST_VERIFY((v[999].mX == 0) && (v.capacity() == 2000));
+
+		eastl::vector<int, eastl::arena_allocator> other((eastl::arena_allocator(&scratch)));
+		other.push_back(1);
+		v.reserve(4000); // v is no longer the arena's last allocation, so it moves.
+		EATEST_VERIFY((v.data() != pData) && (v.size() == 1500) && (v[999].mX == 0));
+	}
+	EATEST_VERIFY(TestObject::Reset());
+
 #if EASTL_EXCEPTIONS_ENABLED
     // test constructors & destructors called appropriate when exception thrown during modification.
     EATEST_VERIFY(TestObject::Reset());
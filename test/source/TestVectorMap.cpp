@@ -7,6 +7,7 @@
 #include "EASTLTest.h"
 #include <EASTL/vector_map.h>
 #include <EASTL/vector_multimap.h>
+#include <EASTL/sort.h>
 #include <EASTL/vector.h>
 #include <EASTL/deque.h>
 #include <EASTL/string.h>
@@ -81,6 +82,66 @@ int TestVectorMapAtKey()
 	return nErrorCount;
 }
 
+// Inserts random batches with insert(first, last) and merge, and verifies that the result
+// is the same as inserting the values one at a time, including which of several values
+// with equal keys is kept (unique keys) and their order (multiple keys). The mapped value
+// records the order in which the values were inserted.
+template <typename T, bool bMultimap>
+int TestVectorMapBatchedInsert()
+{
+	int nErrorCount = 0;
+
+	EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+	T              t;
+	T              tByElement;
+	int            nSequence = 0;
+
+	for(int nBatch = 0; nBatch < 40; nBatch++)
+	{
+		eastl::vector<eastl::pair<int, int> > values;
+		const int nKeyRange = 10 + (int)rng.RandLimit(300);
+		const int nCount    = (int)rng.RandLimit(100);
+
+		for(int i = 0; i < nCount; i++)
+			values.push_back(eastl::make_pair((int)rng.RandLimit((uint32_t)nKeyRange), nSequence++));
+
+		if(nBatch % 4 == 0) // Already sorted batches take a faster path.
+			eastl::stable_sort(values.begin(), values.end(), [](const eastl::pair<int, int>& a, const eastl::pair<int, int>& b) { return a.first < b.first; });
+
+		if(nBatch % 3 == 0) // Merge from another container of the same type.
+		{
+			T source(t.get_allocator());
+			for(eastl_size_t i = 0; i < values.size(); i++)
+				source.insert(values[i]);
+
+			T sourceByElement(source);
+			T rejected(t.get_allocator());
+			for(typename T::iterator it = sourceByElement.begin(); it != sourceByElement.end(); ++it)
+			{
+				if(!bMultimap && (tByElement.find(it->first) != tByElement.end()))
+					rejected.insert(*it);
+				else
+					tByElement.insert(*it);
+			}
+
+			t.merge(source);
+			EATEST_VERIFY(source == rejected);
+		}
+		else
+		{
+			t.insert(values.begin(), values.end());
+
+			for(eastl_size_t i = 0; i < values.size(); i++)
+				tByElement.insert(values[i]);
+		}
+
+		EATEST_VERIFY(t.validate());
+		EATEST_VERIFY(t == tByElement);
+	}
+
+	return nErrorCount;
+}
+
 int TestVectorMap()
 {
 	int nErrorCount = 0;
@@ -309,6 +370,25 @@ int TestVectorMap()
 		VERIFY(ExplicitString::sCtorFromStrCount == 0);
 	}
 
+	{   // insert(first, last) and merge, which sort and merge a batch of values at once.
+		nErrorCount += TestVectorMapBatchedInsert<VM1, false>();
+		nErrorCount += TestVectorMapBatchedInsert<VM2, false>();
+		nErrorCount += TestVectorMapBatchedInsert<VMM1, true>();
+		nErrorCount += TestVectorMapBatchedInsert<VMM2, true>();
+
+		VM1 vm = { { 3, 0 }, { 1, 0 } };
+		vm.insert({ { 2, 1 }, { 1, 1 }, { 0, 1 }, { 2, 2 } });
+		EATEST_VERIFY((vm.size() == 4) && (vm[0] == 1) && (vm[1] == 0) && (vm[2] == 1) && (vm[3] == 0));
+
+		VM1 vmSource = { { 1, 2 }, { 5, 2 } };
+		vm.merge(eastl::move(vmSource));
+		EATEST_VERIFY((vm.size() == 5) && (vm[1] == 0) && (vm[5] == 2));
+		EATEST_VERIFY((vmSource.size() == 1) && (vmSource[1] == 2));
+
+		vm.merge(vm); // Merging with itself does nothing.
+		EATEST_VERIFY(vm.size() == 5);
+	}
+
 	{ // heterogenous functions - vector_multimap
 		eastl::vector_multimap<ExplicitString, int, eastl::less<void>> m{ { ExplicitString::Create("found"), 1 } };
 		nErrorCount += TestAssociativeContainerHeterogeneousLookup(m);
@@ -8,6 +8,7 @@
 #include "EASTLTest.h"
 #include <EASTL/vector_set.h>
 #include <EASTL/vector_multiset.h>
+#include <EASTL/set.h>
 #include <EASTL/vector.h>
 #include <EASTL/deque.h>
 #include <EABase/eabase.h>
@@ -194,6 +195,48 @@ int TestVectorSet()
 		}
 	}
 
+	{ // insert(first, last) and merge, which sort and merge a batch of values at once.
+		EASTLTest_Rand rng(EA::UnitTest::GetRandSeed());
+		VS1  vs;
+		VS2  vsDeque;
+		VMS1 vms;
+		eastl::set<int>      sByElement;
+		eastl::multiset<int> msByElement;
+
+		for(int nBatch = 0; nBatch < 40; nBatch++)
+		{
+			eastl::vector<int> values;
+			for(int i = 0, iEnd = (int)rng.RandLimit(100); i < iEnd; i++)
+				values.push_back((int)rng.RandLimit(500));
+
+			vs.insert(values.begin(), values.end());
+			vsDeque.insert(values.begin(), values.end());
+			vms.insert(values.begin(), values.end());
+			sByElement.insert(values.begin(), values.end());
+			msByElement.insert(values.begin(), values.end());
+
+			EATEST_VERIFY(vs.validate() && vsDeque.validate() && vms.validate());
+			EATEST_VERIFY((vs.size() == sByElement.size()) && eastl::equal(vs.begin(), vs.end(), sByElement.begin()));
+			EATEST_VERIFY((vsDeque.size() == sByElement.size()) && eastl::equal(vsDeque.begin(), vsDeque.end(), sByElement.begin()));
+			EATEST_VERIFY((vms.size() == msByElement.size()) && eastl::equal(vms.begin(), vms.end(), msByElement.begin()));
+		}
+
+		VS1 vsSource = { -1, 0, 1, 1000 };
+		const eastl_size_t nSize = vs.size();
+		vs.merge(vsSource);
+		EATEST_VERIFY(vs.validate() && (vs.size() == nSize + 4 - vsSource.size()) && vs.contains(-1) && vs.contains(1000));
+		EATEST_VERIFY(vsSource.size() == (eastl_size_t)(sByElement.count(0) + sByElement.count(1)));
+
+		VMS1 vmsSource = { -1, 0, 0 };
+		vms.merge(vmsSource);
+		EATEST_VERIFY(vms.validate() && vmsSource.empty() && (vms.count(0) == msByElement.count(0) + 2));
+
+		VS4 vsObjects = { TestObject(3), TestObject(1) }; // An already sorted range with a duplicate, which goes after the existing values.
+		const TestObject objects[] = { TestObject(4), TestObject(5), TestObject(5) };
+		vsObjects.insert(objects, objects + 3);
+		EATEST_VERIFY(VerifySequence(vsObjects, { TestObject(1), TestObject(3), TestObject(4), TestObject(5) }, "vector_set insert"));
+	}
+
 	{ // heterogenous functions - vector_set
 		eastl::vector_set<ExplicitString, eastl::less<void>> s = { ExplicitString::Create("found") };
 		nErrorCount += TestAssociativeContainerHeterogeneousLookup(s);
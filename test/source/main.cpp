@@ -97,9 +97,11 @@ int EAMain(int argc, char* argv[])
 #endif
 	testSuite.AddTest("BitVector",				TestBitVector);
 	testSuite.AddTest("Bitset",					TestBitset);
+	testSuite.AddTest("BTree",					TestBTree);
 	testSuite.AddTest("CharTraits",			    TestCharTraits);
 	testSuite.AddTest("Chrono",					TestChrono);
 	testSuite.AddTest("Concepts", 				TestConcepts);
+	testSuite.AddTest("ConcurrentHashMap",		TestConcurrentHashMap);
 	testSuite.AddTest("ContainerBehaviour",		TestContainerBehaviour);
 	testSuite.AddTest("Deque",					TestDeque);
 #if EA_COMPILER_CPP17_ENABLED
@@ -116,11 +118,13 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("FixedString",			TestFixedString);
 	testSuite.AddTest("FixedTupleVector",		TestFixedTupleVector);
 	testSuite.AddTest("FixedVector",			TestFixedVector);
+	testSuite.AddTest("FlatHash",				TestFlatHash);
 	testSuite.AddTest("Functional",				TestFunctional);
 	testSuite.AddTest("Hash",					TestHash);
 	testSuite.AddTest("Heap",					TestHeap);
 	testSuite.AddTest("IntrusiveHash",			TestIntrusiveHash);
 	testSuite.AddTest("IntrusiveList",			TestIntrusiveList);
+	testSuite.AddTest("IntrusiveTree",			TestIntrusiveTree);
 	testSuite.AddTest("IntrusiveSDList",		TestIntrusiveSDList);
 	testSuite.AddTest("IntrusiveSList",			TestIntrusiveSList);
 	testSuite.AddTest("Iterator",				TestIterator);
@@ -129,10 +133,12 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("ListMap",				TestListMap);
 	testSuite.AddTest("Map",					TestMap);
 	testSuite.AddTest("Memory",					TestMemory);
+	testSuite.AddTest("MemoryResource",			TestMemoryResource);
 	testSuite.AddTest("Meta",				    TestMeta);
 	testSuite.AddTest("NumericLimits",			TestNumericLimits);
 	testSuite.AddTest("Optional",				TestOptional);
 	testSuite.AddTest("Random",					TestRandom);
+	testSuite.AddTest("RankedMap",				TestRankedMap);
 	testSuite.AddTest("Ratio",					TestRatio);
 	testSuite.AddTest("RingBuffer",				TestRingBuffer);
 	testSuite.AddTest("SList",					TestSList);
@@ -141,6 +147,7 @@ int EAMain(int argc, char* argv[])
 	testSuite.AddTest("SmartPtr",				TestSmartPtr);
 	testSuite.AddTest("Sort",					TestSort);
 	testSuite.AddTest("Span",				    TestSpan);
+	testSuite.AddTest("StaticSorted",			TestStaticSorted);
 	testSuite.AddTest("String",					TestString);
 	testSuite.AddTest("StringHashMap",			TestStringHashMap);
 	testSuite.AddTest("StringMap",				TestStringMap);